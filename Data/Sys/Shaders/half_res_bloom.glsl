@@ -0,0 +1,52 @@
+/*
+[configuration]
+
+[OptionRangeFloat]
+GUIName = Bloom threshold
+OptionName = BLOOM_THRESHOLD
+MinValue = 0.0
+MaxValue = 1.0
+StepAmount = 0.05
+DefaultValue = 0.7
+
+[OptionRangeFloat]
+GUIName = Bloom intensity
+OptionName = BLOOM_INTENSITY
+MinValue = 0.0
+MaxValue = 2.0
+StepAmount = 0.05
+DefaultValue = 0.5
+
+[Pass]
+EntryPoint = BrightPass
+OutputScale = 0.5
+
+[Pass]
+EntryPoint = Composite
+
+[/configuration]
+*/
+
+// Extracts and blurs the bright parts of the image at half resolution.
+void BrightPass()
+{
+	float4 sum = float4(0.0, 0.0, 0.0, 0.0);
+	float2 step = GetInvResolution() * 1.5;
+	for (int y = -1; y <= 1; y++)
+	{
+		for (int x = -1; x <= 1; x++)
+		{
+			float4 color = SampleLocation(GetCoordinates() + float2(x, y) * step);
+			sum += max(color - GetOption(BLOOM_THRESHOLD), 0.0);
+		}
+	}
+
+	SetOutput(sum / 9.0);
+}
+
+// Adds the blurred highlights to the full resolution image.
+void Composite()
+{
+	float4 bloom = Sample() * GetOption(BLOOM_INTENSITY);
+	SetOutput(float4(SampleOriginal().rgb + bloom.rgb, 1.0));
+}
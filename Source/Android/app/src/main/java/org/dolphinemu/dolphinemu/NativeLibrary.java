@@ -478,6 +478,24 @@ public final class NativeLibrary
    */
   public static native void WriteProfileResults();
 
+  /**
+   * Starts sampling where the emulated CPU spends its time
+   *
+   * @return false if sampling isn't supported or no game is running
+   */
+  public static native boolean StartSamplingProfiler();
+
+  /**
+   * Stops the sampling profiler and writes the profile to Dump/Debug/sampling_profile.folded
+   */
+  public static native void StopSamplingProfiler();
+
+  /**
+   * Records every draw of the next frame, and writes them to Dump/Debug/draw_capture_*.json and
+   * .csv when the frame ends
+   */
+  public static native void CaptureDraws();
+
   /**
    * Native EGL functions not exposed by Java bindings
    **/
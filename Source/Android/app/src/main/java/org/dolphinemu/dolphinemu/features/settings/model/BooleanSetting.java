@@ -187,6 +187,8 @@ public enum BooleanSetting implements AbstractBooleanSetting
   GFX_CROP(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS, "Crop", false),
   GFX_SHOW_FPS(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS, "ShowFPS", true),
   GFX_OVERLAY_STATS(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS, "OverlayStats", false),
+  GFX_SHOW_FRAME_TIMELINE(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS, "ShowFrameTimeline",
+          false),
   GFX_DUMP_TEXTURES(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS, "DumpTextures", false),
   GFX_DUMP_MIP_TEXTURES(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS, "DumpMipTextures", false),
   GFX_DUMP_BASE_TEXTURES(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS, "DumpBaseTextures",
@@ -199,7 +201,7 @@ public enum BooleanSetting implements AbstractBooleanSetting
   GFX_INTERNAL_RESOLUTION_FRAME_DUMPS(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS,
           "InternalResolutionFrameDumps", false),
   GFX_ENABLE_GPU_TEXTURE_DECODING(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS,
-          "EnableGPUTextureDecoding", false),
+          "EnableGPUTextureDecoding", true),
   GFX_ENABLE_PIXEL_LIGHTING(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS,
           "EnablePixelLighting", false),
   GFX_FAST_DEPTH_CALC(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS, "FastDepthCalc", true),
@@ -215,6 +217,8 @@ public enum BooleanSetting implements AbstractBooleanSetting
           "WaitForShadersBeforeStarting", false),
   GFX_SAVE_TEXTURE_CACHE_TO_STATE(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS,
           "SaveTextureCacheToState", true),
+  GFX_SAVE_TEXTURE_CACHE_AT_NATIVE_RESOLUTION(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS,
+          "SaveTextureCacheAtNativeResolution", false),
   GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS,
           "PreferVSForLinePointExpansion", false),
   GFX_MODS_ENABLE(Settings.FILE_GFX, Settings.SECTION_GFX_SETTINGS, "EnableMods", false),
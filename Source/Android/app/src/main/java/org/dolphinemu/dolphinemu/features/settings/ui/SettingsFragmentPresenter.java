@@ -772,6 +772,8 @@ public final class SettingsFragmentPresenter
             R.string.vertex_rounding, R.string.vertex_rounding_description));
     sl.add(new CheckBoxSetting(mContext, BooleanSetting.GFX_SAVE_TEXTURE_CACHE_TO_STATE,
             R.string.texture_cache_to_state, R.string.texture_cache_to_state_description));
+    sl.add(new CheckBoxSetting(mContext, BooleanSetting.GFX_SAVE_TEXTURE_CACHE_AT_NATIVE_RESOLUTION,
+            R.string.texture_cache_native, R.string.texture_cache_native_description));
   }
 
   private void addAdvancedGraphicsSettings(ArrayList<SettingsItem> sl)
@@ -810,6 +812,8 @@ public final class SettingsFragmentPresenter
 //            R.string.wireframe, R.string.leave_this_unchecked));
     sl.add(new CheckBoxSetting(mContext, BooleanSetting.GFX_OVERLAY_STATS,
             R.string.show_stats, R.string.leave_this_unchecked));
+    sl.add(new CheckBoxSetting(mContext, BooleanSetting.GFX_SHOW_FRAME_TIMELINE,
+            R.string.show_frame_timeline, R.string.show_frame_timeline_description));
 //    sl.add(new CheckBoxSetting(mContext, BooleanSetting.GFX_TEXFMT_OVERLAY_ENABLE,
 //            R.string.texture_format, R.string.leave_this_unchecked));
     sl.add(new CheckBoxSetting(mContext, BooleanSetting.GFX_ENABLE_VALIDATION_LAYER,
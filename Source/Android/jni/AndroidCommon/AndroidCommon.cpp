@@ -5,10 +5,12 @@
 
 #include <algorithm>
 #include <ios>
+#include <limits>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <dlfcn.h>
 #include <jni.h>
 
 #include "Common/Assert.h"
@@ -197,3 +199,40 @@ int GetNetworkGateway()
   return env->CallStaticIntMethod(IDCache::GetNetworkHelperClass(),
                                   IDCache::GetNetworkHelperGetNetworkGateway());
 }
+
+float GetThermalHeadroom(int forecast_seconds)
+{
+  // The thermal API was added in API level 30 (headroom in 31), which is above our minSdkVersion,
+  // so it is looked up at runtime instead of being linked against.
+  struct ThermalApi
+  {
+    using AcquireManager = void* (*)();
+    using GetThermalHeadroom = float (*)(void*, int);
+
+    void* manager = nullptr;
+    GetThermalHeadroom get_thermal_headroom = nullptr;
+  };
+  static const ThermalApi api = [] {
+    ThermalApi result;
+    void* const library = dlopen("libandroid.so", RTLD_NOW);
+    if (!library)
+      return result;
+
+    const auto acquire_manager = reinterpret_cast<ThermalApi::AcquireManager>(
+        dlsym(library, "AThermal_acquireManager"));
+    const auto get_thermal_headroom = reinterpret_cast<ThermalApi::GetThermalHeadroom>(
+        dlsym(library, "AThermal_getThermalHeadroom"));
+    if (!acquire_manager || !get_thermal_headroom)
+      return result;
+
+    // The manager is kept for the lifetime of the process.
+    result.manager = acquire_manager();
+    if (result.manager)
+      result.get_thermal_headroom = get_thermal_headroom;
+    return result;
+  }();
+
+  if (!api.get_thermal_headroom)
+    return std::numeric_limits<float>::quiet_NaN();
+  return api.get_thermal_headroom(api.manager, forecast_seconds);
+}
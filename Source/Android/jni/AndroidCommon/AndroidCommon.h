@@ -46,3 +46,8 @@ std::vector<std::string> DoFileSearchAndroidContent(const std::string& directory
 int GetNetworkIpAddress();
 int GetNetworkPrefixLength();
 int GetNetworkGateway();
+
+// Returns the thermal headroom forecast for the given number of seconds from now, where 1 means
+// that the device is about to be throttled, or NaN if it's unknown. Needs Android 12 or newer, and
+// returns NaN when called more than about once per second.
+float GetThermalHeadroom(int forecast_seconds);
@@ -0,0 +1,101 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "jni/AndroidCommon/PerformanceHint.h"
+
+#include <memory>
+#include <vector>
+
+#include <dlfcn.h>
+
+namespace
+{
+// The performance hint API was added in API level 33, which is above our minSdkVersion, so it is
+// looked up at runtime instead of being linked against.
+struct PerformanceHintApi
+{
+  using GetManager = void* (*)();
+  using CreateSession = void* (*)(void*, const s32*, size_t, s64);
+  using UpdateTargetWorkDuration = int (*)(void*, s64);
+  using ReportActualWorkDuration = int (*)(void*, s64);
+  using CloseSession = void (*)(void*);
+
+  void* manager = nullptr;
+  CreateSession create_session = nullptr;
+  UpdateTargetWorkDuration update_target_work_duration = nullptr;
+  ReportActualWorkDuration report_actual_work_duration = nullptr;
+  CloseSession close_session = nullptr;
+};
+
+const PerformanceHintApi& GetApi()
+{
+  static const PerformanceHintApi api = [] {
+    PerformanceHintApi result;
+    void* const library = dlopen("libandroid.so", RTLD_NOW);
+    if (!library)
+      return result;
+
+    const auto get_manager = reinterpret_cast<PerformanceHintApi::GetManager>(
+        dlsym(library, "APerformanceHint_getManager"));
+    result.create_session = reinterpret_cast<PerformanceHintApi::CreateSession>(
+        dlsym(library, "APerformanceHint_createSession"));
+    result.update_target_work_duration =
+        reinterpret_cast<PerformanceHintApi::UpdateTargetWorkDuration>(
+            dlsym(library, "APerformanceHint_updateTargetWorkDuration"));
+    result.report_actual_work_duration =
+        reinterpret_cast<PerformanceHintApi::ReportActualWorkDuration>(
+            dlsym(library, "APerformanceHint_reportActualWorkDuration"));
+    result.close_session = reinterpret_cast<PerformanceHintApi::CloseSession>(
+        dlsym(library, "APerformanceHint_closeSession"));
+    if (get_manager && result.create_session && result.update_target_work_duration &&
+        result.report_actual_work_duration && result.close_session)
+    {
+      result.manager = get_manager();
+    }
+    return result;
+  }();
+  return api;
+}
+}  // namespace
+
+std::unique_ptr<PerformanceHintSession>
+PerformanceHintSession::Create(const std::vector<s32>& thread_ids, s64 target_duration_ns)
+{
+  const PerformanceHintApi& api = GetApi();
+  if (!api.manager || thread_ids.empty() || target_duration_ns <= 0)
+    return nullptr;
+
+  void* const session =
+      api.create_session(api.manager, thread_ids.data(), thread_ids.size(), target_duration_ns);
+  if (!session)
+    return nullptr;
+
+  std::unique_ptr<PerformanceHintSession> result(new PerformanceHintSession(session));
+  result->m_target_duration_ns = target_duration_ns;
+  return result;
+}
+
+PerformanceHintSession::PerformanceHintSession(void* session) : m_session(session)
+{
+}
+
+PerformanceHintSession::~PerformanceHintSession()
+{
+  GetApi().close_session(m_session);
+}
+
+void PerformanceHintSession::UpdateTargetWorkDuration(s64 target_duration_ns)
+{
+  if (target_duration_ns <= 0 || target_duration_ns == m_target_duration_ns)
+    return;
+
+  m_target_duration_ns = target_duration_ns;
+  GetApi().update_target_work_duration(m_session, target_duration_ns);
+}
+
+void PerformanceHintSession::ReportActualWorkDuration(s64 actual_duration_ns)
+{
+  // Durations must be positive, or the whole report is rejected.
+  if (actual_duration_ns > 0)
+    GetApi().report_actual_work_duration(m_session, actual_duration_ns);
+}
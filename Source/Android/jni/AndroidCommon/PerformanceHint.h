@@ -0,0 +1,32 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// An ADPF performance hint session, which lets the system pick the CPU frequencies and cores for
+// a set of threads based on how long their work takes compared to a target duration.
+class PerformanceHintSession
+{
+public:
+  // Returns nullptr if performance hints aren't supported, which is the case before Android 13.
+  static std::unique_ptr<PerformanceHintSession> Create(const std::vector<s32>& thread_ids,
+                                                        s64 target_duration_ns);
+
+  ~PerformanceHintSession();
+  PerformanceHintSession(const PerformanceHintSession&) = delete;
+  PerformanceHintSession& operator=(const PerformanceHintSession&) = delete;
+
+  void UpdateTargetWorkDuration(s64 target_duration_ns);
+  void ReportActualWorkDuration(s64 actual_duration_ns);
+
+private:
+  explicit PerformanceHintSession(void* session);
+
+  void* m_session;
+  s64 m_target_duration_ns = 0;
+};
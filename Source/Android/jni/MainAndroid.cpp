@@ -7,6 +7,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <jni.h>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -19,6 +20,7 @@
 #include "Common/CPUDetect.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/Flag.h"
@@ -26,6 +28,7 @@
 #include "Common/Logging/LogManager.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
+#include "Common/Thread.h"
 #include "Common/Version.h"
 #include "Common/WindowSystemInfo.h"
 
@@ -33,6 +36,7 @@
 #include "Core/BootManager.h"
 #include "Core/CommonTitles.h"
 #include "Core/ConfigLoaders/GameConfigLoader.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
@@ -43,6 +47,7 @@
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/PowerPC/Profiler.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/State.h"
 #include "Core/ARDecrypt.h"
 
@@ -59,6 +64,8 @@
 #include "UICommon/GameFile.h"
 #include "UICommon/UICommon.h"
 
+#include "VideoCommon/DrawCapture.h"
+#include "VideoCommon/DynamicResolution.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -466,6 +473,25 @@ JNIEXPORT void JNICALL Java_org_dolphinemu_dolphinemu_NativeLibrary_WriteProfile
   JitInterface::WriteProfileResults(filename);
 }
 
+JNIEXPORT jboolean JNICALL
+Java_org_dolphinemu_dolphinemu_NativeLibrary_StartSamplingProfiler(JNIEnv*, jclass)
+{
+  std::lock_guard<std::mutex> guard(s_host_identity_lock);
+  return static_cast<jboolean>(SamplingProfiler::Start());
+}
+
+JNIEXPORT void JNICALL Java_org_dolphinemu_dolphinemu_NativeLibrary_StopSamplingProfiler(JNIEnv*,
+                                                                                         jclass)
+{
+  std::lock_guard<std::mutex> guard(s_host_identity_lock);
+  SamplingProfiler::Stop();
+}
+
+JNIEXPORT void JNICALL Java_org_dolphinemu_dolphinemu_NativeLibrary_CaptureDraws(JNIEnv*, jclass)
+{
+  VideoCommon::g_draw_capture.Request();
+}
+
 // Surface Handling
 JNIEXPORT void JNICALL Java_org_dolphinemu_dolphinemu_NativeLibrary_SurfaceChanged(JNIEnv* env,
                                                                                    jclass,
@@ -473,10 +499,24 @@ JNIEXPORT void JNICALL Java_org_dolphinemu_dolphinemu_NativeLibrary_SurfaceChang
 {
   std::lock_guard<std::mutex> guard(s_surface_lock);
 
-  s_surf = ANativeWindow_fromSurface(env, surf);
-  if (s_surf == nullptr)
+  ANativeWindow* const new_surf = ANativeWindow_fromSurface(env, surf);
+  if (new_surf == nullptr)
     __android_log_print(ANDROID_LOG_ERROR, DOLPHIN_TAG, "Error: Surface is null.");
 
+  // When the device is rotated, the same surface is reported again with a new size. Only the swap
+  // chain has to follow the new size then, the window surface itself stays valid.
+  if (new_surf && new_surf == s_surf)
+  {
+    ANativeWindow_release(new_surf);
+    if (g_renderer)
+      g_renderer->ResizeSurface();
+    return;
+  }
+
+  if (s_surf)
+    ANativeWindow_release(s_surf);
+  s_surf = new_surf;
+
   if (g_renderer)
     g_renderer->ChangeSurface(s_surf);
 }
@@ -620,6 +660,45 @@ static float GetRenderSurfaceScale(JNIEnv* env)
   return env->CallStaticFloatMethod(native_library_class, get_render_surface_scale_method);
 }
 
+// Polls the thermal headroom for the thermal governor while a game is running.
+class ThermalMonitor
+{
+public:
+  ThermalMonitor() : m_thread(&ThermalMonitor::ThreadFunc, this) {}
+  ~ThermalMonitor()
+  {
+    m_stop.Set();
+    m_stop_event.Set();
+    m_thread.join();
+    DynamicResolution::SetThermalHeadroom(std::numeric_limits<float>::quiet_NaN());
+  }
+
+private:
+  void ThreadFunc()
+  {
+    Common::SetCurrentThreadName("Thermal monitor");
+
+    // The headroom is updated by the system about once per second, and asking for it more often
+    // only returns NaN.
+    static constexpr auto POLL_INTERVAL = std::chrono::seconds(1);
+    // Looking a bit ahead lowers the resolution before the device has actually heated up.
+    static constexpr int FORECAST_SECONDS = 10;
+
+    while (!m_stop.IsSet())
+    {
+      const float headroom = Config::Get(Config::GFX_THERMAL_GOVERNOR) ?
+                                 GetThermalHeadroom(FORECAST_SECONDS) :
+                                 std::numeric_limits<float>::quiet_NaN();
+      DynamicResolution::SetThermalHeadroom(headroom);
+      m_stop_event.WaitFor(POLL_INTERVAL);
+    }
+  }
+
+  Common::Flag m_stop;
+  Common::Event m_stop_event;
+  std::thread m_thread;
+};
+
 static void Run(JNIEnv* env, std::unique_ptr<BootParameters>&& boot, bool riivolution)
 {
   std::unique_lock<std::mutex> host_identity_guard(s_host_identity_lock);
@@ -669,6 +748,7 @@ static void Run(JNIEnv* env, std::unique_ptr<BootParameters>&& boot, bool riivol
 
   if (successful_boot)
   {
+    ThermalMonitor thermal_monitor;
     while (Core::IsRunningAndStarted())
     {
       host_identity_guard.unlock();
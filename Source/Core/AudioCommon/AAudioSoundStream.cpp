@@ -0,0 +1,271 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef ANDROID
+#include "AudioCommon/AAudioSoundStream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+
+#include <aaudio/AAudio.h>
+
+#include "Common/DynamicLibrary.h"
+#include "Common/Logging/Log.h"
+
+// The functions are declared by the NDK headers only when targeting Android 8.0 or newer, so their
+// types are spelled out here instead.
+#define AAUDIO_API_VISIT(X)                                                                        \
+  X(AAudio_convertResultToText, const char* (*)(aaudio_result_t))                                  \
+  X(AAudio_createStreamBuilder, aaudio_result_t (*)(AAudioStreamBuilder**))                        \
+  X(AAudioStreamBuilder_delete, aaudio_result_t (*)(AAudioStreamBuilder*))                         \
+  X(AAudioStreamBuilder_openStream, aaudio_result_t (*)(AAudioStreamBuilder*, AAudioStream**))     \
+  X(AAudioStreamBuilder_setChannelCount, void (*)(AAudioStreamBuilder*, int32_t))                  \
+  X(AAudioStreamBuilder_setDataCallback,                                                           \
+    void (*)(AAudioStreamBuilder*, AAudioStream_dataCallback, void*))                              \
+  X(AAudioStreamBuilder_setDirection, void (*)(AAudioStreamBuilder*, aaudio_direction_t))          \
+  X(AAudioStreamBuilder_setErrorCallback,                                                          \
+    void (*)(AAudioStreamBuilder*, AAudioStream_errorCallback, void*))                             \
+  X(AAudioStreamBuilder_setFormat, void (*)(AAudioStreamBuilder*, aaudio_format_t))                \
+  X(AAudioStreamBuilder_setPerformanceMode,                                                        \
+    void (*)(AAudioStreamBuilder*, aaudio_performance_mode_t))                                     \
+  X(AAudioStreamBuilder_setSampleRate, void (*)(AAudioStreamBuilder*, int32_t))                    \
+  X(AAudioStreamBuilder_setSharingMode, void (*)(AAudioStreamBuilder*, aaudio_sharing_mode_t))     \
+  X(AAudioStream_close, aaudio_result_t (*)(AAudioStream*))                                        \
+  X(AAudioStream_getBufferCapacityInFrames, int32_t (*)(AAudioStream*))                            \
+  X(AAudioStream_getBufferSizeInFrames, int32_t (*)(AAudioStream*))                                \
+  X(AAudioStream_getFramesPerBurst, int32_t (*)(AAudioStream*))                                    \
+  X(AAudioStream_getFramesWritten, int64_t (*)(AAudioStream*))                                     \
+  X(AAudioStream_getPerformanceMode, aaudio_performance_mode_t (*)(AAudioStream*))                 \
+  X(AAudioStream_getSampleRate, int32_t (*)(AAudioStream*))                                        \
+  X(AAudioStream_getSharingMode, aaudio_sharing_mode_t (*)(AAudioStream*))                         \
+  X(AAudioStream_getTimestamp, aaudio_result_t (*)(AAudioStream*, clockid_t, int64_t*, int64_t*))  \
+  X(AAudioStream_getXRunCount, int32_t (*)(AAudioStream*))                                         \
+  X(AAudioStream_requestStart, aaudio_result_t (*)(AAudioStream*))                                 \
+  X(AAudioStream_requestStop, aaudio_result_t (*)(AAudioStream*))                                  \
+  X(AAudioStream_setBufferSizeInFrames, aaudio_result_t (*)(AAudioStream*, int32_t))
+
+#define DYN_FUNC_DECLARE(func, type)                                                               \
+  using func##_t = type;                                                                           \
+  static func##_t p##func = nullptr;
+
+#define AAUDIO_FUNC_LOAD(func, type)                                                               \
+  if (!s_aaudio_library.GetSymbol(#func, &p##func))                                                \
+    return false;
+
+AAUDIO_API_VISIT(DYN_FUNC_DECLARE);
+
+static Common::DynamicLibrary s_aaudio_library;
+
+static bool InitFunctions()
+{
+  AAUDIO_API_VISIT(AAUDIO_FUNC_LOAD);
+  return true;
+}
+
+static bool InitLibrary()
+{
+  if (s_aaudio_library.IsOpen())
+    return true;
+
+  if (!s_aaudio_library.Open("libaaudio.so"))
+    return false;
+
+  if (!InitFunctions())
+  {
+    s_aaudio_library.Close();
+    return false;
+  }
+
+  return true;
+}
+
+bool AAudioSound::IsValid()
+{
+  return InitLibrary();
+}
+
+bool AAudioSound::Init()
+{
+  if (!InitLibrary())
+    return false;
+
+  std::lock_guard lk(m_stream_mutex);
+  return OpenStream();
+}
+
+AAudioSound::~AAudioSound()
+{
+  {
+    std::lock_guard lk(m_stream_mutex);
+    m_shutting_down = true;
+    CloseStream();
+  }
+
+  if (m_restart_thread.joinable())
+    m_restart_thread.join();
+}
+
+bool AAudioSound::OpenStream()
+{
+  AAudioStreamBuilder* builder;
+  aaudio_result_t result = pAAudio_createStreamBuilder(&builder);
+  if (result != AAUDIO_OK)
+  {
+    ERROR_LOG_FMT(AUDIO, "AAudio: Failed to create stream builder: {}",
+                  pAAudio_convertResultToText(result));
+    return false;
+  }
+
+  // Exclusive mode gives the stream its own path to the DSP if the device has one to spare, and
+  // otherwise silently falls back to sharing the mixer.
+  pAAudioStreamBuilder_setDirection(builder, AAUDIO_DIRECTION_OUTPUT);
+  pAAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_EXCLUSIVE);
+  pAAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+  pAAudioStreamBuilder_setFormat(builder, AAUDIO_FORMAT_PCM_I16);
+  pAAudioStreamBuilder_setChannelCount(builder, 2);
+  pAAudioStreamBuilder_setSampleRate(builder, m_mixer->GetSampleRate());
+  pAAudioStreamBuilder_setDataCallback(builder, DataCallback, this);
+  pAAudioStreamBuilder_setErrorCallback(builder, ErrorCallback, this);
+
+  AAudioStream* stream;
+  result = pAAudioStreamBuilder_openStream(builder, &stream);
+  pAAudioStreamBuilder_delete(builder);
+  if (result != AAUDIO_OK)
+  {
+    ERROR_LOG_FMT(AUDIO, "AAudio: Failed to open stream: {}", pAAudio_convertResultToText(result));
+    return false;
+  }
+
+  // The device consumes whole bursts, so the buffer starts out at two of them: one being played
+  // while the mixer fills the other. It only grows if the callback turns out to be late.
+  m_frames_per_burst = std::max(pAAudioStream_getFramesPerBurst(stream), 1);
+  m_buffer_capacity = pAAudioStream_getBufferCapacityInFrames(stream);
+  m_xrun_count = 0;
+  pAAudioStream_setBufferSizeInFrames(stream, std::min(m_frames_per_burst * 2, m_buffer_capacity));
+
+  INFO_LOG_FMT(AUDIO, "AAudio: Opened {} stream at {} Hz, {} frames per burst, low latency: {}",
+               pAAudioStream_getSharingMode(stream) == AAUDIO_SHARING_MODE_EXCLUSIVE ? "exclusive" :
+                                                                                      "shared",
+               pAAudioStream_getSampleRate(stream), m_frames_per_burst,
+               pAAudioStream_getPerformanceMode(stream) == AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+
+  m_stream = stream;
+  if (m_running)
+    pAAudioStream_requestStart(m_stream);
+
+  return true;
+}
+
+void AAudioSound::CloseStream()
+{
+  if (!m_stream)
+    return;
+
+  // Closing waits for a running data callback to return.
+  pAAudioStream_requestStop(m_stream);
+  pAAudioStream_close(m_stream);
+  m_stream = nullptr;
+}
+
+void AAudioSound::RestartStream()
+{
+  std::lock_guard lk(m_stream_mutex);
+  if (m_shutting_down)
+    return;
+
+  CloseStream();
+  if (!OpenStream())
+    ERROR_LOG_FMT(AUDIO, "AAudio: Failed to reopen the stream, audio output is stopped");
+}
+
+bool AAudioSound::SetRunning(bool running)
+{
+  std::lock_guard lk(m_stream_mutex);
+  m_running = running;
+  if (!m_stream)
+    return false;
+
+  const aaudio_result_t result =
+      running ? pAAudioStream_requestStart(m_stream) : pAAudioStream_requestStop(m_stream);
+  return result == AAUDIO_OK;
+}
+
+void AAudioSound::SetVolume(int volume)
+{
+  m_volume.store(volume, std::memory_order_relaxed);
+}
+
+float AAudioSound::GetOutputLatency() const
+{
+  std::lock_guard lk(m_stream_mutex);
+  if (!m_stream)
+    return 0.0f;
+
+  // The timestamp tells when a frame that was written earlier was presented, from which the time
+  // at which the frame that is written next will be presented follows.
+  int64_t frame_position;
+  int64_t time_ns;
+  if (pAAudioStream_getTimestamp(m_stream, CLOCK_MONOTONIC, &frame_position, &time_ns) !=
+      AAUDIO_OK)
+  {
+    return 0.0f;
+  }
+
+  const int64_t frames_written = pAAudioStream_getFramesWritten(m_stream);
+  const int64_t sample_rate = pAAudioStream_getSampleRate(m_stream);
+  const int64_t presentation_ns =
+      time_ns + (frames_written - frame_position) * 1'000'000'000 / sample_rate;
+  const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now().time_since_epoch())
+                             .count();
+  return std::max<int64_t>(presentation_ns - now_ns, 0) / 1'000'000.0f;
+}
+
+s32 AAudioSound::DataCallback(AAudioStream* stream, void* user_data, void* audio_data,
+                              s32 num_frames)
+{
+  AAudioSound* self = static_cast<AAudioSound*>(user_data);
+  short* samples = static_cast<short*>(audio_data);
+  self->m_mixer->Mix(samples, num_frames);
+
+  const int volume = self->m_volume.load(std::memory_order_relaxed);
+  if (volume != 100)
+  {
+    for (s32 i = 0; i < num_frames * 2; ++i)
+      samples[i] = static_cast<short>(samples[i] * volume / 100);
+  }
+
+  // Every underrun means that the callback ran too late for the buffered bursts, most likely
+  // because the thread was preempted, so one more burst is buffered from then on.
+  const s32 xrun_count = pAAudioStream_getXRunCount(stream);
+  if (xrun_count > self->m_xrun_count)
+  {
+    self->m_xrun_count = xrun_count;
+    const s32 buffer_size = pAAudioStream_getBufferSizeInFrames(stream);
+    if (buffer_size + self->m_frames_per_burst <= self->m_buffer_capacity)
+    {
+      pAAudioStream_setBufferSizeInFrames(stream, buffer_size + self->m_frames_per_burst);
+      WARN_LOG_FMT(AUDIO, "AAudio: Underrun, buffering {} frames",
+                   buffer_size + self->m_frames_per_burst);
+    }
+  }
+
+  return AAUDIO_CALLBACK_RESULT_CONTINUE;
+}
+
+void AAudioSound::ErrorCallback(AAudioStream* stream, void* user_data, s32 error)
+{
+  AAudioSound* self = static_cast<AAudioSound*>(user_data);
+  WARN_LOG_FMT(AUDIO, "AAudio: Stream error: {}", pAAudio_convertResultToText(error));
+
+  // A disconnected stream, e.g. because headphones were plugged in, has to be replaced by one for
+  // the new device. That can't be done from the callback thread.
+  if (error != AAUDIO_ERROR_DISCONNECTED)
+    return;
+
+  if (self->m_restart_thread.joinable())
+    self->m_restart_thread.join();
+  self->m_restart_thread = std::thread(&AAudioSound::RestartStream, self);
+}
+#endif
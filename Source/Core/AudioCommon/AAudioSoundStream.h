@@ -0,0 +1,56 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#ifdef ANDROID
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "Common/CommonTypes.h"
+#endif
+
+#include "AudioCommon/SoundStream.h"
+
+#ifdef ANDROID
+struct AAudioStreamStruct;
+#endif
+
+// Low latency output through AAudio, which is only available on Android 8.0 and newer. libaaudio is
+// loaded at runtime so that older devices can still fall back to OpenSL ES.
+class AAudioSound final : public SoundStream
+{
+#ifdef ANDROID
+public:
+  ~AAudioSound() override;
+  bool Init() override;
+  bool SetRunning(bool running) override;
+  void SetVolume(int volume) override;
+  float GetOutputLatency() const override;
+  static bool IsValid();
+
+private:
+  bool OpenStream();
+  void CloseStream();
+  void RestartStream();
+
+  static s32 DataCallback(AAudioStreamStruct* stream, void* user_data, void* audio_data,
+                          s32 num_frames);
+  static void ErrorCallback(AAudioStreamStruct* stream, void* user_data, s32 error);
+
+  // Guards m_stream against being reopened while it's in use outside of the callbacks.
+  mutable std::mutex m_stream_mutex;
+  AAudioStreamStruct* m_stream = nullptr;
+  bool m_running = false;
+  bool m_shutting_down = false;
+
+  // Only accessed by the data callback, apart from when the stream is opened.
+  s32 m_frames_per_burst = 0;
+  s32 m_buffer_capacity = 0;
+  s32 m_xrun_count = 0;
+
+  std::atomic<int> m_volume{100};
+  std::thread m_restart_thread;
+#endif  // ANDROID
+};
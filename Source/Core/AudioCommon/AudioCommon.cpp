@@ -6,6 +6,7 @@
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 
+#include "AudioCommon/AAudioSoundStream.h"
 #include "AudioCommon/AlsaSoundStream.h"
 #include "AudioCommon/CubebStream.h"
 #include "AudioCommon/Mixer.h"
@@ -40,6 +41,8 @@ static std::unique_ptr<SoundStream> CreateSoundStreamForBackend(std::string_view
     return std::make_unique<PulseAudio>();
   else if (backend == BACKEND_OPENSLES && OpenSLESStream::IsValid())
     return std::make_unique<OpenSLESStream>();
+  else if (backend == BACKEND_AAUDIO && AAudioSound::IsValid())
+    return std::make_unique<AAudioSound>();
   else if (backend == BACKEND_WASAPI && WASAPIStream::IsValid())
     return std::make_unique<WASAPIStream>();
   return {};
@@ -96,7 +99,7 @@ std::string GetDefaultSoundBackend()
 {
   std::string backend = BACKEND_NULLSOUND;
 #if defined ANDROID
-  backend = BACKEND_OPENSLES;
+  backend = AAudioSound::IsValid() ? BACKEND_AAUDIO : BACKEND_OPENSLES;
 #elif defined __linux__
   if (AlsaSound::IsValid())
     backend = BACKEND_ALSA;
@@ -125,6 +128,8 @@ std::vector<std::string> GetSoundBackends()
     backends.emplace_back(BACKEND_OPENAL);
   if (OpenSLESStream::IsValid())
     backends.emplace_back(BACKEND_OPENSLES);
+  if (AAudioSound::IsValid())
+    backends.emplace_back(BACKEND_AAUDIO);
   if (WASAPIStream::IsValid())
     backends.emplace_back(BACKEND_WASAPI);
 
@@ -154,7 +159,8 @@ bool SupportsVolumeChanges(std::string_view backend)
   // FIXME: this one should ask the backend whether it supports it.
   //       but getting the backend from string etc. is probably
   //       too much just to enable/disable a stupid slider...
-  return backend == BACKEND_CUBEB || backend == BACKEND_OPENAL || backend == BACKEND_WASAPI;
+  return backend == BACKEND_CUBEB || backend == BACKEND_OPENAL || backend == BACKEND_WASAPI ||
+         backend == BACKEND_AAUDIO;
 }
 
 void UpdateSoundStream(Core::System& system)
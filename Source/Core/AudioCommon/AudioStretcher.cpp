@@ -23,6 +23,7 @@ AudioStretcher::AudioStretcher(unsigned int sample_rate) : m_sample_rate(sample_
 void AudioStretcher::Clear()
 {
   m_sound_touch.clear();
+  m_buffer_read.store(m_buffer_write.load());
 }
 
 void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out)
@@ -34,7 +35,10 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
 
   const double max_latency = Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY);
   const double max_backlog = m_sample_rate * max_latency / 1000.0 / m_stretch_ratio;
-  const double backlog_fullness = m_sound_touch.numSamples() / max_backlog;
+  // The samples that were already stretched but not played yet are part of the backlog too.
+  const u32 buffered = m_buffer_write.load(std::memory_order_relaxed) -
+                       m_buffer_read.load(std::memory_order_acquire);
+  const double backlog_fullness = (m_sound_touch.numSamples() + buffered) / max_backlog;
   if (backlog_fullness > 5.0)
   {
     // Too many samples in backlog: Don't push anymore on
@@ -64,9 +68,42 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
   m_sound_touch.putSamples(in, num_in);
 }
 
+void AudioStretcher::BufferStretchedSamples(unsigned int lookahead)
+{
+  const u32 write = m_buffer_write.load(std::memory_order_relaxed);
+  const u32 buffered = write - m_buffer_read.load(std::memory_order_acquire);
+  const u32 wanted = std::min(lookahead, MAX_BUFFERED_SAMPLES);
+  if (buffered >= wanted)
+    return;
+
+  // SoundTouch hands out at most the requested number of samples, which may wrap around the end
+  // of the buffer.
+  u32 received = 0;
+  while (received < wanted - buffered)
+  {
+    const u32 index = (write + received) & BUFFER_MASK;
+    const u32 count = std::min(wanted - buffered - received, MAX_BUFFERED_SAMPLES - index);
+    const u32 count_received =
+        static_cast<u32>(m_sound_touch.receiveSamples(&m_buffer[index * 2], count));
+    received += count_received;
+    if (count_received != count)
+      break;
+  }
+
+  m_buffer_write.store(write + received, std::memory_order_release);
+}
+
 void AudioStretcher::GetStretchedSamples(short* out, unsigned int num_out)
 {
-  const size_t samples_received = m_sound_touch.receiveSamples(out, num_out);
+  const u32 read = m_buffer_read.load(std::memory_order_relaxed);
+  const u32 available = m_buffer_write.load(std::memory_order_acquire) - read;
+  const u32 samples_received = std::min(available, num_out);
+
+  const u32 index = read & BUFFER_MASK;
+  const u32 first_part = std::min(samples_received, MAX_BUFFERED_SAMPLES - index);
+  std::copy_n(&m_buffer[index * 2], first_part * 2, out);
+  std::copy_n(&m_buffer[0], (samples_received - first_part) * 2, out + first_part * 2);
+  m_buffer_read.store(read + samples_received, std::memory_order_release);
 
   if (samples_received != 0)
   {
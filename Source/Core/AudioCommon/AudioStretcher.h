@@ -4,24 +4,43 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 
 #include <SoundTouch.h>
 
+#include "Common/CommonTypes.h"
+
 namespace AudioCommon
 {
 class AudioStretcher
 {
 public:
   explicit AudioStretcher(unsigned int sample_rate);
+
+  // Called from the stretching thread. The stretched samples are buffered until up to lookahead
+  // samples are ready to be played.
   void ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out);
+  void BufferStretchedSamples(unsigned int lookahead);
+
+  // Called from the audio thread. Only copies out samples that have already been stretched.
   void GetStretchedSamples(short* out, unsigned int num_out);
+
+  // Must not be called while the stretching thread is using the stretcher.
   void Clear();
 
 private:
+  static constexpr u32 MAX_BUFFERED_SAMPLES = 1024 * 8;
+  static constexpr u32 BUFFER_MASK = MAX_BUFFERED_SAMPLES - 1;
+
   unsigned int m_sample_rate;
   std::array<short, 2> m_last_stretched_sample = {};
   soundtouch::SoundTouch m_sound_touch;
   double m_stretch_ratio = 1.0;
+
+  // Stereo samples, indexed by sample count.
+  std::array<short, MAX_BUFFERED_SAMPLES * 2> m_buffer{};
+  alignas(64) std::atomic<u32> m_buffer_write{0};
+  alignas(64) std::atomic<u32> m_buffer_read{0};
 };
 
 }  // namespace AudioCommon
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstring>
 
 #include "AudioCommon/Enums.h"
@@ -12,6 +13,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 
@@ -38,11 +40,18 @@ Mixer::Mixer(unsigned int BackendSampleRate)
   m_config_changed_callback_id = Config::AddConfigChangedCallback([this] { RefreshConfig(); });
   RefreshConfig();
 
+  m_stretch_thread_running.Set();
+  m_stretch_thread = std::thread(&Mixer::StretchingThread, this);
+
   INFO_LOG_FMT(AUDIO_INTERFACE, "Mixer is initialized");
 }
 
 Mixer::~Mixer()
 {
+  m_stretch_thread_running.Clear();
+  m_stretch_event.Set();
+  m_stretch_thread.join();
+
   Config::RemoveConfigChangedCallback(m_config_changed_callback_id);
 }
 
@@ -60,8 +69,6 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
                                    bool consider_framelimit, float emulationspeed,
                                    int timing_variance)
 {
-  unsigned int currentSample = 0;
-
   // Cache access in non-volatile variable
   // This is the only function changing the read value, so it's safe to
   // cache it locally although it's written here.
@@ -69,8 +76,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   // so we will just ignore new written data while interpolating.
   // Without this cache, the compiler wouldn't be allowed to optimize the
   // interpolation loop.
-  u32 indexR = m_indexR.load();
-  u32 indexW = m_indexW.load();
+  u32 indexR = m_indexR.load(std::memory_order_relaxed);
+  u32 indexW = m_indexW.load(std::memory_order_acquire);
 
   // render numleft sample pairs to samples[]
   // advance indexR with sample position
@@ -105,32 +112,65 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  // Only output samples for which all input samples that the resampler reads are available can be
+  // rendered. m_frac is the position between the sample at indexR and the next one.
+  constexpr u32 history = AudioCommon::Resampler::POLYPHASE_HISTORY;
+  const bool high_quality = m_mixer->m_config_high_quality_resampling;
+  const u32 lookahead = GetResamplerLookahead();
+  const u32 available = ((indexW - indexR) & INDEX_MASK) / 2;
+  u32 num_frames = 0;
+  if (available > lookahead)
+  {
+    const u64 end = static_cast<u64>(available - lookahead) << 16;
+    if (end > m_frac)
+    {
+      num_frames = ratio == 0 ? numSamples :
+                                static_cast<u32>(std::min<u64>(
+                                    numSamples, (end - m_frac + ratio - 1) / ratio));
+    }
+  }
+
+  const u64 end_position = m_frac + static_cast<u64>(num_frames) * ratio;
+  const u32 consumed = static_cast<u32>(std::min<u64>(end_position >> 16, available));
+  u32 needed = consumed;
+  if (num_frames != 0)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    const u64 last_position = m_frac + static_cast<u64>(num_frames - 1) * ratio;
+    needed = std::max(needed, static_cast<u32>(last_position >> 16) + lookahead + 1);
   }
+  needed = std::min(needed, available);
+
+  // The resamplers work on contiguous native endian samples, so they're copied out of the ring
+  // buffer, following the history that is kept from before indexR. The channels are swapped on the
+  // way, as the sound backends expect right before left.
+  short* const frames = m_frames.data() + history * 2;
+  for (u32 i = 0; i < needed; ++i)
+  {
+    const u32 index = (indexR + i * 2) & INDEX_MASK;
+    frames[i * 2] = read_buffer(index + 1);
+    frames[i * 2 + 1] = read_buffer(index);
+  }
+
+  if (high_quality)
+  {
+    AudioCommon::Resampler::MixPolyphase(frames, m_frac, ratio, num_frames, rvolume, lvolume,
+                                         samples);
+  }
+  else
+  {
+    AudioCommon::Resampler::MixLinear(frames, m_frac, ratio, num_frames, rvolume, lvolume,
+                                      samples);
+  }
+
+  // The samples before the new read position are the history of the next call.
+  const short* const new_history = frames + (static_cast<std::ptrdiff_t>(consumed) - history) * 2;
+  std::memmove(m_frames.data(), new_history, history * 2 * sizeof(short));
+  indexR += consumed * 2;
+  m_frac = consumed == (end_position >> 16) ? static_cast<u32>(end_position & 0xffff) : 0;
+  unsigned int currentSample = num_frames * 2;
 
   // Actual number of samples written to the buffer without padding.
-  unsigned int actual_sample_count = currentSample / 2;
+  unsigned int actual_sample_count = num_frames;
 
   // Padding
   short s[2];
@@ -148,7 +188,7 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   }
 
   // Flush cached variable
-  m_indexR.store(indexR);
+  m_indexR.store(indexR, std::memory_order_release);
 
   return actual_sample_count;
 }
@@ -160,53 +200,106 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
 
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
-  const float emulation_speed = m_config_emulation_speed;
-  const int timing_variance = m_config_timing_variance;
   if (m_config_audio_stretch)
   {
-    unsigned int available_samples =
-        std::min(m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples());
-
-    ASSERT_MSG(AUDIO, available_samples <= MAX_SAMPLES,
-               "Audio stretching would overflow m_scratch_buffer: min({}, {}) -> {} > {} ({})",
-               m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples(),
-               available_samples, MAX_SAMPLES, num_samples);
-
-    m_scratch_buffer.fill(0);
-
-    m_dma_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                    timing_variance);
-    m_streaming_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                          timing_variance);
-    m_wiimote_speaker_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                timing_variance);
-    for (auto& mixer : m_gba_mixers)
-    {
-      mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                timing_variance);
-    }
-
     if (!m_is_stretching)
     {
+      // The stretching thread may still be finishing up from before stretching was last disabled.
+      if (m_stretch_thread_busy.load())
+        return num_samples;
+
       m_stretcher.Clear();
+      m_stretch_requested_samples.store(0);
+      m_stretch_active.store(true);
       m_is_stretching = true;
     }
-    m_stretcher.ProcessSamples(m_scratch_buffer.data(), available_samples, num_samples);
+
+    // Ask for the samples that are being played now to be replaced, plus one more callback's worth
+    // so that the next callback doesn't have to wait for the stretching thread.
+    m_stretch_lookahead.store(num_samples * 2, std::memory_order_relaxed);
     m_stretcher.GetStretchedSamples(samples, num_samples);
+    m_stretch_requested_samples.fetch_add(num_samples);
+    m_stretch_event.Set();
+    return num_samples;
   }
-  else
+
+  if (m_is_stretching)
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    for (auto& mixer : m_gba_mixers)
-      mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    m_stretch_active.store(false);
     m_is_stretching = false;
   }
 
+  // Leave the FIFOs alone until the stretching thread has let go of them. This pairs with the
+  // checks in StretchingThread, so at least one of the two threads sees the other.
+  if (m_stretch_thread_busy.load())
+    return num_samples;
+
+  const float emulation_speed = m_config_emulation_speed;
+  const int timing_variance = m_config_timing_variance;
+  m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+  m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+  m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+  for (auto& mixer : m_gba_mixers)
+    mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+
   return num_samples;
 }
 
+void Mixer::StretchingThread()
+{
+  Common::SetCurrentThreadName("Audio Stretching");
+
+  while (true)
+  {
+    m_stretch_event.Wait();
+    if (!m_stretch_thread_running.IsSet())
+      break;
+
+    m_stretch_thread_busy.store(true);
+    if (!m_stretch_active.load())
+    {
+      m_stretch_thread_busy.store(false);
+      continue;
+    }
+
+    // The number of samples the audio thread played since the last run, which is what the rate
+    // of the input is compared against.
+    const u32 num_samples = m_stretch_requested_samples.exchange(0);
+    if (num_samples != 0)
+    {
+      const float emulation_speed = m_config_emulation_speed;
+      const int timing_variance = m_config_timing_variance;
+      unsigned int available_samples =
+          std::min(m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples());
+
+      ASSERT_MSG(AUDIO, available_samples <= MAX_SAMPLES,
+                 "Audio stretching would overflow m_stretch_buffer: min({}, {}) -> {} > {} ({})",
+                 m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples(),
+                 available_samples, MAX_SAMPLES, num_samples);
+      available_samples = std::min(available_samples, MAX_SAMPLES);
+
+      m_stretch_buffer.fill(0);
+
+      m_dma_mixer.Mix(m_stretch_buffer.data(), available_samples, false, emulation_speed,
+                      timing_variance);
+      m_streaming_mixer.Mix(m_stretch_buffer.data(), available_samples, false, emulation_speed,
+                            timing_variance);
+      m_wiimote_speaker_mixer.Mix(m_stretch_buffer.data(), available_samples, false,
+                                  emulation_speed, timing_variance);
+      for (auto& mixer : m_gba_mixers)
+      {
+        mixer.Mix(m_stretch_buffer.data(), available_samples, false, emulation_speed,
+                  timing_variance);
+      }
+
+      m_stretcher.ProcessSamples(m_stretch_buffer.data(), available_samples, num_samples);
+    }
+
+    m_stretcher.BufferStretchedSamples(m_stretch_lookahead.load(std::memory_order_relaxed));
+    m_stretch_thread_busy.store(false);
+  }
+}
+
 unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 {
   if (!num_samples)
@@ -238,31 +331,33 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 
 void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_samples)
 {
-  // Cache access in non-volatile variable
-  // indexR isn't allowed to cache in the audio throttling loop as it
-  // needs to get updates to not deadlock.
-  u32 indexW = m_indexW.load();
+  const u32 indexW = m_pending_indexW;
+  const u32 count = num_samples * 2;
 
   // Check if we have enough free space
-  // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
-    return;
+  // indexW == indexR results in empty buffer, so indexR must always be smaller than indexW.
+  // m_indexR is only read again once the buffer looks full, as every read has to fetch the cache
+  // line from the audio thread.
+  if (count + ((indexW - m_cached_indexR) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  {
+    m_cached_indexR = m_indexR.load(std::memory_order_acquire);
+    if (count + ((indexW - m_cached_indexR) & INDEX_MASK) >= MAX_SAMPLES * 2)
+      return;
+  }
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
   // to alleviate the workload on main thread
   // and we simply store raw data here to make fast mem copy
-  int over_bytes = num_samples * 4 - (MAX_SAMPLES * 2 - (indexW & INDEX_MASK)) * sizeof(short);
-  if (over_bytes > 0)
-  {
-    memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4 - over_bytes);
-    memcpy(&m_buffer[0], samples + (num_samples * 4 - over_bytes) / sizeof(short), over_bytes);
-  }
-  else
-  {
-    memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
-  }
-
-  m_indexW.fetch_add(num_samples * 2);
+  const u32 start = indexW & INDEX_MASK;
+  const u32 first_part = std::min(count, MAX_SAMPLES * 2 - start);
+  std::memcpy(&m_buffer[start], samples, first_part * sizeof(short));
+  std::memcpy(&m_buffer[0], samples + first_part, (count - first_part) * sizeof(short));
+  m_pending_indexW = indexW + count;
+
+  // The audio DMA delivers just 8 samples at a time, so publishing every push would hand the cache
+  // line back and forth between the threads thousands of times per second for no benefit.
+  if (m_pending_indexW - m_indexW.load(std::memory_order_relaxed) >= PUBLISH_SAMPLES * 2)
+    m_indexW.store(m_pending_indexW, std::memory_order_release);
 }
 
 void Mixer::PushSamples(const short* samples, unsigned int num_samples)
@@ -427,6 +522,7 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_high_quality_resampling = Config::Get(Config::MAIN_AUDIO_HIGH_QUALITY_RESAMPLING);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
@@ -457,11 +553,20 @@ std::pair<s32, s32> Mixer::MixerFifo::GetVolume() const
   return std::make_pair(m_LVolume.load(), m_RVolume.load());
 }
 
+u32 Mixer::MixerFifo::GetResamplerLookahead() const
+{
+  return m_mixer->m_config_high_quality_resampling ?
+             AudioCommon::Resampler::POLYPHASE_LOOKAHEAD :
+             AudioCommon::Resampler::LINEAR_LOOKAHEAD;
+}
+
 unsigned int Mixer::MixerFifo::AvailableSamples() const
 {
-  unsigned int samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
-  if (samples_in_fifo <= 1)
-    return 0;  // Mixer::MixerFifo::Mix always keeps one sample in the buffer.
-  return (samples_in_fifo - 1) * static_cast<u64>(m_mixer->m_sampleRate) *
+  // Mixer::MixerFifo::Mix always keeps the samples the resampler looks ahead at in the buffer.
+  const unsigned int samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
+  const u32 lookahead = GetResamplerLookahead();
+  if (samples_in_fifo <= lookahead)
+    return 0;
+  return (samples_in_fifo - lookahead) * static_cast<u64>(m_mixer->m_sampleRate) *
          m_input_sample_rate_divisor / FIXED_SAMPLE_RATE_DIVIDEND;
 }
@@ -5,11 +5,15 @@
 
 #include <array>
 #include <atomic>
+#include <thread>
 
 #include "AudioCommon/AudioStretcher.h"
+#include "AudioCommon/Resampler.h"
 #include "AudioCommon/SurroundDecoder.h"
 #include "AudioCommon/WaveFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 
 class PointerWrap;
 
@@ -57,6 +61,8 @@ public:
 private:
   static constexpr u32 MAX_SAMPLES = 1024 * 4;  // 128 ms
   static constexpr u32 INDEX_MASK = MAX_SAMPLES * 2 - 1;
+  // Pushed samples are made visible to the audio thread in batches of at least this many.
+  static constexpr u32 PUBLISH_SAMPLES = 32;  // 1 ms at 32000 Hz
   static constexpr int MAX_FREQ_SHIFT = 200;  // Per 32000 Hz
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
@@ -82,20 +88,33 @@ private:
     unsigned int AvailableSamples() const;
 
   private:
+    u32 GetResamplerLookahead() const;
+
     Mixer* m_mixer;
     unsigned m_input_sample_rate_divisor;
     bool m_little_endian;
-    std::array<short, MAX_SAMPLES * 2> m_buffer{};
-    std::atomic<u32> m_indexW{0};
-    std::atomic<u32> m_indexR{0};
     // Volume ranges from 0-256
     std::atomic<s32> m_LVolume{256};
     std::atomic<s32> m_RVolume{256};
+    std::array<short, MAX_SAMPLES * 2> m_buffer{};
+
+    // Owned by the emulation thread, and kept on a separate cache line from the state of the audio
+    // thread. m_pending_indexW runs ahead of m_indexW by the samples that haven't been published
+    // yet, and m_cached_indexR is the last value of m_indexR that was seen.
+    alignas(64) std::atomic<u32> m_indexW{0};
+    u32 m_pending_indexW = 0;
+    u32 m_cached_indexR = 0;
+
+    // Owned by the audio thread.
+    alignas(64) std::atomic<u32> m_indexR{0};
     float m_numLeftI = 0.0f;
     u32 m_frac = 0;
+    // Native endian copy of the samples being resampled, starting with the ones before m_indexR.
+    std::array<short, (AudioCommon::Resampler::POLYPHASE_HISTORY + MAX_SAMPLES) * 2> m_frames{};
   };
 
   void RefreshConfig();
+  void StretchingThread();
 
   MixerFifo m_dma_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 32000, false};
   MixerFifo m_streaming_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 48000, false};
@@ -106,8 +125,20 @@ private:
                                         MixerFifo{this, FIXED_SAMPLE_RATE_DIVIDEND / 48000, true}};
   unsigned int m_sampleRate;
 
+  // Stretching runs on its own thread, which mixes the FIFOs into m_stretch_buffer and feeds the
+  // result to m_stretcher, so that Mix only has to copy out the stretched samples. Only one thread
+  // may mix the FIFOs at a time: the stretching thread while m_stretch_active is set, and the audio
+  // thread otherwise, once m_stretch_thread_busy is clear.
   bool m_is_stretching = false;
   AudioCommon::AudioStretcher m_stretcher;
+  std::array<short, MAX_SAMPLES * 2> m_stretch_buffer{};
+  std::thread m_stretch_thread;
+  Common::Event m_stretch_event;
+  Common::Flag m_stretch_thread_running;
+  std::atomic<bool> m_stretch_active{false};
+  std::atomic<bool> m_stretch_thread_busy{false};
+  std::atomic<u32> m_stretch_requested_samples{0};
+  std::atomic<u32> m_stretch_lookahead{0};
   AudioCommon::SurroundDecoder m_surround_decoder;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
 
@@ -123,6 +154,7 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  bool m_config_high_quality_resampling;
 
   size_t m_config_changed_callback_id;
 };
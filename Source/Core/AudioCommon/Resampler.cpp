@@ -0,0 +1,343 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/Resampler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "Common/Intrinsics.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+namespace AudioCommon::Resampler
+{
+namespace
+{
+constexpr u32 TAPS = POLYPHASE_HISTORY + POLYPHASE_LOOKAHEAD + 1;
+constexpr u32 PHASE_BITS = 8;
+constexpr u32 PHASES = 1 << PHASE_BITS;
+
+// Linear interpolation weights have 14 bits, so that both weights of a pair fit in an s16.
+constexpr s32 LINEAR_ONE = 1 << 14;
+
+using PolyphaseTable = std::array<std::array<s16, TAPS>, PHASES>;
+
+const PolyphaseTable& GetPolyphaseTable()
+{
+  static const PolyphaseTable table = [] {
+    // A Blackman windowed sinc with its cutoff a bit below the Nyquist frequency of the input, as
+    // the mixer mostly upsamples.
+    constexpr double CUTOFF = 0.9;
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double HALF_WIDTH = TAPS / 2.0;
+
+    PolyphaseTable result{};
+    for (u32 phase = 0; phase < PHASES; ++phase)
+    {
+      std::array<double, TAPS> weights;
+      double sum = 0.0;
+      for (u32 tap = 0; tap < TAPS; ++tap)
+      {
+        const double x =
+            static_cast<double>(tap) - POLYPHASE_HISTORY - static_cast<double>(phase) / PHASES;
+        const double sinc = x == 0.0 ? 1.0 : std::sin(PI * CUTOFF * x) / (PI * CUTOFF * x);
+        const double window = 0.42 + 0.5 * std::cos(PI * x / HALF_WIDTH) +
+                              0.08 * std::cos(2.0 * PI * x / HALF_WIDTH);
+        weights[tap] = sinc * window;
+        sum += weights[tap];
+      }
+
+      // Every phase sums up to exactly 1.0 so that constant input stays constant. The rounding
+      // error goes to the largest tap, where it matters least.
+      s32 total = 0;
+      u32 largest = 0;
+      for (u32 tap = 0; tap < TAPS; ++tap)
+      {
+        result[phase][tap] = static_cast<s16>(std::lround(weights[tap] / sum * 32768.0));
+        total += result[phase][tap];
+        if (std::abs(result[phase][tap]) > std::abs(result[phase][largest]))
+          largest = tap;
+      }
+      result[phase][largest] += static_cast<s16>(32768 - total);
+    }
+    return result;
+  }();
+  return table;
+}
+
+// The filter of a frame starts POLYPHASE_HISTORY frames before it.
+const s16* GetPolyphaseFrames(const s16* in, u32 position)
+{
+  return in + (static_cast<std::ptrdiff_t>(position >> 16) - POLYPHASE_HISTORY) * 2;
+}
+
+u32 GetPhase(u32 position)
+{
+  return (position & 0xffff) >> (16 - PHASE_BITS);
+}
+
+s16 LinearWeight(u32 position)
+{
+  return static_cast<s16>((position & 0xffff) >> 2);
+}
+
+// Applies the volume to a resampled frame and adds it to the output.
+void AddFrame(s16* out, s32 sample0, s32 sample1, s32 volume0, s32 volume1)
+{
+  sample0 = (std::clamp(sample0, -32768, 32767) * volume0) >> 8;
+  sample1 = (std::clamp(sample1, -32768, 32767) * volume1) >> 8;
+  out[0] = static_cast<s16>(std::clamp(out[0] + sample0, -32767, 32767));
+  out[1] = static_cast<s16>(std::clamp(out[1] + sample1, -32767, 32767));
+}
+
+void MixLinearFrames(const s16* in, u32 position, u32 step, u32 first, u32 num_frames,
+                     s32 volume0, s32 volume1, s16* out)
+{
+  for (u32 i = first; i < num_frames; ++i)
+  {
+    const u32 frame_position = position + i * step;
+    const s16* frame = in + (frame_position >> 16) * 2;
+    const s32 weight = LinearWeight(frame_position);
+    const s32 sample0 = (frame[0] * (LINEAR_ONE - weight) + frame[2] * weight) >> 14;
+    const s32 sample1 = (frame[1] * (LINEAR_ONE - weight) + frame[3] * weight) >> 14;
+    AddFrame(out + i * 2, sample0, sample1, volume0, volume1);
+  }
+}
+
+// Rounds a sum of samples multiplied by Q15 filter coefficients.
+s32 RoundPolyphase(s32 sum)
+{
+  return (sum + (1 << 14)) >> 15;
+}
+
+void MixPolyphaseFrames(const s16* in, u32 position, u32 step, u32 first, u32 num_frames,
+                        s32 volume0, s32 volume1, s16* out)
+{
+  const PolyphaseTable& table = GetPolyphaseTable();
+  for (u32 i = first; i < num_frames; ++i)
+  {
+    const u32 frame_position = position + i * step;
+    const s16* frame = GetPolyphaseFrames(in, frame_position);
+    const std::array<s16, TAPS>& coefficients = table[GetPhase(frame_position)];
+    s32 sum0 = 0;
+    s32 sum1 = 0;
+    for (u32 tap = 0; tap < TAPS; ++tap)
+    {
+      sum0 += frame[tap * 2] * coefficients[tap];
+      sum1 += frame[tap * 2 + 1] * coefficients[tap];
+    }
+    AddFrame(out + i * 2, RoundPolyphase(sum0), RoundPolyphase(sum1), volume0, volume1);
+  }
+}
+
+#if defined(_M_X86_64)
+// Scales 4 frames by their volume and adds them to the output, with the same rounding and
+// clamping as AddFrame.
+void AddFrames(s16* out, __m128i samples, __m128i volume)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lo = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(samples, zero), volume), 8);
+  const __m128i hi = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(samples, zero), volume), 8);
+  const __m128i mixed = _mm_adds_epi16(_mm_loadu_si128(reinterpret_cast<__m128i*>(out)),
+                                       _mm_packs_epi32(lo, hi));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_max_epi16(mixed, _mm_set1_epi16(-32767)));
+}
+
+// Loads a frame and the next one, with the samples of each channel next to each other.
+__m128i LoadLinearPair(const s16* in, u32 position)
+{
+  const __m128i frames =
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + (position >> 16) * 2));
+  return _mm_shufflelo_epi16(frames, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+// Separates 4 frames into the samples of the first channel followed by those of the second.
+__m128i Deinterleave(__m128i frames)
+{
+  frames = _mm_shufflelo_epi16(frames, _MM_SHUFFLE(3, 1, 2, 0));
+  frames = _mm_shufflehi_epi16(frames, _MM_SHUFFLE(3, 1, 2, 0));
+  return _mm_shuffle_epi32(frames, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+// Returns the unrounded filter sums of both channels of a frame, as two partial sums each.
+__m128i FilterFrame(const s16* in, u32 position, const PolyphaseTable& table)
+{
+  const s16* frame = GetPolyphaseFrames(in, position);
+  const __m128i first = Deinterleave(_mm_loadu_si128(reinterpret_cast<const __m128i*>(frame)));
+  const __m128i second =
+      Deinterleave(_mm_loadu_si128(reinterpret_cast<const __m128i*>(frame + 8)));
+  const __m128i c =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table[GetPhase(position)].data()));
+  const __m128i sums0 = _mm_madd_epi16(_mm_unpacklo_epi64(first, second), c);
+  const __m128i sums1 = _mm_madd_epi16(_mm_unpackhi_epi64(first, second), c);
+  return _mm_add_epi32(_mm_unpacklo_epi32(sums0, sums1), _mm_unpackhi_epi32(sums0, sums1));
+}
+
+// Returns the rounded samples of two frames as 32-bit values.
+__m128i FilterFramePair(const s16* in, u32 position, u32 step, const PolyphaseTable& table)
+{
+  const __m128i a = FilterFrame(in, position, table);
+  const __m128i b = FilterFrame(in, position + step, table);
+  const __m128i sums = _mm_add_epi32(_mm_unpacklo_epi64(a, b), _mm_unpackhi_epi64(a, b));
+  return _mm_srai_epi32(_mm_add_epi32(sums, _mm_set1_epi32(1 << 14)), 15);
+}
+#elif defined(_M_ARM_64)
+int16x4_t GetVolumeVector(s32 volume0, s32 volume1)
+{
+  const std::array<s16, 4> volume{static_cast<s16>(volume0), static_cast<s16>(volume1),
+                                  static_cast<s16>(volume0), static_cast<s16>(volume1)};
+  return vld1_s16(volume.data());
+}
+
+void AddFrames(s16* out, int16x8_t samples, int16x4_t volume)
+{
+  const int16x4_t lo = vshrn_n_s32(vmull_s16(vget_low_s16(samples), volume), 8);
+  const int16x4_t hi = vshrn_n_s32(vmull_s16(vget_high_s16(samples), volume), 8);
+  const int16x8_t mixed = vqaddq_s16(vld1q_s16(out), vcombine_s16(lo, hi));
+  vst1q_s16(out, vmaxq_s16(mixed, vdupq_n_s16(-32767)));
+}
+
+// Loads a frame and the next one as two 32-bit values.
+int32x2_t LoadLinearPair(const s16* in, u32 position)
+{
+  return vreinterpret_s32_s16(vld1_s16(in + (position >> 16) * 2));
+}
+
+// Returns the unrounded filter sums of both channels of a frame, pairwise added once.
+int32x4_t FilterFrame(const s16* in, u32 position, const PolyphaseTable& table)
+{
+  const int16x8x2_t samples = vld2q_s16(GetPolyphaseFrames(in, position));
+  const int16x8_t c = vld1q_s16(table[GetPhase(position)].data());
+  int32x4_t sums0 = vmull_s16(vget_low_s16(samples.val[0]), vget_low_s16(c));
+  sums0 = vmlal_s16(sums0, vget_high_s16(samples.val[0]), vget_high_s16(c));
+  int32x4_t sums1 = vmull_s16(vget_low_s16(samples.val[1]), vget_low_s16(c));
+  sums1 = vmlal_s16(sums1, vget_high_s16(samples.val[1]), vget_high_s16(c));
+  return vpaddq_s32(sums0, sums1);
+}
+
+// Returns the rounded and saturated samples of two frames.
+int16x4_t FilterFramePair(const s16* in, u32 position, u32 step, const PolyphaseTable& table)
+{
+  const int32x4_t sums =
+      vpaddq_s32(FilterFrame(in, position, table), FilterFrame(in, position + step, table));
+  return vqmovn_s32(vrshrq_n_s32(sums, 15));
+}
+#endif
+}  // namespace
+
+void MixLinearScalar(const s16* in, u32 position, u32 step, u32 num_frames, s32 volume0,
+                     s32 volume1, s16* out)
+{
+  MixLinearFrames(in, position, step, 0, num_frames, volume0, volume1, out);
+}
+
+void MixPolyphaseScalar(const s16* in, u32 position, u32 step, u32 num_frames, s32 volume0,
+                        s32 volume1, s16* out)
+{
+  MixPolyphaseFrames(in, position, step, 0, num_frames, volume0, volume1, out);
+}
+
+void MixLinear(const s16* in, u32 position, u32 step, u32 num_frames, s32 volume0, s32 volume1,
+               s16* out)
+{
+  u32 i = 0;
+#if defined(_M_X86_64)
+  const __m128i volume = _mm_setr_epi16(static_cast<s16>(volume0), 0, static_cast<s16>(volume1), 0,
+                                        static_cast<s16>(volume0), 0, static_cast<s16>(volume1), 0);
+  const __m128i fraction_mask = _mm_set1_epi32(0xffff);
+  const __m128i one = _mm_set1_epi32(LINEAR_ONE);
+  const __m128i step4 = _mm_set1_epi32(static_cast<s32>(step * 4));
+  __m128i positions = _mm_setr_epi32(static_cast<s32>(position), static_cast<s32>(position + step),
+                                     static_cast<s32>(position + step * 2),
+                                     static_cast<s32>(position + step * 3));
+  for (; i + 4 <= num_frames; i += 4)
+  {
+    // Each 32-bit weight holds the s16 weights of the current and the next frame, so that a
+    // multiply-add of them with a pair from LoadLinearPair interpolates one sample.
+    const __m128i w = _mm_srli_epi32(_mm_and_si128(positions, fraction_mask), 2);
+    const __m128i weights = _mm_or_si128(_mm_sub_epi32(one, w), _mm_slli_epi32(w, 16));
+    positions = _mm_add_epi32(positions, step4);
+
+    const u32 frame_position = position + i * step;
+    const __m128i pairs01 = _mm_unpacklo_epi64(LoadLinearPair(in, frame_position),
+                                               LoadLinearPair(in, frame_position + step));
+    const __m128i pairs23 = _mm_unpacklo_epi64(LoadLinearPair(in, frame_position + step * 2),
+                                               LoadLinearPair(in, frame_position + step * 3));
+    const __m128i lo =
+        _mm_srai_epi32(_mm_madd_epi16(pairs01, _mm_unpacklo_epi32(weights, weights)), 14);
+    const __m128i hi =
+        _mm_srai_epi32(_mm_madd_epi16(pairs23, _mm_unpackhi_epi32(weights, weights)), 14);
+    AddFrames(out + i * 2, _mm_packs_epi32(lo, hi), volume);
+  }
+#elif defined(_M_ARM_64)
+  const int16x4_t volume = GetVolumeVector(volume0, volume1);
+  const uint32x4_t step4 = vdupq_n_u32(step * 4);
+  const std::array<u32, 4> initial_positions{position, position + step, position + step * 2,
+                                             position + step * 3};
+  uint32x4_t positions = vld1q_u32(initial_positions.data());
+  for (; i + 4 <= num_frames; i += 4)
+  {
+    const uint32x4_t fractions = vandq_u32(positions, vdupq_n_u32(0xffff));
+    const int16x4_t w = vreinterpret_s16_u16(vshrn_n_u32(fractions, 2));
+    const int16x4x2_t weights = vzip_s16(w, w);
+    const int16x8_t w8 = vcombine_s16(weights.val[0], weights.val[1]);
+    const int16x8_t inverse_w8 = vsubq_s16(vdupq_n_s16(LINEAR_ONE), w8);
+    positions = vaddq_u32(positions, step4);
+
+    // Each pair is a frame and the next one, which are split into current and next frames.
+    const u32 frame_position = position + i * step;
+    const int32x2_t pair0 = LoadLinearPair(in, frame_position);
+    const int32x2_t pair1 = LoadLinearPair(in, frame_position + step);
+    const int32x2_t pair2 = LoadLinearPair(in, frame_position + step * 2);
+    const int32x2_t pair3 = LoadLinearPair(in, frame_position + step * 3);
+    const int16x8_t a = vreinterpretq_s16_s32(
+        vcombine_s32(vtrn1_s32(pair0, pair1), vtrn1_s32(pair2, pair3)));
+    const int16x8_t b = vreinterpretq_s16_s32(
+        vcombine_s32(vtrn2_s32(pair0, pair1), vtrn2_s32(pair2, pair3)));
+
+    int32x4_t lo = vmull_s16(vget_low_s16(a), vget_low_s16(inverse_w8));
+    lo = vmlal_s16(lo, vget_low_s16(b), vget_low_s16(w8));
+    int32x4_t hi = vmull_s16(vget_high_s16(a), vget_high_s16(inverse_w8));
+    hi = vmlal_s16(hi, vget_high_s16(b), vget_high_s16(w8));
+    AddFrames(out + i * 2, vcombine_s16(vshrn_n_s32(lo, 14), vshrn_n_s32(hi, 14)), volume);
+  }
+#endif
+  MixLinearFrames(in, position, step, i, num_frames, volume0, volume1, out);
+}
+
+void MixPolyphase(const s16* in, u32 position, u32 step, u32 num_frames, s32 volume0, s32 volume1,
+                  s16* out)
+{
+  u32 i = 0;
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+  static_assert(TAPS == 8);
+  const PolyphaseTable& table = GetPolyphaseTable();
+#endif
+#if defined(_M_X86_64)
+  const __m128i volume = _mm_setr_epi16(static_cast<s16>(volume0), 0, static_cast<s16>(volume1), 0,
+                                        static_cast<s16>(volume0), 0, static_cast<s16>(volume1), 0);
+  for (; i + 4 <= num_frames; i += 4)
+  {
+    const u32 frame_position = position + i * step;
+    const __m128i samples01 = FilterFramePair(in, frame_position, step, table);
+    const __m128i samples23 = FilterFramePair(in, frame_position + step * 2, step, table);
+    AddFrames(out + i * 2, _mm_packs_epi32(samples01, samples23), volume);
+  }
+#elif defined(_M_ARM_64)
+  const int16x4_t volume = GetVolumeVector(volume0, volume1);
+  for (; i + 4 <= num_frames; i += 4)
+  {
+    const u32 frame_position = position + i * step;
+    const int16x4_t samples01 = FilterFramePair(in, frame_position, step, table);
+    const int16x4_t samples23 = FilterFramePair(in, frame_position + step * 2, step, table);
+    AddFrames(out + i * 2, vcombine_s16(samples01, samples23), volume);
+  }
+#endif
+  MixPolyphaseFrames(in, position, step, i, num_frames, volume0, volume1, out);
+}
+}  // namespace AudioCommon::Resampler
@@ -0,0 +1,35 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Resampling kernels used by the mixer. All of them take stereo frames of native endian samples.
+// Output frame k is taken from the input at position + k * step, in 16.16 fixed point frames from
+// the start of the input, scaled by the volume of its channel (0-256) and added to out with
+// clamping.
+namespace AudioCommon::Resampler
+{
+// Number of frames before and after the current input frame that the polyphase filter reads.
+// The linear interpolation only reads the next frame.
+constexpr u32 POLYPHASE_HISTORY = 3;
+constexpr u32 POLYPHASE_LOOKAHEAD = 4;
+constexpr u32 LINEAR_LOOKAHEAD = 1;
+
+// Interpolates linearly between neighbouring frames.
+void MixLinear(const s16* in, u32 position, u32 step, u32 num_frames, s32 volume0, s32 volume1,
+               s16* out);
+
+// An 8 tap windowed sinc filter, which suppresses most of the aliasing and imaging of the linear
+// interpolation at about three times the cost.
+void MixPolyphase(const s16* in, u32 position, u32 step, u32 num_frames, s32 volume0, s32 volume1,
+                  s16* out);
+
+// Plain C++ versions of the above, which produce the same results. Only exposed for testing and
+// benchmarking.
+void MixLinearScalar(const s16* in, u32 position, u32 step, u32 num_frames, s32 volume0,
+                     s32 volume1, s16* out);
+void MixPolyphaseScalar(const s16* in, u32 position, u32 step, u32 num_frames, s32 volume0,
+                        s32 volume1, s16* out);
+}  // namespace AudioCommon::Resampler
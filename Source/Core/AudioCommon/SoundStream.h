@@ -20,6 +20,8 @@ public:
   Mixer* GetMixer() const { return m_mixer.get(); }
   virtual bool Init() { return false; }
   virtual void SetVolume(int) {}
+  // Returns the time in milliseconds until samples mixed now are heard, or 0 if it isn't known.
+  virtual float GetOutputLatency() const { return 0.0f; }
   // Returns true if successful.
   virtual bool SetRunning(bool running) { return false; }
 };
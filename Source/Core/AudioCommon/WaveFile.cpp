@@ -62,6 +62,8 @@ bool WaveFileWriter::Start(const std::string& filename, u32 sample_rate_divisor)
   }
 
   audio_size = 0;
+  conv_buffer.clear();
+  conv_buffer.reserve(BUFFER_SIZE);
 
   if (basename.empty())
     SplitPath(filename, nullptr, &basename, nullptr);
@@ -91,11 +93,19 @@ bool WaveFileWriter::Start(const std::string& filename, u32 sample_rate_divisor)
   if (file.Tell() != 44)
     PanicAlertFmt("Wrong offset: {}", file.Tell());
 
+  write_thread.Reset([this](std::vector<short> samples) {
+    file.WriteBytes(samples.data(), samples.size() * sizeof(short));
+  });
+
   return true;
 }
 
 void WaveFileWriter::Stop()
 {
+  // Let the write thread finish before the header is touched.
+  FlushSamples();
+  write_thread.Shutdown();
+
   file.Seek(4, File::SeekOrigin::Begin);
   Write(audio_size + 36);
 
@@ -115,6 +125,16 @@ void WaveFileWriter::Write4(const char* ptr)
   file.WriteBytes(ptr, 4);
 }
 
+void WaveFileWriter::FlushSamples()
+{
+  if (conv_buffer.empty())
+    return;
+
+  write_thread.EmplaceItem(std::move(conv_buffer));
+  conv_buffer = {};
+  conv_buffer.reserve(BUFFER_SIZE);
+}
+
 void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
                                         u32 sample_rate_divisor, int l_volume, int r_volume)
 {
@@ -144,17 +164,6 @@ void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
       return;
   }
 
-  for (u32 i = 0; i < count; i++)
-  {
-    // Flip the audio channels from RL to LR
-    conv_buffer[2 * i] = Common::swap16((u16)sample_data[2 * i + 1]);
-    conv_buffer[2 * i + 1] = Common::swap16((u16)sample_data[2 * i]);
-
-    // Apply volume (volume ranges from 0 to 256)
-    conv_buffer[2 * i] = conv_buffer[2 * i] * l_volume / 256;
-    conv_buffer[2 * i + 1] = conv_buffer[2 * i + 1] * r_volume / 256;
-  }
-
   if (sample_rate_divisor != current_sample_rate_divisor)
   {
     Stop();
@@ -165,6 +174,19 @@ void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
     current_sample_rate_divisor = sample_rate_divisor;
   }
 
-  file.WriteBytes(conv_buffer.data(), count * 4);
+  if (conv_buffer.size() + count * 2 > BUFFER_SIZE)
+    FlushSamples();
+
+  for (u32 i = 0; i < count; i++)
+  {
+    // Flip the audio channels from RL to LR
+    const short left = Common::swap16((u16)sample_data[2 * i + 1]);
+    const short right = Common::swap16((u16)sample_data[2 * i]);
+
+    // Apply volume (volume ranges from 0 to 256)
+    conv_buffer.push_back(static_cast<short>(left * l_volume / 256));
+    conv_buffer.push_back(static_cast<short>(right * r_volume / 256));
+  }
+
   audio_size += count * 4;
 }
@@ -9,15 +9,18 @@
 // The float variant will convert from -1.0-1.0 range and clamp.
 // Alternatively, AddSamplesBE for big endian wave data.
 // If Stop is not called when it destructs, the destructor will call Stop().
+// The samples are converted right away, but collected into large blocks that are written to disk
+// by a background thread, so that dumping doesn't stall the emulation on file I/O.
 // ---------------------------------------------------------------------------------
 
 #pragma once
 
-#include <array>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
 
 class WaveFileWriter
 {
@@ -44,6 +47,7 @@ private:
 
   void Write(u32 value);
   void Write4(const char* ptr);
+  void FlushSamples();
 
   File::IOFile file;
   std::string basename;
@@ -51,7 +55,8 @@ private:
   u32 audio_size = 0;
 
   u32 current_sample_rate_divisor;
-  std::array<short, BUFFER_SIZE> conv_buffer{};
+  std::vector<short> conv_buffer;
+  Common::WorkQueueThread<std::vector<short>> write_thread;
 
   bool skip_silence = false;
 };
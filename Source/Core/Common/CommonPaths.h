@@ -110,6 +110,7 @@
 // Files in the directory returned by GetUserPath(D_MEMORYWATCHER_IDX)
 #define MEMORYWATCHER_LOCATIONS "Locations.txt"
 #define MEMORYWATCHER_SOCKET "MemoryWatcher"
+#define MEMORYWATCHER_SHARED_MEMORY "MemoryWatcher.shm"
 
 // Sys files
 #define TOTALDB "totaldb.dsy"
@@ -19,7 +19,7 @@ static Layers s_layers;
 static std::vector<std::pair<size_t, ConfigChangedCallback>> s_callbacks;
 static size_t s_next_callback_id = 0;
 static u32 s_callback_guards = 0;
-static std::atomic<u64> s_config_version = 0;
+static std::atomic<u32> s_config_version = 0;
 
 static std::shared_mutex s_layers_rw_lock;
 
@@ -99,7 +99,7 @@ void OnConfigChanged()
     callback.second();
 }
 
-u64 GetConfigVersion()
+u32 GetConfigVersion()
 {
   return s_config_version.load(std::memory_order_relaxed);
 }
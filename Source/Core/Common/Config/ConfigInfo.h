@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstring>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -19,6 +21,17 @@ namespace detail
 // std::underlying_type may only be used with enum types, so make sure T is an enum type first.
 template <typename T>
 using UnderlyingType = typename std::enable_if_t<std::is_enum<T>{}, std::underlying_type<T>>::type;
+
+// Config versions may wrap around, so they are compared through their difference.
+constexpr bool IsNewerConfigVersion(u32 version, u32 other)
+{
+  return static_cast<s32>(version - other) > 0;
+}
+
+// Small trivially copyable values (bools, enums, integers, floats) are cached together with their
+// config version in a single atomic, so that reading them doesn't have to take a lock.
+template <typename T>
+constexpr bool IsAtomicallyCached = std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(u32);
 }  // namespace detail
 
 struct Location
@@ -36,7 +49,7 @@ template <typename T>
 struct CachedValue
 {
   T value;
-  u64 config_version;
+  u32 config_version;
 };
 
 template <typename T>
@@ -44,8 +57,9 @@ class Info
 {
 public:
   constexpr Info(const Location& location, const T& default_value)
-      : m_location{location}, m_default_value{default_value}, m_cached_value{default_value, 0}
+      : m_location{location}, m_default_value{default_value}
   {
+    StoreCachedValue({default_value, 0});
   }
 
   Info(const Info<T>& other) { *this = other; }
@@ -66,7 +80,7 @@ public:
   {
     m_location = other.GetLocation();
     m_default_value = other.GetDefaultValue();
-    m_cached_value = other.GetCachedValue();
+    StoreCachedValue(other.GetCachedValue());
     return *this;
   }
 
@@ -75,7 +89,7 @@ public:
   {
     m_location = std::move(other.m_location);
     m_default_value = std::move(other.m_default_value);
-    m_cached_value = std::move(other.m_cached_value);
+    StoreCachedValue(other.GetCachedValue());
     return *this;
   }
 
@@ -87,7 +101,7 @@ public:
   {
     m_location = other.GetLocation();
     m_default_value = static_cast<T>(other.GetDefaultValue());
-    m_cached_value = other.template GetCachedValueCasted<T>();
+    StoreCachedValue(other.template GetCachedValueCasted<T>());
     return *this;
   }
 
@@ -96,29 +110,83 @@ public:
 
   CachedValue<T> GetCachedValue() const
   {
-    std::shared_lock lock(m_cached_value_mutex);
-    return m_cached_value;
+    if constexpr (detail::IsAtomicallyCached<T>)
+    {
+      return Unpack(m_cache.load(std::memory_order_acquire));
+    }
+    else
+    {
+      std::shared_lock lock(m_cache.mutex);
+      return m_cache.value;
+    }
   }
 
   template <typename U>
   CachedValue<U> GetCachedValueCasted() const
   {
-    std::shared_lock lock(m_cached_value_mutex);
-    return CachedValue<U>{static_cast<U>(m_cached_value.value), m_cached_value.config_version};
+    const CachedValue<T> cached_value = GetCachedValue();
+    return CachedValue<U>{static_cast<U>(cached_value.value), cached_value.config_version};
   }
 
   void SetCachedValue(const CachedValue<T>& cached_value) const
   {
-    std::unique_lock lock(m_cached_value_mutex);
-    if (m_cached_value.config_version < cached_value.config_version)
-      m_cached_value = cached_value;
+    if constexpr (detail::IsAtomicallyCached<T>)
+    {
+      const u64 desired = Pack(cached_value);
+      u64 current = m_cache.load(std::memory_order_relaxed);
+      do
+      {
+        if (!detail::IsNewerConfigVersion(cached_value.config_version, u32(current >> 32)))
+          return;
+      } while (!m_cache.compare_exchange_weak(current, desired, std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+    else
+    {
+      std::unique_lock lock(m_cache.mutex);
+      if (detail::IsNewerConfigVersion(cached_value.config_version, m_cache.value.config_version))
+        m_cache.value = cached_value;
+    }
   }
 
 private:
+  struct LockedCache
+  {
+    CachedValue<T> value;
+    std::shared_mutex mutex;
+  };
+
+  using Cache = std::conditional_t<detail::IsAtomicallyCached<T>, std::atomic<u64>, LockedCache>;
+
+  // The config version is stored in the upper half and the value's bytes in the lower half.
+  static u64 Pack(const CachedValue<T>& cached_value)
+  {
+    u32 bits = 0;
+    std::memcpy(&bits, &cached_value.value, sizeof(T));
+    return u64(cached_value.config_version) << 32 | bits;
+  }
+
+  static CachedValue<T> Unpack(u64 packed)
+  {
+    CachedValue<T> cached_value;
+    const u32 bits = u32(packed);
+    std::memcpy(&cached_value.value, &bits, sizeof(T));
+    cached_value.config_version = u32(packed >> 32);
+    return cached_value;
+  }
+
+  // Not thread-safe
+  void StoreCachedValue(const CachedValue<T>& cached_value)
+  {
+    if constexpr (detail::IsAtomicallyCached<T>)
+      m_cache.store(Pack(cached_value), std::memory_order_relaxed);
+    else
+      m_cache.value = cached_value;
+  }
+
   Location m_location;
   T m_default_value;
 
-  mutable CachedValue<T> m_cached_value;
-  mutable std::shared_mutex m_cached_value_mutex;
+  mutable Cache m_cache;
 };
 }  // namespace Config
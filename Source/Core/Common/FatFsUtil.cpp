@@ -4,11 +4,16 @@
 #include "Common/FatFsUtil.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <ctime>
 #include <mutex>
+#include <optional>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include <fmt/format.h>
@@ -20,6 +25,7 @@
 // clang-format on
 
 #include "Common/Align.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
@@ -480,6 +486,105 @@ static void SortFST(File::FSTEntry* root)
     SortFST(&child);
 }
 
+// The state of the SD folder and image right after they were last synced. As long as neither of
+// them changed since, syncing them again would produce the same result, so it can be skipped
+// instead of copying the whole contents on every boot and shutdown.
+struct SDSyncState
+{
+  std::string folder_hash;
+  u64 image_size = 0;
+  s64 image_modification_time = 0;
+};
+
+static std::string GetSDSyncStatePath()
+{
+  return File::GetUserPath(F_WIISDCARDIMAGE_IDX) + ".sync";
+}
+
+static void HashFolder(const File::FSTEntry& entry, Common::SHA1::Context* context)
+{
+  const File::FileInfo info(entry.physicalName);
+  const std::string line = fmt::format("{}\n{}\n{}\n{}\n", entry.virtualName, entry.isDirectory,
+                                       info.GetSize(), info.GetModificationTime());
+  context->Update(reinterpret_cast<const u8*>(line.data()), line.size());
+
+  if (!entry.isDirectory)
+    return;
+
+  // The order of the scanned entries depends on the host file system.
+  std::vector<const File::FSTEntry*> children;
+  children.reserve(entry.children.size());
+  for (const File::FSTEntry& child : entry.children)
+    children.push_back(&child);
+  std::sort(children.begin(), children.end(),
+            [](const File::FSTEntry* lhs, const File::FSTEntry* rhs) {
+              return lhs->virtualName < rhs->virtualName;
+            });
+  for (const File::FSTEntry* child : children)
+    HashFolder(*child, context);
+}
+
+static std::string HashFolder(const File::FSTEntry& root)
+{
+  auto context = Common::SHA1::CreateContext();
+  HashFolder(root, context.get());
+
+  std::string hash;
+  for (const u8 byte : context->Finish())
+    hash += fmt::format("{:02x}", byte);
+  return hash;
+}
+
+static std::optional<SDSyncState> LoadSDSyncState()
+{
+  std::string contents;
+  if (!File::ReadFileToString(GetSDSyncStatePath(), contents))
+    return std::nullopt;
+
+  SDSyncState state;
+  std::istringstream stream(contents);
+  if (!(stream >> state.folder_hash >> state.image_size >> state.image_modification_time))
+    return std::nullopt;
+  return state;
+}
+
+static bool IsSDSyncStateCurrent(const File::FSTEntry& folder, const std::string& image_path)
+{
+  const std::optional<SDSyncState> state = LoadSDSyncState();
+  if (!state)
+    return false;
+
+  const File::FileInfo image_info(image_path);
+  return image_info.IsFile() && image_info.GetSize() == state->image_size &&
+         image_info.GetModificationTime() == state->image_modification_time &&
+         HashFolder(folder) == state->folder_hash;
+}
+
+static void SaveSDSyncState(const File::FSTEntry& folder, const std::string& image_path)
+{
+  const std::string state_path = GetSDSyncStatePath();
+
+  // Modification times only have a resolution of a second, so writes to the image within the
+  // second in which it was synced couldn't be told apart from the sync. Wait for that second to
+  // pass, and if it doesn't (e.g. because of a clock mismatch), don't trust the state at all.
+  File::FileInfo image_info(image_path);
+  for (int i = 0; i < 25 && image_info.GetModificationTime() >= std::time(nullptr); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    image_info = File::FileInfo(image_path);
+  }
+  if (!image_info.IsFile() || image_info.GetModificationTime() >= std::time(nullptr))
+  {
+    File::Delete(state_path);
+    return;
+  }
+
+  const std::string contents = fmt::format("{} {} {}\n", HashFolder(folder),
+                                           image_info.GetSize(), image_info.GetModificationTime());
+  if (!File::WriteStringToFile(state_path, contents))
+    WARN_LOG_FMT(COMMON, "Failed to write SD sync state to {}", state_path);
+}
+
 bool SyncSDFolderToSDImage(bool deterministic)
 {
   const std::string source_dir = File::GetUserPath(D_WIISDCARDSYNCFOLDER_IDX);
@@ -497,6 +602,16 @@ bool SyncSDFolderToSDImage(bool deterministic)
   }
 
   File::FSTEntry root = File::ScanDirectoryTree(source_dir, true);
+
+  // An image that was modified by an earlier session has a different layout than a freshly packed
+  // one, so it can't be reused when the image has to be the same on every system.
+  if (!deterministic && IsSDSyncStateCurrent(root, image_path))
+  {
+    INFO_LOG_FMT(COMMON, "SD image {} is up to date with folder {}, not converting", image_path,
+                 source_dir);
+    return true;
+  }
+
   if (deterministic)
     SortFST(&root);
   if (!CheckIfFATCompatible(root))
@@ -582,6 +697,8 @@ bool SyncSDFolderToSDImage(bool deterministic)
 
   image_delete_guard.Dismiss();  // no need to delete the temp file anymore after the rename
 
+  SaveSDSyncState(root, image_path);
+
   INFO_LOG_FMT(COMMON, "Successfully packed folder {} to SD image at {}", source_dir, image_path);
   return true;
 }
@@ -746,6 +863,14 @@ bool SyncSDImageToSDFolder()
   if (image_path.empty() || target_dir.empty())
     return false;
 
+  if (File::IsDirectory(target_dir) &&
+      IsSDSyncStateCurrent(File::ScanDirectoryTree(target_dir, true), image_path))
+  {
+    INFO_LOG_FMT(COMMON, "SD folder {} is up to date with image {}, not converting", target_dir,
+                 image_path);
+    return true;
+  }
+
   std::lock_guard lk(s_fatfs_mutex);
   SDCardFatFsCallbacks callbacks;
   s_callbacks = &callbacks;
@@ -814,6 +939,8 @@ bool SyncSDImageToSDFolder()
   if (!image.Close())
     ERROR_LOG_FMT(COMMON, "Failed to close SD image {}", image_path);
 
+  SaveSDSyncState(File::ScanDirectoryTree(target_dir, true), image_path);
+
   INFO_LOG_FMT(COMMON, "Successfully unpacked SD image {} to {}", image_path, target_dir);
   return true;
 }
@@ -119,6 +119,8 @@ void FileInfo::AndroidContentInit(const std::string& path)
   m_exists = result != -1;
   m_stat.st_mode = result == -2 ? S_IFDIR : S_IFREG;
   m_stat.st_size = result >= 0 ? result : 0;
+  // Not available through the content provider API
+  m_stat.st_mtime = 0;
 }
 #endif
 
@@ -142,6 +144,11 @@ u64 FileInfo::GetSize() const
   return IsFile() ? m_stat.st_size : 0;
 }
 
+s64 FileInfo::GetModificationTime() const
+{
+  return m_exists ? static_cast<s64>(m_stat.st_mtime) : 0;
+}
+
 // Returns true if the path exists
 bool Exists(const std::string& path)
 {
@@ -1002,6 +1009,8 @@ static void RebuildUserDirectories(unsigned int dir_index)
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_LOCATIONS;
     s_user_paths[F_MEMORYWATCHERSOCKET_IDX] =
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_SOCKET;
+    s_user_paths[F_MEMORYWATCHERSHAREDMEMORY_IDX] =
+        s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_SHARED_MEMORY;
 
     s_user_paths[D_GBAUSER_IDX] = s_user_paths[D_USER_IDX] + GBA_USER_DIR DIR_SEP;
     s_user_paths[D_GBASAVES_IDX] = s_user_paths[D_GBAUSER_IDX] + GBASAVES_DIR DIR_SEP;
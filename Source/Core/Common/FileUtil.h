@@ -80,6 +80,7 @@ enum
   F_GCSRAM_IDX,
   F_MEMORYWATCHERLOCATIONS_IDX,
   F_MEMORYWATCHERSOCKET_IDX,
+  F_MEMORYWATCHERSHAREDMEMORY_IDX,
   F_WIISDCARDIMAGE_IDX,
   F_DUALSHOCKUDPCLIENTCONFIG_IDX,
   F_FREELOOKCONFIG_IDX,
@@ -118,6 +119,8 @@ public:
   bool IsFile() const;
   // Returns the size of a file (or returns 0 if the path doesn't refer to a file)
   u64 GetSize() const;
+  // Returns the last modification time in seconds since the epoch (or 0 if it's unknown)
+  s64 GetModificationTime() const;
 
 private:
 #ifdef ANDROID
@@ -976,6 +976,14 @@ PFNDOLGETOCCLUSIONQUERYUIVNVPROC dolGetOcclusionQueryuivNV;
 // ARB_clip_control
 PFNDOLCLIPCONTROLPROC dolClipControl;
 
+// ARB_timer_query
+PFNDOLQUERYCOUNTERPROC dolQueryCounter;
+PFNDOLGETQUERYOBJECTI64VPROC dolGetQueryObjecti64v;
+PFNDOLGETQUERYOBJECTUI64VPROC dolGetQueryObjectui64v;
+
+// KHR_parallel_shader_compile
+PFNDOLMAXSHADERCOMPILERTHREADSPROC dolMaxShaderCompilerThreads;
+
 // ARB_copy_image
 PFNDOLCOPYIMAGESUBDATAPROC dolCopyImageSubData;
 
@@ -2098,6 +2106,18 @@ const GLFunc gl_function_array[] = {
     // ARB_clip_control
     GLFUNC_REQUIRES(glClipControl, "GL_ARB_clip_control !VERSION_4_5"),
 
+    // ARB_timer_query
+    GLFUNC_REQUIRES(glQueryCounter, "GL_ARB_timer_query"),
+    GLFUNC_REQUIRES(glGetQueryObjecti64v, "GL_ARB_timer_query"),
+    GLFUNC_REQUIRES(glGetQueryObjectui64v, "GL_ARB_timer_query"),
+
+    // KHR_parallel_shader_compile
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, KHR, "GL_KHR_parallel_shader_compile"),
+
+    // ARB_parallel_shader_compile
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, ARB,
+                  "GL_ARB_parallel_shader_compile !GL_KHR_parallel_shader_compile"),
+
     // ARB_copy_image
     GLFUNC_REQUIRES(glCopyImageSubData, "GL_ARB_copy_image !VERSION_4_3 |VERSION_GLES_3_2"),
 
@@ -30,6 +30,7 @@
 #include "Common/GL/GLExtensions/ARB_texture_multisample.h"
 #include "Common/GL/GLExtensions/ARB_texture_storage.h"
 #include "Common/GL/GLExtensions/ARB_texture_storage_multisample.h"
+#include "Common/GL/GLExtensions/ARB_timer_query.h"
 #include "Common/GL/GLExtensions/ARB_uniform_buffer_object.h"
 #include "Common/GL/GLExtensions/ARB_vertex_array_object.h"
 #include "Common/GL/GLExtensions/ARB_viewport_array.h"
@@ -37,6 +38,9 @@
 #include "Common/GL/GLExtensions/EXT_texture_filter_anisotropic.h"
 #include "Common/GL/GLExtensions/HP_occlusion_test.h"
 #include "Common/GL/GLExtensions/KHR_debug.h"
+#include "Common/GL/GLExtensions/KHR_parallel_shader_compile.h"
+#include "Common/GL/GLExtensions/KHR_shader_subgroup.h"
+#include "Common/GL/GLExtensions/KHR_texture_compression_astc_ldr.h"
 #include "Common/GL/GLExtensions/NV_depth_buffer_float.h"
 #include "Common/GL/GLExtensions/NV_occlusion_query_samples.h"
 #include "Common/GL/GLExtensions/NV_primitive_restart.h"
@@ -0,0 +1,15 @@
+/*
+** Copyright (c) 2013-2017 The Khronos Group Inc.
+** SPDX-License-Identifier: MIT
+*/
+
+#include "Common/GL/GLExtensions/gl_common.h"
+
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
+typedef void(APIENTRYP PFNDOLMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+
+extern PFNDOLMAXSHADERCOMPILERTHREADSPROC dolMaxShaderCompilerThreads;
+
+#define glMaxShaderCompilerThreads dolMaxShaderCompilerThreads
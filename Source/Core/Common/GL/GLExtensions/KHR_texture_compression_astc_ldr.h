@@ -0,0 +1,9 @@
+/*
+** Copyright (c) 2013-2015 The Khronos Group Inc.
+** SPDX-License-Identifier: MIT
+*/
+
+#include "Common/GL/GLExtensions/gl_common.h"
+
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR 0x93D0
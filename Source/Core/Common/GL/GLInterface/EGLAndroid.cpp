@@ -5,6 +5,18 @@
 
 #include <android/native_window.h>
 
+void GLContextEGLAndroid::Update()
+{
+  // The window surface follows the size of the window, e.g. when the device is rotated, so there
+  // is no need to recreate it.
+  if (m_wsi.render_surface)
+  {
+    m_backbuffer_width = ANativeWindow_getWidth(static_cast<ANativeWindow*>(m_wsi.render_surface));
+    m_backbuffer_height =
+        ANativeWindow_getHeight(static_cast<ANativeWindow*>(m_wsi.render_surface));
+  }
+}
+
 EGLDisplay GLContextEGLAndroid::OpenEGLDisplay()
 {
   return eglGetDisplay(EGL_DEFAULT_DISPLAY);
@@ -7,6 +7,9 @@
 
 class GLContextEGLAndroid final : public GLContextEGL
 {
+public:
+  void Update() override;
+
 protected:
   EGLDisplay OpenEGLDisplay() override;
   EGLNativeWindowType GetEGLNativeWindow(EGLConfig config) override;
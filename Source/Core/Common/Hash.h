@@ -21,4 +21,7 @@ u32 StartCRC32();
 u32 UpdateCRC32(u32 crc, const u8* data, size_t len);
 u32 ComputeCRC32(const u8* data, size_t len);
 u32 ComputeCRC32(std::string_view data);
+// Returns the CRC32 of two buffers concatenated, given the CRC32 of each. Lets pieces of a large
+// buffer be hashed in parallel.
+u32 CombineCRC32(u32 crc1, u32 crc2, u64 len2);
 }  // namespace Common
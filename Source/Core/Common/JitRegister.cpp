@@ -47,9 +47,18 @@ void Init(const std::string& perf_dir)
   s_is_enabled = true;
 #endif
 
+#ifdef USE_VTUNE
+  s_is_enabled = true;
+#endif
+
   if (!perf_dir.empty() || getenv("PERF_BUILDID_DIR"))
   {
+#ifdef ANDROID
+    // There is no /tmp on Android, and /data/local/tmp is where simpleperf keeps its files.
+    const std::string dir = perf_dir.empty() ? "/data/local/tmp" : perf_dir;
+#else
     const std::string dir = perf_dir.empty() ? "/tmp" : perf_dir;
+#endif
     const std::string filename = fmt::format("{}/perf-{}.map", dir, getpid());
     s_perf_map_file.Open(filename, "w");
     // Disable buffering in order to avoid missing some mappings
@@ -81,6 +90,11 @@ bool IsEnabled()
   return s_is_enabled;
 }
 
+std::string FormatMapEntry(const void* base_address, u32 code_size, std::string_view symbol_name)
+{
+  return fmt::format("{} {:x} {}\n", fmt::ptr(base_address), code_size, symbol_name);
+}
+
 void Register(const void* base_address, u32 code_size, const std::string& symbol_name)
 {
 #if !(defined USE_OPROFILE && USE_OPROFILE) && !defined(USE_VTUNE)
@@ -105,7 +119,7 @@ void Register(const void* base_address, u32 code_size, const std::string& symbol
   if (!s_perf_map_file.IsOpen())
     return;
 
-  const auto entry = fmt::format("{} {:x} {}\n", fmt::ptr(base_address), code_size, symbol_name);
+  const std::string entry = FormatMapEntry(base_address, code_size, symbol_name);
   s_perf_map_file.WriteBytes(entry.data(), entry.size());
 }
 }  // namespace JitRegister
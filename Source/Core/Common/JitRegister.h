@@ -4,6 +4,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include <fmt/format.h>
 
@@ -16,6 +17,10 @@ void Shutdown();
 void Register(const void* base_address, u32 code_size, const std::string& symbol_name);
 bool IsEnabled();
 
+// Formats a line of a perf map file ("START SIZE symbolname"), which both perf and Android's
+// simpleperf use to symbolize JIT code.
+std::string FormatMapEntry(const void* base_address, u32 code_size, std::string_view symbol_name);
+
 template <typename... Args>
 inline void Register(const void* base_address, u32 code_size, fmt::format_string<Args...> format,
                      Args&&... args)
@@ -4,27 +4,37 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
-#include <memory>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "Common/Thread.h"
 #include "Common/Version.h"
 
 // On disk format:
 // header{
 // u32 'DCAC';
-// u32 version;  // svn_rev
 // u16 sizeof(key_type);
 // u16 sizeof(value_type);
+// char version[40];  // scm rev
 //}
 
 // key_value_pair{
 // u32 value_size;
 // key_type   key;
 // value_type[value_size]   value;
+// u32 entry_number;  // 1-based, stops the scan at a torn write
 //}
 
 template <typename K, typename V>
@@ -34,12 +44,15 @@ public:
   virtual void Read(const K& key, const V* value, u32 value_size) = 0;
 };
 
-// Dead simple unsorted key-value store with append functionality.
-// No random read functionality, all reading is done in OpenAndRead.
+// Unsorted key-value store with append functionality.
+// Values are read in OpenAndRead, or found by OpenAndIndex and read one at a time later.
 // Keys and values can contain any characters, including \0.
 //
 // Suitable for caching generated shader bytecode between executions.
-// Not tuned for extreme performance but should be reasonably fast.
+// The existing entries are memory-mapped when the file is opened, so values are only read from
+// disk when they're used. Entries which were superseded by a later entry with the same key are
+// dropped by rewriting the file in the background once they waste enough space.
+// Append, ReadValue and Sync may be called from multiple threads.
 // Does not support keys or values larger than 2GB, which should be reasonable.
 // Keys must have non-zero length; values can have zero length.
 
@@ -50,99 +63,262 @@ template <typename K, typename V>
 class LinearDiskCache
 {
 public:
+  LinearDiskCache() = default;
+  ~LinearDiskCache() { Close(); }
+
+  LinearDiskCache(const LinearDiskCache&) = delete;
+  LinearDiskCache& operator=(const LinearDiskCache&) = delete;
+
   // return number of read entries
   u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
   {
-    // Since we're reading/writing directly to the storage of K instances,
-    // K must be trivially copyable.
+    std::vector<V> aligned_value;
+    return Open(filename, [&reader, &aligned_value](const K& key, const u8* value, u32 value_size,
+                                                    u64) {
+      // Values in the mapping are only as aligned as the entry sizes before them happen to be.
+      if (reinterpret_cast<uintptr_t>(value) % alignof(V) != 0)
+      {
+        aligned_value.resize(value_size);
+        std::memcpy(aligned_value.data(), value, value_size * sizeof(V));
+        value = reinterpret_cast<const u8*>(aligned_value.data());
+      }
+      reader.Read(key, reinterpret_cast<const V*>(value), value_size);
+    });
+  }
+
+  // Like OpenAndRead, but doesn't touch the values. func is called as
+  // func(key, offset, value_size) for each entry, and the value can be read later with ReadValue.
+  template <typename Func>
+  u32 OpenAndIndex(const std::string& filename, Func func)
+  {
+    return Open(filename, [&func](const K& key, const u8*, u32 value_size, u64 offset) {
+      func(key, offset, value_size);
+    });
+  }
+
+  // Like OpenAndIndex, but leaves the file as it is, for caches which are shipped with Dolphin.
+  // Nothing may be appended, and the file isn't recreated if it's missing or from another version.
+  template <typename Func>
+  u32 OpenReadOnlyAndIndex(const std::string& filename, Func func)
+  {
+    return Open(
+        filename,
+        [&func](const K& key, const u8*, u32 value_size, u64 offset) {
+          func(key, offset, value_size);
+        },
+        true);
+  }
+
+  // Reads a value found by OpenAndIndex.
+  bool ReadValue(u64 offset, u32 value_size, V* value)
+  {
+    const u64 size = u64{value_size} * sizeof(V);
+    if (offset > m_valid_end || size > m_valid_end - offset)
+      return false;
+
+    std::memcpy(value, m_mapping.GetData() + offset, static_cast<size_t>(size));
+    return true;
+  }
+
+  void Sync()
+  {
+    std::lock_guard lk(m_file_mutex);
+    m_file.Flush();
+  }
+
+  void Close()
+  {
+    std::lock_guard lk(m_file_mutex);
+    if (m_compaction_thread.joinable())
+    {
+      m_compaction_thread.join();
+      FinishCompaction();
+    }
+    if (m_file.IsOpen())
+      m_file.Close();
+    m_mapping.Close();
+    m_valid_end = 0;
+  }
+
+  // Appends a key-value pair to the store.
+  void Append(const K& key, const V* value, u32 value_size)
+  {
+    // TODO: Should do a check that we don't already have "key"? (I think each caller does that
+    // already.)
+    std::lock_guard lk(m_file_mutex);
+    m_num_entries++;
+    WriteEntry(m_file, key, reinterpret_cast<const u8*>(value), value_size, m_num_entries);
+  }
+
+private:
+  // The superseded entries of a file have to take up at least this much space, and a quarter of
+  // the file, before it is compacted.
+  static constexpr u64 COMPACTION_MIN_WASTE = 1024 * 1024;
+
+  template <typename Func>
+  u32 Open(const std::string& filename, Func on_entry, bool read_only = false)
+  {
+    // Since we're reading/writing directly to the storage of K and V instances,
+    // they must be trivially copyable.
     static_assert(std::is_trivially_copyable<K>::value, "K must be a trivially copyable type");
+    static_assert(std::is_trivially_copyable<V>::value, "V must be a trivially copyable type");
 
     // close any currently opened file
     Close();
     m_num_entries = 0;
-
-    // try opening for reading/writing
-    m_file.Open(filename, "r+b");
-
-    const u64 file_size = m_file.GetSize();
+    m_filename = filename;
 
     m_header.Init();
-    if (m_file.IsOpen() && ValidateHeader())
+    if (m_mapping.Open(filename) && m_mapping.GetSize() >= sizeof(Header) &&
+        !std::memcmp(&m_header, m_mapping.GetData(), sizeof(Header)))
     {
-      // good header, read some key/value pairs
-      K key;
+      // good header, index the key/value pairs by key to find out how much space the entries
+      // which were superseded by a later one take up
+      std::unordered_map<size_t, u64> latest_entries;
+      u64 wasted_size = 0;
+      m_valid_end = ForEachEntry(m_mapping.GetData(), sizeof(Header), m_mapping.GetSize(), 0,
+                                 [&](u64 entry_offset, const K& key, const u8*, u32) {
+                                   auto [iter, inserted] =
+                                       latest_entries.try_emplace(HashKey(key), entry_offset);
+                                   if (!inserted)
+                                   {
+                                     wasted_size += GetEntrySize(iter->second);
+                                     iter->second = entry_offset;
+                                   }
+                                   m_num_entries++;
+                                   return true;
+                                 });
+      wasted_size += m_mapping.GetSize() - m_valid_end;
+      m_entries_at_open = m_num_entries;
 
-      std::unique_ptr<V[]> value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-      u64 last_valid_value_start = m_file.Tell();
+      ForEachEntry(m_mapping.GetData(), sizeof(Header), m_valid_end, 0,
+                   [&](u64 entry_offset, const K& key, const u8* value, u32 value_size) {
+                     on_entry(key, value, value_size, entry_offset + sizeof(u32) + sizeof(K));
+                     return true;
+                   });
 
-      while (m_file.ReadArray(&value_size, 1))
+      if (read_only)
+        return m_num_entries;
+
+      // Torn writes at the end are overwritten by the next append.
+      if (m_file.Open(filename, "r+b") && m_file.Seek(m_valid_end, File::SeekOrigin::Begin))
       {
-        const u64 next_extent = m_file.Tell() + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
-          break;
-
-        // TODO: use make_unique_for_overwrite in C++20
-        value = std::unique_ptr<V[]>(new V[value_size]);
-
-        // read key/value and pass to reader
-        if (m_file.ReadArray(&key, 1) && m_file.ReadArray(value.get(), value_size) &&
-            m_file.ReadArray(&entry_number, 1) && entry_number == m_num_entries + 1)
-        {
-          last_valid_value_start = m_file.Tell();
-          reader.Read(key, value.get(), value_size);
-        }
-        else
-        {
-          break;
-        }
-
-        m_num_entries++;
+        if (wasted_size >= COMPACTION_MIN_WASTE && wasted_size >= m_mapping.GetSize() / 4)
+          StartCompaction(std::move(latest_entries));
+        return m_num_entries;
       }
-      m_file.ClearError();
-      m_file.Seek(last_valid_value_start, File::SeekOrigin::Begin);
-
-      return m_num_entries;
     }
 
     // failed to open file for reading or bad header
     // close and recreate file
-    Close();
+    m_file.Close();
+    m_mapping.Close();
+    m_valid_end = 0;
+    m_num_entries = 0;
+    if (read_only)
+      return 0;
     m_file.Open(filename, "wb");
     WriteHeader();
     return 0;
   }
 
-  void Sync() { m_file.Flush(); }
-  void Close()
+  // Calls func(entry_offset, key, value, value_size) for each complete entry in [begin, end)
+  // until it returns false. Returns the offset after the last complete entry.
+  template <typename Func>
+  static u64 ForEachEntry(const u8* data, u64 begin, u64 end, u32 entry_number, Func func)
   {
-    if (m_file.IsOpen())
-      m_file.Close();
+    u64 offset = begin;
+    while (end - offset >= sizeof(u32) + sizeof(K))
+    {
+      u32 value_size;
+      std::memcpy(&value_size, data + offset, sizeof(u32));
+      const u64 entry_size = sizeof(u32) + sizeof(K) + u64{value_size} * sizeof(V) + sizeof(u32);
+      if (end - offset < entry_size)
+        break;
+
+      u32 stored_entry_number;
+      std::memcpy(&stored_entry_number, data + offset + entry_size - sizeof(u32), sizeof(u32));
+      if (stored_entry_number != ++entry_number)
+        break;
+
+      K key;
+      std::memcpy(&key, data + offset + sizeof(u32), sizeof(K));
+      if (!func(offset, key, data + offset + sizeof(u32) + sizeof(K), value_size))
+        break;
+
+      offset += entry_size;
+    }
+    return offset;
   }
 
-  // Appends a key-value pair to the store.
-  void Append(const K& key, const V* value, u32 value_size)
+  u64 GetEntrySize(u64 entry_offset) const
   {
-    // TODO: Should do a check that we don't already have "key"? (I think each caller does that
-    // already.)
-    m_file.WriteArray(&value_size, 1);
-    m_file.WriteArray(&key, 1);
-    m_file.WriteArray(value, value_size);
-    m_num_entries++;
-    m_file.WriteArray(&m_num_entries, 1);
+    u32 value_size;
+    std::memcpy(&value_size, m_mapping.GetData() + entry_offset, sizeof(u32));
+    return sizeof(u32) + sizeof(K) + u64{value_size} * sizeof(V) + sizeof(u32);
   }
 
-private:
-  void WriteHeader() { m_file.WriteArray(&m_header, 1); }
-  bool ValidateHeader()
+  static size_t HashKey(const K& key)
+  {
+    return std::hash<std::string_view>{}(
+        std::string_view(reinterpret_cast<const char*>(&key), sizeof(K)));
+  }
+
+  static bool WriteEntry(File::IOFile& file, const K& key, const u8* value, u32 value_size,
+                         u32 entry_number)
   {
-    char file_header[sizeof(Header)];
+    return file.WriteArray(&value_size, 1) && file.WriteArray(&key, 1) &&
+           file.WriteBytes(value, value_size * sizeof(V)) && file.WriteArray(&entry_number, 1);
+  }
 
-    return (m_file.ReadArray(file_header, sizeof(Header)) &&
-            !memcmp((const char*)&m_header, file_header, sizeof(Header)));
+  // Copies the latest entry of each key to a new file. The copy replaces the file when it's
+  // closed, together with the entries which were appended in the meantime.
+  void StartCompaction(std::unordered_map<size_t, u64> latest_entries)
+  {
+    m_compacted_entries = 0;
+    m_compaction_succeeded = false;
+    m_compaction_file.Open(m_filename + ".compact", "wb");
+    m_compaction_thread = std::thread([this, latest_entries = std::move(latest_entries)] {
+      Common::SetCurrentThreadName("Disk cache compaction");
+      bool success = m_compaction_file.WriteArray(&m_header, 1);
+      ForEachEntry(m_mapping.GetData(), sizeof(Header), m_valid_end, 0,
+                   [&](u64 entry_offset, const K& key, const u8* value, u32 value_size) {
+                     if (latest_entries.at(HashKey(key)) != entry_offset)
+                       return true;
+                     success = WriteEntry(m_compaction_file, key, value, value_size,
+                                          ++m_compacted_entries);
+                     return success;
+                   });
+      m_compaction_succeeded = success;
+    });
   }
 
+  void FinishCompaction()
+  {
+    const std::string compaction_filename = m_filename + ".compact";
+    bool success = m_compaction_succeeded;
+    if (success)
+    {
+      std::vector<u8> appended(m_file.Tell() - m_valid_end);
+      success = m_file.Seek(m_valid_end, File::SeekOrigin::Begin) &&
+                m_file.ReadBytes(appended.data(), appended.size());
+      ForEachEntry(appended.data(), 0, appended.size(), m_entries_at_open,
+                   [&](u64, const K& key, const u8* value, u32 value_size) {
+                     success = success && WriteEntry(m_compaction_file, key, value, value_size,
+                                                     ++m_compacted_entries);
+                     return success;
+                   });
+    }
+    success = m_compaction_file.Close() && success;
+
+    m_file.Close();
+    m_mapping.Close();
+    if (!success || !File::Rename(compaction_filename, m_filename))
+      File::Delete(compaction_filename);
+  }
+
+  void WriteHeader() { m_file.WriteArray(&m_header, 1); }
+
   struct Header
   {
     void Init()
@@ -160,6 +336,18 @@ private:
 
   } m_header;
 
+  std::string m_filename;
+  File::MappedFile m_mapping;
+  // End of the entries which were in the file when it was opened, and how many there were.
+  u64 m_valid_end = 0;
+  u32 m_entries_at_open = 0;
+
+  std::mutex m_file_mutex;
   File::IOFile m_file;
   u32 m_num_entries = 0;
+
+  std::thread m_compaction_thread;
+  File::IOFile m_compaction_file;
+  u32 m_compacted_entries = 0;
+  bool m_compaction_succeeded = false;
 };
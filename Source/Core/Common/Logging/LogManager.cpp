@@ -21,6 +21,7 @@
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 
 namespace Common::Log
 {
@@ -32,6 +33,7 @@ const Config::Info<bool> LOGGER_WRITE_TO_WINDOW{
     {Config::System::Logger, "Options", "WriteToWindow"}, true};
 const Config::Info<LogLevel> LOGGER_VERBOSITY{{Config::System::Logger, "Options", "Verbosity"},
                                               LogLevel::LNOTICE};
+const Config::Info<u32> LOGGER_RATE_LIMIT{{Config::System::Logger, "Options", "RateLimit"}, 0};
 
 class FileLogListener : public LogListener
 {
@@ -68,7 +70,7 @@ void GenericLogFmtImpl(LogLevel level, LogType type, const char* file, int line,
   if (instance == nullptr)
     return;
 
-  if (!instance->IsEnabled(type, level))
+  if (!instance->IsEnabled(type, level) || !instance->ConsumeRateLimit(type))
     return;
 
   const auto message = fmt::vformat(format, args);
@@ -167,11 +169,19 @@ LogManager::LogManager()
         Config::Info<bool>{{Config::System::Logger, "Logs", container.m_short_name}, false});
   }
 
+  m_rate_limit = Config::Get(LOGGER_RATE_LIMIT);
+
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  m_thread = std::thread(&LogManager::ThreadFunc, this);
 }
 
 LogManager::~LogManager()
 {
+  m_shutdown.Set();
+  m_queue_event.Set();
+  m_thread.join();
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -205,30 +215,76 @@ void LogManager::Log(LogLevel level, LogType type, const char* file, int line, c
   LogWithFullPath(level, type, file + m_path_cutoff_point, line, message);
 }
 
-std::string LogManager::GetTimestamp()
+std::string LogManager::GetTimestamp(std::chrono::system_clock::time_point time)
 {
   // NOTE: the Qt LogWidget hardcodes the expected length of the timestamp portion of the log line,
   // so ensure they stay in sync
 
   // We want milliseconds *and not hours*, so can't directly use STL formatters
-  const auto now = std::chrono::system_clock::now();
-  const auto now_s = std::chrono::floor<std::chrono::seconds>(now);
-  const auto now_ms = std::chrono::floor<std::chrono::milliseconds>(now);
-  return fmt::format("{:%M:%S}:{:03}", now_s, (now_ms - now_s).count());
+  const auto time_s = std::chrono::floor<std::chrono::seconds>(time);
+  const auto time_ms = std::chrono::floor<std::chrono::milliseconds>(time);
+  return fmt::format("{:%M:%S}:{:03}", time_s, (time_ms - time_s).count());
 }
 
 void LogManager::LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                                  const char* message)
+{
+  QueueMessage(level, type, file, line, message);
+}
+
+void LogManager::QueueMessage(LogLevel level, LogType type, const char* file, int line,
+                              std::string message)
+{
+  const QueuedMessage queued{std::chrono::system_clock::now(), file,
+                             new std::string(std::move(message)), line, level, type};
+
+  // The logging thread keeps up unless a burst fills the whole queue, in which case the caller
+  // has to wait for it rather than lose or reorder messages.
+  while (!m_queue.TryPush(queued))
+  {
+    m_queue_event.Set();
+    std::this_thread::yield();
+  }
+  m_queue_event.Set();
+}
+
+void LogManager::DeliverMessage(const QueuedMessage& queued)
 {
   const std::string msg =
-      fmt::format("{} {}:{} {}[{}]: {}\n", GetTimestamp(), file, line,
-                  LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), message);
+      fmt::format("{} {}:{} {}[{}]: {}\n", GetTimestamp(queued.time), queued.file, queued.line,
+                  LOG_LEVEL_TO_CHAR[static_cast<int>(queued.level)], GetShortName(queued.type),
+                  *queued.message);
+  delete queued.message;
 
+  std::lock_guard lk(m_listener_mutex);
   for (const auto listener_id : m_listener_ids)
   {
     if (m_listeners[listener_id])
-      m_listeners[listener_id]->Log(level, msg.c_str());
+      m_listeners[listener_id]->Log(queued.level, msg.c_str());
+  }
+}
+
+void LogManager::ThreadFunc()
+{
+  Common::SetCurrentThreadName("Logger");
+
+  QueuedMessage queued;
+  while (true)
+  {
+    m_queue_event.Wait();
+
+    // A message whose producer hasn't finished writing it stops the loop early, but that producer
+    // sets the event again once it's done.
+    while (m_queue.Pop(queued))
+      DeliverMessage(queued);
+
+    if (m_shutdown.IsSet())
+      break;
   }
+
+  // Messages that were still being queued when the loop was left.
+  while (m_queue.Pop(queued))
+    DeliverMessage(queued);
 }
 
 LogLevel LogManager::GetLogLevel() const
@@ -251,6 +307,35 @@ bool LogManager::IsEnabled(LogType type, LogLevel level) const
   return m_log[type].m_enable && GetLogLevel() >= level;
 }
 
+bool LogManager::ConsumeRateLimit(LogType type)
+{
+  if (m_rate_limit == 0)
+    return true;
+
+  auto& state = m_rate_limits[type];
+  const s64 second = std::chrono::duration_cast<std::chrono::seconds>(
+                         std::chrono::steady_clock::now().time_since_epoch())
+                         .count();
+  s64 previous_second = state.second.load(std::memory_order_relaxed);
+  if (previous_second != second &&
+      state.second.compare_exchange_strong(previous_second, second, std::memory_order_relaxed))
+  {
+    state.count.store(0, std::memory_order_relaxed);
+    const u32 dropped = state.dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped != 0)
+    {
+      QueueMessage(LogLevel::LWARNING, type, __FILE__ + m_path_cutoff_point, __LINE__,
+                   fmt::format("{} messages were dropped by the rate limit", dropped));
+    }
+  }
+
+  if (state.count.fetch_add(1, std::memory_order_relaxed) < m_rate_limit)
+    return true;
+
+  state.dropped.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
 std::map<std::string, std::string> LogManager::GetLogTypes()
 {
   std::map<std::string, std::string> log_types;
@@ -273,6 +358,7 @@ const char* LogManager::GetFullName(LogType type) const
 
 void LogManager::RegisterListener(LogListener::LISTENER id, LogListener* listener)
 {
+  std::lock_guard lk(m_listener_mutex);
   m_listeners[id] = listener;
 }
 
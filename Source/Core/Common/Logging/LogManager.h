@@ -4,13 +4,21 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/MPSCQueue.h"
 
 namespace Common::Log
 {
@@ -38,6 +46,8 @@ public:
   static void Init();
   static void Shutdown();
 
+  // Messages are written out asynchronously, so file has to be a string with static storage
+  // duration, such as __FILE__.
   void Log(LogLevel level, LogType type, const char* file, int line, const char* message);
   void LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                        const char* message);
@@ -48,6 +58,10 @@ public:
   void SetEnable(LogType type, bool enable);
   bool IsEnabled(LogType type, LogLevel level = LogLevel::LNOTICE) const;
 
+  // Returns false if the message should be dropped, because more messages than the configured
+  // rate limit have already been logged for this type in the current second.
+  bool ConsumeRateLimit(LogType type);
+
   std::map<std::string, std::string> GetLogTypes();
 
   const char* GetShortName(LogType type) const;
@@ -67,6 +81,25 @@ private:
     bool m_enable = false;
   };
 
+  // Messages are handed over to the logging thread, which adds the prefix and passes them to the
+  // listeners. The message string is allocated by the caller and freed by the logging thread.
+  struct QueuedMessage
+  {
+    std::chrono::system_clock::time_point time;
+    const char* file;
+    std::string* message;
+    int line;
+    LogLevel level;
+    LogType type;
+  };
+
+  struct RateLimitState
+  {
+    std::atomic<s64> second{0};
+    std::atomic<u32> count{0};
+    std::atomic<u32> dropped{0};
+  };
+
   LogManager();
   ~LogManager();
 
@@ -75,12 +108,30 @@ private:
   LogManager(LogManager&&) = delete;
   LogManager& operator=(LogManager&&) = delete;
 
-  static std::string GetTimestamp();
+  static std::string GetTimestamp(std::chrono::system_clock::time_point time);
+
+  void QueueMessage(LogLevel level, LogType type, const char* file, int line,
+                    std::string message);
+  void DeliverMessage(const QueuedMessage& queued);
+  void ThreadFunc();
 
   LogLevel m_level;
   EnumMap<LogContainer, LAST_LOG_TYPE> m_log{};
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+
+  // Messages per second and log type, or 0 for no limit.
+  u32 m_rate_limit = 0;
+  EnumMap<RateLimitState, LAST_LOG_TYPE> m_rate_limits;
+
+  // Held while a message is passed to the listeners, so that a listener that is unregistered
+  // can't be in use anymore once RegisterListener returns.
+  std::mutex m_listener_mutex;
+
+  Common::MPSCQueue<QueuedMessage, 4096> m_queue;
+  Common::Event m_queue_event;
+  Common::Flag m_shutdown;
+  std::thread m_thread;
 };
 }  // namespace Common::Log
@@ -0,0 +1,100 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// A bounded lock-free queue with any number of producers and a single consumer.
+//
+// Producers claim a slot by advancing the write position, then publish the element by bumping
+// the slot's sequence number, so they never wait for each other or for the consumer. A push only
+// fails when the queue is full; callers need a fallback for that case.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+template <typename T, size_t Capacity>
+class MPSCQueue
+{
+  static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+  static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+public:
+  MPSCQueue()
+  {
+    for (size_t i = 0; i < Capacity; ++i)
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  // Can be called from any thread. Returns false if the queue is full. If retries isn't null, it
+  // is incremented every time another producer won the race for a slot.
+  bool TryPush(const T& value, u32* retries = nullptr)
+  {
+    size_t pos = m_write_pos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true)
+    {
+      slot = &m_slots[pos & (Capacity - 1)];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<std::make_signed_t<size_t>>(sequence - pos);
+      if (difference == 0)
+      {
+        if (m_write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+        if (retries)
+          ++*retries;
+      }
+      else if (difference < 0)
+      {
+        // The consumer hasn't popped the element written a full lap ago yet.
+        return false;
+      }
+      else
+      {
+        // Another producer claimed this slot.
+        pos = m_write_pos.load(std::memory_order_relaxed);
+        if (retries)
+          ++*retries;
+      }
+    }
+
+    slot->value = value;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Must only be called from the consumer thread. Returns false if the queue is empty, or if the
+  // oldest element has been claimed by a producer that hasn't finished writing it yet.
+  bool Pop(T& value)
+  {
+    Slot& slot = m_slots[m_read_pos & (Capacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != m_read_pos + 1)
+      return false;
+
+    value = slot.value;
+    slot.sequence.store(m_read_pos + Capacity, std::memory_order_release);
+    ++m_read_pos;
+    return true;
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::array<Slot, Capacity> m_slots;
+  // Kept on separate cache lines, since they're written by different threads.
+  alignas(64) std::atomic<size_t> m_write_pos{0};
+  alignas(64) size_t m_read_pos = 0;
+};
+}  // namespace Common
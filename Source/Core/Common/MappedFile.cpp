@@ -0,0 +1,95 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Common/StringUtil.h"
+
+namespace File
+{
+MappedFile::MappedFile() = default;
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+  Close();
+
+#ifdef _WIN32
+  const HANDLE file = CreateFileW(UTF8ToWString(path).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  // The view keeps the mapping, and the mapping keeps the file open.
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+    return false;
+
+  void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!view)
+    return false;
+
+  m_size = static_cast<size_t>(file_size.QuadPart);
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  // The mapping keeps the file open.
+  void* const view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (view == MAP_FAILED)
+    return false;
+
+  m_size = static_cast<size_t>(st.st_size);
+#endif
+
+  m_data = static_cast<const u8*>(view);
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (!m_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+#else
+  munmap(const_cast<u8*>(m_data), m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+}  // namespace File
@@ -0,0 +1,37 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+// A read-only memory mapping of a whole file. Pages are only read from disk when they are
+// touched, so opening a large file is cheap even if little of it ends up being used.
+class MappedFile final
+{
+public:
+  MappedFile();
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Returns false if the file can't be opened or mapped, or is empty.
+  bool Open(const std::string& path);
+  void Close();
+
+  bool IsOpen() const { return m_data != nullptr; }
+  const u8* GetData() const { return m_data; }
+  size_t GetSize() const { return m_size; }
+
+private:
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+};
+
+}  // namespace File
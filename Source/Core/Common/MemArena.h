@@ -28,14 +28,21 @@ public:
   MemArena& operator=(const MemArena&) = delete;
   MemArena& operator=(MemArena&&) = delete;
 
+  // Size of the huge pages the host uses where huge page backing is supported. Offsets and sizes
+  // aligned to this can be backed by huge pages.
+  static constexpr size_t HUGE_PAGE_SIZE = 0x200000;
+
   ///
   /// Allocate the singular memory segment handled by this MemArena. This will be the actual
   /// 'physical' available memory for this arena. After allocation, it can be interacted with using
   /// CreateView() and ReleaseView(). Used to make a mappable region for emulated memory.
   ///
   /// @param size The amount of bytes that should be allocated in this region.
+  /// @param huge_pages Whether to ask the host to back the segment and its views with huge pages.
+  /// This is only a hint: the outcome is logged, and normal pages are used when they're
+  /// unavailable.
   ///
-  void GrabSHMSegment(size_t size);
+  void GrabSHMSegment(size_t size, bool huge_pages = false);
 
   ///
   /// Release the memory segment previously allocated with GrabSHMSegment().
@@ -119,6 +126,10 @@ private:
   int m_shm_fd;
   void* m_reserved_region;
   std::size_t m_reserved_region_size;
+
+  void AdviseHugePages(void* view, size_t size);
+
+  bool m_huge_pages = false;
 #endif
 #endif
 };
@@ -62,8 +62,12 @@ static int AshmemCreateFileMapping(const char* name, size_t size)
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool huge_pages)
 {
+  // Ashmem segments can't be backed by transparent huge pages.
+  if (huge_pages)
+    NOTICE_LOG_FMT(MEMMAP, "Huge pages unavailable: not supported for ashmem");
+
   fd = AshmemCreateFileMapping(("dolphin-emu." + std::to_string(getpid())).c_str(), size);
   if (fd < 0)
     NOTICE_LOG_FMT(MEMMAP, "Ashmem allocation failed");
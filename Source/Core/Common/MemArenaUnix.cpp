@@ -5,8 +5,10 @@
 
 #include <cerrno>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <set>
 #include <string>
 
@@ -14,6 +16,7 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include "Common/Align.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -22,11 +25,54 @@
 
 namespace Common
 {
+#ifdef MADV_HUGEPAGE
+// Returns the transparent huge page mode the kernel uses for shared memory, or an empty string if
+// it can't be determined.
+static std::string GetShmemHugePageMode()
+{
+  // All the modes are listed, with the active one in brackets: "always [advise] never ..."
+  // This is a sysfs file, whose reported size doesn't match its contents.
+  std::ifstream file("/sys/kernel/mm/transparent_hugepage/shmem_enabled");
+  std::string modes;
+  if (!std::getline(file, modes))
+    return {};
+
+  const size_t begin = modes.find('[');
+  const size_t end = modes.find(']', begin);
+  if (begin == std::string::npos || end == std::string::npos)
+    return {};
+  return modes.substr(begin + 1, end - begin - 1);
+}
+#endif
+
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool huge_pages)
 {
+  m_huge_pages = false;
+  if (huge_pages)
+  {
+#ifdef MADV_HUGEPAGE
+    const std::string mode = GetShmemHugePageMode();
+    if (mode.empty() || mode == "never" || mode == "deny")
+    {
+      NOTICE_LOG_FMT(MEMMAP,
+                     "Huge pages unavailable: the kernel doesn't allow transparent huge pages for "
+                     "shared memory (shmem_enabled: {})",
+                     mode.empty() ? "unknown" : mode);
+    }
+    else
+    {
+      NOTICE_LOG_FMT(MEMMAP, "Using transparent huge pages for emulated memory (shmem_enabled: {})",
+                     mode);
+      m_huge_pages = true;
+    }
+#else
+    NOTICE_LOG_FMT(MEMMAP, "Huge pages unavailable: not supported on this platform");
+#endif
+  }
+
   const std::string file_name = "/dolphin-emu." + std::to_string(getpid());
   m_shm_fd = shm_open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
   if (m_shm_fd == -1)
@@ -54,6 +100,7 @@ void* MemArena::CreateView(s64 offset, size_t size)
   }
   else
   {
+    AdviseHugePages(retval, size);
     return retval;
   }
 }
@@ -65,13 +112,27 @@ void MemArena::ReleaseView(void* view, size_t size)
 
 u8* MemArena::ReserveMemoryRegion(size_t memory_size)
 {
+  // Huge pages can only be used for views whose address is aligned like their offset in the
+  // segment, so the region needs to be aligned to the huge page size.
+  const size_t alignment = m_huge_pages ? HUGE_PAGE_SIZE : 0;
+
   const int flags = MAP_ANON | MAP_PRIVATE;
-  void* base = mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+  void* base = mmap(nullptr, memory_size + alignment, PROT_NONE, flags, -1, 0);
   if (base == MAP_FAILED)
   {
     PanicAlertFmt("Failed to map enough memory space: {}", LastStrerrorString());
     return nullptr;
   }
+  if (alignment != 0)
+  {
+    const uintptr_t unaligned = reinterpret_cast<uintptr_t>(base);
+    const uintptr_t aligned = Common::AlignUp(unaligned, alignment);
+    if (aligned != unaligned)
+      munmap(base, aligned - unaligned);
+    if (aligned - unaligned != alignment)
+      munmap(reinterpret_cast<void*>(aligned + memory_size), alignment - (aligned - unaligned));
+    base = reinterpret_cast<void*>(aligned);
+  }
   m_reserved_region = base;
   m_reserved_region_size = memory_size;
   return static_cast<u8*>(base);
@@ -96,6 +157,7 @@ void* MemArena::MapInMemoryRegion(s64 offset, size_t size, void* base)
   }
   else
   {
+    AdviseHugePages(retval, size);
     return retval;
   }
 }
@@ -106,4 +168,18 @@ void MemArena::UnmapFromMemoryRegion(void* view, size_t size)
   if (retval == MAP_FAILED)
     NOTICE_LOG_FMT(MEMMAP, "mmap failed");
 }
+
+void MemArena::AdviseHugePages(void* view, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+  if (!m_huge_pages || size < HUGE_PAGE_SIZE)
+    return;
+
+  if (madvise(view, size, MADV_HUGEPAGE) != 0)
+  {
+    NOTICE_LOG_FMT(MEMMAP, "madvise(MADV_HUGEPAGE) failed for {} bytes at {}: {}", size,
+                   fmt::ptr(view), LastStrerrorString());
+  }
+#endif
+}
 }  // namespace Common
\ No newline at end of file
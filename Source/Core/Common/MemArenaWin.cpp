@@ -21,8 +21,13 @@ namespace Common
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool huge_pages)
 {
+  // Large page file mappings need the SeLockMemoryPrivilege and large page aligned views, neither
+  // of which the arena can rely on.
+  if (huge_pages)
+    NOTICE_LOG_FMT(MEMMAP, "Huge pages unavailable: not supported on Windows");
+
   const std::string name = "dolphin-emu." + std::to_string(GetCurrentProcessId());
   hMemoryMapping = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
                                      static_cast<DWORD>(size), UTF8ToTStr(name).c_str());
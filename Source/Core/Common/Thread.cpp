@@ -20,13 +20,23 @@
 #include <OS.h>
 #endif
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #ifdef USE_VTUNE
 #include <ittnotify.h>
 #pragma comment(lib, "libittnotify.lib")
 #endif
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <string>
+
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
 
 namespace Common
@@ -146,6 +156,16 @@ void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask)
   pthread_setaffinity_np(thread, cpuset_size(cpu_set), cpu_set);
   cpuset_destroy(cpu_set);
 #endif
+#elif defined ANDROID
+  // Bionic has no pthread_setaffinity_np, but the kernel thread ID can be passed to the syscall.
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+
+  for (int i = 0; i != sizeof(mask) * 8; ++i)
+    if ((mask >> i) & 1)
+      CPU_SET(i, &cpu_set);
+
+  sched_setaffinity(pthread_gettid_np(thread), sizeof(cpu_set), &cpu_set);
 #endif
 }
 
@@ -187,4 +207,71 @@ void SetCurrentThreadName(const char* name)
 
 #endif
 
+namespace
+{
+struct CoreMasks
+{
+  u32 performance = 0;
+  u32 efficiency = 0;
+};
+
+CoreMasks DetectCoreMasks()
+{
+  CoreMasks masks;
+#ifdef __linux__
+  // cpu_capacity is normalized so that the fastest core reports 1024. Not all kernels have it, in
+  // which case the maximum frequency is the next best thing to tell the core types apart.
+  std::array<u64, 32> capacities{};
+  for (u32 i = 0; i < capacities.size(); ++i)
+  {
+    const std::string cpu_path = "/sys/devices/system/cpu/cpu" + std::to_string(i);
+    std::string value;
+    if (!File::ReadFileToString(cpu_path + "/cpu_capacity", value) &&
+        !File::ReadFileToString(cpu_path + "/cpufreq/cpuinfo_max_freq", value))
+    {
+      continue;
+    }
+    TryParse(std::string(StripWhitespace(value)), &capacities[i]);
+  }
+
+  u64 slowest = std::numeric_limits<u64>::max();
+  for (const u64 capacity : capacities)
+  {
+    if (capacity != 0)
+      slowest = std::min(slowest, capacity);
+  }
+
+  for (u32 i = 0; i < capacities.size(); ++i)
+  {
+    if (capacities[i] == 0)
+      continue;
+    if (capacities[i] > slowest)
+      masks.performance |= 1u << i;
+    else
+      masks.efficiency |= 1u << i;
+  }
+
+  if (masks.performance == 0)
+    masks.efficiency = 0;
+#endif
+  return masks;
+}
+
+const CoreMasks& GetCoreMasks()
+{
+  static const CoreMasks masks = DetectCoreMasks();
+  return masks;
+}
+}  // namespace
+
+u32 GetPerformanceCoreMask()
+{
+  return GetCoreMasks().performance;
+}
+
+u32 GetEfficiencyCoreMask()
+{
+  return GetCoreMasks().efficiency;
+}
+
 }  // namespace Common
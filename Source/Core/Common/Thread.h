@@ -22,6 +22,12 @@ int CurrentThreadId();
 void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask);
 void SetCurrentThreadAffinity(u32 mask);
 
+// On CPUs which mix fast and slow cores (e.g. ARM big.LITTLE), returns the cores above the slowest
+// tier and the cores of the slowest tier respectively. Both are 0 if all cores are equally fast or
+// the topology is unknown. Only Linux (including Android) reports the topology for now.
+u32 GetPerformanceCoreMask();
+u32 GetEfficiencyCoreMask();
+
 void SleepCurrentThread(int ms);
 void SwitchCurrentThread();  // On Linux, this is equal to sleep 1ms
 
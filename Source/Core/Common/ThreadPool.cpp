@@ -0,0 +1,96 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ThreadPool.h"
+
+#include <utility>
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+ThreadPool::~ThreadPool()
+{
+  Shutdown();
+}
+
+void ThreadPool::Reset(size_t num_threads, std::string name)
+{
+  Shutdown();
+
+  m_name = std::move(name);
+  m_shutdown = false;
+  m_threads.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i)
+    m_threads.emplace_back(&ThreadPool::ThreadLoop, this);
+}
+
+void ThreadPool::Shutdown()
+{
+  {
+    std::lock_guard lk(m_lock);
+    m_shutdown = true;
+  }
+  m_work_available.notify_all();
+
+  for (std::thread& thread : m_threads)
+    thread.join();
+  m_threads.clear();
+}
+
+void ThreadPool::RunParallel(size_t count, const std::function<void(size_t)>& function)
+{
+  if (m_threads.empty() || count <= 1)
+  {
+    for (size_t i = 0; i < count; ++i)
+      function(i);
+    return;
+  }
+
+  {
+    std::lock_guard lk(m_lock);
+    m_function = &function;
+    m_count = count;
+    m_next_item.store(0, std::memory_order_relaxed);
+    m_busy_threads = m_threads.size();
+    ++m_job_id;
+  }
+  m_work_available.notify_all();
+
+  RunItems();
+
+  std::unique_lock lk(m_lock);
+  m_work_done.wait(lk, [this] { return m_busy_threads == 0; });
+  m_function = nullptr;
+}
+
+void ThreadPool::RunItems()
+{
+  size_t i;
+  while ((i = m_next_item.fetch_add(1, std::memory_order_relaxed)) < m_count)
+    (*m_function)(i);
+}
+
+void ThreadPool::ThreadLoop()
+{
+  Common::SetCurrentThreadName(m_name.c_str());
+
+  std::unique_lock lk(m_lock);
+  u64 last_job_id = m_job_id;
+  while (true)
+  {
+    m_work_available.wait(lk, [&] { return m_shutdown || m_job_id != last_job_id; });
+    if (m_shutdown)
+      return;
+
+    last_job_id = m_job_id;
+    lk.unlock();
+    RunItems();
+    lk.lock();
+
+    if (--m_busy_threads == 0)
+      m_work_done.notify_one();
+  }
+}
+
+}  // namespace Common
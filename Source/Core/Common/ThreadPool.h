@@ -0,0 +1,62 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A fixed set of threads for splitting a job into independent parts. The thread which submits the
+// job takes part in it as well, and waits until every part is done.
+
+namespace Common
+{
+class ThreadPool
+{
+public:
+  ThreadPool() = default;
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Starts num_threads worker threads, stopping the previous ones first.
+  void Reset(size_t num_threads, std::string name);
+  void Shutdown();
+
+  size_t GetNumThreads() const { return m_threads.size(); }
+
+  // Calls function(i) for every i in [0, count), spread over the worker threads and the calling
+  // thread. The calls may run in any order.
+  void RunParallel(size_t count, const std::function<void(size_t)>& function);
+
+private:
+  void ThreadLoop();
+  void RunItems();
+
+  std::vector<std::thread> m_threads;
+  std::string m_name;
+
+  std::mutex m_lock;
+  std::condition_variable m_work_available;
+  std::condition_variable m_work_done;
+
+  // Describe the current job. Only changed while no worker is running it.
+  const std::function<void(size_t)>* m_function = nullptr;
+  size_t m_count = 0;
+  std::atomic<size_t> m_next_item{0};
+
+  u64 m_job_id = 0;
+  size_t m_busy_threads = 0;
+  bool m_shutdown = false;
+};
+
+}  // namespace Common
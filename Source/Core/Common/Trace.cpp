@@ -0,0 +1,126 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/Trace.h"
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Timer.h"
+
+namespace Common::Trace
+{
+namespace
+{
+struct Event
+{
+  const char* name;
+  u64 start_us;
+  // Instant events have no duration.
+  std::optional<u64> duration_us;
+  u32 thread_id;
+};
+
+std::atomic<bool> s_recording = false;
+std::mutex s_events_mutex;
+std::vector<Event> s_events;
+
+// Small sequential IDs keep the exported threads readable, unlike native thread IDs.
+u32 GetThreadID()
+{
+  static std::atomic<u32> s_next_thread_id = 1;
+  thread_local const u32 thread_id = s_next_thread_id.fetch_add(1, std::memory_order_relaxed);
+  return thread_id;
+}
+
+void RecordEvent(const Event& event)
+{
+  std::lock_guard lk(s_events_mutex);
+  if (s_recording.load(std::memory_order_relaxed))
+    s_events.push_back(event);
+}
+}  // namespace
+
+void StartRecording()
+{
+  std::lock_guard lk(s_events_mutex);
+  s_events.clear();
+  s_recording.store(true, std::memory_order_relaxed);
+}
+
+bool IsRecording()
+{
+  return s_recording.load(std::memory_order_relaxed);
+}
+
+bool StopRecordingAndExport(const std::string& path)
+{
+  std::vector<Event> events;
+  {
+    std::lock_guard lk(s_events_mutex);
+    if (!s_recording.exchange(false, std::memory_order_relaxed))
+      return false;
+    events = std::move(s_events);
+    s_events.clear();
+  }
+
+  std::string json = "{\"traceEvents\":[\n";
+  for (size_t i = 0; i < events.size(); ++i)
+  {
+    const Event& event = events[i];
+    if (event.duration_us)
+    {
+      json += fmt::format(R"({{"name":"{}","ph":"X","ts":{},"dur":{},"pid":1,"tid":{}}})",
+                          event.name, event.start_us, *event.duration_us, event.thread_id);
+    }
+    else
+    {
+      json += fmt::format(R"({{"name":"{}","ph":"i","s":"g","ts":{},"pid":1,"tid":{}}})",
+                          event.name, event.start_us, event.thread_id);
+    }
+    json += i + 1 != events.size() ? ",\n" : "\n";
+  }
+  json += "]}\n";
+
+  File::IOFile file(path, "wb");
+  if (!file.WriteString(json))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to write trace to {}", path);
+    return false;
+  }
+
+  NOTICE_LOG_FMT(COMMON, "Wrote {} trace events to {}", events.size(), path);
+  return true;
+}
+
+void AddEvent(const char* name, u64 start_us, u64 end_us)
+{
+  if (IsRecording())
+    RecordEvent(Event{name, start_us, end_us - start_us, GetThreadID()});
+}
+
+void AddInstantEvent(const char* name)
+{
+  if (IsRecording())
+    RecordEvent(Event{name, Timer::NowUs(), std::nullopt, GetThreadID()});
+}
+
+ScopedEvent::ScopedEvent(const char* name) : m_name(name), m_recording(IsRecording())
+{
+  if (m_recording)
+    m_start_us = Timer::NowUs();
+}
+
+ScopedEvent::~ScopedEvent()
+{
+  if (m_recording)
+    AddEvent(m_name, m_start_us, Timer::NowUs());
+}
+}  // namespace Common::Trace
@@ -0,0 +1,47 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// A lightweight recorder for timing how long parts of the emulator take, e.g. during boot.
+// Recorded events can be exported in the Chrome trace event format, which can be opened in
+// chrome://tracing or Perfetto. Nothing is recorded unless recording was started, in which case
+// a scoped event costs one timer read on construction and one lock on destruction.
+//
+// Event names aren't copied, so they must be string literals.
+
+namespace Common::Trace
+{
+// Discards previously recorded events and starts recording.
+void StartRecording();
+bool IsRecording();
+// Stops recording and writes the recorded events to the given path.
+// Returns false if nothing was being recorded or the file couldn't be written.
+bool StopRecordingAndExport(const std::string& path);
+
+// Records an event that started and ended at the given times, as returned by Timer::NowUs().
+void AddEvent(const char* name, u64 start_us, u64 end_us);
+// Records an event without a duration.
+void AddInstantEvent(const char* name);
+
+class ScopedEvent
+{
+public:
+  explicit ScopedEvent(const char* name);
+  ~ScopedEvent();
+
+  ScopedEvent(const ScopedEvent&) = delete;
+  ScopedEvent& operator=(const ScopedEvent&) = delete;
+  ScopedEvent(ScopedEvent&&) = delete;
+  ScopedEvent& operator=(ScopedEvent&&) = delete;
+
+private:
+  const char* m_name;
+  u64 m_start_us = 0;
+  bool m_recording;
+};
+}  // namespace Common::Trace
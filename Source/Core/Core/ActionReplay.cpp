@@ -24,6 +24,7 @@
 #include <atomic>
 #include <iterator>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <utility>
 #include <variant>
@@ -81,9 +82,21 @@ enum
   SUB_MASTER_CODE = 0x03,
 };
 
+// A RAM write, or fill of consecutive addresses, with a constant value.
+struct CompiledWrite
+{
+  u32 address;
+  u32 value;
+  u32 count;
+  u32 size;  // in bytes
+};
+
 // General lock. Protects codes list and internal log.
 static std::mutex s_lock;
 static std::vector<ARCode> s_active_codes;
+// For each active code, its writes if it consists only of RAM writes. Those don't need to be
+// interpreted again every frame once they've been logged.
+static std::vector<std::optional<std::vector<CompiledWrite>>> s_compiled_codes;
 static std::vector<ARCode> s_synced_codes;
 static std::vector<std::string> s_internal_log;
 static std::atomic<bool> s_use_internal_log{false};
@@ -110,6 +123,44 @@ struct ARAddr
   operator u32() const { return address; }
 };
 
+static std::optional<std::vector<CompiledWrite>> CompileCode(const ARCode& code)
+{
+  std::vector<CompiledWrite> writes;
+  writes.reserve(code.ops.size());
+  for (const AREntry& entry : code.ops)
+  {
+    const ARAddr addr(entry.cmd_addr);
+    // Anything which RunCodeLocked doesn't treat as a RAM write (and fill) is left to it.
+    if (addr == 0 || (addr >= 0x00002000 && addr < 0x00003000) || addr.type != 0 ||
+        addr.subtype != SUB_RAM_WRITE)
+    {
+      return std::nullopt;
+    }
+
+    switch (addr.size)
+    {
+    case DATATYPE_8BIT:
+      writes.push_back({addr.GCAddress(), entry.value & 0xFF, (entry.value >> 8) + 1, 1});
+      break;
+    case DATATYPE_16BIT:
+      writes.push_back({addr.GCAddress(), entry.value & 0xFFFF, (entry.value >> 16) + 1, 2});
+      break;
+    default:
+      writes.push_back({addr.GCAddress(), entry.value, 1, 4});
+      break;
+    }
+  }
+  return writes;
+}
+
+static void CompileActiveCodes()
+{
+  s_compiled_codes.clear();
+  s_compiled_codes.reserve(s_active_codes.size());
+  for (const ARCode& code : s_active_codes)
+    s_compiled_codes.emplace_back(CompileCode(code));
+}
+
 // ----------------------
 // AR Remote Functions
 void ApplyCodes(const std::vector<ARCode>& codes)
@@ -123,6 +174,7 @@ void ApplyCodes(const std::vector<ARCode>& codes)
   std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                [](const ARCode& code) { return code.enabled; });
   s_active_codes.shrink_to_fit();
+  CompileActiveCodes();
 }
 
 void SetSyncedCodesAsActive()
@@ -130,6 +182,7 @@ void SetSyncedCodesAsActive()
   s_active_codes.clear();
   s_active_codes.reserve(s_synced_codes.size());
   s_active_codes = s_synced_codes;
+  CompileActiveCodes();
 }
 
 void UpdateSyncedCodes(const std::vector<ARCode>& codes)
@@ -150,6 +203,7 @@ std::vector<ARCode> ApplyAndReturnCodes(const std::vector<ARCode>& codes)
     s_active_codes.clear();
     std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                  [](const ARCode& code) { return code.enabled; });
+    CompileActiveCodes();
   }
   s_active_codes.shrink_to_fit();
 
@@ -165,6 +219,7 @@ void AddCode(ARCode code)
   {
     std::lock_guard guard(s_lock);
     s_disable_logging = false;
+    s_compiled_codes.emplace_back(CompileCode(code));
     s_active_codes.emplace_back(std::move(code));
   }
 }
@@ -977,6 +1032,27 @@ static bool RunCodeLocked(const ARCode& arcode)
   return true;
 }
 
+static void RunCompiledCode(const std::vector<CompiledWrite>& writes)
+{
+  for (const CompiledWrite& write : writes)
+  {
+    switch (write.size)
+    {
+    case 1:
+      for (u32 i = 0; i < write.count; ++i)
+        PowerPC::HostWrite_U8(write.value, write.address + i);
+      break;
+    case 2:
+      for (u32 i = 0; i < write.count; ++i)
+        PowerPC::HostWrite_U16(write.value, write.address + i * 2);
+      break;
+    default:
+      PowerPC::HostWrite_U32(write.value, write.address);
+      break;
+    }
+  }
+}
+
 void RunAllActive()
 {
   if (!Config::Get(Config::MAIN_ENABLE_CHEATS))
@@ -986,13 +1062,28 @@ void RunAllActive()
   // are only atomic ops unless contested. It should be rare for this to
   // be contested.
   std::lock_guard guard(s_lock);
-  s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
-                                      [](const ARCode& code) {
-                                        bool success = RunCodeLocked(code);
-                                        LogInfo("\n");
-                                        return !success;
-                                      }),
-                       s_active_codes.end());
+  for (size_t i = 0; i < s_active_codes.size();)
+  {
+    // Compiled codes can't fail, but still go through the interpreter while they're being logged.
+    if (s_disable_logging && s_compiled_codes[i])
+    {
+      RunCompiledCode(*s_compiled_codes[i]);
+      ++i;
+      continue;
+    }
+
+    const bool success = RunCodeLocked(s_active_codes[i]);
+    LogInfo("\n");
+    if (success)
+    {
+      ++i;
+    }
+    else
+    {
+      s_active_codes.erase(s_active_codes.begin() + i);
+      s_compiled_codes.erase(s_compiled_codes.begin() + i);
+    }
+  }
   s_disable_logging = true;
 }
 
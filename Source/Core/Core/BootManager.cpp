@@ -28,6 +28,7 @@
 #include "Common/FileUtil.h"
 #include "Common/IniFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/Trace.h"
 
 #include "Core/Boot/Boot.h"
 #include "Core/Config/MainSettings.h"
@@ -59,10 +60,17 @@ bool BootCore(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
   if (!boot)
     return false;
 
+  if (Config::Get(Config::MAIN_DEBUG_BOOT_TRACE))
+    Common::Trace::StartRecording();
+  Common::Trace::ScopedEvent trace_event("BootManager::BootCore");
+
   SConfig& StartUp = SConfig::GetInstance();
 
-  if (!StartUp.SetPathsAndGameMetadata(*boot))
-    return false;
+  {
+    Common::Trace::ScopedEvent metadata_trace_event("Game metadata and config");
+    if (!StartUp.SetPathsAndGameMetadata(*boot))
+      return false;
+  }
 
   // Movie settings
   if (Movie::IsPlayingInput() && Movie::IsConfigSaved())
@@ -147,6 +155,7 @@ bool BootCore(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
 
   if (StartUp.bWii)
   {
+    Common::Trace::ScopedEvent wii_root_trace_event("Wii root initialization");
     Core::InitializeWiiRoot(Core::WantsDeterminism());
 
     // Ensure any new settings are written to the SYSCONF
@@ -0,0 +1,133 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/CPUBenchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include <picojson.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Timer.h"
+#include "Core/CoreTiming.h"
+#include "Core/Host.h"
+
+namespace CPUBenchmark
+{
+static std::atomic<bool> s_running{false};
+static std::mutex s_mutex;
+static u32 s_num_fields = 0;
+static bool s_complete = false;
+static u64 s_start_us = 0;
+static u64 s_last_field_us = 0;
+static u64 s_start_ticks = 0;
+static JitInterface::CompileStats s_start_compile_stats;
+static JitInterface::CodeSpaceStats s_start_code_space_stats;
+static Results s_results;
+
+void Start(u32 num_fields)
+{
+  std::lock_guard lk(s_mutex);
+  s_num_fields = std::max<u32>(num_fields, 1);
+  s_complete = false;
+  s_start_us = 0;
+  s_results = {};
+  s_running.store(true, std::memory_order_relaxed);
+}
+
+std::optional<Results> Stop()
+{
+  std::lock_guard lk(s_mutex);
+  s_running.store(false, std::memory_order_relaxed);
+  if (!s_complete)
+    return std::nullopt;
+
+  return std::move(s_results);
+}
+
+void OnNewField()
+{
+  if (!s_running.load(std::memory_order_relaxed))
+    return;
+
+  std::lock_guard lk(s_mutex);
+  const u64 now = Common::Timer::NowUs();
+  if (s_start_us == 0)
+  {
+    s_start_us = now;
+    s_last_field_us = now;
+    s_start_ticks = CoreTiming::GetTicks();
+    s_start_compile_stats = JitInterface::GetCompileStats();
+    s_start_code_space_stats = JitInterface::GetCodeSpaceStats();
+    return;
+  }
+
+  s_results.field_times_us.push_back(now - s_last_field_us);
+  s_last_field_us = now;
+  if (s_results.field_times_us.size() < s_num_fields)
+    return;
+
+  // The counters are reset when the JIT is recreated, which doesn't happen while emulating.
+  const JitInterface::CompileStats compile_stats = JitInterface::GetCompileStats();
+  const JitInterface::CodeSpaceStats code_space_stats = JitInterface::GetCodeSpaceStats();
+  s_results.emulated_cycles = CoreTiming::GetTicks() - s_start_ticks;
+  s_results.compile_stats.compiled_blocks =
+      compile_stats.compiled_blocks - s_start_compile_stats.compiled_blocks;
+  s_results.compile_stats.compile_time_us =
+      compile_stats.compile_time_us - s_start_compile_stats.compile_time_us;
+  s_results.compile_stats.cache_clears =
+      compile_stats.cache_clears - s_start_compile_stats.cache_clears;
+  s_results.evicted_blocks =
+      code_space_stats.evicted_blocks - s_start_code_space_stats.evicted_blocks;
+  s_results.full_clears = code_space_stats.full_clears - s_start_code_space_stats.full_clears;
+
+  s_complete = true;
+  s_running.store(false, std::memory_order_relaxed);
+  Host_Message(HostMessageID::WMUserStop);
+}
+
+bool WriteResultsJSON(const std::string& path, const Results& results,
+                      const std::string& description)
+{
+  std::vector<u64> field_times = results.field_times_us;
+  std::sort(field_times.begin(), field_times.end());
+  const auto percentile = [&field_times](size_t percent) {
+    return static_cast<double>(field_times[(field_times.size() - 1) * percent / 100]);
+  };
+
+  double host_time_us = 0;
+  picojson::array json_field_times;
+  for (const u64 time : results.field_times_us)
+  {
+    host_time_us += time;
+    json_field_times.emplace_back(static_cast<double>(time));
+  }
+
+  const double fields = static_cast<double>(field_times.size());
+  const double emulated_cycles = static_cast<double>(results.emulated_cycles);
+
+  picojson::object jit;
+  jit.emplace("compiled_blocks", static_cast<double>(results.compile_stats.compiled_blocks));
+  jit.emplace("compile_time_us", static_cast<double>(results.compile_stats.compile_time_us));
+  jit.emplace("cache_clears", static_cast<double>(results.compile_stats.cache_clears));
+  jit.emplace("full_clears", static_cast<double>(results.full_clears));
+  jit.emplace("evicted_blocks", static_cast<double>(results.evicted_blocks));
+
+  picojson::object root;
+  root.emplace("description", description);
+  root.emplace("fields", fields);
+  root.emplace("host_time_us", host_time_us);
+  root.emplace("emulated_cycles", emulated_cycles);
+  root.emplace("emulated_mhz", emulated_cycles / host_time_us);
+  root.emplace("mean_field_time_us", host_time_us / fields);
+  root.emplace("median_field_time_us", percentile(50));
+  root.emplace("p99_field_time_us", percentile(99));
+  root.emplace("max_field_time_us", static_cast<double>(field_times.back()));
+  root.emplace("jit", std::move(jit));
+  root.emplace("field_times_us", std::move(json_field_times));
+
+  return File::WriteStringToFile(path, picojson::value(std::move(root)).serialize(true));
+}
+}  // namespace CPUBenchmark
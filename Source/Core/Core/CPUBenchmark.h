@@ -0,0 +1,41 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/JitInterface.h"
+
+// Measures how fast the CPU core emulates a fixed number of VI fields, so that changes to the JITs
+// can be compared across builds. The JITs don't count the instructions they run, so throughput is
+// given in emulated CPU cycles per host second.
+namespace CPUBenchmark
+{
+struct Results
+{
+  u64 emulated_cycles = 0;
+  // Host time of each emulated VI field.
+  std::vector<u64> field_times_us;
+  // Compilation and code space counters of the JIT, for the measured fields only.
+  JitInterface::CompileStats compile_stats;
+  u32 evicted_blocks = 0;
+  u32 full_clears = 0;
+};
+
+// Measurement begins at the first VI field after this, so that booting isn't included, and
+// emulation is stopped once num_fields more fields have been emulated.
+void Start(u32 num_fields);
+// Returns the results if all fields were measured.
+std::optional<Results> Stop();
+
+// Called by Core on the CPU thread at every emulated VI field.
+void OnNewField();
+
+// Returns false if the file can't be written.
+bool WriteResultsJSON(const std::string& path, const Results& results,
+                      const std::string& description);
+}  // namespace CPUBenchmark
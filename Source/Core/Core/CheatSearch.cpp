@@ -3,11 +3,15 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -15,6 +19,7 @@
 #include "Common/Align.h"
 #include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -185,6 +190,40 @@ TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
 {
   return PowerPC::HostTryReadF64(addr, space);
 }
+
+// A range which is being searched, with the host memory of each page of it which is in MEM1 or
+// MEM2. Values in those pages are read directly, and can be compared on several threads.
+struct PageTable
+{
+  u32 first_page;
+  std::vector<const u8*> pages;
+
+  template <typename T>
+  std::optional<T> TryRead(u32 addr) const
+  {
+    const size_t index = (addr - first_page) / PowerPC::HW_PAGE_SIZE;
+    const u32 offset = addr & PowerPC::HW_PAGE_MASK;
+    const u8* page = pages[index];
+    if (!page)
+      return std::nullopt;
+
+    T value;
+    const u32 size_in_page = std::min<u32>(sizeof(T), PowerPC::HW_PAGE_SIZE - offset);
+    std::memcpy(&value, page + offset, size_in_page);
+    if (size_in_page < sizeof(T))
+    {
+      const u8* next_page = index + 1 < pages.size() ? pages[index + 1] : nullptr;
+      if (!next_page)
+        return std::nullopt;
+      std::memcpy(reinterpret_cast<u8*>(&value) + size_in_page, next_page,
+                  sizeof(T) - size_in_page);
+    }
+    return Common::FromBigEndian(value);
+  }
+};
+
+// Ranges with fewer values than this per thread aren't worth splitting up.
+constexpr u64 MIN_VALUES_PER_SEARCH_THREAD = 0x10000;
 }  // namespace
 
 template <typename T>
@@ -210,6 +249,13 @@ Cheats::NewSearch(const std::vector<Cheats::MemoryRange>& memory_ranges,
       return;
     }
 
+    const bool translated =
+        address_space == PowerPC::RequestedAddressSpace::Virtual ||
+        (address_space == PowerPC::RequestedAddressSpace::Effective && MSR.DR);
+    const Cheats::SearchResultValueState page_value_state =
+        translated ? Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                     Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+
     for (const Cheats::MemoryRange& range : memory_ranges)
     {
       if (range.m_length < data_size)
@@ -223,21 +269,86 @@ Cheats::NewSearch(const std::vector<Cheats::MemoryRange>& memory_ranges,
         continue;
 
       const u64 length = aligned_length - (data_size - 1);
-      for (u64 i = 0; i < length; i += increment_per_loop)
+
+      // Translate each page only once, instead of every address in it.
+      PageTable page_table;
+      page_table.first_page = start_address & ~PowerPC::HW_PAGE_MASK;
+      const u64 last_page = (start_address + aligned_length - 1) & ~PowerPC::HW_PAGE_MASK;
+      page_table.pages.resize((last_page - page_table.first_page) / PowerPC::HW_PAGE_SIZE + 1);
+      for (size_t i = 0; i < page_table.pages.size(); ++i)
       {
-        const u32 addr = start_address + i;
-        const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
-        if (!current_value)
-          continue;
+        page_table.pages[i] = PowerPC::HostGetRAMPage(
+            static_cast<u32>(page_table.first_page + i * PowerPC::HW_PAGE_SIZE), address_space);
+      }
+
+      // Values outside of MEM1 and MEM2 are marked as not accessible here, and read the slow way
+      // on this thread below.
+      const auto search_values = [&](u64 begin, u64 end) {
+        std::vector<Cheats::SearchResult<T>> range_results;
+        for (u64 i = begin; i < end; i += increment_per_loop)
+        {
+          const u32 addr = static_cast<u32>(start_address + i);
+          const std::optional<T> value = page_table.TryRead<T>(addr);
+          if (!value)
+          {
+            auto& r = range_results.emplace_back();
+            r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
+            r.m_address = addr;
+          }
+          else if (validator(*value))
+          {
+            auto& r = range_results.emplace_back();
+            r.m_value = *value;
+            r.m_value_state = page_value_state;
+            r.m_address = addr;
+          }
+        }
+        return range_results;
+      };
+
+      const u64 num_values = (length + increment_per_loop - 1) / increment_per_loop;
+      const u64 threads = std::clamp<u64>(num_values / MIN_VALUES_PER_SEARCH_THREAD, 1,
+                                          std::max(1U, std::thread::hardware_concurrency()));
+      const u64 values_per_thread = (num_values + threads - 1) / threads;
 
-        if (validator(current_value->value))
+      // The first part is searched on this thread, while the others are searched in parallel.
+      std::vector<std::future<std::vector<Cheats::SearchResult<T>>>> futures;
+      for (u64 i = 1; i < threads; ++i)
+      {
+        const u64 begin = std::min(i * values_per_thread, num_values) * increment_per_loop;
+        const u64 end = std::min((i + 1) * values_per_thread, num_values) * increment_per_loop;
+        futures.push_back(std::async(std::launch::async, search_values, begin, end));
+      }
+      std::vector<std::vector<Cheats::SearchResult<T>>> parts;
+      parts.push_back(
+          search_values(0, std::min(values_per_thread, num_values) * increment_per_loop));
+      for (auto& future : futures)
+        parts.push_back(future.get());
+
+      for (const auto& part : parts)
+      {
+        for (const auto& result : part)
         {
-          auto& r = results.emplace_back();
-          r.m_value = current_value->value;
-          r.m_value_state = current_value->translated ?
-                                Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                                Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-          r.m_address = addr;
+          if (result.IsValueValid())
+          {
+            results.push_back(result);
+            continue;
+          }
+
+          const u32 addr = result.m_address;
+          const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
+          if (!current_value)
+            continue;
+
+          if (validator(current_value->value))
+          {
+            auto& r = results.emplace_back();
+            r.m_value = current_value->value;
+            r.m_value_state = current_value->translated ?
+                                  Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                                  Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+            r.m_address = addr;
+          }
         }
       }
     }
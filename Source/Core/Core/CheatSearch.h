@@ -105,7 +105,8 @@ DataType GetDataType(const SearchValue& value);
 std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 
 // Do a new search across the given memory region in the given address space, only keeping values
-// for which the given validator returns true.
+// for which the given validator returns true. The validator may be called from several threads at
+// once.
 template <typename T>
 Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
 NewSearch(const std::vector<MemoryRange>& memory_ranges,
@@ -15,6 +15,7 @@ namespace Config
 // Graphics.Hardware
 
 const Info<bool> GFX_VSYNC{{System::GFX, "Hardware", "VSync"}, false};
+const Info<bool> GFX_DISPLAY_PACING{{System::GFX, "Hardware", "DisplayPacing"}, false};
 const Info<int> GFX_ADAPTER{{System::GFX, "Hardware", "Adapter"}, 0};
 
 // Graphics.Settings
@@ -32,14 +33,23 @@ const Info<bool> GFX_SHOW_NETPLAY_PING{{System::GFX, "Settings", "ShowNetPlayPin
 const Info<bool> GFX_SHOW_NETPLAY_MESSAGES{{System::GFX, "Settings", "ShowNetPlayMessages"}, false};
 const Info<bool> GFX_LOG_RENDER_TIME_TO_FILE{{System::GFX, "Settings", "LogRenderTimeToFile"},
                                              false};
+const Info<bool> GFX_LOG_GPU_TIMINGS_TO_FILE{{System::GFX, "Settings", "LogGPUTimingsToFile"},
+                                             false};
 const Info<bool> GFX_OVERLAY_STATS{{System::GFX, "Settings", "OverlayStats"}, false};
+const Info<bool> GFX_SHOW_FRAME_TIMELINE{{System::GFX, "Settings", "ShowFrameTimeline"}, false};
 const Info<bool> GFX_OVERLAY_PROJ_STATS{{System::GFX, "Settings", "OverlayProjStats"}, false};
 const Info<bool> GFX_OVERLAY_SCISSOR_STATS{{System::GFX, "Settings", "OverlayScissorStats"}, false};
 const Info<bool> GFX_DUMP_TEXTURES{{System::GFX, "Settings", "DumpTextures"}, false};
 const Info<bool> GFX_DUMP_MIP_TEXTURES{{System::GFX, "Settings", "DumpMipTextures"}, true};
 const Info<bool> GFX_DUMP_BASE_TEXTURES{{System::GFX, "Settings", "DumpBaseTextures"}, true};
+const Info<bool> GFX_DUMP_TEXTURES_FAST_COMPRESSION{
+    {System::GFX, "Settings", "DumpTexturesFastCompression"}, false};
 const Info<bool> GFX_HIRES_TEXTURES{{System::GFX, "Settings", "HiresTextures"}, false};
 const Info<bool> GFX_CACHE_HIRES_TEXTURES{{System::GFX, "Settings", "CacheHiresTextures"}, false};
+const Info<bool> GFX_HIRES_TEXTURES_STREAMING{{System::GFX, "Settings", "HiresTexturesStreaming"},
+                                              false};
+const Info<int> GFX_HIRES_TEXTURES_MEMORY_LIMIT{
+    {System::GFX, "Settings", "HiresTexturesMemoryLimit"}, 512};
 const Info<bool> GFX_DUMP_EFB_TARGET{{System::GFX, "Settings", "DumpEFBTarget"}, false};
 const Info<bool> GFX_DUMP_XFB_TARGET{{System::GFX, "Settings", "DumpXFBTarget"}, false};
 const Info<bool> GFX_DUMP_FRAMES_AS_IMAGES{{System::GFX, "Settings", "DumpFramesAsImages"}, false};
@@ -48,18 +58,31 @@ const Info<std::string> GFX_DUMP_FORMAT{{System::GFX, "Settings", "DumpFormat"},
 const Info<std::string> GFX_DUMP_CODEC{{System::GFX, "Settings", "DumpCodec"}, ""};
 const Info<std::string> GFX_DUMP_PIXEL_FORMAT{{System::GFX, "Settings", "DumpPixelFormat"}, ""};
 const Info<std::string> GFX_DUMP_ENCODER{{System::GFX, "Settings", "DumpEncoder"}, ""};
+const Info<bool> GFX_DUMP_HARDWARE_ENCODER{{System::GFX, "Settings", "DumpHardwareEncoder"},
+                                           false};
 const Info<std::string> GFX_DUMP_PATH{{System::GFX, "Settings", "DumpPath"}, ""};
 const Info<int> GFX_BITRATE_KBPS{{System::GFX, "Settings", "BitrateKbps"}, 25000};
 const Info<bool> GFX_INTERNAL_RESOLUTION_FRAME_DUMPS{
     {System::GFX, "Settings", "InternalResolutionFrameDumps"}, false};
 const Info<int> GFX_PNG_COMPRESSION_LEVEL{{System::GFX, "Settings", "PNGCompressionLevel"}, 6};
+// Mobile devices are far more often limited by the CPU than by the GPU, so decoding textures in
+// compute shaders is a win there wherever the backend supports it.
+#ifdef ANDROID
+const Info<bool> GFX_ENABLE_GPU_TEXTURE_DECODING{
+    {System::GFX, "Settings", "EnableGPUTextureDecoding"}, true};
+#else
 const Info<bool> GFX_ENABLE_GPU_TEXTURE_DECODING{
     {System::GFX, "Settings", "EnableGPUTextureDecoding"}, false};
+#endif
 const Info<bool> GFX_ENABLE_PIXEL_LIGHTING{{System::GFX, "Settings", "EnablePixelLighting"}, false};
 const Info<bool> GFX_FAST_DEPTH_CALC{{System::GFX, "Settings", "FastDepthCalc"}, true};
 const Info<u32> GFX_MSAA{{System::GFX, "Settings", "MSAA"}, 1};
 const Info<bool> GFX_SSAA{{System::GFX, "Settings", "SSAA"}, false};
 const Info<int> GFX_EFB_SCALE{{System::GFX, "Settings", "InternalResolution"}, 100};
+const Info<bool> GFX_DYNAMIC_RESOLUTION{{System::GFX, "Settings", "DynamicResolution"}, false};
+const Info<int> GFX_DYNAMIC_RESOLUTION_MIN_SCALE{
+    {System::GFX, "Settings", "DynamicResolutionMinScale"}, 50};
+const Info<bool> GFX_THERMAL_GOVERNOR{{System::GFX, "Settings", "ThermalGovernor"}, false};
 const Info<bool> GFX_TEXFMT_OVERLAY_ENABLE{{System::GFX, "Settings", "TexFmtOverlayEnable"}, false};
 const Info<bool> GFX_TEXFMT_OVERLAY_CENTER{{System::GFX, "Settings", "TexFmtOverlayCenter"}, false};
 const Info<bool> GFX_ENABLE_WIREFRAME{{System::GFX, "Settings", "WireFrame"}, false};
@@ -84,14 +107,24 @@ const Info<int> GFX_SHADER_PRECOMPILER_THREADS{
     {System::GFX, "Settings", "ShaderPrecompilerThreads"}, -1};
 const Info<bool> GFX_SAVE_TEXTURE_CACHE_TO_STATE{
     {System::GFX, "Settings", "SaveTextureCacheToState"}, true};
+const Info<bool> GFX_SAVE_TEXTURE_CACHE_AT_NATIVE_RESOLUTION{
+    {System::GFX, "Settings", "SaveTextureCacheAtNativeResolution"}, false};
 const Info<bool> GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION{
     {System::GFX, "Settings", "PreferVSForLinePointExpansion"}, false};
+// Android devices share a few GB of memory between the GPU and everything else, and the system
+// kills the app rather than failing allocations, so the texture cache is kept in check there.
+#ifdef ANDROID
+const Info<int> GFX_TEXTURE_CACHE_BUDGET_MB{{System::GFX, "Settings", "TextureCacheBudgetMB"}, 512};
+#else
+const Info<int> GFX_TEXTURE_CACHE_BUDGET_MB{{System::GFX, "Settings", "TextureCacheBudgetMB"}, 0};
+#endif
 
 const Info<TriState> GFX_MTL_MANUALLY_UPLOAD_BUFFERS{
     {System::GFX, "Settings", "ManuallyUploadBuffers"}, TriState::Auto};
 const Info<bool> GFX_MTL_USE_PRESENT_DRAWABLE{{System::GFX, "Settings", "MTLUsePresentDrawable"},
                                               false};
 
+const Info<int> GFX_SW_RASTERIZER_THREADS{{System::GFX, "Settings", "SWRasterizerThreads"}, -1};
 const Info<bool> GFX_SW_DUMP_OBJECTS{{System::GFX, "Settings", "SWDumpObjects"}, false};
 const Info<bool> GFX_SW_DUMP_TEV_STAGES{{System::GFX, "Settings", "SWDumpTevStages"}, false};
 const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES{{System::GFX, "Settings", "SWDumpTevTexFetches"},
@@ -150,6 +183,8 @@ const Info<bool> GFX_HACK_EARLY_XFB_OUTPUT{{System::GFX, "Hacks", "EarlyXFBOutpu
 const Info<bool> GFX_HACK_COPY_EFB_SCALED{{System::GFX, "Hacks", "EFBScaledCopy"}, true};
 const Info<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES{
     {System::GFX, "Hacks", "EFBEmulateFormatChanges"}, false};
+const Info<bool> GFX_HACK_REDUCED_PRECISION_EFB_DEPTH{
+    {System::GFX, "Hacks", "ReducedPrecisionEFBDepth"}, false};
 const Info<bool> GFX_HACK_VERTEX_ROUNDING{{System::GFX, "Hacks", "VertexRounding"}, false};
 const Info<u32> GFX_HACK_MISSING_COLOR_VALUE{{System::GFX, "Hacks", "MissingColorValue"},
                                              0xFFFFFFFF};
@@ -162,4 +197,5 @@ const Info<bool> GFX_HACK_NO_MIPMAPPING{{System::GFX, "Hacks", "NoMipmapping"},
 // Graphics.GameSpecific
 
 const Info<bool> GFX_PERF_QUERIES_ENABLE{{System::GFX, "GameSpecific", "PerfQueriesEnable"}, false};
+const Info<bool> GFX_PERF_QUERIES_ASYNC{{System::GFX, "GameSpecific", "PerfQueriesAsync"}, false};
 }  // namespace Config
@@ -19,6 +19,7 @@ namespace Config
 // Graphics.Hardware
 
 extern const Info<bool> GFX_VSYNC;
+extern const Info<bool> GFX_DISPLAY_PACING;
 extern const Info<int> GFX_ADAPTER;
 
 // Graphics.Settings
@@ -33,14 +34,19 @@ extern const Info<bool> GFX_SHOW_FPS;
 extern const Info<bool> GFX_SHOW_NETPLAY_PING;
 extern const Info<bool> GFX_SHOW_NETPLAY_MESSAGES;
 extern const Info<bool> GFX_LOG_RENDER_TIME_TO_FILE;
+extern const Info<bool> GFX_LOG_GPU_TIMINGS_TO_FILE;
 extern const Info<bool> GFX_OVERLAY_STATS;
+extern const Info<bool> GFX_SHOW_FRAME_TIMELINE;
 extern const Info<bool> GFX_OVERLAY_PROJ_STATS;
 extern const Info<bool> GFX_OVERLAY_SCISSOR_STATS;
 extern const Info<bool> GFX_DUMP_TEXTURES;
 extern const Info<bool> GFX_DUMP_MIP_TEXTURES;
 extern const Info<bool> GFX_DUMP_BASE_TEXTURES;
+extern const Info<bool> GFX_DUMP_TEXTURES_FAST_COMPRESSION;
 extern const Info<bool> GFX_HIRES_TEXTURES;
 extern const Info<bool> GFX_CACHE_HIRES_TEXTURES;
+extern const Info<bool> GFX_HIRES_TEXTURES_STREAMING;
+extern const Info<int> GFX_HIRES_TEXTURES_MEMORY_LIMIT;
 extern const Info<bool> GFX_DUMP_EFB_TARGET;
 extern const Info<bool> GFX_DUMP_XFB_TARGET;
 extern const Info<bool> GFX_DUMP_FRAMES_AS_IMAGES;
@@ -49,6 +55,7 @@ extern const Info<std::string> GFX_DUMP_FORMAT;
 extern const Info<std::string> GFX_DUMP_CODEC;
 extern const Info<std::string> GFX_DUMP_PIXEL_FORMAT;
 extern const Info<std::string> GFX_DUMP_ENCODER;
+extern const Info<bool> GFX_DUMP_HARDWARE_ENCODER;
 extern const Info<std::string> GFX_DUMP_PATH;
 extern const Info<int> GFX_BITRATE_KBPS;
 extern const Info<bool> GFX_INTERNAL_RESOLUTION_FRAME_DUMPS;
@@ -59,6 +66,9 @@ extern const Info<bool> GFX_FAST_DEPTH_CALC;
 extern const Info<u32> GFX_MSAA;
 extern const Info<bool> GFX_SSAA;
 extern const Info<int> GFX_EFB_SCALE;
+extern const Info<bool> GFX_DYNAMIC_RESOLUTION;
+extern const Info<int> GFX_DYNAMIC_RESOLUTION_MIN_SCALE;
+extern const Info<bool> GFX_THERMAL_GOVERNOR;
 extern const Info<bool> GFX_TEXFMT_OVERLAY_ENABLE;
 extern const Info<bool> GFX_TEXFMT_OVERLAY_CENTER;
 extern const Info<bool> GFX_ENABLE_WIREFRAME;
@@ -73,11 +83,14 @@ extern const Info<ShaderCompilationMode> GFX_SHADER_COMPILATION_MODE;
 extern const Info<int> GFX_SHADER_COMPILER_THREADS;
 extern const Info<int> GFX_SHADER_PRECOMPILER_THREADS;
 extern const Info<bool> GFX_SAVE_TEXTURE_CACHE_TO_STATE;
+extern const Info<bool> GFX_SAVE_TEXTURE_CACHE_AT_NATIVE_RESOLUTION;
 extern const Info<bool> GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION;
+extern const Info<int> GFX_TEXTURE_CACHE_BUDGET_MB;
 
 extern const Info<TriState> GFX_MTL_MANUALLY_UPLOAD_BUFFERS;
 extern const Info<bool> GFX_MTL_USE_PRESENT_DRAWABLE;
 
+extern const Info<int> GFX_SW_RASTERIZER_THREADS;
 extern const Info<bool> GFX_SW_DUMP_OBJECTS;
 extern const Info<bool> GFX_SW_DUMP_TEV_STAGES;
 extern const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES;
@@ -127,6 +140,7 @@ extern const Info<bool> GFX_HACK_SKIP_DUPLICATE_XFBS;
 extern const Info<bool> GFX_HACK_EARLY_XFB_OUTPUT;
 extern const Info<bool> GFX_HACK_COPY_EFB_SCALED;
 extern const Info<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES;
+extern const Info<bool> GFX_HACK_REDUCED_PRECISION_EFB_DEPTH;
 extern const Info<bool> GFX_HACK_VERTEX_ROUNDING;
 extern const Info<u32> GFX_HACK_MISSING_COLOR_VALUE;
 extern const Info<bool> GFX_HACK_FAST_TEXTURE_SAMPLING;
@@ -137,5 +151,6 @@ extern const Info<bool> GFX_HACK_NO_MIPMAPPING;
 // Graphics.GameSpecific
 
 extern const Info<bool> GFX_PERF_QUERIES_ENABLE;
+extern const Info<bool> GFX_PERF_QUERIES_ASYNC;
 
 }  // namespace Config
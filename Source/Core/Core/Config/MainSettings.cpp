@@ -25,6 +25,7 @@
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SI/SI_Device.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/State.h"
 #include "DiscIO/Enums.h"
 #include "VideoCommon/VideoBackendBase.h"
 
@@ -36,10 +37,25 @@ const Info<bool> MAIN_SKIP_IPL{{System::Main, "Core", "SkipIPL"}, true};
 const Info<PowerPC::CPUCore> MAIN_CPU_CORE{{System::Main, "Core", "CPUCore"},
                                            PowerPC::DefaultCPUCore()};
 const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"}, true};
+const Info<bool> MAIN_JIT_BLOCK_DISK_CACHE{{System::Main, "Core", "JITBlockDiskCache"}, false};
+const Info<bool> MAIN_JIT_TIERED_COMPILATION{{System::Main, "Core", "JITTieredCompilation"},
+                                             false};
+const Info<bool> MAIN_JIT_INTERPRET_COLD_BLOCKS{{System::Main, "Core", "JITInterpretColdBlocks"},
+                                                false};
+const Info<bool> MAIN_JIT_TRACE_FORMATION{{System::Main, "Core", "JITTraceFormation"}, false};
+const Info<bool> MAIN_JIT_INDIRECT_BRANCH_CACHE{{System::Main, "Core", "JITIndirectBranchCache"},
+                                                false};
+const Info<bool> MAIN_JIT_LOOP_REGISTER_ENTRY{{System::Main, "Core", "JITLoopRegisterEntry"},
+                                              false};
+const Info<bool> MAIN_JIT_CACHE_EVICTION{{System::Main, "Core", "JITCacheEviction"}, false};
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
+const Info<bool> MAIN_HUGE_PAGES{{System::Main, "Core", "HugePages"}, false};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const Info<int> MAIN_TIMING_VARIANCE{{System::Main, "Core", "TimingVariance"}, 40};
 const Info<bool> MAIN_CPU_THREAD{{System::Main, "Core", "CPUThread"}, true};
+const Info<bool> MAIN_PIN_THREADS_TO_CORE_TYPES{{System::Main, "Core", "PinThreadsToCoreTypes"},
+                                                true};
+const Info<bool> MAIN_LOW_MEMORY_MODE{{System::Main, "Core", "LowMemoryMode"}, false};
 const Info<bool> MAIN_SYNC_ON_SKIP_IDLE{{System::Main, "Core", "SyncOnSkipIdle"}, true};
 const Info<std::string> MAIN_DEFAULT_ISO{{System::Main, "Core", "DefaultISO"}, ""};
 const Info<bool> MAIN_ENABLE_CHEATS{{System::Main, "Core", "EnableCheats"}, false};
@@ -188,6 +204,7 @@ const Info<bool> MAIN_SYNC_GPU{{System::Main, "Core", "SyncGPU"}, false};
 const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE{{System::Main, "Core", "SyncGpuMaxDistance"}, 200000};
 const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE{{System::Main, "Core", "SyncGpuMinDistance"}, -200000};
 const Info<float> MAIN_SYNC_GPU_OVERCLOCK{{System::Main, "Core", "SyncGpuOverclock"}, 1.0f};
+const Info<bool> MAIN_SYNC_GPU_ADAPTIVE{{System::Main, "Core", "SyncGpuAdaptive"}, false};
 const Info<bool> MAIN_FAST_DISC_SPEED{{System::Main, "Core", "FastDiscSpeed"}, false};
 const Info<bool> MAIN_LOW_DCBZ_HACK{{System::Main, "Core", "LowDCBZHack"}, false};
 const Info<bool> MAIN_FLOAT_EXCEPTIONS{{System::Main, "Core", "FloatExceptions"}, false};
@@ -238,6 +255,21 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<State::CompressionMethod> MAIN_SAVESTATE_COMPRESSION{
+    {System::Main, "Core", "SaveStateCompression"}, State::CompressionMethod::Zstd};
+// Negative levels trade some size for speed, which matters more on slow phone cores.
+#ifdef ANDROID
+const Info<int> MAIN_SAVESTATE_COMPRESSION_LEVEL{
+    {System::Main, "Core", "SaveStateCompressionLevel"}, -3};
+#else
+const Info<int> MAIN_SAVESTATE_COMPRESSION_LEVEL{
+    {System::Main, "Core", "SaveStateCompressionLevel"}, 1};
+#endif
+const Info<bool> MAIN_REWIND_ENABLE{{System::Main, "Core", "RewindEnable"}, false};
+// In video fields, so two per frame for interlaced games.
+const Info<int> MAIN_REWIND_INTERVAL{{System::Main, "Core", "RewindInterval"}, 30};
+// In MiB.
+const Info<int> MAIN_REWIND_MEMORY_BUDGET{{System::Main, "Core", "RewindMemoryBudget"}, 256};
 const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS{
     {System::Main, "Core", "RealWiiRemoteRepeatReports"}, true};
 
@@ -264,6 +296,7 @@ const Info<bool> MAIN_DISABLE_SCREENSAVER{{System::Main, "Display", "DisableScre
 const Info<bool> MAIN_DSP_THREAD{{System::Main, "DSP", "DSPThread"}, false};
 const Info<bool> MAIN_DSP_CAPTURE_LOG{{System::Main, "DSP", "CaptureLog"}, false};
 const Info<bool> MAIN_DSP_JIT{{System::Main, "DSP", "EnableJIT"}, true};
+const Info<int> MAIN_DSP_HLE_VOICE_THREADS{{System::Main, "DSP", "HLEVoiceThreads"}, 0};
 const Info<bool> MAIN_DUMP_AUDIO{{System::Main, "DSP", "DumpAudio"}, false};
 const Info<bool> MAIN_DUMP_AUDIO_SILENT{{System::Main, "DSP", "DumpAudioSilent"}, false};
 const Info<bool> MAIN_DUMP_UCODE{{System::Main, "DSP", "DumpUCode"}, false};
@@ -271,6 +304,8 @@ const Info<std::string> MAIN_AUDIO_BACKEND{{System::Main, "DSP", "Backend"},
                                            AudioCommon::GetDefaultSoundBackend()};
 const Info<int> MAIN_AUDIO_VOLUME{{System::Main, "DSP", "Volume"}, 100};
 const Info<bool> MAIN_AUDIO_MUTED{{System::Main, "DSP", "Muted"}, false};
+const Info<bool> MAIN_AUDIO_HIGH_QUALITY_RESAMPLING{{System::Main, "DSP", "HighQualityResampling"},
+                                                   false};
 #ifdef _WIN32
 const Info<std::string> MAIN_WASAPI_DEVICE{{System::Main, "DSP", "WASAPIDevice"}, "Default"};
 #endif
@@ -454,6 +489,8 @@ const Info<bool> MAIN_GAMELIST_COLUMN_TAGS{{System::Main, "GameList", "ColumnTag
 const Info<bool> MAIN_FIFOPLAYER_LOOP_REPLAY{{System::Main, "FifoPlayer", "LoopReplay"}, true};
 const Info<bool> MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES{
     {System::Main, "FifoPlayer", "EarlyMemoryUpdates"}, false};
+const Info<bool> MAIN_FIFOPLAYER_COMPRESS_RECORDINGS{
+    {System::Main, "FifoPlayer", "CompressRecordings"}, true};
 
 // Main.AutoUpdate
 
@@ -471,10 +508,12 @@ const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT{{System::Main, "Movie", "DumpFram
 const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY{{System::Main, "Movie", "ShowInputDisplay"}, false};
 const Info<bool> MAIN_MOVIE_SHOW_RTC{{System::Main, "Movie", "ShowRTC"}, false};
 const Info<bool> MAIN_MOVIE_SHOW_RERECORD{{System::Main, "Movie", "ShowRerecord"}, false};
+const Info<bool> MAIN_MOVIE_FAST_PLAYBACK{{System::Main, "Movie", "FastPlayback"}, false};
 
 // Main.Input
 
 const Info<bool> MAIN_INPUT_BACKGROUND_INPUT{{System::Main, "Input", "BackgroundInput"}, false};
+const Info<bool> MAIN_INPUT_LATE_LATCHING{{System::Main, "Input", "LateLatching"}, false};
 
 // Main.Debug
 
@@ -499,6 +538,7 @@ const Info<bool> MAIN_DEBUG_JIT_SYSTEM_REGISTERS_OFF{
 const Info<bool> MAIN_DEBUG_JIT_BRANCH_OFF{{System::Main, "Debug", "JitBranchOff"}, false};
 const Info<bool> MAIN_DEBUG_JIT_REGISTER_CACHE_OFF{{System::Main, "Debug", "JitRegisterCacheOff"},
                                                    false};
+const Info<bool> MAIN_DEBUG_BOOT_TRACE{{System::Main, "Debug", "BootTrace"}, false};
 
 // Main.BluetoothPassthrough
 
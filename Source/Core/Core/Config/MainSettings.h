@@ -19,6 +19,7 @@
 #define BACKEND_OPENAL "OpenAL"
 #define BACKEND_PULSEAUDIO "Pulse"
 #define BACKEND_OPENSLES "OpenSLES"
+#define BACKEND_AAUDIO "AAudio"
 #define BACKEND_WASAPI _trans("WASAPI (Exclusive Mode)")
 
 namespace PowerPC
@@ -47,6 +48,11 @@ namespace HSP
 enum class HSPDeviceType : int;
 }
 
+namespace State
+{
+enum class CompressionMethod : u16;
+}
+
 namespace Config
 {
 // Main.Core
@@ -54,11 +60,22 @@ namespace Config
 extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+extern const Info<bool> MAIN_JIT_BLOCK_DISK_CACHE;
+extern const Info<bool> MAIN_JIT_TIERED_COMPILATION;
+extern const Info<bool> MAIN_JIT_INTERPRET_COLD_BLOCKS;
+extern const Info<bool> MAIN_JIT_TRACE_FORMATION;
+extern const Info<bool> MAIN_JIT_INDIRECT_BRANCH_CACHE;
+extern const Info<bool> MAIN_JIT_LOOP_REGISTER_ENTRY;
+extern const Info<bool> MAIN_JIT_CACHE_EVICTION;
 extern const Info<bool> MAIN_FASTMEM;
+extern const Info<bool> MAIN_HUGE_PAGES;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
 extern const Info<int> MAIN_TIMING_VARIANCE;
 extern const Info<bool> MAIN_CPU_THREAD;
+extern const Info<bool> MAIN_PIN_THREADS_TO_CORE_TYPES;
+// Trades some performance for a smaller memory footprint, for devices with little RAM.
+extern const Info<bool> MAIN_LOW_MEMORY_MODE;
 extern const Info<bool> MAIN_SYNC_ON_SKIP_IDLE;
 extern const Info<std::string> MAIN_DEFAULT_ISO;
 extern const Info<bool> MAIN_ENABLE_CHEATS;
@@ -109,6 +126,7 @@ extern const Info<bool> MAIN_SYNC_GPU;
 extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
+extern const Info<bool> MAIN_SYNC_GPU_ADAPTIVE;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
@@ -145,6 +163,11 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+extern const Info<State::CompressionMethod> MAIN_SAVESTATE_COMPRESSION;
+extern const Info<int> MAIN_SAVESTATE_COMPRESSION_LEVEL;
+extern const Info<bool> MAIN_REWIND_ENABLE;
+extern const Info<int> MAIN_REWIND_INTERVAL;
+extern const Info<int> MAIN_REWIND_MEMORY_BUDGET;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
@@ -155,12 +178,16 @@ extern const Info<std::string> MAIN_WII_NUS_SHOP_URL;
 extern const Info<bool> MAIN_DSP_THREAD;
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
+// Number of extra threads the AX HLE ucodes process voices on. 0 processes them in order on the
+// emulation thread.
+extern const Info<int> MAIN_DSP_HLE_VOICE_THREADS;
 extern const Info<bool> MAIN_DUMP_AUDIO;
 extern const Info<bool> MAIN_DUMP_AUDIO_SILENT;
 extern const Info<bool> MAIN_DUMP_UCODE;
 extern const Info<std::string> MAIN_AUDIO_BACKEND;
 extern const Info<int> MAIN_AUDIO_VOLUME;
 extern const Info<bool> MAIN_AUDIO_MUTED;
+extern const Info<bool> MAIN_AUDIO_HIGH_QUALITY_RESAMPLING;
 #ifdef _WIN32
 extern const Info<std::string> MAIN_WASAPI_DEVICE;
 #endif
@@ -294,6 +321,7 @@ extern const Info<bool> MAIN_GAMELIST_COLUMN_TAGS;
 
 extern const Info<bool> MAIN_FIFOPLAYER_LOOP_REPLAY;
 extern const Info<bool> MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES;
+extern const Info<bool> MAIN_FIFOPLAYER_COMPRESS_RECORDINGS;
 
 // Main.AutoUpdate
 
@@ -309,10 +337,14 @@ extern const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT;
 extern const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY;
 extern const Info<bool> MAIN_MOVIE_SHOW_RTC;
 extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
+// Plays movies back as fast as possible, only presenting a few frames per second.
+extern const Info<bool> MAIN_MOVIE_FAST_PLAYBACK;
 
 // Main.Input
 
 extern const Info<bool> MAIN_INPUT_BACKGROUND_INPUT;
+// Samples GameCube controllers when the game reads them rather than when they are polled.
+extern const Info<bool> MAIN_INPUT_LATE_LATCHING;
 
 // Main.Debug
 
@@ -329,6 +361,8 @@ extern const Info<bool> MAIN_DEBUG_JIT_PAIRED_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_SYSTEM_REGISTERS_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_BRANCH_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_REGISTER_CACHE_OFF;
+// Records a timeline of the boot up to the first frame into Logs/BootTrace.json.
+extern const Info<bool> MAIN_DEBUG_BOOT_TRACE;
 
 // Main.BluetoothPassthrough
 
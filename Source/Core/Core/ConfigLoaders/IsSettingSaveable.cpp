@@ -71,6 +71,11 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_MEM2_SIZE.GetLocation(),
       &Config::MAIN_GFX_BACKEND.GetLocation(),
       &Config::MAIN_ENABLE_SAVESTATES.GetLocation(),
+      &Config::MAIN_SAVESTATE_COMPRESSION.GetLocation(),
+      &Config::MAIN_SAVESTATE_COMPRESSION_LEVEL.GetLocation(),
+      &Config::MAIN_REWIND_ENABLE.GetLocation(),
+      &Config::MAIN_REWIND_INTERVAL.GetLocation(),
+      &Config::MAIN_REWIND_MEMORY_BUDGET.GetLocation(),
       &Config::MAIN_FALLBACK_REGION.GetLocation(),
       &Config::MAIN_REAL_WII_REMOTE_REPEAT_REPORTS.GetLocation(),
       &Config::MAIN_DSP_HLE.GetLocation(),
@@ -88,6 +93,13 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_CUSTOM_RTC_ENABLE.GetLocation(),
       &Config::MAIN_CUSTOM_RTC_VALUE.GetLocation(),
       &Config::MAIN_JIT_FOLLOW_BRANCH.GetLocation(),
+      &Config::MAIN_JIT_BLOCK_DISK_CACHE.GetLocation(),
+      &Config::MAIN_JIT_TIERED_COMPILATION.GetLocation(),
+      &Config::MAIN_JIT_INTERPRET_COLD_BLOCKS.GetLocation(),
+      &Config::MAIN_JIT_TRACE_FORMATION.GetLocation(),
+      &Config::MAIN_JIT_INDIRECT_BRANCH_CACHE.GetLocation(),
+      &Config::MAIN_JIT_LOOP_REGISTER_ENTRY.GetLocation(),
+      &Config::MAIN_JIT_CACHE_EVICTION.GetLocation(),
       &Config::MAIN_FLOAT_EXCEPTIONS.GetLocation(),
       &Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS.GetLocation(),
       &Config::MAIN_LOW_DCBZ_HACK.GetLocation(),
@@ -108,6 +120,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_FAST_DISC_SPEED.GetLocation(),
       &Config::MAIN_SYNC_ON_SKIP_IDLE.GetLocation(),
       &Config::MAIN_FASTMEM.GetLocation(),
+      &Config::MAIN_HUGE_PAGES.GetLocation(),
       &Config::MAIN_TIMING_VARIANCE.GetLocation(),
       &Config::MAIN_WII_SD_CARD.GetLocation(),
       &Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC.GetLocation(),
@@ -130,6 +143,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_SYNC_GPU_MAX_DISTANCE.GetLocation(),
       &Config::MAIN_SYNC_GPU_MIN_DISTANCE.GetLocation(),
       &Config::MAIN_SYNC_GPU_OVERCLOCK.GetLocation(),
+      &Config::MAIN_SYNC_GPU_ADAPTIVE.GetLocation(),
       &Config::MAIN_OVERRIDE_BOOT_IOS.GetLocation(),
       &Config::MAIN_GCI_FOLDER_A_PATH.GetLocation(),
       &Config::MAIN_GCI_FOLDER_B_PATH.GetLocation(),
@@ -67,9 +67,13 @@ public:
     layer->Set(Config::GFX_HACK_DISABLE_COPY_TO_VRAM, m_settings.disable_copy_to_vram);
     layer->Set(Config::GFX_HACK_IMMEDIATE_XFB, m_settings.immediate_xfb_enable);
     layer->Set(Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES, m_settings.efb_emulate_format_changes);
+    // Depth values read back from the EFB would depend on the host GPU.
+    layer->Set(Config::GFX_HACK_REDUCED_PRECISION_EFB_DEPTH, false);
     layer->Set(Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES,
                m_settings.safe_texture_cache_color_samples);
     layer->Set(Config::GFX_PERF_QUERIES_ENABLE, m_settings.perf_queries_enable);
+    // Asynchronous results depend on host GPU timing, so they can't be kept in sync.
+    layer->Set(Config::GFX_PERF_QUERIES_ASYNC, false);
     layer->Set(Config::MAIN_FLOAT_EXCEPTIONS, m_settings.float_exceptions);
     layer->Set(Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS, m_settings.divide_by_zero_exceptions);
     layer->Set(Config::MAIN_FPRF, m_settings.fprf);
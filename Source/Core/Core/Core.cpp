@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cstring>
+#include <future>
 #include <mutex>
 #include <queue>
 #include <utility>
@@ -37,10 +38,12 @@
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 #include "Common/Version.h"
 
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/CPUBenchmark.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
@@ -56,6 +59,7 @@
 #include "Core/HW/GCKeyboard.h"
 #include "Core/HW/GCPad.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
@@ -69,6 +73,7 @@
 #include "Core/PowerPC/GDBStub.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/State.h"
 #include "Core/System.h"
 #include "Core/WiiRoot.h"
@@ -91,7 +96,10 @@
 #include "VideoCommon/VideoBackendBase.h"
 
 #ifdef ANDROID
+#include <unistd.h>
+
 #include "jni/AndroidCommon/IDCache.h"
+#include "jni/AndroidCommon/PerformanceHint.h"
 #endif
 
 namespace Core
@@ -131,6 +139,13 @@ static std::mutex s_host_jobs_lock;
 static std::queue<HostJob> s_host_jobs_queue;
 static Common::Event s_cpu_thread_job_finished;
 
+#ifdef ANDROID
+// Only used on the CPU thread.
+static std::unique_ptr<PerformanceHintSession> s_cpu_performance_hint;
+static u64 s_cpu_performance_hint_last_field_us;
+static u64 s_cpu_performance_hint_last_sleep_us;
+#endif
+
 static thread_local bool tls_is_cpu_thread = false;
 static thread_local bool tls_is_gpu_thread = false;
 
@@ -155,6 +170,8 @@ void FrameUpdateOnCPUThread()
 {
   if (NetPlay::IsNetPlayRunning())
     NetPlay::NetPlayClient::SendTimeBase();
+
+  SamplingProfiler::ResolvePendingSamples();
 }
 
 void OnFrameEnd()
@@ -323,6 +340,58 @@ void UndeclareAsGPUThread()
   tls_is_gpu_thread = false;
 }
 
+void PinCurrentThread(HostCoreType type)
+{
+  if (!Config::Get(Config::MAIN_PIN_THREADS_TO_CORE_TYPES))
+    return;
+
+  const u32 mask = type == HostCoreType::Performance ? Common::GetPerformanceCoreMask() :
+                                                       Common::GetEfficiencyCoreMask();
+  if (mask != 0)
+    Common::SetCurrentThreadAffinity(mask);
+}
+
+#ifdef ANDROID
+// The emulated time of one field at the configured emulation speed, or 0 if it's unlimited.
+static s64 GetTargetFieldDurationNs()
+{
+  const float emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
+  if (emulation_speed <= 0.0f)
+    return 0;
+
+  return static_cast<s64>(VideoInterface::GetTicksPerField() * 1000000000.0 /
+                          SystemTimers::GetTicksPerSecond() / emulation_speed);
+}
+
+static void StartCPUPerformanceHint()
+{
+  // The frame rate isn't known until the game has set up the VI, so start with 60 fields/s.
+  s_cpu_performance_hint = PerformanceHintSession::Create({gettid()}, 1000000000 / 60);
+  s_cpu_performance_hint_last_field_us = Common::Timer::NowUs();
+  s_cpu_performance_hint_last_sleep_us = SystemTimers::GetTimeSpentSleepingUs();
+}
+
+// Reports the time the CPU thread was busy during the last field, i.e. not waiting for the
+// emulation speed limit, so that the system only clocks up when it is needed to keep up.
+static void ReportCPUPerformanceHint()
+{
+  if (!s_cpu_performance_hint)
+    return;
+
+  const u64 now_us = Common::Timer::NowUs();
+  const u64 sleep_us = SystemTimers::GetTimeSpentSleepingUs();
+  const u64 elapsed_us = now_us - std::exchange(s_cpu_performance_hint_last_field_us, now_us);
+  const u64 slept_us = sleep_us - std::exchange(s_cpu_performance_hint_last_sleep_us, sleep_us);
+
+  s_cpu_performance_hint->UpdateTargetWorkDuration(GetTargetFieldDurationNs());
+  if (elapsed_us > slept_us)
+  {
+    s_cpu_performance_hint->ReportActualWorkDuration(
+        static_cast<s64>(elapsed_us - slept_us) * 1000);
+  }
+}
+#endif
+
 // For the CPU Thread only.
 static void CPUSetInitialExecutionState(bool force_paused = false)
 {
@@ -350,10 +419,14 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   // This needs to be delayed until after the video backend is ready.
   DolphinAnalytics::Instance().ReportGameStart();
 
+  PinCurrentThread(HostCoreType::Performance);
+
 #ifdef ANDROID
   // For some reason, calling the JNI function AttachCurrentThread from the CPU thread after a
   // certain point causes a crash if fastmem is enabled. Let's call it early to avoid that problem.
   static_cast<void>(IDCache::GetEnvForThread());
+
+  StartCPUPerformanceHint();
 #endif
 
   const bool fastmem_enabled = Config::Get(Config::MAIN_FASTMEM);
@@ -399,6 +472,12 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   // Enter CPU run loop. When we leave it - we are done.
   CPU::Run();
 
+  SamplingProfiler::Stop();
+
+#ifdef ANDROID
+  s_cpu_performance_hint.reset();
+#endif
+
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher.reset();
 #endif
@@ -451,6 +530,11 @@ static void FifoPlayerThread(const std::optional<std::string>& savestate_path,
 // Initialize and create emulation thread
 // Call browser: Init():s_emu_thread().
 // See the BootManager.cpp file description for a complete call schedule.
+static void ExportBootTrace()
+{
+  Common::Trace::StopRecordingAndExport(File::GetUserPath(D_LOGS_IDX) + "BootTrace.json");
+}
+
 static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi)
 {
   Core::System& system = Core::System::GetInstance();
@@ -462,6 +546,10 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     s_is_stopping = false;
     s_wants_determinism = false;
 
+    // Emulation was stopped before the first frame.
+    if (Common::Trace::IsRecording())
+      ExportBootTrace();
+
     CallOnStateChangedCallbacks(State::Uninitialized);
 
     INFO_LOG_FMT(CONSOLE, "Stop\t\t---- Shutdown complete ----");
@@ -489,12 +577,23 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   const bool delete_savestate =
       boot_session_data.GetDeleteSavestate() == DeleteSavestateAfterBoot::Yes;
 
-  bool sync_sd_folder = core_parameter.bWii && Config::Get(Config::MAIN_WII_SD_CARD) &&
-                        Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC);
-  if (sync_sd_folder)
-    sync_sd_folder = Common::SyncSDFolderToSDImage(Core::WantsDeterminism());
+  // Syncing a large SD folder can take a while. The SD image is only opened once the game opens
+  // the SD slot or a savestate is loaded, so the sync runs alongside the rest of the hardware and
+  // video backend initialization and is only waited for right before booting.
+  std::future<bool> sd_folder_sync;
+  if (core_parameter.bWii && Config::Get(Config::MAIN_WII_SD_CARD) &&
+      Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC))
+  {
+    sd_folder_sync = std::async(std::launch::async, [deterministic = Core::WantsDeterminism()] {
+      Common::SetCurrentThreadName("SD folder sync");
+      return Common::SyncSDFolderToSDImage(deterministic);
+    });
+  }
 
-  Common::ScopeGuard sd_folder_sync_guard{[sync_sd_folder] {
+  bool sync_sd_folder = false;
+  Common::ScopeGuard sd_folder_sync_guard{[&sd_folder_sync, &sync_sd_folder] {
+    if (sd_folder_sync.valid())
+      sync_sd_folder = sd_folder_sync.get();
     if (sync_sd_folder && Config::Get(Config::MAIN_ALLOW_SD_WRITES))
       Common::SyncSDImageToSDFolder();
   }};
@@ -513,7 +612,16 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   AudioCommon::InitSoundStream(system);
   Common::ScopeGuard audio_guard([&system] { AudioCommon::ShutdownSoundStream(system); });
 
+  u64 phase_start = Common::Timer::NowUs();
+  const auto log_boot_phase = [&phase_start](const char* phase) {
+    const u64 now = Common::Timer::NowUs();
+    INFO_LOG_FMT(BOOT, "{} took {} ms", phase, (now - phase_start) / 1000);
+    Common::Trace::AddEvent(phase, phase_start, now);
+    phase_start = now;
+  };
+
   HW::Init(NetPlay::IsNetPlayRunning() ? &(boot_session_data.GetNetplaySettings()->sram) : nullptr);
+  log_boot_phase("Hardware initialization");
 
   Common::ScopeGuard hw_guard{[] {
     // We must set up this flag before executing HW::Shutdown()
@@ -542,6 +650,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     return;
   }
   Common::ScopeGuard video_guard{[] { g_video_backend->Shutdown(); }};
+  log_boot_phase("Video backend initialization");
 
   // Render a single frame without anything on it to clear the screen.
   // This avoids the game list being displayed while the core is finishing initializing.
@@ -558,6 +667,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     PanicAlertFmt("Failed to initialize DSP emulation!");
     return;
   }
+  log_boot_phase("DSP initialization");
 
   // Inputs loading may have generated custom dynamic textures
   // it's now ok to initialize any custom textures
@@ -586,8 +696,15 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   if (SConfig::GetInstance().bWii)
     savegame_redirect = DiscIO::Riivolution::ExtractSavegameRedirect(boot->riivolution_patches);
 
+  if (sd_folder_sync.valid())
+  {
+    sync_sd_folder = sd_folder_sync.get();
+    log_boot_phase("Waiting for the SD folder sync");
+  }
+
   if (!CBoot::BootUp(std::move(boot)))
     return;
+  log_boot_phase("Boot");
 
   // Initialise Wii filesystem contents.
   // This is done here after Boot and not in BootManager to ensure that we operate
@@ -597,9 +714,14 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     boot_session_data.InvokeWiiSyncCleanup();
   }};
   if (SConfig::GetInstance().bWii)
+  {
     Core::InitializeWiiFileSystemContents(savegame_redirect, boot_session_data);
+    log_boot_phase("Wii filesystem contents");
+  }
   else
+  {
     wiifs_guard.Dismiss();
+  }
 
   // This adds the SyncGPU handler to CoreTiming, so now CoreTiming::Advance might block.
   Fifo::Prepare();
@@ -621,6 +743,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     // thread, and then takes over and becomes the video thread
     Common::SetCurrentThreadName("Video thread");
     UndeclareAsCPUThread();
+    PinCurrentThread(HostCoreType::Performance);
     FPURoundMode::LoadDefaultSIMDState();
 
     // Spawn the CPU thread. The CPU thread will signal the event that boot is complete.
@@ -868,6 +991,12 @@ void Callback_FramePresented(double actual_emulation_speed)
 {
   s_last_actual_emulation_speed = actual_emulation_speed;
 
+  if (Common::Trace::IsRecording()) [[unlikely]]
+  {
+    Common::Trace::AddInstantEvent("First frame");
+    ExportBootTrace();
+  }
+
   s_drawn_frame++;
   s_stop_frame_step.store(true);
 }
@@ -875,6 +1004,12 @@ void Callback_FramePresented(double actual_emulation_speed)
 // Called from VideoInterface::Update (CPU thread) at emulated field boundaries
 void Callback_NewField()
 {
+  ::State::OnNewField();
+  CPUBenchmark::OnNewField();
+#ifdef ANDROID
+  ReportCPUPerformanceHint();
+#endif
+
   if (s_frame_step)
   {
     // To ensure that s_stop_frame_step is up to date, wait for the GPU thread queue to empty,
@@ -912,11 +1047,18 @@ void UpdateTitle(u64 elapsed_ms)
     perf_stats.VPS = (float)(s_drawn_video.load() * 1000.0 / elapsed_ms);
     perf_stats.Speed = (float)(s_drawn_video.load() * (100 * 1000.0) /
                                       (VideoInterface::GetTargetRefreshRate() * elapsed_ms));
+    DSPEmulator* dsp_emulator = DSP::GetDSPEmulator();
+    perf_stats.DSPThreadLatency = dsp_emulator ? dsp_emulator->TakeThreadLatency() : 0.0f;
+    perf_stats.DMABytesPerFrame =
+        (float)Memory::TakeDMAByteCount() / std::max<u32>(s_drawn_video.load(), 1);
+    auto& system = Core::System::GetInstance();
+    SoundStream* sound_stream = system.GetSoundStream();
+    perf_stats.AudioLatency = sound_stream ? sound_stream->GetOutputLatency() : 0.0f;
 
   // Settings are shown the same for both extended and summary info
   const std::string SSettings = fmt::format(
       "{} {} | {} | {}", PowerPC::GetCPUName(),
-      Core::System::GetInstance().IsDualCoreMode() ? "DC" : "SC", g_video_backend->GetDisplayName(),
+      system.IsDualCoreMode() ? "DC" : "SC", g_video_backend->GetDisplayName(),
       Config::Get(Config::MAIN_DSP_HLE) ? "HLE" : "LLE");
 
   std::string SFPS;
@@ -956,6 +1098,11 @@ void UpdateTitle(u64 elapsed_ms)
       SFPS += fmt::format(" | CPU: ~{} MHz [Real: {} + IdleSkip: {}] / {} MHz (~{:3.0f}%)", diff,
                           diff - idleDiff, idleDiff, SystemTimers::GetTicksPerSecond() / 1000000,
                           TicksPercentage);
+      if (perf_stats.DSPThreadLatency != 0.0f)
+        SFPS += fmt::format(" | DSP thread wait: {:.1f} us", perf_stats.DSPThreadLatency);
+      SFPS += fmt::format(" | DMA: {:.1f} KiB/frame", perf_stats.DMABytesPerFrame / 1024);
+      if (perf_stats.AudioLatency != 0.0f)
+        SFPS += fmt::format(" | Audio latency: {:.1f} ms", perf_stats.AudioLatency);
     }
   }
 
@@ -968,8 +1115,6 @@ void UpdateTitle(u64 elapsed_ms)
   }
 
   // Update the audio timestretcher with the current speed
-  auto& system = Core::System::GetInstance();
-  SoundStream* sound_stream = system.GetSoundStream();
   if (sound_stream)
   {
     Mixer* mixer = sound_stream->GetMixer();
@@ -101,6 +101,16 @@ void UndeclareAsCPUThread();
 void DeclareAsGPUThread();
 void UndeclareAsGPUThread();
 
+enum class HostCoreType
+{
+  Performance,
+  Efficiency,
+};
+
+// Restricts the calling thread to the given type of host cores, if the host CPU mixes fast and
+// slow cores and the threads aren't configured to run anywhere.
+void PinCurrentThread(HostCoreType type);
+
 std::string StopMessage(bool main_thread, std::string_view message);
 
 bool IsRunning();
@@ -120,6 +130,12 @@ struct PerformanceStatistics
     float FPS;
     float VPS;
     float Speed;
+    // Average time in microseconds the CPU thread waits for the DSP LLE thread per update.
+    float DSPThreadLatency;
+    // Average number of bytes moved by the DMA engines per emulated video frame.
+    float DMABytesPerFrame;
+    // Milliseconds until audio mixed now is heard, if the sound backend can tell.
+    float AudioLatency;
 };
 
 const PerformanceStatistics& GetPerformanceStatistics();
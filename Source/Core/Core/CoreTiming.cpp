@@ -4,8 +4,10 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -14,7 +16,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
@@ -22,6 +24,7 @@
 #include "Core/System.h"
 
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameTimeline.h"
 #include "VideoCommon/VideoBackendBase.h"
 
 namespace CoreTiming
@@ -30,6 +33,9 @@ struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+  // Number of events of this type in the event queue, which lets RemoveEvent() skip searching the
+  // queue for the (common) case where there aren't any.
+  u32 queued_count = 0;
 };
 
 struct Event
@@ -41,10 +47,6 @@ struct Event
 };
 
 // Sort by time, unless the times are the same, in which case sort by the order added to the queue
-static bool operator>(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-}
 static bool operator<(const Event& left, const Event& right)
 {
   return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
@@ -52,6 +54,83 @@ static bool operator<(const Event& left, const Event& right)
 
 static constexpr int MAX_SLICE_LENGTH = 20000;
 
+// The event queue is a 4-ary min-heap. It is shallower than a binary heap, and the children of a
+// node are next to each other in memory, so both insertions and removals touch fewer cache lines.
+static constexpr size_t HEAP_ARITY = 4;
+
+static void SiftUp(std::vector<Event>& heap, size_t index)
+{
+  Event ev = heap[index];
+  while (index > 0)
+  {
+    const size_t parent = (index - 1) / HEAP_ARITY;
+    if (!(ev < heap[parent]))
+      break;
+    heap[index] = heap[parent];
+    index = parent;
+  }
+  heap[index] = ev;
+}
+
+static void SiftDown(std::vector<Event>& heap, size_t index)
+{
+  const size_t size = heap.size();
+  Event ev = heap[index];
+  while (true)
+  {
+    const size_t first_child = index * HEAP_ARITY + 1;
+    if (first_child >= size)
+      break;
+
+    const size_t end_child = std::min(first_child + HEAP_ARITY, size);
+    size_t smallest = first_child;
+    for (size_t child = first_child + 1; child < end_child; ++child)
+    {
+      if (heap[child] < heap[smallest])
+        smallest = child;
+    }
+
+    if (!(heap[smallest] < ev))
+      break;
+    heap[index] = heap[smallest];
+    index = smallest;
+  }
+  heap[index] = ev;
+}
+
+static void MakeHeap(std::vector<Event>& heap)
+{
+  if (heap.size() < 2)
+    return;
+
+  // Starting from the parent of the last event.
+  for (size_t i = (heap.size() - 2) / HEAP_ARITY + 1; i-- > 0;)
+    SiftDown(heap, i);
+}
+
+static void PushEvent(std::vector<Event>& heap, const Event& ev)
+{
+  ++ev.type->queued_count;
+  heap.push_back(ev);
+  SiftUp(heap, heap.size() - 1);
+}
+
+static void RemoveEventAt(std::vector<Event>& heap, size_t index)
+{
+  --heap[index].type->queued_count;
+  const Event last = heap.back();
+  heap.pop_back();
+  if (index == heap.size())
+    return;
+
+  // The last event can belong either above or below the hole it fills.
+  heap[index] = last;
+  if (index > 0 && last < heap[(index - 1) / HEAP_ARITY])
+    SiftUp(heap, index);
+  else
+    SiftDown(heap, index);
+}
+
 struct CoreTimingState::Data
 {
   // unordered_map stores each element separately as a linked list node so pointers to elements
@@ -59,14 +138,24 @@ struct CoreTimingState::Data
   std::unordered_map<std::string, EventType> event_types;
 
   // STATE_TO_SAVE
-  // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
+  // The queue is a min-heap maintained by the PushEvent/RemoveEventAt helpers above.
   // We don't use std::priority_queue because we need to be able to serialize, unserialize and
   // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
   // by the standard adaptor class.
   std::vector<Event> event_queue;
   u64 event_fifo_id;
-  std::mutex ts_write_lock;
-  Common::SPSCQueue<Event, false> ts_queue;
+
+  // Events scheduled from other threads, which MoveEvents() moves into event_queue. If the queue
+  // fills up, producers fall back to the overflow vector until it has been drained.
+  Common::MPSCQueue<Event, 1024> ts_queue;
+  std::mutex ts_overflow_lock;
+  std::vector<Event> ts_overflow;
+  std::atomic<bool> ts_overflow_pending = false;
+
+  // Contention statistics for the cross-thread queue.
+  std::atomic<u64> ts_event_count = 0;
+  std::atomic<u64> ts_push_retries = 0;
+  std::atomic<u64> ts_overflow_count = 0;
 
   float last_oc_factor;
 
@@ -167,8 +256,10 @@ void Init()
 void Shutdown()
 {
   auto& state = Core::System::GetInstance().GetCoreTimingState().GetData();
-  std::lock_guard lk(state.ts_write_lock);
   MoveEvents();
+  INFO_LOG_FMT(POWERPC, "Cross-thread events: {} (push retries: {}, overflowed: {})",
+               state.ts_event_count.load(), state.ts_push_retries.load(),
+               state.ts_overflow_count.load());
   ClearPendingEvents();
   UnregisterAllEvents();
   Config::RemoveConfigChangedCallback(state.registered_config_callback_id);
@@ -189,7 +280,6 @@ void DoState(PointerWrap& p)
   auto& state = system.GetCoreTimingState().GetData();
   auto& g = system.GetCoreTimingGlobals();
 
-  std::lock_guard lk(state.ts_write_lock);
   p.Do(g.slice_length);
   p.Do(g.global_timer);
   p.Do(state.idled_cycles);
@@ -204,6 +294,8 @@ void DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
+  if (p.IsReadMode())
+    ClearPendingEvents();
   p.DoEachElement(state.event_queue, [&state](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
@@ -238,10 +330,14 @@ void DoState(PointerWrap& p)
   p.DoMarker("CoreTimingEvents");
 
   // When loading from a save state, we must assume the Event order is random and meaningless.
-  // The exact layout of the heap in memory is implementation defined, therefore it is platform
-  // and library version specific.
+  // Older save states were written with a heap layout that was implementation defined, and
+  // therefore platform and library version specific.
   if (p.IsReadMode())
-    std::make_heap(state.event_queue.begin(), state.event_queue.end(), std::greater<Event>());
+  {
+    for (const Event& ev : state.event_queue)
+      ++ev.type->queued_count;
+    MakeHeap(state.event_queue);
+  }
 }
 
 // This should only be called from the CPU thread. If you are calling
@@ -270,6 +366,8 @@ u64 GetIdleTicks()
 void ClearPendingEvents()
 {
   auto& state = Core::System::GetInstance().GetCoreTimingState().GetData();
+  for (const Event& ev : state.event_queue)
+    --ev.type->queued_count;
   state.event_queue.clear();
 }
 
@@ -302,8 +400,7 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
     if (!state.is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    state.event_queue.emplace_back(Event{timeout, state.event_fifo_id++, userdata, event_type});
-    std::push_heap(state.event_queue.begin(), state.event_queue.end(), std::greater<Event>());
+    PushEvent(state.event_queue, Event{timeout, state.event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -315,8 +412,22 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
                     *event_type->name);
     }
 
-    std::lock_guard lk(state.ts_write_lock);
-    state.ts_queue.Push(Event{g.global_timer + cycles_into_future, 0, userdata, event_type});
+    const Event ev{g.global_timer + cycles_into_future, 0, userdata, event_type};
+    state.ts_event_count.fetch_add(1, std::memory_order_relaxed);
+
+    // Events keep going to the overflow vector while it isn't empty, so that the events from a
+    // thread reach the CPU thread in the order they were scheduled in.
+    u32 retries = 0;
+    if (state.ts_overflow_pending.load(std::memory_order_acquire) ||
+        !state.ts_queue.TryPush(ev, &retries))
+    {
+      std::lock_guard lk(state.ts_overflow_lock);
+      state.ts_overflow.push_back(ev);
+      state.ts_overflow_pending.store(true, std::memory_order_release);
+      state.ts_overflow_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (retries != 0)
+      state.ts_push_retries.fetch_add(retries, std::memory_order_relaxed);
   }
 }
 
@@ -324,15 +435,24 @@ void RemoveEvent(EventType* event_type)
 {
   auto& state = Core::System::GetInstance().GetCoreTimingState().GetData();
 
+  if (event_type->queued_count == 0)
+    return;
+
+  if (event_type->queued_count == 1)
+  {
+    const auto itr = std::find_if(state.event_queue.begin(), state.event_queue.end(),
+                                  [&](const Event& e) { return e.type == event_type; });
+    RemoveEventAt(state.event_queue, itr - state.event_queue.begin());
+    return;
+  }
+
   auto itr = std::remove_if(state.event_queue.begin(), state.event_queue.end(),
                             [&](const Event& e) { return e.type == event_type; });
 
   // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != state.event_queue.end())
-  {
-    state.event_queue.erase(itr, state.event_queue.end());
-    std::make_heap(state.event_queue.begin(), state.event_queue.end(), std::greater<Event>());
-  }
+  state.event_queue.erase(itr, state.event_queue.end());
+  event_type->queued_count = 0;
+  MakeHeap(state.event_queue);
 }
 
 void RemoveAllEvents(EventType* event_type)
@@ -363,8 +483,19 @@ void MoveEvents()
   for (Event ev; state.ts_queue.Pop(ev);)
   {
     ev.fifo_order = state.event_fifo_id++;
-    state.event_queue.emplace_back(std::move(ev));
-    std::push_heap(state.event_queue.begin(), state.event_queue.end(), std::greater<Event>());
+    PushEvent(state.event_queue, ev);
+  }
+
+  if (state.ts_overflow_pending.load(std::memory_order_acquire))
+  {
+    std::lock_guard lk(state.ts_overflow_lock);
+    for (Event ev : state.ts_overflow)
+    {
+      ev.fifo_order = state.event_fifo_id++;
+      PushEvent(state.event_queue, ev);
+    }
+    state.ts_overflow.clear();
+    state.ts_overflow_pending.store(false, std::memory_order_release);
   }
 }
 
@@ -386,9 +517,8 @@ void Advance()
 
   while (!state.event_queue.empty() && state.event_queue.front().time <= g.global_timer)
   {
-    Event evt = std::move(state.event_queue.front());
-    std::pop_heap(state.event_queue.begin(), state.event_queue.end(), std::greater<Event>());
-    state.event_queue.pop_back();
+    const Event evt = state.event_queue.front();
+    RemoveEventAt(state.event_queue, 0);
     evt.type->callback(system, evt.userdata, g.global_timer - evt.time);
   }
 
@@ -437,6 +567,10 @@ void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock)
     const s64 ticks = (ev.time - g.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = g.global_timer + ticks;
   }
+
+  // Rounding can make events that were due at different times coincide, in which case they're
+  // ordered by fifo_order instead.
+  MakeHeap(state.event_queue);
 }
 
 void Idle()
@@ -445,6 +579,8 @@ void Idle()
   auto& state = system.GetCoreTimingState().GetData();
   auto& g = system.GetCoreTimingGlobals();
 
+  VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::IdleSkip);
+
   if (state.config_sync_on_skip_idle)
   {
     // When the FIFO is processing data we must not advance because in this way
@@ -471,6 +607,10 @@ std::string GetScheduledEventsSummary()
   {
     text += fmt::format("{} : {} {:016x}\n", *ev.type->name, ev.time, ev.userdata);
   }
+
+  text += fmt::format("\nCross-thread events: {} (push retries: {}, overflowed: {})\n",
+                      state.ts_event_count.load(), state.ts_push_retries.load(),
+                      state.ts_overflow_count.load());
   return text;
 }
 
@@ -11,6 +11,21 @@
 
 namespace DSP
 {
+static s16 DecodeADPCMSample(int nibble, u16 pred_scale, const s16* coefs, s16 yn1, s16 yn2)
+{
+  int scale = 1 << (pred_scale & 0xF);
+  int coef_idx = (pred_scale >> 4) & 0x7;
+
+  s32 coef1 = coefs[coef_idx * 2 + 0];
+  s32 coef2 = coefs[coef_idx * 2 + 1];
+
+  if (nibble >= 8)
+    nibble -= 16;
+
+  s32 val32 = (scale * nibble) + ((0x400 + coef1 * yn1 + coef2 * yn2) >> 11);
+  return static_cast<s16>(std::clamp<s32>(val32, -0x7FFF, 0x7FFF));
+}
+
 u16 Accelerator::ReadD3()
 {
   u16 val = 0;
@@ -76,20 +91,10 @@ u16 Accelerator::Read(const s16* coefs)
   {
   case 0x00:  // ADPCM audio
   {
-    int scale = 1 << (m_pred_scale & 0xF);
-    int coef_idx = (m_pred_scale >> 4) & 0x7;
-
-    s32 coef1 = coefs[coef_idx * 2 + 0];
-    s32 coef2 = coefs[coef_idx * 2 + 1];
-
     int temp = (m_current_address & 1) ? (ReadMemory(m_current_address >> 1) & 0xF) :
                                          (ReadMemory(m_current_address >> 1) >> 4);
 
-    if (temp >= 8)
-      temp -= 16;
-
-    s32 val32 = (scale * temp) + ((0x400 + coef1 * m_yn1 + coef2 * m_yn2) >> 11);
-    val = static_cast<s16>(std::clamp<s32>(val32, -0x7FFF, 0x7FFF));
+    val = static_cast<u16>(DecodeADPCMSample(temp, m_pred_scale, coefs, m_yn1, m_yn2));
     step_size_bytes = 2;
 
     m_yn2 = m_yn1;
@@ -160,6 +165,69 @@ u16 Accelerator::Read(const s16* coefs)
   return val;
 }
 
+size_t Accelerator::ReadADPCMFrame(const s16* coefs, s16* dst, size_t count)
+{
+  const u32 address = m_current_address;
+  const size_t frame_samples = std::min<size_t>(16 - (address & 15), count);
+  const bool reaches_header = ((address + frame_samples) & 15) == 0;
+
+  // Read checks for the end address after each sample, at the addresses after the sample and
+  // after the header of the next frame. Only take the fast path if the end address is well
+  // clear of all of them, and if the address doesn't carry out of the masked address bits.
+  const u32 last_address = address + static_cast<u32>(frame_samples) + 2;
+  if ((address & 0x3FFFFFF0) == 0x3FFFFFF0 ||
+      (m_end_address + 3 >= address + 1 && m_end_address <= last_address + 1))
+  {
+    return 0;
+  }
+
+  s16 yn1 = m_yn1;
+  s16 yn2 = m_yn2;
+  u8 byte = ReadMemory(address >> 1);
+  for (size_t i = 0; i < frame_samples; ++i)
+  {
+    const u32 nibble_address = address + static_cast<u32>(i);
+    if (i != 0 && (nibble_address & 1) == 0)
+      byte = ReadMemory(nibble_address >> 1);
+
+    const int nibble = (nibble_address & 1) ? (byte & 0xF) : (byte >> 4);
+    const s16 sample = DecodeADPCMSample(nibble, m_pred_scale, coefs, yn1, yn2);
+    yn2 = yn1;
+    yn1 = sample;
+    dst[i] = sample;
+  }
+  m_yn1 = yn1;
+  m_yn2 = yn2;
+
+  u32 new_address = address + static_cast<u32>(frame_samples);
+  if (reaches_header)
+  {
+    m_pred_scale = ReadMemory(new_address >> 1);
+    new_address += 2;
+  }
+  SetCurrentAddress(new_address);
+  return frame_samples;
+}
+
+void Accelerator::ReadSamples(const s16* coefs, s16* dst, size_t count)
+{
+  size_t i = 0;
+  while (i < count)
+  {
+    if (m_sample_format == 0x00 && !m_reads_stopped)
+    {
+      const size_t decoded = ReadADPCMFrame(coefs, dst + i, count - i);
+      if (decoded != 0)
+      {
+        i += decoded;
+        continue;
+      }
+    }
+
+    dst[i++] = static_cast<s16>(Read(coefs));
+  }
+}
+
 void Accelerator::DoState(PointerWrap& p)
 {
   p.Do(m_start_address);
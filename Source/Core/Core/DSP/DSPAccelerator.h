@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "Common/CommonTypes.h"
 
 class PointerWrap;
@@ -15,6 +17,9 @@ public:
   virtual ~Accelerator() = default;
 
   u16 Read(const s16* coefs);
+  // Reads count samples, the same way as calling Read count times. ADPCM frames are decoded a
+  // whole frame at a time where possible.
+  void ReadSamples(const s16* coefs, s16* dst, size_t count);
   // Zelda ucode reads ARAM through 0xffd3.
   u16 ReadD3();
   void WriteD3(u16 value);
@@ -41,6 +46,11 @@ protected:
   virtual u8 ReadMemory(u32 address) = 0;
   virtual void WriteMemory(u32 address, u8 value) = 0;
 
+  // Decodes the ADPCM samples up to the end of the current frame without the per sample end
+  // address checks, if none of them can reach the end address. Returns the number of samples
+  // decoded, which is 0 if they have to be read one at a time.
+  size_t ReadADPCMFrame(const s16* coefs, s16* dst, size_t count);
+
   // DSP accelerator registers.
   u32 m_start_address = 0;
   u32 m_end_address = 0;
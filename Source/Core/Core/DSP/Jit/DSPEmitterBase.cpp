@@ -5,6 +5,8 @@
 
 #if defined(_M_X86) || defined(_M_X86_64)
 #include "Core/DSP/Jit/x64/DSPEmitter.h"
+#elif defined(_M_ARM_64)
+#include "Core/DSP/Jit/arm64/DSPEmitter.h"
 #endif
 
 namespace DSP::JIT
@@ -15,6 +17,8 @@ std::unique_ptr<DSPEmitter> CreateDSPEmitter([[maybe_unused]] DSPCore& dsp)
 {
 #if defined(_M_X86) || defined(_M_X86_64)
   return std::make_unique<x64::DSPEmitter>(dsp);
+#elif defined(_M_ARM_64)
+  return std::make_unique<arm64::DSPEmitter>(dsp);
 #else
   return std::make_unique<DSPEmitterNull>();
 #endif
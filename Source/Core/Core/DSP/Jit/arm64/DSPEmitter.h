@@ -0,0 +1,116 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "Common/Arm64Emitter.h"
+#include "Common/CommonTypes.h"
+
+#include "Core/DSP/DSPCommon.h"
+#include "Core/DSP/Jit/DSPEmitterBase.h"
+#include "Core/DSP/Jit/arm64/DSPJitRegCache.h"
+
+class PointerWrap;
+
+namespace DSP::JIT::arm64
+{
+// Compiles blocks the same way as the x64 DSP recompiler. Instructions without a native
+// implementation are run through the interpreter, which still avoids the interpreter's per
+// instruction fetch, decode, exception and loop checks.
+class DSPEmitter final : public JIT::DSPEmitter, public Arm64Gen::ARM64CodeBlock
+{
+public:
+  // Holds the address of SDSP while running compiled code.
+  static constexpr Arm64Gen::ARM64Reg STATE_REG = Arm64Gen::ARM64Reg::X28;
+
+  explicit DSPEmitter(DSPCore& dsp);
+  ~DSPEmitter() override;
+
+  u16 RunCycles(u16 cycles) override;
+  void DoState(PointerWrap& p) override;
+  void ClearIRAM() override;
+
+  // Ext commands
+  void dr(UDSPInstruction opc);
+  void ir(UDSPInstruction opc);
+  void nr(UDSPInstruction opc);
+  void nop(const UDSPInstruction opc) {}
+  // Commands
+  void dar(UDSPInstruction opc);
+  void iar(UDSPInstruction opc);
+  void subarn(UDSPInstruction opc);
+  void addarn(UDSPInstruction opc);
+  void sbclr(UDSPInstruction opc);
+  void sbset(UDSPInstruction opc);
+  void srbith(UDSPInstruction opc);
+  void lri(UDSPInstruction opc);
+  void mrr(UDSPInstruction opc);
+  void nx(UDSPInstruction opc);
+
+private:
+  using DSPCompiledCode = const u8*;
+
+  // The emitter emits calls to this function. It's present here
+  // within the class itself to allow access to member variables.
+  static void CompileCurrent(DSPEmitter& emitter);
+
+  void EmitInstruction(UDSPInstruction inst);
+  void ClearIRAMandDSPJITCodespaceReset();
+
+  void CompileDispatcher();
+  const u8* CompileStub();
+  void Compile(u16 start_addr);
+
+  void FallBackToInterpreter(UDSPInstruction inst);
+  void CallThunk(const void* func, const void* arg, std::optional<u32> arg2 = std::nullopt);
+
+  // Writes the cached registers back and returns to the dispatcher, having executed the cycles of
+  // the block so far.
+  void WriteBlockExit();
+
+  // Branch helpers
+  void HandleLoop();
+
+  // Register helpers
+  void setCompileSR(u16 bit);
+  void clrCompileSR(u16 bit);
+  void checkExceptions(u32 retval);
+
+  // Memory helper functions
+  void increment_addr_reg(int reg);
+  void decrement_addr_reg(int reg);
+  void increase_addr_reg(int reg, int ix_reg);
+  void decrease_addr_reg(int reg);
+
+  // SDSP memory offset helpers
+  static u32 SDSP_pc();
+  static u32 SDSP_exceptions();
+  static u32 SDSP_control_reg();
+  static u32 SDSP_external_interrupt_waiting();
+  static u32 SDSP_r_st(size_t index);
+  static u32 SDSP_r_sr();
+
+  static constexpr size_t MAX_BLOCKS = 0x10000;
+
+  DSPJitRegCache m_gpr{*this};
+
+  u16 m_compile_pc;
+  u16 m_start_address;
+
+  std::vector<DSPCompiledCode> m_blocks;
+  std::vector<u16> m_block_size;
+
+  u16 m_cycles_left = 0;
+
+  const u8* m_enter_dispatcher;
+  const u8* m_return_dispatcher;
+  const u8* m_stub_entry_point;
+
+  DSPCore& m_dsp_core;
+};
+
+}  // namespace DSP::JIT::arm64
@@ -0,0 +1,48 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/DSP/Jit/arm64/DSPEmitter.h"
+
+#include "Common/CommonTypes.h"
+
+#include "Core/DSP/DSPCore.h"
+
+using namespace Arm64Gen;
+
+namespace DSP::JIT::arm64
+{
+static void EndLoopThunk(SDSP& dsp)
+{
+  dsp.PopStack(StackRegister::Call);
+  dsp.PopStack(StackRegister::LoopAddress);
+  dsp.PopStack(StackRegister::LoopCounter);
+}
+
+void DSPEmitter::HandleLoop()
+{
+  LDRH(IndexType::Unsigned, ARM64Reg::W0, STATE_REG, SDSP_r_st(2));
+  LDRH(IndexType::Unsigned, ARM64Reg::W1, STATE_REG, SDSP_r_st(3));
+
+  FixupBranch loop_counter_zero = CBZ(ARM64Reg::W1);
+  MOVI2R(ARM64Reg::W2, static_cast<u16>(m_compile_pc - 1));
+  CMP(ARM64Reg::W0, ARM64Reg::W2);
+  FixupBranch not_loop_address = B(CC_NEQ);
+
+  SUBS(ARM64Reg::W1, ARM64Reg::W1, 1);
+  STRH(IndexType::Unsigned, ARM64Reg::W1, STATE_REG, SDSP_r_st(3));
+
+  FixupBranch load_stack = B(CC_EQ);
+  LDRH(IndexType::Unsigned, ARM64Reg::W0, STATE_REG, SDSP_r_st(0));
+  STRH(IndexType::Unsigned, ARM64Reg::W0, STATE_REG, SDSP_pc());
+  FixupBranch loop_updated = B();
+
+  SetJumpTarget(load_stack);
+  // The stack registers aren't cached, so nothing has to be written back for this.
+  CallThunk(reinterpret_cast<const void*>(&EndLoopThunk), &m_dsp_core.DSPState());
+
+  SetJumpTarget(loop_updated);
+  SetJumpTarget(not_loop_address);
+  SetJumpTarget(loop_counter_zero);
+}
+
+}  // namespace DSP::JIT::arm64
@@ -0,0 +1,39 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/DSP/Jit/arm64/DSPEmitter.h"
+
+#include "Common/CommonTypes.h"
+
+// Like the x64 recompiler, the extended opcodes write to the address registers directly, as they
+// are neither read nor written by any extendable opcode.
+
+namespace DSP::JIT::arm64
+{
+// DR $arR
+// xxxx xxxx 0000 01rr
+// Decrement addressing register $arR.
+void DSPEmitter::dr(const UDSPInstruction opc)
+{
+  decrement_addr_reg(opc & 0x3);
+}
+
+// IR $arR
+// xxxx xxxx 0000 10rr
+// Increment addressing register $arR.
+void DSPEmitter::ir(const UDSPInstruction opc)
+{
+  increment_addr_reg(opc & 0x3);
+}
+
+// NR $arR
+// xxxx xxxx 0000 11rr
+// Add corresponding indexing register $ixR to addressing register $arR.
+void DSPEmitter::nr(const UDSPInstruction opc)
+{
+  const u8 reg = opc & 0x3;
+
+  increase_addr_reg(reg, reg);
+}
+
+}  // namespace DSP::JIT::arm64
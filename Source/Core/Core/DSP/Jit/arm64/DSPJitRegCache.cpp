@@ -0,0 +1,141 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/DSP/Jit/arm64/DSPJitRegCache.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "Common/Assert.h"
+
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/Jit/arm64/DSPEmitter.h"
+
+using namespace Arm64Gen;
+
+namespace DSP::JIT::arm64
+{
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+static u32 GetRegisterOffset(size_t reg)
+{
+  // r.ar, r.ix and r.wr are laid out back to back, in the same order as the register numbers.
+  static_assert(offsetof(DSP_Regs, ix) == offsetof(DSP_Regs, ar) + sizeof(DSP_Regs::ar));
+  static_assert(offsetof(DSP_Regs, wr) == offsetof(DSP_Regs, ix) + sizeof(DSP_Regs::ix));
+  return static_cast<u32>(offsetof(SDSP, r.ar) + sizeof(SDSP::r.ar[0]) * (reg - DSP_REG_AR0));
+}
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+DSPJitRegCache::DSPJitRegCache(DSPEmitter& emitter) : m_emitter(emitter)
+{
+}
+
+bool DSPJitRegCache::IsCacheable(int reg)
+{
+  return reg >= DSP_REG_AR0 && reg <= DSP_REG_WR3;
+}
+
+ARM64Reg DSPJitRegCache::R(int reg)
+{
+  return Bind(reg, true);
+}
+
+ARM64Reg DSPJitRegCache::RW(int reg, bool load)
+{
+  const ARM64Reg host_reg = Bind(reg, load);
+  m_regs[reg].dirty = true;
+  return host_reg;
+}
+
+ARM64Reg DSPJitRegCache::Bind(int reg, bool load)
+{
+  ASSERT_MSG(DSPLLE, IsCacheable(reg), "Register {} can't be cached", reg);
+
+  CachedReg& cached = m_regs[reg];
+  cached.last_use = ++m_use_counter;
+  if (cached.host_reg != ARM64Reg::INVALID_REG)
+    return cached.host_reg;
+
+  cached.host_reg = AllocateHostReg();
+  if (load)
+  {
+    m_emitter.LDRH(IndexType::Unsigned, cached.host_reg, DSPEmitter::STATE_REG,
+                   GetRegisterOffset(reg));
+  }
+  return cached.host_reg;
+}
+
+ARM64Reg DSPJitRegCache::AllocateHostReg()
+{
+  for (ARM64Reg host_reg : s_allocation_order)
+  {
+    if (std::none_of(m_regs.begin(), m_regs.end(),
+                     [host_reg](const CachedReg& cached) { return cached.host_reg == host_reg; }))
+    {
+      return host_reg;
+    }
+  }
+
+  // Spill the least recently used register. No instruction uses more than three registers, so
+  // the ones bound earlier by the current instruction are never picked.
+  size_t lru = NUM_GUEST_REGS;
+  for (size_t i = 0; i < NUM_GUEST_REGS; ++i)
+  {
+    const CachedReg& cached = m_regs[i];
+    if (cached.host_reg == ARM64Reg::INVALID_REG)
+      continue;
+    if (lru == NUM_GUEST_REGS || cached.last_use < m_regs[lru].last_use)
+      lru = i;
+  }
+
+  ASSERT(lru != NUM_GUEST_REGS);
+  const ARM64Reg host_reg = m_regs[lru].host_reg;
+  Spill(lru);
+  return host_reg;
+}
+
+void DSPJitRegCache::Spill(size_t reg)
+{
+  CachedReg& cached = m_regs[reg];
+  if (cached.dirty)
+  {
+    m_emitter.STRH(IndexType::Unsigned, cached.host_reg, DSPEmitter::STATE_REG,
+                   GetRegisterOffset(reg));
+  }
+
+  cached = CachedReg{};
+}
+
+void DSPJitRegCache::StoreRegs()
+{
+  for (size_t i = 0; i < NUM_GUEST_REGS; ++i)
+  {
+    const CachedReg& cached = m_regs[i];
+    if (cached.dirty)
+    {
+      m_emitter.STRH(IndexType::Unsigned, cached.host_reg, DSPEmitter::STATE_REG,
+                     GetRegisterOffset(i));
+    }
+  }
+}
+
+void DSPJitRegCache::FlushRegs()
+{
+  for (size_t i = 0; i < NUM_GUEST_REGS; ++i)
+  {
+    if (m_regs[i].host_reg != ARM64Reg::INVALID_REG)
+      Spill(i);
+  }
+}
+
+void DSPJitRegCache::Reset()
+{
+  m_regs = {};
+  m_use_counter = 0;
+}
+
+}  // namespace DSP::JIT::arm64
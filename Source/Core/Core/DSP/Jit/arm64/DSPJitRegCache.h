@@ -0,0 +1,68 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "Common/Arm64Emitter.h"
+
+namespace DSP::JIT::arm64
+{
+class DSPEmitter;
+
+// Caches the address, index and wrapping registers ($arN, $ixN, $wrN) in callee saved host
+// registers for the duration of a block. The values are kept zero extended to 32 bits.
+//
+// The register state is the same on every path through the generated code: the only control flow
+// in a block is to exits, which write the dirty registers back with StoreRegs without changing
+// the cache.
+class DSPJitRegCache
+{
+public:
+  explicit DSPJitRegCache(DSPEmitter& emitter);
+
+  // Whether the guest register can be cached.
+  static bool IsCacheable(int reg);
+
+  // Returns a host register holding the value of the guest register.
+  Arm64Gen::ARM64Reg R(int reg);
+  // Returns a host register which the new value of the guest register has to be written to. If
+  // load is set, it holds the old value.
+  Arm64Gen::ARM64Reg RW(int reg, bool load = true);
+
+  // Writes the dirty registers back to memory without changing the state of the cache, for exits.
+  void StoreRegs();
+  // Writes the dirty registers back to memory and forgets all cached values, before calls to code
+  // which accesses the registers in memory, and at the end of a block.
+  void FlushRegs();
+
+  // Forgets all cached values without writing anything, at the start of a block.
+  void Reset();
+
+private:
+  static constexpr size_t NUM_GUEST_REGS = 12;
+  static constexpr std::array<Arm64Gen::ARM64Reg, 8> s_allocation_order = {
+      Arm64Gen::ARM64Reg::W19, Arm64Gen::ARM64Reg::W20, Arm64Gen::ARM64Reg::W21,
+      Arm64Gen::ARM64Reg::W22, Arm64Gen::ARM64Reg::W23, Arm64Gen::ARM64Reg::W24,
+      Arm64Gen::ARM64Reg::W25, Arm64Gen::ARM64Reg::W26};
+
+  struct CachedReg
+  {
+    Arm64Gen::ARM64Reg host_reg = Arm64Gen::ARM64Reg::INVALID_REG;
+    bool dirty = false;
+    int last_use = 0;
+  };
+
+  Arm64Gen::ARM64Reg Bind(int reg, bool load);
+  Arm64Gen::ARM64Reg AllocateHostReg();
+  void Spill(size_t reg);
+
+  std::array<CachedReg, NUM_GUEST_REGS> m_regs{};
+  int m_use_counter = 0;
+
+  DSPEmitter& m_emitter;
+};
+
+}  // namespace DSP::JIT::arm64
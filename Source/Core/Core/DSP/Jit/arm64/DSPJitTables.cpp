@@ -0,0 +1,111 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/DSP/Jit/arm64/DSPJitTables.h"
+
+#include <array>
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPTables.h"
+#include "Core/DSP/Jit/arm64/DSPEmitter.h"
+
+namespace DSP::JIT::arm64
+{
+struct JITOpInfo
+{
+  u16 opcode;
+  u16 opcode_mask;
+  JITFunction function;
+};
+
+// Instructions which aren't listed here are run through the interpreter.
+// clang-format off
+const std::array<JITOpInfo, 16> s_opcodes =
+{{
+  {0x0000, 0xfffc, &DSPEmitter::nop},
+
+  {0x0004, 0xfffc, &DSPEmitter::dar},
+  {0x0008, 0xfffc, &DSPEmitter::iar},
+  {0x000c, 0xfffc, &DSPEmitter::subarn},
+  {0x0010, 0xfff0, &DSPEmitter::addarn},
+
+  {0x1200, 0xff00, &DSPEmitter::sbclr},
+  {0x1300, 0xff00, &DSPEmitter::sbset},
+
+  {0x0080, 0xffe0, &DSPEmitter::lri},
+
+  {0x1c00, 0xfc00, &DSPEmitter::mrr},
+
+  {0x8000, 0xf700, &DSPEmitter::nx},
+  {0x8a00, 0xff00, &DSPEmitter::srbith},
+  {0x8b00, 0xff00, &DSPEmitter::srbith},
+  {0x8c00, 0xff00, &DSPEmitter::srbith},
+  {0x8d00, 0xff00, &DSPEmitter::srbith},
+  {0x8e00, 0xff00, &DSPEmitter::srbith},
+  {0x8f00, 0xff00, &DSPEmitter::srbith},
+}};
+
+constexpr std::array<JITOpInfo, 4> s_opcodes_ext
+{{
+  {0x0000, 0x00fc, &DSPEmitter::nop},
+
+  {0x0004, 0x00fc, &DSPEmitter::dr},
+  {0x0008, 0x00fc, &DSPEmitter::ir},
+  {0x000c, 0x00fc, &DSPEmitter::nr},
+}};
+// clang-format on
+
+namespace
+{
+std::array<JITFunction, 65536> s_op_table;
+std::array<JITFunction, 256> s_ext_op_table;
+bool s_tables_initialized = false;
+}  // Anonymous namespace
+
+JITFunction GetOp(UDSPInstruction inst)
+{
+  return s_op_table[inst];
+}
+
+JITFunction GetExtOp(UDSPInstruction inst)
+{
+  const bool has_seven_bit_extension = (inst >> 12) == 0x3;
+
+  if (has_seven_bit_extension)
+    return s_ext_op_table[inst & 0x7F];
+
+  return s_ext_op_table[inst & 0xFF];
+}
+
+void InitInstructionTables()
+{
+  if (s_tables_initialized)
+    return;
+
+  // ext op table
+  for (size_t i = 0; i < s_ext_op_table.size(); i++)
+  {
+    s_ext_op_table[i] = nullptr;
+
+    const auto iter = FindByOpcode(static_cast<UDSPInstruction>(i), s_opcodes_ext);
+    if (iter == s_opcodes_ext.cend())
+      continue;
+
+    s_ext_op_table[i] = iter->function;
+  }
+
+  // op table
+  for (size_t i = 0; i < s_op_table.size(); i++)
+  {
+    s_op_table[i] = nullptr;
+
+    const auto iter = FindByOpcode(static_cast<UDSPInstruction>(i), s_opcodes);
+    if (iter == s_opcodes.cend())
+      continue;
+
+    s_op_table[i] = iter->function;
+  }
+
+  s_tables_initialized = true;
+}
+}  // namespace DSP::JIT::arm64
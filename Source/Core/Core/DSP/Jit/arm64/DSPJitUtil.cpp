@@ -0,0 +1,168 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/DSP/Jit/arm64/DSPEmitter.h"
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPCore.h"
+
+using namespace Arm64Gen;
+
+namespace DSP::JIT::arm64
+{
+// addr math
+//
+// These functions detect overflow by checking if
+// the bit past the top of the mask(WR) has changed in AR.
+// They detect values under the minimum for a mask by adding wr + 1
+// and checking if the bit past the top of the mask doesn't change.
+// Both are done while ignoring changes due to values/holes in IX
+// above the mask.
+//
+// W0 - W5 are used as temporaries.
+
+void DSPEmitter::increment_addr_reg(int reg)
+{
+  const ARM64Reg wr = m_gpr.R(DSP_REG_WR0 + reg);
+  const ARM64Reg ar = m_gpr.RW(DSP_REG_AR0 + reg);
+
+  // u32 nar = ar + 1;
+  ADD(ARM64Reg::W0, ar, 1);
+
+  // if ((nar ^ ar) > ((wr | 1) << 1))
+  //		nar -= wr + 1;
+  EOR(ARM64Reg::W1, ARM64Reg::W0, ar);
+  ORR(ARM64Reg::W2, wr, LogicalImm(1, 32));
+  LSL(ARM64Reg::W2, ARM64Reg::W2, 1);
+  SUB(ARM64Reg::W3, ARM64Reg::W0, wr);
+  SUB(ARM64Reg::W3, ARM64Reg::W3, 1);
+  CMP(ARM64Reg::W1, ARM64Reg::W2);
+  CSEL(ARM64Reg::W0, ARM64Reg::W3, ARM64Reg::W0, CC_HI);
+
+  // g_dsp.r.ar[reg] = nar;
+  UXTH(ar, ARM64Reg::W0);
+}
+
+void DSPEmitter::decrement_addr_reg(int reg)
+{
+  const ARM64Reg wr = m_gpr.R(DSP_REG_WR0 + reg);
+  const ARM64Reg ar = m_gpr.RW(DSP_REG_AR0 + reg);
+
+  // u32 nar = ar + wr;
+  ADD(ARM64Reg::W0, ar, wr);
+
+  // if (((nar ^ ar) & ((wr | 1) << 1)) > wr)
+  //		nar -= wr + 1;
+  EOR(ARM64Reg::W1, ARM64Reg::W0, ar);
+  ORR(ARM64Reg::W2, wr, LogicalImm(1, 32));
+  AND(ARM64Reg::W1, ARM64Reg::W1, ARM64Reg::W2, ArithOption(ARM64Reg::W2, ShiftType::LSL, 1));
+  SUB(ARM64Reg::W3, ARM64Reg::W0, wr);
+  SUB(ARM64Reg::W3, ARM64Reg::W3, 1);
+  CMP(ARM64Reg::W1, wr);
+  CSEL(ARM64Reg::W0, ARM64Reg::W3, ARM64Reg::W0, CC_HI);
+
+  // g_dsp.r.ar[reg] = nar;
+  UXTH(ar, ARM64Reg::W0);
+}
+
+// Increase addr register according to the correspond ix register
+void DSPEmitter::increase_addr_reg(int reg, int ix_reg)
+{
+  const ARM64Reg wr = m_gpr.R(DSP_REG_WR0 + reg);
+  const ARM64Reg ix = m_gpr.R(DSP_REG_IX0 + ix_reg);
+  const ARM64Reg ar = m_gpr.RW(DSP_REG_AR0 + reg);
+
+  // s32 ix = (s16)g_dsp.r.ix[ix_reg];
+  SXTH(ARM64Reg::W3, ix);
+
+  // u32 nar = ar + ix;
+  ADD(ARM64Reg::W0, ar, ARM64Reg::W3);
+
+  // u32 dar = (nar ^ ar ^ ix) & ((wr | 1) << 1);
+  EOR(ARM64Reg::W1, ARM64Reg::W0, ar);
+  EOR(ARM64Reg::W1, ARM64Reg::W1, ARM64Reg::W3);
+  ORR(ARM64Reg::W2, wr, LogicalImm(1, 32));
+  AND(ARM64Reg::W1, ARM64Reg::W1, ARM64Reg::W2, ArithOption(ARM64Reg::W2, ShiftType::LSL, 1));
+
+  // w2 = wr + 1
+  ADD(ARM64Reg::W2, wr, 1);
+
+  // if (ix >= 0)
+  FixupBranch negative = TBNZ(ARM64Reg::W3, 31);
+
+  // if (dar > wr)
+  //		nar -= wr + 1;
+  SUB(ARM64Reg::W4, ARM64Reg::W0, ARM64Reg::W2);
+  CMP(ARM64Reg::W1, wr);
+  CSEL(ARM64Reg::W0, ARM64Reg::W4, ARM64Reg::W0, CC_HI);
+  FixupBranch done = B();
+
+  // else
+  SetJumpTarget(negative);
+
+  // if ((((nar + wr + 1) ^ nar) & dar) <= wr)
+  //		nar += wr + 1;
+  ADD(ARM64Reg::W4, ARM64Reg::W0, ARM64Reg::W2);
+  EOR(ARM64Reg::W5, ARM64Reg::W4, ARM64Reg::W0);
+  AND(ARM64Reg::W5, ARM64Reg::W5, ARM64Reg::W1);
+  CMP(ARM64Reg::W5, wr);
+  CSEL(ARM64Reg::W0, ARM64Reg::W4, ARM64Reg::W0, CC_LS);
+
+  SetJumpTarget(done);
+
+  // g_dsp.r.ar[reg] = nar;
+  UXTH(ar, ARM64Reg::W0);
+}
+
+// Decrease addr register according to the correspond ix register
+void DSPEmitter::decrease_addr_reg(int reg)
+{
+  const ARM64Reg wr = m_gpr.R(DSP_REG_WR0 + reg);
+  const ARM64Reg ix = m_gpr.R(DSP_REG_IX0 + reg);
+  const ARM64Reg ar = m_gpr.RW(DSP_REG_AR0 + reg);
+
+  // s32 ix = (s16)g_dsp.r.ix[reg];
+  SXTH(ARM64Reg::W3, ix);
+
+  // u32 nar = ar - ix;
+  SUB(ARM64Reg::W0, ar, ARM64Reg::W3);
+
+  // u32 dar = (nar ^ ar ^ ~ix) & ((wr | 1) << 1);
+  EOR(ARM64Reg::W1, ARM64Reg::W0, ar);
+  EON(ARM64Reg::W1, ARM64Reg::W1, ARM64Reg::W3);
+  ORR(ARM64Reg::W2, wr, LogicalImm(1, 32));
+  AND(ARM64Reg::W1, ARM64Reg::W1, ARM64Reg::W2, ArithOption(ARM64Reg::W2, ShiftType::LSL, 1));
+
+  // w2 = wr + 1
+  ADD(ARM64Reg::W2, wr, 1);
+
+  // if ((u32)ix > 0xFFFF8000)
+  MOVI2R(ARM64Reg::W4, 0xFFFF8000);
+  CMP(ARM64Reg::W3, ARM64Reg::W4);
+  FixupBranch not_negative = B(CC_LS);
+
+  // if (dar > wr)
+  //		nar -= wr + 1;
+  SUB(ARM64Reg::W4, ARM64Reg::W0, ARM64Reg::W2);
+  CMP(ARM64Reg::W1, wr);
+  CSEL(ARM64Reg::W0, ARM64Reg::W4, ARM64Reg::W0, CC_HI);
+  FixupBranch done = B();
+
+  // else
+  SetJumpTarget(not_negative);
+
+  // if ((((nar + wr + 1) ^ nar) & dar) <= wr)
+  //		nar += wr + 1;
+  ADD(ARM64Reg::W4, ARM64Reg::W0, ARM64Reg::W2);
+  EOR(ARM64Reg::W5, ARM64Reg::W4, ARM64Reg::W0);
+  AND(ARM64Reg::W5, ARM64Reg::W5, ARM64Reg::W1);
+  CMP(ARM64Reg::W5, wr);
+  CSEL(ARM64Reg::W0, ARM64Reg::W4, ARM64Reg::W0, CC_LS);
+
+  SetJumpTarget(done);
+
+  // g_dsp.r.ar[reg] = nar;
+  UXTH(ar, ARM64Reg::W0);
+}
+
+}  // namespace DSP::JIT::arm64
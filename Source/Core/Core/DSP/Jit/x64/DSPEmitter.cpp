@@ -56,19 +56,49 @@ u16 DSPEmitter::RunCycles(u16 cycles)
     m_dsp_core.CheckExceptions();
   }
 
+  SDSP& state = m_dsp_core.DSPState();
+
+  // The DSP is polling the mailboxes in an idle loop. Until the CPU or an interrupt changes
+  // something, running it again would only spin in the same loop, so give up the time slice
+  // right away.
+  if (m_idle_wait)
+  {
+    if (state.pc == m_idle_wait_pc &&
+        state.PeekMailbox(Mailbox::CPU) == m_idle_wait_mailboxes[0] &&
+        state.PeekMailbox(Mailbox::DSP) == m_idle_wait_mailboxes[1])
+    {
+      m_cycles_left = 0;
+      return 0;
+    }
+    m_idle_wait = false;
+  }
+
   m_cycles_left = cycles;
   auto exec_addr = (DSPCompiledCode)m_enter_dispatcher;
   exec_addr();
 
-  if (m_dsp_core.DSPState().reset_dspjit_codespace)
+  if (state.reset_dspjit_codespace)
     ClearIRAMandDSPJITCodespaceReset();
 
+  // If the last block was an idle loop which branched back to itself, it has already seen the
+  // current mailbox contents.
+  if (!Host::OnThread() && m_last_block_cycles == DSP_IDLE_SKIP_CYCLES &&
+      m_idle_block_address == state.pc)
+  {
+    m_idle_wait = true;
+    m_idle_wait_pc = state.pc;
+    m_idle_wait_mailboxes = {state.PeekMailbox(Mailbox::CPU), state.PeekMailbox(Mailbox::DSP)};
+  }
+
   return m_cycles_left;
 }
 
 void DSPEmitter::DoState(PointerWrap& p)
 {
   p.Do(m_cycles_left);
+
+  if (p.IsReadMode())
+    m_idle_wait = false;
 }
 
 void DSPEmitter::ClearIRAM()
@@ -80,6 +110,7 @@ void DSPEmitter::ClearIRAM()
     m_block_size[i] = 0;
     m_unresolved_jumps[i].clear();
   }
+  m_idle_wait = false;
   m_dsp_core.DSPState().reset_dspjit_codespace = true;
 }
 
@@ -282,14 +313,7 @@ void DSPEmitter::Compile(u16 start_addr)
       DSPJitRegCache c(m_gpr);
       HandleLoop();
       m_gpr.SaveRegs();
-      if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-      {
-        MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-      }
-      else
-      {
-        MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-      }
+      WriteBlockCycles(!Host::OnThread() && analyzer.IsIdleSkip(start_addr));
       JMP(m_return_dispatcher, true);
       m_gpr.LoadRegs(false);
       m_gpr.FlushRegs(c, false);
@@ -318,14 +342,7 @@ void DSPEmitter::Compile(u16 start_addr)
         DSPJitRegCache c(m_gpr);
         // don't update g_dsp.pc -- the branch insn already did
         m_gpr.SaveRegs();
-        if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-        {
-          MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-        }
-        else
-        {
-          MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-        }
+        WriteBlockCycles(!Host::OnThread() && analyzer.IsIdleSkip(start_addr));
         JMP(m_return_dispatcher, true);
         m_gpr.LoadRegs(false);
         m_gpr.FlushRegs(c, false);
@@ -381,15 +398,23 @@ void DSPEmitter::Compile(u16 start_addr)
   }
 
   m_gpr.SaveRegs();
-  if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
+  WriteBlockCycles(!Host::OnThread() && analyzer.IsIdleSkip(start_addr));
+  JMP(m_return_dispatcher, true);
+}
+
+void DSPEmitter::WriteBlockCycles(bool idle_skip)
+{
+  if (idle_skip)
   {
+    // Lets RunCycles tell which idle loop gave up the time slice.
+    MOV(64, R(RCX), ImmPtr(&m_idle_block_address));
+    MOV(16, MatR(RCX), Imm16(m_start_address));
     MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
   }
   else
   {
-    MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
+    MOV(16, R(EAX), Imm16(m_block_size[m_start_address]));
   }
-  JMP(m_return_dispatcher, true);
 }
 
 void DSPEmitter::CompileCurrent(DSPEmitter& emitter)
@@ -453,6 +478,9 @@ void DSPEmitter::CompileDispatcher()
 
   m_return_dispatcher = GetCodePtr();
 
+  MOV(64, R(RCX), ImmPtr(&m_last_block_cycles));
+  MOV(16, MatR(RCX), R(EAX));
+
   // Decrement cyclesLeft
   MOV(64, R(RCX), ImmPtr(&m_cycles_left));
   SUB(16, MatR(RCX), R(EAX));
@@ -211,6 +211,9 @@ private:
 
   void FallBackToInterpreter(UDSPInstruction inst);
 
+  // Sets EAX to the number of cycles the block executed, for the dispatcher. Idle loops return
+  // enough cycles to end the time slice.
+  void WriteBlockCycles(bool idle_skip);
   void WriteBranchExit();
   void WriteBlockLink(u16 dest);
 
@@ -325,6 +328,15 @@ private:
 
   u16 m_cycles_left = 0;
 
+  // Written by the dispatcher and the idle loop exits, for detecting when the DSP is waiting for
+  // mail.
+  u16 m_last_block_cycles = 0;
+  u16 m_idle_block_address = 0;
+
+  bool m_idle_wait = false;
+  u16 m_idle_wait_pc = 0;
+  std::array<u32, 2> m_idle_wait_mailboxes{};
+
   // The index of the last stored ext value (compile time).
   int m_store_index = -1;
   int m_store_index2 = -1;
@@ -30,6 +30,10 @@ public:
   virtual void DSP_StopSoundStream() = 0;
   virtual u32 DSP_UpdateRate() = 0;
 
+  // Returns the average time in microseconds the CPU thread waited for the DSP thread per update
+  // since the last call, or 0 if the DSP doesn't run on its own thread.
+  virtual float TakeThreadLatency() { return 0.0f; }
+
 protected:
   bool m_wii = false;
 };
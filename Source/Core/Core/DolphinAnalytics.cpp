@@ -130,7 +130,8 @@ void DolphinAnalytics::ReportGameStart()
   Send(builder);
 
   // Reset per-game state.
-  m_reported_quirks.fill(false);
+  for (std::atomic<bool>& reported : m_reported_quirks)
+    reported.store(false, std::memory_order_relaxed);
   InitializePerformanceSampling();
 }
 
@@ -173,9 +174,8 @@ void DolphinAnalytics::ReportGameQuirk(GameQuirk quirk)
   u32 quirk_idx = static_cast<u32>(quirk);
 
   // Only report once per run.
-  if (m_reported_quirks[quirk_idx])
+  if (m_reported_quirks[quirk_idx].exchange(true, std::memory_order_relaxed))
     return;
-  m_reported_quirks[quirk_idx] = true;
 
   Common::AnalyticsReportBuilder builder(m_per_game_builder);
   builder.AddData("type", "quirk");
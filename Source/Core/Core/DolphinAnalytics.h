@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -174,8 +175,9 @@ private:
   bool m_sampling_performance_info = false;  // Whether we are currently collecting samples.
   std::vector<PerformanceSample> m_performance_samples;
 
-  // What quirks have already been reported about the current game.
-  std::array<bool, static_cast<size_t>(GameQuirk::COUNT)> m_reported_quirks;
+  // What quirks have already been reported about the current game. Quirks can be reported from
+  // the DSP HLE voice threads.
+  std::array<std::atomic<bool>, static_cast<size_t>(GameQuirk::COUNT)> m_reported_quirks{};
 
   // Builder that contains all non variable data that should be sent with all
   // reports.
@@ -9,17 +9,24 @@
 #include <string>
 #include <vector>
 
+#include <xxhash.h>
+#include <zstd.h>
+
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 
 constexpr u32 FILE_ID = 0x0d01f1f0;
-constexpr u32 VERSION_NUMBER = 5;
+constexpr u32 VERSION_NUMBER = 7;
 constexpr u32 MIN_LOADER_VERSION = 1;
-// This value is only used if the DFF file was created with overridden RAM sizes.
-// If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
+// These values are only used if the DFF file was created with overridden RAM sizes, or with
+// compression. If the MIN_LOADER_VERSION ever exceeds them, it's alright to remove them.
 constexpr u32 MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5;
+constexpr u32 MIN_LOADER_VERSION_FOR_COMPRESSION = 7;
+
+constexpr int COMPRESSION_LEVEL = 3;
 
 #pragma pack(push, 1)
 
@@ -49,6 +56,10 @@ struct FileHeader
 };
 static_assert(sizeof(FileHeader) == 128, "FileHeader should be 128 bytes");
 
+// In compressed files, fifoDataOffset points to a zstd frame. In version 6 it holds the FIFO data
+// followed by the data of the memory updates, and their data offsets are relative to its start.
+// From version 7 on, it only holds the FIFO data, and every memory update points to a zstd frame
+// of its own, which may be shared with other memory updates.
 struct FileFrameInfo
 {
   u64 fifoDataOffset;
@@ -57,7 +68,9 @@ struct FileFrameInfo
   u32 fifoEnd;
   u64 memoryUpdatesOffset;
   u32 numMemoryUpdates;
-  u8 reserved[32];
+  u32 compressedSize;
+  u32 uncompressedSize;
+  u8 reserved[24];
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
@@ -74,6 +87,41 @@ static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 byt
 
 #pragma pack(pop)
 
+template <typename T>
+static bool ReadStruct(std::span<const u8> data, u64 offset, T* out)
+{
+  if (offset > data.size() || data.size() - offset < sizeof(T))
+    return false;
+
+  std::memcpy(out, data.data() + offset, sizeof(T));
+  return true;
+}
+
+static bool IsInRange(u64 size, u64 offset, u64 length)
+{
+  return offset <= size && size - offset >= length;
+}
+
+static std::vector<u8> Compress(std::span<const u8> data)
+{
+  // This can only fail if memory runs out, which is then reported when the data is decompressed.
+  std::vector<u8> compressed(ZSTD_compressBound(data.size()));
+  const size_t size =
+      ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), COMPRESSION_LEVEL);
+  compressed.resize(ZSTD_isError(size) ? 0 : size);
+  return compressed;
+}
+
+// Decompresses the zstd frame at the start of src, which may be followed by other data.
+static bool Decompress(std::span<const u8> src, std::span<u8> dst)
+{
+  const size_t src_size = ZSTD_findFrameCompressedSize(src.data(), src.size());
+  if (ZSTD_isError(src_size))
+    return false;
+
+  return ZSTD_decompress(dst.data(), dst.size(), src.data(), src_size) == dst.size();
+}
+
 FifoDataFile::FifoDataFile() = default;
 
 FifoDataFile::~FifoDataFile() = default;
@@ -98,13 +146,98 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
-void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
+void FifoDataFile::SetCompressed(bool compressed)
+{
+  SetFlag(FLAG_COMPRESSED, compressed);
+}
+
+bool FifoDataFile::HasCombinedFramePayload() const
 {
-  m_Frames.push_back(frameInfo);
+  return GetFlag(FLAG_COMPRESSED) && m_Version < 7;
+}
+
+void FifoDataFile::AddFrame(FifoFrameInfo frameInfo)
+{
+  if (!m_encode_thread_started)
+  {
+    m_encode_thread.Reset([this](FifoFrameInfo frame) { EncodeFrame(frame); });
+    m_encode_thread_started = true;
+  }
+
+  {
+    std::lock_guard lk(m_frames_mutex);
+    m_Frames.emplace_back();
+    m_frame_count++;
+  }
+
+  m_encode_thread.EmplaceItem(std::move(frameInfo));
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  std::unique_lock lk(m_frames_mutex);
+  if (m_Frames[frame])
+    return m_Frames[frame];
+
+  if (!IsLoaded())
+    m_frame_encoded.wait(lk, [&] { return frame < m_encoded_frames.size(); });
+
+  const auto get_size = [](const FifoFrameInfo& frame_info) {
+    size_t size = frame_info.fifoData.size();
+    for (const MemoryUpdate& update : frame_info.memoryUpdates)
+      size += update.data.size();
+    return size;
+  };
+
+  auto frame_info = std::make_shared<const FifoFrameInfo>(
+      IsLoaded() ? ReadFrame(frame) : DecodeFrame(m_encoded_frames[frame]));
+  m_Frames[frame] = frame_info;
+  m_cached_frames.push_back(frame);
+  m_cached_frames_size += get_size(*frame_info);
+
+  while (m_cached_frames_size > FRAME_CACHE_SIZE && m_cached_frames.size() > 1)
+  {
+    std::shared_ptr<const FifoFrameInfo>& oldest = m_Frames[m_cached_frames.front()];
+    m_cached_frames_size -= get_size(*oldest);
+    oldest.reset();
+    m_cached_frames.pop_front();
+  }
+
+  return frame_info;
+}
+
+void FifoDataFile::GetRecordedSizes(u64* fifo_bytes, u64* memory_bytes, u64* stored_bytes) const
+{
+  std::unique_lock lk(m_frames_mutex);
+  m_frame_encoded.wait(lk, [&] { return m_encoded_frames.size() == m_frame_count; });
+
+  *fifo_bytes = 0;
+  *memory_bytes = 0;
+  *stored_bytes = 0;
+  for (const EncodedFrame& frame : m_encoded_frames)
+  {
+    *fifo_bytes += frame.fifoDataSize;
+    *stored_bytes += frame.fifoData.size();
+    for (const EncodedMemoryUpdate& update : frame.memoryUpdates)
+      *memory_bytes += update.dataSize;
+  }
+
+  for (const std::vector<u8>& block : m_data_blocks)
+    *stored_bytes += block.size();
 }
 
 bool FifoDataFile::Save(const std::string& filename)
 {
+  // The frames of a loaded file are only encoded when it's saved.
+  if (IsLoaded())
+  {
+    for (u32 i = static_cast<u32>(m_encoded_frames.size()); i < m_frame_count; ++i)
+      EncodeFrame(*GetFrame(i));
+  }
+
+  std::unique_lock lk(m_frames_mutex);
+  m_frame_encoded.wait(lk, [&] { return m_encoded_frames.size() == m_frame_count; });
+
   File::IOFile file;
   if (!file.Open(filename, "wb"))
     return false;
@@ -114,7 +247,7 @@ bool FifoDataFile::Save(const std::string& filename)
 
   // Add space for frame list
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  PadFile(m_frame_count * sizeof(FileFrameInfo), file);
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
@@ -131,15 +264,19 @@ bool FifoDataFile::Save(const std::string& filename)
   u64 texMemOffset = file.Tell();
   file.WriteArray(m_TexMem);
 
+  const bool compressed = GetFlag(FLAG_COMPRESSED);
+
   // Write header
   FileHeader header;
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
+  // Maintain backwards compatability so long as the RAM sizes aren't overridden and the file
+  // isn't compressed.
+  header.min_loader_version = MIN_LOADER_VERSION;
   if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
     header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
-  else
-    header.min_loader_version = MIN_LOADER_VERSION;
+  if (compressed)
+    header.min_loader_version = MIN_LOADER_VERSION_FOR_COMPRESSION;
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -157,7 +294,7 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = m_frame_count;
 
   header.flags = m_Flags;
 
@@ -167,32 +304,58 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, File::SeekOrigin::Begin);
   file.WriteBytes(&header, sizeof(FileHeader));
 
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
+  // Write memory update data. Every block is written once, however many updates refer to it,
+  // which older versions of the FIFO player can also load as long as it's uncompressed.
+  file.Seek(0, File::SeekOrigin::End);
+  std::vector<u64> dataBlockOffsets(m_data_blocks.size());
+  for (size_t i = 0; i < m_data_blocks.size(); ++i)
   {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
+    dataBlockOffsets[i] = file.Tell();
+    file.WriteBytes(m_data_blocks[i].data(), m_data_blocks[i].size());
+  }
 
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+  std::vector<FileFrameInfo> frameList(m_frame_count);
+  for (u32 i = 0; i < m_frame_count; ++i)
+  {
+    const EncodedFrame& srcFrame = m_encoded_frames[i];
 
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
+    FileFrameInfo& dstFrame = frameList[i];
+    dstFrame = {};
+    dstFrame.fifoDataSize = srcFrame.fifoDataSize;
     dstFrame.fifoStart = srcFrame.fifoStart;
     dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
     dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
+    if (compressed)
+    {
+      dstFrame.compressedSize = static_cast<u32>(srcFrame.fifoData.size());
+      dstFrame.uncompressedSize = srcFrame.fifoDataSize;
+    }
+
+    // Write FIFO data
+    dstFrame.fifoDataOffset = file.Tell();
+    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
 
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+    // Write memory update list
+    std::vector<FileMemoryUpdate> updates(srcFrame.memoryUpdates.size());
+    for (size_t j = 0; j < updates.size(); ++j)
+    {
+      const EncodedMemoryUpdate& srcUpdate = srcFrame.memoryUpdates[j];
+      updates[j] = {};
+      updates[j].fifoPosition = srcUpdate.fifoPosition;
+      updates[j].address = srcUpdate.address;
+      updates[j].dataOffset = dataBlockOffsets[srcUpdate.dataBlock];
+      updates[j].dataSize = srcUpdate.dataSize;
+      updates[j].type = srcUpdate.type;
+    }
+
+    dstFrame.memoryUpdatesOffset = file.Tell();
+    file.WriteBytes(updates.data(), updates.size() * sizeof(FileMemoryUpdate));
   }
 
+  // Write frame list
+  file.Seek(frameListOffset, File::SeekOrigin::Begin);
+  file.WriteBytes(frameList.data(), frameList.size() * sizeof(FileFrameInfo));
+
   if (!file.Close())
     return false;
 
@@ -308,35 +471,30 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   if (!file.IsGood())
     return panic_failed_to_read();
 
-  // idk what else these could be used for, but it'd be a shame to not make them available.
-  dataFile->m_ram_size_real = header.mem1_size;
-  dataFile->m_exram_size_real = header.mem2_size;
-
-  // Read frames
-  for (u32 i = 0; i < header.frameCount; ++i)
+  // Frames are read from the file as they're used.
+  if (dataFile->m_mapped_file.Open(filename))
   {
-    u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
+    dataFile->m_file_data = {dataFile->m_mapped_file.GetData(),
+                             dataFile->m_mapped_file.GetSize()};
+  }
+  else
+  {
+    dataFile->m_file_buffer.resize(file.GetSize());
+    file.Seek(0, File::SeekOrigin::Begin);
+    if (!file.ReadBytes(dataFile->m_file_buffer.data(), dataFile->m_file_buffer.size()))
       return panic_failed_to_read();
+    dataFile->m_file_data = dataFile->m_file_buffer;
+  }
 
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-
-    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
-
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
-
-    if (!file.IsGood())
-      return panic_failed_to_read();
+  // idk what else these could be used for, but it'd be a shame to not make them available.
+  dataFile->m_ram_size_real = header.mem1_size;
+  dataFile->m_exram_size_real = header.mem2_size;
 
-    dataFile->AddFrame(dstFrame);
-  }
+  dataFile->m_frame_list_offset = header.frameListOffset;
+  dataFile->m_frame_count = header.frameCount;
+  dataFile->m_Frames.resize(header.frameCount);
+  if (!dataFile->ValidateFrames())
+    return panic_failed_to_read();
 
   return dataFile;
 }
@@ -360,56 +518,190 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
+void FifoDataFile::EncodeFrame(const FifoFrameInfo& frame)
 {
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
+  EncodedFrame encoded;
+  encoded.fifoStart = frame.fifoStart;
+  encoded.fifoEnd = frame.fifoEnd;
+  encoded.fifoDataSize = static_cast<u32>(frame.fifoData.size());
+  encoded.fifoData = GetFlag(FLAG_COMPRESSED) ? Compress(frame.fifoData) : frame.fifoData;
+
+  encoded.memoryUpdates.reserve(frame.memoryUpdates.size());
+  for (const MemoryUpdate& update : frame.memoryUpdates)
+  {
+    encoded.memoryUpdates.push_back({update.fifoPosition, update.address,
+                                     static_cast<u32>(update.data.size()),
+                                     AddDataBlock(update.data), update.type});
+  }
+
+  std::lock_guard lk(m_frames_mutex);
+  m_encoded_frames.push_back(std::move(encoded));
+  m_frame_encoded.notify_all();
+}
 
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
+u32 FifoDataFile::AddDataBlock(std::span<const u8> data)
+{
+  // Textures and vertex arrays are often uploaded again with the same contents, after the game
+  // used that memory for something else. Blocks with the same hash are compared, so that data
+  // is never merged with different data that happens to have the same hash.
+  const u64 hash = XXH64(data.data(), data.size(), 0);
+  const auto [begin, end] = m_data_block_hashes.equal_range(hash);
+  for (auto it = begin; it != end; ++it)
   {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
+    const std::vector<u8>& block = m_data_blocks[it->second];
+    const bool equal =
+        GetFlag(FLAG_COMPRESSED) ?
+            std::ranges::equal(DecodeData(block, static_cast<u32>(data.size())), data) :
+            std::ranges::equal(block, data);
+    if (equal)
+      return it->second;
+  }
+
+  std::vector<u8> block = GetFlag(FLAG_COMPRESSED) ? Compress(data) :
+                                                     std::vector<u8>(data.begin(), data.end());
 
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+  std::lock_guard lk(m_frames_mutex);
+  const u32 index = static_cast<u32>(m_data_blocks.size());
+  m_data_blocks.push_back(std::move(block));
+  m_data_block_hashes.emplace(hash, index);
+  return index;
+}
+
+std::vector<u8> FifoDataFile::DecodeData(std::span<const u8> stored, u32 size) const
+{
+  if (!GetFlag(FLAG_COMPRESSED))
+    return std::vector<u8>(stored.begin(), stored.end());
+
+  std::vector<u8> data(size);
+  if (!Decompress(stored, data))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to decompress recorded FIFO data");
+    data.clear();
+  }
+  return data;
+}
 
-    FileMemoryUpdate dstUpdate;
+FifoFrameInfo FifoDataFile::DecodeFrame(const EncodedFrame& frame) const
+{
+  FifoFrameInfo dstFrame;
+  dstFrame.fifoStart = frame.fifoStart;
+  dstFrame.fifoEnd = frame.fifoEnd;
+  dstFrame.fifoData = DecodeData(frame.fifoData, frame.fifoDataSize);
+
+  dstFrame.memoryUpdates.resize(frame.memoryUpdates.size());
+  for (size_t i = 0; i < frame.memoryUpdates.size(); ++i)
+  {
+    const EncodedMemoryUpdate& srcUpdate = frame.memoryUpdates[i];
+    MemoryUpdate& dstUpdate = dstFrame.memoryUpdates[i];
     dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
     dstUpdate.type = srcUpdate.type;
+    dstUpdate.data = DecodeData(m_data_blocks[srcUpdate.dataBlock], srcUpdate.dataSize);
+  }
 
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
+  return dstFrame;
+}
+
+bool FifoDataFile::ValidateFrames() const
+{
+  const bool compressed = GetFlag(FLAG_COMPRESSED);
+  const bool combined = HasCombinedFramePayload();
+  for (u32 i = 0; i < m_frame_count; ++i)
+  {
+    FileFrameInfo frame;
+    if (!ReadStruct(m_file_data, m_frame_list_offset + u64{i} * sizeof(FileFrameInfo), &frame))
+      return false;
+
+    const u64 payload_size = compressed ? frame.uncompressedSize : m_file_data.size();
+    if (compressed && !IsInRange(m_file_data.size(), frame.fifoDataOffset, frame.compressedSize))
+      return false;
+    if (!IsInRange(payload_size, compressed ? 0 : frame.fifoDataOffset, frame.fifoDataSize))
+      return false;
+    if (!IsInRange(m_file_data.size(), frame.memoryUpdatesOffset,
+                   u64{frame.numMemoryUpdates} * sizeof(FileMemoryUpdate)))
+    {
+      return false;
+    }
+
+    for (u32 j = 0; j < frame.numMemoryUpdates; ++j)
+    {
+      FileMemoryUpdate update;
+      ReadStruct(m_file_data, frame.memoryUpdatesOffset + u64{j} * sizeof(FileMemoryUpdate),
+                 &update);
+      // Separately compressed data is checked when it's decompressed, as its size isn't stored.
+      if (compressed && !combined)
+      {
+        if (update.dataOffset >= m_file_data.size())
+          return false;
+      }
+      else if (!IsInRange(combined ? payload_size : m_file_data.size(), update.dataOffset,
+                          update.dataSize))
+      {
+        return false;
+      }
+    }
   }
 
-  return updateListOffset;
+  return true;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
+FifoFrameInfo FifoDataFile::ReadFrame(u32 frame) const
 {
-  memUpdates.resize(numUpdates);
+  // The frame list was checked by ValidateFrames when the file was loaded.
+  FileFrameInfo srcFrame;
+  ReadStruct(m_file_data, m_frame_list_offset + u64{frame} * sizeof(FileFrameInfo), &srcFrame);
+
+  FifoFrameInfo dstFrame;
+  dstFrame.fifoStart = srcFrame.fifoStart;
+  dstFrame.fifoEnd = srcFrame.fifoEnd;
+
+  std::span<const u8> payload = m_file_data;
+  u64 fifoDataOffset = srcFrame.fifoDataOffset;
+  std::vector<u8> decompressed;
+  if (GetFlag(FLAG_COMPRESSED))
+  {
+    decompressed.resize(srcFrame.uncompressedSize);
+    if (!Decompress(m_file_data.subspan(srcFrame.fifoDataOffset, srcFrame.compressedSize),
+                    decompressed))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to decompress frame {} of the FIFO log", frame);
+      return dstFrame;
+    }
+
+    payload = decompressed;
+    fifoDataOffset = 0;
+  }
+
+  dstFrame.fifoData.assign(payload.begin() + fifoDataOffset,
+                           payload.begin() + fifoDataOffset + srcFrame.fifoDataSize);
 
-  for (u32 i = 0; i < numUpdates; ++i)
+  dstFrame.memoryUpdates.resize(srcFrame.numMemoryUpdates);
+  for (u32 i = 0; i < srcFrame.numMemoryUpdates; ++i)
   {
-    u64 updateOffset = fileOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
     FileMemoryUpdate srcUpdate;
-    file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate));
+    ReadStruct(m_file_data, srcFrame.memoryUpdatesOffset + u64{i} * sizeof(FileMemoryUpdate),
+               &srcUpdate);
 
-    MemoryUpdate& dstUpdate = memUpdates[i];
+    MemoryUpdate& dstUpdate = dstFrame.memoryUpdates[i];
     dstUpdate.address = srcUpdate.address;
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.data.resize(srcUpdate.dataSize);
     dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
 
-    file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
+    if (GetFlag(FLAG_COMPRESSED) && !HasCombinedFramePayload())
+    {
+      dstUpdate.data.resize(srcUpdate.dataSize);
+      if (!Decompress(m_file_data.subspan(srcUpdate.dataOffset), dstUpdate.data))
+      {
+        ERROR_LOG_FMT(VIDEO, "Failed to decompress a memory update in frame {} of the FIFO log",
+                      frame);
+        dstUpdate.data.clear();
+      }
+      continue;
+    }
+
+    dstUpdate.data.assign(payload.begin() + srcUpdate.dataOffset,
+                          payload.begin() + srcUpdate.dataOffset + srcUpdate.dataSize);
   }
+
+  return dstFrame;
 }
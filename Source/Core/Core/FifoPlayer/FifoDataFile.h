@@ -4,11 +4,18 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace File
@@ -61,6 +68,8 @@ public:
 
   void SetIsWii(bool isWii);
   bool GetIsWii() const;
+  // Must be set before frames are added.
+  void SetCompressed(bool compressed);
   bool HasBrokenEFBCopies() const;
   bool ShouldGenerateFakeVIUpdates() const;
 
@@ -72,27 +81,69 @@ public:
   u32 GetRamSizeReal() { return m_ram_size_real; }
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
-  void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // Added frames are encoded on a worker thread into the form they're saved in, which compresses
+  // them if enabled and stores memory update data that is identical to earlier data only once.
+  void AddFrame(FifoFrameInfo frameInfo);
+  // Frames are only read from a loaded file or decoded when they're used, and only the most
+  // recently used ones are kept in memory, so callers have to hold on to the returned frame.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const { return m_frame_count; }
+  // Total size of the FIFO data and memory updates of the added frames, and the number of bytes
+  // that are actually stored for them.
+  void GetRecordedSizes(u64* fifo_bytes, u64* memory_bytes, u64* stored_bytes) const;
+  // Compressed files store the FIFO data of each frame and the data of memory updates as zstd
+  // frames. They can't be loaded by versions of the FIFO player from before compression was
+  // supported.
   bool Save(const std::string& filename);
 
+  // Only reads the file's header and frame list, so that large files can start playing at once.
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
 
 private:
   enum
   {
-    FLAG_IS_WII = 1
+    FLAG_IS_WII = 1,
+    FLAG_COMPRESSED = 2,
   };
 
+  // Decoded frames of a loaded file are dropped once they take up more than this.
+  static constexpr size_t FRAME_CACHE_SIZE = 64 * 1024 * 1024;
+
   void PadFile(size_t numBytes, File::IOFile& file);
 
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  struct EncodedMemoryUpdate
+  {
+    u32 fifoPosition;
+    u32 address;
+    u32 dataSize;
+    // Index into m_data_blocks.
+    u32 dataBlock;
+    MemoryUpdate::Type type;
+  };
+
+  struct EncodedFrame
+  {
+    u32 fifoStart;
+    u32 fifoEnd;
+    u32 fifoDataSize;
+    std::vector<u8> fifoData;
+    std::vector<EncodedMemoryUpdate> memoryUpdates;
+  };
+
+  bool IsLoaded() const { return !m_file_data.empty(); }
+  // Version 6 compressed the data of a frame's memory updates together with its FIFO data.
+  bool HasCombinedFramePayload() const;
+
+  void EncodeFrame(const FifoFrameInfo& frame);
+  u32 AddDataBlock(std::span<const u8> data);
+  std::vector<u8> DecodeData(std::span<const u8> stored, u32 size) const;
+  FifoFrameInfo DecodeFrame(const EncodedFrame& frame) const;
+
+  bool ValidateFrames() const;
+  FifoFrameInfo ReadFrame(u32 frame) const;
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
@@ -105,5 +156,27 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  // Loaded files are memory mapped if possible, and read into m_file_buffer otherwise.
+  File::MappedFile m_mapped_file;
+  std::vector<u8> m_file_buffer;
+  std::span<const u8> m_file_data;
+  u64 m_frame_list_offset = 0;
+  u32 m_frame_count = 0;
+
+  // All recorded frames, or the frames of a loaded file that have been read recently.
+  mutable std::mutex m_frames_mutex;
+  mutable std::vector<std::shared_ptr<const FifoFrameInfo>> m_Frames;
+  mutable std::deque<u32> m_cached_frames;
+  mutable size_t m_cached_frames_size = 0;
+
+  // Encoded frames, and the memory update data they refer to. Blocks are only added by the
+  // encoder, which looks them up by their XXH64 hash.
+  std::vector<EncodedFrame> m_encoded_frames;
+  std::vector<std::vector<u8>> m_data_blocks;
+  std::unordered_multimap<u64, u32> m_data_block_hashes;
+  mutable std::condition_variable m_frame_encoded;
+
+  // Declared last so that it finishes encoding before anything else is destroyed.
+  Common::WorkQueueThread<FifoFrameInfo> m_encode_thread;
+  bool m_encode_thread_started = false;
 };
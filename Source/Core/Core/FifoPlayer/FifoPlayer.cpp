@@ -80,7 +80,8 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
 
   for (u32 frame_no = 0; frame_no < file->GetFrameCount(); frame_no++)
   {
-    const FifoFrameInfo& frame = file->GetFrame(frame_no);
+    const std::shared_ptr<const FifoFrameInfo> frame_ptr = file->GetFrame(frame_no);
+    const FifoFrameInfo& frame = *frame_ptr;
     AnalyzedFrameInfo& analyzed = frame_info[frame_no];
 
     u32 offset = 0;
@@ -227,6 +228,7 @@ public:
     CPU::EnableStepping(false);
 
     m_parent->m_CurrentFrame = m_parent->m_FrameRangeStart;
+    m_parent->m_CompletedLoops = 0;
     m_parent->LoadMemory();
   }
 
@@ -274,7 +276,9 @@ CPU::State FifoPlayer::AdvanceFrame()
 {
   if (m_CurrentFrame > m_FrameRangeEnd)
   {
-    if (!m_Loop)
+    ++m_CompletedLoops;
+    const bool loop = m_LoopCount != 0 ? m_CompletedLoops < m_LoopCount : m_Loop;
+    if (!loop)
       return CPU::State::PowerDown;
 
     // When looping, reload the contents of all the BP/CP/CF registers.
@@ -292,7 +296,7 @@ CPU::State FifoPlayer::AdvanceFrame()
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  WriteFrame(*m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
 
   ++m_CurrentFrame;
   return CPU::State::Running;
@@ -483,8 +487,8 @@ void FifoPlayer::WriteAllMemoryUpdates()
 
   for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
   {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
-    for (auto& update : frame.memoryUpdates)
+    const std::shared_ptr<const FifoFrameInfo> frame = m_File->GetFrame(frameNum);
+    for (auto& update : frame->memoryUpdates)
     {
       WriteMemory(update);
     }
@@ -542,7 +546,8 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const std::shared_ptr<const FifoFrameInfo> frame_ptr = m_File->GetFrame(m_CurrentFrame);
+  const FifoFrameInfo& frame = *frame_ptr;
 
   // Set fifo bounds
   WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
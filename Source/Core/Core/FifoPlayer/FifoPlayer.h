@@ -123,6 +123,12 @@ public:
   u32 GetObjectRangeEnd() const { return m_ObjectRangeEnd; }
   void SetObjectRangeEnd(u32 end) { m_ObjectRangeEnd = end; }
 
+  // Plays the frame range this many times and then stops, regardless of the loop setting. If it's
+  // 0, the loop setting decides.
+  void SetLoopCount(u32 count) { m_LoopCount = count; }
+  // Times the frame range has been played completely since playback started.
+  u32 GetCompletedLoopCount() const { return m_CompletedLoops; }
+
   // Callbacks
   void SetFileLoadedCallback(CallbackFunc callback);
   void SetFrameWrittenCallback(CallbackFunc callback) { m_FrameWrittenCb = std::move(callback); }
@@ -173,6 +179,8 @@ private:
   void RefreshConfig();
 
   bool m_Loop = true;
+  u32 m_LoopCount = 0;
+  u32 m_CompletedLoops = 0;
   // If enabled then all memory updates happen at once before the first frame
   bool m_EarlyMemoryUpdates = false;
 
@@ -10,6 +10,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
 
@@ -236,6 +237,7 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
   std::fill(m_ExRam.begin(), m_ExRam.end(), 0);
 
   m_File->SetIsWii(SConfig::GetInstance().bWii);
+  m_File->SetCompressed(Config::Get(Config::MAIN_FIFOPLAYER_COMPRESS_RECORDINGS));
 
   if (!m_IsRecording)
   {
@@ -292,15 +294,15 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
     {
       std::lock_guard lk(m_mutex);
 
-      // Copy frame to file
-      // The file will be responsible for freeing the memory allocated for each frame's fifoData
-      m_File->AddFrame(m_CurrentFrame);
+      // The file encodes the frame on its own thread, so that compressing and deduplicating the
+      // recorded data doesn't hold up the video thread.
+      m_File->AddFrame(std::move(m_CurrentFrame));
 
       if (m_FinishedCb && m_RequestedRecordingEnd)
         m_FinishedCb();
     }
 
-    m_CurrentFrame.memoryUpdates.clear();
+    m_CurrentFrame = {};
     m_FifoData.clear();
     m_FrameEnded = false;
   }
@@ -254,10 +254,14 @@ void FreeLookController::UpdateInput(CameraControllerInput* camera_controller)
   // we need to invert the yaw and roll as well
   const Common::Vec3 gyro_motion_rad_velocity_converted{
       gyro_motion_rad_velocity.x, gyro_motion_rad_velocity.z * -1, gyro_motion_rad_velocity.y * -1};
-  const auto gyro_motion_quat =
-      Common::Quaternion::RotateXYZ(gyro_motion_rad_velocity_converted * dt);
+  if (gyro_motion_rad_velocity_converted.Length() != 0)
+  {
+    const auto gyro_motion_quat =
+        Common::Quaternion::RotateXYZ(gyro_motion_rad_velocity_converted * dt);
+
+    camera_controller->Rotate(gyro_motion_quat);
+  }
 
-  camera_controller->Rotate(gyro_motion_quat);
   if (m_move_buttons->controls[MoveButtons::Up]->GetState<bool>())
     camera_controller->MoveVertical(-camera_controller->GetSpeed() * dt);
 
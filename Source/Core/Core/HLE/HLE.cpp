@@ -20,6 +20,8 @@
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
 
+#include "VideoCommon/FrameTimeline.h"
+
 namespace HLE
 {
 // Map addresses to the HLE hook index
@@ -152,6 +154,7 @@ void Execute(u32 current_pc, u32 hook_index)
   hook_index &= 0xFFFFF;
   if (hook_index > 0 && hook_index < os_patches.size())
   {
+    VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::MMIOAndHLE);
     os_patches[hook_index].function();
   }
   else
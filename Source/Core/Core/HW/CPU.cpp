@@ -16,6 +16,7 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameTimeline.h"
 
 namespace CPU
 {
@@ -123,7 +124,10 @@ void Run()
       }
 
       // Enter a fast runloop
-      PowerPC::RunLoop();
+      {
+        VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::JitExecution);
+        PowerPC::RunLoop();
+      }
 
       state_lock.lock();
       s_state_cpu_thread_active = false;
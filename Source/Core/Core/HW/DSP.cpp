@@ -23,6 +23,8 @@
 
 #include "Core/HW/DSP.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "AudioCommon/AudioCommon.h"
@@ -556,7 +558,8 @@ static void Do_ARAM_DMA()
   int ticksToTransfer = (state.aram_dma.Cnt.count / 32) * 246;
   CoreTiming::ScheduleEvent(ticksToTransfer, state.event_type_complete_aram);
 
-  // Real hardware DMAs in 32byte chunks, but we can get by with 8byte chunks
+  // Real hardware DMAs in 32byte chunks, but the timing is handled by the completion event, so
+  // the data can be copied all at once.
   if (state.aram_dma.Cnt.dir)
   {
     // ARAM -> MRAM
@@ -569,29 +572,17 @@ static void Do_ARAM_DMA()
 
     if (state.aram_dma.ARAddr < state.aram.size)
     {
+      // Reads are the same for all the memory maps (see below in the write section for more
+      // information), so the transfer is copied in one go, split only where ARAM wraps around.
       while (state.aram_dma.Cnt.count)
       {
-        // These are logically separated in code to show that a memory map has been set up
-        // See below in the write section for more information
-        if ((state.aram_info.Hex & 0xf) == 3)
-        {
-          Memory::Write_U64_Swap(*(u64*)&state.aram.ptr[state.aram_dma.ARAddr & state.aram.mask],
-                                 state.aram_dma.MMAddr);
-        }
-        else if ((state.aram_info.Hex & 0xf) == 4)
-        {
-          Memory::Write_U64_Swap(*(u64*)&state.aram.ptr[state.aram_dma.ARAddr & state.aram.mask],
-                                 state.aram_dma.MMAddr);
-        }
-        else
-        {
-          Memory::Write_U64_Swap(*(u64*)&state.aram.ptr[state.aram_dma.ARAddr & state.aram.mask],
-                                 state.aram_dma.MMAddr);
-        }
+        const u32 offset = state.aram_dma.ARAddr & state.aram.mask;
+        const u32 length = std::min<u32>(state.aram_dma.Cnt.count, state.aram.mask + 1 - offset);
+        Memory::DMAToEmu(state.aram_dma.MMAddr, &state.aram.ptr[offset], length);
 
-        state.aram_dma.MMAddr += 8;
-        state.aram_dma.ARAddr += 8;
-        state.aram_dma.Cnt.count -= 8;
+        state.aram_dma.MMAddr += length;
+        state.aram_dma.ARAddr += length;
+        state.aram_dma.Cnt.count -= length;
       }
     }
     else if (!state.aram.wii_mode)
@@ -617,32 +608,28 @@ static void Do_ARAM_DMA()
 
     if (state.aram_dma.ARAddr < state.aram.size)
     {
+      // The transfer is copied in chunks that end where ARAM wraps around, and where the mirrored
+      // writes of memory map 4 stop.
+      const bool mirror_low_4mb = (state.aram_info.Hex & 0xf) == 4;
       while (state.aram_dma.Cnt.count)
       {
-        if ((state.aram_info.Hex & 0xf) == 3)
-        {
-          *(u64*)&state.aram.ptr[state.aram_dma.ARAddr & state.aram.mask] =
-              Common::swap64(Memory::Read_U64(state.aram_dma.MMAddr));
-        }
-        else if ((state.aram_info.Hex & 0xf) == 4)
-        {
-          if (state.aram_dma.ARAddr < 0x400000)
-          {
-            *(u64*)&state.aram.ptr[(state.aram_dma.ARAddr + 0x400000) & state.aram.mask] =
-                Common::swap64(Memory::Read_U64(state.aram_dma.MMAddr));
-          }
-          *(u64*)&state.aram.ptr[state.aram_dma.ARAddr & state.aram.mask] =
-              Common::swap64(Memory::Read_U64(state.aram_dma.MMAddr));
-        }
-        else
+        const u32 offset = state.aram_dma.ARAddr & state.aram.mask;
+        u32 length = std::min<u32>(state.aram_dma.Cnt.count, state.aram.mask + 1 - offset);
+
+        const bool mirrored = mirror_low_4mb && state.aram_dma.ARAddr < 0x400000;
+        if (mirrored)
+          length = std::min<u32>(length, 0x400000 - state.aram_dma.ARAddr);
+
+        Memory::DMAFromEmu(&state.aram.ptr[offset], state.aram_dma.MMAddr, length);
+        if (mirrored)
         {
-          *(u64*)&state.aram.ptr[state.aram_dma.ARAddr & state.aram.mask] =
-              Common::swap64(Memory::Read_U64(state.aram_dma.MMAddr));
+          const u32 mirror_offset = (state.aram_dma.ARAddr + 0x400000) & state.aram.mask;
+          std::memcpy(&state.aram.ptr[mirror_offset], &state.aram.ptr[offset], length);
         }
 
-        state.aram_dma.MMAddr += 8;
-        state.aram_dma.ARAddr += 8;
-        state.aram_dma.Cnt.count -= 8;
+        state.aram_dma.MMAddr += length;
+        state.aram_dma.ARAddr += length;
+        state.aram_dma.Cnt.count -= length;
       }
     }
     else if (!state.aram.wii_mode)
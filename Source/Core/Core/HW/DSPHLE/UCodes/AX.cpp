@@ -15,6 +15,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -30,6 +31,10 @@ namespace DSP::HLE
 AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc)
 {
   INFO_LOG_FMT(DSPHLE, "Instantiating AXUCode: crc={:08x}", crc);
+
+  const int voice_threads = std::clamp(Config::Get(Config::MAIN_DSP_HLE_VOICE_THREADS), 0, 16);
+  if (voice_threads != 0)
+    m_voice_threads.Reset(voice_threads, "AX Voice");
 }
 
 void AXUCode::Initialize()
@@ -404,16 +409,12 @@ void AXUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPB pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
-
-    ReadPB(pb_addr, pb, m_crc);
+  const AXBuffers output = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                             m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                             m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
 
+  // Called from the voice threads, so it may only change the PB and the buffers.
+  const auto process_pb = [this](AXPB& pb, AXBuffers buffers) {
     u32 updates_addr = HILO_TO_32(pb.updates.data);
     u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
 
@@ -428,7 +429,17 @@ void AXUCode::ProcessPBList(u32 pb_addr)
       for (auto& ptr : buffers.ptrs)
         ptr += spms;
     }
+  };
 
+  if (ProcessPBListParallel(m_voice_threads, pb_addr, m_crc, output, process_pb))
+    return;
+
+  AXPB pb;
+
+  while (pb_addr)
+  {
+    ReadPB(pb_addr, pb, m_crc);
+    process_pb(pb, output);
     WritePB(pb_addr, pb, m_crc);
     pb_addr = HILO_TO_32(pb.next_pb);
   }
@@ -17,6 +17,7 @@
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 #include "Core/HW/Memmap.h"
 
@@ -99,6 +100,9 @@ protected:
 
   u16 m_compressor_pos = 0;
 
+  // Processes the voices of a frame in parallel, if enabled.
+  Common::ThreadPool m_voice_threads;
+
   bool LoadResamplingCoefficients(bool require_same_checksum, u32 desired_checksum);
 
   // Copy a command list from memory to our temp buffer
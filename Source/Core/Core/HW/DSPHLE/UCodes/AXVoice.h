@@ -12,10 +12,14 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
+#include "Common/ThreadPool.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -23,6 +27,10 @@
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace DSP::HLE
 {
 #ifdef AX_GC
@@ -145,8 +153,8 @@ void WritePB(u32 addr, const PB_TYPE& pb, u32 crc)
   }
 }
 
-// Simulated accelerator state.
-static PB_TYPE* acc_pb;
+// Simulated accelerator state. Every thread processing voices has its own.
+static thread_local PB_TYPE* acc_pb;
 
 class HLEAccelerator final : public Accelerator
 {
@@ -184,7 +192,8 @@ protected:
   void WriteMemory(u32 address, u8 value) override { WriteARAM(value, address); }
 };
 
-static std::unique_ptr<Accelerator> s_accelerator = std::make_unique<HLEAccelerator>();
+static thread_local std::unique_ptr<Accelerator> s_accelerator =
+    std::make_unique<HLEAccelerator>();
 
 // Sets up the simulated accelerator.
 void AcceleratorSetup(PB_TYPE* pb)
@@ -347,9 +356,26 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+
+  // ResampleAudio reads the input samples in order, so they can be read from the accelerator
+  // up front, which lets it decode whole ADPCM frames at once.
+  const u32 ratio = HILO_TO_32(pb.src.ratio);
+  const u64 input_count = (pb.src_type == SRCTYPE_LINEAR || pb.src_type == SRCTYPE_POLYPHASE) ?
+                              (pb.src.cur_addr_frac + u64(count) * ratio) >> 16 :
+                              count;
+  std::array<s16, 0x400> input;
+  u32 curr_pos;
+  if (input_count <= input.size() && ratio < 0x10000 * 0x100)
+  {
+    s_accelerator->ReadSamples(acc_pb->adpcm.coefs, input.data(), input_count);
+    curr_pos = ResampleAudio([&input](u32 i) { return input[i]; }, samples, count,
+                             pb.src.last_samples, pb.src.cur_addr_frac, ratio, pb.src_type, coeffs);
+  }
+  else
+  {
+    curr_pos = ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count,
+                             pb.src.last_samples, pb.src.cur_addr_frac, ratio, pb.src_type, coeffs);
+  }
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -372,17 +398,82 @@ void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bo
   if (!ramp)
     volume_delta = 0;
 
-  for (u32 i = 0; i < count; ++i)
+  // The product of a sample and an unsigned 16 bit volume always fits in 32 bits.
+  const auto mix_sample = [](s16 sample, u16 sample_volume) {
+    const s32 scaled = (s32(sample) * s32(sample_volume)) >> 15;
+    return static_cast<s16>(std::clamp(scaled, -32767, 32767));  // -32768 ?
+  };
+
+  // Mix 8 samples at a time. The volumes of the lanes are kept in a vector and wrap around like
+  // the scalar volume does.
+  u32 i = 0;
+#if defined(_M_X86)
+  __m128i volumes =
+      _mm_add_epi16(_mm_set1_epi16(static_cast<s16>(volume)),
+                    _mm_mullo_epi16(_mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7),
+                                    _mm_set1_epi16(static_cast<s16>(volume_delta))));
+  const __m128i volume_step = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+  for (; i + 8 <= count; i += 8)
   {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+
+    // SSE2 only has a signed high multiply, so correct it for volumes with the top bit set.
+    const __m128i product_lo = _mm_mullo_epi16(samples, volumes);
+    const __m128i product_hi = _mm_add_epi16(_mm_mulhi_epi16(samples, volumes),
+                                             _mm_and_si128(samples, _mm_srai_epi16(volumes, 15)));
+    const __m128i scaled_lo = _mm_srai_epi32(_mm_unpacklo_epi16(product_lo, product_hi), 15);
+    const __m128i scaled_hi = _mm_srai_epi32(_mm_unpackhi_epi16(product_lo, product_hi), 15);
+    const __m128i mixed = _mm_max_epi16(_mm_packs_epi32(scaled_lo, scaled_hi), min_sample);
+
+    const __m128i mixed_sign = _mm_srai_epi16(mixed, 15);
+    __m128i* const out_vec = reinterpret_cast<__m128i*>(out + i);
+    _mm_storeu_si128(out_vec, _mm_add_epi32(_mm_loadu_si128(out_vec),
+                                            _mm_unpacklo_epi16(mixed, mixed_sign)));
+    _mm_storeu_si128(out_vec + 1, _mm_add_epi32(_mm_loadu_si128(out_vec + 1),
+                                                _mm_unpackhi_epi16(mixed, mixed_sign)));
+
+    volumes = _mm_add_epi16(volumes, volume_step);
+  }
+#elif defined(_M_ARM_64)
+  static constexpr u16 lane_index[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  uint16x8_t volumes =
+      vmlaq_n_u16(vdupq_n_u16(volume), vld1q_u16(lane_index), static_cast<u16>(volume_delta));
+  const uint16x8_t volume_step = vdupq_n_u16(static_cast<u16>(volume_delta * 8));
+  const int16x8_t min_sample = vdupq_n_s16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(input + i);
+
+    const int32x4_t product_lo =
+        vmulq_s32(vmovl_s16(vget_low_s16(samples)),
+                  vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(volumes))));
+    const int32x4_t product_hi =
+        vmulq_s32(vmovl_high_s16(samples), vreinterpretq_s32_u32(vmovl_high_u16(volumes)));
+    const int16x8_t mixed = vmaxq_s16(
+        vcombine_s16(vqshrn_n_s32(product_lo, 15), vqshrn_n_s32(product_hi, 15)), min_sample);
+
+    vst1q_s32(out + i, vaddw_s16(vld1q_s32(out + i), vget_low_s16(mixed)));
+    vst1q_s32(out + i + 4, vaddw_high_s16(vld1q_s32(out + i + 4), mixed));
 
-    out[i] += (s16)sample;
+    volumes = vaddq_u16(volumes, volume_step);
+  }
+#endif
+
+  if (i != 0)
+  {
+    volume += static_cast<u16>(volume_delta * i);
+    *dpop = mix_sample(input[i - 1], static_cast<u16>(volume - volume_delta));
+  }
+
+  for (; i < count; ++i)
+  {
+    const s16 sample = mix_sample(input[i], volume);
+
+    out[i] += sample;
     volume += volume_delta;
 
-    *dpop = (s16)sample;
+    *dpop = sample;
   }
 }
 
@@ -555,6 +646,105 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #endif
 }
 
+
+// Size of the mixing buffers of the ucode, in samples.
+#ifdef AX_GC
+constexpr u32 MIX_BUFFER_SIZE = 32 * 5;
+#else
+constexpr u32 MIX_BUFFER_SIZE = 32 * 3;
+#endif
+constexpr size_t NUM_MIX_BUFFERS = sizeof(AXBuffers::ptrs) / sizeof(AXBuffers::ptrs[0]);
+
+u32 GetMixBufferSize(size_t index)
+{
+#ifdef AX_WII
+  // The Wii Remote buffers come after the 12 main and aux buffers.
+  if (index >= 12)
+    return 6 * 3;
+#endif
+  return MIX_BUFFER_SIZE;
+}
+
+// Processes the voices of a PB list on the threads of the pool, calling process_pb(pb, buffers)
+// for every PB. Every thread mixes into buffers of its own, which are added to the output
+// afterwards. Integer additions can be done in any order, so this gives exactly the same result
+// as processing the voices one after another, independently of the scheduling.
+//
+// Returns false without changing anything if the list has to be processed in order.
+template <typename ProcessPB>
+bool ProcessPBListParallel(Common::ThreadPool& pool, u32 pb_addr, u32 crc, const AXBuffers& output,
+                           const ProcessPB& process_pb)
+{
+  // Waking up the threads costs more than processing a few voices.
+  constexpr size_t MIN_VOICES_PER_GROUP = 8;
+  // Longer lists are left to the sequential loop, which also covers lists which loop forever.
+  constexpr size_t MAX_VOICES = 0x1000;
+
+  if (pool.GetNumThreads() == 0)
+    return false;
+
+  std::vector<u32> addresses;
+  std::vector<PB_TYPE> pbs;
+  while (pb_addr)
+  {
+    if (pbs.size() == MAX_VOICES)
+      return false;
+
+    addresses.push_back(pb_addr);
+    ReadPB(pb_addr, pbs.emplace_back(), crc);
+    pb_addr = HILO_TO_32(pbs.back().next_pb);
+  }
+
+  const size_t num_groups = std::min(pbs.size() / MIN_VOICES_PER_GROUP, pool.GetNumThreads() + 1);
+  if (num_groups < 2)
+    return false;
+
+  // All PBs are read before any is written back, which is only the same if they don't overlap.
+  std::vector<u32> sorted_addresses = addresses;
+  std::sort(sorted_addresses.begin(), sorted_addresses.end());
+  for (size_t i = 1; i < sorted_addresses.size(); ++i)
+  {
+    if (sorted_addresses[i] - sorted_addresses[i - 1] < sizeof(PB_TYPE))
+      return false;
+  }
+
+  std::vector<int> group_samples(num_groups * NUM_MIX_BUFFERS * MIX_BUFFER_SIZE);
+  pool.RunParallel(num_groups, [&](size_t group) {
+    AXBuffers buffers;
+    for (size_t i = 0; i < NUM_MIX_BUFFERS; ++i)
+      buffers.ptrs[i] = &group_samples[(group * NUM_MIX_BUFFERS + i) * MIX_BUFFER_SIZE];
+
+    const size_t first = pbs.size() * group / num_groups;
+    const size_t last = pbs.size() * (group + 1) / num_groups;
+    for (size_t i = first; i < last; ++i)
+      process_pb(pbs[i], buffers);
+  });
+
+  // Updates applied while processing a voice can relink the list, which changes the voices
+  // processed after it.
+  for (size_t i = 0; i < pbs.size(); ++i)
+  {
+    const u32 next_addr = i + 1 < pbs.size() ? addresses[i + 1] : 0;
+    if (HILO_TO_32(pbs[i].next_pb) != next_addr)
+      return false;
+  }
+
+  for (size_t i = 0; i < pbs.size(); ++i)
+    WritePB(addresses[i], pbs[i], crc);
+
+  for (size_t group = 0; group < num_groups; ++group)
+  {
+    for (size_t i = 0; i < NUM_MIX_BUFFERS; ++i)
+    {
+      const int* samples = &group_samples[(group * NUM_MIX_BUFFERS + i) * MIX_BUFFER_SIZE];
+      for (u32 j = 0; j < GetMixBufferSize(i); ++j)
+        output.ptrs[i][j] += samples[j];
+    }
+  }
+
+  return true;
+}
+
 }  // namespace
 }  // inline namespace AXGC/AXWii
 }  // namespace DSP::HLE
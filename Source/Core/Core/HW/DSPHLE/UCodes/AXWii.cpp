@@ -414,20 +414,16 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPBWii pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
-                          m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
-                          m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
-                          m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
-                          m_samples_wm3,       m_samples_aux3}};
-
-    ReadPB(pb_addr, pb, m_crc);
-
+  const AXBuffers output = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                             m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                             m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
+                             m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
+                             m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
+                             m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
+                             m_samples_wm3,       m_samples_aux3}};
+
+  // Called from the voice threads, so it may only change the PB and the buffers.
+  const auto process_pb = [this](AXPBWii& pb, AXBuffers buffers) {
     u16 num_updates[3];
     u16 updates[1024];
     u32 updates_addr;
@@ -450,7 +446,17 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
       ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                    m_coeffs_checksum ? m_coeffs.data() : nullptr);
     }
+  };
+
+  if (ProcessPBListParallel(m_voice_threads, pb_addr, m_crc, output, process_pb))
+    return;
+
+  AXPBWii pb;
 
+  while (pb_addr)
+  {
+    ReadPB(pb_addr, pb, m_crc);
+    process_pb(pb, output);
     WritePB(pb_addr, pb, m_crc);
     pb_addr = HILO_TO_32(pb.next_pb);
   }
@@ -0,0 +1,366 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/ZeldaAudio.h"
+
+#include <algorithm>
+
+#include "Common/CommonTypes.h"
+
+#if defined(_M_X86)
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace DSP::HLE::ZeldaAudio
+{
+namespace Generic
+{
+void ApplyVolume(s16* buf, size_t count, u16 vol, u32 shift)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    s32 tmp = (u32)buf[i] * (u32)vol;
+    tmp >>= shift;
+
+    buf[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
+  }
+}
+
+s32 AddWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    dst[i] += ((vol >> 16) * src[i]) >> 16;
+    vol += step;
+  }
+
+  return vol;
+}
+
+void AddWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  while (count--)
+  {
+    s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
+    *dst++ += std::clamp(vol_src, -0x8000, 0x7FFF);
+  }
+}
+
+void Filter8Tap(s16* buf, size_t count, const s16* coeffs)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    s32 sample = 0;
+    for (size_t j = 0; j < 8; ++j)
+      sample += (s32)buf[i + j] * coeffs[j];
+    sample >>= 15;
+    buf[i] = std::clamp(sample, -0x8000, 0x7FFF);
+  }
+}
+
+u32 ResamplePolyphase(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                      const s16* coeffs)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    // We have 0x40 * 4 coeffs that need to be selected based on the
+    // most significant bits of the fractional part of the position. 12
+    // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
+    // consecutive coeffs.
+    const s16* phase_coeffs = &coeffs[((pos & 0xFFF) >> 6) * 4];
+    const s16* input = &src[pos >> 12];
+
+    s64 dst_sample_unclamped = 0;
+    for (size_t j = 0; j < 4; ++j)
+      dst_sample_unclamped += (s64)2 * phase_coeffs[j] * input[j];
+    dst_sample_unclamped >>= 16;
+
+    dst[i] = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
+
+    pos += ratio;
+  }
+
+  return pos;
+}
+}  // namespace Generic
+
+// The polyphase filter sums four products of two s16 in 64 bits, which doesn't fit the 32-bit
+// lanes. Splitting each product p into (p >> 15) * 0x8000 + (p & 0x7FFF) gives the same result
+// when both parts are summed separately: sum(p) >> 15 == sum(p >> 15) + (sum(p & 0x7FFF) >> 15),
+// and neither sum can overflow.
+
+#if defined(_M_X86)
+
+// Full 32-bit products of signed samples and an unsigned volume. SSE2 only has a signed high
+// multiply, so it is corrected for volumes with the top bit set.
+static inline void MultiplyByVolume(__m128i samples, __m128i vol, __m128i* lo, __m128i* hi)
+{
+  const __m128i product_lo = _mm_mullo_epi16(samples, vol);
+  const __m128i product_hi = _mm_add_epi16(_mm_mulhi_epi16(samples, vol),
+                                           _mm_and_si128(samples, _mm_srai_epi16(vol, 15)));
+  *lo = _mm_unpacklo_epi16(product_lo, product_hi);
+  *hi = _mm_unpackhi_epi16(product_lo, product_hi);
+}
+
+// Returns the sums of the lanes of a, b, c and d, in that order.
+static inline __m128i HorizontalSums(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+  const __m128i ab = _mm_add_epi32(_mm_unpacklo_epi32(a, b), _mm_unpackhi_epi32(a, b));
+  const __m128i cd = _mm_add_epi32(_mm_unpacklo_epi32(c, d), _mm_unpackhi_epi32(c, d));
+  return _mm_add_epi32(_mm_unpacklo_epi64(ab, cd), _mm_unpackhi_epi64(ab, cd));
+}
+
+void ApplyVolume(s16* buf, size_t count, u16 vol, u32 shift)
+{
+  const __m128i vol_vec = _mm_set1_epi16(static_cast<s16>(vol));
+  const __m128i shift_vec = _mm_cvtsi32_si128(static_cast<int>(shift));
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i* const ptr = reinterpret_cast<__m128i*>(buf + i);
+    __m128i lo, hi;
+    MultiplyByVolume(_mm_loadu_si128(ptr), vol_vec, &lo, &hi);
+    _mm_storeu_si128(ptr, _mm_packs_epi32(_mm_sra_epi32(lo, shift_vec),
+                                          _mm_sra_epi32(hi, shift_vec)));
+  }
+  Generic::ApplyVolume(buf + i, count - i, vol, shift);
+}
+
+s32 AddWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step)
+{
+  // The volume wraps around like the scalar one does.
+  const u32 uvol = static_cast<u32>(vol);
+  const u32 ustep = static_cast<u32>(step);
+  __m128i vol_lo =
+      _mm_setr_epi32(static_cast<s32>(uvol), static_cast<s32>(uvol + ustep),
+                     static_cast<s32>(uvol + ustep * 2), static_cast<s32>(uvol + ustep * 3));
+  const __m128i vol_step = _mm_set1_epi32(static_cast<s32>(ustep * 4));
+  __m128i vol_hi = _mm_add_epi32(vol_lo, vol_step);
+  const __m128i vol_step8 = _mm_add_epi32(vol_step, vol_step);
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    // vol >> 16 fits in s16, and the high half of the product is exactly the product >> 16.
+    const __m128i vol_int =
+        _mm_packs_epi32(_mm_srai_epi32(vol_lo, 16), _mm_srai_epi32(vol_hi, 16));
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i* const out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), _mm_mulhi_epi16(vol_int, samples)));
+
+    vol_lo = _mm_add_epi32(vol_lo, vol_step8);
+    vol_hi = _mm_add_epi32(vol_hi, vol_step8);
+  }
+  return Generic::AddWithVolumeRamp(dst + i, src + i, count - i,
+                                    static_cast<s32>(uvol + ustep * static_cast<u32>(i)), step);
+}
+
+void AddWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  const __m128i vol_vec = _mm_set1_epi16(static_cast<s16>(vol));
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i lo, hi;
+    MultiplyByVolume(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), vol_vec, &lo,
+                     &hi);
+    const __m128i scaled = _mm_packs_epi32(_mm_srai_epi32(lo, 15), _mm_srai_epi32(hi, 15));
+    __m128i* const out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), scaled));
+  }
+  Generic::AddWithVolume(dst + i, src + i, count - i, vol);
+}
+
+void Filter8Tap(s16* buf, size_t count, const s16* coeffs)
+{
+  const __m128i coeffs_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coeffs));
+  const auto filter = [&](size_t i) {
+    return _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i)), coeffs_vec);
+  };
+
+  // Each group of 4 output samples only reads input samples which haven't been overwritten yet.
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128i sums = HorizontalSums(filter(i), filter(i + 1), filter(i + 2), filter(i + 3));
+    const __m128i samples = _mm_srai_epi32(sums, 15);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(buf + i), _mm_packs_epi32(samples, samples));
+  }
+  Generic::Filter8Tap(buf + i, count - i, coeffs);
+}
+
+u32 ResamplePolyphase(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                      const s16* coeffs)
+{
+  const __m128i low_mask = _mm_set1_epi32(0x7FFF);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i input[4], phase_coeffs[4];
+    for (size_t j = 0; j < 4; ++j)
+    {
+      input[j] = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&src[pos >> 12]));
+      phase_coeffs[j] =
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&coeffs[((pos & 0xFFF) >> 6) * 4]));
+      pos += ratio;
+    }
+
+    __m128i products[4];
+    for (size_t j = 0; j < 4; j += 2)
+    {
+      const __m128i in = _mm_unpacklo_epi64(input[j], input[j + 1]);
+      const __m128i c = _mm_unpacklo_epi64(phase_coeffs[j], phase_coeffs[j + 1]);
+      const __m128i product_lo = _mm_mullo_epi16(in, c);
+      const __m128i product_hi = _mm_mulhi_epi16(in, c);
+      products[j] = _mm_unpacklo_epi16(product_lo, product_hi);
+      products[j + 1] = _mm_unpackhi_epi16(product_lo, product_hi);
+    }
+
+    const __m128i high_sums =
+        HorizontalSums(_mm_srai_epi32(products[0], 15), _mm_srai_epi32(products[1], 15),
+                       _mm_srai_epi32(products[2], 15), _mm_srai_epi32(products[3], 15));
+    const __m128i low_sums = HorizontalSums(
+        _mm_and_si128(products[0], low_mask), _mm_and_si128(products[1], low_mask),
+        _mm_and_si128(products[2], low_mask), _mm_and_si128(products[3], low_mask));
+    const __m128i samples = _mm_add_epi32(high_sums, _mm_srai_epi32(low_sums, 15));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(samples, samples));
+  }
+  return Generic::ResamplePolyphase(dst + i, count - i, src, pos, ratio, coeffs);
+}
+
+#elif defined(_M_ARM_64)
+
+// Returns the sums of the lanes of a, b, c and d, in that order.
+static inline int32x4_t HorizontalSums(int32x4_t a, int32x4_t b, int32x4_t c, int32x4_t d)
+{
+  return vpaddq_s32(vpaddq_s32(a, b), vpaddq_s32(c, d));
+}
+
+void ApplyVolume(s16* buf, size_t count, u16 vol, u32 shift)
+{
+  const int32x4_t shift_vec = vdupq_n_s32(-static_cast<s32>(shift));
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(buf + i);
+    const int32x4_t lo = vmulq_n_s32(vmovl_s16(vget_low_s16(samples)), vol);
+    const int32x4_t hi = vmulq_n_s32(vmovl_high_s16(samples), vol);
+    vst1q_s16(buf + i, vcombine_s16(vqmovn_s32(vshlq_s32(lo, shift_vec)),
+                                    vqmovn_s32(vshlq_s32(hi, shift_vec))));
+  }
+  Generic::ApplyVolume(buf + i, count - i, vol, shift);
+}
+
+s32 AddWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step)
+{
+  // The volume wraps around like the scalar one does.
+  const u32 uvol = static_cast<u32>(vol);
+  const u32 ustep = static_cast<u32>(step);
+  const u32 lane_vol[4] = {uvol, uvol + ustep, uvol + ustep * 2, uvol + ustep * 3};
+  int32x4_t vol_vec = vreinterpretq_s32_u32(vld1q_u32(lane_vol));
+  const int32x4_t vol_step = vdupq_n_s32(static_cast<s32>(ustep * 4));
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const int32x4_t scaled =
+        vshrq_n_s32(vmulq_s32(vshrq_n_s32(vol_vec, 16), vmovl_s16(vld1_s16(src + i))), 16);
+    vst1_s16(dst + i, vadd_s16(vld1_s16(dst + i), vmovn_s32(scaled)));
+
+    vol_vec = vaddq_s32(vol_vec, vol_step);
+  }
+  return Generic::AddWithVolumeRamp(dst + i, src + i, count - i,
+                                    static_cast<s32>(uvol + ustep * static_cast<u32>(i)), step);
+}
+
+void AddWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(src + i);
+    const int32x4_t lo = vmulq_n_s32(vmovl_s16(vget_low_s16(samples)), vol);
+    const int32x4_t hi = vmulq_n_s32(vmovl_high_s16(samples), vol);
+    const int16x8_t scaled = vcombine_s16(vqshrn_n_s32(lo, 15), vqshrn_n_s32(hi, 15));
+    vst1q_s16(dst + i, vaddq_s16(vld1q_s16(dst + i), scaled));
+  }
+  Generic::AddWithVolume(dst + i, src + i, count - i, vol);
+}
+
+void Filter8Tap(s16* buf, size_t count, const s16* coeffs)
+{
+  const int16x8_t coeffs_vec = vld1q_s16(coeffs);
+  const auto filter = [&](size_t i) {
+    const int16x8_t samples = vld1q_s16(buf + i);
+    return vmlal_high_s16(vmull_s16(vget_low_s16(samples), vget_low_s16(coeffs_vec)), samples,
+                          coeffs_vec);
+  };
+
+  // Each group of 4 output samples only reads input samples which haven't been overwritten yet.
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const int32x4_t sums = HorizontalSums(filter(i), filter(i + 1), filter(i + 2), filter(i + 3));
+    vst1_s16(buf + i, vqmovn_s32(vshrq_n_s32(sums, 15)));
+  }
+  Generic::Filter8Tap(buf + i, count - i, coeffs);
+}
+
+u32 ResamplePolyphase(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                      const s16* coeffs)
+{
+  const int32x4_t low_mask = vdupq_n_s32(0x7FFF);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    int32x4_t products[4];
+    for (size_t j = 0; j < 4; ++j)
+    {
+      products[j] =
+          vmull_s16(vld1_s16(&src[pos >> 12]), vld1_s16(&coeffs[((pos & 0xFFF) >> 6) * 4]));
+      pos += ratio;
+    }
+
+    const int32x4_t high_sums =
+        HorizontalSums(vshrq_n_s32(products[0], 15), vshrq_n_s32(products[1], 15),
+                       vshrq_n_s32(products[2], 15), vshrq_n_s32(products[3], 15));
+    const int32x4_t low_sums =
+        HorizontalSums(vandq_s32(products[0], low_mask), vandq_s32(products[1], low_mask),
+                       vandq_s32(products[2], low_mask), vandq_s32(products[3], low_mask));
+    vst1_s16(dst + i, vqmovn_s32(vsraq_n_s32(high_sums, low_sums, 15)));
+  }
+  return Generic::ResamplePolyphase(dst + i, count - i, src, pos, ratio, coeffs);
+}
+
+#else
+
+void ApplyVolume(s16* buf, size_t count, u16 vol, u32 shift)
+{
+  Generic::ApplyVolume(buf, count, vol, shift);
+}
+
+s32 AddWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step)
+{
+  return Generic::AddWithVolumeRamp(dst, src, count, vol, step);
+}
+
+void AddWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  Generic::AddWithVolume(dst, src, count, vol);
+}
+
+void Filter8Tap(s16* buf, size_t count, const s16* coeffs)
+{
+  Generic::Filter8Tap(buf, count, coeffs);
+}
+
+u32 ResamplePolyphase(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                      const s16* coeffs)
+{
+  return Generic::ResamplePolyphase(dst, count, src, pos, ratio, coeffs);
+}
+
+#endif
+}  // namespace DSP::HLE::ZeldaAudio
@@ -0,0 +1,46 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+// Sample processing stages of the Zelda UCode audio renderer. These are vectorized where the host
+// supports it; the results are bit for bit identical to the Generic versions, which mirror what
+// the UCode does.
+namespace DSP::HLE::ZeldaAudio
+{
+// Multiplies the samples by an unsigned volume, shifts the products right by the given amount and
+// clamps them to s16.
+void ApplyVolume(s16* buf, size_t count, u16 vol, u32 shift);
+
+// Adds src to dst with a volume in 16.16 format which changes by step after each sample. Returns
+// the volume after the last sample.
+s32 AddWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step);
+
+// Adds src to dst with a volume in 1.15 format, clamping the scaled samples to s16.
+void AddWithVolume(s16* dst, const s16* src, size_t count, u16 vol);
+
+// Applies an 8-tap FIR filter with coefficients in 1.15 format in place. buf has to hold count + 7
+// samples; output sample i is computed from the input samples i to i + 7.
+void Filter8Tap(s16* buf, size_t count, const s16* coeffs);
+
+// Resamples src into count samples using a 4-tap polyphase filter. pos and ratio are in 20.12
+// format, and the filter phase is selected by the 6 most significant bits of the fractional part
+// of the position. Returns the position after the last sample.
+u32 ResamplePolyphase(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                      const s16* coeffs);
+
+// Scalar reference implementations.
+namespace Generic
+{
+void ApplyVolume(s16* buf, size_t count, u16 vol, u32 shift);
+s32 AddWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step);
+void AddWithVolume(s16* dst, const s16* src, size_t count, u16 vol);
+void Filter8Tap(s16* buf, size_t count, const s16* coeffs);
+u32 ResamplePolyphase(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                      const s16* coeffs);
+}  // namespace Generic
+}  // namespace DSP::HLE::ZeldaAudio
@@ -3,6 +3,7 @@
 
 #include "Core/HW/DSPLLE/DSPLLE.h"
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -10,11 +11,11 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
-#include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/Thread.h"
+#include "Common/Timer.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -53,13 +54,44 @@ void DSPLLE::DoState(PointerWrap& p)
   p.Do(m_cycle_count);
 }
 
+// The CPU thread hands a slice to the DSP thread every few hundred microseconds, which is shorter
+// than the time it takes to wake a sleeping thread up. Both threads wait for each other by
+// yielding for a while before going to sleep, and only notify the other thread if it is asleep.
+constexpr int SPIN_ITERATIONS = 200;
+
+template <typename Predicate>
+static void SpinThenPark(std::atomic<u32>& value, std::atomic<bool>& parked, Predicate predicate)
+{
+  for (int i = 0; i < SPIN_ITERATIONS; ++i)
+  {
+    if (predicate(value.load()))
+      return;
+    Common::YieldCPU();
+  }
+
+  parked.store(true);
+  u32 current;
+  while (!predicate(current = value.load()))
+    value.wait(current);
+  parked.store(false);
+}
+
+static void Unpark(std::atomic<u32>& value, const std::atomic<bool>& parked)
+{
+  if (parked.load())
+    value.notify_one();
+}
+
 // Regular thread
 void DSPLLE::DSPThread(DSPLLE* dsp_lle)
 {
   Common::SetCurrentThreadName("DSP thread");
+  Core::PinCurrentThread(Core::HostCoreType::Performance);
 
   while (dsp_lle->m_is_running.IsSet())
   {
+    // Read before the cycle count, so that cycles added after it was read always wake us up.
+    const u32 wakeups = dsp_lle->m_dsp_wakeups.load();
     const int cycles = static_cast<int>(dsp_lle->m_cycle_count.load());
     if (cycles > 0)
     {
@@ -75,15 +107,22 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
           dsp_lle->m_dsp_core.GetInterpreter().RunCyclesThread(cycles);
         }
         dsp_lle->m_cycle_count.store(0);
+        Unpark(dsp_lle->m_cycle_count, dsp_lle->m_cpu_parked);
         continue;
       }
     }
 
-    dsp_lle->m_ppc_event.Set();
-    dsp_lle->m_dsp_event.Wait();
+    SpinThenPark(dsp_lle->m_dsp_wakeups, dsp_lle->m_dsp_parked,
+                 [wakeups](u32 value) { return value != wakeups; });
   }
 }
 
+void DSPLLE::WakeDSPThread()
+{
+  m_dsp_wakeups.fetch_add(1);
+  Unpark(m_dsp_wakeups, m_dsp_parked);
+}
+
 static bool LoadDSPRom(u16* rom, const std::string& filename, u32 size_in_bytes)
 {
   std::string bytes;
@@ -120,7 +159,7 @@ static bool FillDSPInitOptions(DSPInitOptions* opts)
     return false;
 
   opts->core_type = DSPInitOptions::CoreType::Interpreter;
-#ifdef _M_X86
+#if defined(_M_X86) || defined(_M_ARM_64)
   if (Config::Get(Config::MAIN_DSP_JIT))
     opts->core_type = DSPInitOptions::CoreType::JIT64;
 #endif
@@ -171,8 +210,7 @@ void DSPLLE::DSP_StopSoundStream()
     return;
 
   m_is_running.Clear();
-  m_ppc_event.Set();
-  m_dsp_event.Set();
+  WakeDSPThread();
   m_dsp_thread.join();
 }
 
@@ -276,13 +314,24 @@ void DSPLLE::DSP_Update(int cycles)
   }
   else
   {
-    // Wait for DSP thread to complete its cycle. Note: this logic should be thought through.
-    m_ppc_event.Wait();
+    // Wait for the DSP thread to complete the previous slice.
+    const u64 wait_start = Common::Timer::NowUs();
+    SpinThenPark(m_cycle_count, m_cpu_parked, [](u32 value) { return value == 0; });
+    m_wait_time_us.fetch_add(Common::Timer::NowUs() - wait_start, std::memory_order_relaxed);
+    m_wait_count.fetch_add(1, std::memory_order_relaxed);
+
     m_cycle_count.fetch_add(dsp_cycles);
-    m_dsp_event.Set();
+    WakeDSPThread();
   }
 }
 
+float DSPLLE::TakeThreadLatency()
+{
+  const u64 wait_time_us = m_wait_time_us.exchange(0, std::memory_order_relaxed);
+  const u32 wait_count = m_wait_count.exchange(0, std::memory_order_relaxed);
+  return wait_count != 0 ? static_cast<float>(wait_time_us) / wait_count : 0.0f;
+}
+
 u32 DSPLLE::DSP_UpdateRate()
 {
   return 12600;  // TO BE TWEAKED
@@ -301,8 +350,7 @@ void DSPLLE::PauseAndLock(bool do_lock, bool unpause_on_unlock)
     if (m_is_dsp_on_thread)
     {
       // Signal the DSP thread so it can perform any outstanding work now (if any)
-      m_ppc_event.Wait();
-      m_dsp_event.Set();
+      WakeDSPThread();
     }
   }
 }
@@ -37,19 +37,31 @@ public:
   void DSP_Update(int cycles) override;
   void DSP_StopSoundStream() override;
   u32 DSP_UpdateRate() override;
+  float TakeThreadLatency() override;
 
 private:
   static void DSPThread(DSPLLE* dsp_lle);
+  void WakeDSPThread();
 
   DSPCore m_dsp_core;
   std::thread m_dsp_thread;
   std::mutex m_dsp_thread_mutex;
   bool m_is_dsp_on_thread = false;
   Common::Flag m_is_running;
+  // Cycle budget handed to the DSP thread. The DSP thread sets it back to 0 once it has run the
+  // cycles, which is what the CPU thread waits for.
   std::atomic<u32> m_cycle_count{};
+  // Incremented to wake the DSP thread up: when cycles are added, when it is unpaused and when
+  // it has to stop.
+  std::atomic<u32> m_dsp_wakeups{};
+  // Whether each thread is sleeping and has to be notified, instead of spinning.
+  std::atomic<bool> m_cpu_parked{};
+  std::atomic<bool> m_dsp_parked{};
+
+  // Time the CPU thread spent waiting for the DSP thread, for the performance statistics.
+  std::atomic<u64> m_wait_time_us{};
+  std::atomic<u32> m_wait_count{};
 
-  Common::Event m_dsp_event;
-  Common::Event m_ppc_event;
   bool m_request_disable_thread = false;
 };
 }  // namespace DSP::LLE
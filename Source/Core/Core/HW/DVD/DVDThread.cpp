@@ -3,6 +3,8 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -32,6 +34,7 @@
 #include "Core/System.h"
 
 #include "DiscIO/Enums.h"
+#include "DiscIO/Filesystem.h"
 #include "DiscIO/Volume.h"
 
 namespace DVDThread
@@ -62,6 +65,30 @@ struct ReadRequest
 
 using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
 
+// When the emulated software starts reading a file, the rest of it is likely to be read soon,
+// often in small pieces (e.g. streamed audio). The DVD thread reads the rest of the file into a
+// buffer whenever it's idle, so that those reads don't each wait on slow storage.
+struct FilePrefetch
+{
+  DiscIO::Partition partition{};
+  u64 file_start = 0;
+  u64 file_end = 0;
+
+  // Data starting at buffer_offset. Data before consumed_until has already been read by the
+  // emulated software, and is discarded when more room is needed.
+  u64 buffer_offset = 0;
+  u64 consumed_until = 0;
+  std::vector<u8> buffer;
+
+  bool IsActive() const { return file_end != 0; }
+  u64 GetBufferEnd() const { return buffer_offset + buffer.size(); }
+};
+
+// Amount of data to keep read ahead of the emulated software.
+constexpr u64 PREFETCH_AHEAD_SIZE = 0x400000;
+// Amount of data to read at a time, so that new requests don't have to wait long.
+constexpr u64 PREFETCH_CHUNK_SIZE = 0x40000;
+
 static void StartDVDThread(DVDThreadState::Data& state);
 static void StopDVDThread(DVDThreadState::Data& state);
 
@@ -92,6 +119,9 @@ struct DVDThreadState::Data
   std::unique_ptr<DiscIO::Volume> disc;
 
   FileMonitor::FileLogger file_logger;
+
+  // Only accessed by the DVD thread, or while it's stopped.
+  FilePrefetch prefetch;
 };
 
 DVDThreadState::DVDThreadState() : m_data(std::make_unique<Data>())
@@ -130,6 +160,7 @@ void Stop()
   auto& state = Core::System::GetInstance().GetDVDThreadState().GetData();
   StopDVDThread(state);
   state.disc.reset();
+  state.prefetch = {};
 }
 
 static void StopDVDThread(DVDThreadState::Data& state)
@@ -197,6 +228,7 @@ void SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 
   WaitUntilIdle();
   state.disc = std::move(disc);
+  state.prefetch = {};
 }
 
 bool HasDisc()
@@ -388,7 +420,7 @@ static void FinishRead(Core::System& system, u64 id, s64 cycles_late)
   else
   {
     if (request.copy_to_ram)
-      Memory::CopyToEmu(request.output_address, buffer.data(), request.length);
+      Memory::DMAToEmu(request.output_address, buffer.data(), request.length);
 
     interrupt = DVDInterface::DIInterruptType::TCINT;
   }
@@ -397,6 +429,87 @@ static void FinishRead(Core::System& system, u64 id, s64 cycles_late)
   DVDInterface::FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
 }
 
+static bool ReadFromPrefetch(FilePrefetch& prefetch, const ReadRequest& request, u8* out_ptr)
+{
+  if (!prefetch.IsActive() || request.partition != prefetch.partition)
+    return false;
+
+  const u64 request_end = request.dvd_offset + request.length;
+  if (request.dvd_offset < prefetch.buffer_offset || request_end > prefetch.GetBufferEnd())
+  {
+    // If the software skipped ahead within the file, continue reading ahead from there.
+    if (request.dvd_offset >= prefetch.file_start && request_end < prefetch.file_end)
+    {
+      prefetch.buffer.clear();
+      prefetch.buffer_offset = request_end;
+      prefetch.consumed_until = request_end;
+    }
+    return false;
+  }
+
+  std::memcpy(out_ptr, prefetch.buffer.data() + (request.dvd_offset - prefetch.buffer_offset),
+              request.length);
+  prefetch.consumed_until = std::max(prefetch.consumed_until, request_end);
+  return true;
+}
+
+static void StartPrefetch(DVDThreadState::Data& state, const ReadRequest& request)
+{
+  const DiscIO::FileSystem* file_system = state.disc->GetFileSystem(request.partition);
+  if (!file_system)
+    return;
+
+  // Only the start of a file is a good sign that the rest of it will be read.
+  const std::unique_ptr<DiscIO::FileInfo> file_info =
+      file_system->FindFileInfo(request.dvd_offset);
+  if (!file_info || file_info->GetOffset() != request.dvd_offset)
+    return;
+
+  const u64 request_end = request.dvd_offset + request.length;
+  const u64 file_end = file_info->GetOffset() + file_info->GetSize();
+  if (file_end <= request_end)
+    return;
+
+  FilePrefetch& prefetch = state.prefetch;
+  prefetch.partition = request.partition;
+  prefetch.file_start = request.dvd_offset;
+  prefetch.file_end = file_end;
+  prefetch.buffer.clear();
+  prefetch.buffer_offset = request_end;
+  prefetch.consumed_until = request_end;
+}
+
+static bool HasPrefetchWork(const FilePrefetch& prefetch)
+{
+  return prefetch.IsActive() && prefetch.GetBufferEnd() < prefetch.file_end &&
+         prefetch.GetBufferEnd() - prefetch.consumed_until < PREFETCH_AHEAD_SIZE;
+}
+
+static void ContinuePrefetch(DVDThreadState::Data& state)
+{
+  FilePrefetch& prefetch = state.prefetch;
+  if (!HasPrefetchWork(prefetch))
+    return;
+
+  // Discard the data that has been read, once it's worth the cost of moving the rest.
+  const u64 consumed = prefetch.consumed_until - prefetch.buffer_offset;
+  if (consumed >= PREFETCH_AHEAD_SIZE)
+  {
+    prefetch.buffer.erase(prefetch.buffer.begin(), prefetch.buffer.begin() + consumed);
+    prefetch.buffer_offset = prefetch.consumed_until;
+  }
+
+  const u64 offset = prefetch.GetBufferEnd();
+  const u64 length = std::min(PREFETCH_CHUNK_SIZE, prefetch.file_end - offset);
+  const size_t old_size = prefetch.buffer.size();
+  prefetch.buffer.resize(old_size + length);
+  if (!state.disc->Read(offset, length, prefetch.buffer.data() + old_size, prefetch.partition))
+  {
+    // Leave the error to be reported when the emulated software reads this data.
+    prefetch = {};
+  }
+}
+
 static void DVDThread()
 {
   auto& state = Core::System::GetInstance().GetDVDThreadState().GetData();
@@ -405,7 +518,9 @@ static void DVDThread()
 
   while (true)
   {
-    state.request_queue_expanded.Wait();
+    // Only sleep when there is nothing to read ahead.
+    if (!HasPrefetchWork(state.prefetch))
+      state.request_queue_expanded.Wait();
 
     if (state.dvd_thread_exiting.IsSet())
       return;
@@ -416,8 +531,18 @@ static void DVDThread()
       state.file_logger.Log(*state.disc, request.partition, request.dvd_offset);
 
       std::vector<u8> buffer(request.length);
-      if (!state.disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
+      if (!ReadFromPrefetch(state.prefetch, request, buffer.data()))
+      {
+        if (state.disc->Read(request.dvd_offset, request.length, buffer.data(),
+                             request.partition))
+        {
+          StartPrefetch(state, request);
+        }
+        else
+        {
+          buffer.resize(0);
+        }
+      }
 
       request.realtime_done_us = Common::Timer::NowUs();
 
@@ -427,6 +552,8 @@ static void DVDThread()
       if (state.dvd_thread_exiting.IsSet())
         return;
     }
+
+    ContinuePrefetch(state);
   }
 }
 }  // namespace DVDThread
@@ -478,10 +478,17 @@ void Core::SendJoybusCommand(u64 gc_ticks, int transfer_time, u8* buffer, u16 ke
 
   if (m_thread)
   {
-    std::lock_guard<std::mutex> lock(m_queue_mutex);
-    m_command_queue.push(command);
-    m_idle = false;
-    m_command_cv.notify_one();
+    // The sync events alone queue a command every millisecond for each GBA. The thread only waits
+    // for commands when the queue is empty, so it only needs to be woken up then.
+    bool was_empty;
+    {
+      std::lock_guard<std::mutex> lock(m_queue_mutex);
+      was_empty = m_command_queue.empty();
+      m_command_queue.push(command);
+      m_idle = false;
+    }
+    if (was_empty)
+      m_command_cv.notify_one();
   }
   else
   {
@@ -528,8 +535,10 @@ void Core::ThreadLoop()
 
     queue_lock.lock();
     if (m_command_queue.empty())
+    {
       m_idle = true;
-    m_response_cv.notify_one();
+      m_response_cv.notify_one();
+    }
   }
 }
 
@@ -620,9 +620,17 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
 
 void GCMemcardDirectory::FlushToFile()
 {
+  // The saves which need to be written are copied while holding the lock, and written once it's
+  // released, so that a game which keeps saving doesn't have to wait for the disk.
+  struct PendingWrite
+  {
+    std::string filename;
+    Memcard::DEntry header;
+    std::vector<Memcard::GCMBlock> blocks;
+  };
+  std::vector<PendingWrite> pending_writes;
+
   std::unique_lock l(m_write_mutex);
-  int errors = 0;
-  Memcard::DEntry invalid;
   for (Memcard::GCIFile& save : m_saves)
   {
     if (save.m_dirty)
@@ -658,25 +666,7 @@ void GCMemcardDirectory::FlushToFile()
           }
           save.m_filename = default_save_name;
         }
-        File::IOFile gci(save.m_filename, "wb");
-        if (gci)
-        {
-          gci.WriteBytes(&save.m_gci_header, Memcard::DENTRY_SIZE);
-          for (const Memcard::GCMBlock& block : save.m_save_data)
-            gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
-
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage(fmt::format("Wrote save contents to {}", save.m_filename), 4000);
-          }
-          else
-          {
-            ++errors;
-            Core::DisplayMessage(
-                fmt::format("Failed to write save contents to {}", save.m_filename), 4000);
-            ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", save.m_filename);
-          }
-        }
+        pending_writes.push_back({save.m_filename, save.m_gci_header, save.m_save_data});
       }
       else if (save.m_filename.length() != 0)
       {
@@ -704,6 +694,29 @@ void GCMemcardDirectory::FlushToFile()
       save.m_save_data.clear();
     }
   }
+  l.unlock();
+
+  for (const PendingWrite& write : pending_writes)
+  {
+    File::IOFile gci(write.filename, "wb");
+    if (!gci)
+      continue;
+
+    gci.WriteBytes(&write.header, Memcard::DENTRY_SIZE);
+    for (const Memcard::GCMBlock& block : write.blocks)
+      gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
+
+    if (gci.IsGood())
+    {
+      Core::DisplayMessage(fmt::format("Wrote save contents to {}", write.filename), 4000);
+    }
+    else
+    {
+      Core::DisplayMessage(fmt::format("Failed to write save contents to {}", write.filename),
+                           4000);
+      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", write.filename);
+    }
+  }
 #if _WRITE_MC_HEADER
   u8 mc[BLOCK_SIZE * MC_FST_BLOCKS];
   Read(0, BLOCK_SIZE * MC_FST_BLOCKS, mc);
@@ -190,6 +190,11 @@ WriteHandlingMethod<T>* InvalidWrite()
 // Converters to larger and smaller size. Probably the most complex of these
 // handlers to implement. They do not define new handling method types but
 // instead will internally use the types defined above.
+//
+// When the handlers they combine are simple enough, they are folded into a
+// single Constant, Nop or Direct handler that the JITs can inline. Direct
+// handlers are only folded when the host layout of the values they point to
+// matches the combined access, which assumes a little endian host.
 template <typename T>
 struct SmallerAccessSize
 {
@@ -220,15 +225,97 @@ struct LargerAccessSize<u16>
   typedef u32 value;
 };
 
+// Visitors recording which handling method a handler uses.
+template <typename T>
+class ReadMethodInfo : public ReadHandlingMethodVisitor<T>
+{
+public:
+  enum class Kind
+  {
+    Constant,
+    Direct,
+    Complex,
+  };
+
+  void VisitConstant(T value) override
+  {
+    kind = Kind::Constant;
+    this->value = value;
+  }
+  void VisitDirect(const T* addr, u32 mask) override
+  {
+    kind = Kind::Direct;
+    this->addr = addr;
+    this->mask = mask;
+  }
+  void VisitComplex(const std::function<T(Core::System&, u32)>*) override
+  {
+    kind = Kind::Complex;
+  }
+
+  Kind kind = Kind::Complex;
+  T value = 0;
+  const T* addr = nullptr;
+  u32 mask = 0;
+};
+
+template <typename T>
+class WriteMethodInfo : public WriteHandlingMethodVisitor<T>
+{
+public:
+  enum class Kind
+  {
+    Nop,
+    Direct,
+    Complex,
+  };
+
+  void VisitNop() override { kind = Kind::Nop; }
+  void VisitDirect(T* addr, u32 mask) override
+  {
+    kind = Kind::Direct;
+    this->addr = addr;
+    this->mask = mask;
+  }
+  void VisitComplex(const std::function<void(Core::System&, u32, T)>*) override
+  {
+    kind = Kind::Complex;
+  }
+
+  Kind kind = Kind::Complex;
+  T* addr = nullptr;
+  u32 mask = 0;
+};
+
 template <typename T>
 ReadHandlingMethod<T>* ReadToSmaller(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
 {
   typedef typename SmallerAccessSize<T>::value ST;
+  using Kind = typename ReadMethodInfo<ST>::Kind;
+  constexpr u32 bits = 8 * sizeof(ST);
+  constexpr u32 part_mask = (1u << bits) - 1;
 
   ReadHandler<ST>* high_part = &mmio->GetHandlerForRead<ST>(high_part_addr);
   ReadHandler<ST>* low_part = &mmio->GetHandlerForRead<ST>(low_part_addr);
 
-  // TODO(delroth): optimize
+  ReadMethodInfo<ST> high_info, low_info;
+  high_part->Visit(high_info);
+  low_part->Visit(low_info);
+
+  if (high_info.kind == Kind::Constant && low_info.kind == Kind::Constant)
+  {
+    const u32 value = (static_cast<u32>(high_info.value) << bits) | low_info.value;
+    return Constant<T>(static_cast<T>(value));
+  }
+
+  if (high_info.kind == Kind::Direct && low_info.kind == Kind::Direct &&
+      high_info.addr == low_info.addr + 1 &&
+      reinterpret_cast<uintptr_t>(low_info.addr) % sizeof(T) == 0)
+  {
+    const u32 mask = ((high_info.mask & part_mask) << bits) | (low_info.mask & part_mask);
+    return DirectRead<T>(reinterpret_cast<const T*>(low_info.addr), mask);
+  }
+
   return ComplexRead<T>([=](Core::System& system, u32 addr) {
     return ((T)high_part->Read(system, high_part_addr) << (8 * sizeof(ST))) |
            low_part->Read(system, low_part_addr);
@@ -240,10 +327,28 @@ WriteHandlingMethod<T>* WriteToSmaller(Mapping* mmio, u32 high_part_addr, u32 lo
 {
   typedef typename SmallerAccessSize<T>::value ST;
 
+  using Kind = typename WriteMethodInfo<ST>::Kind;
+  constexpr u32 bits = 8 * sizeof(ST);
+  constexpr u32 part_mask = (1u << bits) - 1;
+
   WriteHandler<ST>* high_part = &mmio->GetHandlerForWrite<ST>(high_part_addr);
   WriteHandler<ST>* low_part = &mmio->GetHandlerForWrite<ST>(low_part_addr);
 
-  // TODO(delroth): optimize
+  WriteMethodInfo<ST> high_info, low_info;
+  high_part->Visit(high_info);
+  low_part->Visit(low_info);
+
+  if (high_info.kind == Kind::Nop && low_info.kind == Kind::Nop)
+    return Nop<T>();
+
+  if (high_info.kind == Kind::Direct && low_info.kind == Kind::Direct &&
+      high_info.addr == low_info.addr + 1 &&
+      reinterpret_cast<uintptr_t>(low_info.addr) % sizeof(T) == 0)
+  {
+    const u32 mask = ((high_info.mask & part_mask) << bits) | (low_info.mask & part_mask);
+    return DirectWrite<T>(reinterpret_cast<T*>(low_info.addr), mask);
+  }
+
   return ComplexWrite<T>([=](Core::System& system, u32 addr, T val) {
     high_part->Write(system, high_part_addr, val >> (8 * sizeof(ST)));
     low_part->Write(system, low_part_addr, (ST)val);
@@ -255,9 +360,22 @@ ReadHandlingMethod<T>* ReadToLarger(Mapping* mmio, u32 larger_addr, u32 shift)
 {
   typedef typename LargerAccessSize<T>::value LT;
 
+  using Kind = typename ReadMethodInfo<LT>::Kind;
+
   ReadHandler<LT>* large = &mmio->GetHandlerForRead<LT>(larger_addr);
 
-  // TODO(delroth): optimize
+  ReadMethodInfo<LT> info;
+  large->Visit(info);
+
+  if (info.kind == Kind::Constant)
+    return Constant<T>(static_cast<T>(info.value >> shift));
+
+  if (info.kind == Kind::Direct && shift % 8 == 0 && shift + 8 * sizeof(T) <= 8 * sizeof(LT))
+  {
+    const u8* addr = reinterpret_cast<const u8*>(info.addr) + shift / 8;
+    return DirectRead<T>(reinterpret_cast<const T*>(addr), info.mask >> shift);
+  }
+
   return ComplexRead<T>([large, shift](Core::System& system, u32 addr) {
     return large->Read(system, addr & ~(sizeof(LT) - 1)) >> shift;
   });
@@ -5,6 +5,7 @@
 
 #include <functional>
 #include <memory>
+#include <type_traits>
 
 #include "Common/CommonTypes.h"
 
@@ -59,6 +60,27 @@ ReadHandlingMethod<T>* ComplexRead(std::function<T(Core::System&, u32)>);
 template <typename T>
 WriteHandlingMethod<T>* ComplexWrite(std::function<void(Core::System&, u32, T)>);
 
+// Lambdas without captures are stored as plain function pointers, which the
+// JITs can call directly instead of going through the std::function.
+template <typename T, typename F,
+          std::enable_if_t<std::is_empty_v<F> && std::is_default_constructible_v<F> &&
+                           std::is_invocable_r_v<T, F, Core::System&, u32>>* = nullptr>
+ReadHandlingMethod<T>* ComplexRead(F)
+{
+  using Function = T (*)(Core::System&, u32);
+  return ComplexRead<T>(std::function<T(Core::System&, u32)>(static_cast<Function>(
+      [](Core::System& system, u32 addr) -> T { return F{}(system, addr); })));
+}
+template <typename T, typename F,
+          std::enable_if_t<std::is_empty_v<F> && std::is_default_constructible_v<F> &&
+                           std::is_invocable_v<F, Core::System&, u32, T>>* = nullptr>
+WriteHandlingMethod<T>* ComplexWrite(F)
+{
+  using Function = void (*)(Core::System&, u32, T);
+  return ComplexWrite<T>(std::function<void(Core::System&, u32, T)>(static_cast<Function>(
+      [](Core::System& system, u32 addr, T val) { F{}(system, addr, val); })));
+}
+
 // Invalid: log an error and return -1 in case of a read. These are the default
 // handlers set for all MMIO types.
 template <typename T>
@@ -10,10 +10,12 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <memory>
 #include <tuple>
 
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -51,6 +53,8 @@ u8* physical_page_mappings_base = nullptr;
 u8* logical_page_mappings_base = nullptr;
 static bool is_fastmem_arena_initialized = false;
 
+static std::atomic<u64> s_dma_byte_count{0};
+
 // The MemArena class
 static Common::MemArena g_arena;
 // ==============
@@ -267,6 +271,7 @@ void Init()
 #endif
 
   u32 mem_size = 0;
+  const bool huge_pages = Config::Get(Config::MAIN_HUGE_PAGES);
   for (PhysicalMemoryRegion& region : s_physical_regions)
   {
     if (!wii && (region.flags & PhysicalMemoryRegion::WII_ONLY))
@@ -274,11 +279,16 @@ void Init()
     if (!fake_vmem && (region.flags & PhysicalMemoryRegion::FAKE_VMEM))
       continue;
 
+    // Huge pages can only back the parts of a view that are aligned alike in the segment and in
+    // the address space, and the regions are mapped at aligned addresses.
+    if (huge_pages)
+      mem_size = Common::AlignUp(mem_size, Common::MemArena::HUGE_PAGE_SIZE);
+
     region.shm_position = mem_size;
     region.active = true;
     mem_size += region.size;
   }
-  g_arena.GrabSHMSegment(mem_size);
+  g_arena.GrabSHMSegment(mem_size, huge_pages);
 
   s_physical_page_mappings.fill(nullptr);
 
@@ -582,6 +592,23 @@ void Memset(u32 address, u8 value, size_t size)
   memset(pointer, value, size);
 }
 
+void DMAToEmu(u32 address, const void* data, size_t size)
+{
+  s_dma_byte_count.fetch_add(size, std::memory_order_relaxed);
+  CopyToEmu(address, data, size);
+}
+
+void DMAFromEmu(void* data, u32 address, size_t size)
+{
+  s_dma_byte_count.fetch_add(size, std::memory_order_relaxed);
+  CopyFromEmu(data, address, size);
+}
+
+u64 TakeDMAByteCount()
+{
+  return s_dma_byte_count.exchange(0, std::memory_order_relaxed);
+}
+
 std::string GetString(u32 em_address, size_t size)
 {
   const char* ptr = reinterpret_cast<const char*>(GetPointer(em_address));
@@ -79,6 +79,14 @@ u8* GetPointerForRange(u32 address, size_t size);
 void CopyFromEmu(void* data, u32 address, size_t size);
 void CopyToEmu(u32 address, const void* data, size_t size);
 void Memset(u32 address, u8 value, size_t size);
+
+// Bulk transfers done by the DMA engines of the emulated hardware. These copy the whole range at
+// once like CopyToEmu/CopyFromEmu, and count the bytes moved for the performance statistics.
+void DMAToEmu(u32 address, const void* data, size_t size);
+void DMAFromEmu(void* data, u32 address, size_t size);
+// Returns the number of bytes moved by DMAToEmu/DMAFromEmu since the last call.
+u64 TakeDMAByteCount();
+
 u8 Read_U8(u32 address);
 u16 Read_U16(u32 address);
 u32 Read_U32(u32 address);
@@ -18,6 +18,7 @@
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/ProcessorInterface.h"
@@ -104,6 +105,8 @@ struct SSIChannel
   std::unique_ptr<ISIDevice> device;
 
   bool has_recent_device_change = false;
+  // Set when the inputs latched by the last poll should be sampled again once they are read.
+  bool late_latch_pending = false;
 };
 
 // SI Poll: Controls how often a device is polled
@@ -214,6 +217,9 @@ struct SerialInterfaceState::Data
   USIStatusReg status_reg;
   USIEXIClockCount exi_clock_count;
   std::array<u8, 128> si_buffer;
+
+  // Whether the host inputs have to be updated before the next late latch.
+  bool late_latch_input_stale = false;
 };
 
 SerialInterfaceState::SerialInterfaceState() : m_data(std::make_unique<Data>())
@@ -250,6 +256,31 @@ static void ChangeDeviceCallback(Core::System& system, u64 user_data, s64 cycles
   state.channel[user_data].has_recent_device_change = false;
 }
 
+static bool IsLateLatchSupported(SIDevices type)
+{
+  return type == SIDEVICE_GC_CONTROLLER || type == SIDEVICE_WIIU_ADAPTER;
+}
+
+// Samples the inputs of a controller again when the game reads them. The poll that latched them
+// may have happened most of a frame earlier, depending on how the game set up SI polling.
+static void LateLatch(Core::System& system, int channel)
+{
+  auto& state = system.GetSerialInterfaceState().GetData();
+  SSIChannel& si_channel = state.channel[channel];
+  if (!si_channel.late_latch_pending)
+    return;
+  si_channel.late_latch_pending = false;
+
+  if (state.late_latch_input_stale)
+  {
+    g_controller_interface.SetCurrentInputChannel(ciface::InputChannel::SerialInterface);
+    g_controller_interface.UpdateInput();
+    state.late_latch_input_stale = false;
+  }
+
+  si_channel.device->GetData(si_channel.in_hi.hex, si_channel.in_lo.hex);
+}
+
 static void UpdateInterrupts()
 {
   // check if we have to update the RDSTINT flag
@@ -359,6 +390,8 @@ void DoState(PointerWrap& p)
     p.Do(state.channel[i].in_lo.hex);
     p.Do(state.channel[i].out.hex);
     p.Do(state.channel[i].has_recent_device_change);
+    if (p.IsReadMode())
+      state.channel[i].late_latch_pending = false;
 
     std::unique_ptr<ISIDevice>& device = state.channel[i].device;
     SIDevices type = device->GetDeviceType();
@@ -535,6 +568,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
     mmio->Register(base | (SI_CHANNEL_0_IN_HI + 0xC * i),
                    MMIO::ComplexRead<u32>([i, rdst_bit](Core::System& system, u32) {
                      auto& state = system.GetSerialInterfaceState().GetData();
+                     LateLatch(system, i);
                      state.status_reg.hex &= ~(1U << rdst_bit);
                      UpdateInterrupts();
                      return state.channel[i].in_hi.hex;
@@ -543,6 +577,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
     mmio->Register(base | (SI_CHANNEL_0_IN_LO + 0xC * i),
                    MMIO::ComplexRead<u32>([i, rdst_bit](Core::System& system, u32) {
                      auto& state = system.GetSerialInterfaceState().GetData();
+                     LateLatch(system, i);
                      state.status_reg.hex &= ~(1U << rdst_bit);
                      UpdateInterrupts();
                      return state.channel[i].in_lo.hex;
@@ -720,10 +755,23 @@ void UpdateDevices()
   // succession, in order to optimize networking
   NetPlay::SetSIPollBatching(true);
 
+  // Late latching samples the inputs again when the game reads them, which would give different
+  // results on every system, so it's only done when determinism isn't needed.
+  const bool late_latch =
+      Config::Get(Config::MAIN_INPUT_LATE_LATCHING) && !Core::WantsDeterminism();
+
   // Update inputs at the rate of SI
   // Typically 120hz but is variable
-  g_controller_interface.SetCurrentInputChannel(ciface::InputChannel::SerialInterface);
-  g_controller_interface.UpdateInput();
+  // With late latching, they are only updated once they are read.
+  if (late_latch)
+  {
+    state.late_latch_input_stale = true;
+  }
+  else
+  {
+    g_controller_interface.SetCurrentInputChannel(ciface::InputChannel::SerialInterface);
+    g_controller_interface.UpdateInput();
+  }
 
   // Update channels and set the status bit if there's new data
   state.status_reg.RDST0 =
@@ -735,6 +783,12 @@ void UpdateDevices()
   state.status_reg.RDST3 =
       !!state.channel[3].device->GetData(state.channel[3].in_hi.hex, state.channel[3].in_lo.hex);
 
+  for (SSIChannel& channel : state.channel)
+  {
+    channel.late_latch_pending =
+        late_latch && IsLateLatchSupported(channel.device->GetDeviceType());
+  }
+
   UpdateInterrupts();
 
   // Polling finished
@@ -63,9 +63,11 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/IOS/IOS.h"
+#include "Core/Movie.h"
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameTimeline.h"
 
 namespace SystemTimers
 {
@@ -179,7 +181,8 @@ void ThrottleCallback(Core::System& system, u64 deadline, s64 cyclesLate)
 
   const s64 diff = deadline - time;
   const float emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
-  const bool frame_limiter = emulation_speed > 0.0f && !Core::GetIsThrottlerTempDisabled();
+  const bool frame_limiter = emulation_speed > 0.0f && !Core::GetIsThrottlerTempDisabled() &&
+                             !Movie::IsFastPlayback();
   u32 next_event = GetTicksPerSecond() / 1000;
 
   {
@@ -202,6 +205,7 @@ void ThrottleCallback(Core::System& system, u64 deadline, s64 cyclesLate)
     }
     else if (diff > 1000)
     {
+      VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::Throttle);
       Common::SleepCurrentThread(diff / 1000);
       s_time_spent_sleeping += Common::Timer::NowUs() - time;
     }
@@ -279,6 +283,11 @@ double GetEstimatedEmulationPerformance()
   return delta_us == 0 ? DBL_MAX : emulated_us / delta_us;
 }
 
+u64 GetTimeSpentSleepingUs()
+{
+  return s_time_spent_sleeping;
+}
+
 // split from Init to break a circular dependency between VideoInterface::Init and
 // SystemTimers::Init
 void PreInit()
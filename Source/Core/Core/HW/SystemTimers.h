@@ -70,6 +70,10 @@ s64 GetLocalTimeRTCOffset();
 // - 2.0: the emulator is running at 200% speed (or 100% speed but sleeping half of the time).
 double GetEstimatedEmulationPerformance();
 
+// How long the CPU thread has slept to limit the emulation speed since the emulator started.
+// Only meaningful as a difference between two calls. CPU thread only.
+u64 GetTimeSpentSleepingUs();
+
 }  // namespace SystemTimers
 
 inline namespace SystemTimersLiterals
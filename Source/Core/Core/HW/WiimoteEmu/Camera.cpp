@@ -19,6 +19,7 @@ namespace WiimoteEmu
 void CameraLogic::Reset()
 {
   m_reg_data = {};
+  m_camera_data_valid = false;
 
   m_is_enabled = false;
 }
@@ -27,6 +28,9 @@ void CameraLogic::DoState(PointerWrap& p)
 {
   p.Do(m_reg_data);
 
+  if (p.IsReadMode())
+    m_camera_data_valid = false;
+
   // FYI: m_is_enabled is handled elsewhere.
 }
 
@@ -49,6 +53,7 @@ int CameraLogic::BusWrite(u8 slave_addr, u8 addr, int count, const u8* data_in)
   if (!m_is_enabled)
     return 0;
 
+  m_camera_data_valid = false;
   return RawWrite(&m_reg_data, addr, count, data_in);
 }
 
@@ -100,6 +105,16 @@ CameraLogic::GetCameraPoints(const Common::Matrix44& transform, Common::Vec2 fie
 
 void CameraLogic::Update(const std::array<CameraPoint, NUM_POINTS>& camera_points)
 {
+  const bool sensor_bar = bool(IOS::g_gpio_out[IOS::GPIO::SENSOR_BAR]);
+  if (m_camera_data_valid && m_last_sensor_bar == sensor_bar &&
+      m_last_camera_points == camera_points)
+  {
+    return;
+  }
+  m_last_camera_points = camera_points;
+  m_last_sensor_bar = sensor_bar;
+  m_camera_data_valid = true;
+
   // IR data is read from offset 0x37 on real hardware.
   auto& data = m_reg_data.camera_data;
   data.fill(0xff);
@@ -112,7 +127,7 @@ void CameraLogic::Update(const std::array<CameraPoint, NUM_POINTS>& camera_point
     return;
 
   // If the sensor bar is off the camera will see no LEDs and return 0xFFs.
-  if (!IOS::g_gpio_out[IOS::GPIO::SENSOR_BAR])
+  if (!sensor_bar)
     return;
 
   switch (m_reg_data.mode)
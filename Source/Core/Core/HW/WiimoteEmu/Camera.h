@@ -182,6 +182,13 @@ private:
 
   Register m_reg_data{};
 
+  // The points and sensor bar state camera_data was last built from. Games request IR reports
+  // at 100-200hz while the pointer often doesn't move, so Update skips rebuilding identical data.
+  // Any bus write or state load may change the registers and invalidates this.
+  std::array<CameraPoint, NUM_POINTS> m_last_camera_points{};
+  bool m_last_sensor_bar = false;
+  bool m_camera_data_valid = false;
+
   // When disabled the camera does not respond on the bus.
   // Change is triggered by wiimote report 0x13.
   bool m_is_enabled = false;
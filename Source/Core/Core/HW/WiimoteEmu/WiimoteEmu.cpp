@@ -466,7 +466,7 @@ void Wiimote::BuildDesiredWiimoteState(DesiredWiimoteState* target_state)
       ConvertAccelData(GetTotalAcceleration(), ACCEL_ZERO_G << 2, ACCEL_ONE_G << 2);
 
   // Calculate IR camera state.
-  target_state->camera_points = CameraLogic::GetCameraPoints(
+  target_state->camera_points = GetCameraPoints(
       GetTotalTransformation(),
       Common::Vec2(m_fov_x_setting.GetValue(), m_fov_y_setting.GetValue()) / 360 *
           float(MathUtil::TAU));
@@ -852,4 +852,21 @@ Common::Matrix44 Wiimote::GetTotalTransformation() const
       Common::Quaternion::RotateX(m_imu_cursor_state.recentered_pitch)));
 }
 
+const std::array<CameraPoint, CameraLogic::NUM_POINTS>&
+Wiimote::GetCameraPoints(const Common::Matrix44& transform, Common::Vec2 field_of_view)
+{
+  // The dynamics settle on the exact same pose while the inputs are at rest,
+  // so the projection only has to be redone when something actually moved.
+  if (!m_camera_points_valid || m_camera_transform != transform.data ||
+      m_camera_fov != field_of_view)
+  {
+    m_camera_points = CameraLogic::GetCameraPoints(transform, field_of_view);
+    m_camera_transform = transform.data;
+    m_camera_fov = field_of_view;
+    m_camera_points_valid = true;
+  }
+
+  return m_camera_points;
+}
+
 }  // namespace WiimoteEmu
@@ -198,6 +198,8 @@ private:
   void HandleExtensionSwap(ExtensionNumber desired_extension_number, bool desired_motion_plus);
   bool ProcessExtensionPortEvent();
   void SendDataReport(const DesiredWiimoteState& target_state);
+  const std::array<CameraPoint, CameraLogic::NUM_POINTS>&
+  GetCameraPoints(const Common::Matrix44& transform, Common::Vec2 field_of_view);
   bool ProcessReadDataRequest();
 
   void SetRumble(bool on);
@@ -315,6 +317,12 @@ private:
 
   IMUCursorState m_imu_cursor_state;
 
+  // The last camera projection, reused while the pose and field of view are unchanged.
+  std::array<float, 16> m_camera_transform{};
+  Common::Vec2 m_camera_fov;
+  std::array<CameraPoint, CameraLogic::NUM_POINTS> m_camera_points{};
+  bool m_camera_points_valid = false;
+
   size_t m_config_changed_callback_id;
 };
 }  // namespace WiimoteEmu
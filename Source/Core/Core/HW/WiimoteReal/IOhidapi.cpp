@@ -4,10 +4,12 @@
 #include "Core/HW/WiimoteReal/IOhidapi.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Core/HW/WiimoteCommon/WiimoteHid.h"
 
 using namespace WiimoteCommon;
@@ -104,12 +106,28 @@ bool WiimoteHidapi::ConnectInternal()
                   "Could not connect to Wii Remote at \"{}\". "
                   "Do you have permission to access the device?",
                   m_device_path);
+    return false;
   }
-  return m_handle != nullptr;
+
+  m_read_failed.Clear();
+  m_read_thread_running.Set();
+  m_read_thread = std::thread(&WiimoteHidapi::ReadThreadFunc, this);
+  return true;
 }
 
 void WiimoteHidapi::DisconnectInternal()
 {
+  if (m_read_thread.joinable())
+  {
+    m_read_thread_running.Clear();
+    m_read_thread.join();
+  }
+
+  Report report;
+  while (m_read_reports.Pop(report))
+  {
+  }
+
   hid_close(m_handle);
   m_handle = nullptr;
 }
@@ -119,22 +137,50 @@ bool WiimoteHidapi::IsConnected() const
   return m_handle != nullptr;
 }
 
-int WiimoteHidapi::IORead(u8* buf)
+void WiimoteHidapi::ReadThreadFunc()
 {
-  int timeout = 200;  // ms
-  int result = hid_read_timeout(m_handle, buf + 1, MAX_PAYLOAD - 1, timeout);
-  // TODO: If and once we use hidapi across plaforms, change our internal API to clean up this mess.
-  if (result == -1)
-  {
-    ERROR_LOG_FMT(WIIMOTE, "Failed to read from {}.", m_device_path);
-    return 0;  // error
-  }
-  if (result == 0)
+  Common::SetCurrentThreadName("Wiimote Read Thread");
+
+  while (m_read_thread_running.IsSet())
   {
-    return -1;  // didn't read packet
+    Report report(MAX_PAYLOAD);
+    // The timeout only limits how long disconnecting has to wait for this thread.
+    const int result = hid_read_timeout(m_handle, report.data() + 1, MAX_PAYLOAD - 1, 200);
+    // TODO: If and once we use hidapi across plaforms, change our internal API to clean up this
+    // mess.
+    if (result == -1)
+    {
+      ERROR_LOG_FMT(WIIMOTE, "Failed to read from {}.", m_device_path);
+      m_read_failed.Set();
+      m_read_event.Set();
+      return;
+    }
+    if (result == 0)
+      continue;
+
+    report[0] = WR_SET_REPORT | BT_INPUT;
+    report.resize(result + 1);
+    m_read_reports.Push(std::move(report));
+    m_read_event.Set();
   }
-  buf[0] = WR_SET_REPORT | BT_INPUT;
-  return result + 1;  // number of bytes read
+}
+
+void WiimoteHidapi::IOWakeup()
+{
+  m_read_event.Set();
+}
+
+int WiimoteHidapi::IORead(u8* buf)
+{
+  if (m_read_reports.Empty() && !m_read_failed.IsSet())
+    m_read_event.WaitFor(std::chrono::milliseconds(200));
+
+  Report report;
+  if (!m_read_reports.Pop(report))
+    return m_read_failed.IsSet() ? 0 : -1;  // error or didn't read packet
+
+  std::copy(report.begin(), report.end(), buf);
+  return static_cast<int>(report.size());  // number of bytes read
 }
 
 int WiimoteHidapi::IOWrite(const u8* buf, size_t len)
@@ -4,8 +4,13 @@
 #pragma once
 
 #ifdef HAVE_HIDAPI
+#include <thread>
+
 #include <hidapi.h>
 
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/SPSCQueue.h"
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
 namespace WiimoteReal
@@ -21,13 +26,23 @@ protected:
   bool ConnectInternal() override;
   void DisconnectInternal() override;
   bool IsConnected() const override;
-  void IOWakeup() override {}
+  void IOWakeup() override;
   int IORead(u8* buf) override;
   int IOWrite(const u8* buf, size_t len) override;
 
 private:
+  void ReadThreadFunc();
+
   std::string m_device_path;
   hid_device* m_handle = nullptr;
+
+  // hidapi reads can't be interrupted, so they are done on a separate thread. Otherwise, reports
+  // that the emulated side wants to write would have to wait until the next report is read.
+  std::thread m_read_thread;
+  Common::Flag m_read_thread_running;
+  Common::Flag m_read_failed;
+  Common::SPSCQueue<Report> m_read_reports;
+  Common::Event m_read_event;
 };
 
 class WiimoteScannerHidapi final : public WiimoteScannerBackend
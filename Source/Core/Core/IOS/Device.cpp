@@ -75,6 +75,37 @@ IOCtlVRequest::IOCtlVRequest(const u32 address_) : Request(address_)
   }
 }
 
+static std::span<u8> GetEmulatedBuffer(u32 address, u32 size)
+{
+  if (size == 0)
+    return {};
+
+  u8* pointer = Memory::GetPointerForRange(address, size);
+  if (!pointer)
+    return {};
+
+  return {pointer, size};
+}
+
+std::span<u8> ReadWriteRequest::GetBuffer() const
+{
+  return GetEmulatedBuffer(buffer, size);
+}
+
+std::span<const u8> IOCtlVRequest::GetInBuffer(size_t index) const
+{
+  if (index >= in_vectors.size())
+    return {};
+  return GetEmulatedBuffer(in_vectors[index].address, in_vectors[index].size);
+}
+
+std::span<u8> IOCtlVRequest::GetIOBuffer(size_t index) const
+{
+  if (index >= io_vectors.size())
+    return {};
+  return GetEmulatedBuffer(io_vectors[index].address, io_vectors[index].size);
+}
+
 const IOCtlVRequest::IOVector* IOCtlVRequest::GetVector(size_t index) const
 {
   if (index >= in_vectors.size() + io_vectors.size())
@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -105,6 +106,9 @@ struct ReadWriteRequest final : Request
   u32 buffer = 0;
   u32 size = 0;
   explicit ReadWriteRequest(u32 address);
+  /// Returns a view of the buffer in emulated memory, or an empty span if it isn't entirely
+  /// in valid memory.
+  std::span<u8> GetBuffer() const;
 };
 
 enum SeekMode : s32
@@ -158,6 +162,11 @@ struct IOCtlVRequest final : Request
 
   /// Returns the specified vector or nullptr if the index is out of bounds.
   const IOVector* GetVector(size_t index) const;
+  /// Return views of the buffers of the specified vectors in emulated memory, so that large
+  /// buffers don't have to be copied. The spans are empty if the index is out of bounds or if
+  /// the buffer isn't entirely in valid memory.
+  std::span<const u8> GetInBuffer(size_t index) const;
+  std::span<u8> GetIOBuffer(size_t index) const;
 
   explicit IOCtlVRequest(u32 address);
   bool HasNumberOfValidVectors(size_t in_count, size_t io_count) const;
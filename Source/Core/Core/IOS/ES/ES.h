@@ -5,6 +5,7 @@
 
 #include <array>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -389,5 +390,16 @@ private:
   ContextArray m_contexts;
   TitleContext m_title_context{};
   std::string m_pending_ppc_boot_content_path;
+
+  // Listing /title and /ticket takes one host directory read per title, and titles are often
+  // listed several times in a row (count, then IDs). The lists are reused for as long as the
+  // filesystem reports that no file or directory has been created, deleted or renamed.
+  struct CachedTitleList
+  {
+    u32 namespace_version = 0;
+    std::vector<u64> title_ids;
+  };
+  mutable std::optional<CachedTitleList> m_installed_titles_cache;
+  mutable std::optional<CachedTitleList> m_titles_with_tickets_cache;
 };
 }  // namespace IOS::HLE
@@ -43,15 +43,21 @@ IPCReply ESDevice::Encrypt(u32 uid, const IOCtlVRequest& request)
   if (!request.HasNumberOfValidVectors(3, 2))
     return IPCReply(ES_EINVAL);
 
+  const std::span<const u8> source = request.GetInBuffer(2);
+  const std::span<u8> iv = request.GetIOBuffer(0);
+  const std::span<u8> destination = request.GetIOBuffer(1);
+  if (source.size() != request.in_vectors[2].size || iv.size() < 16 ||
+      destination.size() < source.size())
+  {
+    return IPCReply(ES_EINVAL);
+  }
+
   u32 keyIndex = Memory::Read_U32(request.in_vectors[0].address);
-  u8* source = Memory::GetPointer(request.in_vectors[2].address);
-  u32 size = request.in_vectors[2].size;
-  u8* iv = Memory::GetPointer(request.io_vectors[0].address);
-  u8* destination = Memory::GetPointer(request.io_vectors[1].address);
 
   // TODO: Check whether the active title is allowed to encrypt.
 
-  const ReturnCode ret = m_ios.GetIOSC().Encrypt(keyIndex, iv, source, size, destination, PID_ES);
+  const ReturnCode ret = m_ios.GetIOSC().Encrypt(keyIndex, iv.data(), source.data(),
+                                                 u32(source.size()), destination.data(), PID_ES);
   return IPCReply(ret);
 }
 
@@ -60,15 +66,21 @@ IPCReply ESDevice::Decrypt(u32 uid, const IOCtlVRequest& request)
   if (!request.HasNumberOfValidVectors(3, 2))
     return IPCReply(ES_EINVAL);
 
+  const std::span<const u8> source = request.GetInBuffer(2);
+  const std::span<u8> iv = request.GetIOBuffer(0);
+  const std::span<u8> destination = request.GetIOBuffer(1);
+  if (source.size() != request.in_vectors[2].size || iv.size() < 16 ||
+      destination.size() < source.size())
+  {
+    return IPCReply(ES_EINVAL);
+  }
+
   u32 keyIndex = Memory::Read_U32(request.in_vectors[0].address);
-  u8* source = Memory::GetPointer(request.in_vectors[2].address);
-  u32 size = request.in_vectors[2].size;
-  u8* iv = Memory::GetPointer(request.io_vectors[0].address);
-  u8* destination = Memory::GetPointer(request.io_vectors[1].address);
 
   // TODO: Check whether the active title is allowed to decrypt.
 
-  const ReturnCode ret = m_ios.GetIOSC().Decrypt(keyIndex, iv, source, size, destination, PID_ES);
+  const ReturnCode ret = m_ios.GetIOSC().Decrypt(keyIndex, iv.data(), source.data(),
+                                                 u32(source.size()), destination.data(), PID_ES);
   return IPCReply(ret);
 }
 
@@ -113,19 +113,8 @@ static std::vector<u64> GetTitlesInTitleOrImport(FS::FileSystem* fs, const std::
   return title_ids;
 }
 
-std::vector<u64> ESDevice::GetInstalledTitles() const
-{
-  return GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/title");
-}
-
-std::vector<u64> ESDevice::GetTitleImports() const
+static std::vector<u64> GetTitlesInTicketDirectory(FS::FileSystem* fs)
 {
-  return GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/import");
-}
-
-std::vector<u64> ESDevice::GetTitlesWithTickets() const
-{
-  const auto fs = m_ios.GetFS();
   const auto entries = fs->ReadDirectory(PID_KERNEL, PID_KERNEL, "/ticket");
   if (!entries)
   {
@@ -165,6 +154,36 @@ std::vector<u64> ESDevice::GetTitlesWithTickets() const
   return title_ids;
 }
 
+template <typename Cache, typename GetTitles>
+static std::vector<u64> GetCachedTitleList(Cache& cache, const FS::FileSystem& fs,
+                                           GetTitles get_titles)
+{
+  const u32 namespace_version = fs.GetNamespaceVersion();
+  if (!cache || cache->namespace_version != namespace_version)
+    cache = typename Cache::value_type{namespace_version, get_titles()};
+  return cache->title_ids;
+}
+
+std::vector<u64> ESDevice::GetInstalledTitles() const
+{
+  const auto fs = m_ios.GetFS();
+  return GetCachedTitleList(m_installed_titles_cache, *fs, [&fs] {
+    return GetTitlesInTitleOrImport(fs.get(), "/title");
+  });
+}
+
+std::vector<u64> ESDevice::GetTitleImports() const
+{
+  return GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/import");
+}
+
+std::vector<u64> ESDevice::GetTitlesWithTickets() const
+{
+  const auto fs = m_ios.GetFS();
+  return GetCachedTitleList(m_titles_with_tickets_cache, *fs,
+                            [&fs] { return GetTitlesInTicketDirectory(fs.get()); });
+}
+
 std::vector<ES::Content>
 ESDevice::GetStoredContentsFromTMD(const ES::TMDReader& tmd,
                                    CheckContentHashes check_content_hashes) const
@@ -112,10 +112,13 @@ IPCReply ESDevice::ReadContent(u32 uid, const IOCtlVRequest& request)
     const u32 cfd = Memory::Read_U32(request.in_vectors[0].address);
     const u32 size = request.io_vectors[0].size;
     const u32 addr = request.io_vectors[0].address;
+    const std::span<u8> buffer = request.GetIOBuffer(0);
+    if (buffer.size() != size)
+      return ES_EINVAL;
 
     INFO_LOG_FMT(IOS_ES, "ReadContent(uid={:#x}, cfd={}, size={}, addr={:08x})", uid, cfd, size,
                  addr);
-    return ReadContent(cfd, Memory::GetPointer(addr), size, uid, ticks);
+    return ReadContent(cfd, buffer.data(), size, uid, ticks);
   });
 }
 
@@ -346,9 +346,12 @@ IPCReply ESDevice::ImportContentData(Context& context, const IOCtlVRequest& requ
   if (!request.HasNumberOfValidVectors(2, 0))
     return IPCReply(ES_EINVAL);
 
+  const std::span<const u8> data = request.GetInBuffer(1);
+  if (data.size() != request.in_vectors[1].size)
+    return IPCReply(ES_EINVAL);
+
   u32 content_fd = Memory::Read_U32(request.in_vectors[0].address);
-  u8* data_start = Memory::GetPointer(request.in_vectors[1].address);
-  return IPCReply(ImportContentData(context, content_fd, data_start, request.in_vectors[1].size));
+  return IPCReply(ImportContentData(context, content_fd, data.data(), u32(data.size())));
 }
 
 static bool CheckIfContentHashMatches(const std::vector<u8>& content, const ES::Content& info)
@@ -778,11 +781,12 @@ IPCReply ESDevice::ExportContentData(Context& context, const IOCtlVRequest& requ
     return IPCReply(ES_EINVAL);
   }
 
-  const u32 content_fd = Memory::Read_U32(request.in_vectors[0].address);
-  u8* data = Memory::GetPointer(request.io_vectors[0].address);
-  const u32 bytes_to_read = request.io_vectors[0].size;
+  const std::span<u8> data = request.GetIOBuffer(0);
+  if (data.size() != request.io_vectors[0].size)
+    return IPCReply(ES_EINVAL);
 
-  return IPCReply(ExportContentData(context, content_fd, data, bytes_to_read));
+  const u32 content_fd = Memory::Read_U32(request.in_vectors[0].address);
+  return IPCReply(ExportContentData(context, content_fd, data.data(), u32(data.size())));
 }
 
 ReturnCode ESDevice::ExportContentEnd(Context& context, u32 content_fd)
@@ -250,6 +250,16 @@ public:
   virtual Result<DirectoryStats> GetDirectoryStats(const std::string& path) = 0;
 
   virtual void SetNandRedirects(std::vector<NandRedirect> nand_redirects) = 0;
+
+  /// Returns a number that changes whenever files or directories are created, deleted or renamed,
+  /// so that callers can cache directory listings.
+  u32 GetNamespaceVersion() const { return m_namespace_version; }
+
+protected:
+  void InvalidateNamespace() { ++m_namespace_version; }
+
+private:
+  u32 m_namespace_version = 0;
 };
 
 template <typename T>
@@ -310,8 +310,11 @@ bool FSDevice::HasCacheForFile(u64 fd, u32 offset) const
 
 std::optional<IPCReply> FSDevice::Read(const ReadWriteRequest& request)
 {
-  return MakeIPCReply([&](Ticks t) {
-    return Read(request.fd, Memory::GetPointer(request.buffer), request.size, request.buffer, t);
+  return MakeIPCReply([&](Ticks t) -> s32 {
+    const std::span<u8> buffer = request.GetBuffer();
+    if (buffer.size() != request.size)
+      return ConvertResult(ResultCode::Invalid);
+    return Read(request.fd, buffer.data(), request.size, request.buffer, t);
   });
 }
 
@@ -338,8 +341,11 @@ s32 FSDevice::Read(u64 fd, u8* data, u32 size, std::optional<u32> ipc_buffer_add
 
 std::optional<IPCReply> FSDevice::Write(const ReadWriteRequest& request)
 {
-  return MakeIPCReply([&](Ticks t) {
-    return Write(request.fd, Memory::GetPointer(request.buffer), request.size, request.buffer, t);
+  return MakeIPCReply([&](Ticks t) -> s32 {
+    const std::span<u8> buffer = request.GetBuffer();
+    if (buffer.size() != request.size)
+      return ConvertResult(ResultCode::Invalid);
+    return Write(request.fd, buffer.data(), request.size, request.buffer, t);
   });
 }
 
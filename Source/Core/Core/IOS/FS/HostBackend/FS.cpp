@@ -218,9 +218,15 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
     return nullptr;
 
   auto host_file = BuildFilename(path);
-  const File::FileInfo host_file_info{host_file.host_path};
-  if (!host_file_info.Exists())
-    return nullptr;
+  // A file that is already open is known to exist, which saves querying the host.
+  bool is_file = true;
+  if (!GetOpenHostFile(host_file.host_path))
+  {
+    const File::FileInfo host_file_info{host_file.host_path};
+    if (!host_file_info.Exists())
+      return nullptr;
+    is_file = host_file_info.IsFile();
+  }
 
   FstEntry* entry = host_file.is_redirect ? &m_redirect_fst : &m_root_entry;
   std::string complete_path = "";
@@ -246,7 +252,7 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
     }
   }
 
-  entry->data.is_file = host_file_info.IsFile();
+  entry->data.is_file = is_file;
   if (entry->data.is_file && !entry->children.empty())
   {
     WARN_LOG_FMT(IOS_FS, "{} is a file but also has children; clearing children", path);
@@ -347,6 +353,7 @@ void HostFileSystem::DoStateWriteOrMeasure(PointerWrap& p, std::string start_dir
 void HostFileSystem::DoState(PointerWrap& p)
 {
   // Temporarily close the file, to prevent any issues with the savestating of files/folders.
+  CloseCachedHostFiles();
   for (Handle& handle : m_handles)
     handle.host_file.reset();
 
@@ -387,6 +394,7 @@ void HostFileSystem::DoState(PointerWrap& p)
   }
   else  // case where we're in read mode.
   {
+    InvalidateNamespace();
     DoStateRead(p, "/tmp");
     if (!Movie::IsMovieActive() || !original_save_state_made_during_movie_recording ||
         !Core::WiiRootIsTemporary() ||
@@ -421,10 +429,12 @@ ResultCode HostFileSystem::Format(Uid uid)
   if (m_root_path.empty())
     return ResultCode::AccessDenied;
   const std::string root = BuildFilename("/").host_path;
+  CloseCachedHostFiles();
   if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
     return ResultCode::UnknownError;
   ResetFst();
   SaveFst();
+  InvalidateNamespace();
   // Reset and close all handles.
   m_handles = {};
   return ResultCode::Success;
@@ -468,6 +478,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   child->data.gid = gid;
   child->data.attribute = attr;
   SaveFst();
+  InvalidateNamespace();
   return ResultCode::Success;
 }
 
@@ -515,6 +526,8 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   if (!File::Exists(host_path))
     return ResultCode::NotFound;
 
+  // Files can't be deleted while they're open on some hosts.
+  CloseCachedHostFiles();
   if (File::IsFile(host_path) && !IsFileOpened(path))
     File::Delete(host_path);
   else if (File::IsDirectory(host_path) && !IsDirectoryInUse(path))
@@ -527,6 +540,7 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   if (it != parent->children.end())
     parent->children.erase(it);
   SaveFst();
+  InvalidateNamespace();
 
   return ResultCode::Success;
 }
@@ -570,6 +584,9 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   const std::string& host_old_path = host_old_info.host_path;
   const std::string& host_new_path = host_new_info.host_path;
 
+  // Files can't be renamed or replaced while they're open on some hosts.
+  CloseCachedHostFiles();
+
   // If there is already something of the same type at the new path, delete it.
   if (File::Exists(host_new_path))
   {
@@ -623,6 +640,7 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   }
 
   SaveFst();
+  InvalidateNamespace();
 
   return ResultCode::Success;
 }
@@ -711,7 +729,7 @@ Result<Metadata> HostFileSystem::GetMetadata(Uid uid, Gid gid, const std::string
     return ResultCode::NotFound;
 
   Metadata metadata = entry->data;
-  metadata.size = File::GetSize(BuildFilename(path).host_path);
+  metadata.size = GetHostFileSize(BuildFilename(path).host_path);
   return metadata;
 }
 
@@ -730,7 +748,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   if (caller_uid != 0 && uid != entry->data.uid)
     return ResultCode::AccessDenied;
 
-  const bool is_empty = File::GetSize(BuildFilename(path).host_path) == 0;
+  const bool is_empty = GetHostFileSize(BuildFilename(path).host_path) == 0;
   if (entry->data.uid != uid && entry->data.is_file && !is_empty)
     return ResultCode::FileNotEmpty;
 
@@ -769,6 +787,8 @@ Result<DirectoryStats> HostFileSystem::GetDirectoryStats(const std::string& wii_
   std::string path(BuildFilename(wii_path).host_path);
   if (File::IsDirectory(path))
   {
+    // The sizes on the host must include the writes that are still buffered.
+    FlushOpenHostFiles();
     File::FSTEntry parent_dir = File::ScanDirectoryTree(path, true);
     // add one for the folder itself
     stats.used_inodes = 1 + (u32)parent_dir.size;
@@ -786,6 +806,8 @@ Result<DirectoryStats> HostFileSystem::GetDirectoryStats(const std::string& wii_
 
 void HostFileSystem::SetNandRedirects(std::vector<NandRedirect> nand_redirects)
 {
+  CloseCachedHostFiles();
   m_nand_redirects = std::move(nand_redirects);
+  InvalidateNamespace();
 }
 }  // namespace IOS::HLE::FS
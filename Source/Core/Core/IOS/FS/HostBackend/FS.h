@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
@@ -75,12 +76,28 @@ private:
     std::vector<FstEntry> children;
   };
 
+  /// A file on the host, shared by all handles for the same path.
+  struct HostFile
+  {
+    /// Moves the stream to the given position, if it isn't already there or if the direction of
+    /// the access changes. Seeking flushes the stdio buffers, so this keeps small sequential reads
+    /// and writes buffered.
+    void PrepareAccess(u64 offset, bool write);
+
+    File::IOFile file;
+    /// Cached because querying it from the host requires seeking.
+    u64 size = 0;
+    u64 position = UINT64_MAX;
+    bool last_access_was_write = false;
+    bool has_unflushed_writes = false;
+  };
+
   struct Handle
   {
     bool opened = false;
     Mode mode = Mode::None;
     std::string wii_path;
-    std::shared_ptr<File::IOFile> host_file;
+    std::shared_ptr<HostFile> host_file;
     u32 file_offset = 0;
   };
   Handle* AssignFreeHandle();
@@ -93,7 +110,11 @@ private:
     bool is_redirect;
   };
   HostFilename BuildFilename(const std::string& wii_path) const;
-  std::shared_ptr<File::IOFile> OpenHostFile(const std::string& host_path);
+  std::shared_ptr<HostFile> OpenHostFile(const std::string& host_path);
+  std::shared_ptr<HostFile> GetOpenHostFile(const std::string& host_path) const;
+  u64 GetHostFileSize(const std::string& host_path) const;
+  void FlushOpenHostFiles();
+  void CloseCachedHostFiles();
 
   ResultCode CreateFileOrDirectory(Uid uid, Gid gid, const std::string& path,
                                    FileAttribute attribute, Modes modes, bool is_file);
@@ -119,9 +140,16 @@ private:
   /// filesystem root manually.
   FstEntry m_root_entry{};
   std::string m_root_path;
-  std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
+  std::map<std::string, std::weak_ptr<HostFile>> m_open_files;
   std::array<Handle, 16> m_handles{};
 
+  /// Files that were recently closed by the emulated software are kept open on the host, as games
+  /// tend to open the same save files over and over, and opening files can be very slow on some
+  /// hosts (e.g. with scoped storage on Android). Must be cleared before the host file system is
+  /// modified in other ways. Most recently closed files are at the front.
+  static constexpr size_t MAX_CACHED_HOST_FILES = 8;
+  std::deque<std::shared_ptr<HostFile>> m_cached_host_files;
+
   FstEntry m_redirect_fst{};
   std::vector<NandRedirect> m_nand_redirects;
 };
@@ -13,8 +13,19 @@
 
 namespace IOS::HLE::FS
 {
+void HostFileSystem::HostFile::PrepareAccess(u64 offset, bool write)
+{
+  // Switching between reading and writing requires a seek (or a flush) in between.
+  if (position == offset && last_access_was_write == write)
+    return;
+
+  file.Seek(offset, File::SeekOrigin::Begin);
+  position = offset;
+  last_access_was_write = write;
+}
+
 // This isn't theadsafe, but it's only called from the CPU thread.
-std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& host_path)
+std::shared_ptr<HostFileSystem::HostFile> HostFileSystem::OpenHostFile(const std::string& host_path)
 {
   // On the wii, all file operations are strongly ordered.
   // If a game opens the same file twice (or 8 times, looking at you PokePark Wii)
@@ -33,11 +44,24 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
   //    - The Beatles: Rock Band (saving doesn't work)
 
   // Check if the file has already been opened.
-  auto search = m_open_files.find(host_path);
-  if (search != m_open_files.end())
+  if (std::shared_ptr<HostFile> host_file = GetOpenHostFile(host_path))
   {
-    // Lock a shared pointer to use.
-    return search->second.lock();
+    const auto cached = std::find(m_cached_host_files.begin(), m_cached_host_files.end(), host_file);
+    if (cached != m_cached_host_files.end())
+    {
+      m_cached_host_files.erase(cached);
+
+      // Nothing else had the file open, so it may have been changed behind our back.
+      const bool in_use =
+          std::any_of(m_handles.begin(), m_handles.end(),
+                      [&host_file](const Handle& handle) { return handle.host_file == host_file; });
+      if (!in_use)
+      {
+        host_file->size = host_file->file.GetSize();
+        host_file->position = UINT64_MAX;
+      }
+    }
+    return host_file;
   }
 
   // All files are opened read/write. Actual access rights will be controlled per handle by the
@@ -60,20 +84,58 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
   }
 
   // This code will be called when all references to the shared pointer below have been removed.
-  auto deleter = [this, host_path](File::IOFile* ptr) {
+  auto deleter = [this, host_path](HostFile* ptr) {
     delete ptr;                     // IOFile's deconstructor closes the file.
     m_open_files.erase(host_path);  // erase the weak pointer from the list of open files.
   };
 
   // Use the custom deleter from above.
-  std::shared_ptr<File::IOFile> file_ptr(new File::IOFile(std::move(file)), deleter);
+  std::shared_ptr<HostFile> file_ptr(new HostFile{std::move(file)}, deleter);
+  file_ptr->size = file_ptr->file.GetSize();
 
   // Store a weak pointer to our newly opened file in the cache.
-  m_open_files[host_path] = std::weak_ptr<File::IOFile>(file_ptr);
+  m_open_files[host_path] = std::weak_ptr<HostFile>(file_ptr);
 
   return file_ptr;
 }
 
+std::shared_ptr<HostFileSystem::HostFile>
+HostFileSystem::GetOpenHostFile(const std::string& host_path) const
+{
+  const auto search = m_open_files.find(host_path);
+  if (search == m_open_files.end())
+    return nullptr;
+
+  // Lock a shared pointer to use.
+  return search->second.lock();
+}
+
+u64 HostFileSystem::GetHostFileSize(const std::string& host_path) const
+{
+  if (const std::shared_ptr<HostFile> host_file = GetOpenHostFile(host_path))
+    return host_file->size;
+  return File::GetSize(host_path);
+}
+
+void HostFileSystem::FlushOpenHostFiles()
+{
+  for (const auto& entry : m_open_files)
+  {
+    const std::shared_ptr<HostFile> host_file = entry.second.lock();
+    if (host_file && host_file->has_unflushed_writes)
+    {
+      host_file->file.Flush();
+      host_file->has_unflushed_writes = false;
+    }
+  }
+}
+
+void HostFileSystem::CloseCachedHostFiles()
+{
+  // Files that are still in use by a handle stay open.
+  m_cached_host_files.clear();
+}
+
 Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, Mode mode)
 {
   Handle* handle = AssignFreeHandle();
@@ -81,7 +143,8 @@ Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, M
     return ResultCode::NoFreeHandle;
 
   const std::string host_path = BuildFilename(path).host_path;
-  if (!File::IsFile(host_path))
+  // A file that is already open is known to exist, which saves querying the host.
+  if (!GetOpenHostFile(host_path) && !File::IsFile(host_path))
   {
     *handle = Handle{};
     return ResultCode::NotFound;
@@ -106,8 +169,25 @@ ResultCode HostFileSystem::Close(Fd fd)
   if (!handle)
     return ResultCode::Invalid;
 
-  // Let go of our pointer to the file, it will automatically close if we are the last handle
-  // accessing it.
+  // Writes are buffered only for as long as the file is open, so that they don't get lost and so
+  // that the saves on the host are up to date.
+  HostFile& host_file = *handle->host_file;
+  if (host_file.has_unflushed_writes)
+  {
+    host_file.file.Flush();
+    host_file.has_unflushed_writes = false;
+  }
+
+  // Keep the file open on the host for a while, in case it's reopened soon. It will automatically
+  // close once it has left the cache and we are the last handle accessing it.
+  const auto cached =
+      std::find(m_cached_host_files.begin(), m_cached_host_files.end(), handle->host_file);
+  if (cached != m_cached_host_files.end())
+    m_cached_host_files.erase(cached);
+  m_cached_host_files.push_front(std::move(handle->host_file));
+  if (m_cached_host_files.size() > MAX_CACHED_HOST_FILES)
+    m_cached_host_files.pop_back();
+
   *handle = Handle{};
   return ResultCode::Success;
 }
@@ -115,23 +195,28 @@ ResultCode HostFileSystem::Close(Fd fd)
 Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Read)) == 0)
     return ResultCode::AccessDenied;
 
-  const u32 file_size = static_cast<u32>(handle->host_file->GetSize());
+  HostFile& host_file = *handle->host_file;
+  const u32 file_size = static_cast<u32>(host_file.size);
   // IOS has this check in the read request handler.
   if (count + handle->file_offset > file_size)
     count = file_size - handle->file_offset;
 
   // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, handle->host_file->GetHandle()));
+  host_file.PrepareAccess(handle->file_offset, false);
+  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, host_file.file.GetHandle()));
+  host_file.position += actually_read;
 
-  if (actually_read != count && ferror(handle->host_file->GetHandle()))
+  if (actually_read != count && ferror(host_file.file.GetHandle()))
+  {
+    host_file.position = UINT64_MAX;
     return ResultCode::AccessDenied;
+  }
 
   // IOS returns the number of bytes read and adds that value to the seek position,
   // instead of adding the *requested* read length.
@@ -142,17 +227,25 @@ Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Write)) == 0)
     return ResultCode::AccessDenied;
 
-  // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  if (!handle->host_file->WriteBytes(ptr, count))
+  // File might be opened twice, need to seek before we write
+  HostFile& host_file = *handle->host_file;
+  host_file.PrepareAccess(handle->file_offset, true);
+  host_file.has_unflushed_writes = true;
+  if (!host_file.file.WriteBytes(ptr, count))
+  {
+    host_file.position = UINT64_MAX;
+    host_file.size = host_file.file.GetSize();
     return ResultCode::AccessDenied;
+  }
 
+  host_file.position += count;
+  host_file.size = std::max(host_file.size, host_file.position);
   handle->file_offset += count;
   return count;
 }
@@ -160,7 +253,7 @@ Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   u32 new_position = 0;
@@ -173,14 +266,14 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
     new_position = handle->file_offset + offset;
     break;
   case SeekMode::End:
-    new_position = handle->host_file->GetSize() + offset;
+    new_position = handle->host_file->size + offset;
     break;
   default:
     return ResultCode::Invalid;
   }
 
   // This differs from POSIX behaviour which allows seeking past the end of the file.
-  if (handle->host_file->GetSize() < new_position)
+  if (handle->host_file->size < new_position)
     return ResultCode::Invalid;
 
   handle->file_offset = new_position;
@@ -190,11 +283,11 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 Result<FileStatus> HostFileSystem::GetFileStatus(Fd fd)
 {
   const Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   FileStatus status;
-  status.size = handle->host_file->GetSize();
+  status.size = handle->host_file->size;
   status.offset = handle->file_offset;
   return status;
 }
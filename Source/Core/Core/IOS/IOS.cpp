@@ -17,6 +17,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 #include "Core/Boot/AncastTypes.h"
 #include "Core/Boot/DolReader.h"
 #include "Core/Boot/ElfReader.h"
@@ -303,6 +304,7 @@ Kernel::Kernel(u64 title_id) : m_title_id(title_id)
 
 EmulationKernel::EmulationKernel(u64 title_id) : Kernel(title_id)
 {
+  Common::Trace::ScopedEvent trace_event("IOS::HLE::EmulationKernel");
   INFO_LOG_FMT(IOS, "Starting IOS {:016x}", title_id);
 
   if (!SetupMemory(title_id, MemorySetupType::IOSReload))
@@ -15,6 +15,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -79,6 +80,16 @@ int SSLRecv(void* ctx, unsigned char* buf, size_t len)
 
   return ret;
 }
+
+Common::WorkQueueThread<WII_SSL*>& GetHandshakeThread()
+{
+  static Common::WorkQueueThread<WII_SSL*> s_handshake_thread([](WII_SSL* ssl) {
+    ssl->handshake_result = mbedtls_ssl_handshake(&ssl->ctx);
+    ssl->handshake_state.store(WII_SSL::HandshakeState::Done, std::memory_order_release);
+    ssl->handshake_event.Set();
+  });
+  return s_handshake_thread;
+}
 }  // namespace
 
 NetSSLDevice::NetSSLDevice(Kernel& ios, const std::string& device_name) : Device(ios, device_name)
@@ -96,6 +107,7 @@ NetSSLDevice::~NetSSLDevice()
   {
     if (ssl.active)
     {
+      WaitForHandshake(ssl);
       mbedtls_ssl_close_notify(&ssl.ctx);
 
       mbedtls_x509_crt_free(&ssl.cacert);
@@ -126,6 +138,37 @@ int NetSSLDevice::GetSSLFreeID() const
   return 0;
 }
 
+std::optional<int> NetSSLDevice::DoHandshakeStep(WII_SSL& ssl)
+{
+  const WII_SSL::HandshakeState state = ssl.handshake_state.load(std::memory_order_acquire);
+  if (state == WII_SSL::HandshakeState::Done)
+  {
+    ssl.handshake_state.store(WII_SSL::HandshakeState::Idle, std::memory_order_relaxed);
+    return ssl.handshake_result;
+  }
+
+  if (state == WII_SSL::HandshakeState::Idle)
+  {
+    ssl.handshake_state.store(WII_SSL::HandshakeState::Running, std::memory_order_relaxed);
+    GetHandshakeThread().EmplaceItem(&ssl);
+  }
+  return std::nullopt;
+}
+
+bool NetSSLDevice::IsHandshakeRunning(const WII_SSL& ssl)
+{
+  return ssl.handshake_state.load(std::memory_order_acquire) == WII_SSL::HandshakeState::Running;
+}
+
+void NetSSLDevice::WaitForHandshake(WII_SSL& ssl)
+{
+  while (IsHandshakeRunning(ssl))
+    ssl.handshake_event.Wait();
+
+  // The result of a step that nobody asked for anymore is dropped.
+  ssl.handshake_state.store(WII_SSL::HandshakeState::Idle, std::memory_order_relaxed);
+}
+
 std::optional<IPCReply> NetSSLDevice::IOCtl(const IOCtlRequest& request)
 {
   request.Log(GetDeviceName(), Common::Log::LogType::IOS_SSL, Common::Log::LogLevel::LINFO);
@@ -294,6 +337,7 @@ std::optional<IPCReply> NetSSLDevice::IOCtlV(const IOCtlVRequest& request)
     if (IsSSLIDValid(sslID))
     {
       WII_SSL* ssl = &_SSL[sslID];
+      WaitForHandshake(*ssl);
 
       mbedtls_ssl_close_notify(&ssl->ctx);
 
@@ -13,11 +13,14 @@
 #include <mbedtls/platform.h>
 #include <mbedtls/ssl.h>
 #include <mbedtls/x509_crt.h>
+#include <atomic>
+#include <optional>
 #include <string>
 
 // clang-format on
 
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
 
@@ -77,6 +80,17 @@ struct WII_SSL
   int hostfd = -1;
   std::string hostname;
   bool active = false;
+
+  enum class HandshakeState
+  {
+    Idle,
+    Running,
+    Done,
+  };
+  // The context belongs to the handshake thread while a handshake step is running.
+  std::atomic<HandshakeState> handshake_state = HandshakeState::Idle;
+  int handshake_result = 0;
+  Common::Event handshake_event;
 };
 
 class NetSSLDevice : public Device
@@ -91,6 +105,14 @@ public:
 
   int GetSSLFreeID() const;
 
+  // Handshake steps verify certificates and do key exchanges, which can take long enough to stall
+  // emulation, so they run on a worker thread. Returns the result of mbedtls_ssl_handshake once
+  // the step that this started earlier is done, and nothing until then.
+  static std::optional<int> DoHandshakeStep(WII_SSL& ssl);
+  static bool IsHandshakeRunning(const WII_SSL& ssl);
+  // Must be called before the context is modified or freed from the CPU thread.
+  static void WaitForHandshake(WII_SSL& ssl);
+
   static WII_SSL _SSL[NET_SSL_MAXINSTANCES];
 
 private:
@@ -188,6 +188,8 @@ s32 WiiSocket::Shutdown(u32 how)
       break;
     }
   }
+  // The aborted operations are replied to on the next update.
+  waiting_for_host = false;
   return ret;
 }
 
@@ -196,6 +198,7 @@ s32 WiiSocket::CloseFd()
   s32 ReturnValue = 0;
   if (fd >= 0)
   {
+    WiiSockMan::GetInstance().GetNotifier().Remove(fd);
     s32 ret = closesocket(fd);
     ReturnValue = WiiSockMan::GetNetErrorCode(ret, "CloseFd", false);
   }
@@ -204,6 +207,7 @@ s32 WiiSocket::CloseFd()
     ReturnValue = WiiSockMan::GetNetErrorCode(EITHER(WSAENOTSOCK, EBADF), "CloseFd", false);
   }
   fd = -1;
+  waiting_for_host = false;
 
   for (auto it = pending_sockops.begin(); it != pending_sockops.end();)
   {
@@ -400,8 +404,20 @@ void WiiSocket::Update(bool read, bool write, bool except)
               break;
             }
 
-            mbedtls_ssl_context* ctx = &NetSSLDevice::_SSL[sslID].ctx;
-            const int ret = mbedtls_ssl_handshake(ctx);
+            // Until the step that runs on the handshake thread is done, the handshake is
+            // treated as if it was waiting for data.
+            WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
+            const std::optional<int> result = NetSSLDevice::DoHandshakeStep(*ssl);
+            if (!result)
+            {
+              WriteReturnValue(SSL_ERR_RAGAIN, BufferIn);
+              if (!nonBlock)
+                ReturnValue = SSL_ERR_RAGAIN;
+              break;
+            }
+
+            mbedtls_ssl_context* ctx = &ssl->ctx;
+            const int ret = *result;
             if (ret != 0)
             {
               char error_buffer[256] = "";
@@ -478,6 +494,14 @@ void WiiSocket::Update(bool read, bool write, bool except)
           case IOCTLV_NET_SSL_WRITE:
           {
             WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
+            if (NetSSLDevice::IsHandshakeRunning(*ssl))
+            {
+              WriteReturnValue(SSL_ERR_WAGAIN, BufferIn);
+              if (!nonBlock)
+                ReturnValue = SSL_ERR_WAGAIN;
+              break;
+            }
+
             const int ret =
                 mbedtls_ssl_write(&ssl->ctx, Memory::GetPointer(BufferOut2), BufferOutSize2);
 
@@ -512,6 +536,14 @@ void WiiSocket::Update(bool read, bool write, bool except)
           case IOCTLV_NET_SSL_READ:
           {
             WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
+            if (NetSSLDevice::IsHandshakeRunning(*ssl))
+            {
+              WriteReturnValue(SSL_ERR_RAGAIN, BufferIn);
+              if (!nonBlock)
+                ReturnValue = SSL_ERR_RAGAIN;
+              break;
+            }
+
             const int ret =
                 mbedtls_ssl_read(&ssl->ctx, Memory::GetPointer(BufferIn2), BufferInSize2);
 
@@ -700,6 +732,40 @@ void WiiSocket::Update(bool read, bool write, bool except)
   }
 }
 
+void WiiSocket::WaitForHost(SocketNotifier& notifier)
+{
+  // Only operations that can't make progress until the host socket is ready are left to the
+  // notifier. SSL operations may find data that mbedtls has already buffered and blocking connects
+  // have to time out, so those keep being retried on every update.
+  bool read = false;
+  bool write = false;
+  for (const sockop& op : pending_sockops)
+  {
+    if (op.is_ssl || op.is_aborted)
+      return;
+
+    switch (op.net_type)
+    {
+    case IOCTL_SO_ACCEPT:
+    case IOCTLV_SO_RECVFROM:
+      read = true;
+      break;
+    case IOCTLV_SO_SENDTO:
+      write = true;
+      break;
+    default:
+      return;
+    }
+  }
+
+  // Sending and receiving are refused until a connection in progress is established, which is
+  // when the socket becomes writable.
+  if (connecting_state == ConnectingState::Connecting)
+    write = true;
+
+  waiting_for_host = notifier.Arm(fd, read, write);
+}
+
 void WiiSocket::UpdateConnectingState(s32 connect_rv)
 {
   if (connect_rv == -SO_EAGAIN || connect_rv == -SO_EALREADY || connect_rv == -SO_EINPROGRESS)
@@ -825,6 +891,7 @@ void WiiSocket::DoSock(Request request, NET_IOCTL type)
   sockop so = {request, false};
   so.net_type = type;
   pending_sockops.push_back(so);
+  waiting_for_host = false;
 }
 
 void WiiSocket::DoSock(Request request, SSL_IOCTL type)
@@ -832,6 +899,7 @@ void WiiSocket::DoSock(Request request, SSL_IOCTL type)
   sockop so = {request, true};
   so.ssl_type = type;
   pending_sockops.push_back(so);
+  waiting_for_host = false;
 }
 
 s32 WiiSockMan::AddSocket(s32 fd, bool is_rw)
@@ -940,6 +1008,37 @@ s32 WiiSockMan::DeleteSocket(s32 wii_fd)
 
 void WiiSockMan::Update()
 {
+  if (m_notifier.IsActive())
+  {
+    // Sockets whose operations are blocked on the host socket are skipped until the notifier
+    // reports them, so an idle update doesn't make any syscall.
+    const std::vector<s32> ready_fds = m_notifier.TakeReadySockets();
+    auto socket_iter = WiiSockets.begin();
+    while (socket_iter != WiiSockets.end())
+    {
+      WiiSocket& sock = socket_iter->second;
+      if (!sock.IsValid())
+      {
+        socket_iter = WiiSockets.erase(socket_iter);
+        continue;
+      }
+
+      if (!sock.waiting_for_host ||
+          std::find(ready_fds.begin(), ready_fds.end(), sock.fd) != ready_fds.end())
+      {
+        sock.waiting_for_host = false;
+        if (!sock.pending_sockops.empty())
+        {
+          sock.Update(false, false, false);
+          sock.WaitForHost(m_notifier);
+        }
+      }
+      ++socket_iter;
+    }
+    UpdatePollCommands();
+    return;
+  }
+
   s32 nfds = 0;
   fd_set read_fds, write_fds, except_fds;
   struct timeval t = {0, 0};
@@ -57,6 +57,7 @@ typedef struct pollfd pollfd_t;
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/Network/IP/Top.h"
 #include "Core/IOS/Network/SSL.h"
+#include "Core/IOS/Network/SocketNotifier.h"
 
 namespace IOS::HLE
 {
@@ -220,6 +221,7 @@ private:
   void DoSock(Request request, NET_IOCTL type);
   void DoSock(Request request, SSL_IOCTL type);
   void Update(bool read, bool write, bool except);
+  void WaitForHost(SocketNotifier& notifier);
   void UpdateConnectingState(s32 connect_rv);
   ConnectingState GetConnectingState() const;
   bool IsValid() const { return fd >= 0; }
@@ -230,6 +232,8 @@ private:
   bool nonBlock = false;
   ConnectingState connecting_state = ConnectingState::None;
   std::list<sockop> pending_sockops;
+  // Set while the pending operations are blocked until the notifier reports the host socket.
+  bool waiting_for_host = false;
 
   std::optional<Timeout> timeout;
 };
@@ -277,6 +281,7 @@ public:
   s32 GetLastNetError() const { return errno_last; }
   void SetLastNetError(s32 error) { errno_last = error; }
   void Clean() { WiiSockets.clear(); }
+  SocketNotifier& GetNotifier() { return m_notifier; }
   template <typename T>
   void DoSock(s32 sock, const Request& request, T type)
   {
@@ -304,6 +309,8 @@ private:
 
   void UpdatePollCommands();
 
+  // Declared first, since the sockets unregister themselves from it when they are destroyed.
+  SocketNotifier m_notifier;
   std::unordered_map<s32, WiiSocket> WiiSockets;
   s32 errno_last = 0;
   std::vector<PollCommand> pending_polls;
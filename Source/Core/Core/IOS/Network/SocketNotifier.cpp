@@ -0,0 +1,206 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/IOS/Network/SocketNotifier.h"
+
+#if defined(__linux__)
+#define USE_EPOLL
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+#define USE_KQUEUE
+#include <sys/event.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+
+namespace IOS::HLE
+{
+SocketNotifier::SocketNotifier()
+{
+#if defined(USE_EPOLL) || defined(USE_KQUEUE)
+#ifdef USE_EPOLL
+  m_queue_fd = epoll_create1(EPOLL_CLOEXEC);
+#else
+  m_queue_fd = kqueue();
+#endif
+  if (m_queue_fd < 0)
+  {
+    ERROR_LOG_FMT(IOS_NET, "Failed to create the socket notifier queue: {}", errno);
+    return;
+  }
+
+  // The thread is woken up through this pipe when it has to exit.
+  if (pipe(m_wakeup_fds) != 0)
+  {
+    ERROR_LOG_FMT(IOS_NET, "Failed to create the socket notifier pipe: {}", errno);
+    close(m_queue_fd);
+    m_queue_fd = -1;
+    return;
+  }
+
+#ifdef USE_EPOLL
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = m_wakeup_fds[0];
+  const bool added = epoll_ctl(m_queue_fd, EPOLL_CTL_ADD, m_wakeup_fds[0], &event) == 0;
+#else
+  struct kevent event;
+  EV_SET(&event, m_wakeup_fds[0], EVFILT_READ, EV_ADD, 0, 0, nullptr);
+  const bool added = kevent(m_queue_fd, &event, 1, nullptr, 0, nullptr) == 0;
+#endif
+  if (!added)
+  {
+    ERROR_LOG_FMT(IOS_NET, "Failed to watch the socket notifier pipe: {}", errno);
+    close(m_wakeup_fds[0]);
+    close(m_wakeup_fds[1]);
+    close(m_queue_fd);
+    m_queue_fd = -1;
+    return;
+  }
+
+  m_thread = std::thread(&SocketNotifier::ThreadFunc, this);
+#endif
+}
+
+SocketNotifier::~SocketNotifier()
+{
+#if defined(USE_EPOLL) || defined(USE_KQUEUE)
+  if (!IsActive())
+    return;
+
+  const char byte = 0;
+  while (write(m_wakeup_fds[1], &byte, 1) < 0 && errno == EINTR)
+  {
+  }
+  m_thread.join();
+
+  close(m_wakeup_fds[0]);
+  close(m_wakeup_fds[1]);
+  close(m_queue_fd);
+#endif
+}
+
+bool SocketNotifier::Arm(s32 fd, bool read, bool write)
+{
+  if (!IsActive() || fd < 0 || (!read && !write))
+    return false;
+
+#if defined(USE_EPOLL)
+  // One shot events are disabled once they are reported, so the socket isn't reported over and
+  // over again while the operations that wait for it are still queued.
+  epoll_event event{};
+  event.events = EPOLLONESHOT | (read ? EPOLLIN : 0u) | (write ? EPOLLOUT : 0u);
+  event.data.fd = fd;
+  if (epoll_ctl(m_queue_fd, EPOLL_CTL_MOD, fd, &event) == 0)
+    return true;
+  if (errno == ENOENT && epoll_ctl(m_queue_fd, EPOLL_CTL_ADD, fd, &event) == 0)
+    return true;
+#elif defined(USE_KQUEUE)
+  struct kevent events[2];
+  EV_SET(&events[0], fd, EVFILT_READ, read ? EV_ADD | EV_ONESHOT : EV_DELETE, 0, 0, nullptr);
+  EV_SET(&events[1], fd, EVFILT_WRITE, write ? EV_ADD | EV_ONESHOT : EV_DELETE, 0, 0, nullptr);
+  // Deleting a filter that isn't registered fails with ENOENT, which is reported through the
+  // receipt instead of failing the whole call.
+  events[0].flags |= EV_RECEIPT;
+  events[1].flags |= EV_RECEIPT;
+  struct kevent receipts[2];
+  const int count = kevent(m_queue_fd, events, 2, receipts, 2, nullptr);
+  if (count >= 0 && std::all_of(receipts, receipts + count, [](const struct kevent& receipt) {
+        return receipt.data == 0 || receipt.data == ENOENT;
+      }))
+  {
+    return true;
+  }
+#endif
+
+  WARN_LOG_FMT(IOS_NET, "Failed to watch socket {}: {}", fd, errno);
+  return false;
+}
+
+void SocketNotifier::Remove(s32 fd)
+{
+  if (!IsActive() || fd < 0)
+    return;
+
+#if defined(USE_EPOLL)
+  epoll_ctl(m_queue_fd, EPOLL_CTL_DEL, fd, nullptr);
+#elif defined(USE_KQUEUE)
+  struct kevent events[2];
+  EV_SET(&events[0], fd, EVFILT_READ, EV_DELETE | EV_RECEIPT, 0, 0, nullptr);
+  EV_SET(&events[1], fd, EVFILT_WRITE, EV_DELETE | EV_RECEIPT, 0, 0, nullptr);
+  struct kevent receipts[2];
+  kevent(m_queue_fd, events, 2, receipts, 2, nullptr);
+#endif
+
+  // A report that is still queued would otherwise be taken for a new socket with the same fd.
+  std::lock_guard lk(m_ready_mutex);
+  m_ready.erase(std::remove(m_ready.begin(), m_ready.end(), fd), m_ready.end());
+}
+
+std::vector<s32> SocketNotifier::TakeReadySockets()
+{
+  if (!m_has_ready.load(std::memory_order_acquire))
+    return {};
+
+  std::lock_guard lk(m_ready_mutex);
+  m_has_ready.store(false, std::memory_order_relaxed);
+  return std::exchange(m_ready, {});
+}
+
+void SocketNotifier::ThreadFunc()
+{
+  Common::SetCurrentThreadName("IOS Socket Notifier");
+
+#if defined(USE_EPOLL) || defined(USE_KQUEUE)
+  constexpr int MAX_EVENTS = 32;
+#ifdef USE_EPOLL
+  epoll_event events[MAX_EVENTS];
+#else
+  struct kevent events[MAX_EVENTS];
+#endif
+
+  while (true)
+  {
+#ifdef USE_EPOLL
+    const int count = epoll_wait(m_queue_fd, events, MAX_EVENTS, -1);
+#else
+    const int count = kevent(m_queue_fd, nullptr, 0, events, MAX_EVENTS, nullptr);
+#endif
+    if (count < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      ERROR_LOG_FMT(IOS_NET, "Socket notifier failed to wait for events: {}", errno);
+      return;
+    }
+
+    std::lock_guard lk(m_ready_mutex);
+    for (int i = 0; i < count; ++i)
+    {
+#ifdef USE_EPOLL
+      const s32 fd = events[i].data.fd;
+#else
+      const s32 fd = static_cast<s32>(events[i].ident);
+#endif
+      if (fd == m_wakeup_fds[0])
+        return;
+
+      // With kqueue, a socket that is both readable and writable is reported twice.
+      if (std::find(m_ready.begin(), m_ready.end(), fd) == m_ready.end())
+        m_ready.push_back(fd);
+    }
+    if (!m_ready.empty())
+      m_has_ready.store(true, std::memory_order_release);
+  }
+#endif
+}
+}  // namespace IOS::HLE
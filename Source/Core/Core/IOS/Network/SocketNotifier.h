@@ -0,0 +1,51 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace IOS::HLE
+{
+// Waits on its own thread for host sockets to become readable or writable, so that socket
+// operations which would block don't have to be retried on every update of the CPU thread.
+// Backed by epoll on Linux and Android and by kqueue on macOS and the BSDs. Elsewhere it is
+// inactive, and the caller keeps polling every socket.
+class SocketNotifier
+{
+public:
+  SocketNotifier();
+  ~SocketNotifier();
+  SocketNotifier(const SocketNotifier&) = delete;
+  SocketNotifier& operator=(const SocketNotifier&) = delete;
+  SocketNotifier(SocketNotifier&&) = delete;
+  SocketNotifier& operator=(SocketNotifier&&) = delete;
+
+  bool IsActive() const { return m_thread.joinable(); }
+
+  // Reports the socket once, as soon as it is readable and/or writable as requested. Re-arming a
+  // socket replaces the events it is waiting for. Returns false if the socket can't be watched.
+  bool Arm(s32 fd, bool read, bool write);
+  // Must be called before the socket is closed, as its descriptor may be reused afterwards.
+  void Remove(s32 fd);
+
+  // Returns the sockets that were reported since the last call, without any syscall.
+  std::vector<s32> TakeReadySockets();
+
+private:
+  void ThreadFunc();
+
+  s32 m_queue_fd = -1;
+  s32 m_wakeup_fds[2] = {-1, -1};
+  std::thread m_thread;
+
+  std::mutex m_ready_mutex;
+  std::vector<s32> m_ready;
+  std::atomic<bool> m_has_ready = false;
+};
+}  // namespace IOS::HLE
@@ -392,17 +392,18 @@ void BluetoothEmuDevice::Update()
 
 void BluetoothEmuDevice::ACLPool::Store(const u8* data, const u16 size, const u16 conn_handle)
 {
-  if (m_queue.size() >= 100)
+  if (m_count >= MAX_PACKETS)
   {
     // Many simultaneous exchanges of ACL packets tend to cause the queue to fill up.
-    ERROR_LOG_FMT(IOS_WIIMOTE, "ACL queue size reached 100 - current packet will be dropped!");
+    ERROR_LOG_FMT(IOS_WIIMOTE, "ACL queue size reached {} - current packet will be dropped!",
+                  MAX_PACKETS);
     return;
   }
 
   DEBUG_ASSERT_MSG(IOS_WIIMOTE, size < ACL_PKT_SIZE, "ACL packet too large for pool");
 
-  m_queue.push_back(Packet());
-  auto& packet = m_queue.back();
+  auto& packet = m_packets[(m_read_index + m_count) % MAX_PACKETS];
+  m_count++;
 
   std::copy(data, data + size, packet.data);
   packet.size = size;
@@ -411,7 +412,7 @@ void BluetoothEmuDevice::ACLPool::Store(const u8* data, const u16 size, const u1
 
 void BluetoothEmuDevice::ACLPool::WriteToEndpoint(const USB::V0BulkMessage& endpoint)
 {
-  auto& packet = m_queue.front();
+  auto& packet = m_packets[m_read_index];
 
   const u8* const data = packet.data;
   const u16 size = packet.size;
@@ -427,11 +428,30 @@ void BluetoothEmuDevice::ACLPool::WriteToEndpoint(const USB::V0BulkMessage& endp
   // Write the packet to the buffer
   std::copy(data, data + size, (u8*)header + sizeof(hci_acldata_hdr_t));
 
-  m_queue.pop_front();
+  m_read_index = (m_read_index + 1) % MAX_PACKETS;
+  m_count--;
 
   m_ios.EnqueueIPCReply(endpoint.ios_request, sizeof(hci_acldata_hdr_t) + size);
 }
 
+void BluetoothEmuDevice::ACLPool::DoState(PointerWrap& p)
+{
+  // Stored the same way as the std::deque that used to hold the packets.
+  u32 count = m_count;
+  p.Do(count);
+  if (p.IsReadMode())
+  {
+    m_read_index = 0;
+    m_count = std::min(count, MAX_PACKETS);
+  }
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    Packet discarded;
+    p.Do(i < MAX_PACKETS ? m_packets[(m_read_index + i) % MAX_PACKETS] : discarded);
+  }
+}
+
 bool BluetoothEmuDevice::SendEventInquiryComplete(u8 num_responses)
 {
   SQueuedEvent event(sizeof(SHCIEventInquiryComplete), 0);
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <deque>
 #include <memory>
@@ -71,19 +72,24 @@ private:
   std::unique_ptr<USB::V0BulkMessage> m_acl_endpoint;
   std::deque<SQueuedEvent> m_event_queue;
 
+  // Holds the ACL packets (mostly Wii Remote input reports) that arrive while the stack has no
+  // buffer for them. This is a fixed ring rather than a deque, as every packet would otherwise be
+  // a separate allocation, up to a few hundred times per second per Wii Remote.
   class ACLPool
   {
   public:
-    explicit ACLPool(Kernel& ios) : m_ios(ios), m_queue() {}
+    explicit ACLPool(Kernel& ios) : m_ios(ios) {}
     void Store(const u8* data, const u16 size, const u16 conn_handle);
 
     void WriteToEndpoint(const USB::V0BulkMessage& endpoint);
 
-    bool IsEmpty() const { return m_queue.empty(); }
+    bool IsEmpty() const { return m_count == 0; }
     // For SaveStates
-    void DoState(PointerWrap& p) { p.Do(m_queue); }
+    void DoState(PointerWrap& p);
 
   private:
+    static constexpr u32 MAX_PACKETS = 100;
+
     struct Packet
     {
       u8 data[ACL_PKT_SIZE];
@@ -92,7 +98,9 @@ private:
     };
 
     Kernel& m_ios;
-    std::deque<Packet> m_queue;
+    std::array<Packet, MAX_PACKETS> m_packets{};
+    u32 m_read_index = 0;
+    u32 m_count = 0;
   } m_acl_pool{m_ios};
 
   u32 m_packet_count[MAX_BBMOTES] = {};
@@ -4,10 +4,14 @@
 #include "Core/MemoryWatcher.h"
 
 #include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
+#include <new>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
+#include <unordered_set>
 
 #include "Common/FileUtil.h"
 #include "Core/HW/SystemTimers.h"
@@ -20,11 +24,17 @@ MemoryWatcher::MemoryWatcher()
     return;
   if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
     return;
+  OpenSharedMemory(File::GetUserPath(F_MEMORYWATCHERSHAREDMEMORY_IDX));
   m_running = true;
 }
 
 MemoryWatcher::~MemoryWatcher()
 {
+  if (m_shared_memory)
+    munmap(m_shared_memory, m_shared_size);
+  if (m_shared_fd >= 0)
+    close(m_shared_fd);
+
   if (!m_running)
     return;
 
@@ -39,23 +49,28 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   if (!locations)
     return false;
 
+  std::unordered_set<std::string> lines;
   std::string line;
   while (std::getline(locations, line))
-    ParseLine(line);
+  {
+    if (lines.insert(line).second)
+      ParseLine(line);
+  }
 
-  return !m_values.empty();
+  m_changed.reserve(m_watches.size());
+  return !m_watches.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  Watch& watch = m_watches.emplace_back();
+  watch.line = line;
 
   std::istringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,10 +82,38 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const std::string& line)
+bool MemoryWatcher::OpenSharedMemory(const std::string& path)
+{
+  const size_t size = sizeof(SharedHeader) + m_watches.size() * sizeof(SharedEntry);
+
+  m_shared_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (m_shared_fd < 0)
+    return false;
+
+  if (ftruncate(m_shared_fd, size) != 0)
+    return false;
+
+  void* const memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_shared_fd, 0);
+  if (memory == MAP_FAILED)
+    return false;
+
+  m_shared_memory = memory;
+  m_shared_size = size;
+
+  // The file was truncated, so the entries start out zeroed, like the watched values.
+  SharedHeader* const header = new (m_shared_memory) SharedHeader{};
+  header->magic = SHARED_MAGIC;
+  header->version = SHARED_VERSION;
+  header->num_entries = static_cast<u32>(m_watches.size());
+  header->entry_size = sizeof(SharedEntry);
+  header->sequence.store(0, std::memory_order_release);
+  return true;
+}
+
+u32 MemoryWatcher::ChasePointer(const Watch& watch) const
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : watch.offsets)
   {
     value = PowerPC::HostRead_U32(value + offset);
     if (!PowerPC::HostIsRAMAddress(value))
@@ -84,17 +127,18 @@ std::string MemoryWatcher::ComposeMessages()
   std::ostringstream message_stream;
   message_stream << std::hex;
 
-  for (auto& entry : m_values)
+  m_changed.clear();
+  for (size_t i = 0; i < m_watches.size(); ++i)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    Watch& watch = m_watches[i];
 
-    u32 new_value = ChasePointer(address);
-    if (new_value != current_value)
+    u32 new_value = ChasePointer(watch);
+    if (new_value != watch.value)
     {
       // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      watch.value = new_value;
+      m_changed.push_back(i);
+      message_stream << watch.line << '\n' << new_value << '\n';
     }
   }
 
@@ -109,4 +153,20 @@ void MemoryWatcher::Step()
   std::string message = ComposeMessages();
   sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
          sizeof(m_addr));
+
+  if (!m_shared_memory || m_changed.empty())
+    return;
+
+  auto* const header = static_cast<SharedHeader*>(m_shared_memory);
+  auto* const entries = reinterpret_cast<SharedEntry*>(header + 1);
+  const u64 sequence = header->sequence.load(std::memory_order_relaxed) + 2;
+
+  header->sequence.store(sequence - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i : m_changed)
+  {
+    entries[i].value = m_watches[i].value;
+    entries[i].change_sequence = sequence;
+  }
+  header->sequence.store(sequence, std::memory_order_release);
 }
@@ -5,7 +5,8 @@
 
 #include "Common/CommonTypes.h"
 
-#include <map>
+#include <atomic>
+#include <cstddef>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -19,19 +20,56 @@
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// The values are also kept in a file next to the socket which readers can map, so that they don't
+// have to keep up with the socket. It holds a SharedHeader followed by one SharedEntry for each
+// distinct line of the input file, in the order of the file. All the changes of a step are written
+// at once: the header's sequence is odd while they're being written, and each changed entry gets
+// the sequence the header has afterwards. A reader copies the entries while the sequence is even,
+// and checks that it didn't change in the meantime.
 class MemoryWatcher final
 {
 public:
+  static constexpr u32 SHARED_MAGIC = 0x534D5744;  // "DWMS"
+  static constexpr u32 SHARED_VERSION = 1;
+
+  struct SharedHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 num_entries;
+    u32 entry_size;
+    std::atomic<u64> sequence;
+  };
+
+  struct SharedEntry
+  {
+    u32 value;
+    u32 padding;
+    // The header's sequence after the last change of the value.
+    u64 change_sequence;
+  };
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step();
 
 private:
+  struct Watch
+  {
+    // Address as stored in the file
+    std::string line;
+    // Offsets to follow
+    std::vector<u32> offsets;
+    u32 value = 0;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenSharedMemory(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const std::string& line);
+  u32 ChasePointer(const Watch& watch) const;
   std::string ComposeMessages();
 
   bool m_running = false;
@@ -39,8 +77,11 @@ private:
   int m_fd;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  std::vector<Watch> m_watches;
+  // Indices of the watches which changed in the current step
+  std::vector<size_t> m_changed;
+
+  int m_shared_fd = -1;
+  void* m_shared_memory = nullptr;
+  size_t m_shared_size = 0;
 };
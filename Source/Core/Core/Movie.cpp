@@ -339,6 +339,11 @@ bool IsPlayingInput()
   return (s_playMode == PlayMode::Playing);
 }
 
+bool IsFastPlayback()
+{
+  return IsPlayingInput() && Config::Get(Config::MAIN_MOVIE_FAST_PLAYBACK);
+}
+
 bool IsMovieActive()
 {
   return s_playMode != PlayMode::None;
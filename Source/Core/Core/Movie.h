@@ -147,6 +147,9 @@ bool IsRecordingInputFromSaveState();
 bool IsJustStartingRecordingInputFromSaveState();
 bool IsJustStartingPlayingInputFromSaveState();
 bool IsPlayingInput();
+// Whether a movie is being played back with fast playback enabled. Emulation then runs without
+// the frame limiter, and the renderer skips presenting most frames.
+bool IsFastPlayback();
 bool IsMovieActive();
 bool IsReadOnly();
 u64 GetRecordingStartTime();
@@ -304,6 +304,8 @@ bool NetPlayClient::Connect()
 
     m_is_connected = true;
 
+    SendCachedSaveData();
+
     return true;
   }
 }
@@ -946,6 +948,7 @@ void NetPlayClient::OnPlayerPingData(sf::Packet& packet)
     std::lock_guard lkp(m_crit.players);
     Player& player = m_players[pid];
     packet >> player.ping;
+    packet >> player.ping_jitter;
   }
 
   DisplayPlayersPing();
@@ -1771,6 +1774,9 @@ void NetPlayClient::SyncSaveDataResponse(const bool success)
   {
     if (++m_sync_save_data_success_count >= m_sync_save_data_count)
     {
+      // Lets the host leave out the data received now when saves are synchronized next time.
+      SendCachedSaveData();
+
       sf::Packet response_packet;
       response_packet << MessageID::SyncSaveData;
       response_packet << SyncSaveDataID::Success;
@@ -1788,6 +1794,20 @@ void NetPlayClient::SyncSaveDataResponse(const bool success)
   }
 }
 
+void NetPlayClient::SendCachedSaveData()
+{
+  const std::vector<u64> hashes = GetCachedSaveDataHashes();
+
+  sf::Packet packet;
+  packet << MessageID::SyncSaveData;
+  packet << SyncSaveDataID::CachedData;
+  packet << static_cast<u32>(hashes.size());
+  for (const u64 hash : hashes)
+    packet << sf::Uint64{hash};
+
+  Send(packet);
+}
+
 void NetPlayClient::SyncCodeResponse(const bool success)
 {
   // If something failed, immediately report back that code sync failed
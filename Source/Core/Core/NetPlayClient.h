@@ -102,6 +102,7 @@ public:
   std::string name;
   std::string revision;
   u32 ping = 0;
+  u32 ping_jitter = 0;
   SyncIdentifierComparison game_status = SyncIdentifierComparison::Unknown;
 
   bool IsHost() const { return pid == 1; }
@@ -252,6 +253,7 @@ private:
   void SendStopGamePacket();
 
   void SyncSaveDataResponse(bool success);
+  void SendCachedSaveData();
   void SyncCodeResponse(bool success);
 
   bool PollLocalPad(int local_pad, sf::Packet& packet);
@@ -4,90 +4,138 @@
 #include "Core/NetPlayCommon.h"
 
 #include <algorithm>
+#include <span>
+#include <utility>
 
 #include <fmt/format.h>
-#include <lzo/lzo1x.h>
+#include <xxhash.h>
+#include <zstd.h>
 
+#include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/SFMLHelper.h"
+#include "Common/StringUtil.h"
 
 namespace NetPlay
 {
-constexpr u32 LZO_IN_LEN = 1024 * 64;
-constexpr u32 LZO_OUT_LEN = LZO_IN_LEN + (LZO_IN_LEN / 16) + 64 + 3;
+// Save data is sent with the fast levels, as they keep up with even quick connections.
+constexpr int ZSTD_COMPRESSION_LEVEL = 3;
 
-bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
+static std::string GetSaveDataCachePath()
 {
-  File::IOFile file(file_path, "rb");
-  if (!file)
+  return File::GetUserPath(D_CACHE_IDX) + "NetPlay" DIR_SEP "SaveData" DIR_SEP;
+}
+
+static std::string GetSaveDataCachePath(u64 hash)
+{
+  return fmt::format("{}{:016x}", GetSaveDataCachePath(), hash);
+}
+
+// Each piece of data is written as its size and hash, followed by either nothing if the client
+// has it cached, or the data as a zstd frame.
+static bool CompressDataIntoPacket(std::span<const u8> data, sf::Packet& packet,
+                                   const CachedDataHashes* cached_hashes)
+{
+  packet << sf::Uint64{data.size()};
+  if (data.empty())
+    return true;
+
+  const u64 hash = XXH64(data.data(), data.size(), 0);
+  const bool cached = cached_hashes && data.size() >= SAVE_DATA_CACHE_MIN_SIZE &&
+                      cached_hashes->contains(hash);
+  packet << sf::Uint64{hash} << cached;
+  if (cached)
+    return true;
+
+  std::vector<u8> compressed(ZSTD_compressBound(data.size()));
+  const size_t compressed_size = ZSTD_compress(compressed.data(), compressed.size(), data.data(),
+                                               data.size(), ZSTD_COMPRESSION_LEVEL);
+  if (ZSTD_isError(compressed_size))
   {
-    PanicAlertFmtT("Failed to open file \"{0}\".", file_path);
+    PanicAlertFmtT("Internal zstd error - compression failed");
     return false;
   }
 
-  const sf::Uint64 size = file.GetSize();
-  packet << size;
+  packet << static_cast<u32>(compressed_size);
+  packet.append(compressed.data(), compressed_size);
+  return true;
+}
 
+static std::optional<std::vector<u8>> DecompressPacketIntoData(sf::Packet& packet)
+{
+  const u64 size = Common::PacketReadU64(packet);
   if (size == 0)
-    return true;
+    return std::vector<u8>();
 
-  std::vector<u8> in_buffer(LZO_IN_LEN);
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+  const u64 hash = Common::PacketReadU64(packet);
+  bool cached;
+  packet >> cached;
+  if (!packet)
+    return std::nullopt;
 
-  lzo_uint i = 0;
-  while (true)
+  if (cached)
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
+    std::string contents;
+    if (!File::ReadFileToString(GetSaveDataCachePath(hash), contents) || contents.size() != size ||
+        XXH64(contents.data(), contents.size(), 0) != hash)
     {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
+      PanicAlertFmtT("Save data cached from an earlier NetPlay session is missing or damaged.");
+      return std::nullopt;
     }
 
-    if (cur_len <= 0)
-      break;  // EOF
+    return std::vector<u8>(contents.begin(), contents.end());
+  }
 
-    if (!file.ReadBytes(in_buffer.data(), cur_len))
-    {
-      PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
-      return false;
-    }
+  std::string compressed;
+  packet >> compressed;
+  if (!packet || ZSTD_getFrameContentSize(compressed.data(), compressed.size()) != size)
+  {
+    PanicAlertFmtT("Internal zstd error - decompression failed");
+    return std::nullopt;
+  }
 
-    if (lzo1x_1_compress(in_buffer.data(), cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
-      return false;
-    }
+  std::vector<u8> data(size);
+  if (ZSTD_decompress(data.data(), data.size(), compressed.data(), compressed.size()) != size ||
+      XXH64(data.data(), data.size(), 0) != hash)
+  {
+    PanicAlertFmtT("Internal zstd error - decompression failed");
+    return std::nullopt;
+  }
 
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
+  // Failing to cache the data only means that it has to be sent again next time.
+  if (size >= SAVE_DATA_CACHE_MIN_SIZE && File::CreateFullPath(GetSaveDataCachePath()))
+  {
+    File::IOFile file(GetSaveDataCachePath(hash), "wb");
+    file.WriteBytes(data.data(), data.size());
+  }
 
-    if (cur_len != LZO_IN_LEN)
-      break;
+  return data;
+}
 
-    i += cur_len;
+bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet,
+                            const CachedDataHashes* cached_hashes)
+{
+  File::IOFile file(file_path, "rb");
+  if (!file)
+  {
+    PanicAlertFmtT("Failed to open file \"{0}\".", file_path);
+    return false;
   }
 
-  // Mark end of data
-  packet << static_cast<u32>(0);
+  std::vector<u8> data(file.GetSize());
+  if (!file.ReadBytes(data.data(), data.size()))
+  {
+    PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
+    return false;
+  }
 
-  return true;
+  return CompressDataIntoPacket(data, packet, cached_hashes);
 }
 
-static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::Packet& packet)
+static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::Packet& packet,
+                                             const CachedDataHashes* cached_hashes)
 {
   const sf::Uint64 size = folder.children.size();
   packet << size;
@@ -96,15 +144,17 @@ static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::P
     const bool is_folder = child.isDirectory;
     packet << child.virtualName;
     packet << is_folder;
-    const bool success = is_folder ? CompressFolderIntoPacketInternal(child, packet) :
-                                     CompressFileIntoPacket(child.physicalName, packet);
+    const bool success =
+        is_folder ? CompressFolderIntoPacketInternal(child, packet, cached_hashes) :
+                    CompressFileIntoPacket(child.physicalName, packet, cached_hashes);
     if (!success)
       return false;
   }
   return true;
 }
 
-bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet)
+bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet,
+                              const CachedDataHashes* cached_hashes)
 {
   if (!File::IsDirectory(folder_path))
   {
@@ -113,69 +163,23 @@ bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet
   }
 
   packet << true;
-  return CompressFolderIntoPacketInternal(File::ScanDirectoryTree(folder_path, true), packet);
+  return CompressFolderIntoPacketInternal(File::ScanDirectoryTree(folder_path, true), packet,
+                                          cached_hashes);
 }
 
-bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet)
+bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet,
+                              const CachedDataHashes* cached_hashes)
 {
-  const sf::Uint64 size = in_buffer.size();
-  packet << size;
-
-  if (size == 0)
-    return true;
-
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
-
-  lzo_uint i = 0;
-  while (true)
-  {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // end of buffer
-
-    if (lzo1x_1_compress(&in_buffer[i], cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
-      return false;
-    }
-
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
-
-    if (cur_len != LZO_IN_LEN)
-      break;
-
-    i += cur_len;
-  }
-
-  // Mark end of data
-  packet << static_cast<u32>(0);
-
-  return true;
+  return CompressDataIntoPacket(in_buffer, packet, cached_hashes);
 }
 
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
 {
-  u64 file_size = Common::PacketReadU64(packet);
+  const std::optional<std::vector<u8>> data = DecompressPacketIntoData(packet);
+  if (!data)
+    return false;
 
-  if (file_size == 0)
+  if (data->empty())
     return true;
 
   File::IOFile file(file_path, "wb");
@@ -185,35 +189,10 @@ bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
     return false;
   }
 
-  std::vector<u8> in_buffer(LZO_OUT_LEN);
-  std::vector<u8> out_buffer(LZO_IN_LEN);
-
-  while (true)
+  if (!file.WriteBytes(data->data(), data->size()))
   {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
-
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
-
-    for (size_t j = 0; j < cur_len; j++)
-    {
-      packet >> in_buffer[j];
-    }
-
-    if (lzo1x_decompress(in_buffer.data(), cur_len, out_buffer.data(), &new_len, nullptr) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - decompression failed");
-      return false;
-    }
-
-    if (!file.WriteBytes(out_buffer.data(), new_len))
-    {
-      PanicAlertFmtT("Error writing file: {0}", file_path);
-      return false;
-    }
+    PanicAlertFmtT("Error writing file: {0}", file_path);
+    return false;
   }
 
   return true;
@@ -262,39 +241,49 @@ bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_pa
 
 std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet)
 {
-  u64 size = Common::PacketReadU64(packet);
-
-  std::vector<u8> out_buffer(size);
-
-  if (size == 0)
-    return out_buffer;
-
-  std::vector<u8> in_buffer(LZO_OUT_LEN);
+  return DecompressPacketIntoData(packet);
+}
 
-  lzo_uint i = 0;
-  while (true)
+std::vector<u64> GetCachedSaveDataHashes()
+{
+  struct CacheEntry
   {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
-
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
-
-    for (size_t j = 0; j < cur_len; j++)
+    std::string path;
+    u64 hash;
+    u64 size;
+    s64 time;
+  };
+
+  std::vector<CacheEntry> entries;
+  const File::FSTEntry cache = File::ScanDirectoryTree(GetSaveDataCachePath(), false);
+  for (const File::FSTEntry& child : cache.children)
+  {
+    u64 hash;
+    if (child.isDirectory || child.virtualName.size() != 16 ||
+        !TryParse(child.virtualName, &hash, 16))
     {
-      packet >> in_buffer[j];
+      continue;
     }
 
-    if (lzo1x_decompress(in_buffer.data(), cur_len, &out_buffer[i], &new_len, nullptr) != LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - decompression failed");
-      return {};
-    }
+    const s64 time = File::FileInfo(child.physicalName).GetModificationTime();
+    entries.push_back({child.physicalName, hash, child.size, time});
+  }
 
-    i += new_len;
+  // Keep the most recently received data.
+  std::sort(entries.begin(), entries.end(),
+            [](const CacheEntry& a, const CacheEntry& b) { return a.time > b.time; });
+
+  std::vector<u64> hashes;
+  u64 total_size = 0;
+  for (const CacheEntry& entry : entries)
+  {
+    total_size += entry.size;
+    if (total_size > SAVE_DATA_CACHE_MAX_SIZE)
+      File::Delete(entry.path);
+    else
+      hashes.push_back(entry.hash);
   }
 
-  return out_buffer;
+  return hashes;
 }
 }  // namespace NetPlay
@@ -9,6 +9,7 @@
 #include <chrono>
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -20,10 +21,26 @@ using namespace std::chrono_literals;
 // connection is disconnected
 constexpr std::chrono::milliseconds PEER_TIMEOUT = 30s;
 
-bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet);
-bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet);
-bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet);
+// Clients keep received save data of at least this size in a cache, keyed by its hash, so that
+// the host only has to send the hash if the data is unchanged in a later session. The least
+// recently received data is dropped once the cache grows beyond SAVE_DATA_CACHE_MAX_SIZE.
+constexpr u64 SAVE_DATA_CACHE_MIN_SIZE = 64 * 1024;
+constexpr u64 SAVE_DATA_CACHE_MAX_SIZE = 256 * 1024 * 1024;
+
+// The hashes of the data in a client's save data cache.
+using CachedDataHashes = std::unordered_set<u64>;
+
+// Data whose hash is in cached_hashes is sent as just its hash.
+bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet,
+                            const CachedDataHashes* cached_hashes = nullptr);
+bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet,
+                              const CachedDataHashes* cached_hashes = nullptr);
+bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet,
+                              const CachedDataHashes* cached_hashes = nullptr);
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path);
 bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path);
 std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet);
+
+// Returns the hashes of the data in the local save data cache, after dropping old data.
+std::vector<u64> GetCachedSaveDataHashes();
 }  // namespace NetPlay
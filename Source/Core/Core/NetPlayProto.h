@@ -203,7 +203,8 @@ enum class SyncSaveDataID : u8
   RawData = 3,
   GCIData = 4,
   WiiData = 5,
-  GBAData = 6
+  GBAData = 6,
+  CachedData = 7
 };
 
 enum class SyncCodeID : u8
@@ -5,8 +5,10 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdio>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -161,6 +163,7 @@ NetPlayServer::NetPlayServer(const u16 port, const bool forward_port, NetPlayUI*
     m_do_loop = true;
     m_thread = std::thread(&NetPlayServer::ThreadFunc, this);
     m_target_buffer_size = 5;
+    m_adaptive_buffer = Config::Get(Config::NETPLAY_ADAPTIVE_BUFFER);
     m_chunked_data_thread = std::thread(&NetPlayServer::ChunkedDataThreadFunc, this);
 
 #ifdef USE_UPNP
@@ -258,6 +261,8 @@ void NetPlayServer::ThreadFunc()
       m_index.SetGame(m_selected_game_name);
       m_index.SetInGame(m_is_running);
 
+      UpdateAdaptiveBufferSize();
+
       m_update_pings = false;
     }
 
@@ -285,85 +290,98 @@ void NetPlayServer::ThreadFunc()
     }
     if (net > 0)
     {
-      switch (netEvent.type)
-      {
-      case ENET_EVENT_TYPE_CONNECT:
-      {
-        // Actual client initialization is deferred to the receive event, so here
-        // we'll just log the new connection.
-        INFO_LOG_FMT(NETPLAY, "Peer connected from: {:x}:{}", netEvent.peer->address.host,
-                     netEvent.peer->address.port);
-      }
-      break;
-      case ENET_EVENT_TYPE_RECEIVE:
+      // Everything that has arrived is handled before relaying pad data, so that the inputs of
+      // several players go out in one packet per client.
+      do
       {
-        sf::Packet rpac;
-        rpac.append(netEvent.packet->data, netEvent.packet->dataLength);
+        OnENetEvent(netEvent);
+      } while (enet_host_check_events(m_server, &netEvent) > 0);
 
-        if (!netEvent.peer->data)
-        {
-          // uninitialized client, we'll assume this is their initialization packet
-          ConnectionError error;
-          {
-            std::lock_guard lkg(m_crit.game);
-            error = OnConnect(netEvent.peer, rpac);
-          }
+      FlushPadData();
+    }
+  }
 
-          if (error != ConnectionError::NoError)
-          {
-            sf::Packet spac;
-            spac << error;
-            // don't need to lock, this client isn't in the client map
-            Send(netEvent.peer, spac);
+  // close listening socket and client sockets
+  for (auto& player_entry : m_players)
+  {
+    ClearPeerPlayerId(player_entry.second.socket);
+    enet_peer_disconnect(player_entry.second.socket, 0);
+  }
+  m_players.clear();
+}
 
-            ClearPeerPlayerId(netEvent.peer);
-            enet_peer_disconnect_later(netEvent.peer, 0);
-          }
-        }
-        else
-        {
-          auto it = m_players.find(*PeerPlayerId(netEvent.peer));
-          Client& client = it->second;
-          if (OnData(rpac, client) != 0)
-          {
-            // if a bad packet is received, disconnect the client
-            std::lock_guard lkg(m_crit.game);
-            OnDisconnect(client);
+// called from ---NETPLAY--- thread
+void NetPlayServer::OnENetEvent(ENetEvent& net_event)
+{
+  switch (net_event.type)
+  {
+  case ENET_EVENT_TYPE_CONNECT:
+  {
+    // Actual client initialization is deferred to the receive event, so here
+    // we'll just log the new connection.
+    INFO_LOG_FMT(NETPLAY, "Peer connected from: {:x}:{}", net_event.peer->address.host,
+                 net_event.peer->address.port);
+  }
+  break;
+  case ENET_EVENT_TYPE_RECEIVE:
+  {
+    sf::Packet rpac;
+    rpac.append(net_event.packet->data, net_event.packet->dataLength);
 
-            ClearPeerPlayerId(netEvent.peer);
-          }
-        }
-        enet_packet_destroy(netEvent.packet);
-      }
-      break;
-      case ENET_EVENT_TYPE_DISCONNECT:
+    if (!net_event.peer->data)
+    {
+      // uninitialized client, we'll assume this is their initialization packet
+      ConnectionError error;
       {
         std::lock_guard lkg(m_crit.game);
-        if (!netEvent.peer->data)
-          break;
-        auto it = m_players.find(*PeerPlayerId(netEvent.peer));
-        if (it != m_players.end())
-        {
-          Client& client = it->second;
-          OnDisconnect(client);
+        error = OnConnect(net_event.peer, rpac);
+      }
 
-          ClearPeerPlayerId(netEvent.peer);
-        }
+      if (error != ConnectionError::NoError)
+      {
+        sf::Packet spac;
+        spac << error;
+        // don't need to lock, this client isn't in the client map
+        Send(net_event.peer, spac);
+
+        ClearPeerPlayerId(net_event.peer);
+        enet_peer_disconnect_later(net_event.peer, 0);
       }
-      break;
-      default:
-        break;
+    }
+    else
+    {
+      auto it = m_players.find(*PeerPlayerId(net_event.peer));
+      Client& client = it->second;
+      if (OnData(rpac, client) != 0)
+      {
+        // if a bad packet is received, disconnect the client
+        std::lock_guard lkg(m_crit.game);
+        OnDisconnect(client);
+
+        ClearPeerPlayerId(net_event.peer);
       }
     }
+    enet_packet_destroy(net_event.packet);
   }
-
-  // close listening socket and client sockets
-  for (auto& player_entry : m_players)
+  break;
+  case ENET_EVENT_TYPE_DISCONNECT:
   {
-    ClearPeerPlayerId(player_entry.second.socket);
-    enet_peer_disconnect(player_entry.second.socket, 0);
+    std::lock_guard lkg(m_crit.game);
+    if (!net_event.peer->data)
+      break;
+    auto it = m_players.find(*PeerPlayerId(net_event.peer));
+    if (it != m_players.end())
+    {
+      Client& client = it->second;
+      OnDisconnect(client);
+
+      ClearPeerPlayerId(net_event.peer);
+    }
+  }
+  break;
+  default:
+    break;
   }
-  m_players.clear();
 }
 
 static void SendSyncIdentifier(sf::Packet& spac, const SyncIdentifier& sync_identifier)
@@ -634,6 +652,68 @@ void NetPlayServer::AdjustPadBufferSize(unsigned int size)
   }
 }
 
+// called from ---GUI--- thread
+void NetPlayServer::SetAdaptiveBuffer(const bool enable)
+{
+  std::lock_guard lkg(m_crit.game);
+  m_adaptive_buffer = enable;
+  m_adaptive_buffer_lower_rounds = 0;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::UpdateAdaptiveBufferSize()
+{
+  // Frames of input the buffer has to cover at most, and how many ping rounds in a row the
+  // latency has to call for a smaller buffer before it's lowered by one. Raising it right away
+  // and lowering it slowly avoids stutter from a buffer that keeps changing.
+  constexpr u32 MAX_ADAPTIVE_BUFFER_SIZE = 40;
+  constexpr u32 ADAPTIVE_BUFFER_LOWER_DELAY = 5;
+  constexpr double FRAME_TIME_MS = 1000.0 / 60.0;
+
+  std::lock_guard lkg(m_crit.game);
+  if (!m_adaptive_buffer || m_host_input_authority || !m_is_running)
+    return;
+
+  // Inputs go from one player through the server to the others, so the buffer has to cover about
+  // half of the two highest round trip times, plus a margin for jitter.
+  u32 highest_ping = 0;
+  u32 second_highest_ping = 0;
+  u32 highest_jitter = 0;
+  for (const auto& [pid, player] : m_players)
+  {
+    if (player.smoothed_ping > highest_ping)
+    {
+      second_highest_ping = highest_ping;
+      highest_ping = player.smoothed_ping;
+    }
+    else if (player.smoothed_ping > second_highest_ping)
+    {
+      second_highest_ping = player.smoothed_ping;
+    }
+    highest_jitter = std::max(highest_jitter, player.ping_jitter);
+  }
+
+  const double latency_ms = (highest_ping + second_highest_ping) / 2.0 + highest_jitter * 2.0;
+  const u32 target = std::clamp(static_cast<u32>(std::ceil(latency_ms / FRAME_TIME_MS)), 1u,
+                                MAX_ADAPTIVE_BUFFER_SIZE);
+
+  if (target > m_target_buffer_size)
+  {
+    m_adaptive_buffer_lower_rounds = 0;
+    AdjustPadBufferSize(target);
+  }
+  else if (target < m_target_buffer_size &&
+           ++m_adaptive_buffer_lower_rounds >= ADAPTIVE_BUFFER_LOWER_DELAY)
+  {
+    m_adaptive_buffer_lower_rounds = 0;
+    AdjustPadBufferSize(m_target_buffer_size - 1);
+  }
+  else if (target == m_target_buffer_size)
+  {
+    m_adaptive_buffer_lower_rounds = 0;
+  }
+}
+
 void NetPlayServer::SetHostInputAuthority(const bool enable)
 {
   std::lock_guard lkg(m_crit.game);
@@ -750,8 +830,7 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (player.current_game != m_current_game)
       break;
 
-    sf::Packet spac;
-    spac << (m_host_input_authority ? MessageID::PadHostData : MessageID::PadData);
+    sf::Packet pad_data;
 
     while (!packet.endOfPacket())
     {
@@ -767,14 +846,14 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 
       GCPadStatus pad;
       packet >> pad.button;
-      spac << map << pad.button;
+      pad_data << map << pad.button;
       if (!m_gba_config.at(map).enabled)
       {
         packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
             pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
 
-        spac << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-             << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
+        pad_data << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
+                 << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
       }
     }
 
@@ -782,11 +861,17 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     {
       // Prevent crash before game stop if the golfer disconnects
       if (m_current_golfer != 0 && m_players.find(m_current_golfer) != m_players.end())
+      {
+        sf::Packet spac;
+        spac << MessageID::PadHostData;
+        spac.append(pad_data.getData(), pad_data.getDataSize());
         Send(m_players.at(m_current_golfer).socket, spac);
+      }
     }
     else
     {
-      SendToClients(spac, player.pid);
+      // Relayed by FlushPadData, together with the data of the other players.
+      m_pending_pad_data.emplace_back(player.pid, std::move(pad_data));
     }
   }
   break;
@@ -927,12 +1012,28 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (m_ping_key == ping_key)
     {
       player.ping = ping;
+
+      // Estimated the way TCP estimates its retransmission timeout (RFC 6298).
+      if (!player.ping_measured)
+      {
+        player.smoothed_ping = ping;
+        player.ping_jitter = ping / 2;
+        player.ping_measured = true;
+      }
+      else
+      {
+        const u32 deviation =
+            ping > player.smoothed_ping ? ping - player.smoothed_ping : player.smoothed_ping - ping;
+        player.ping_jitter = (player.ping_jitter * 3 + deviation) / 4;
+        player.smoothed_ping = (player.smoothed_ping * 7 + ping) / 8;
+      }
     }
 
     sf::Packet spac;
     spac << MessageID::PlayerPingData;
     spac << player.pid;
     spac << player.ping;
+    spac << player.ping_jitter;
 
     SendToClients(spac);
   }
@@ -1103,6 +1204,20 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     }
     break;
 
+    case SyncSaveDataID::CachedData:
+    {
+      u32 count;
+      packet >> count;
+
+      CachedDataHashes cached_hashes;
+      for (u32 i = 0; i < count && packet; i++)
+        cached_hashes.insert(Common::PacketReadU64(packet));
+
+      std::lock_guard lkp(m_crit.players);
+      player.cached_save_data = std::move(cached_hashes);
+    }
+    break;
+
     case SyncSaveDataID::Failure:
     {
       m_dialog->AppendChat(Common::FmtFormatT("{0} failed to synchronize.", player.name));
@@ -1703,205 +1818,314 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
               static_cast<u16>(Memcard::MBIT_SIZE_MEMORY_CARD_59 << size_override) :
               Memcard::MBIT_SIZE_MEMORY_CARD_2043;
       const std::string path = Config::GetMemcardPath(slot, game_region, card_size_mbits);
+      const bool exists = File::Exists(path);
 
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::RawData;
-      pac << is_slot_a << region << size_override;
-
-      if (File::Exists(path))
+      if (exists)
       {
         INFO_LOG_FMT(NETPLAY, "Sending data of raw memcard {} in slot {}.", path,
                      is_slot_a ? 'A' : 'B');
-        if (!CompressFileIntoPacket(path, pac))
-          return false;
       }
       else
       {
-        // No file, so we'll say the size is 0
         INFO_LOG_FMT(NETPLAY, "Sending empty marker for raw memcard {} in slot {}.", path,
                      is_slot_a ? 'A' : 'B');
-        pac << sf::Uint64{0};
       }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+      const auto build_packet = [&](sf::Packet& pac, const CachedDataHashes* cached_hashes) {
+        pac << MessageID::SyncSaveData;
+        pac << SyncSaveDataID::RawData;
+        pac << is_slot_a << region << size_override;
+
+        // No file, so we'll say the size is 0
+        if (!exists)
+        {
+          pac << sf::Uint64{0};
+          return true;
+        }
+
+        return CompressFileIntoPacket(path, pac, cached_hashes);
+      };
+
+      if (!SendSaveDataToClients(
+              build_packet, fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B')))
+      {
+        return false;
+      }
     }
     else if (Config::Get(Config::GetInfoForEXIDevice(slot)) ==
              ExpansionInterface::EXIDeviceType::MemoryCardFolder)
     {
       const std::string path = Config::GetGCIFolderPath(slot, gamecube_region);
 
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::GCIData;
-      pac << is_slot_a;
-
+      std::vector<std::string> files;
       if (File::IsDirectory(path))
       {
-        std::vector<std::string> files =
+        files =
             GCMemcardDirectory::GetFileNamesForGameID(path + DIR_SEP, sync_info.game->GetGameID());
 
         INFO_LOG_FMT(NETPLAY, "Sending data of GCI memcard {} in slot {} ({} files).", path,
                      is_slot_a ? 'A' : 'B', files.size());
+      }
+      else
+      {
+        INFO_LOG_FMT(NETPLAY, "Sending empty marker for GCI memcard {} in slot {}.", path,
+                     is_slot_a ? 'A' : 'B');
+      }
 
+      const auto build_packet = [&](sf::Packet& pac, const CachedDataHashes* cached_hashes) {
+        pac << MessageID::SyncSaveData;
+        pac << SyncSaveDataID::GCIData;
+        pac << is_slot_a;
         pac << static_cast<u8>(files.size());
 
         for (const std::string& file : files)
         {
           const std::string filename = file.substr(file.find_last_of('/') + 1);
-          INFO_LOG_FMT(NETPLAY, "Sending GCI {}.", filename);
           pac << filename;
-          if (!CompressFileIntoPacket(file, pac))
+          if (!CompressFileIntoPacket(file, pac, cached_hashes))
             return false;
         }
-      }
-      else
-      {
-        INFO_LOG_FMT(NETPLAY, "Sending empty marker for GCI memcard {} in slot {}.", path,
-                     is_slot_a ? 'A' : 'B');
 
-        pac << static_cast<u8>(0);
-      }
+        return true;
+      };
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'));
+      if (!SendSaveDataToClients(
+              build_packet, fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B')))
+      {
+        return false;
+      }
     }
   }
 
   if (sync_info.has_wii_save)
   {
-    sf::Packet pac;
-    pac << MessageID::SyncSaveData;
-    pac << SyncSaveDataID::WiiData;
-
-    // Shove the Mii data into the start the packet
-    if (sync_info.mii_data)
+    struct WiiSaveData
+    {
+      u64 title_id;
+      std::optional<WiiSave::Header> header;
+      std::optional<WiiSave::BkHeader> bk_header;
+      std::optional<std::vector<WiiSave::Storage::SaveFile>> files;
+    };
+
+    // Read the saves once, rather than for each client's packet.
+    std::vector<WiiSaveData> wii_saves;
+    for (const auto& [title_id, storage] : sync_info.wii_saves)
     {
-      INFO_LOG_FMT(NETPLAY, "Sending Mii data.");
-      pac << true;
-      if (!CompressBufferIntoPacket(*sync_info.mii_data, pac))
+      WiiSaveData& save = wii_saves.emplace_back(WiiSaveData{title_id});
+      if (!storage->SaveExists())
+      {
+        INFO_LOG_FMT(NETPLAY, "No data for Wii save of title {:016x}.", title_id);
+        continue;
+      }
+
+      save.header = storage->ReadHeader();
+      save.bk_header = storage->ReadBkHeader();
+      save.files = storage->ReadFiles();
+      if (!save.header || !save.bk_header || !save.files)
+      {
+        INFO_LOG_FMT(NETPLAY, "Wii save of title {:016x} is corrupted.", title_id);
         return false;
+      }
+
+      INFO_LOG_FMT(NETPLAY, "Sending Wii save of title {:016x}.", title_id);
+      for (const WiiSave::Storage::SaveFile& file : *save.files)
+      {
+        INFO_LOG_FMT(NETPLAY, "Sending Wii save data of type {} at {}",
+                     static_cast<u8>(file.type), file.path);
+      }
+    }
+
+    INFO_LOG_FMT(NETPLAY, "{} Mii data.", sync_info.mii_data ? "Sending" : "Not sending");
+    INFO_LOG_FMT(NETPLAY, "Sending {} Wii saves.", wii_saves.size());
+    if (sync_info.redirected_save)
+    {
+      INFO_LOG_FMT(NETPLAY, "Sending redirected save at {}.",
+                   sync_info.redirected_save->m_target_path);
     }
     else
     {
-      INFO_LOG_FMT(NETPLAY, "Not sending Mii data.");
-      pac << false;  // no mii data
+      INFO_LOG_FMT(NETPLAY, "Not sending redirected save.");
     }
 
-    // Carry on with the save files
-    INFO_LOG_FMT(NETPLAY, "Sending {} Wii saves.", sync_info.wii_saves.size());
-    pac << static_cast<u32>(sync_info.wii_saves.size());
+    const auto build_packet = [&](sf::Packet& pac, const CachedDataHashes* cached_hashes) {
+      pac << MessageID::SyncSaveData;
+      pac << SyncSaveDataID::WiiData;
 
-    for (const auto& [title_id, storage] : sync_info.wii_saves)
-    {
-      pac << sf::Uint64{title_id};
+      // Shove the Mii data into the start the packet
+      if (sync_info.mii_data)
+      {
+        pac << true;
+        if (!CompressBufferIntoPacket(*sync_info.mii_data, pac, cached_hashes))
+          return false;
+      }
+      else
+      {
+        pac << false;  // no mii data
+      }
+
+      // Carry on with the save files
+      pac << static_cast<u32>(wii_saves.size());
 
-      if (storage->SaveExists())
+      for (const WiiSaveData& save : wii_saves)
       {
-        const std::optional<WiiSave::Header> header = storage->ReadHeader();
-        const std::optional<WiiSave::BkHeader> bk_header = storage->ReadBkHeader();
-        const std::optional<std::vector<WiiSave::Storage::SaveFile>> files = storage->ReadFiles();
-        if (!header || !bk_header || !files)
+        pac << sf::Uint64{save.title_id};
+
+        if (!save.header)
         {
-          INFO_LOG_FMT(NETPLAY, "Wii save of title {:016x} is corrupted.", title_id);
-          return false;
+          pac << false;  // save does not exist
+          continue;
         }
 
-        INFO_LOG_FMT(NETPLAY, "Sending Wii save of title {:016x}.", title_id);
         pac << true;  // save exists
 
         // Header
-        pac << sf::Uint64{header->tid};
-        pac << header->banner_size << header->permissions << header->unk1;
-        for (u8 byte : header->md5)
+        const WiiSave::Header& header = *save.header;
+        pac << sf::Uint64{header.tid};
+        pac << header.banner_size << header.permissions << header.unk1;
+        for (u8 byte : header.md5)
           pac << byte;
-        pac << header->unk2;
-        for (size_t i = 0; i < header->banner_size; i++)
-          pac << header->banner[i];
+        pac << header.unk2;
+        for (size_t i = 0; i < header.banner_size; i++)
+          pac << header.banner[i];
 
         // BkHeader
-        pac << bk_header->size << bk_header->magic << bk_header->ngid << bk_header->number_of_files
-            << bk_header->size_of_files << bk_header->unk1 << bk_header->unk2
-            << bk_header->total_size;
-        for (u8 byte : bk_header->unk3)
+        const WiiSave::BkHeader& bk_header = *save.bk_header;
+        pac << bk_header.size << bk_header.magic << bk_header.ngid << bk_header.number_of_files
+            << bk_header.size_of_files << bk_header.unk1 << bk_header.unk2
+            << bk_header.total_size;
+        for (u8 byte : bk_header.unk3)
           pac << byte;
-        pac << sf::Uint64{bk_header->tid};
-        for (u8 byte : bk_header->mac_address)
+        pac << sf::Uint64{bk_header.tid};
+        for (u8 byte : bk_header.mac_address)
           pac << byte;
 
         // Files
-        for (const WiiSave::Storage::SaveFile& file : *files)
+        for (const WiiSave::Storage::SaveFile& file : *save.files)
         {
-          INFO_LOG_FMT(NETPLAY, "Sending Wii save data of type {} at {}",
-                       static_cast<u8>(file.type), file.path);
-
           pac << file.mode << file.attributes << file.type << file.path;
 
           if (file.type == WiiSave::Storage::SaveFile::Type::File)
           {
             const std::optional<std::vector<u8>>& data = *file.data;
-            if (!data || !CompressBufferIntoPacket(*data, pac))
+            if (!data || !CompressBufferIntoPacket(*data, pac, cached_hashes))
               return false;
           }
         }
       }
-      else
+
+      if (sync_info.redirected_save)
       {
-        INFO_LOG_FMT(NETPLAY, "No data for Wii save of title {:016x}.", title_id);
-        pac << false;  // save does not exist
+        pac << true;
+        return CompressFolderIntoPacket(sync_info.redirected_save->m_target_path, pac,
+                                        cached_hashes);
       }
-    }
 
-    if (sync_info.redirected_save)
-    {
-      INFO_LOG_FMT(NETPLAY, "Sending redirected save at {}.",
-                   sync_info.redirected_save->m_target_path);
-      pac << true;
-      if (!CompressFolderIntoPacket(sync_info.redirected_save->m_target_path, pac))
-        return false;
-    }
-    else
-    {
-      INFO_LOG_FMT(NETPLAY, "Not sending redirected save.");
       pac << false;  // no redirected save
-    }
+      return true;
+    };
 
-    SendChunkedToClients(std::move(pac), 1, "Wii Save Synchronization");
+    if (!SendSaveDataToClients(build_packet, "Wii Save Synchronization"))
+      return false;
   }
 
   for (size_t i = 0; i < m_gba_config.size(); ++i)
   {
     if (m_gba_config[i].enabled && m_gba_config[i].has_rom)
     {
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::GBAData;
-      pac << static_cast<u8>(i);
-
       std::string path;
 #ifdef HAS_LIBMGBA
       path = HW::GBA::Core::GetSavePath(Config::Get(Config::MAIN_GBA_ROM_PATHS[i]),
                                         static_cast<int>(i));
 #endif
-      if (File::Exists(path))
-      {
+      const bool exists = File::Exists(path);
+      if (exists)
         INFO_LOG_FMT(NETPLAY, "Sending data of GBA save at {} for slot {}.", path, i);
-        if (!CompressFileIntoPacket(path, pac))
-          return false;
-      }
       else
-      {
-        // No file, so we'll say the size is 0
         INFO_LOG_FMT(NETPLAY, "Sending empty marker for GBA save at {} for slot {}.", path, i);
-        pac << sf::Uint64{0};
+
+      const auto build_packet = [&](sf::Packet& pac, const CachedDataHashes* cached_hashes) {
+        pac << MessageID::SyncSaveData;
+        pac << SyncSaveDataID::GBAData;
+        pac << static_cast<u8>(i);
+
+        // No file, so we'll say the size is 0
+        if (!exists)
+        {
+          pac << sf::Uint64{0};
+          return true;
+        }
+
+        return CompressFileIntoPacket(path, pac, cached_hashes);
+      };
+
+      if (!SendSaveDataToClients(build_packet,
+                                 fmt::format("GBA{} Save File Synchronization", i + 1)))
+      {
+        return false;
       }
+    }
+  }
+
+  return true;
+}
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GBA{} Save File Synchronization", i + 1));
+// called from ---GUI--- thread
+bool NetPlayServer::SendSaveDataToClients(
+    const std::function<bool(sf::Packet&, const CachedDataHashes*)>& build_packet,
+    const std::string& title)
+{
+  std::vector<std::pair<PlayerId, CachedDataHashes>> player_caches;
+  {
+    std::lock_guard lkp(m_crit.players);
+    for (const auto& [pid, player] : m_players)
+    {
+      if (!player.IsHost() && !player.cached_save_data.empty())
+        player_caches.emplace_back(pid, player.cached_save_data);
     }
   }
 
+  sf::Packet full_packet;
+  if (!build_packet(full_packet, nullptr))
+    return false;
+
+  // Leaving out cached data makes a packet smaller, so packets of the same size as the full one
+  // are the same as it.
+  std::vector<std::pair<PlayerId, sf::Packet>> reduced_packets;
+  for (const auto& [pid, cached_hashes] : player_caches)
+  {
+    sf::Packet pac;
+    if (!build_packet(pac, &cached_hashes))
+      return false;
+
+    if (pac.getDataSize() != full_packet.getDataSize())
+    {
+      INFO_LOG_FMT(NETPLAY, "Player {} has {} of {} bytes of save data cached.", pid,
+                   full_packet.getDataSize() - pac.getDataSize(), full_packet.getDataSize());
+      reduced_packets.emplace_back(pid, std::move(pac));
+    }
+  }
+
+  if (reduced_packets.empty())
+  {
+    SendChunkedToClients(std::move(full_packet), 1, title);
+    return true;
+  }
+
+  {
+    std::lock_guard lkp(m_crit.players);
+    for (const auto& [pid, player] : m_players)
+    {
+      const bool reduced =
+          std::any_of(reduced_packets.begin(), reduced_packets.end(),
+                      [pid = pid](const auto& entry) { return entry.first == pid; });
+      if (!player.IsHost() && !reduced)
+        SendChunked(sf::Packet(full_packet), pid, title);
+    }
+  }
+
+  for (auto& [pid, pac] : reduced_packets)
+    SendChunked(std::move(pac), pid, title);
+
   return true;
 }
 
@@ -2070,6 +2294,36 @@ void NetPlayServer::SendToClients(const sf::Packet& packet, const PlayerId skip_
   }
 }
 
+// called from ---NETPLAY--- thread
+void NetPlayServer::FlushPadData()
+{
+  if (m_pending_pad_data.empty())
+    return;
+
+  for (const auto& [pid, player] : m_players)
+  {
+    if (!player.pid)
+      continue;
+
+    sf::Packet spac;
+    spac << MessageID::PadData;
+    bool has_data = false;
+    for (const auto& [sender_pid, pad_data] : m_pending_pad_data)
+    {
+      if (sender_pid == player.pid)
+        continue;
+
+      spac.append(pad_data.getData(), pad_data.getDataSize());
+      has_data = true;
+    }
+
+    if (has_data)
+      Send(player.socket, spac);
+  }
+
+  m_pending_pad_data.clear();
+}
+
 void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet, const u8 channel_id)
 {
   ENetUtil::SendPacket(socket, packet, channel_id);
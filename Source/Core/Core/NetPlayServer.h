@@ -5,6 +5,7 @@
 
 #include <SFML/Network/Packet.hpp>
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -21,6 +22,7 @@
 #include "Common/SPSCQueue.h"
 #include "Common/Timer.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayCommon.h"
 #include "Core/NetPlayProto.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
@@ -67,6 +69,8 @@ public:
   void SetWiimoteMapping(const PadMappingArray& mappings);
 
   void AdjustPadBufferSize(unsigned int size);
+  // Makes the server pick the pad buffer size from the measured latency of the players.
+  void SetAdaptiveBuffer(bool enable);
   void SetHostInputAuthority(bool enable);
 
   void KickPlayer(PlayerId player);
@@ -91,7 +95,12 @@ private:
 
     ENetPeer* socket = nullptr;
     u32 ping = 0;
+    // Smoothed round trip time and its mean deviation, in milliseconds.
+    u32 smoothed_ping = 0;
+    u32 ping_jitter = 0;
+    bool ping_measured = false;
     u32 current_game = 0;
+    CachedDataHashes cached_save_data;
 
     Common::QoSSession qos_session;
 
@@ -124,6 +133,10 @@ private:
   bool SetupNetSettings();
   std::optional<SaveSyncInfo> CollectSaveSyncInfo();
   bool SyncSaveData(const SaveSyncInfo& sync_info);
+  // Sends every client a packet built by build_packet, leaving out the data it has cached.
+  bool SendSaveDataToClients(
+      const std::function<bool(sf::Packet&, const CachedDataHashes*)>& build_packet,
+      const std::string& title);
   bool SyncCodes();
   void CheckSyncAndStartGame();
 
@@ -140,6 +153,9 @@ private:
   ConnectionError OnConnect(ENetPeer* socket, sf::Packet& received_packet);
   unsigned int OnDisconnect(const Client& player);
   unsigned int OnData(sf::Packet& packet, Client& player);
+  void OnENetEvent(ENetEvent& net_event);
+  void FlushPadData();
+  void UpdateAdaptiveBufferSize();
 
   void OnTraversalStateChanged() override;
   void OnConnectReady(ENetAddress) override {}
@@ -170,6 +186,10 @@ private:
   bool m_update_pings = false;
   u32 m_current_game = 0;
   unsigned int m_target_buffer_size = 0;
+  bool m_adaptive_buffer = false;
+  u32 m_adaptive_buffer_lower_rounds = 0;
+  // Pad data received from each player since the last FlushPadData.
+  std::vector<std::pair<PlayerId, sf::Packet>> m_pending_pad_data;
   PadMappingArray m_pad_map;
   GBAConfigArray m_gba_config;
   PadMappingArray m_wiimote_map;
@@ -91,6 +91,7 @@ PCAPSSLCaptureLogger::~PCAPSSLCaptureLogger() = default;
 
 void PCAPSSLCaptureLogger::OnNewSocket(s32 socket)
 {
+  std::lock_guard lk(m_mutex);
   m_read_sequence_number[socket] = 0;
   m_write_sequence_number[socket] = 0;
 }
@@ -123,6 +124,7 @@ void PCAPSSLCaptureLogger::LogBBA(const void* data, std::size_t length)
 {
   if (!Config::Get(Config::MAIN_NETWORK_DUMP_BBA))
     return;
+  std::lock_guard lk(m_mutex);
   m_file->AddPacket(static_cast<const u8*>(data), length);
 }
 
@@ -188,6 +190,8 @@ void PCAPSSLCaptureLogger::LogIPv4(LogType log_type, const u8* data, u16 length,
   }
   insert(&ethernet_header, ethernet_header.Size());
 
+  // SSL handshakes log their packets from the handshake thread.
+  std::lock_guard lk(m_mutex);
   if (socket_type == SOCK_STREAM)
   {
     u32& sequence_number = (log_type == LogType::Read) ? m_read_sequence_number[socket] :
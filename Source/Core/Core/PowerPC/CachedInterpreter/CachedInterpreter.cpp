@@ -3,57 +3,52 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <cstring>
+#include <limits>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/Swap.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
 #include "Core/PowerPC/Jit64Common/Jit64Constants.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
-struct CachedInterpreter::Instruction
-{
-  using CommonCallback = void (*)(UGeckoInstruction);
-  using ConditionalCallback = bool (*)(u32);
-
-  Instruction() {}
-  Instruction(const CommonCallback c, UGeckoInstruction i)
-      : common_callback(c), data(i.hex), type(Type::Common)
-  {
-  }
-
-  Instruction(const ConditionalCallback c, u32 d)
-      : conditional_callback(c), data(d), type(Type::Conditional)
-  {
-  }
-
-  enum class Type
-  {
-    Abort,
-    Common,
-    Conditional,
-  };
-
-  union
-  {
-    const CommonCallback common_callback;
-    const ConditionalCallback conditional_callback;
-  };
+// Blocks are stored as threaded code: every entry is a pointer to its handler, immediately
+// followed by the operands the handler needs. Handlers return the size of their entry so that
+// the dispatch loop can step to the next one, or 0 to leave the block.
+using AnyCallback = u32 (*)(const u8* entry);
 
-  u32 data = 0;
-  Type type = Type::Abort;
+template <typename Operands>
+struct Entry
+{
+  AnyCallback callback;
+  Operands operands;
 };
 
+template <typename Operands, bool (*Callback)(Operands)>
+static u32 CallEntry(const u8* entry)
+{
+  if (Callback(reinterpret_cast<const Entry<Operands>*>(entry)->operands))
+    return 0;
+  return sizeof(Entry<Operands>);
+}
+
 CachedInterpreter::CachedInterpreter() = default;
 
 CachedInterpreter::~CachedInterpreter() = default;
 
 void CachedInterpreter::Init()
 {
-  m_code.reserve(CODE_SIZE / sizeof(Instruction));
+  m_code.reserve(CODE_SIZE);
 
   jo.enableBlocklink = false;
 
@@ -72,7 +67,16 @@ void CachedInterpreter::Shutdown()
 
 u8* CachedInterpreter::GetCodePtr()
 {
-  return reinterpret_cast<u8*>(m_code.data() + m_code.size());
+  return m_code.data() + m_code.size();
+}
+
+template <typename Operands, bool (*Callback)(Operands)>
+void CachedInterpreter::Emit(Operands operands)
+{
+  const Entry<Operands> entry{CallEntry<Operands, Callback>, operands};
+  const size_t offset = m_code.size();
+  m_code.resize(offset + sizeof(entry));
+  std::memcpy(m_code.data() + offset, &entry, sizeof(entry));
 }
 
 void CachedInterpreter::ExecuteOneBlock()
@@ -84,27 +88,9 @@ void CachedInterpreter::ExecuteOneBlock()
     return;
   }
 
-  const Instruction* code = reinterpret_cast<const Instruction*>(normal_entry);
-
-  for (; code->type != Instruction::Type::Abort; ++code)
-  {
-    switch (code->type)
-    {
-    case Instruction::Type::Common:
-      code->common_callback(UGeckoInstruction(code->data));
-      break;
-
-    case Instruction::Type::Conditional:
-      if (code->conditional_callback(code->data))
-        return;
-      break;
-
-    default:
-      ERROR_LOG_FMT(POWERPC, "Unknown CachedInterpreter Instruction: {}",
-                    static_cast<int>(code->type));
-      break;
-    }
-  }
+  const u8* code = normal_entry;
+  while (const u32 entry_size = (*reinterpret_cast<const AnyCallback*>(code))(code))
+    code += entry_size;
 }
 
 void CachedInterpreter::Run()
@@ -130,32 +116,79 @@ void CachedInterpreter::SingleStep()
   ExecuteOneBlock();
 }
 
-static void EndBlock(UGeckoInstruction data)
+struct InterpreterOperands
 {
-  PC = NPC;
-  PowerPC::ppcState.downcount -= data.hex;
-  PowerPC::UpdatePerformanceMonitor(data.hex, 0, 0);
+  Interpreter::Instruction func;
+  UGeckoInstruction inst;
+};
+
+// Two adjacent instructions with nothing else to do in between share a single entry.
+struct InterpreterPairOperands
+{
+  Interpreter::Instruction func[2];
+  UGeckoInstruction inst[2];
+};
+
+struct InterpreterWithPCOperands
+{
+  Interpreter::Instruction func;
+  UGeckoInstruction inst;
+  u32 pc;
+};
+
+struct EndBlockOperands
+{
+  u32 downcount;
+  u32 num_load_stores;
+  u32 num_fp_inst;
+};
+
+static bool ExitBlock(u32)
+{
+  return true;
+}
+
+static bool CallInterpreter(InterpreterOperands operands)
+{
+  operands.func(operands.inst);
+  return false;
 }
 
-static void UpdateNumLoadStoreInstructions(UGeckoInstruction data)
+static bool CallInterpreterPair(InterpreterPairOperands operands)
 {
-  PowerPC::UpdatePerformanceMonitor(0, data.hex, 0);
+  operands.func[0](operands.inst[0]);
+  operands.func[1](operands.inst[1]);
+  return false;
 }
 
-static void UpdateNumFloatingPointInstructions(UGeckoInstruction data)
+static bool CallInterpreterWithPC(InterpreterWithPCOperands operands)
 {
-  PowerPC::UpdatePerformanceMonitor(0, 0, data.hex);
+  PC = operands.pc;
+  NPC = operands.pc + 4;
+  operands.func(operands.inst);
+  return false;
 }
 
-static void WritePC(UGeckoInstruction data)
+static bool EndBlock(EndBlockOperands operands)
 {
-  PC = data.hex;
-  NPC = data.hex + 4;
+  PC = NPC;
+  PowerPC::ppcState.downcount -= operands.downcount;
+  PowerPC::UpdatePerformanceMonitor(operands.downcount, operands.num_load_stores,
+                                    operands.num_fp_inst);
+  return false;
 }
 
-static void WriteBrokenBlockNPC(UGeckoInstruction data)
+static bool WritePC(u32 pc)
 {
-  NPC = data.hex;
+  PC = pc;
+  NPC = pc + 4;
+  return false;
+}
+
+static bool WriteBrokenBlockNPC(u32 npc)
+{
+  NPC = npc;
+  return false;
 }
 
 static bool CheckFPU(u32 data)
@@ -212,24 +245,227 @@ static bool CheckIdle(u32 idle_pc)
   return false;
 }
 
+// Loads and stores which hit RAM go straight through the soft MMU page tables that Memmap keeps
+// for the JITs, skipping address translation in MMU.cpp. This needs neither executable memory
+// nor a fastmem arena, so it also works on hosts where the CachedInterpreter is the only option.
+// Anything else (MMIO, page table mappings, page crossing or misaligned float accesses) is handed
+// to the regular interpreter implementation, which takes care of raising exceptions.
+template <typename T>
+static u8* GetFastmemPointer(u32 address)
+{
+  const u32 offset = address & (PowerPC::BAT_PAGE_SIZE - 1);
+  if (offset > PowerPC::BAT_PAGE_SIZE - sizeof(T))
+    return nullptr;
+
+  u8* const* page_mappings = reinterpret_cast<u8* const*>(
+      MSR.DR ? Memory::logical_page_mappings_base : Memory::physical_page_mappings_base);
+  u8* const page = page_mappings[address >> PowerPC::BAT_INDEX_SHIFT];
+  return page ? page + offset : nullptr;
+}
+
+static u32 GetFastmemAddress(UGeckoInstruction inst)
+{
+  return inst.RA ? rGPR[inst.RA] + u32(inst.SIMM_16) : u32(inst.SIMM_16);
+}
+
+static void FastmemLwz(UGeckoInstruction inst)
+{
+  if (const u8* ptr = GetFastmemPointer<u32>(GetFastmemAddress(inst)))
+    rGPR[inst.RD] = Common::swap32(ptr);
+  else
+    Interpreter::lwz(inst);
+}
+
+static void FastmemLwzu(UGeckoInstruction inst)
+{
+  const u32 address = rGPR[inst.RA] + u32(inst.SIMM_16);
+  if (const u8* ptr = GetFastmemPointer<u32>(address))
+  {
+    rGPR[inst.RD] = Common::swap32(ptr);
+    rGPR[inst.RA] = address;
+  }
+  else
+  {
+    Interpreter::lwzu(inst);
+  }
+}
+
+static void FastmemLhz(UGeckoInstruction inst)
+{
+  if (const u8* ptr = GetFastmemPointer<u16>(GetFastmemAddress(inst)))
+    rGPR[inst.RD] = Common::swap16(ptr);
+  else
+    Interpreter::lhz(inst);
+}
+
+static void FastmemLha(UGeckoInstruction inst)
+{
+  if (const u8* ptr = GetFastmemPointer<u16>(GetFastmemAddress(inst)))
+    rGPR[inst.RD] = u32(s32(s16(Common::swap16(ptr))));
+  else
+    Interpreter::lha(inst);
+}
+
+static void FastmemLbz(UGeckoInstruction inst)
+{
+  if (const u8* ptr = GetFastmemPointer<u8>(GetFastmemAddress(inst)))
+    rGPR[inst.RD] = *ptr;
+  else
+    Interpreter::lbz(inst);
+}
+
+static void FastmemStw(UGeckoInstruction inst)
+{
+  if (u8* ptr = GetFastmemPointer<u32>(GetFastmemAddress(inst)))
+  {
+    const u32 value = Common::swap32(rGPR[inst.RS]);
+    std::memcpy(ptr, &value, sizeof(value));
+  }
+  else
+  {
+    Interpreter::stw(inst);
+  }
+}
+
+static void FastmemStwu(UGeckoInstruction inst)
+{
+  const u32 address = rGPR[inst.RA] + u32(inst.SIMM_16);
+  if (u8* ptr = GetFastmemPointer<u32>(address))
+  {
+    const u32 value = Common::swap32(rGPR[inst.RS]);
+    std::memcpy(ptr, &value, sizeof(value));
+    rGPR[inst.RA] = address;
+  }
+  else
+  {
+    Interpreter::stwu(inst);
+  }
+}
+
+static void FastmemSth(UGeckoInstruction inst)
+{
+  if (u8* ptr = GetFastmemPointer<u16>(GetFastmemAddress(inst)))
+  {
+    const u16 value = Common::swap16(static_cast<u16>(rGPR[inst.RS]));
+    std::memcpy(ptr, &value, sizeof(value));
+  }
+  else
+  {
+    Interpreter::sth(inst);
+  }
+}
+
+static void FastmemStb(UGeckoInstruction inst)
+{
+  if (u8* ptr = GetFastmemPointer<u8>(GetFastmemAddress(inst)))
+    *ptr = static_cast<u8>(rGPR[inst.RS]);
+  else
+    Interpreter::stb(inst);
+}
+
+static void FastmemLfs(UGeckoInstruction inst)
+{
+  const u32 address = GetFastmemAddress(inst);
+  const u8* ptr = (address & 0b11) == 0 ? GetFastmemPointer<u32>(address) : nullptr;
+  if (ptr)
+    rPS(inst.FD).Fill(ConvertToDouble(Common::swap32(ptr)));
+  else
+    Interpreter::lfs(inst);
+}
+
+static void FastmemLfd(UGeckoInstruction inst)
+{
+  const u32 address = GetFastmemAddress(inst);
+  const u8* ptr = (address & 0b11) == 0 ? GetFastmemPointer<u64>(address) : nullptr;
+  if (ptr)
+    rPS(inst.FD).SetPS0(Common::swap64(ptr));
+  else
+    Interpreter::lfd(inst);
+}
+
+static void FastmemStfs(UGeckoInstruction inst)
+{
+  const u32 address = GetFastmemAddress(inst);
+  u8* ptr = (address & 0b11) == 0 ? GetFastmemPointer<u32>(address) : nullptr;
+  if (ptr)
+  {
+    const u32 value = Common::swap32(ConvertToSingle(rPS(inst.FS).PS0AsU64()));
+    std::memcpy(ptr, &value, sizeof(value));
+  }
+  else
+  {
+    Interpreter::stfs(inst);
+  }
+}
+
+static void FastmemStfd(UGeckoInstruction inst)
+{
+  const u32 address = GetFastmemAddress(inst);
+  u8* ptr = (address & 0b11) == 0 ? GetFastmemPointer<u64>(address) : nullptr;
+  if (ptr)
+  {
+    const u64 value = Common::swap64(rPS(inst.FS).PS0AsU64());
+    std::memcpy(ptr, &value, sizeof(value));
+  }
+  else
+  {
+    Interpreter::stfd(inst);
+  }
+}
+
+static Interpreter::Instruction GetFastmemCallback(UGeckoInstruction inst)
+{
+  switch (inst.OPCD)
+  {
+  case 32:
+    return FastmemLwz;
+  case 33:
+    return FastmemLwzu;
+  case 34:
+    return FastmemLbz;
+  case 36:
+    return FastmemStw;
+  case 37:
+    return FastmemStwu;
+  case 38:
+    return FastmemStb;
+  case 40:
+    return FastmemLhz;
+  case 42:
+    return FastmemLha;
+  case 44:
+    return FastmemSth;
+  case 48:
+    return FastmemLfs;
+  case 50:
+    return FastmemLfd;
+  case 52:
+    return FastmemStfs;
+  case 54:
+    return FastmemStfd;
+  default:
+    return nullptr;
+  }
+}
+
 bool CachedInterpreter::HandleFunctionHooking(u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType type) {
-    m_code.emplace_back(WritePC, address);
-    m_code.emplace_back(Interpreter::HLEFunction, hook_index);
+    Emit<InterpreterWithPCOperands, CallInterpreterWithPC>(
+        {Interpreter::HLEFunction, UGeckoInstruction(hook_index), address});
 
     if (type != HLE::HookType::Replace)
       return false;
 
-    m_code.emplace_back(EndBlock, js.downcountAmount);
-    m_code.emplace_back();
+    Emit<EndBlockOperands, EndBlock>({js.downcountAmount, 0, 0});
+    Emit<u32, ExitBlock>(0);
     return true;
   });
 }
 
 void CachedInterpreter::Jit(u32 address)
 {
-  if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
+  if (m_code.size() >= CODE_SIZE - 0x10000 ||
       SConfig::GetInstance().bJITNoBlockCache)
   {
     ClearCache();
@@ -259,6 +495,12 @@ void CachedInterpreter::Jit(u32 address)
   b->checkedEntry = GetCodePtr();
   b->normalEntry = GetCodePtr();
 
+  // Watchpoints are only checked in the MMU.cpp slow path.
+  const bool fastmem = m_fastmem_enabled && !PowerPC::memchecks.HasAny();
+
+  // End of the most recent entry holding a single interpreter call, for merging it with the next.
+  size_t last_interpreter_entry_end = std::numeric_limits<size_t>::max();
+
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
     PPCAnalyst::CodeOp& op = m_code_buffer[i];
@@ -282,41 +524,63 @@ void CachedInterpreter::Jit(u32 address)
       const bool check_program_exception = !endblock && ShouldHandleFPExceptionForInstruction(&op);
       const bool idle_loop = op.branchIsIdleLoop;
 
-      if (breakpoint || check_fpu || endblock || memcheck || check_program_exception)
-        m_code.emplace_back(WritePC, op.address);
+      const bool write_pc = endblock || memcheck || check_program_exception;
+
+      if (breakpoint || check_fpu)
+        Emit<u32, WritePC>(op.address);
 
       if (breakpoint)
-        m_code.emplace_back(CheckBreakpoint, js.downcountAmount);
+        Emit<u32, CheckBreakpoint>(js.downcountAmount);
 
       if (check_fpu)
       {
-        m_code.emplace_back(CheckFPU, js.downcountAmount);
+        Emit<u32, CheckFPU>(js.downcountAmount);
         js.firstFPInstructionFound = true;
       }
 
-      m_code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
+      Interpreter::Instruction callback = fastmem ? GetFastmemCallback(op.inst) : nullptr;
+      if (!callback)
+        callback = PPCTables::GetInterpreterOp(op.inst);
+
+      if (write_pc && !breakpoint && !check_fpu)
+      {
+        Emit<InterpreterWithPCOperands, CallInterpreterWithPC>({callback, op.inst, op.address});
+      }
+      else if (last_interpreter_entry_end == m_code.size())
+      {
+        const size_t offset = m_code.size() - sizeof(Entry<InterpreterOperands>);
+        const InterpreterOperands previous =
+            reinterpret_cast<const Entry<InterpreterOperands>*>(m_code.data() + offset)->operands;
+        m_code.resize(offset);
+        Emit<InterpreterPairOperands, CallInterpreterPair>(
+            {{previous.func, callback}, {previous.inst, op.inst}});
+      }
+      else
+      {
+        Emit<InterpreterOperands, CallInterpreter>({callback, op.inst});
+        last_interpreter_entry_end = m_code.size();
+      }
+
       if (memcheck)
-        m_code.emplace_back(CheckDSI, js.downcountAmount);
+        Emit<u32, CheckDSI>(js.downcountAmount);
       if (check_program_exception)
-        m_code.emplace_back(CheckProgramException, js.downcountAmount);
+        Emit<u32, CheckProgramException>(js.downcountAmount);
       if (idle_loop)
-        m_code.emplace_back(CheckIdle, js.blockStart);
+        Emit<u32, CheckIdle>(op.branchTo);
       if (endblock)
       {
-        m_code.emplace_back(EndBlock, js.downcountAmount);
-        m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-        m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+        Emit<EndBlockOperands, EndBlock>(
+            {js.downcountAmount, js.numLoadStoreInst, js.numFloatingPointInst});
       }
     }
   }
   if (code_block.m_broken)
   {
-    m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
-    m_code.emplace_back(EndBlock, js.downcountAmount);
-    m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-    m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+    Emit<u32, WriteBrokenBlockNPC>(nextPC);
+    Emit<EndBlockOperands, EndBlock>(
+        {js.downcountAmount, js.numLoadStoreInst, js.numFloatingPointInst});
   }
-  m_code.emplace_back();
+  Emit<u32, ExitBlock>(0);
 
   b->codeSize = (u32)(GetCodePtr() - b->checkedEntry);
   b->originalSize = code_block.m_num_instructions;
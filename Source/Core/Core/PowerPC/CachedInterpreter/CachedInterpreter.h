@@ -32,13 +32,15 @@ public:
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
 
 private:
-  struct Instruction;
-
   u8* GetCodePtr();
+
+  template <typename Operands, bool (*Callback)(Operands)>
+  void Emit(Operands operands);
+
   void ExecuteOneBlock();
 
   bool HandleFunctionHooking(u32 address);
 
   BlockCache m_block_cache{*this};
-  std::vector<Instruction> m_code;
+  std::vector<u8> m_code;
 };
@@ -41,6 +41,9 @@ std::array<Interpreter::Instruction, 1024> Interpreter::m_op_table31;
 std::array<Interpreter::Instruction, 32> Interpreter::m_op_table59;
 std::array<Interpreter::Instruction, 1024> Interpreter::m_op_table63;
 
+std::array<Interpreter::DecodedInstruction, Interpreter::DECODE_CACHE_SIZE>
+    Interpreter::m_decode_cache;
+
 namespace
 {
 // Determines whether or not the given instruction is one where its execution
@@ -98,9 +101,38 @@ void Interpreter::RunTable63(UGeckoInstruction inst)
   m_op_table63[inst.SUBOP10](inst);
 }
 
+Interpreter::Instruction Interpreter::GetHandler(UGeckoInstruction inst)
+{
+  const Instruction handler = m_op_table[inst.OPCD];
+  if (handler == RunTable4)
+    return m_op_table4[inst.SUBOP10];
+  if (handler == RunTable19)
+    return m_op_table19[inst.SUBOP10];
+  if (handler == RunTable31)
+    return m_op_table31[inst.SUBOP10];
+  if (handler == RunTable59)
+    return m_op_table59[inst.SUBOP5];
+  if (handler == RunTable63)
+    return m_op_table63[inst.SUBOP10];
+  return handler;
+}
+
+const Interpreter::DecodedInstruction& Interpreter::Decode(UGeckoInstruction inst)
+{
+  DecodedInstruction& entry = m_decode_cache[(inst.hex ^ (inst.hex >> 16)) % DECODE_CACHE_SIZE];
+  if (entry.hex != inst.hex)
+  {
+    entry.hex = inst.hex;
+    entry.handler = GetHandler(inst);
+    entry.info = PPCTables::GetOpInfo(inst);
+  }
+  return entry;
+}
+
 void Interpreter::Init()
 {
   InitializeInstructionTables();
+  m_decode_cache.fill({});
   m_end_block = false;
 }
 
@@ -163,8 +195,12 @@ int Interpreter::SingleStepInner()
     Trace(m_prev_inst);
   }
 
+  const GekkoOPInfo* opinfo;
   if (m_prev_inst.hex != 0)
   {
+    const DecodedInstruction& decoded = Decode(m_prev_inst);
+    opinfo = decoded.info;
+
     if (IsInvalidPairedSingleExecution(m_prev_inst))
     {
       GenerateProgramException(ProgramExceptionCause::IllegalInstruction);
@@ -172,7 +208,7 @@ int Interpreter::SingleStepInner()
     }
     else if (MSR.FP)
     {
-      m_op_table[m_prev_inst.OPCD](m_prev_inst);
+      decoded.handler(m_prev_inst);
       if ((PowerPC::ppcState.Exceptions & EXCEPTION_DSI) != 0)
       {
         CheckExceptions();
@@ -181,14 +217,14 @@ int Interpreter::SingleStepInner()
     else
     {
       // check if we have to generate a FPU unavailable exception or a program exception.
-      if (PPCTables::UsesFPU(m_prev_inst))
+      if ((opinfo->flags & FL_USE_FPU) != 0)
       {
         PowerPC::ppcState.Exceptions |= EXCEPTION_FPU_UNAVAILABLE;
         CheckExceptions();
       }
       else
       {
-        m_op_table[m_prev_inst.OPCD](m_prev_inst);
+        decoded.handler(m_prev_inst);
         if ((PowerPC::ppcState.Exceptions & EXCEPTION_DSI) != 0)
         {
           CheckExceptions();
@@ -200,16 +236,27 @@ int Interpreter::SingleStepInner()
   {
     // Memory exception on instruction fetch
     CheckExceptions();
+    opinfo = PPCTables::GetOpInfo(m_prev_inst);
   }
 
   UpdatePC();
 
-  const GekkoOPInfo* opinfo = PPCTables::GetOpInfo(m_prev_inst);
   PowerPC::UpdatePerformanceMonitor(opinfo->numCycles, (opinfo->flags & FL_LOADSTORE) != 0,
                                     (opinfo->flags & FL_USE_FPU) != 0);
   return opinfo->numCycles;
 }
 
+int Interpreter::ExecuteBlock()
+{
+  m_end_block = false;
+
+  int cycles = 0;
+  while (!m_end_block)
+    cycles += SingleStepInner();
+
+  return cycles;
+}
+
 void Interpreter::SingleStep()
 {
   auto& core_timing_globals = Core::System::GetInstance().GetCoreTimingGlobals();
@@ -9,6 +9,8 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/Gekko.h"
 
+struct GekkoOPInfo;
+
 class Interpreter : public CPUCoreBase
 {
 public:
@@ -16,6 +18,9 @@ public:
   void Shutdown() override;
   void SingleStep() override;
   int SingleStepInner();
+  // Executes instructions up to and including the next one which ends a block.
+  // Returns the number of cycles taken.
+  int ExecuteBlock();
 
   void Run() override;
   void ClearCache() override;
@@ -281,10 +286,21 @@ public:
   static u32 Helper_Carry(u32 value1, u32 value2);
 
 private:
+  // The handler and info of an instruction word, with the subtables already looked up.
+  struct DecodedInstruction
+  {
+    u32 hex = 0;
+    Instruction handler = nullptr;
+    const GekkoOPInfo* info = nullptr;
+  };
+
   void CheckExceptions();
 
   static void InitializeInstructionTables();
 
+  static Instruction GetHandler(UGeckoInstruction inst);
+  static const DecodedInstruction& Decode(UGeckoInstruction inst);
+
   static bool HandleFunctionHooking(u32 address);
 
   // flag helper
@@ -298,4 +314,9 @@ private:
   UGeckoInstruction m_prev_inst{};
 
   static bool m_end_block;
+
+  // Direct-mapped cache of decoded instruction words. It's keyed by the instruction word rather
+  // than by address, so it never has to be invalidated when code changes.
+  static constexpr u32 DECODE_CACHE_SIZE = 0x1000;
+  static std::array<DecodedInstruction, DECODE_CACHE_SIZE> m_decode_cache;
 };
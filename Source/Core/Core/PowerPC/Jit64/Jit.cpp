@@ -3,9 +3,11 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <array>
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <disasm.h>
 #include <fmt/format.h>
@@ -45,6 +47,8 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/PowerPC/Profiler.h"
 
+#include "VideoCommon/FrameTimeline.h"
+
 using namespace Gen;
 using namespace PowerPC;
 
@@ -341,9 +345,10 @@ void Jit64::Init()
 
   const size_t routines_size = asm_routines.CODE_SIZE;
   const size_t trampolines_size = jo.memcheck ? TRAMPOLINE_CODE_SIZE_MMU : TRAMPOLINE_CODE_SIZE;
-  const size_t farcode_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
+  const size_t code_size = GetCodeSpaceSize(CODE_SIZE);
+  const size_t farcode_size = GetCodeSpaceSize(jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE);
   const size_t constpool_size = m_const_pool.CONST_POOL_SIZE;
-  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size);
+  AllocCodeSpace(code_size + routines_size + trampolines_size + farcode_size + constpool_size);
   AddChildCodeSpace(&asm_routines, routines_size);
   AddChildCodeSpace(&trampolines, trampolines_size);
   AddChildCodeSpace(&m_far_code, farcode_size);
@@ -378,6 +383,7 @@ void Jit64::Init()
 
 void Jit64::ClearCache()
 {
+  CountCacheClear();
   blocks.Clear();
   blocks.ClearRangesToFree();
   trampolines.ClearCodeSpace();
@@ -396,6 +402,12 @@ void Jit64::ResetFreeMemoryRanges()
   m_free_ranges_near.insert(region, region + region_size);
   m_free_ranges_far.clear();
   m_free_ranges_far.insert(m_far_code.GetWritableCodePtr(), m_far_code.GetWritableCodeEnd());
+
+  m_near_code_used = 0;
+  m_near_code_size = region_size;
+  m_far_code_used = 0;
+  m_far_code_size = m_far_code.GetWritableCodeEnd() - m_far_code.GetWritableCodePtr();
+  PublishCodeSpaceStats();
 }
 
 void Jit64::Shutdown()
@@ -431,6 +443,9 @@ void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
   gpr.Reset(js.op->regsOut);
   fpr.Reset(js.op->GetFregsOut());
 
+  // The interpreter may have changed the rounding mode.
+  js.knownRoundingMode.reset();
+
   if (js.op->opinfo->flags & FL_ENDBLOCK)
   {
     if (js.isLastInstruction)
@@ -443,10 +458,13 @@ void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
     {
       MOV(32, R(RSCRATCH), PPCSTATE(npc));
       CMP(32, R(RSCRATCH), Imm32(js.compilerPC + 4));
-      FixupBranch c = J_CC(CC_Z);
+      FixupBranch c = J_CC(CC_NZ, true);
+
+      SwitchToFarCode();
+      SetJumpTarget(c);
       MOV(32, PPCSTATE(pc), R(RSCRATCH));
       WriteExceptionExit();
-      SetJumpTarget(c);
+      SwitchToNearCode();
     }
   }
   else if (ShouldHandleFPExceptionForInstruction(js.op))
@@ -476,6 +494,7 @@ void Jit64::HLEFunction(u32 hook_index)
   ABI_PushRegistersAndAdjustStack({}, 0);
   ABI_CallFunctionCC(HLE::Execute, js.compilerPC, hook_index);
   ABI_PopRegistersAndAdjustStack({}, 0);
+  js.knownRoundingMode.reset();
 }
 
 void Jit64::DoNothing(UGeckoInstruction _inst)
@@ -652,11 +671,97 @@ void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
   }
 }
 
+void Jit64::WriteIndirectExitDestInRSCRATCH(bool bl, u32 after)
+{
+  IndirectBranchCache* cache = blocks.AllocateIndirectBranchCache(js.curBlock->msrBits);
+  if (!cache)
+  {
+    WriteExitDestInRSCRATCH(bl, after);
+    return;
+  }
+
+  if (!m_enable_blr_optimization)
+    bl = false;
+  MOV(32, PPCSTATE(pc), R(RSCRATCH));
+  bool disturbed = Cleanup();
+  if (disturbed)
+    MOV(32, R(RSCRATCH), PPCSTATE(pc));
+
+  SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+  FixupBranch do_timing = J_CC(CC_LE, true);
+
+  MOV(64, R(RSCRATCH2), ImmPtr(cache));
+  std::array<FixupBranch, IndirectBranchCache::NUM_ENTRIES> hits;
+  for (u32 i = 0; i < IndirectBranchCache::NUM_ENTRIES; ++i)
+  {
+    const s32 offset = offsetof(IndirectBranchCache, effective_addresses) + i * sizeof(u32);
+    CMP(32, R(RSCRATCH), MDisp(RSCRATCH2, offset));
+    hits[i] = J_CC(CC_E, true);
+  }
+  FixupBranch miss = J(true);
+
+  std::vector<FixupBranch> returns;
+  for (u32 i = 0; i < IndirectBranchCache::NUM_ENTRIES; ++i)
+  {
+    SetJumpTarget(hits[i]);
+    const s32 offset = offsetof(IndirectBranchCache, normal_entries) + i * sizeof(const u8*);
+    const OpArg entry = MDisp(RSCRATCH2, offset);
+    if (bl)
+    {
+      MOV(32, R(RSCRATCH), Imm32(after));
+      PUSH(RSCRATCH);
+      CALLptr(entry);
+      returns.push_back(J(true));
+    }
+    else
+    {
+      JMPptr(entry);
+    }
+  }
+
+  SwitchToFarCode();
+  SetJumpTarget(miss);
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  MOV(64, R(ABI_PARAM1), Imm64(reinterpret_cast<u64>(static_cast<JitBaseBlockCache*>(&blocks))));
+  MOV(64, R(ABI_PARAM2), Imm64(reinterpret_cast<u64>(cache)));
+  ABI_CallFunction(JitBaseBlockCache::UpdateIndirectBranchCache);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+  // The call clobbered the flags of the downcount check, which has been done already.
+  if (bl)
+  {
+    MOV(32, R(RSCRATCH2), Imm32(after));
+    PUSH(RSCRATCH2);
+    CALL(asm_routines.dispatcher_no_timing_check);
+    returns.push_back(J(true));
+  }
+  else
+  {
+    JMP(asm_routines.dispatcher_no_timing_check, true);
+  }
+  SwitchToNearCode();
+
+  SetJumpTarget(do_timing);
+  if (bl)
+  {
+    MOV(32, R(RSCRATCH2), Imm32(after));
+    PUSH(RSCRATCH2);
+    CALL(asm_routines.dispatcher);
+    for (FixupBranch& fixup : returns)
+      SetJumpTarget(fixup);
+    POP(RSCRATCH);
+    JustWriteExit(after, false, 0);
+  }
+  else
+  {
+    JMP(asm_routines.dispatcher, true);
+  }
+}
+
 void Jit64::WriteBLRExit()
 {
   if (!m_enable_blr_optimization)
   {
-    WriteExitDestInRSCRATCH();
+    WriteIndirectExitDestInRSCRATCH();
     return;
   }
   MOV(32, PPCSTATE(pc), R(RSCRATCH));
@@ -759,6 +864,8 @@ void Jit64::Jit(u32 em_address)
 
 void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 {
+  VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::JitCompile);
+
   if (m_cleanup_after_stackfault)
   {
     ClearCache();
@@ -781,9 +888,15 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   // Check if any code blocks have been freed in the block cache and transfer this information to
   // the local rangesets to allow overwriting them with new code.
   for (auto range : blocks.GetRangesToFreeNear())
+  {
     m_free_ranges_near.insert(range.first, range.second);
+    m_near_code_used -= range.second - range.first;
+  }
   for (auto range : blocks.GetRangesToFreeFar())
+  {
     m_free_ranges_far.insert(range.first, range.second);
+    m_far_code_used -= range.second - range.first;
+  }
   blocks.ClearRangesToFree();
 
   std::size_t block_size = m_code_buffer.size();
@@ -813,10 +926,16 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     }
   }
 
+  js.baselineTier = ShouldCompileBaselineTier(em_address);
+  const u32 analyzer_options = analyzer.GetOptions();
+  if (js.baselineTier)
+    analyzer.SetOptions(GetBaselineTierAnalyzerOptions(analyzer_options));
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
   const u32 nextPC = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  analyzer.SetOptions(analyzer_options);
 
   if (code_block.m_memory_exception)
   {
@@ -845,6 +964,9 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       u8* far_end = m_far_code.GetWritableCodePtr();
       if (far_start != far_end)
         m_free_ranges_far.erase(far_start, far_end);
+      m_near_code_used += near_end - near_start;
+      m_far_code_used += far_end - far_start;
+      PublishCodeSpaceStats();
 
       // Store the used memory regions in the block so we know what to mark as unused when the
       // block gets invalidated.
@@ -856,14 +978,25 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
       return;
     }
+
+    blocks.DiscardBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
+    // Evict the least recently executed blocks and retry, or if that's not possible, clear the
+    // entire JIT cache and retry.
+    if (EvictColdBlocks())
+    {
+      Jit(em_address, true);
+      return;
+    }
+
     WARN_LOG_FMT(POWERPC, "flushing code caches, please report if this happens a lot");
     ClearCache();
+    ++m_code_space_stats.full_clears;
+    PublishCodeSpaceStats();
     Jit(em_address, false);
     return;
   }
@@ -931,6 +1064,33 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     ADD(64, MDisp(ABI_PARAM1, offset), Imm8(1));
     ABI_CallFunction(QueryPerformanceCounter);
   }
+
+  // Mark the block as executed for least recently used eviction.
+  if (m_cache_eviction)
+  {
+    MOV(64, R(RSCRATCH), ImmPtr(&b->notExecuted));
+    MOV(8, MatR(RSCRATCH), Imm8(0));
+  }
+
+  // Baseline tier blocks count their executions and request a fully optimized recompile once
+  // they turn out to be hot.
+  if (js.baselineTier)
+  {
+    b->tierUpCountdown = TIER_UP_THRESHOLD;
+    MOV(64, R(RSCRATCH), ImmPtr(&b->tierUpCountdown));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    FixupBranch hot = J_CC(CC_Z, true);
+
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                      static_cast<u32>(JitInterface::ExceptionType::TierUp));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, true);
+    SwitchToNearCode();
+  }
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -945,42 +1105,68 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   js.skipInstructions = 0;
   js.carryFlag = CarryFlag::InPPCState;
   js.constantGqrValid = BitSet8();
+  js.knownRoundingMode.reset();
 
   // Assume that GQR values don't change often at runtime. Many paired-heavy games use largely float
   // loads and stores,
   // which are significantly faster when inlined (especially in MMU mode, where this lets them use
   // fastmem).
-  if (js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
+  // If there are GQRs used but not set, we'll treat those as constant and optimize them
+  BitSet8 gqr_static = ComputeStaticGQRs(code_block);
+  if (gqr_static)
   {
-    // If there are GQRs used but not set, we'll treat those as constant and optimize them
-    BitSet8 gqr_static = ComputeStaticGQRs(code_block);
-    if (gqr_static)
+    SwitchToFarCode();
+    const u8* target = GetCodePtr();
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunction(JitInterface::CompileGQRCheck);
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, true);
+    SwitchToNearCode();
+
+    // Insert a check that the GQRs are still the value we expect at
+    // the start of the block in case our guess turns out wrong. Only the GQR which changed stops
+    // being specialized when the block gets recompiled.
+    for (int gqr : gqr_static)
     {
       SwitchToFarCode();
-      const u8* target = GetCodePtr();
-      MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
-      ABI_PushRegistersAndAdjustStack({}, 0);
-      ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
-                        static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
-      ABI_PopRegistersAndAdjustStack({}, 0);
-      JMP(asm_routines.dispatcher_no_check, true);
+      const u8* gqr_target = GetCodePtr();
+      MOV(32, R(ABI_PARAM1), Imm32(gqr));
+      JMP(target, true);
       SwitchToNearCode();
 
-      // Insert a check that the GQRs are still the value we expect at
-      // the start of the block in case our guess turns out wrong.
-      for (int gqr : gqr_static)
-      {
-        u32 value = GQR(gqr);
-        js.constantGqr[gqr] = value;
-        CMP_or_TEST(32, PPCSTATE(spr[SPR_GQR0 + gqr]), Imm32(value));
-        J_CC(CC_NZ, target);
-      }
-      js.constantGqrValid = gqr_static;
+      u32 value = GQR(gqr);
+      js.constantGqr[gqr] = value;
+      CMP_or_TEST(32, PPCSTATE(spr[SPR_GQR0 + gqr]), Imm32(value));
+      J_CC(CC_NZ, gqr_target);
     }
+    js.constantGqrValid = gqr_static;
   }
 
-  if (js.noSpeculativeConstantsAddresses.find(js.blockStart) ==
-      js.noSpeculativeConstantsAddresses.end())
+  if (ShouldAssumeRoundingMode(code_block))
+  {
+    const u32 rounding_mode = FPSCR.Hex & ROUNDING_MODE_MASK;
+    MOV(32, R(RSCRATCH), PPCSTATE(fpscr));
+    AND(32, R(RSCRATCH), Imm8(ROUNDING_MODE_MASK));
+    CMP(32, R(RSCRATCH), Imm8(rounding_mode));
+    FixupBranch mismatch = J_CC(CC_NE, true);
+
+    SwitchToFarCode();
+    SetJumpTarget(mismatch);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                      static_cast<u32>(JitInterface::ExceptionType::RoundingMode));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, true);
+    SwitchToNearCode();
+
+    js.knownRoundingMode = rounding_mode;
+  }
+
+  if (!js.baselineTier &&
+      js.noSpeculativeConstantsAddresses.find(js.blockStart) ==
+          js.noSpeculativeConstantsAddresses.end())
   {
     IntializeSpeculativeConstants();
   }
@@ -1226,11 +1412,6 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   return true;
 }
 
-BitSet8 Jit64::ComputeStaticGQRs(const PPCAnalyst::CodeBlock& cb) const
-{
-  return cb.m_gqr_used & ~cb.m_gqr_modified;
-}
-
 BitSet32 Jit64::CallerSavedRegistersInUse() const
 {
   BitSet32 in_use = gpr.RegistersInUse() | (fpr.RegistersInUse() << 16);
@@ -67,7 +67,6 @@ public:
   bool SetEmitterStateToFreeCodeRegion();
 
   BitSet32 CallerSavedRegistersInUse() const;
-  BitSet8 ComputeStaticGQRs(const PPCAnalyst::CodeBlock&) const;
 
   void IntializeSpeculativeConstants();
 
@@ -88,11 +87,15 @@ public:
   void WriteExit(u32 destination, bool bl = false, u32 after = 0);
   void JustWriteExit(u32 destination, bool bl, u32 after);
   void WriteExitDestInRSCRATCH(bool bl = false, u32 after = 0);
+  // Like WriteExitDestInRSCRATCH, but for guest code branching to a computed address, which goes
+  // through an indirect branch cache if enabled.
+  void WriteIndirectExitDestInRSCRATCH(bool bl = false, u32 after = 0);
   void WriteBLRExit();
   void WriteExceptionExit();
   void WriteExternalExceptionExit();
   void WriteRfiExitDestInRSCRATCH();
   void WriteIdleExit(u32 destination);
+  void WriteTakenBranchCounter(const PPCAnalyst::CodeOp& op);
   bool Cleanup();
 
   void GenerateConstantOverflow(bool overflow);
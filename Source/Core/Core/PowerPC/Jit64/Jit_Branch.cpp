@@ -10,6 +10,7 @@
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/Jit64/RegCache/JitRegCache.h"
 #include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -104,6 +105,28 @@ void Jit64::bx(UGeckoInstruction inst)
 // TODO - optimize to hell and beyond
 // TODO - make nice easy to optimize special cases for the most common
 // variants of this instruction.
+// Must be called with all registers flushed.
+void Jit64::WriteTakenBranchCounter(const PPCAnalyst::CodeOp& op)
+{
+  u32* counter = GetTakenBranchCounter(op);
+  if (!counter)
+    return;
+
+  MOV(64, R(RSCRATCH), ImmPtr(counter));
+  SUB(32, MatR(RSCRATCH), Imm8(1));
+  FixupBranch hot = J_CC(CC_Z, true);
+  SwitchToFarCode();
+  SetJumpTarget(hot);
+  MOV(32, PPCSTATE(pc), Imm32(op.address));
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                    static_cast<u32>(JitInterface::ExceptionType::TakenBranch));
+  ABI_PopRegistersAndAdjustStack({}, 0);
+  FixupBranch back = J(true);
+  SwitchToNearCode();
+  SetJumpTarget(back);
+}
+
 void Jit64::bcx(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -147,12 +170,36 @@ void Jit64::bcx(UGeckoInstruction inst)
     return;
   }
 
+  // The analyzer stitched the taken path into this block, so the fallthrough is the exit instead.
+  if (js.op->followConditionalBranch)
+  {
+    FixupBranch taken = J(true);
+
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+
+    {
+      RCForkGuard gpr_guard = gpr.Fork();
+      RCForkGuard fpr_guard = fpr.Fork();
+      gpr.Flush();
+      fpr.Flush();
+      WriteExit(js.compilerPC + 4);
+    }
+
+    SetJumpTarget(taken);
+    return;
+  }
+
   {
     RCForkGuard gpr_guard = gpr.Fork();
     RCForkGuard fpr_guard = fpr.Fork();
     gpr.Flush();
     fpr.Flush();
 
+    WriteTakenBranchCounter(*js.op);
+
     if (js.op->branchIsIdleLoop)
     {
       WriteIdleExit(js.op->branchTo);
@@ -197,7 +244,7 @@ void Jit64::bcctrx(UGeckoInstruction inst)
     if (inst.LK_3)
       MOV(32, PPCSTATE_LR, Imm32(js.compilerPC + 4));  // LR = PC + 4;
     AND(32, R(RSCRATCH), Imm32(0xFFFFFFFC));
-    WriteExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
+    WriteIndirectExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
   }
   else
   {
@@ -219,7 +266,7 @@ void Jit64::bcctrx(UGeckoInstruction inst)
       RCForkGuard fpr_guard = fpr.Fork();
       gpr.Flush();
       fpr.Flush();
-      WriteExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
+      WriteIndirectExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
       // Would really like to continue the block here, but it ends. TODO.
     }
     SetJumpTarget(b);
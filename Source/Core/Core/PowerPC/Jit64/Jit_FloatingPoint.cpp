@@ -109,9 +109,69 @@ void Jit64::HandleNaNs(UGeckoInstruction inst, X64Reg xmm, X64Reg clobber, std::
 
   ASSERT(xmm != clobber);
 
-  if (inst.OPCD != 4)
+  const bool paired = inst.OPCD == 4;
+
+  if (cpu_info.bSSE4_1)
+  {
+    // The check for a NaN result is the only branch. What happens when it is taken is branchless,
+    // so that code producing lots of NaNs doesn't keep running into mispredicted branches.
+    FixupBranch handle_nan;
+    if (paired)
+    {
+      avx_op(&XEmitter::VCMPPD, &XEmitter::CMPPD, clobber, R(xmm), R(xmm), CMP_UNORD);
+      PTEST(clobber, R(clobber));
+      handle_nan = J_CC(CC_NZ, true);
+    }
+    else
+    {
+      UCOMISD(xmm, R(xmm));
+      handle_nan = J_CC(CC_P, true);
+    }
+    SwitchToFarCode();
+    SetJumpTarget(handle_nan);
+
+    // With AVX, the blend mask can be in any register
+    const auto blend = [&](const OpArg& Rx) {
+      if (cpu_info.bAVX)
+      {
+        VBLENDVPD(xmm, xmm, Rx, clobber);
+      }
+      else
+      {
+        ASSERT_MSG(DYNA_REC, clobber == XMM0, "BLENDVPD implicitly uses XMM0");
+        BLENDVPD(xmm, Rx);
+      }
+    };
+
+    // Replace NaNs with PPC default NaN. For scalar instructions, the mask isn't set up yet.
+    if (!paired)
+      avx_op(&XEmitter::VCMPPD, &XEmitter::CMPPD, clobber, R(xmm), R(xmm), CMP_UNORD);
+    blend(MConst(psGeneratedQNaN));
+
+    // If any inputs are NaNs, use those instead
+    const auto check_input = [&](const OpArg& Rx) {
+      avx_op(&XEmitter::VCMPPD, &XEmitter::CMPPD, clobber, Rx, Rx, CMP_UNORD);
+      blend(Rx);
+    };
+    if (Rc)
+      check_input(*Rc);
+    if (Rb && Rb != Rc)
+      check_input(*Rb);
+    if (Ra && Ra != Rb && Ra != Rc)
+      check_input(*Ra);
+
+    // Turn SNaNs into QNaNs
+    avx_op(&XEmitter::VCMPPD, &XEmitter::CMPPD, clobber, R(xmm), R(xmm), CMP_UNORD);
+    ANDPD(clobber, MConst(psGeneratedQNaN));
+    ORPD(xmm, R(clobber));
+
+    FixupBranch done = J(true);
+    SwitchToNearCode();
+    SetJumpTarget(done);
+  }
+  else if (!paired)
   {
-    // not paired-single
+    // not paired-single, SSE2 fallback
 
     UCOMISD(xmm, R(xmm));
     FixupBranch handle_nan = J_CC(CC_P, true);
@@ -146,69 +206,40 @@ void Jit64::HandleNaNs(UGeckoInstruction inst, X64Reg xmm, X64Reg clobber, std::
   }
   else
   {
-    // paired-single
-
-    if (cpu_info.bSSE4_1)
-    {
-      avx_op(&XEmitter::VCMPPD, &XEmitter::CMPPD, clobber, R(xmm), R(xmm), CMP_UNORD);
-      PTEST(clobber, R(clobber));
-      FixupBranch handle_nan = J_CC(CC_NZ, true);
-      SwitchToFarCode();
-      SetJumpTarget(handle_nan);
+    // paired-single, SSE2 fallback
+
+    RCX64Reg tmp = fpr.Scratch();
+    RegCache::Realize(tmp);
+    MOVAPD(clobber, R(xmm));
+    CMPPD(clobber, R(clobber), CMP_UNORD);
+    MOVMSKPD(RSCRATCH, R(clobber));
+    TEST(32, R(RSCRATCH), R(RSCRATCH));
+    FixupBranch handle_nan = J_CC(CC_NZ, true);
+    SwitchToFarCode();
+    SetJumpTarget(handle_nan);
 
-      // Replace NaNs with PPC default NaN
-      ASSERT_MSG(DYNA_REC, clobber == XMM0, "BLENDVPD implicitly uses XMM0");
-      BLENDVPD(xmm, MConst(psGeneratedQNaN));
+    // Replace NaNs with PPC default NaN
+    MOVAPD(tmp, R(clobber));
+    ANDNPD(clobber, R(xmm));
+    ANDPD(tmp, MConst(psGeneratedQNaN));
+    ORPD(tmp, R(clobber));
+    MOVAPD(xmm, tmp);
 
-      // If any inputs are NaNs, use those instead
-      const auto check_input = [&](const OpArg& Rx) {
-        avx_op(&XEmitter::VCMPPD, &XEmitter::CMPPD, clobber, Rx, Rx, CMP_UNORD);
-        BLENDVPD(xmm, Rx);
-      };
-      if (Rc)
-        check_input(*Rc);
-      if (Rb && Rb != Rc)
-        check_input(*Rb);
-      if (Ra && Ra != Rb && Ra != Rc)
-        check_input(*Ra);
-    }
-    else
-    {
-      // SSE2 fallback
-
-      RCX64Reg tmp = fpr.Scratch();
-      RegCache::Realize(tmp);
-      MOVAPD(clobber, R(xmm));
-      CMPPD(clobber, R(clobber), CMP_UNORD);
-      MOVMSKPD(RSCRATCH, R(clobber));
-      TEST(32, R(RSCRATCH), R(RSCRATCH));
-      FixupBranch handle_nan = J_CC(CC_NZ, true);
-      SwitchToFarCode();
-      SetJumpTarget(handle_nan);
-
-      // Replace NaNs with PPC default NaN
+    // If any inputs are NaNs, use those instead
+    const auto check_input = [&](const OpArg& Rx) {
+      MOVAPD(clobber, Rx);
+      CMPPD(clobber, R(clobber), CMP_ORD);
       MOVAPD(tmp, R(clobber));
-      ANDNPD(clobber, R(xmm));
-      ANDPD(tmp, MConst(psGeneratedQNaN));
-      ORPD(tmp, R(clobber));
-      MOVAPD(xmm, tmp);
-
-      // If any inputs are NaNs, use those instead
-      const auto check_input = [&](const OpArg& Rx) {
-        MOVAPD(clobber, Rx);
-        CMPPD(clobber, R(clobber), CMP_ORD);
-        MOVAPD(tmp, R(clobber));
-        ANDNPD(clobber, Rx);
-        ANDPD(xmm, tmp);
-        ORPD(xmm, R(clobber));
-      };
-      if (Rc)
-        check_input(*Rc);
-      if (Rb && Rb != Rc)
-        check_input(*Rb);
-      if (Ra && Ra != Rb && Ra != Rc)
-        check_input(*Ra);
-    }
+      ANDNPD(clobber, Rx);
+      ANDPD(xmm, tmp);
+      ORPD(xmm, R(clobber));
+    };
+    if (Rc)
+      check_input(*Rc);
+    if (Rb && Rb != Rc)
+      check_input(*Rb);
+    if (Ra && Ra != Rb && Ra != Rc)
+      check_input(*Ra);
 
     // Turn SNaNs into QNaNs
     avx_op(&XEmitter::VCMPPD, &XEmitter::CMPPD, clobber, R(xmm), R(xmm), CMP_UNORD);
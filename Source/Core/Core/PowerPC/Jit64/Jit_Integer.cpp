@@ -142,6 +142,9 @@ void Jit64::FinalizeCarryOverflow(bool oe, bool inv)
 // LT/GT either.
 void Jit64::ComputeRC(preg_t preg, bool needs_test, bool needs_sext)
 {
+  if (!js.op->wantsCR[0])
+    return;
+
   RCOpArg arg = gpr.Use(preg, RCMode::Read);
   RegCache::Realize(arg);
 
@@ -373,6 +376,10 @@ bool Jit64::CheckMergedBranch(u32 crf) const
   if (!CanMergeNextInstructions(1))
     return false;
 
+  // Followed conditional branches are handled by bcx itself.
+  if (js.op[1].followConditionalBranch)
+    return false;
+
   const UGeckoInstruction& next = js.op[1].inst;
   return (((next.OPCD == 16 /* bcx */) ||
            ((next.OPCD == 19) && (next.SUBOP10 == 528) /* bcctrx */) ||
@@ -404,6 +411,7 @@ void Jit64::DoMergedBranch()
       destination = SignExt16(next.BD << 2);
     else
       destination = nextPC + SignExt16(next.BD << 2);
+    WriteTakenBranchCounter(js.op[1]);
     WriteExit(destination, next.LK, nextPC + 4);
   }
   else if ((next.OPCD == 19) && (next.SUBOP10 == 528))  // bcctrx
@@ -412,7 +420,7 @@ void Jit64::DoMergedBranch()
       MOV(32, PPCSTATE(spr[SPR_LR]), Imm32(nextPC + 4));
     MOV(32, R(RSCRATCH), PPCSTATE(spr[SPR_CTR]));
     AND(32, R(RSCRATCH), Imm32(0xFFFFFFFC));
-    WriteExitDestInRSCRATCH(next.LK, nextPC + 4);
+    WriteIndirectExitDestInRSCRATCH(next.LK, nextPC + 4);
   }
   else if ((next.OPCD == 19) && (next.SUBOP10 == 16))  // bclrx
   {
@@ -513,6 +521,9 @@ void Jit64::cmpXX(UGeckoInstruction inst)
   int a = inst.RA;
   int b = inst.RB;
   u32 crf = inst.CRFD;
+  if (!js.op->wantsCR[crf])
+    return;
+
   bool merge_branch = CheckMergedBranch(crf);
 
   bool signedCompare;
@@ -771,7 +771,7 @@ void Jit64::mtfsb0x(UGeckoInstruction inst)
     }
 
     MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
-    if (inst.CRBD >= 29)
+    if (inst.CRBD >= 29 && SetKnownRoundingMode(GetRoundingModeAfterBitWrite(mask, false)))
       UpdateMXCSR();
   }
 }
@@ -810,7 +810,7 @@ void Jit64::mtfsb1x(UGeckoInstruction inst)
   }
 
   MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
-  if (inst.CRBD >= 29)
+  if (inst.CRBD >= 29 && SetKnownRoundingMode(GetRoundingModeAfterBitWrite(mask, true)))
     UpdateMXCSR();
 }
 
@@ -841,7 +841,7 @@ void Jit64::mtfsfix(UGeckoInstruction inst)
   MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
 
   // Field 7 contains NI and RN.
-  if (inst.CRFD == 7)
+  if (inst.CRFD == 7 && SetKnownRoundingMode(imm & ROUNDING_MODE_MASK))
     LDMXCSR(MConst(s_fpscr_to_mxcsr, imm & 7));
 }
 
@@ -888,5 +888,8 @@ void Jit64::mtfsfx(UGeckoInstruction inst)
   MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
 
   if (inst.FM & 1)
+  {
+    js.knownRoundingMode.reset();
     UpdateMXCSR();
+  }
 }
@@ -3,6 +3,8 @@
 
 #include "Core/PowerPC/Jit64Common/EmuCodeBlock.h"
 
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <limits>
 
@@ -131,6 +133,44 @@ FixupBranch EmuCodeBlock::CheckIfSafeAddress(const OpArg& reg_value, X64Reg reg_
   return J_CC(CC_Z, m_far_code.Enabled());
 }
 
+bool EmuCodeBlock::HostTLBLookup(X64Reg reg_addr, int access_size, bool write,
+                                 BitSet32 registers_in_use, bool far_miss, X64Reg* bias,
+                                 FixupBranch* miss)
+{
+  registers_in_use[reg_addr] = true;
+
+  std::array<X64Reg, 2> scratch;
+  size_t num_scratch = 0;
+  for (X64Reg reg : {RSCRATCH, RSCRATCH2, RSCRATCH_EXTRA})
+  {
+    if (!registers_in_use[reg] && num_scratch < scratch.size())
+      scratch[num_scratch++] = reg;
+  }
+  if (num_scratch < scratch.size())
+    return false;
+
+  const X64Reg index = scratch[0];
+  const X64Reg tag = scratch[1];
+  const size_t host_tlb =
+      offsetof(PowerPC::PowerPCState, host_tlb) + write * sizeof(PowerPC::HostTLB);
+  const s32 tag_offset = static_cast<s32>(host_tlb + offsetof(PowerPC::HostTLB, tag)) - 0x80;
+  const s32 bias_offset = static_cast<s32>(host_tlb + offsetof(PowerPC::HostTLB, bias)) - 0x80;
+
+  MOV(32, R(index), R(reg_addr));
+  SHR(32, R(index), Imm8(PowerPC::HW_PAGE_INDEX_SHIFT));
+  AND(32, R(index), Imm32(PowerPC::HOST_TLB_SIZE - 1));
+
+  // Using the address of the last byte means that accesses crossing into the next page miss.
+  LEA(32, tag, MDisp(reg_addr, access_size / 8 - 1));
+  OR(32, R(tag), Imm32(PowerPC::HW_PAGE_MASK));
+  CMP(32, R(tag), MComplex(RPPCSTATE, index, SCALE_4, tag_offset));
+  *miss = J_CC(CC_NE, far_miss);
+
+  MOV(64, R(tag), MComplex(RPPCSTATE, index, SCALE_8, bias_offset));
+  *bias = tag;
+  return true;
+}
+
 void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int accessSize, s32 offset,
                                        bool swap, MovInfo* info)
 {
@@ -273,7 +313,12 @@ private:
   void CallLambda(int sbits, const std::function<T(Core::System&, u32)>* lambda)
   {
     m_code->ABI_PushRegistersAndAdjustStack(m_registers_in_use, 0);
-    m_code->ABI_CallLambdaPC(lambda, &Core::System::GetInstance(), m_address);
+    // Handlers created from lambdas without captures hold a plain function,
+    // which can be called without going through the std::function.
+    if (const auto* function = lambda->template target<T (*)(Core::System&, u32)>())
+      m_code->ABI_CallFunctionPC(*function, &Core::System::GetInstance(), m_address);
+    else
+      m_code->ABI_CallLambdaPC(lambda, &Core::System::GetInstance(), m_address);
     m_code->ABI_PopRegistersAndAdjustStack(m_registers_in_use, 0);
     MoveOpArgToReg(sbits, R(ABI_RETURN));
   }
@@ -380,6 +425,26 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     SetJumpTarget(slow);
   }
 
+  // Pages which don't have a BAT mapping (or all of them, without a fastmem arena) get another
+  // chance at avoiding a call into MMU.cpp. Without a fast path in front of it, the lookup is
+  // emitted in near code and the call moves to far code instead.
+  const bool host_tlb_far_miss = !fast_check_address && m_far_code.Enabled();
+  X64Reg host_tlb_bias;
+  FixupBranch host_tlb_miss;
+  FixupBranch host_tlb_hit;
+  const bool host_tlb = dr_set && m_jit.jo.host_tlb && !(flags & SAFE_LOADSTORE_NO_UPDATE_PC) &&
+                        HostTLBLookup(reg_addr, accessSize, false, registersInUse,
+                                      host_tlb_far_miss, &host_tlb_bias, &host_tlb_miss);
+  if (host_tlb)
+  {
+    LoadAndSwap(accessSize, reg_value, MRegSum(host_tlb_bias, reg_addr), signExtend);
+    if (host_tlb_far_miss)
+      SwitchToFarCode();
+    else
+      host_tlb_hit = J(true);
+    SetJumpTarget(host_tlb_miss);
+  }
+
   // Helps external systems know which instruction triggered the read.
   // Invalid for calls from Jit64AsmCommon routines
   if (!(flags & SAFE_LOADSTORE_NO_UPDATE_PC))
@@ -417,6 +482,16 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     MOVZX(64, accessSize, reg_value, R(ABI_RETURN));
   }
 
+  if (host_tlb)
+  {
+    if (host_tlb_far_miss)
+    {
+      host_tlb_hit = J(true);
+      SwitchToNearCode();
+    }
+    SetJumpTarget(host_tlb_hit);
+  }
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
@@ -548,6 +623,34 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
     SetJumpTarget(slow);
   }
 
+  BitSet32 host_tlb_registers_in_use = registersInUse;
+  if (reg_value.IsSimpleReg())
+    host_tlb_registers_in_use[reg_value.GetSimpleReg()] = true;
+
+  const bool host_tlb_far_miss = !fast_check_address && m_far_code.Enabled();
+  X64Reg host_tlb_bias;
+  FixupBranch host_tlb_miss;
+  FixupBranch host_tlb_hit;
+  const bool host_tlb = dr_set && m_jit.jo.host_tlb && !(flags & SAFE_LOADSTORE_NO_UPDATE_PC) &&
+                        (reg_value.IsImm() || !WriteClobbersRegValue(accessSize, swap)) &&
+                        HostTLBLookup(reg_addr, accessSize, true, host_tlb_registers_in_use,
+                                      host_tlb_far_miss, &host_tlb_bias, &host_tlb_miss);
+  if (host_tlb)
+  {
+    const OpArg dest = MRegSum(host_tlb_bias, reg_addr);
+    if (reg_value.IsImm())
+      MOV(accessSize, dest, swap ? SwapImmediate(accessSize, reg_value) : reg_value);
+    else if (swap)
+      SwapAndStore(accessSize, dest, reg_value.GetSimpleReg());
+    else
+      MOV(accessSize, dest, reg_value);
+    if (host_tlb_far_miss)
+      SwitchToFarCode();
+    else
+      host_tlb_hit = J(true);
+    SetJumpTarget(host_tlb_miss);
+  }
+
   // PC is used by memory watchpoints (if enabled) or to print accurate PC locations in debug logs
   // Invalid for calls from Jit64AsmCommon routines
   if (!(flags & SAFE_LOADSTORE_NO_UPDATE_PC))
@@ -589,6 +692,16 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 
   MemoryExceptionCheck();
 
+  if (host_tlb)
+  {
+    if (host_tlb_far_miss)
+    {
+      host_tlb_hit = J(true);
+      SwitchToNearCode();
+    }
+    SetJumpTarget(host_tlb_hit);
+  }
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
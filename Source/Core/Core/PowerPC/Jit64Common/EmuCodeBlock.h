@@ -55,6 +55,14 @@ public:
 
   Gen::FixupBranch CheckIfSafeAddress(const Gen::OpArg& reg_value, Gen::X64Reg reg_addr,
                                       BitSet32 registers_in_use);
+
+  // Looks up the page of an access in PowerPC::ppcState.host_tlb. On a hit, falls through with the
+  // host address of the access being MRegSum(*bias, reg_addr); on a miss, jumps to *miss, which
+  // has to be a near jump if far_miss is set. Returns false without emitting anything if there
+  // are no free scratch registers.
+  bool HostTLBLookup(Gen::X64Reg reg_addr, int access_size, bool write,
+                     BitSet32 registers_in_use, bool far_miss, Gen::X64Reg* bias,
+                     Gen::FixupBranch* miss);
   // these return the address of the MOV, for backpatching
   void UnsafeWriteRegToReg(Gen::OpArg reg_value, Gen::X64Reg reg_addr, int accessSize,
                            s32 offset = 0, bool swap = true, Gen::MovInfo* info = nullptr);
@@ -3,7 +3,10 @@
 
 #include "Core/PowerPC/JitArm64/Jit.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdio>
+#include <vector>
 
 #include "Common/Arm64Emitter.h"
 #include "Common/CommonTypes.h"
@@ -25,6 +28,8 @@
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/Profiler.h"
 
+#include "VideoCommon/FrameTimeline.h"
+
 using namespace Arm64Gen;
 
 constexpr size_t CODE_SIZE = 1024 * 1024 * 32;
@@ -48,8 +53,9 @@ JitArm64::~JitArm64() = default;
 
 void JitArm64::Init()
 {
-  const size_t child_code_size = m_mmu_enabled ? FARCODE_SIZE_MMU : FARCODE_SIZE;
-  AllocCodeSpace(CODE_SIZE + child_code_size);
+  const size_t code_size = GetCodeSpaceSize(CODE_SIZE);
+  const size_t child_code_size = GetCodeSpaceSize(m_mmu_enabled ? FARCODE_SIZE_MMU : FARCODE_SIZE);
+  AllocCodeSpace(code_size + child_code_size);
   AddChildCodeSpace(&m_far_code, child_code_size);
 
   jo.fastmem_arena = m_fastmem_enabled && Memory::InitFastmemArena();
@@ -128,6 +134,7 @@ bool JitArm64::HandleStackFault()
 
 void JitArm64::ClearCache()
 {
+  CountCacheClear();
   m_fault_to_handler.clear();
 
   blocks.Clear();
@@ -149,6 +156,12 @@ void JitArm64::ResetFreeMemoryRanges()
   m_free_ranges_near.insert(GetWritableCodePtr(), GetWritableCodeEnd());
   m_free_ranges_far.clear();
   m_free_ranges_far.insert(m_far_code.GetWritableCodePtr(), m_far_code.GetWritableCodeEnd());
+
+  m_near_code_used = 0;
+  m_near_code_size = GetWritableCodeEnd() - GetWritableCodePtr();
+  m_far_code_used = 0;
+  m_far_code_size = m_far_code.GetWritableCodeEnd() - m_far_code.GetWritableCodePtr();
+  PublishCodeSpaceStats();
 }
 
 void JitArm64::Shutdown()
@@ -186,6 +199,9 @@ void JitArm64::FallBackToInterpreter(UGeckoInstruction inst)
   gpr.ResetRegisters(js.op->regsOut);
   fpr.ResetRegisters(js.op->GetFregsOut());
 
+  // The interpreter may have changed the rounding mode.
+  js.knownRoundingMode.reset();
+
   if (js.op->opinfo->flags & FL_ENDBLOCK)
   {
     if (js.isLastInstruction)
@@ -205,7 +221,13 @@ void JitArm64::FallBackToInterpreter(UGeckoInstruction inst)
       CMP(WB, WA);
       gpr.Unlock(WB);
       FixupBranch c = B(CC_EQ);
+      FixupBranch exit = B();
+
+      SwitchToFarCode();
+      SetJumpTarget(exit);
       WriteExceptionExit(WA);
+      SwitchToNearCode();
+
       SetJumpTarget(c);
       gpr.Unlock(WA);
     }
@@ -231,6 +253,7 @@ void JitArm64::HLEFunction(u32 hook_index)
   MOVI2R(ARM64Reg::W0, js.compilerPC);
   MOVI2R(ARM64Reg::W1, hook_index);
   BLR(ARM64Reg::X8);
+  js.knownRoundingMode.reset();
 }
 
 void JitArm64::DoNothing(UGeckoInstruction inst)
@@ -441,6 +464,175 @@ void JitArm64::WriteExit(Arm64Gen::ARM64Reg dest, bool LK, u32 exit_address_afte
   }
 }
 
+void JitArm64::WriteIndirectExit(Arm64Gen::ARM64Reg dest, bool LK, u32 exit_address_after_return)
+{
+  IndirectBranchCache* cache = blocks.AllocateIndirectBranchCache(js.curBlock->msrBits);
+  if (!cache)
+  {
+    WriteExit(dest, LK, exit_address_after_return);
+    return;
+  }
+
+  if (dest != DISPATCHER_PC)
+    MOV(DISPATCHER_PC, dest);
+
+  Cleanup();
+  EndTimeProfile(js.curBlock);
+  DoDownCount();
+
+  LK &= m_enable_blr_optimization;
+
+  FixupBranch do_timing = B(CC_LE);
+
+  MOVP2R(ARM64Reg::X1, cache);
+  std::array<FixupBranch, IndirectBranchCache::NUM_ENTRIES> hits;
+  for (u32 i = 0; i < IndirectBranchCache::NUM_ENTRIES; ++i)
+  {
+    LDR(IndexType::Unsigned, ARM64Reg::W0, ARM64Reg::X1,
+        offsetof(IndirectBranchCache, effective_addresses) + i * sizeof(u32));
+    CMP(ARM64Reg::W0, DISPATCHER_PC);
+    hits[i] = B(CC_EQ);
+  }
+  FixupBranch miss = B();
+
+  std::vector<FixupBranch> returns;
+  for (u32 i = 0; i < IndirectBranchCache::NUM_ENTRIES; ++i)
+  {
+    SetJumpTarget(hits[i]);
+    LDR(IndexType::Unsigned, ARM64Reg::X2, ARM64Reg::X1,
+        offsetof(IndirectBranchCache, normal_entries) + i * sizeof(const u8*));
+    if (LK)
+    {
+      // Push {ARM_PC, PPC_PC} on the stack
+      MOVI2R(ARM64Reg::X1, exit_address_after_return);
+      ADR(ARM64Reg::X0, 12);
+      STP(IndexType::Pre, ARM64Reg::X0, ARM64Reg::X1, ARM64Reg::SP, -16);
+      BLR(ARM64Reg::X2);
+      returns.push_back(B());
+    }
+    else
+    {
+      BR(ARM64Reg::X2);
+    }
+  }
+
+  SwitchToFarCode();
+  SetJumpTarget(miss);
+  STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+  MOVP2R(ARM64Reg::X0, static_cast<JitBaseBlockCache*>(&blocks));
+  MOVP2R(ARM64Reg::X1, cache);
+  MOVP2R(ARM64Reg::X8, &JitBaseBlockCache::UpdateIndirectBranchCache);
+  BLR(ARM64Reg::X8);
+  // The call clobbered the flags of the downcount check, which has been done already.
+  if (LK)
+  {
+    MOVI2R(ARM64Reg::X1, exit_address_after_return);
+    ADR(ARM64Reg::X0, 12);
+    STP(IndexType::Pre, ARM64Reg::X0, ARM64Reg::X1, ARM64Reg::SP, -16);
+    BL(dispatcher_no_timing_check);
+    returns.push_back(B());
+  }
+  else
+  {
+    B(dispatcher_no_timing_check);
+  }
+  SwitchToNearCode();
+
+  SetJumpTarget(do_timing);
+  if (!LK)
+  {
+    B(dispatcher);
+    return;
+  }
+
+  MOVI2R(ARM64Reg::X1, exit_address_after_return);
+  ADR(ARM64Reg::X0, 12);
+  STP(IndexType::Pre, ARM64Reg::X0, ARM64Reg::X1, ARM64Reg::SP, -16);
+  BL(dispatcher);
+
+  for (FixupBranch& fixup : returns)
+    SetJumpTarget(fixup);
+
+  // Write the regular exit node after the return.
+  JitBlock* b = js.curBlock;
+  JitBlock::LinkData linkData;
+  linkData.exitAddress = exit_address_after_return;
+  linkData.exitPtrs = GetWritableCodePtr();
+  linkData.linkStatus = false;
+  linkData.call = false;
+  b->linkData.push_back(linkData);
+
+  blocks.WriteLinkBlock(*this, linkData);
+}
+
+bool JitArm64::IsLoopBackEdge(const PPCAnalyst::CodeOp& op) const
+{
+  return op.inst.OPCD == 16 && !op.inst.LK && !op.skip && !op.branchIsIdleLoop &&
+         op.branchTo == js.blockStart;
+}
+
+bool JitArm64::CanUseLoopEntry() const
+{
+  // The loop entry skips everything emitted before it, and the back edges don't do the work of
+  // Cleanup which depends on settings checked at runtime by the normal exits.
+  if (!m_loop_register_entry || m_enable_debugging || jo.profile_blocks || bJITBranchOff ||
+      bJITRegisterCacheOff || MMCR0.Hex || MMCR1.Hex)
+  {
+    return false;
+  }
+
+  // The assumed rounding mode is only checked at the normal entry.
+  if (ShouldAssumeRoundingMode(code_block))
+    return false;
+
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+  {
+    if (IsLoopBackEdge(m_code_buffer[i]))
+      return true;
+  }
+  return false;
+}
+
+std::vector<size_t> JitArm64::GetLoopRegisters() const
+{
+  // The GPRs which are read before being written are the ones carried over between iterations.
+  // Prefer the ones which are read the most.
+  std::array<u32, 32> reads{};
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+  {
+    for (const int reg : m_code_buffer[i].regsIn)
+      reads[reg]++;
+  }
+
+  std::vector<size_t> regs;
+  for (const int reg : code_block.m_gpr_inputs)
+    regs.push_back(reg);
+  std::stable_sort(regs.begin(), regs.end(),
+                   [&reads](size_t a, size_t b) { return reads[a] > reads[b]; });
+  return regs;
+}
+
+void JitArm64::WriteLoopBackEdge(ARM64Reg tmp_reg)
+{
+  gpr.EmitLoopRegisterTransfer(tmp_reg);
+  Cleanup();
+  DoDownCount();
+
+  FixupBranch timing = B(CC_LE);
+  u8* const branch = GetWritableCodePtr();
+  B(m_loop_entry);
+
+  // Taken when the timeslice is over, or when the block has been destroyed. In the latter case,
+  // the dispatcher sees that the downcount is still positive and looks up the new block.
+  SetJumpTarget(timing);
+  u8* const exit_stub = GetWritableCodePtr();
+  gpr.EmitLoopRegisterStore();
+  MOVI2R(DISPATCHER_PC, js.blockStart);
+  B(dispatcher);
+
+  js.curBlock->loop_back_edges.push_back({branch, exit_stub});
+}
+
 void JitArm64::FakeLKExit(u32 exit_address_after_return)
 {
   if (!m_enable_blr_optimization)
@@ -477,7 +669,7 @@ void JitArm64::WriteBLRExit(Arm64Gen::ARM64Reg dest)
 {
   if (!m_enable_blr_optimization)
   {
-    WriteExit(dest);
+    WriteIndirectExit(dest);
     return;
   }
 
@@ -663,6 +855,8 @@ void JitArm64::Jit(u32 em_address)
 
 void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 {
+  VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::JitCompile);
+
   if (m_cleanup_after_stackfault)
   {
     ClearCache();
@@ -688,10 +882,12 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     m_fault_to_handler.erase(first_fastmem_area, last_fastmem_area);
 
     m_free_ranges_near.insert(range.first, range.second);
+    m_near_code_used -= range.second - range.first;
   }
   for (auto range : blocks.GetRangesToFreeFar())
   {
     m_free_ranges_far.insert(range.first, range.second);
+    m_far_code_used -= range.second - range.first;
   }
   blocks.ClearRangesToFree();
 
@@ -705,10 +901,16 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     block_size = 1;
   }
 
+  js.baselineTier = ShouldCompileBaselineTier(em_address);
+  const u32 analyzer_options = analyzer.GetOptions();
+  if (js.baselineTier)
+    analyzer.SetOptions(GetBaselineTierAnalyzerOptions(analyzer_options));
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
   const u32 nextPC = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  analyzer.SetOptions(analyzer_options);
 
   if (code_block.m_memory_exception)
   {
@@ -737,6 +939,9 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       u8* far_end = m_far_code.GetWritableCodePtr();
       if (far_start != far_end)
         m_free_ranges_far.erase(far_start, far_end);
+      m_near_code_used += near_end - near_start;
+      m_far_code_used += far_end - far_start;
+      PublishCodeSpaceStats();
 
       // Store the used memory regions in the block so we know what to mark as unused when the
       // block gets invalidated.
@@ -748,14 +953,28 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
       return;
     }
+
+    // The half written block may have registered fastmem areas, which must not outlive it.
+    m_fault_to_handler.erase(m_fault_to_handler.upper_bound(near_start),
+                             m_fault_to_handler.upper_bound(GetWritableCodePtr()));
+    blocks.DiscardBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
+    // Evict the least recently executed blocks and retry, or if that's not possible, clear the
+    // entire JIT cache and retry.
+    if (EvictColdBlocks())
+    {
+      Jit(em_address, true);
+      return;
+    }
+
     WARN_LOG_FMT(POWERPC, "flushing code caches, please report if this happens a lot");
     ClearCache();
+    ++m_code_space_stats.full_clears;
+    PublishCodeSpaceStats();
     Jit(em_address, false);
     return;
   }
@@ -793,7 +1012,8 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 {
   js.isLastInstruction = false;
   js.firstFPInstructionFound = false;
-  js.assumeNoPairedQuantize = false;
+  js.constantGqrValid = BitSet8();
+  js.knownRoundingMode.reset();
   js.blockStart = em_address;
   js.fifoBytesSinceCheck = 0;
   js.mustCheckFifo = false;
@@ -825,39 +1045,126 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     BeginTimeProfile(b);
   }
 
-  if (code_block.m_gqr_used.Count() == 1 &&
-      js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
+  // Mark the block as executed for least recently used eviction.
+  if (m_cache_eviction)
+  {
+    MOVP2R(ARM64Reg::X0, &b->notExecuted);
+    STRB(IndexType::Unsigned, ARM64Reg::WZR, ARM64Reg::X0, 0);
+  }
+
+  // Baseline tier blocks count their executions and request a fully optimized recompile once
+  // they turn out to be hot.
+  if (js.baselineTier)
   {
-    int gqr = *code_block.m_gqr_used.begin();
-    if (!code_block.m_gqr_modified[gqr] && !GQR(gqr))
+    b->tierUpCountdown = TIER_UP_THRESHOLD;
+    MOVP2R(ARM64Reg::X0, &b->tierUpCountdown);
+    LDR(IndexType::Unsigned, ARM64Reg::W1, ARM64Reg::X0, 0);
+    SUBS(ARM64Reg::W1, ARM64Reg::W1, 1);
+    STR(IndexType::Unsigned, ARM64Reg::W1, ARM64Reg::X0, 0);
+    FixupBranch not_hot = B(CC_NEQ);
+    FixupBranch hot = B();
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    MOVP2R(ARM64Reg::X8, &JitInterface::CompileExceptionCheck);
+    MOVI2R(ARM64Reg::W0, static_cast<u32>(JitInterface::ExceptionType::TierUp));
+    // Write dispatcher_no_check to LR for tail call
+    MOVP2R(ARM64Reg::X30, dispatcher_no_check);
+    BR(ARM64Reg::X8);
+    SwitchToNearCode();
+    SetJumpTarget(not_hot);
+  }
+
+  // Assume that GQR values don't change often at runtime. GQRs which are used but not set in the
+  // block are treated as constants, which lets psq_l and psq_st quantize inline with NEON instead
+  // of calling into the quantized load and store routines.
+  const BitSet8 gqr_static = ComputeStaticGQRs(code_block);
+  if (gqr_static)
+  {
+    SwitchToFarCode();
+    const u8* target = GetCodePtr();
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    MOVP2R(ARM64Reg::X8, &JitInterface::CompileGQRCheck);
+    // Write dispatcher_no_check to LR for tail call
+    MOVP2R(ARM64Reg::X30, dispatcher_no_check);
+    BR(ARM64Reg::X8);
+    SwitchToNearCode();
+
+    // Only the GQR which changed stops being specialized when the block gets recompiled.
+    for (int gqr : gqr_static)
     {
+      const u32 value = GQR(gqr);
       LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + gqr));
-      FixupBranch no_fail = CBZ(ARM64Reg::W0);
+      FixupBranch no_fail;
+      if (value == 0)
+      {
+        no_fail = CBZ(ARM64Reg::W0);
+      }
+      else
+      {
+        MOVI2R(ARM64Reg::W1, value);
+        CMP(ARM64Reg::W0, ARM64Reg::W1);
+        no_fail = B(CC_EQ);
+      }
       FixupBranch fail = B();
       SwitchToFarCode();
       SetJumpTarget(fail);
-      MOVI2R(DISPATCHER_PC, js.blockStart);
-      STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
-      MOVP2R(ARM64Reg::X8, &JitInterface::CompileExceptionCheck);
-      MOVI2R(ARM64Reg::W0, static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
-      // Write dispatcher_no_check to LR for tail call
-      MOVP2R(ARM64Reg::X30, dispatcher_no_check);
-      BR(ARM64Reg::X8);
+      MOVI2R(ARM64Reg::W0, gqr);
+      B(target);
       SwitchToNearCode();
       SetJumpTarget(no_fail);
-      js.assumeNoPairedQuantize = true;
+      js.constantGqr[gqr] = value;
     }
+
+    js.constantGqrValid = gqr_static;
+  }
+
+  if (ShouldAssumeRoundingMode(code_block))
+  {
+    const u32 rounding_mode = FPSCR.Hex & ROUNDING_MODE_MASK;
+    LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF(fpscr));
+    AND(ARM64Reg::W0, ARM64Reg::W0, LogicalImm(ROUNDING_MODE_MASK, 32));
+    CMP(ARM64Reg::W0, rounding_mode);
+    FixupBranch match = B(CC_EQ);
+    FixupBranch mismatch = B();
+    SwitchToFarCode();
+    SetJumpTarget(mismatch);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    MOVP2R(ARM64Reg::X8, &JitInterface::CompileExceptionCheck);
+    MOVI2R(ARM64Reg::W0, static_cast<u32>(JitInterface::ExceptionType::RoundingMode));
+    // Write dispatcher_no_check to LR for tail call
+    MOVP2R(ARM64Reg::X30, dispatcher_no_check);
+    BR(ARM64Reg::X8);
+    SwitchToNearCode();
+    SetJumpTarget(match);
+
+    js.knownRoundingMode = rounding_mode;
   }
 
   gpr.Start(js.gpa);
   fpr.Start(js.fpa);
 
-  if (js.noSpeculativeConstantsAddresses.find(js.blockStart) ==
-      js.noSpeculativeConstantsAddresses.end())
+  // Speculative constants are checked at the normal entry only, so they can't be combined with a
+  // loop entry.
+  m_loop_entry = nullptr;
+  const bool use_loop_entry = CanUseLoopEntry();
+
+  if (!use_loop_entry && !js.baselineTier &&
+      js.noSpeculativeConstantsAddresses.find(js.blockStart) ==
+          js.noSpeculativeConstantsAddresses.end())
   {
     IntializeSpeculativeConstants();
   }
 
+  if (use_loop_entry)
+  {
+    gpr.LoadLoopRegisters(GetLoopRegisters());
+    m_loop_entry = GetCodePtr();
+  }
+
   // Translate instructions
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
@@ -894,16 +1201,34 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
       js.mustCheckFifo = false;
 
       gpr.Lock(ARM64Reg::W30);
+      const ARM64Reg WA = gpr.GetReg();
+      const ARM64Reg XA = EncodeRegTo64(WA);
       BitSet32 regs_in_use = gpr.GetCallerSavedUsed();
       BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
       regs_in_use[DecodeReg(ARM64Reg::W30)] = 0;
+      regs_in_use[DecodeReg(WA)] = 0;
+
+      // Check the pipe inline, so that only a full one pays for saving the registers. The pipe is
+      // then flushed in as many whole bursts as it holds.
+      static_assert(PPCSTATE_OFF(gather_pipe_ptr) <= 504);
+      static_assert(PPCSTATE_OFF(gather_pipe_ptr) + 8 == PPCSTATE_OFF(gather_pipe_base_ptr));
+      LDP(IndexType::Signed, ARM64Reg::X30, XA, PPC_REG, PPCSTATE_OFF(gather_pipe_ptr));
+      SUB(ARM64Reg::X30, ARM64Reg::X30, XA);
+      CMP(ARM64Reg::X30, GPFifo::GATHER_PIPE_SIZE);
+      FixupBranch pipe_full = B(CC_GE);
+      gpr.Unlock(WA);
 
+      SwitchToFarCode();
+      SetJumpTarget(pipe_full);
       ABI_PushRegisters(regs_in_use);
       m_float_emit.ABI_PushRegisters(fprs_in_use, ARM64Reg::X30);
-      MOVP2R(ARM64Reg::X8, &GPFifo::FastCheckGatherPipe);
+      MOVP2R(ARM64Reg::X8, &GPFifo::UpdateGatherPipe);
       BLR(ARM64Reg::X8);
       m_float_emit.ABI_PopRegisters(fprs_in_use, ARM64Reg::X30);
       ABI_PopRegisters(regs_in_use);
+      FixupBranch pipe_flushed = B();
+      SwitchToNearCode();
+      SetJumpTarget(pipe_flushed);
 
       // Inline exception check
       LDR(IndexType::Unsigned, ARM64Reg::W30, PPC_REG, PPCSTATE_OFF(Exceptions));
@@ -304,6 +304,10 @@ protected:
   // Exits
   void WriteExit(u32 destination, bool LK = false, u32 exit_address_after_return = 0);
   void WriteExit(Arm64Gen::ARM64Reg dest, bool LK = false, u32 exit_address_after_return = 0);
+  // Like WriteExit, but for guest code branching to a computed address, which goes through an
+  // indirect branch cache if enabled.
+  void WriteIndirectExit(Arm64Gen::ARM64Reg dest, bool LK = false,
+                         u32 exit_address_after_return = 0);
   void WriteExceptionExit(u32 destination, bool only_external = false,
                           bool always_exception = false);
   void WriteExceptionExit(Arm64Gen::ARM64Reg dest, bool only_external = false,
@@ -314,6 +318,15 @@ protected:
                                      u64 increment_sp_on_exit = 0);
   void FakeLKExit(u32 exit_address_after_return);
   void WriteBLRExit(Arm64Gen::ARM64Reg dest);
+  void WriteTakenBranchCounter(const PPCAnalyst::CodeOp& op);
+
+  // Blocks ending in a branch back to their own start get a second entry point, right after the
+  // guest GPRs carried between iterations have been loaded. Their back edges move the registers
+  // into place and branch there directly instead of flushing and going through a block link.
+  bool IsLoopBackEdge(const PPCAnalyst::CodeOp& op) const;
+  bool CanUseLoopEntry() const;
+  std::vector<size_t> GetLoopRegisters() const;
+  void WriteLoopBackEdge(Arm64Gen::ARM64Reg tmp_reg);
 
   Arm64Gen::FixupBranch JumpIfCRFieldBit(int field, int bit, bool jump_if_set);
   void FixGTBeforeSettingCRFieldBit(Arm64Gen::ARM64Reg reg);
@@ -356,6 +369,8 @@ protected:
 
   bool m_enable_blr_optimization;
   bool m_cleanup_after_stackfault = false;
+  // Loop entry of the block being compiled, or nullptr if it has none.
+  const u8* m_loop_entry = nullptr;
   u8* m_stack_base = nullptr;
   u8* m_stack_pointer = nullptr;
   u8* m_saved_stack_pointer = nullptr;
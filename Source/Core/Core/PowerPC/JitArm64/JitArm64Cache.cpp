@@ -81,6 +81,13 @@ void JitArm64BlockCache::WriteDestroyBlock(const JitBlock& block)
   while (emit.GetWritableCodePtr() <= block.normalEntry)
     emit.BRK(0x123);
   emit.FlushIcache();
+
+  for (const JitBlock::LoopBackEdge& edge : block.loop_back_edges)
+  {
+    ARM64XEmitter edge_emit(edge.branch, edge.branch + 4);
+    edge_emit.B(edge.exit_stub);
+    edge_emit.FlushIcache();
+  }
 }
 
 void JitArm64BlockCache::DestroyBlock(JitBlock& block)
@@ -9,6 +9,7 @@
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/PowerPC/JitArm64/JitArm64_RegCache.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCTables.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -116,6 +117,32 @@ void JitArm64::bx(UGeckoInstruction inst)
   WriteExit(js.op->branchTo, inst.LK, js.compilerPC + 4);
 }
 
+// Must be called with all registers flushed.
+void JitArm64::WriteTakenBranchCounter(const PPCAnalyst::CodeOp& op)
+{
+  u32* counter = GetTakenBranchCounter(op);
+  if (!counter)
+    return;
+
+  ARM64Reg WA = gpr.GetReg();
+  ARM64Reg WB = gpr.GetReg();
+  ARM64Reg XB = EncodeRegTo64(WB);
+
+  MOVP2R(XB, counter);
+  LDR(IndexType::Unsigned, WA, XB, 0);
+  SUBS(WA, WA, 1);
+  STR(IndexType::Unsigned, WA, XB, 0);
+  FixupBranch not_hot = B(CC_NEQ);
+  MOVI2R(WA, op.address);
+  STR(IndexType::Unsigned, WA, PPC_REG, PPCSTATE_OFF(pc));
+  MOVP2R(ARM64Reg::X8, &JitInterface::CompileExceptionCheck);
+  MOVI2R(ARM64Reg::W0, static_cast<u32>(JitInterface::ExceptionType::TakenBranch));
+  BLR(ARM64Reg::X8);
+  SetJumpTarget(not_hot);
+
+  gpr.Unlock(WA, WB);
+}
+
 void JitArm64::bcx(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -143,6 +170,31 @@ void JitArm64::bcx(UGeckoInstruction inst)
         JumpIfCRFieldBit(inst.BI >> 2, 3 - (inst.BI & 3), !(inst.BO_2 & BO_BRANCH_IF_TRUE));
   }
 
+  // The analyzer stitched the taken path into this block, so the fallthrough is the exit instead.
+  if (js.op->followConditionalBranch)
+  {
+    FixupBranch taken = B();
+
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+
+    FixupBranch far_addr = B();
+    SwitchToFarCode();
+    SetJumpTarget(far_addr);
+
+    gpr.Flush(FlushMode::MaintainState, WA);
+    fpr.Flush(FlushMode::MaintainState, ARM64Reg::INVALID_REG);
+    WriteExit(js.compilerPC + 4);
+
+    SwitchToNearCode();
+    SetJumpTarget(taken);
+
+    gpr.Unlock(WA);
+    return;
+  }
+
   FixupBranch far_addr = B();
   SwitchToFarCode();
   SetJumpTarget(far_addr);
@@ -153,11 +205,17 @@ void JitArm64::bcx(UGeckoInstruction inst)
     STR(IndexType::Unsigned, WA, PPC_REG, PPCSTATE_OFF_SPR(SPR_LR));
   }
 
-  gpr.Flush(FlushMode::MaintainState, WA);
-  fpr.Flush(FlushMode::MaintainState, ARM64Reg::INVALID_REG);
-
-  if (js.op->branchIsIdleLoop)
+  if (m_loop_entry && IsLoopBackEdge(*js.op))
   {
+    // The GPRs are handled by the back edge itself.
+    fpr.Flush(FlushMode::MaintainState, ARM64Reg::INVALID_REG);
+    WriteLoopBackEdge(WA);
+  }
+  else if (js.op->branchIsIdleLoop)
+  {
+    gpr.Flush(FlushMode::MaintainState, WA);
+    fpr.Flush(FlushMode::MaintainState, ARM64Reg::INVALID_REG);
+
     // make idle loops go faster
     ARM64Reg XA = EncodeRegTo64(WA);
 
@@ -168,6 +226,10 @@ void JitArm64::bcx(UGeckoInstruction inst)
   }
   else
   {
+    gpr.Flush(FlushMode::MaintainState, WA);
+    fpr.Flush(FlushMode::MaintainState, ARM64Reg::INVALID_REG);
+
+    WriteTakenBranchCounter(*js.op);
     WriteExit(js.op->branchTo, inst.LK, js.compilerPC + 4);
   }
 
@@ -221,7 +283,7 @@ void JitArm64::bcctrx(UGeckoInstruction inst)
   LDR(IndexType::Unsigned, WA, PPC_REG, PPCSTATE_OFF_SPR(SPR_CTR));
   AND(WA, WA, LogicalImm(~0x3, 32));
 
-  WriteExit(WA, inst.LK_3, js.compilerPC + 4);
+  WriteIndirectExit(WA, inst.LK_3, js.compilerPC + 4);
 
   gpr.Unlock(WA);
 }
@@ -30,12 +30,18 @@ using namespace JitCommon;
 
 void JitArm64::ComputeRC0(ARM64Reg reg)
 {
+  if (!js.op->wantsCR[0])
+    return;
+
   gpr.BindCRToRegister(0, false);
   SXTW(gpr.CR(0), reg);
 }
 
 void JitArm64::ComputeRC0(u64 imm)
 {
+  if (!js.op->wantsCR[0])
+    return;
+
   gpr.BindCRToRegister(0, false);
   MOVI2R(gpr.CR(0), imm);
   if (imm & 0x80000000)
@@ -569,6 +575,8 @@ void JitArm64::cmp(UGeckoInstruction inst)
   JITDISABLE(bJITIntegerOff);
 
   int crf = inst.CRFD;
+  if (!js.op->wantsCR[crf])
+    return;
   u32 a = inst.RA, b = inst.RB;
 
   gpr.BindCRToRegister(crf, false);
@@ -610,6 +618,8 @@ void JitArm64::cmpl(UGeckoInstruction inst)
   JITDISABLE(bJITIntegerOff);
 
   int crf = inst.CRFD;
+  if (!js.op->wantsCR[crf])
+    return;
   u32 a = inst.RA, b = inst.RB;
 
   gpr.BindCRToRegister(crf, false);
@@ -643,6 +653,8 @@ void JitArm64::cmpi(UGeckoInstruction inst)
   u32 a = inst.RA;
   s64 B = inst.SIMM_16;
   int crf = inst.CRFD;
+  if (!js.op->wantsCR[crf])
+    return;
 
   gpr.BindCRToRegister(crf, false);
   ARM64Reg CR = gpr.CR(crf);
@@ -671,6 +683,8 @@ void JitArm64::cmpli(UGeckoInstruction inst)
   u32 a = inst.RA;
   u64 B = inst.UIMM;
   int crf = inst.CRFD;
+  if (!js.op->wantsCR[crf])
+    return;
 
   gpr.BindCRToRegister(crf, false);
   ARM64Reg CR = gpr.CR(crf);
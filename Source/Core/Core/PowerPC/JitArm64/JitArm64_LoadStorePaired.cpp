@@ -22,9 +22,6 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
 
-  // If we have a fastmem arena, the asm routines assume address translation is on.
-  FALLBACK_IF(!js.assumeNoPairedQuantize && jo.fastmem_arena && !MSR.DR);
-
   // X30 is LR
   // X0 is the address
   // X1 contains the scale
@@ -37,9 +34,18 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
   const int i = indexed ? inst.Ix : inst.I;
   const int w = indexed ? inst.Wx : inst.W;
 
+  // If the GQR is known at compile time, the load and the dequantization are emitted inline.
+  const UGQR gqr(js.constantGqr[i]);
+  const EQuantizeType type = gqr.ld_type;
+  const bool inline_quantize =
+      js.constantGqrValid[i] && (type == QUANTIZE_FLOAT || type >= QUANTIZE_U8);
+
+  // If we have a fastmem arena, the asm routines assume address translation is on.
+  FALLBACK_IF(!inline_quantize && jo.fastmem_arena && !MSR.DR);
+
   gpr.Lock(ARM64Reg::W0, ARM64Reg::W30);
   fpr.Lock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!inline_quantize)
   {
     gpr.Lock(ARM64Reg::W1, ARM64Reg::W2, ARM64Reg::W3);
     fpr.Lock(ARM64Reg::Q1);
@@ -78,7 +84,7 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (inline_quantize)
   {
     BitSet32 gprs_in_use = gpr.GetCallerSavedUsed();
     BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
@@ -92,12 +98,48 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
     if (!jo.memcheck)
       fprs_in_use[DecodeReg(VS)] = 0;
 
-    u32 flags = BackPatchInfo::FLAG_LOAD | BackPatchInfo::FLAG_FLOAT | BackPatchInfo::FLAG_SIZE_32;
+    u32 flags = BackPatchInfo::FLAG_LOAD | BackPatchInfo::FLAG_FLOAT;
+    if (type == QUANTIZE_U8 || type == QUANTIZE_S8)
+      flags |= BackPatchInfo::FLAG_SIZE_8;
+    else if (type == QUANTIZE_U16 || type == QUANTIZE_S16)
+      flags |= BackPatchInfo::FLAG_SIZE_16;
+    else
+      flags |= BackPatchInfo::FLAG_SIZE_32;
     if (!w)
       flags |= BackPatchInfo::FLAG_PAIR;
 
     EmitBackpatchRoutine(flags, MemAccessMode::Auto, VS, EncodeRegTo64(addr_reg), gprs_in_use,
                          fprs_in_use);
+
+    if (type != QUANTIZE_FLOAT)
+    {
+      const ARM64Reg VS_d = EncodeRegToDouble(VS);
+      const bool is_signed = type == QUANTIZE_S8 || type == QUANTIZE_S16;
+
+      if (type == QUANTIZE_U8)
+        m_float_emit.UXTL(8, VS_d, VS_d);
+      else if (type == QUANTIZE_S8)
+        m_float_emit.SXTL(8, VS_d, VS_d);
+
+      if (is_signed)
+      {
+        m_float_emit.SXTL(16, VS_d, VS_d);
+        m_float_emit.SCVTF(32, VS_d, VS_d);
+      }
+      else
+      {
+        m_float_emit.UXTL(16, VS_d, VS_d);
+        m_float_emit.UCVTF(32, VS_d, VS_d);
+      }
+
+      // A scale of zero dequantizes by multiplying with 1.0
+      if (gqr.ld_scale != 0)
+      {
+        const s32 load_offset = MOVPage2R(ARM64Reg::X30, &m_dequantizeTableS[gqr.ld_scale * 2]);
+        m_float_emit.LDR(32, IndexType::Unsigned, ARM64Reg::D0, ARM64Reg::X30, load_offset);
+        m_float_emit.FMUL(32, VS_d, VS_d, ARM64Reg::D0, 0);
+      }
+    }
   }
   else
   {
@@ -131,7 +173,7 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
 
   gpr.Unlock(ARM64Reg::W0, ARM64Reg::W30);
   fpr.Unlock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!inline_quantize)
   {
     gpr.Unlock(ARM64Reg::W1, ARM64Reg::W2, ARM64Reg::W3);
     fpr.Unlock(ARM64Reg::Q1);
@@ -147,9 +189,6 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
 
-  // If we have a fastmem arena, the asm routines assume address translation is on.
-  FALLBACK_IF(!js.assumeNoPairedQuantize && jo.fastmem_arena && !MSR.DR);
-
   // X30 is LR
   // X0 contains the scale
   // X1 is the address
@@ -161,26 +200,77 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   const int i = indexed ? inst.Ix : inst.I;
   const int w = indexed ? inst.Wx : inst.W;
 
+  // If the GQR is known at compile time, the quantization and the store are emitted inline.
+  const UGQR gqr(js.constantGqr[i]);
+  const EQuantizeType type = gqr.st_type;
+  const bool inline_quantize =
+      js.constantGqrValid[i] && (type == QUANTIZE_FLOAT || type >= QUANTIZE_U8);
+
+  // If we have a fastmem arena, the asm routines assume address translation is on.
+  FALLBACK_IF(!inline_quantize && jo.fastmem_arena && !MSR.DR);
+
   fpr.Lock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!inline_quantize)
     fpr.Lock(ARM64Reg::Q1);
 
+  gpr.Lock(ARM64Reg::W0, ARM64Reg::W1, ARM64Reg::W30);
+  if (!inline_quantize || !jo.fastmem_arena)
+    gpr.Lock(ARM64Reg::W2);
+  if (!inline_quantize && !jo.fastmem_arena)
+    gpr.Lock(ARM64Reg::W3);
+
   const bool have_single = fpr.IsSingle(inst.RS);
 
   ARM64Reg VS = fpr.R(inst.RS, have_single ? RegType::Single : RegType::Register);
+  bool unlock_vs = false;
 
-  if (js.assumeNoPairedQuantize)
+  if (inline_quantize)
   {
-    if (!have_single)
+    if (!have_single || type != QUANTIZE_FLOAT)
     {
       const ARM64Reg single_reg = fpr.GetReg();
-
-      if (w)
-        m_float_emit.FCVT(32, 64, EncodeRegToDouble(single_reg), EncodeRegToDouble(VS));
-      else
-        m_float_emit.FCVTN(32, EncodeRegToDouble(single_reg), EncodeRegToDouble(VS));
+      const ARM64Reg single_reg_d = EncodeRegToDouble(single_reg);
+      ARM64Reg src_reg = EncodeRegToDouble(VS);
+
+      if (!have_single)
+      {
+        if (w)
+          m_float_emit.FCVT(32, 64, single_reg_d, src_reg);
+        else
+          m_float_emit.FCVTN(32, single_reg_d, src_reg);
+
+        src_reg = single_reg_d;
+      }
+
+      if (type != QUANTIZE_FLOAT)
+      {
+        // A scale of zero quantizes by multiplying with 1.0
+        if (gqr.st_scale != 0)
+        {
+          const s32 load_offset = MOVPage2R(ARM64Reg::X30, &m_quantizeTableS[gqr.st_scale * 2]);
+          m_float_emit.LDR(32, IndexType::Unsigned, ARM64Reg::D0, ARM64Reg::X30, load_offset);
+          m_float_emit.FMUL(32, single_reg_d, src_reg, ARM64Reg::D0, 0);
+          src_reg = single_reg_d;
+        }
+
+        if (type == QUANTIZE_S8 || type == QUANTIZE_S16)
+        {
+          m_float_emit.FCVTZS(32, single_reg_d, src_reg);
+          m_float_emit.SQXTN(16, single_reg_d, single_reg_d);
+          if (type == QUANTIZE_S8)
+            m_float_emit.SQXTN(8, single_reg_d, single_reg_d);
+        }
+        else
+        {
+          m_float_emit.FCVTZU(32, single_reg_d, src_reg);
+          m_float_emit.UQXTN(16, single_reg_d, single_reg_d);
+          if (type == QUANTIZE_U8)
+            m_float_emit.UQXTN(8, single_reg_d, single_reg_d);
+        }
+      }
 
       VS = single_reg;
+      unlock_vs = true;
     }
   }
   else
@@ -198,12 +288,6 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     }
   }
 
-  gpr.Lock(ARM64Reg::W0, ARM64Reg::W1, ARM64Reg::W30);
-  if (!js.assumeNoPairedQuantize || !jo.fastmem_arena)
-    gpr.Lock(ARM64Reg::W2);
-  if (!js.assumeNoPairedQuantize && !jo.fastmem_arena)
-    gpr.Lock(ARM64Reg::W3);
-
   constexpr ARM64Reg scale_reg = ARM64Reg::W0;
   constexpr ARM64Reg addr_reg = ARM64Reg::W1;
   constexpr ARM64Reg type_reg = ARM64Reg::W2;
@@ -232,7 +316,7 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (inline_quantize)
   {
     BitSet32 gprs_in_use = gpr.GetCallerSavedUsed();
     BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
@@ -244,7 +328,13 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     if (!jo.fastmem_arena)
       gprs_in_use[DecodeReg(ARM64Reg::W2)] = false;
 
-    u32 flags = BackPatchInfo::FLAG_STORE | BackPatchInfo::FLAG_FLOAT | BackPatchInfo::FLAG_SIZE_32;
+    u32 flags = BackPatchInfo::FLAG_STORE | BackPatchInfo::FLAG_FLOAT;
+    if (type == QUANTIZE_U8 || type == QUANTIZE_S8)
+      flags |= BackPatchInfo::FLAG_SIZE_8;
+    else if (type == QUANTIZE_U16 || type == QUANTIZE_S16)
+      flags |= BackPatchInfo::FLAG_SIZE_16;
+    else
+      flags |= BackPatchInfo::FLAG_SIZE_32;
     if (!w)
       flags |= BackPatchInfo::FLAG_PAIR;
 
@@ -270,15 +360,15 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize && !have_single)
+  if (unlock_vs)
     fpr.Unlock(VS);
 
   gpr.Unlock(ARM64Reg::W0, ARM64Reg::W1, ARM64Reg::W30);
   fpr.Unlock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize || !jo.fastmem_arena)
+  if (!inline_quantize || !jo.fastmem_arena)
     gpr.Unlock(ARM64Reg::W2);
-  if (!js.assumeNoPairedQuantize && !jo.fastmem_arena)
+  if (!inline_quantize && !jo.fastmem_arena)
     gpr.Unlock(ARM64Reg::W3);
-  if (!js.assumeNoPairedQuantize)
+  if (!inline_quantize)
     fpr.Unlock(ARM64Reg::Q1);
 }
@@ -147,6 +147,7 @@ Arm64GPRCache::Arm64GPRCache() : Arm64RegCache(GUEST_GPR_COUNT + GUEST_CR_COUNT)
 
 void Arm64GPRCache::Start(PPCAnalyst::BlockRegStats& stats)
 {
+  m_loop_registers = BitSet32{};
 }
 
 bool Arm64GPRCache::IsCallerSaved(ARM64Reg reg) const
@@ -386,6 +387,71 @@ void Arm64GPRCache::BindToRegister(const GuestRegInfo& guest_reg, bool will_read
   }
 }
 
+BitSet32 Arm64GPRCache::LoadLoopRegisters(const std::vector<size_t>& regs)
+{
+  for (const size_t preg : regs)
+  {
+    // GetReg hands out the first unlocked register in allocation order, and the callee saved
+    // registers come first. Caller saved ones would have to be saved around every call.
+    const auto next = std::find_if(m_host_registers.begin(), m_host_registers.end(),
+                                   [](const HostReg& reg) { return !reg.IsLocked(); });
+    if (next == m_host_registers.end() || IsCallerSaved(next->GetReg()))
+      break;
+
+    BindToRegister(preg, true, true);
+    m_loop_registers[preg] = true;
+    m_loop_host_registers[preg] = GetGuestGPROpArg(preg).GetReg();
+  }
+
+  return m_loop_registers;
+}
+
+void Arm64GPRCache::EmitLoopRegisterTransfer(ARM64Reg tmp_reg)
+{
+  for (size_t i = 0; i < GUEST_GPR_COUNT; ++i)
+  {
+    if (!m_loop_registers[i])
+      FlushRegister(GUEST_GPR_OFFSET + i, true, tmp_reg);
+  }
+  FlushCRRegisters(BitSet32(~0U), true, tmp_reg);
+
+  // A loop register currently living in the wrong host register may be sitting in the host
+  // register of another loop register, so write all of those back before loading any of them.
+  for (const size_t i : m_loop_registers)
+  {
+    const OpArg& reg = m_guest_registers[GUEST_GPR_OFFSET + i];
+    if (reg.GetType() == RegType::Register && reg.IsDirty() &&
+        DecodeReg(reg.GetReg()) != DecodeReg(m_loop_host_registers[i]))
+    {
+      m_emit->STR(IndexType::Unsigned, reg.GetReg(), PPC_REG, u32(PPCSTATE_OFF_GPR(i)));
+    }
+  }
+
+  for (const size_t i : m_loop_registers)
+  {
+    const OpArg& reg = m_guest_registers[GUEST_GPR_OFFSET + i];
+    const ARM64Reg host_reg = m_loop_host_registers[i];
+    if (reg.GetType() == RegType::Immediate)
+    {
+      m_emit->MOVI2R(host_reg, reg.GetImm());
+    }
+    else if (reg.GetType() != RegType::Register ||
+             DecodeReg(reg.GetReg()) != DecodeReg(host_reg))
+    {
+      m_emit->LDR(IndexType::Unsigned, host_reg, PPC_REG, u32(PPCSTATE_OFF_GPR(i)));
+    }
+  }
+}
+
+void Arm64GPRCache::EmitLoopRegisterStore()
+{
+  for (const size_t i : m_loop_registers)
+  {
+    m_emit->STR(IndexType::Unsigned, m_loop_host_registers[i], PPC_REG,
+                u32(PPCSTATE_OFF_GPR(i)));
+  }
+}
+
 void Arm64GPRCache::GetAllocationOrder()
 {
   // Callee saved registers first in hopes that we will keep everything stored there first
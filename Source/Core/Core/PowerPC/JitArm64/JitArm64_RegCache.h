@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <memory>
 #include <type_traits>
@@ -322,6 +323,21 @@ public:
     FlushCRRegisters(regs, false, tmp_reg);
   }
 
+  // Support for blocks which branch back to their own start while keeping guest GPRs in host
+  // registers across iterations.
+  //
+  // Binds the given guest GPRs, in order of priority, to callee saved host registers for as long
+  // as there are free ones, and marks them as dirty. Returns which GPRs got bound.
+  BitSet32 LoadLoopRegisters(const std::vector<size_t>& regs);
+
+  // Emits code turning the current state into the one set up by LoadLoopRegisters: all other
+  // guest registers are written back to ppcState and the loop registers are moved into their host
+  // registers. Like FlushMode::MaintainState, this leaves the state of the cache unchanged.
+  void EmitLoopRegisterTransfer(Arm64Gen::ARM64Reg tmp_reg);
+
+  // Emits code writing the loop registers back, for leaving the block after a transfer.
+  void EmitLoopRegisterStore();
+
 protected:
   // Get the order of the host registers
   void GetAllocationOrder() override;
@@ -353,6 +369,9 @@ private:
 
   void FlushRegisters(BitSet32 regs, bool maintain_state, Arm64Gen::ARM64Reg tmp_reg);
   void FlushCRRegisters(BitSet32 regs, bool maintain_state, Arm64Gen::ARM64Reg tmp_reg);
+
+  BitSet32 m_loop_registers;
+  std::array<Arm64Gen::ARM64Reg, 32> m_loop_host_registers{};
 };
 
 class Arm64FPRCache : public Arm64RegCache
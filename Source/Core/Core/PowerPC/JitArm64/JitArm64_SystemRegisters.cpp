@@ -811,7 +811,7 @@ void JitArm64::mtfsb0x(UGeckoInstruction inst)
 
   gpr.Unlock(WA);
 
-  if (inst.CRBD >= 29)
+  if (inst.CRBD >= 29 && SetKnownRoundingMode(GetRoundingModeAfterBitWrite(mask, false)))
     UpdateRoundingMode();
 }
 
@@ -847,7 +847,7 @@ void JitArm64::mtfsb1x(UGeckoInstruction inst)
 
   gpr.Unlock(WA);
 
-  if (inst.CRBD >= 29)
+  if (inst.CRBD >= 29 && SetKnownRoundingMode(GetRoundingModeAfterBitWrite(mask, true)))
     UpdateRoundingMode();
 }
 
@@ -889,7 +889,7 @@ void JitArm64::mtfsfix(UGeckoInstruction inst)
   gpr.Unlock(WA);
 
   // Field 7 contains NI and RN.
-  if (inst.CRFD == 7)
+  if (inst.CRFD == 7 && SetKnownRoundingMode(imm & ROUNDING_MODE_MASK))
     UpdateRoundingMode();
 }
 
@@ -956,5 +956,8 @@ void JitArm64::mtfsfx(UGeckoInstruction inst)
   }
 
   if (inst.FM & 1)
+  {
+    js.knownRoundingMode.reset();
     UpdateRoundingMode();
+  }
 }
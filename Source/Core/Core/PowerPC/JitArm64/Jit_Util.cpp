@@ -78,10 +78,22 @@ private:
 
     m_emit->ABI_PushRegisters(m_gprs_in_use);
     float_emit.ABI_PushRegisters(m_fprs_in_use, ARM64Reg::X1);
-    m_emit->MOVP2R(ARM64Reg::X1, &Core::System::GetInstance());
-    m_emit->MOVI2R(ARM64Reg::W2, m_address);
-    m_emit->MOV(ARM64Reg::W3, m_src_reg);
-    m_emit->BLR(m_emit->ABI_SetupLambda(lambda));
+    // Handlers created from lambdas without captures hold a plain function,
+    // which can be called without going through the std::function.
+    if (const auto* function = lambda->template target<void (*)(Core::System&, u32, T)>())
+    {
+      m_emit->MOV(ARM64Reg::W2, m_src_reg);
+      m_emit->MOVP2R(ARM64Reg::X0, &Core::System::GetInstance());
+      m_emit->MOVI2R(ARM64Reg::W1, m_address);
+      m_emit->QuickCallFunction(ARM64Reg::X8, *function);
+    }
+    else
+    {
+      m_emit->MOVP2R(ARM64Reg::X1, &Core::System::GetInstance());
+      m_emit->MOVI2R(ARM64Reg::W2, m_address);
+      m_emit->MOV(ARM64Reg::W3, m_src_reg);
+      m_emit->BLR(m_emit->ABI_SetupLambda(lambda));
+    }
 
     float_emit.ABI_PopRegisters(m_fprs_in_use, ARM64Reg::X1);
     m_emit->ABI_PopRegisters(m_gprs_in_use);
@@ -175,9 +187,18 @@ private:
 
     m_emit->ABI_PushRegisters(m_gprs_in_use);
     float_emit.ABI_PushRegisters(m_fprs_in_use, ARM64Reg::X1);
-    m_emit->MOVP2R(ARM64Reg::X1, &Core::System::GetInstance());
-    m_emit->MOVI2R(ARM64Reg::W2, m_address);
-    m_emit->BLR(m_emit->ABI_SetupLambda(lambda));
+    if (const auto* function = lambda->template target<T (*)(Core::System&, u32)>())
+    {
+      m_emit->MOVP2R(ARM64Reg::X0, &Core::System::GetInstance());
+      m_emit->MOVI2R(ARM64Reg::W1, m_address);
+      m_emit->QuickCallFunction(ARM64Reg::X8, *function);
+    }
+    else
+    {
+      m_emit->MOVP2R(ARM64Reg::X1, &Core::System::GetInstance());
+      m_emit->MOVI2R(ARM64Reg::W2, m_address);
+      m_emit->BLR(m_emit->ABI_SetupLambda(lambda));
+    }
     if (m_sign_extend)
       m_emit->SBFM(m_dst_reg, ARM64Reg::W0, 0, sbits - 1);
     else
@@ -3,11 +3,16 @@
 
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
+#include <algorithm>
+
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/Timer.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HW/CPU.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -19,7 +24,10 @@ const u8* JitBase::Dispatch(JitBase& jit)
 
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
-  jit.Jit(em_address);
+  if (jit.InterpretColdBlock(em_address))
+    return;
+
+  jit.CompileBlock(em_address);
 }
 
 JitBase::JitBase() : m_code_buffer(code_buffer_size)
@@ -27,6 +35,7 @@ JitBase::JitBase() : m_code_buffer(code_buffer_size)
   m_registered_config_callback_id = Config::AddConfigChangedCallback(
       [this] { Core::RunAsCPUThread([this] { RefreshConfig(); }); });
   RefreshConfig();
+  JitInterface::SetCompileStats(m_compile_stats);
 }
 
 JitBase::~JitBase()
@@ -34,6 +43,11 @@ JitBase::~JitBase()
   Config::RemoveConfigChangedCallback(m_registered_config_callback_id);
 }
 
+size_t JitBase::GetCodeSpaceSize(size_t size)
+{
+  return Config::Get(Config::MAIN_LOW_MEMORY_MODE) ? size / 2 : size;
+}
+
 void JitBase::RefreshConfig()
 {
   bJITOff = Config::Get(Config::MAIN_DEBUG_JIT_OFF);
@@ -58,11 +72,18 @@ void JitBase::RefreshConfig()
   m_fastmem_enabled = Config::Get(Config::MAIN_FASTMEM);
   m_mmu_enabled = Core::System::GetInstance().IsMMUMode();
   m_pause_on_panic_enabled = Core::System::GetInstance().IsPauseOnPanicMode();
+  m_tiered_compilation = Config::Get(Config::MAIN_JIT_TIERED_COMPILATION);
+  m_interpret_cold_blocks = Config::Get(Config::MAIN_JIT_INTERPRET_COLD_BLOCKS);
+  m_trace_formation = Config::Get(Config::MAIN_JIT_TRACE_FORMATION);
+  m_loop_register_entry = Config::Get(Config::MAIN_JIT_LOOP_REGISTER_ENTRY);
+  m_cache_eviction = Config::Get(Config::MAIN_JIT_CACHE_EVICTION);
 
   analyzer.SetDebuggingEnabled(m_enable_debugging);
   analyzer.SetBranchFollowingEnabled(Config::Get(Config::MAIN_JIT_FOLLOW_BRANCH));
   analyzer.SetFloatExceptionsEnabled(m_enable_float_exceptions);
   analyzer.SetDivByZeroExceptionsEnabled(m_enable_div_by_zero_exceptions);
+  analyzer.SetTakenBranchHints(m_trace_formation && !m_enable_debugging ? &js.takenBranchHints :
+                                                                          nullptr);
 }
 
 bool JitBase::CanMergeNextInstructions(int count) const
@@ -85,6 +106,8 @@ void JitBase::UpdateMemoryAndExceptionOptions()
   bool any_watchpoints = PowerPC::memchecks.HasAny();
   jo.fastmem = m_fastmem_enabled && jo.fastmem_arena && (MSR.DR || !any_watchpoints);
   jo.memcheck = m_mmu_enabled || m_pause_on_panic_enabled || any_watchpoints;
+  // Watchpoints are checked in MMU.cpp, which host TLB hits skip.
+  jo.host_tlb = !any_watchpoints;
   jo.fp_exceptions = m_enable_float_exceptions;
   jo.div_by_zero_exceptions = m_enable_div_by_zero_exceptions;
 }
@@ -98,3 +121,153 @@ bool JitBase::ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op
   else
     return false;
 }
+
+BitSet8 JitBase::ComputeStaticGQRs(const PPCAnalyst::CodeBlock& cb) const
+{
+  BitSet8 gqr_static = cb.m_gqr_used & ~cb.m_gqr_modified;
+
+  const auto it = js.unstableGqrs.find(js.blockStart);
+  if (it != js.unstableGqrs.end())
+    gqr_static &= ~it->second;
+
+  return gqr_static;
+}
+
+bool JitBase::ShouldAssumeRoundingMode(const PPCAnalyst::CodeBlock& cb) const
+{
+  if (js.noAssumedRoundingModeAddresses.find(js.blockStart) !=
+      js.noAssumedRoundingModeAddresses.end())
+  {
+    return false;
+  }
+
+  for (u32 i = 0; i < cb.m_num_instructions; ++i)
+  {
+    const UGeckoInstruction inst = m_code_buffer[i].inst;
+    if (inst.OPCD != 63)
+      continue;
+
+    // mtfsb0x and mtfsb1x of NI or RN, or mtfsfix of the field containing them
+    if (((inst.SUBOP10 == 70 || inst.SUBOP10 == 38) && inst.CRBD >= 29) ||
+        (inst.SUBOP10 == 134 && inst.CRFD == 7))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool JitBase::SetKnownRoundingMode(std::optional<u32> rounding_mode)
+{
+  if (rounding_mode && js.knownRoundingMode == rounding_mode)
+    return false;
+
+  js.knownRoundingMode = rounding_mode;
+  return true;
+}
+
+std::optional<u32> JitBase::GetRoundingModeAfterBitWrite(u32 mask, bool set) const
+{
+  if (!js.knownRoundingMode)
+    return std::nullopt;
+
+  mask &= ROUNDING_MODE_MASK;
+  return set ? *js.knownRoundingMode | mask : *js.knownRoundingMode & ~mask;
+}
+
+bool JitBase::ShouldCompileBaselineTier(u32 em_address) const
+{
+  if (!m_tiered_compilation || m_enable_debugging || jo.profile_blocks)
+    return false;
+
+  return js.hotBlockAddresses.find(em_address) == js.hotBlockAddresses.end();
+}
+
+u32 JitBase::GetBaselineTierAnalyzerOptions(u32 options)
+{
+  return options & ~(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW |
+                     PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_MERGE |
+                     PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE |
+                     PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
+}
+
+u32* JitBase::GetTakenBranchCounter(const PPCAnalyst::CodeOp& op)
+{
+  if (op.followConditionalBranch || !analyzer.CanFollowConditionalBranch(op) ||
+      js.takenBranchHints.find(op.address) != js.takenBranchHints.end())
+  {
+    return nullptr;
+  }
+
+  // The counter is shared by all blocks containing this branch. Its node stays allocated until
+  // the cache is cleared, since erasing it could leave dangling pointers in the generated code.
+  u32& counter = js.takenBranchCounters[op.address];
+  counter = TAKEN_BRANCH_THRESHOLD;
+  return &counter;
+}
+
+bool JitBase::EvictColdBlocks()
+{
+  if (!m_cache_eviction || m_enable_debugging)
+    return false;
+
+  const size_t evicted = GetBlockCache()->EvictColdBlocks();
+  if (evicted == 0)
+    return false;
+
+  INFO_LOG_FMT(DYNA_REC, "Evicted {} cold blocks to free code space", evicted);
+  m_code_space_stats.evicted_blocks += static_cast<u32>(evicted);
+  PublishCodeSpaceStats();
+  return true;
+}
+
+void JitBase::CompileBlock(u32 em_address)
+{
+  const u64 start_us = Common::Timer::NowUs();
+  Jit(em_address);
+  GetBlockCache()->CompileRecordedBlocks(em_address);
+
+  ++m_compile_stats.compiled_blocks;
+  m_compile_stats.compile_time_us += Common::Timer::NowUs() - start_us;
+  JitInterface::SetCompileStats(m_compile_stats);
+}
+
+void JitBase::CountCacheClear()
+{
+  ++m_compile_stats.cache_clears;
+  JitInterface::SetCompileStats(m_compile_stats);
+}
+
+void JitBase::PublishCodeSpaceStats()
+{
+  const auto percent = [](size_t used, size_t size) {
+    return size == 0 ? 0 : static_cast<u32>(used * 100 / size);
+  };
+  m_code_space_stats.usage_percent = std::max(percent(m_near_code_used, m_near_code_size),
+                                              percent(m_far_code_used, m_far_code_size));
+  m_code_space_stats.far_code_percent =
+      percent(m_far_code_used, m_near_code_used + m_far_code_used);
+  m_code_space_stats.size_kb = static_cast<u32>((m_near_code_size + m_far_code_size) / 1024);
+  m_code_space_stats.used_kb = static_cast<u32>((m_near_code_used + m_far_code_used) / 1024);
+  JitInterface::SetCodeSpaceStats(m_code_space_stats);
+}
+
+bool JitBase::InterpretColdBlock(u32 em_address)
+{
+  // The dispatcher doesn't check the downcount after returning from JitTrampoline, so we must
+  // compile once the timeslice is over to make sure that the next block exit handles timing.
+  if (!m_interpret_cold_blocks || m_enable_debugging || PowerPC::ppcState.downcount <= 0)
+    return false;
+
+  const auto it = js.coldBlockExecutions.try_emplace(em_address, 0).first;
+  if (it->second >= COLD_BLOCK_EXECUTIONS)
+  {
+    js.coldBlockExecutions.erase(it);
+    return false;
+  }
+  ++it->second;
+
+  PowerPC::ppcState.downcount -= Interpreter::getInstance()->ExecuteBlock();
+  return true;
+}
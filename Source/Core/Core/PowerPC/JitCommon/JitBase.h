@@ -5,6 +5,8 @@
 
 #include <cstddef>
 #include <map>
+#include <optional>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "Common/BitSet.h"
@@ -15,6 +17,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 //#define JIT_LOG_GENERATED_CODE  // Enables logging of generated code
@@ -62,6 +65,7 @@ protected:
     bool fastmem;
     bool fastmem_arena;
     bool memcheck;
+    bool host_tlb;
     bool fp_exceptions;
     bool div_by_zero_exceptions;
     bool profile_blocks;
@@ -82,11 +86,13 @@ protected:
     bool fixupExceptionHandler;
     Gen::FixupBranch exceptionHandler;
 
-    bool assumeNoPairedQuantize;
     BitSet8 constantGqrValid;
     std::array<u32, 8> constantGqr;
+    // FPSCR.NI and FPSCR.RN at the current instruction, if they are known at compile time.
+    std::optional<u32> knownRoundingMode;
     bool firstFPInstructionFound;
     bool isLastInstruction;
+    bool baselineTier;
     int skipInstructions;
     CarryFlag carryFlag;
 
@@ -105,8 +111,19 @@ protected:
     JitBlock* curBlock;
 
     std::unordered_set<u32> fifoWriteAddresses;
-    std::unordered_set<u32> pairedQuantizeAddresses;
+    // GQRs which no longer matched the value their block was specialized on, per block address.
+    std::unordered_map<u32, BitSet8> unstableGqrs;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    // Blocks which didn't run with the rounding mode they were compiled for.
+    std::unordered_set<u32> noAssumedRoundingModeAddresses;
+    // Blocks which ran often enough in the baseline tier to be recompiled with full optimization.
+    std::unordered_set<u32> hotBlockAddresses;
+    // How many times each not yet compiled block has been run through the interpreter.
+    std::unordered_map<u32, u32> coldBlockExecutions;
+    // Conditional branches which were taken often enough to be followed by the analyzer.
+    std::unordered_set<u32> takenBranchHints;
+    // Taken exit counters of conditional branches, referenced directly from the generated code.
+    std::unordered_map<u32, u32> takenBranchCounters;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -136,15 +153,66 @@ protected:
   bool m_fastmem_enabled = false;
   bool m_mmu_enabled = false;
   bool m_pause_on_panic_enabled = false;
+  bool m_tiered_compilation = false;
+  bool m_interpret_cold_blocks = false;
+  bool m_trace_formation = false;
+  bool m_loop_register_entry = false;
+  bool m_cache_eviction = false;
+
+  // Code space accounting, updated by the JIT whenever it allocates or frees code space.
+  size_t m_near_code_used = 0;
+  size_t m_near_code_size = 0;
+  size_t m_far_code_used = 0;
+  size_t m_far_code_size = 0;
+  JitInterface::CodeSpaceStats m_code_space_stats;
+  JitInterface::CompileStats m_compile_stats;
 
   void RefreshConfig();
 
+  // Shrinks a code region size in low memory mode. The JIT then clears its cache more often, but
+  // less code stays resident. Only read when the code space is allocated.
+  static size_t GetCodeSpaceSize(size_t size);
+
   bool CanMergeNextInstructions(int count) const;
 
   void UpdateMemoryAndExceptionOptions();
 
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op);
 
+  // GQRs which are used but not set in the block are specialized on the value they have at
+  // compile time, unless they already changed under an earlier compilation of the same block.
+  BitSet8 ComputeStaticGQRs(const PPCAnalyst::CodeBlock& cb) const;
+
+  // Blocks which change the rounding mode through mtfsb0x, mtfsb1x or mtfsfix are compiled for the
+  // rounding mode at compile time, checked on block entry. Rounding mode writes which turn out not
+  // to change anything can then skip the (slow, and on many CPUs serializing) host update.
+  static constexpr u32 ROUNDING_MODE_MASK = 7;  // FPSCR.NI and FPSCR.RN
+  bool ShouldAssumeRoundingMode(const PPCAnalyst::CodeBlock& cb) const;
+  // Records what the rounding mode is after the current instruction (nullopt if unknown). Returns
+  // whether the host rounding mode has to be updated.
+  bool SetKnownRoundingMode(std::optional<u32> rounding_mode);
+  // The rounding mode after setting (or clearing) the FPSCR bits in mask, if known.
+  std::optional<u32> GetRoundingModeAfterBitWrite(u32 mask, bool set) const;
+
+  // With tiered compilation, blocks are first compiled without the expensive analysis options and
+  // speculative constants, and get recompiled once they have run TIER_UP_THRESHOLD times.
+  bool ShouldCompileBaselineTier(u32 em_address) const;
+  static u32 GetBaselineTierAnalyzerOptions(u32 options);
+  static constexpr u32 TIER_UP_THRESHOLD = 64;
+
+  // With trace formation, the taken exit of each conditional branch that the analyzer could follow
+  // counts down from TAKEN_BRANCH_THRESHOLD. Once it hits zero, the block is recompiled with the
+  // taken path stitched in and the fallthrough turned into a side exit.
+  u32* GetTakenBranchCounter(const PPCAnalyst::CodeOp& op);
+  static constexpr u32 TAKEN_BRANCH_THRESHOLD = 32;
+
+  // With JIT cache eviction, running out of code space destroys the least recently executed
+  // blocks instead of clearing the whole cache. Returns false if nothing could be evicted.
+  bool EvictColdBlocks();
+  void PublishCodeSpaceStats();
+  // Called by the backends whenever they clear the whole code cache.
+  void CountCacheClear();
+
 public:
   JitBase();
   ~JitBase() override;
@@ -155,6 +223,15 @@ public:
   virtual JitBaseBlockCache* GetBlockCache() = 0;
 
   virtual void Jit(u32 em_address) = 0;
+  // Compiles the block at em_address through Jit, and keeps track of the time it takes.
+  void CompileBlock(u32 em_address);
+
+  // Code which runs only a few times (boot code, level loading, one-off initialization) isn't
+  // worth the cost of compiling. When enabled, a block missing from the cache is run through the
+  // interpreter for its first COLD_BLOCK_EXECUTIONS executions, and only compiled afterwards.
+  // Returns false if the block should be compiled now.
+  bool InterpretColdBlock(u32 em_address);
+  static constexpr u32 COLD_BLOCK_EXECUTIONS = 2;
 
   virtual const CommonAsmRoutinesBase* GetAsmRoutines() = 0;
 
@@ -0,0 +1,270 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitBlockDiskCache.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+
+// Unlike Memory::GetPointer, this doesn't raise a panic alert for addresses outside of RAM.
+// Blocks living in the locked L1 cache or the fake VMEM are simply not recorded.
+static const u8* GetGuestCodePointer(u32 physical_address)
+{
+  if (physical_address < Memory::GetRamSizeReal())
+    return Memory::m_pRAM + physical_address;
+
+  if (Memory::m_pEXRAM && (physical_address >> 28) == 0x1 &&
+      (physical_address & 0x0fffffff) < Memory::GetExRamSizeReal())
+  {
+    return Memory::m_pEXRAM + (physical_address & Memory::GetExRamMask());
+  }
+
+  return nullptr;
+}
+
+class JitBlockDiskCache::Reader final : public LinearDiskCacheReader<Key, u32>
+{
+public:
+  explicit Reader(JitBlockDiskCache& cache) : m_cache(cache) {}
+
+  void Read(const Key& key, const u32* value, u32 value_size) override
+  {
+    if (value_size == 0)
+      return;
+
+    if (!m_cache.m_recorded.emplace(ToTuple(key)).second)
+      return;
+
+    Entry entry{key, std::vector<u32>(value, value + value_size)};
+
+    const auto profile = m_cache.m_profile.find(ToTuple(key));
+    if (profile != m_cache.m_profile.end())
+    {
+      entry.hotness = profile->second.hotness;
+      entry.taken_branches = profile->second.taken_branches;
+    }
+
+    if (entry.hotness >= HOT_THRESHOLD)
+      m_cache.m_hot.push_back(std::move(entry));
+    else
+      m_cache.m_pending[key.physical_address >> PAGE_SHIFT].push_back(std::move(entry));
+  }
+
+private:
+  JitBlockDiskCache& m_cache;
+};
+
+// Profile values are the hotness followed by the effective addresses of the taken branches.
+class JitBlockDiskCache::ProfileReader final : public LinearDiskCacheReader<Key, u32>
+{
+public:
+  explicit ProfileReader(JitBlockDiskCache& cache) : m_cache(cache) {}
+
+  void Read(const Key& key, const u32* value, u32 value_size) override
+  {
+    if (value_size == 0)
+      return;
+
+    ProfileEntry& entry = m_cache.m_profile[ToTuple(key)];
+    entry.hotness = value[0];
+    entry.taken_branches.assign(value + 1, value + value_size);
+  }
+
+private:
+  JitBlockDiskCache& m_cache;
+};
+
+void JitBlockDiskCache::Open(const std::string& game_id)
+{
+  Close();
+
+  const std::string path = File::GetUserPath(D_CACHE_IDX) + game_id;
+
+  // The profile has to be loaded first, so that the block records can be sorted by hotness.
+  m_profile_filename = path + ".jitprofile";
+  {
+    LinearDiskCache<Key, u32> profile_file;
+    ProfileReader profile_reader(*this);
+    profile_file.OpenAndRead(m_profile_filename, profile_reader);
+  }
+
+  const std::string filename = path + ".jitblocks";
+  Reader reader(*this);
+  const u32 count = m_file.OpenAndRead(filename, reader);
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} JIT block records from {}, {} of them hot", count, filename,
+               m_hot.size());
+
+  std::stable_sort(m_hot.begin(), m_hot.end(),
+                   [](const Entry& a, const Entry& b) { return a.hotness > b.hotness; });
+
+  m_is_open = true;
+}
+
+void JitBlockDiskCache::Close()
+{
+  if (!m_is_open)
+    return;
+
+  m_file.Sync();
+  m_file.Close();
+  SaveProfile();
+  m_pending.clear();
+  m_hot.clear();
+  m_recorded.clear();
+  m_profile.clear();
+  m_is_open = false;
+}
+
+void JitBlockDiskCache::SaveProfile()
+{
+  class NullReader final : public LinearDiskCacheReader<Key, u32>
+  {
+  public:
+    void Read(const Key& key, const u32* value, u32 value_size) override {}
+  };
+
+  // The profile is small compared to the block records, so it's simply rewritten every time.
+  File::Delete(m_profile_filename, File::IfAbsentBehavior::NoConsoleWarning);
+
+  LinearDiskCache<Key, u32> profile_file;
+  NullReader reader;
+  profile_file.OpenAndRead(m_profile_filename, reader);
+
+  std::vector<u32> value;
+  for (const auto& [tuple, entry] : m_profile)
+  {
+    // Halving the previous hotness makes blocks which stopped running fade out of the profile.
+    const u32 hotness = entry.session_samples + entry.hotness / 2;
+    if (hotness == 0 && entry.taken_branches.empty())
+      continue;
+
+    const auto& [effective_address, physical_address, msr_bits, code_hash] = tuple;
+    const Key key{effective_address, physical_address, msr_bits, code_hash};
+    value.assign(1, hotness);
+    value.insert(value.end(), entry.taken_branches.begin(), entry.taken_branches.end());
+    profile_file.Append(key, value.data(), static_cast<u32>(value.size()));
+  }
+
+  profile_file.Close();
+}
+
+void JitBlockDiskCache::Record(JitBlock& block)
+{
+  if (!m_is_open || block.physical_addresses.empty())
+    return;
+
+  u32 hash;
+  if (!HashGuestCode(block.physical_addresses, &hash))
+    return;
+
+  block.recordedCodeHash = hash;
+
+  const Key key{block.effectiveAddress, block.physicalAddress, block.msrBits, hash};
+  if (!m_recorded.emplace(ToTuple(key)).second)
+    return;
+
+  const std::vector<u32> addresses(block.physical_addresses.begin(),
+                                   block.physical_addresses.end());
+  m_file.Append(key, addresses.data(), static_cast<u32>(addresses.size()));
+}
+
+void JitBlockDiskCache::UpdateProfile(const JitBlock& block, std::vector<u32> taken_branches)
+{
+  if (!m_is_open || !block.recordedCodeHash)
+    return;
+
+  const Key key{block.effectiveAddress, block.physicalAddress, block.msrBits,
+                *block.recordedCodeHash};
+  ProfileEntry& entry = m_profile[ToTuple(key)];
+  entry.session_samples += block.executedSamples;
+  if (!taken_branches.empty())
+    entry.taken_branches = std::move(taken_branches);
+}
+
+std::vector<JitBlockDiskCache::Entry> JitBlockDiskCache::TakePendingEntries(u32 physical_address,
+                                                                             u32 msr_bits)
+{
+  std::vector<Entry> result;
+
+  const auto it = m_pending.find(physical_address >> PAGE_SHIFT);
+  if (it == m_pending.end())
+    return result;
+
+  std::vector<Entry>& entries = it->second;
+  for (auto entry = entries.begin(); entry != entries.end();)
+  {
+    if (entry->key.msr_bits == msr_bits)
+    {
+      result.push_back(std::move(*entry));
+      entry = entries.erase(entry);
+    }
+    else
+    {
+      ++entry;
+    }
+  }
+
+  if (entries.empty())
+    m_pending.erase(it);
+
+  return result;
+}
+
+std::vector<JitBlockDiskCache::Entry> JitBlockDiskCache::TakeHotEntries(u32 msr_bits)
+{
+  std::vector<Entry> result;
+  if (m_hot.empty())
+    return result;
+
+  const auto middle = std::stable_partition(m_hot.begin(), m_hot.end(), [msr_bits](const Entry& e) {
+    return e.key.msr_bits == msr_bits;
+  });
+  result.assign(std::make_move_iterator(m_hot.begin()), std::make_move_iterator(middle));
+  m_hot.erase(m_hot.begin(), middle);
+  return result;
+}
+
+void JitBlockDiskCache::ReturnEntry(Entry entry)
+{
+  const u32 page = entry.key.physical_address >> PAGE_SHIFT;
+  m_pending[page].push_back(std::move(entry));
+}
+
+bool JitBlockDiskCache::IsGuestCodeUnchanged(const Entry& entry)
+{
+  u32 hash;
+  return HashGuestCode(entry.physical_addresses, &hash) && hash == entry.key.code_hash;
+}
+
+JitBlockDiskCache::KeyTuple JitBlockDiskCache::ToTuple(const Key& key)
+{
+  return {key.effective_address, key.physical_address, key.msr_bits, key.code_hash};
+}
+
+template <typename Container>
+bool JitBlockDiskCache::HashGuestCode(const Container& physical_addresses, u32* hash)
+{
+  u32 crc = Common::StartCRC32();
+  for (const u32 address : physical_addresses)
+  {
+    const u8* ptr = GetGuestCodePointer(address);
+    if (!ptr)
+      return false;
+
+    const u32 address_be = Common::swap32(address);
+    crc = Common::UpdateCRC32(crc, reinterpret_cast<const u8*>(&address_be), sizeof(address_be));
+    crc = Common::UpdateCRC32(crc, ptr, sizeof(u32));
+  }
+
+  *hash = crc;
+  return true;
+}
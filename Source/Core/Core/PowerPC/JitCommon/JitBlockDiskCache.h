@@ -0,0 +1,105 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+
+struct JitBlock;
+
+// Persistent per-game record of the blocks the JIT has compiled.
+//
+// Host code can't be stored as-is, since it embeds absolute pointers to the asm routines,
+// trampolines, far code and C++ helpers which all move between sessions. Instead, we store the
+// address, MSR bits and a hash of the guest instructions of each block. When the guest code in a
+// page is first executed in a later session, every recorded block of that page whose guest code
+// still matches is compiled in one go, instead of trickling in one block at a time.
+//
+// A second file holds a profile of the recorded blocks: how often they ran in previous sessions,
+// and which of their conditional branches were taken often enough to be followed. Hot blocks are
+// compiled back to back as soon as the game starts running, ahead of their first execution.
+class JitBlockDiskCache
+{
+public:
+  struct Key
+  {
+    u32 effective_address;
+    u32 physical_address;
+    u32 msr_bits;
+    u32 code_hash;
+  };
+
+  struct Entry
+  {
+    Key key;
+    std::vector<u32> physical_addresses;
+    // From the profile of previous sessions.
+    u32 hotness = 0;
+    std::vector<u32> taken_branches;
+  };
+
+  void Open(const std::string& game_id);
+  void Close();
+  bool IsOpen() const { return m_is_open; }
+
+  void Record(JitBlock& block);
+
+  // Adds the executed samples of a recorded block to the profile written on Close. If
+  // taken_branches is empty, the previously profiled taken branches of the block are kept.
+  void UpdateProfile(const JitBlock& block, std::vector<u32> taken_branches);
+
+  // Removes and returns the recorded blocks which start in the same page as physical_address and
+  // were compiled with the given MSR bits.
+  std::vector<Entry> TakePendingEntries(u32 physical_address, u32 msr_bits);
+
+  // Removes and returns the recorded blocks which were hot in previous sessions and were compiled
+  // with the given MSR bits, hottest first.
+  std::vector<Entry> TakeHotEntries(u32 msr_bits);
+
+  // Puts back an entry returned by TakeHotEntries, so that it gets compiled along with its page.
+  void ReturnEntry(Entry entry);
+
+  // Returns whether the guest code of a recorded block is identical to what is in memory now.
+  static bool IsGuestCodeUnchanged(const Entry& entry);
+
+private:
+  class Reader;
+  class ProfileReader;
+
+  using KeyTuple = std::tuple<u32, u32, u32, u32>;
+
+  struct ProfileEntry
+  {
+    // Decayed sum of the executed block samples (see JitBaseBlockCache::SampleExecutedBlocks) of
+    // previous sessions.
+    u32 hotness = 0;
+    u32 session_samples = 0;
+    std::vector<u32> taken_branches;
+  };
+
+  static constexpr u32 PAGE_SHIFT = 12;
+  // Blocks whose hotness reaches this are compiled ahead of their first execution.
+  static constexpr u32 HOT_THRESHOLD = 2;
+
+  static KeyTuple ToTuple(const Key& key);
+
+  template <typename Container>
+  static bool HashGuestCode(const Container& physical_addresses, u32* hash);
+
+  void SaveProfile();
+
+  LinearDiskCache<Key, u32> m_file;
+  std::map<u32, std::vector<Entry>> m_pending;  // physical page -> entries
+  std::vector<Entry> m_hot;
+  std::set<KeyTuple> m_recorded;
+  std::map<KeyTuple, ProfileEntry> m_profile;
+  std::string m_profile_filename;
+  bool m_is_open = false;
+};
@@ -9,16 +9,23 @@
 #include <functional>
 #include <map>
 #include <set>
+#include <string>
 #include <utility>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
 #include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
+#include "Core/System.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -32,7 +39,7 @@ bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
          physical_addresses.lower_bound(address + length);
 }
 
-JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
+JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}, m_page_block_count(PAGE_COUNT)
 {
 }
 
@@ -42,11 +49,34 @@ void JitBaseBlockCache::Init()
 {
   JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR));
 
+  // Recorded blocks are only reliable when the effective to physical mapping can't change under
+  // us, and debugging needs single instruction blocks.
+  if (Config::Get(Config::MAIN_JIT_BLOCK_DISK_CACHE) && !Core::System::GetInstance().IsMMUMode() &&
+      !m_jit.IsDebuggingEnabled())
+  {
+    m_disk_cache.Open(SConfig::GetInstance().GetGameID());
+  }
+
+  m_indirect_branch_caching =
+      Config::Get(Config::MAIN_JIT_INDIRECT_BRANCH_CACHE) && !m_jit.IsDebuggingEnabled();
+
   Clear();
 }
 
 void JitBaseBlockCache::Shutdown()
 {
+  if (m_disk_cache.IsOpen())
+  {
+    SampleExecutedBlocks();
+    for (auto& e : block_map)
+    {
+      JitBlock& block = e.second;
+      m_disk_cache.UpdateProfile(block, GetTakenBranchHints(block));
+      block.executedSamples = 0;
+    }
+  }
+
+  m_disk_cache.Close();
   JitRegister::Shutdown();
 }
 
@@ -58,8 +88,13 @@ void JitBaseBlockCache::Clear()
   Core::DisplayMessage("Clearing code cache.", 3000);
 #endif
   m_jit.js.fifoWriteAddresses.clear();
-  m_jit.js.pairedQuantizeAddresses.clear();
+  m_jit.js.unstableGqrs.clear();
   m_jit.js.noSpeculativeConstantsAddresses.clear();
+  m_jit.js.noAssumedRoundingModeAddresses.clear();
+  m_jit.js.hotBlockAddresses.clear();
+  m_jit.js.coldBlockExecutions.clear();
+  m_jit.js.takenBranchHints.clear();
+  m_jit.js.takenBranchCounters.clear();
   for (auto& e : block_map)
   {
     DestroyBlock(e.second);
@@ -67,8 +102,13 @@ void JitBaseBlockCache::Clear()
   block_map.clear();
   links_to.clear();
   block_range_map.clear();
+  m_host_code_map.clear();
+  m_indirect_branch_targets.clear();
+  m_indirect_branch_caches.clear();
+  m_blocks_since_sample = 0;
 
   valid_block.ClearAll();
+  std::fill(m_page_block_count.begin(), m_page_block_count.end(), 0);
 
   fast_block_map.fill(nullptr);
 }
@@ -99,6 +139,9 @@ JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
   b.msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
   b.linkData.clear();
   b.fast_block_map_index = 0;
+  b.tierUpCountdown = 0;
+  b.notExecuted = 1;
+  b.lastExecutedSample = m_execution_sample;
   return &b;
 }
 
@@ -117,6 +160,12 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
     valid_block.Set(addr / 32);
     block_range_map[addr & range_mask].insert(&block);
   }
+  UpdatePageBlockCounts(block, true);
+
+  if (block.near_begin != block.near_end)
+    m_host_code_map.emplace(block.near_begin, &block);
+  if (block.far_begin != block.far_end)
+    m_host_code_map.emplace(block.far_begin, &block);
 
   if (block_link)
   {
@@ -128,18 +177,89 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
     LinkBlock(block);
   }
 
-  Common::Symbol* symbol = nullptr;
-  if (JitRegister::IsEnabled() &&
-      (symbol = g_symbolDB.GetSymbolFromAddr(block.effectiveAddress)) != nullptr)
+  m_disk_cache.Record(block);
+
+  if (++m_blocks_since_sample >= SAMPLE_INTERVAL)
+    SampleExecutedBlocks();
+
+  if (JitRegister::IsEnabled())
   {
-    JitRegister::Register(block.checkedEntry, block.codeSize, "JIT_PPC_{}_{:08x}",
-                          symbol->function_name.c_str(), block.physicalAddress);
+    const std::string name = GetSymbolName(block);
+    JitRegister::Register(block.checkedEntry, block.codeSize, name);
+    if (block.far_begin != block.far_end)
+      JitRegister::Register(block.far_begin, block.far_end, "{}_far", name);
   }
-  else
+}
+
+std::string JitBaseBlockCache::GetSymbolName(const JitBlock& block)
+{
+  if (const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(block.effectiveAddress))
+    return fmt::format("JIT_PPC_{}_{:08x}", symbol->function_name, block.effectiveAddress);
+
+  return fmt::format("JIT_PPC_{:08x}", block.effectiveAddress);
+}
+
+void JitBaseBlockCache::CompileRecordedBlocks(u32 em_address)
+{
+  if (!m_disk_cache.IsOpen())
+    return;
+
+  const u32 msr_bits = MSR.Hex & JIT_CACHE_MSR_MASK;
+
+  // Hot blocks are all compiled the first time we get here, which lays them out next to each other
+  // in the code space. The ones whose guest code isn't loaded yet wait for their page instead.
+  for (JitBlockDiskCache::Entry& entry : m_disk_cache.TakeHotEntries(msr_bits))
+  {
+    if (!CompileRecordedBlock(entry, msr_bits))
+      m_disk_cache.ReturnEntry(std::move(entry));
+  }
+
+  const auto translated = PowerPC::JitCache_TranslateAddress(em_address);
+  if (!translated.valid)
+    return;
+
+  for (const JitBlockDiskCache::Entry& entry :
+       m_disk_cache.TakePendingEntries(translated.address, msr_bits))
+  {
+    CompileRecordedBlock(entry, msr_bits);
+  }
+}
+
+// Returns false if the guest code of the entry isn't in memory, or has changed.
+bool JitBaseBlockCache::CompileRecordedBlock(const JitBlockDiskCache::Entry& entry, u32 msr_bits)
+{
+  const u32 address = entry.key.effective_address;
+  if (GetBlockFromStartAddress(address, msr_bits))
+    return true;
+
+  const auto translated = PowerPC::JitCache_TranslateAddress(address);
+  if (!translated.valid || translated.address != entry.key.physical_address)
+    return false;
+
+  if (!JitBlockDiskCache::IsGuestCodeUnchanged(entry))
+    return false;
+
+  m_jit.js.takenBranchHints.insert(entry.taken_branches.begin(), entry.taken_branches.end());
+  m_jit.Jit(address);
+  return true;
+}
+
+// Returns the conditional branches of the block which the analyzer has been told to follow.
+std::vector<u32> JitBaseBlockCache::GetTakenBranchHints(const JitBlock& block) const
+{
+  std::vector<u32> result;
+  const auto& hints = m_jit.js.takenBranchHints;
+  if (hints.empty())
+    return result;
+
+  // Without MMU emulation, which the disk cache requires, blocks are mapped linearly.
+  const u32 offset = block.effectiveAddress - block.physicalAddress;
+  for (const u32 physical_address : block.physical_addresses)
   {
-    JitRegister::Register(block.checkedEntry, block.codeSize, "JIT_PPC_{:08x}",
-                          block.physicalAddress);
+    if (hints.find(physical_address + offset) != hints.end())
+      result.push_back(physical_address + offset);
   }
+  return result;
 }
 
 JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
@@ -166,6 +286,22 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
   return nullptr;
 }
 
+const JitBlock* JitBaseBlockCache::GetBlockFromHostAddress(const u8* host_address) const
+{
+  auto it = m_host_code_map.upper_bound(host_address);
+  if (it == m_host_code_map.begin())
+    return nullptr;
+  --it;
+
+  const JitBlock* block = it->second;
+  if ((host_address >= block->near_begin && host_address < block->near_end) ||
+      (host_address >= block->far_begin && host_address < block->far_end))
+  {
+    return block;
+  }
+  return nullptr;
+}
+
 const u8* JitBaseBlockCache::Dispatch()
 {
   JitBlock* block = fast_block_map[FastLookupIndexForAddress(PC)];
@@ -179,6 +315,106 @@ const u8* JitBaseBlockCache::Dispatch()
   return block->normalEntry;
 }
 
+IndirectBranchCache* JitBaseBlockCache::AllocateIndirectBranchCache(u32 msr_bits)
+{
+  if (!m_indirect_branch_caching)
+    return nullptr;
+
+  IndirectBranchCache& cache = m_indirect_branch_caches.emplace_back();
+  for (u32 i = 0; i < IndirectBranchCache::NUM_ENTRIES; ++i)
+  {
+    cache.effective_addresses[i] = IndirectBranchCache::INVALID_ADDRESS;
+    cache.normal_entries[i] = nullptr;
+    cache.blocks[i] = nullptr;
+  }
+  cache.msr_bits = msr_bits;
+  cache.next_entry = 0;
+  cache.misses = 0;
+  return &cache;
+}
+
+void JitBaseBlockCache::UpdateIndirectBranchCache(JitBaseBlockCache& block_cache,
+                                                  IndirectBranchCache* cache)
+{
+  if (cache->misses >= IndirectBranchCache::MAX_MISSES)
+    return;
+  cache->misses++;
+
+  // The generated code doesn't check MSR, so only blocks matching the MSR bits the call site was
+  // compiled with may be cached.
+  const u32 msr_bits = MSR.Hex & JIT_CACHE_MSR_MASK;
+  if (msr_bits != cache->msr_bits)
+    return;
+
+  // If the destination isn't compiled yet, the dispatcher takes care of it and a later miss will
+  // fill the cache.
+  JitBlock* block = block_cache.GetBlockFromStartAddress(PC, msr_bits);
+  if (!block)
+    return;
+
+  const u32 index = cache->next_entry;
+  cache->next_entry = (index + 1) % IndirectBranchCache::NUM_ENTRIES;
+
+  block_cache.ResetIndirectBranchCacheEntry(*cache, index);
+  cache->effective_addresses[index] = PC;
+  cache->normal_entries[index] = block->normalEntry;
+  cache->blocks[index] = block;
+  block_cache.m_indirect_branch_targets.emplace(block, std::make_pair(cache, index));
+}
+
+void JitBaseBlockCache::ResetIndirectBranchCacheEntry(IndirectBranchCache& cache, u32 index)
+{
+  JitBlock* block = cache.blocks[index];
+  if (!block)
+    return;
+
+  const auto range = m_indirect_branch_targets.equal_range(block);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second.first == &cache && it->second.second == index)
+    {
+      m_indirect_branch_targets.erase(it);
+      break;
+    }
+  }
+
+  cache.effective_addresses[index] = IndirectBranchCache::INVALID_ADDRESS;
+  cache.normal_entries[index] = nullptr;
+  cache.blocks[index] = nullptr;
+}
+
+static u32 GetAddressKey(u32 address)
+{
+  return address;
+}
+
+template <typename T>
+static u32 GetAddressKey(const std::pair<const u32, T>& entry)
+{
+  return entry.first;
+}
+
+// Erases the entries for the instructions in [address, address + length) from one of the per
+// address sets or maps of the JIT state. Large ranges are handled by walking the container
+// instead, since it usually holds far fewer entries than there are instructions in the range.
+template <typename Container>
+static void EraseAddressRange(Container& container, u32 address, u32 length)
+{
+  if (container.empty())
+    return;
+
+  if (length / 4 <= container.size())
+  {
+    for (u32 i = address; i < address + length; i += 4)
+      container.erase(i);
+    return;
+  }
+
+  std::erase_if(container, [address, length](const auto& entry) {
+    return GetAddressKey(entry) - address < length;
+  });
+}
+
 void JitBaseBlockCache::InvalidateICacheLine(u32 address)
 {
   const u32 cache_line_address = address & ~0x1f;
@@ -244,7 +480,8 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
   if (destroy_block)
   {
     // destroy JIT blocks
-    ErasePhysicalRange(physical_address, length);
+    if (RangeHasBlocks(physical_address, length))
+      ErasePhysicalRange(physical_address, length);
 
     // If the code was actually modified, we need to clear the relevant entries from the
     // FIFO write address cache, so we don't end up with FIFO checks in places they shouldn't
@@ -252,12 +489,12 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
     // being in the right place between instructions).
     if (!forced)
     {
-      for (u32 i = address; i < address + length; i += 4)
-      {
-        m_jit.js.fifoWriteAddresses.erase(i);
-        m_jit.js.pairedQuantizeAddresses.erase(i);
-        m_jit.js.noSpeculativeConstantsAddresses.erase(i);
-      }
+      EraseAddressRange(m_jit.js.fifoWriteAddresses, address, length);
+      EraseAddressRange(m_jit.js.unstableGqrs, address, length);
+      EraseAddressRange(m_jit.js.noSpeculativeConstantsAddresses, address, length);
+      EraseAddressRange(m_jit.js.noAssumedRoundingModeAddresses, address, length);
+      EraseAddressRange(m_jit.js.hotBlockAddresses, address, length);
+      EraseAddressRange(m_jit.js.takenBranchHints, address, length);
     }
   }
 }
@@ -284,17 +521,9 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
             block_range_map[addr & range_mask].erase(block);
 
         // And remove the block.
+        UpdatePageBlockCounts(*block, false);
         DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
+        EraseFromBlockMap(*block);
         iter = start->second.erase(iter);
       }
       else
@@ -311,6 +540,114 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
   }
 }
 
+void JitBaseBlockCache::EraseFromBlockMap(const JitBlock& block)
+{
+  auto block_map_iter = block_map.equal_range(block.physicalAddress);
+  while (block_map_iter.first != block_map_iter.second)
+  {
+    if (&block_map_iter.first->second == &block)
+    {
+      block_map.erase(block_map_iter.first);
+      break;
+    }
+    block_map_iter.first++;
+  }
+}
+
+void JitBaseBlockCache::UpdatePageBlockCounts(const JitBlock& block, bool add)
+{
+  // physical_addresses is sorted, so each page only shows up in one run.
+  u32 last_page = PAGE_COUNT;
+  for (u32 addr : block.physical_addresses)
+  {
+    const u32 page = addr >> PAGE_SHIFT;
+    if (page == last_page)
+      continue;
+    last_page = page;
+
+    if (add)
+      ++m_page_block_count[page];
+    else
+      --m_page_block_count[page];
+  }
+}
+
+bool JitBaseBlockCache::RangeHasBlocks(u32 physical_address, u32 length) const
+{
+  const u32 first_page = physical_address >> PAGE_SHIFT;
+  const u32 last_page = (physical_address + (length - 1)) >> PAGE_SHIFT;
+  for (u32 page = first_page; page <= last_page; ++page)
+  {
+    if (m_page_block_count[page] != 0)
+      return true;
+  }
+  return false;
+}
+
+void JitBaseBlockCache::SampleExecutedBlocks()
+{
+  ++m_execution_sample;
+  m_blocks_since_sample = 0;
+
+  for (auto& e : block_map)
+  {
+    JitBlock& block = e.second;
+    if (!block.notExecuted)
+    {
+      block.lastExecutedSample = m_execution_sample;
+      ++block.executedSamples;
+      block.notExecuted = 1;
+    }
+  }
+}
+
+size_t JitBaseBlockCache::EvictColdBlocks()
+{
+  SampleExecutedBlocks();
+
+  std::vector<JitBlock*> candidates;
+  candidates.reserve(block_map.size());
+  for (auto& e : block_map)
+    candidates.push_back(&e.second);
+
+  const size_t count = candidates.size() / EVICTION_DIVISOR;
+  if (count == 0)
+    return 0;
+
+  const auto last = candidates.begin() + count;
+  std::nth_element(candidates.begin(), last, candidates.end(),
+                   [](const JitBlock* a, const JitBlock* b) {
+                     return a->lastExecutedSample < b->lastExecutedSample;
+                   });
+
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  for (auto it = candidates.begin(); it != last; ++it)
+  {
+    JitBlock& block = **it;
+    for (u32 addr : block.physical_addresses)
+    {
+      const auto range = block_range_map.find(addr & range_mask);
+      if (range == block_range_map.end())
+        continue;
+
+      range->second.erase(&block);
+      if (range->second.empty())
+        block_range_map.erase(range);
+    }
+
+    UpdatePageBlockCounts(block, false);
+    DestroyBlock(block);
+    EraseFromBlockMap(block);
+  }
+
+  return count;
+}
+
+void JitBaseBlockCache::DiscardBlock(JitBlock& block)
+{
+  EraseFromBlockMap(block);
+}
+
 u32* JitBaseBlockCache::GetBlockBitSet() const
 {
   return valid_block.m_valid_block.get();
@@ -386,11 +723,35 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
 
 void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 {
+  // Samples taken in the block can't be traced back to guest code once it's gone.
+  SamplingProfiler::ResolvePendingSamples();
+
+  for (const u8* begin : {block.near_begin, block.far_begin})
+  {
+    const auto it = m_host_code_map.find(begin);
+    if (it != m_host_code_map.end() && it->second == &block)
+      m_host_code_map.erase(it);
+  }
+
+  m_disk_cache.UpdateProfile(block, {});
+
   if (fast_block_map[block.fast_block_map_index] == &block)
     fast_block_map[block.fast_block_map_index] = nullptr;
 
   UnlinkBlock(block);
 
+  // Drop the block from all indirect branch caches
+  const auto targets = m_indirect_branch_targets.equal_range(&block);
+  for (auto it = targets.first; it != targets.second; ++it)
+  {
+    IndirectBranchCache* cache = it->second.first;
+    const u32 index = it->second.second;
+    cache->effective_addresses[index] = IndirectBranchCache::INVALID_ADDRESS;
+    cache->normal_entries[index] = nullptr;
+    cache->blocks[index] = nullptr;
+  }
+  m_indirect_branch_targets.erase(targets.first, targets.second);
+
   // Delete linking addresses
   for (const auto& e : block.linkData)
   {
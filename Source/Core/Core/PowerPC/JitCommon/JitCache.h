@@ -6,16 +6,20 @@
 #include <array>
 #include <bitset>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Core/PowerPC/JitCommon/JitBlockDiskCache.h"
 
 class JitBase;
 
@@ -53,6 +57,12 @@ struct JitBlockData
   // This tracks the position if this block within the fast block cache.
   // We allow each block to have only one map entry.
   size_t fast_block_map_index;
+  // Number of remaining executions before a baseline tier block is recompiled with full
+  // optimization. Decremented by the block itself.
+  u32 tierUpCountdown;
+  // With JIT cache eviction, the block clears this whenever it's entered, and the block cache
+  // sets it again each time it samples which blocks have run.
+  u8 notExecuted;
 };
 static_assert(std::is_standard_layout_v<JitBlockData>, "JitBlockData must have a standard layout");
 
@@ -78,9 +88,27 @@ struct JitBlock : public JitBlockData
   };
   std::vector<LinkData> linkData;
 
+  // Branches from the end of the block back to its loop entry, which keeps guest registers in
+  // host registers across iterations (JitArm64 only). As they bypass the entry points, they get
+  // redirected to their exit stub when the block is destroyed.
+  struct LoopBackEdge
+  {
+    u8* branch;
+    u8* exit_stub;
+  };
+  std::vector<LoopBackEdge> loop_back_edges;
+
   // This set stores all physical addresses of all occupied instructions.
   std::set<u32> physical_addresses;
 
+  // The last sample of JitBaseBlockCache::SampleExecutedBlocks which found the block to have run.
+  u32 lastExecutedSample = 0;
+  // How many samples found the block to have run, for the JIT block profile.
+  u32 executedSamples = 0;
+
+  // Hash of the guest code, if the block was recorded in the JIT block disk cache.
+  std::optional<u32> recordedCodeHash;
+
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
   {
@@ -92,6 +120,29 @@ struct JitBlock : public JitBlockData
   } profile_data = {};
 };
 
+// Per call site cache of the blocks an indirect branch (bcctr, or bclr without the BLR
+// optimization) recently jumped to. The generated code compares the destination against these
+// entries and jumps straight to the block on a hit, only using the dispatcher on a miss. The
+// cache is specific to the MSR bits of the block containing the branch.
+struct IndirectBranchCache
+{
+  static constexpr u32 NUM_ENTRIES = 2;
+  static constexpr u32 INVALID_ADDRESS = 0xFFFFFFFF;
+  // Misses after which a call site is considered megamorphic and no longer updated.
+  static constexpr u32 MAX_MISSES = 64;
+
+  u32 effective_addresses[NUM_ENTRIES];
+  const u8* normal_entries[NUM_ENTRIES];
+
+  // Not accessed by the generated code.
+  JitBlock* blocks[NUM_ENTRIES];
+  u32 msr_bits;
+  u32 next_entry;
+  u32 misses;
+};
+static_assert(std::is_standard_layout_v<IndirectBranchCache>,
+              "IndirectBranchCache must have a standard layout");
+
 typedef void (*CompiledCode)();
 
 // This is essentially just an std::bitset, but Visual Studia 2013's
@@ -146,20 +197,42 @@ public:
   JitBlock** GetFastBlockMap();
   void RunOnBlocks(std::function<void(const JitBlock&)> f);
 
+  // The name the host code of the block is given in profiler symbol maps.
+  static std::string GetSymbolName(const JitBlock& block);
+
   JitBlock* AllocateBlock(u32 em_address);
   void FinalizeBlock(JitBlock& block, bool block_link, const std::set<u32>& physical_addresses);
 
+  // Compiles the blocks recorded in the on-disk block list which share a page with em_address, or
+  // were hot in previous sessions, and whose guest code is unchanged since they were recorded.
+  void CompileRecordedBlocks(u32 em_address);
+
   // Look for the block in the slow but accurate way.
   // This function shall be used if FastLookupIndexForAddress() failed.
   // This might return nullptr if there is no such block.
   JitBlock* GetBlockFromStartAddress(u32 em_address, u32 msr);
 
+  // Returns the block whose near or far code contains the given host address, or nullptr.
+  const JitBlock* GetBlockFromHostAddress(const u8* host_address) const;
+
   // Get the normal entry for the block associated with the current program
   // counter. This will JIT code if necessary. (This is the reference
   // implementation; high-performance JITs will want to use a custom
   // assembly version.)
   const u8* Dispatch();
 
+  // Returns a new, empty indirect branch cache, or nullptr if they are disabled.
+  IndirectBranchCache* AllocateIndirectBranchCache(u32 msr_bits);
+  // Called by the generated code when an indirect branch to PC missed its cache.
+  static void UpdateIndirectBranchCache(JitBaseBlockCache& block_cache, IndirectBranchCache* cache);
+
+  // Records which blocks have run since the last sample, for least recently used eviction.
+  void SampleExecutedBlocks();
+  // Destroys the least recently executed quarter of the blocks. Returns how many were destroyed.
+  size_t EvictColdBlocks();
+  // Drops a block which failed to compile and was never finalized.
+  void DiscardBlock(JitBlock& block);
+
   void InvalidateICache(u32 address, u32 length, bool forced);
   void InvalidateICacheLine(u32 address);
   void ErasePhysicalRange(u32 address, u32 length);
@@ -179,6 +252,12 @@ private:
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
+  void ResetIndirectBranchCacheEntry(IndirectBranchCache& cache, u32 index);
+  void EraseFromBlockMap(const JitBlock& block);
+  void UpdatePageBlockCounts(const JitBlock& block, bool add);
+  bool CompileRecordedBlock(const JitBlockDiskCache::Entry& entry, u32 msr_bits);
+  std::vector<u32> GetTakenBranchHints(const JitBlock& block) const;
+  bool RangeHasBlocks(u32 physical_address, u32 length) const;
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, u32 msr);
 
@@ -199,11 +278,38 @@ private:
   static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
   std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
 
+  // Blocks indexed by the beginning of their near and far code, to map host addresses back to
+  // guest code for the sampling profiler.
+  std::map<const u8*, const JitBlock*> m_host_code_map;
+
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
   ValidBlockBitSet valid_block;
 
+  // Number of blocks overlapping each 4 KiB page of the physical address space. Unlike
+  // valid_block, this is exact, so invalidating pages which only hold data can skip the block
+  // lookup entirely.
+  static constexpr u32 PAGE_SHIFT = 12;
+  static constexpr u32 PAGE_COUNT = 1u << (32 - PAGE_SHIFT);
+  std::vector<u32> m_page_block_count;
+
   // This array is indexed with the masked PC and likely holds the correct block id.
   // This is used as a fast cache of block_map used in the assembly dispatcher.
   std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> fast_block_map{};  // start_addr & mask -> number
+
+  // Persistent list of the blocks compiled in previous sessions of the running game.
+  JitBlockDiskCache m_disk_cache;
+
+  // The generated code holds pointers to these, so they are only freed when clearing the cache.
+  std::deque<IndirectBranchCache> m_indirect_branch_caches;
+  // Which indirect branch cache entries have to be reset when a block is destroyed.
+  std::unordered_multimap<const JitBlock*, std::pair<IndirectBranchCache*, u32>>
+      m_indirect_branch_targets;
+  bool m_indirect_branch_caching = false;
+
+  // Executed blocks are sampled every SAMPLE_INTERVAL finalized blocks, and before evicting.
+  static constexpr u32 SAMPLE_INTERVAL = 256;
+  static constexpr size_t EVICTION_DIVISOR = 4;
+  u32 m_execution_sample = 0;
+  u32 m_blocks_since_sample = 0;
 };
@@ -4,6 +4,7 @@
 #include "Core/PowerPC/JitInterface.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <string>
 #include <unordered_set>
@@ -19,6 +20,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/JitRegister.h"
 #include "Common/MsgHandler.h"
 
 #include "Core/Core.h"
@@ -41,6 +43,15 @@
 namespace JitInterface
 {
 static JitBase* g_jit = nullptr;
+static std::atomic<u32> s_code_space_usage_percent{0};
+static std::atomic<u32> s_evicted_blocks{0};
+static std::atomic<u32> s_full_clears{0};
+static std::atomic<u32> s_far_code_percent{0};
+static std::atomic<u32> s_code_space_size_kb{0};
+static std::atomic<u32> s_code_space_used_kb{0};
+static std::atomic<u64> s_compiled_blocks{0};
+static std::atomic<u64> s_compile_time_us{0};
+static std::atomic<u32> s_cache_clears{0};
 void SetJit(JitBase* jit)
 {
   g_jit = jit;
@@ -103,19 +114,54 @@ void WriteProfileResults(const std::string& filename)
     return;
   }
   f.WriteString("origAddr\tblkName\trunCount\tcost\ttimeCost\tpercent\ttimePercent\tOvAllinBlkTime("
-                "ms)\tblkCodeSize\n");
+                "ms)\tblkCodeSize\tnearCodeSize\tfarCodeSize\n");
   for (auto& stat : prof_stats.block_stats)
   {
     std::string name = g_symbolDB.GetDescription(stat.addr);
     double percent = 100.0 * (double)stat.cost / (double)prof_stats.cost_sum;
     double timePercent = 100.0 * (double)stat.tick_counter / (double)prof_stats.timecost_sum;
-    f.WriteString(fmt::format("{0:08x}\t{1}\t{2}\t{3}\t{4}\t{5:.2f}\t{6:.2f}\t{7:.2f}\t{8}\n",
-                              stat.addr, name, stat.run_count, stat.cost, stat.tick_counter,
-                              percent, timePercent,
-                              static_cast<double>(stat.tick_counter) * 1000.0 /
-                                  static_cast<double>(prof_stats.countsPerSec),
-                              stat.block_size));
+    f.WriteString(
+        fmt::format("{0:08x}\t{1}\t{2}\t{3}\t{4}\t{5:.2f}\t{6:.2f}\t{7:.2f}\t{8}\t{9}\t{10}\n",
+                    stat.addr, name, stat.run_count, stat.cost, stat.tick_counter, percent,
+                    timePercent,
+                    static_cast<double>(stat.tick_counter) * 1000.0 /
+                        static_cast<double>(prof_stats.countsPerSec),
+                    stat.block_size, stat.near_size, stat.far_size));
   }
+
+  WriteSymbolMap(filename + ".map");
+}
+
+void WriteSymbolMap(const std::string& filename)
+{
+  if (!g_jit)
+    return;
+
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    PanicAlertFmt("Failed to open {}", filename);
+    return;
+  }
+
+  Core::RunAsCPUThread([&f] {
+    const bool profiling = g_jit->jo.profile_blocks;
+    g_jit->GetBlockCache()->RunOnBlocks([&f, profiling](const JitBlock& block) {
+      const std::string name = JitBaseBlockCache::GetSymbolName(block);
+      const std::string stats = profiling ? fmt::format(" runs={} ticks={}",
+                                                        block.profile_data.runCount,
+                                                        block.profile_data.ticCounter) :
+                                            "";
+
+      f.WriteString(JitRegister::FormatMapEntry(block.checkedEntry, block.codeSize, name + stats));
+      if (block.far_begin != block.far_end)
+      {
+        f.WriteString(JitRegister::FormatMapEntry(block.far_begin,
+                                                  static_cast<u32>(block.far_end - block.far_begin),
+                                                  name + "_far" + stats));
+      }
+    });
+  });
 }
 
 void GetProfileResults(Profiler::ProfileStats* prof_stats)
@@ -136,8 +182,12 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
       u64 timecost = data.ticCounter;
       // Todo: tweak.
       if (data.runCount >= 1)
-        prof_stats->block_stats.emplace_back(block.effectiveAddress, cost, timecost, data.runCount,
-                                             block.codeSize);
+      {
+        prof_stats->block_stats.emplace_back(
+            block.effectiveAddress, cost, timecost, data.runCount, block.codeSize,
+            static_cast<u32>(block.near_end - block.near_begin),
+            static_cast<u32>(block.far_end - block.far_begin));
+      }
       prof_stats->cost_sum += cost;
       prof_stats->timecost_sum += timecost;
     });
@@ -146,6 +196,17 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
   });
 }
 
+std::optional<u32> GetBlockAddressFromHostCode(const u8* host_address)
+{
+  if (!g_jit)
+    return std::nullopt;
+
+  const JitBlock* block = g_jit->GetBlockCache()->GetBlockFromHostAddress(host_address);
+  if (!block)
+    return std::nullopt;
+  return block->effectiveAddress;
+}
+
 std::variant<GetHostCodeError, GetHostCodeResult> GetHostCode(u32 address)
 {
   if (!g_jit)
@@ -256,12 +317,18 @@ void CompileExceptionCheck(ExceptionType type)
   case ExceptionType::FIFOWrite:
     exception_addresses = &g_jit->js.fifoWriteAddresses;
     break;
-  case ExceptionType::PairedQuantize:
-    exception_addresses = &g_jit->js.pairedQuantizeAddresses;
-    break;
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &g_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::TierUp:
+    exception_addresses = &g_jit->js.hotBlockAddresses;
+    break;
+  case ExceptionType::TakenBranch:
+    exception_addresses = &g_jit->js.takenBranchHints;
+    break;
+  case ExceptionType::RoundingMode:
+    exception_addresses = &g_jit->js.noAssumedRoundingModeAddresses;
+    break;
   }
 
   if (PC != 0 && (exception_addresses->find(PC)) == (exception_addresses->end()))
@@ -281,6 +348,59 @@ void CompileExceptionCheck(ExceptionType type)
   }
 }
 
+void CompileGQRCheck(u32 gqr)
+{
+  if (!g_jit || PC == 0)
+    return;
+
+  BitSet8& unstable_gqrs = g_jit->js.unstableGqrs[PC];
+  if (unstable_gqrs[gqr])
+    return;
+  unstable_gqrs[gqr] = true;
+
+  // Invalidate the JIT block so that it gets recompiled without specializing on this GQR. The
+  // other GQRs of the block stay specialized.
+  g_jit->GetBlockCache()->InvalidateICache(PC, 4, true);
+}
+
+CodeSpaceStats GetCodeSpaceStats()
+{
+  CodeSpaceStats stats;
+  stats.usage_percent = s_code_space_usage_percent.load(std::memory_order_relaxed);
+  stats.evicted_blocks = s_evicted_blocks.load(std::memory_order_relaxed);
+  stats.full_clears = s_full_clears.load(std::memory_order_relaxed);
+  stats.far_code_percent = s_far_code_percent.load(std::memory_order_relaxed);
+  stats.size_kb = s_code_space_size_kb.load(std::memory_order_relaxed);
+  stats.used_kb = s_code_space_used_kb.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void SetCodeSpaceStats(const CodeSpaceStats& stats)
+{
+  s_code_space_usage_percent.store(stats.usage_percent, std::memory_order_relaxed);
+  s_evicted_blocks.store(stats.evicted_blocks, std::memory_order_relaxed);
+  s_full_clears.store(stats.full_clears, std::memory_order_relaxed);
+  s_far_code_percent.store(stats.far_code_percent, std::memory_order_relaxed);
+  s_code_space_size_kb.store(stats.size_kb, std::memory_order_relaxed);
+  s_code_space_used_kb.store(stats.used_kb, std::memory_order_relaxed);
+}
+
+CompileStats GetCompileStats()
+{
+  CompileStats stats;
+  stats.compiled_blocks = s_compiled_blocks.load(std::memory_order_relaxed);
+  stats.compile_time_us = s_compile_time_us.load(std::memory_order_relaxed);
+  stats.cache_clears = s_cache_clears.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void SetCompileStats(const CompileStats& stats)
+{
+  s_compiled_blocks.store(stats.compiled_blocks, std::memory_order_relaxed);
+  s_compile_time_us.store(stats.compile_time_us, std::memory_order_relaxed);
+  s_cache_clears.store(stats.cache_clears, std::memory_order_relaxed);
+}
+
 void Shutdown()
 {
   if (g_jit)
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <variant>
 
@@ -28,8 +29,10 @@ namespace JitInterface
 enum class ExceptionType
 {
   FIFOWrite,
-  PairedQuantize,
-  SpeculativeConstants
+  SpeculativeConstants,
+  TierUp,
+  TakenBranch,
+  RoundingMode
 };
 
 void DoState(PointerWrap& p);
@@ -59,7 +62,13 @@ struct GetHostCodeResult
 void SetProfilingState(ProfilingState state);
 void WriteProfileResults(const std::string& filename);
 void GetProfileResults(Profiler::ProfileStats* prof_stats);
+// Writes a perf map file (which perf and simpleperf both read) naming the host code of every
+// block after its guest address and symbol. With block profiling enabled, the names also contain
+// how often each block ran and the host ticks spent in it.
+void WriteSymbolMap(const std::string& filename);
 std::variant<GetHostCodeError, GetHostCodeResult> GetHostCode(u32 address);
+// Returns the guest address of the block whose host code contains the given address.
+std::optional<u32> GetBlockAddressFromHostCode(const u8* host_address);
 
 // Memory Utilities
 bool HandleFault(uintptr_t access_address, SContext* ctx);
@@ -79,9 +88,44 @@ void InvalidateICacheLine(u32 address);
 void InvalidateICacheLines(u32 address, u32 count);
 
 void CompileExceptionCheck(ExceptionType type);
+// Called when a GQR no longer has the value the block at PC was specialized on.
+void CompileGQRCheck(u32 gqr);
 
 /// used for the page fault unit test, don't use outside of tests!
 void SetJit(JitBase* jit);
 
+// Code space pressure of the JIT, shown in the statistics overlay.
+struct CodeSpaceStats
+{
+  // Fill level of the fuller of the near and far code regions, in percent.
+  u32 usage_percent = 0;
+  // Blocks destroyed to make room for new code by JIT cache eviction.
+  u32 evicted_blocks = 0;
+  // How often the whole code cache had to be cleared because it ran full.
+  u32 full_clears = 0;
+  // Share of the code of the live blocks which is in the far code region, in percent.
+  u32 far_code_percent = 0;
+  // Size of the near and far code regions together, and how much of them is in use, in KiB.
+  u32 size_kb = 0;
+  u32 used_kb = 0;
+};
+
+// Compilation work of the JIT since it was created, for benchmarking.
+struct CompileStats
+{
+  u64 compiled_blocks = 0;
+  // Host time spent compiling, including recompiling blocks which were invalidated.
+  u64 compile_time_us = 0;
+  // Clears of the whole code cache, both the ones counted in full_clears and the ones caused by
+  // the emulated software, e.g. by invalidating the whole instruction cache.
+  u32 cache_clears = 0;
+};
+
+// These can be called from any thread.
+CodeSpaceStats GetCodeSpaceStats();
+void SetCodeSpaceStats(const CodeSpaceStats& stats);
+CompileStats GetCompileStats();
+void SetCompileStats(const CompileStats& stats);
+
 void Shutdown();
 }  // namespace JitInterface
@@ -23,6 +23,7 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
+#include "VideoCommon/FrameTimeline.h"
 #include "VideoCommon/VideoBackendBase.h"
 
 namespace PowerPC
@@ -170,6 +171,64 @@ BatTable dbat_table;
 
 static void GenerateDSIException(u32 effective_address, bool write);
 
+static HostTLB& GetHostTLB(XCheckTLBFlag flag)
+{
+  return ppcState.host_tlb[flag == XCheckTLBFlag::Write];
+}
+
+static u32 GetHostTLBIndex(u32 address)
+{
+  return (address >> HW_PAGE_INDEX_SHIFT) & (HOST_TLB_SIZE - 1);
+}
+
+// Returns the host address of an access which doesn't cross a page boundary, if its page is in
+// the host TLB.
+static u8* LookupHostTLB(XCheckTLBFlag flag, u32 address)
+{
+  const HostTLB& host_tlb = GetHostTLB(flag);
+  const u32 index = GetHostTLBIndex(address);
+  if (host_tlb.tag[index] != (address | HW_PAGE_MASK))
+    return nullptr;
+  return host_tlb.bias[index] + address;
+}
+
+static void UpdateHostTLB(XCheckTLBFlag flag, u32 effective_address, u32 physical_address)
+{
+  const u8* const* page_mappings =
+      reinterpret_cast<const u8* const*>(Memory::physical_page_mappings_base);
+  if (!page_mappings)
+    return;
+
+  const u8* page = page_mappings[physical_address >> BAT_INDEX_SHIFT];
+  if (!page)
+    return;
+
+  const u32 offset_in_page = physical_address & (BAT_PAGE_SIZE - 1) & ~HW_PAGE_MASK;
+  const u32 effective_page = effective_address & ~HW_PAGE_MASK;
+
+  HostTLB& host_tlb = GetHostTLB(flag);
+  const u32 index = GetHostTLBIndex(effective_address);
+  host_tlb.bias[index] = const_cast<u8*>(page) + offset_in_page - effective_page;
+  host_tlb.tag[index] = effective_page | HW_PAGE_MASK;
+}
+
+static void InvalidateHostTLBPage(u32 effective_page_index)
+{
+  const u32 address = effective_page_index << HW_PAGE_INDEX_SHIFT;
+  for (HostTLB& host_tlb : ppcState.host_tlb)
+  {
+    const u32 index = GetHostTLBIndex(address);
+    if (host_tlb.tag[index] == (address | HW_PAGE_MASK))
+      host_tlb.tag[index] = 0;
+  }
+}
+
+void InvalidateHostTLB()
+{
+  for (HostTLB& host_tlb : ppcState.host_tlb)
+    host_tlb.Invalidate();
+}
+
 template <XCheckTLBFlag flag, typename T, bool never_translate = false>
 static T ReadFromHardware(u32 em_address)
 {
@@ -189,6 +248,16 @@ static T ReadFromHardware(u32 em_address)
 
   if (!never_translate && MSR.DR)
   {
+    if (flag == XCheckTLBFlag::Read)
+    {
+      if (const u8* host_address = LookupHostTLB(flag, em_address))
+      {
+        T value;
+        std::memcpy(&value, host_address, sizeof(T));
+        return bswap(value);
+      }
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -196,11 +265,14 @@ static T ReadFromHardware(u32 em_address)
         GenerateDSIException(em_address, false);
       return 0;
     }
+    if (flag == XCheckTLBFlag::Read)
+      UpdateHostTLB(flag, em_address, translated_addr.address);
     em_address = translated_addr.address;
   }
 
   if (flag == XCheckTLBFlag::Read && (em_address & 0xF8000000) == 0x08000000)
   {
+    VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::MMIOAndHLE);
     if (em_address < 0x0c000000)
       return EFB_Read(em_address);
     else
@@ -276,6 +348,16 @@ static void WriteToHardware(u32 em_address, const u32 data, const u32 size)
 
   if (!never_translate && MSR.DR)
   {
+    if (flag == XCheckTLBFlag::Write)
+    {
+      if (u8* host_address = LookupHostTLB(flag, em_address))
+      {
+        const u32 swapped_data = Common::swap32(Common::RotateRight(data, size * 8));
+        std::memcpy(host_address, &swapped_data, size);
+        return;
+      }
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -283,6 +365,9 @@ static void WriteToHardware(u32 em_address, const u32 data, const u32 size)
         GenerateDSIException(em_address, true);
       return;
     }
+    // Write-through and cache-inhibited accesses have side effects, see below.
+    if (flag == XCheckTLBFlag::Write && !translated_addr.wi)
+      UpdateHostTLB(flag, em_address, translated_addr.address);
     em_address = translated_addr.address;
     wi = translated_addr.wi;
   }
@@ -324,6 +409,7 @@ static void WriteToHardware(u32 em_address, const u32 data, const u32 size)
 
   if (flag == XCheckTLBFlag::Write && (em_address & 0xF8000000) == 0x08000000)
   {
+    VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::MMIOAndHLE);
     if (em_address < 0x0c000000)
     {
       EFB_Write(data, em_address);
@@ -965,6 +1051,45 @@ bool HostIsInstructionRAMAddress(u32 address, RequestedAddressSpace space)
   return false;
 }
 
+const u8* HostGetRAMPage(u32 address, RequestedAddressSpace space)
+{
+  bool translate;
+  switch (space)
+  {
+  case RequestedAddressSpace::Effective:
+    translate = MSR.DR;
+    break;
+  case RequestedAddressSpace::Physical:
+    translate = false;
+    break;
+  case RequestedAddressSpace::Virtual:
+    if (!MSR.DR)
+      return nullptr;
+    translate = true;
+    break;
+  default:
+    ASSERT(0);
+    return nullptr;
+  }
+
+  address &= ~HW_PAGE_MASK;
+  if (translate)
+  {
+    const auto translate_address = TranslateAddress<XCheckTLBFlag::NoException>(address);
+    if (!translate_address.Success())
+      return nullptr;
+    address = translate_address.address;
+  }
+
+  // The RAM sizes are multiples of the page size, so the whole page is inside.
+  const u32 segment = address >> 28;
+  if (Memory::m_pRAM && segment == 0x0 && address < Memory::GetRamSizeReal())
+    return Memory::m_pRAM + address;
+  if (Memory::m_pEXRAM && segment == 0x1 && (address & 0x0FFFFFFF) < Memory::GetExRamSizeReal())
+    return Memory::m_pEXRAM + (address & 0x0FFFFFFF);
+  return nullptr;
+}
+
 void DMA_LCToMemory(const u32 mem_address, const u32 cache_address, const u32 num_blocks)
 {
   // TODO: It's not completely clear this is the right spot for this code;
@@ -1206,6 +1331,8 @@ void SDRUpdated()
 
   ppcState.pagetable_base = htaborg << 16;
   ppcState.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+
+  InvalidateHostTLB();
 }
 
 enum class TLBLookupResult
@@ -1279,6 +1406,8 @@ static void UpdateTLBEntry(const XCheckTLBFlag flag, UPTE_Hi pte2, const u32 add
   TLBEntry& tlbe = ppcState.tlb[IsOpcodeFlag(flag)][tag & HW_PAGE_INDEX_MASK];
   const u32 index = tlbe.recent == 0 && tlbe.tag[0] != TLBEntry::INVALID_TAG;
   tlbe.recent = index;
+  if (!IsOpcodeFlag(flag) && tlbe.tag[index] != TLBEntry::INVALID_TAG)
+    InvalidateHostTLBPage(tlbe.tag[index]);
   tlbe.paddr[index] = pte2.RPN << HW_PAGE_INDEX_SHIFT;
   tlbe.pte[index] = pte2.Hex;
   tlbe.tag[index] = tag;
@@ -1288,6 +1417,12 @@ void InvalidateTLBEntry(u32 address)
 {
   const u32 entry_index = (address >> HW_PAGE_INDEX_SHIFT) & HW_PAGE_INDEX_MASK;
 
+  for (const u32 tag : ppcState.tlb[0][entry_index].tag)
+  {
+    if (tag != TLBEntry::INVALID_TAG)
+      InvalidateHostTLBPage(tag);
+  }
+
   ppcState.tlb[0][entry_index].Invalidate();
   ppcState.tlb[1][entry_index].Invalidate();
 }
@@ -1530,6 +1665,8 @@ void DBATUpdated()
   Memory::UpdateLogicalMemory(dbat_table);
 #endif
 
+  InvalidateHostTLB();
+
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   JitInterface::ClearSafe();
 }
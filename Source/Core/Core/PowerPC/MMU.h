@@ -124,6 +124,12 @@ bool HostIsRAMAddress(u32 address, RequestedAddressSpace space = RequestedAddres
 bool HostIsInstructionRAMAddress(u32 address,
                                  RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+// Returns the host memory backing the page containing the given address, if data reads from that
+// page in the given address space go to MEM1 or MEM2. Otherwise returns nullptr. This lets whole
+// pages be read without translating each address.
+const u8* HostGetRAMPage(u32 address,
+                         RequestedAddressSpace space = RequestedAddressSpace::Effective);
+
 // Routines for the CPU core to access memory.
 
 // Used by interpreter to read instructions, uses iCache
@@ -169,6 +175,7 @@ void ClearCacheLine(u32 address);  // Zeroes 32 bytes; address should be 32-byte
 // TLB functions
 void SDRUpdated();
 void InvalidateTLBEntry(u32 address);
+void InvalidateHostTLB();
 void DBATUpdated();
 void IBATUpdated();
 
@@ -43,6 +43,9 @@ constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
 
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
+// Maximum number of instructions of a loop considered by IsBusyWaitLoop.
+constexpr size_t MAX_BUSY_WAIT_LOOP_SIZE = 64;
+
 static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
 {
   switch (instr.OPCD)
@@ -192,6 +195,19 @@ static void AnalyzeFunction2(Common::Symbol* func)
   func->flags = flags;
 }
 
+bool PPCAnalyzer::CanFollowConditionalBranch(const CodeOp& op) const
+{
+  if (!m_taken_branch_hints || !m_enable_branch_following || !HasOption(OPTION_BRANCH_FOLLOW))
+    return false;
+
+  // Only forward bcx without LK are considered, so that loops keep their back edge as a block
+  // link and the LR value doesn't need to be faked.
+  const UGeckoInstruction inst = op.inst;
+  return inst.OPCD == 16 && !inst.LK &&
+         ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0 || (inst.BO & BO_DONT_CHECK_CONDITION) == 0) &&
+         op.branchTo > op.address;
+}
+
 bool PPCAnalyzer::CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b) const
 {
   const GekkoOPInfo* a_info = a.opinfo;
@@ -256,35 +272,34 @@ bool PPCAnalyzer::CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b) const
 // called by another function. Therefore, let's scan the
 // entire space for bl operations and find what functions
 // get called.
+// Popular functions are called from thousands of places, so the targets are collected first and
+// each one is only looked up (and analyzed, which may fail every time) once.
 static void FindFunctionsFromBranches(u32 startAddr, u32 endAddr, Common::SymbolDB* func_db)
 {
+  std::vector<u32> targets;
   for (u32 addr = startAddr; addr < endAddr; addr += 4)
   {
     const PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(addr);
     const UGeckoInstruction instr = read_result.hex;
 
-    if (read_result.valid && PPCTables::IsValidInstruction(instr))
-    {
-      switch (instr.OPCD)
-      {
-      case 18:  // branch instruction
-      {
-        if (instr.LK)  // bl
-        {
-          u32 target = SignExt26(instr.LI << 2);
-          if (!instr.AA)
-            target += addr;
-          if (PowerPC::HostIsRAMAddress(target))
-          {
-            func_db->AddFunction(target);
-          }
-        }
-      }
-      break;
-      default:
-        break;
-      }
-    }
+    // Only bl is of interest. Checking the opcode first avoids the table lookup for everything
+    // else, and any bl is a valid instruction.
+    if (!read_result.valid || instr.OPCD != 18 || !instr.LK)
+      continue;
+
+    u32 target = SignExt26(instr.LI << 2);
+    if (!instr.AA)
+      target += addr;
+    targets.push_back(target);
+  }
+
+  std::sort(targets.begin(), targets.end());
+  targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+  for (u32 target : targets)
+  {
+    if (PowerPC::HostIsRAMAddress(target))
+      func_db->AddFunction(target);
   }
 }
 
@@ -475,7 +490,7 @@ void PPCAnalyzer::ReorderInstructionsCore(u32 instructions, CodeOp* code, bool r
       // (if we add more merged branch instructions, add them here!)
       if ((type == ReorderType::CROR && isCror(a)) ||
           (type == ReorderType::Carry && isCarryOp(a)) ||
-          (type == ReorderType::CMP && (isCmp(a) || a.outputCR0)))
+          (type == ReorderType::CMP && (isCmp(a) || a.crOut[0])))
       {
         // once we're next to a carry instruction, don't move away!
         if (type == ReorderType::Carry && i != start)
@@ -524,9 +539,6 @@ void PPCAnalyzer::ReorderInstructions(u32 instructions, CodeOp* code) const
 void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code,
                                       const GekkoOPInfo* opinfo) const
 {
-  code->wantsCR0 = false;
-  code->wantsCR1 = false;
-
   bool first_fpu_instruction = false;
   if (opinfo->flags & FL_USE_FPU)
   {
@@ -534,21 +546,62 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code,
     block->m_fpa->any = true;
   }
 
-  // Does the instruction output CR0?
-  if (opinfo->flags & FL_RC_BIT)
-    code->outputCR0 = code->inst.hex & 1;  // todo fix
-  else if ((opinfo->flags & FL_SET_CRn) && code->inst.CRFD == 0)
-    code->outputCR0 = true;
-  else
-    code->outputCR0 = (opinfo->flags & FL_SET_CR0) != 0;
-
-  // Does the instruction output CR1?
-  if (opinfo->flags & FL_RC_BIT_F)
-    code->outputCR1 = code->inst.hex & 1;  // todo fix
-  else if ((opinfo->flags & FL_SET_CRn) && code->inst.CRFD == 1)
-    code->outputCR1 = true;
-  else
-    code->outputCR1 = (opinfo->flags & FL_SET_CR1) != 0;
+  // Which CR fields does the instruction read and write?
+  code->crIn = BitSet8{};
+  code->crOut = BitSet8{};
+  if ((opinfo->flags & FL_SET_CR0) || ((opinfo->flags & FL_RC_BIT) && code->inst.Rc))
+    code->crOut[0] = true;
+  if ((opinfo->flags & FL_SET_CR1) || ((opinfo->flags & FL_RC_BIT_F) && code->inst.Rc))
+    code->crOut[1] = true;
+  if (opinfo->flags & FL_SET_CRn)
+    code->crOut[code->inst.CRFD] = true;
+
+  switch (code->inst.OPCD)
+  {
+  case 16:  // bcx
+    if (!(code->inst.BO & BO_DONT_CHECK_CONDITION))
+      code->crIn[code->inst.BI >> 2] = true;
+    break;
+  case 19:
+    switch (code->inst.SUBOP10)
+    {
+    case 0:  // mcrf
+      code->crIn[code->inst.CRFS] = true;
+      break;
+    case 16:   // bclrx
+    case 528:  // bcctrx
+      if (!(code->inst.BO_2 & BO_DONT_CHECK_CONDITION))
+        code->crIn[code->inst.BI_2 >> 2] = true;
+      break;
+    case 33:   // crnor
+    case 129:  // crandc
+    case 193:  // crxor
+    case 225:  // crnand
+    case 257:  // crand
+    case 289:  // creqv
+    case 417:  // crorc
+    case 449:  // cror
+      // Only a single bit of crbD is written, so the rest of its field is passed through.
+      code->crIn[code->inst.CRBA >> 2] = true;
+      code->crIn[code->inst.CRBB >> 2] = true;
+      code->crIn[code->inst.CRBD >> 2] = true;
+      code->crOut[code->inst.CRBD >> 2] = true;
+      break;
+    }
+    break;
+  case 31:
+    if (code->inst.SUBOP10 == 19)  // mfcr
+    {
+      code->crIn = BitSet8::AllTrue(8);
+    }
+    else if (code->inst.SUBOP10 == 144)  // mtcrf
+    {
+      code->crOut = BitSet8{};
+      for (u32 i = 0; i < 8; ++i)
+        code->crOut[i] = (code->inst.CRM & (0x80 >> i)) != 0;
+    }
+    break;
+  }
 
   code->wantsFPRF = (opinfo->flags & FL_READ_FPRF) != 0;
   code->outputFPRF = (opinfo->flags & FL_SET_FPRF) != 0;
@@ -667,57 +720,151 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code,
   }
 }
 
-bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const
+// Whether an instruction may be part of a busy wait loop, as far as its effects on
+// anything but registers are concerned.
+static bool IsBusyWaitLoopInstruction(const CodeOp& op)
 {
-  // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
-  //   * It does not write to memory.
-  //   * It only reads from registers it wrote to earlier in the loop, or it
-  //     does not write to these registers.
-  //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
-  std::bitset<32> write_disallowed_regs;
-  std::bitset<32> written_regs;
-  for (size_t i = 0; i <= instructions; ++i)
+  const UGeckoInstruction inst = op.inst;
+  switch (op.opinfo->type)
   {
-    if (code[i].opinfo->type == OpType::Branch)
+  case OpType::Integer:
+  case OpType::Load:
+  case OpType::LoadFP:
+  case OpType::LoadPS:
+  case OpType::CR:
+  case OpType::Branch:
+    return true;
+
+  case OpType::System:
+    // mcrf, mfcr, mfmsr, sync and eieio
+    return (inst.OPCD == 19 && inst.SUBOP10 == 0) ||
+           (inst.OPCD == 31 && (inst.SUBOP10 == 19 || inst.SUBOP10 == 83 ||
+                                inst.SUBOP10 == 598 || inst.SUBOP10 == 854));
+
+  case OpType::SPR:
+  {
+    if (inst.SUBOP10 != 339)  // mfspr
+      return false;
+
+    // Only SPRs which can't change while the loop runs. Writing them would end the loop.
+    const u32 index = (inst.SPRU << 5) | (inst.SPRL & 0x1F);
+    return index == SPR_LR || index == SPR_CTR || (index >= SPR_SPRG0 && index <= SPR_SPRG3) ||
+           (index >= SPR_GQR0 && index < SPR_GQR0 + 8) || index == SPR_HID0 || index == SPR_HID1 ||
+           index == SPR_HID2 || index == SPR_HID4;
+  }
+
+  default:
+    return false;
+  }
+}
+
+bool PPCAnalyzer::IsBusyWaitLoop(const CodeOp* code, size_t instructions) const
+{
+  // Detects loops which only wait for something else (an interrupt, or another piece of hardware
+  // writing memory) to end them:
+  //   * The loop ends with a bcx or bx back to its head, which can be anywhere in the block. The
+  //     body may contain calls and returns which were followed, and conditional branches leaving
+  //     the loop.
+  //   * It does not write to memory or to any state outside of the registers.
+  //   * It only reads registers (GPRs, FPRs, CR fields, CA and LR) it wrote to earlier in the
+  //     loop, or it does not write to these registers. Each iteration then does exactly the same
+  //     as the previous one until something external changes the memory it reads.
+  const CodeOp& loop_branch = code[instructions];
+  if ((loop_branch.inst.OPCD != 16 && loop_branch.inst.OPCD != 18) || loop_branch.inst.LK ||
+      loop_branch.branchUsesCtr)
+  {
+    return false;
+  }
+
+  const size_t max_start =
+      instructions >= MAX_BUSY_WAIT_LOOP_SIZE ? instructions - MAX_BUSY_WAIT_LOOP_SIZE + 1 : 0;
+  size_t start = instructions;
+  while (code[start].address != loop_branch.branchTo)
+  {
+    if (start == max_start)
+      return false;
+    --start;
+  }
+
+  const auto is_in_loop = [&](u32 address) {
+    for (size_t i = start; i <= instructions; ++i)
     {
-      if (code[i].branchUsesCtr)
-        return false;
-      if (code[i].branchTo == block->m_address && i == instructions)
+      if (code[i].address == address)
         return true;
     }
-    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
-    {
-      // In the future, some subsets of other instruction types might get
-      // supported. Right now, only try loops that have this very
-      // restricted instruction set.
+    return false;
+  };
+
+  BitSet32 gpr_disallowed, gpr_written;
+  BitSet32 fpr_disallowed, fpr_written;
+  BitSet8 cr_disallowed, cr_written;
+  bool ca_disallowed = false, ca_written = false;
+  bool lr_disallowed = false, lr_written = false;
+
+  for (size_t i = start; i <= instructions; ++i)
+  {
+    const CodeOp& op = code[i];
+    const UGeckoInstruction inst = op.inst;
+    if (!IsBusyWaitLoopInstruction(op))
       return false;
-    }
-    else
+
+    bool reads_lr = false;
+    bool writes_lr = false;
+    if (op.opinfo->type == OpType::Branch)
     {
-      for (int reg : code[i].regsIn)
-      {
-        if (reg == -1)
-          continue;
-        if (written_regs[reg])
-          continue;
-        write_disallowed_regs[reg] = true;
-      }
-      for (int reg : code[i].regsOut)
+      if (op.branchUsesCtr || (inst.OPCD == 19 && inst.SUBOP10 != 16))
+        return false;
+
+      reads_lr = inst.OPCD == 19;
+      writes_lr = inst.LK;
+
+      // Every way out of a branch inside the loop other than the next instruction has to leave
+      // the loop, or we would have to check the paths through the loop separately.
+      if (i != instructions)
       {
-        if (reg == -1)
-          continue;
-        if (write_disallowed_regs[reg])
+        const bool unconditional =
+            inst.OPCD == 18 ||
+            ((inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION));
+        const u32 next = code[i + 1].address;
+        if (op.branchTo == next)
+        {
+          if (!unconditional && is_in_loop(op.address + 4))
+            return false;
+        }
+        else if (inst.OPCD == 19 || unconditional || is_in_loop(op.branchTo))
+        {
           return false;
-        written_regs[reg] = true;
+        }
       }
     }
+    else if (op.opinfo->type == OpType::SPR)
+    {
+      const u32 index = (inst.SPRU << 5) | (inst.SPRL & 0x1F);
+      reads_lr = index == SPR_LR;
+    }
+
+    gpr_disallowed |= op.regsIn & ~gpr_written;
+    fpr_disallowed |= op.fregsIn & ~fpr_written;
+    cr_disallowed |= op.crIn & ~cr_written;
+    ca_disallowed |= op.wantsCA && !ca_written;
+    lr_disallowed |= reads_lr && !lr_written;
+
+    const BitSet32 fregs_out = op.GetFregsOut();
+    if ((op.regsOut & gpr_disallowed) || (fregs_out & fpr_disallowed) ||
+        (op.crOut & cr_disallowed) || (op.outputCA && ca_disallowed) ||
+        (writes_lr && lr_disallowed))
+    {
+      return false;
+    }
+
+    gpr_written |= op.regsOut;
+    fpr_written |= fregs_out;
+    cr_written |= op.crOut;
+    ca_written |= op.outputCA;
+    lr_written |= writes_lr;
   }
-  return false;
+
+  return true;
 }
 
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
@@ -769,6 +916,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     code[i].address = address;
     code[i].inst = inst;
     code[i].skip = false;
+    code[i].followConditionalBranch = false;
     block->m_stats->numCycles += opinfo->numCycles;
     block->m_physical_addresses.insert(result.physical_address);
 
@@ -805,6 +953,15 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
           caller = i;
         }
       }
+      else if (block_size > 1 && CanFollowConditionalBranch(code[i]) &&
+               m_taken_branch_hints->count(code[i].address) != 0 &&
+               numFollows < BRANCH_FOLLOWING_THRESHOLD)
+      {
+        // Follow hot conditional branches, turning the fallthrough into a side exit.
+        follow = true;
+        found_call = false;
+        code[i].followConditionalBranch = true;
+      }
       else if (inst.OPCD == 19 && inst.SUBOP10 == 16 && !inst.LK && found_call)
       {
         code[i].branchTo = code[caller].address + 4;
@@ -866,8 +1023,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       }
     }
 
-    code[i].branchIsIdleLoop =
-        code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
+    code[i].branchIsIdleLoop = IsBusyWaitLoop(code, i);
 
     if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
     {
@@ -906,26 +1062,22 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
 
   // Scan for flag dependencies; assume the next block (or any branch that can leave the block)
   // wants flags, to be safe.
-  bool wantsCR0 = true, wantsCR1 = true, wantsFPRF = true, wantsCA = true;
+  bool wantsFPRF = true, wantsCA = true;
+  BitSet8 wantsCR = BitSet8::AllTrue(8);
   BitSet32 fprInUse, gprInUse, gprDiscardable, fprDiscardable, fprInXmm;
   for (int i = block->m_num_instructions - 1; i >= 0; i--)
   {
     CodeOp& op = code[i];
 
-    const bool opWantsCR0 = op.wantsCR0;
-    const bool opWantsCR1 = op.wantsCR1;
     const bool opWantsFPRF = op.wantsFPRF;
     const bool opWantsCA = op.wantsCA;
-    op.wantsCR0 = wantsCR0 || op.canEndBlock || op.canCauseException;
-    op.wantsCR1 = wantsCR1 || op.canEndBlock || op.canCauseException;
-    op.wantsFPRF = wantsFPRF || op.canEndBlock || op.canCauseException;
-    op.wantsCA = wantsCA || op.canEndBlock || op.canCauseException;
-    wantsCR0 |= opWantsCR0 || op.canEndBlock || op.canCauseException;
-    wantsCR1 |= opWantsCR1 || op.canEndBlock || op.canCauseException;
-    wantsFPRF |= opWantsFPRF || op.canEndBlock || op.canCauseException;
-    wantsCA |= opWantsCA || op.canEndBlock || op.canCauseException;
-    wantsCR0 &= !op.outputCR0 || opWantsCR0;
-    wantsCR1 &= !op.outputCR1 || opWantsCR1;
+    const bool leavesBlock = op.canEndBlock || op.canCauseException;
+    op.wantsCR = leavesBlock ? BitSet8::AllTrue(8) : wantsCR;
+    op.wantsFPRF = wantsFPRF || leavesBlock;
+    op.wantsCA = wantsCA || leavesBlock;
+    wantsCR = leavesBlock ? BitSet8::AllTrue(8) : (wantsCR & ~op.crOut) | op.crIn;
+    wantsFPRF |= opWantsFPRF || leavesBlock;
+    wantsCA |= opWantsCA || leavesBlock;
     wantsFPRF &= !op.outputFPRF || opWantsFPRF;
     wantsCA &= !op.outputCA || opWantsCA;
     op.gprInUse = gprInUse;
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <set>
+#include <unordered_set>
 #include <vector>
 
 #include "Common/BitSet.h"
@@ -34,19 +35,22 @@ struct CodeOp  // 16B
   bool isBranchTarget = false;
   bool branchUsesCtr = false;
   bool branchIsIdleLoop = false;
-  bool wantsCR0 = false;
-  bool wantsCR1 = false;
   bool wantsFPRF = false;
   bool wantsCA = false;
   bool wantsCAInFlags = false;
-  bool outputCR0 = false;
-  bool outputCR1 = false;
   bool outputFPRF = false;
   bool outputCA = false;
   bool canEndBlock = false;
   bool canCauseException = false;
   bool skipLRStack = false;
   bool skip = false;  // followed BL-s for example
+  // conditional branch whose taken path was stitched into the block, the fallthrough is a side exit
+  bool followConditionalBranch = false;
+  // which CR fields the instruction reads (including partial writes) and overwrites
+  BitSet8 crIn;
+  BitSet8 crOut;
+  // which CR fields are still needed after this instruction
+  BitSet8 wantsCR;
   // which registers are still needed after this instruction in this block
   BitSet32 fprInUse;
   BitSet32 gprInUse;
@@ -171,10 +175,16 @@ public:
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
+  u32 GetOptions() const { return m_options; }
+  void SetOptions(u32 options) { m_options = options; }
   void SetDebuggingEnabled(bool enabled) { m_is_debugging_enabled = enabled; }
   void SetBranchFollowingEnabled(bool enabled) { m_enable_branch_following = enabled; }
   void SetFloatExceptionsEnabled(bool enabled) { m_enable_float_exceptions = enabled; }
   void SetDivByZeroExceptionsEnabled(bool enabled) { m_enable_div_by_zero_exceptions = enabled; }
+  // Addresses of conditional branches which have been found to be mostly taken at runtime.
+  // Passing nullptr disables trace formation.
+  void SetTakenBranchHints(const std::unordered_set<u32>* hints) { m_taken_branch_hints = hints; }
+  bool CanFollowConditionalBranch(const CodeOp& op) const;
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size) const;
 
 private:
@@ -190,7 +200,7 @@ private:
                                ReorderType type) const;
   void ReorderInstructions(u32 instructions, CodeOp* code) const;
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo) const;
-  bool IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const;
+  bool IsBusyWaitLoop(const CodeOp* code, size_t instructions) const;
 
   // Options
   u32 m_options = 0;
@@ -199,6 +209,7 @@ private:
   bool m_enable_branch_following = false;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
+  const std::unordered_set<u32>* m_taken_branch_hints = nullptr;
 };
 
 void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db);
@@ -275,6 +275,7 @@ void Reset()
   ppcState.pagetable_base = 0;
   ppcState.pagetable_hashmask = 0;
   ppcState.tlb = {};
+  InvalidateHostTLB();
 
   ResetRegisters();
   ppcState.iCache.Reset();
@@ -635,6 +636,7 @@ void PowerPCState::SetSR(u32 index, u32 value)
 {
   DEBUG_LOG_FMT(POWERPC, "{:08x}: MMU: Segment register {} set to {:08x}", pc, index, value);
   sr[index] = value;
+  InvalidateHostTLB();
 }
 
 // FPSCR update functions
@@ -62,6 +62,23 @@ struct TLBEntry
   void Invalidate() { tag.fill(INVALID_TAG); }
 };
 
+// Direct-mapped cache of effective pages that translate to RAM, consulted by the slow memory
+// access paths before doing a full address translation. An entry for a page table translation is
+// only ever present while the TLB entry it came from is, so this doesn't change when R and C bits
+// get set. Entries hold host pointers and are therefore not part of savestates.
+constexpr size_t HOST_TLB_SIZE = 256;
+
+struct HostTLB
+{
+  // Pointers into host memory biased by the effective address of the page, so that adding the
+  // effective address of an access gives its host address.
+  std::array<u8*, HOST_TLB_SIZE> bias{};
+  // Effective address of the page with all the offset bits set. 0 never matches an access.
+  std::array<u32, HOST_TLB_SIZE> tag{};
+
+  void Invalidate() { tag.fill(0); }
+};
+
 struct PairedSingle
 {
   u64 PS0AsU64() const { return ps0; }
@@ -168,6 +185,9 @@ struct PowerPCState
 
   std::array<std::array<TLBEntry, TLB_SIZE / TLB_WAYS>, NUM_TLBS> tlb;
 
+  // Separate caches for reads and writes, since only writes need to set the C bit.
+  std::array<HostTLB, 2> host_tlb;
+
   u32 pagetable_base = 0;
   u32 pagetable_hashmask = 0;
 
@@ -13,8 +13,9 @@ namespace Profiler
 {
 struct BlockStat
 {
-  BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size)
-      : addr(_addr), cost(c), tick_counter(ticks), run_count(run), block_size(size)
+  BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size, u32 near_bytes, u32 far_bytes)
+      : addr(_addr), cost(c), tick_counter(ticks), run_count(run), block_size(size),
+        near_size(near_bytes), far_size(far_bytes)
   {
   }
   u32 addr;
@@ -22,6 +23,9 @@ struct BlockStat
   u64 tick_counter;
   u64 run_count;
   u32 block_size;
+  // Bytes of host code in the near and far code regions.
+  u32 near_size;
+  u32 far_size;
 
   bool operator<(const BlockStat& other) const { return cost > other.cost; }
 };
@@ -0,0 +1,335 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/SamplingProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+
+#if defined(__linux__) && !defined(_M_GENERIC)
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Core/MachineContext.h"
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace SamplingProfiler
+{
+namespace
+{
+constexpr u32 MAX_STACK_DEPTH = 16;
+
+// Stands in for the guest function in the stacks when the CPU thread was outside of JIT code.
+constexpr u32 HOST_CODE = 0;
+
+struct Sample
+{
+  uintptr_t host_pc;
+  u32 guest_pc;
+  u32 lr;
+  u32 num_frames;
+  // Return addresses found by walking the guest stack, innermost first
+  std::array<u32, MAX_STACK_DEPTH> frames;
+};
+
+// Written by the signal handler and read by ResolvePendingSamples, which both run on the CPU
+// thread, so the handler may interrupt a read but not the other way around. Samples taken while
+// the buffer is full are dropped.
+constexpr u32 SAMPLE_BUFFER_SIZE = 4096;
+std::array<Sample, SAMPLE_BUFFER_SIZE> s_samples;
+std::atomic<u32> s_read_index{0};
+std::atomic<u32> s_write_index{0};
+std::atomic<u32> s_dropped_samples{0};
+static_assert(std::atomic<u32>::is_always_lock_free);
+
+// Number of samples with each stack of guest functions, outermost first
+std::map<std::vector<u32>, u64> s_stacks;
+u64 s_num_samples = 0;
+
+bool s_running = false;
+
+// Reads a word of the guest stack, without anything that isn't safe in a signal handler. Stacks
+// are in MEM1 or MEM2, which games access through the BATs set up by the SDK.
+bool ReadStackWord(u32 address, u32* value)
+{
+  if ((address & 3) != 0)
+    return false;
+
+  const u32 segment = address >> 28;
+  const u32 offset = address & 0x0FFFFFFF;
+  const u8* memory;
+  if (segment == 0x8 || segment == 0xC)
+  {
+    if (!Memory::m_pRAM || offset >= Memory::GetRamSizeReal())
+      return false;
+    memory = Memory::m_pRAM;
+  }
+  else if (segment == 0x9 || segment == 0xD)
+  {
+    if (!Memory::m_pEXRAM || offset >= Memory::GetExRamSizeReal())
+      return false;
+    memory = Memory::m_pEXRAM;
+  }
+  else
+  {
+    return false;
+  }
+
+  *value = Common::swap32(memory + offset);
+  return true;
+}
+
+// Called from the signal handler.
+void TakeSample(uintptr_t host_pc)
+{
+  const u32 write_index = s_write_index.load(std::memory_order_relaxed);
+  if (write_index - s_read_index.load(std::memory_order_acquire) >= SAMPLE_BUFFER_SIZE)
+  {
+    s_dropped_samples.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Sample& sample = s_samples[write_index % SAMPLE_BUFFER_SIZE];
+  sample.host_pc = host_pc;
+  sample.guest_pc = PowerPC::ppcState.pc;
+  sample.lr = LR;
+
+  // Each frame starts with a pointer to the caller's frame, and the word after that is where the
+  // callee saves its return address.
+  sample.num_frames = 0;
+  u32 frame;
+  if (ReadStackWord(PowerPC::ppcState.gpr[1], &frame))
+  {
+    u32 return_address;
+    while (sample.num_frames < MAX_STACK_DEPTH && frame != 0 && frame != 0xFFFFFFFF &&
+           ReadStackWord(frame + 4, &return_address) && return_address != 0)
+    {
+      sample.frames[sample.num_frames++] = return_address - 4;
+      if (!ReadStackWord(frame, &frame))
+        break;
+    }
+  }
+
+  s_write_index.store(write_index + 1, std::memory_order_release);
+}
+
+u32 GetFunctionAddress(u32 address)
+{
+  const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  return symbol ? symbol->address : address;
+}
+
+std::string GetFunctionName(u32 address)
+{
+  if (address == HOST_CODE)
+    return "[host]";
+
+  const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  std::string name = symbol ? symbol->name : fmt::format("{:08x}", address);
+  // Semicolons separate the frames, and spaces the count.
+  std::replace(name.begin(), name.end(), ';', ':');
+  std::replace(name.begin(), name.end(), ' ', '_');
+  return name;
+}
+
+void AddSample(const Sample& sample)
+{
+  std::vector<u32> stack;
+  const auto push = [&stack](u32 function) {
+    // A function which hasn't called anything yet still has the return address into its caller in
+    // LR, but otherwise LR points into the function itself, and it would show up twice.
+    if (stack.empty() || stack.back() != function)
+      stack.push_back(function);
+  };
+
+  const std::optional<u32> block_address =
+      JitInterface::GetBlockAddressFromHostCode(reinterpret_cast<const u8*>(sample.host_pc));
+  const u32 leaf = GetFunctionAddress(block_address.value_or(sample.guest_pc));
+
+  // Built innermost first, then reversed.
+  if (!block_address)
+    stack.push_back(HOST_CODE);
+  push(leaf);
+  push(GetFunctionAddress(sample.lr));
+  for (u32 i = 0; i < sample.num_frames; ++i)
+    push(GetFunctionAddress(sample.frames[i]));
+
+  std::reverse(stack.begin(), stack.end());
+  ++s_stacks[std::move(stack)];
+  ++s_num_samples;
+}
+
+#if defined(__linux__) && !defined(_M_GENERIC)
+timer_t s_timer;
+struct sigaction s_old_action;
+
+void SignalHandler(int, siginfo_t*, void* raw_context)
+{
+  const int saved_errno = errno;
+  ucontext_t* context = static_cast<ucontext_t*>(raw_context);
+  SContext* ctx = &context->uc_mcontext;
+  TakeSample(static_cast<uintptr_t>(ctx->CTX_PC));
+  errno = saved_errno;
+}
+
+// Must be called on the CPU thread.
+bool StartTimer(u32 samples_per_second)
+{
+  clockid_t clock;
+  if (pthread_getcpuclockid(pthread_self(), &clock) != 0)
+    return false;
+
+  struct sigaction action{};
+  action.sa_sigaction = &SignalHandler;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, &s_old_action) != 0)
+    return false;
+
+  // Only the CPU thread is sampled, so the signal has to go to it rather than to the process.
+  sigevent event{};
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+  if (timer_create(clock, &event, &s_timer) != 0)
+  {
+    sigaction(SIGPROF, &s_old_action, nullptr);
+    return false;
+  }
+
+  const long interval_ns = 1000000000L / std::max<u32>(samples_per_second, 1);
+  itimerspec spec{};
+  spec.it_interval.tv_sec = interval_ns / 1000000000L;
+  spec.it_interval.tv_nsec = interval_ns % 1000000000L;
+  spec.it_value = spec.it_interval;
+  if (timer_settime(s_timer, 0, &spec, nullptr) != 0)
+  {
+    timer_delete(s_timer);
+    sigaction(SIGPROF, &s_old_action, nullptr);
+    return false;
+  }
+  return true;
+}
+
+void StopTimer()
+{
+  timer_delete(s_timer);
+  sigaction(SIGPROF, &s_old_action, nullptr);
+}
+#else
+bool StartTimer(u32)
+{
+  return false;
+}
+
+void StopTimer()
+{
+}
+#endif
+
+void WriteStacks()
+{
+  const std::string path = GetOutputPath();
+  File::CreateFullPath(path);
+  File::IOFile file(path, "w");
+  if (!file)
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to write the sampling profile to {}", path);
+    return;
+  }
+
+  for (const auto& [stack, count] : s_stacks)
+  {
+    std::string line;
+    for (u32 function : stack)
+    {
+      if (!line.empty())
+        line += ';';
+      line += GetFunctionName(function);
+    }
+    file.WriteString(fmt::format("{} {}\n", line, count));
+  }
+
+  NOTICE_LOG_FMT(POWERPC, "Wrote {} samples ({} dropped) to {}", s_num_samples,
+                 s_dropped_samples.load(std::memory_order_relaxed), path);
+}
+}  // namespace
+
+bool Start(u32 samples_per_second)
+{
+  if (s_running || !Core::IsRunning())
+    return false;
+
+  s_stacks.clear();
+  s_num_samples = 0;
+  s_dropped_samples.store(0, std::memory_order_relaxed);
+  s_read_index.store(0, std::memory_order_relaxed);
+  s_write_index.store(0, std::memory_order_relaxed);
+
+  bool success = false;
+  Core::RunOnCPUThread([&] { success = StartTimer(samples_per_second); }, true);
+  s_running = success;
+  return success;
+}
+
+void Stop()
+{
+  if (!s_running)
+    return;
+
+  Core::RunAsCPUThread([] {
+    StopTimer();
+    ResolvePendingSamples();
+    WriteStacks();
+    s_stacks.clear();
+    s_running = false;
+  });
+}
+
+bool IsRunning()
+{
+  return s_running;
+}
+
+std::string GetOutputPath()
+{
+  return File::GetUserPath(D_DUMP_IDX) + "Debug/sampling_profile.folded";
+}
+
+void ResolvePendingSamples()
+{
+  const u32 write_index = s_write_index.load(std::memory_order_acquire);
+  u32 read_index = s_read_index.load(std::memory_order_relaxed);
+  if (read_index == write_index)
+    return;
+
+  for (; read_index != write_index; ++read_index)
+    AddSample(s_samples[read_index % SAMPLE_BUFFER_SIZE]);
+  s_read_index.store(read_index, std::memory_order_release);
+}
+}  // namespace SamplingProfiler
@@ -0,0 +1,39 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Finds out where the CPU thread spends its time by interrupting it at a fixed rate of its CPU
+// time, rather than by instrumenting the generated code like block profiling does, so that it
+// barely affects what it measures. Each sample records the host PC, which is mapped back to the
+// JIT block it's in, and the guest call stack, which is found by walking the stack frames.
+//
+// The samples are written as folded stacks ("caller;callee count" lines), which flame graph tools
+// read, with the functions named after the symbols in g_symbolDB. Time spent outside of JIT code,
+// like in MMIO handlers or the dispatcher, is shown as a "[host]" frame on top of the guest
+// function which was running.
+//
+// Only supported on Linux and Android.
+namespace SamplingProfiler
+{
+// Starts sampling the CPU thread of the running game. Returns false if it's not supported or
+// there's no game running.
+bool Start(u32 samples_per_second = 1000);
+
+// Stops sampling, and writes the samples taken since Start to GetOutputPath(). Also called when
+// emulation ends.
+void Stop();
+
+bool IsRunning();
+
+std::string GetOutputPath();
+
+// Maps the samples taken since the last call back to guest code. Must be called on the CPU thread
+// (or while it's paused), and before JIT blocks are destroyed, since samples taken in a block
+// can't be mapped once it's gone. Returns quickly if there's nothing to do.
+void ResolvePendingSamples();
+}  // namespace SamplingProfiler
@@ -3,11 +3,16 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <thread>
 #include <utility>
@@ -16,18 +21,22 @@
 #include <fmt/format.h>
 
 #include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 #include "Common/Version.h"
 #include "Common/WorkQueueThread.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -39,10 +48,12 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/StateDelta.h"
 
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoBackendBase.h"
+#include "VideoCommon/VideoState.h"
 
 namespace State
 {
@@ -63,12 +74,59 @@ static unsigned char __LZO_MMODEL out[OUT_LEN];
 
 static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
 
+// Each chunk is compressed independently, so that all cores can work on a state at once and the
+// compressed chunks can be written out while later ones are still being compressed.
+constexpr size_t ZSTD_CHUNK_SIZE = 4 * 1024 * 1024;
+
+struct ZstdChunkHeader
+{
+  u32 compressed_size;
+  u32 uncompressed_size;
+};
+static_assert(sizeof(ZstdChunkHeader) == 8);
+
 static AfterLoadCallbackFunc s_on_after_load_callback;
 
 // Temporary undo state buffer
 static std::vector<u8> s_undo_load_buffer;
 static std::mutex s_undo_load_buffer_mutex;
 
+// Recent states kept in memory by SaveToHistory, for rewinding. The number of states is in
+// practice limited by the memory budget. A keyframe every few snapshots keeps both the memory
+// usage and the cost of restoring a state low.
+constexpr size_t STATE_HISTORY_MAX_STATES = 10000;
+constexpr size_t STATE_HISTORY_KEYFRAME_INTERVAL = 10;
+constexpr int STATE_HISTORY_COMPRESSION_LEVEL = 1;
+static std::unique_ptr<StateHistory> s_state_history;
+static std::mutex s_state_history_mutex;
+
+// The CPU thread only serializes snapshots. Turning them into deltas and compressing them
+// happens on this thread.
+struct HistorySnapshot
+{
+  std::vector<u8> buffer;
+  u64 generation;
+};
+static Common::WorkQueueThread<HistorySnapshot> s_history_thread;
+
+// Incremented when rewinding, so that snapshots which are still being compressed at that point
+// get dropped instead of ending up in front of the state that was rewound to.
+static std::atomic<u64> s_history_generation;
+
+// Size of the last snapshot, so the next one can skip measuring the state. Host thread only.
+static size_t s_history_buffer_size;
+// Size of the last state written by WriteStateToBuffer, for buffers which aren't reused.
+static std::atomic<size_t> s_last_state_size;
+
+// Video fields between automatic snapshots, or 0 if rewinding is disabled. CPU thread only.
+static u32 s_history_interval;
+static u32 s_fields_since_snapshot;
+static std::atomic_bool s_history_snapshot_queued;
+
+// Timings of SaveToFastBuffer for the running game, to check it against FAST_STATE_BUDGET_US.
+static FastStateStats s_fast_state_stats;
+static std::mutex s_fast_state_stats_mutex;
+
 static std::mutex s_load_or_save_in_progress_mutex;
 
 struct CompressAndDumpState_args
@@ -76,6 +134,8 @@ struct CompressAndDumpState_args
   std::vector<u8> buffer_vector;
   std::string filename;
   std::shared_ptr<Common::Event> state_write_done_event;
+  CompressionMethod compression{};
+  int compression_level = 0;
 };
 
 // Protects against simultaneous reads and writes to the final savestate location from multiple
@@ -210,29 +270,38 @@ static void DoState(PointerWrap& p)
     return;
   }
 
+  // Does the state of a subsystem followed by its marker. When saving, logs how much of the state
+  // the subsystem takes up and how long it took to write.
+  const auto do_subsystem = [&p](const char* name, const auto& do_state) {
+    const u8* const begin = p.GetCurrentPointer();
+    const u64 start_us = Common::Timer::NowUs();
+    do_state();
+    p.DoMarker(name);
+    if (p.IsWriteMode())
+    {
+      DEBUG_LOG_FMT(CORE, "State: {} is {} bytes, written in {} us", name,
+                    p.GetCurrentPointer() - begin, Common::Timer::NowUs() - start_us);
+    }
+  };
+
   // Movie must be done before the video backend, because the window is redrawn in the video backend
   // state load, and the frame number must be up-to-date.
-  Movie::DoState(p);
-  p.DoMarker("Movie");
+  do_subsystem("Movie", [&p] { Movie::DoState(p); });
 
   // Begin with video backend, so that it gets a chance to clear its caches and writeback modified
   // things to RAM
-  g_video_backend->DoState(p);
-  p.DoMarker("video_backend");
+  do_subsystem("video_backend", [&p] { g_video_backend->DoState(p); });
 
-  PowerPC::DoState(p);
-  p.DoMarker("PowerPC");
+  do_subsystem("PowerPC", [&p] { PowerPC::DoState(p); });
   // CoreTiming needs to be restored before restoring Hardware because
   // the controller code might need to schedule an event if the controller has changed.
-  CoreTiming::DoState(p);
-  p.DoMarker("CoreTiming");
-  HW::DoState(p);
-  p.DoMarker("HW");
-  if (SConfig::GetInstance().bWii)
-    Wiimote::DoState(p);
-  p.DoMarker("Wiimote");
-  Gecko::DoState(p);
-  p.DoMarker("Gecko");
+  do_subsystem("CoreTiming", [&p] { CoreTiming::DoState(p); });
+  do_subsystem("HW", [&p] { HW::DoState(p); });
+  do_subsystem("Wiimote", [&p] {
+    if (SConfig::GetInstance().bWii)
+      Wiimote::DoState(p);
+  });
+  do_subsystem("Gecko", [&p] { Gecko::DoState(p); });
 }
 
 void LoadFromBuffer(std::vector<u8>& buffer)
@@ -252,24 +321,163 @@ void LoadFromBuffer(std::vector<u8>& buffer)
       true);
 }
 
+// Serializes the state into buffer. Must be called on the CPU thread. States rarely change size,
+// so writing straight into a buffer the size of the last one avoids a measuring pass, which takes
+// as long as the write itself. If the state doesn't fit, PointerWrap switches to measuring where
+// it ran out of space, so the first pass still ends up with the size for the second one. Clears
+// buffer on failure.
+static void WriteStateToBuffer(std::vector<u8>& buffer)
+{
+  for (int attempt = 0; attempt < 2; ++attempt)
+  {
+    u8* ptr = buffer.data();
+    PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+    DoState(p);
+    buffer.resize(ptr - buffer.data());
+    if (p.IsWriteMode())
+    {
+      s_last_state_size = buffer.size();
+      return;
+    }
+  }
+
+  buffer.clear();
+}
+
 void SaveToBuffer(std::vector<u8>& buffer)
+{
+  // Allocate the buffer here rather than on the CPU thread, like in SaveToHistory.
+  buffer.resize(s_last_state_size);
+  Core::RunOnCPUThread([&] { WriteStateToBuffer(buffer); }, true);
+}
+
+void SaveToFastBuffer(std::vector<u8>& buffer)
 {
   Core::RunOnCPUThread(
       [&] {
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-
-        DoState(p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-        buffer.resize(buffer_size);
+        const u64 start_us = Common::Timer::NowUs();
+
+        VideoCommon_SetSkipGPUReadback(true);
+        WriteStateToBuffer(buffer);
+        VideoCommon_SetSkipGPUReadback(false);
+
+        const u64 elapsed_us = Common::Timer::NowUs() - start_us;
+        const bool over_budget = elapsed_us > FAST_STATE_BUDGET_US;
+        if (over_budget)
+          DEBUG_LOG_FMT(CORE, "Fast state took {} us, over the budget", elapsed_us);
+
+        std::lock_guard lk(s_fast_state_stats_mutex);
+        s_fast_state_stats.count++;
+        s_fast_state_stats.total_us += elapsed_us;
+        s_fast_state_stats.max_us = std::max(s_fast_state_stats.max_us, elapsed_us);
+        if (over_budget)
+          s_fast_state_stats.over_budget_count++;
+      },
+      true);
+}
 
-        ptr = buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+void LoadFromFastBuffer(std::vector<u8>& buffer)
+{
+  Core::RunOnCPUThread(
+      [&] {
+        u8* ptr = buffer.data();
+        PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
         DoState(p);
       },
       true);
 }
 
+FastStateStats GetFastStateStats()
+{
+  std::lock_guard lk(s_fast_state_stats_mutex);
+  return s_fast_state_stats;
+}
+
+void SaveToHistory()
+{
+  if (!Core::IsRunningAndStarted())
+    return;
+
+  // Allocate the buffer here rather than on the CPU thread, as faulting in the pages of a buffer
+  // the size of a Wii state takes about as long as serializing into it.
+  std::vector<u8> buffer(s_history_buffer_size);
+  const u64 generation = s_history_generation;
+
+  Core::RunOnCPUThread(
+      [&] {
+        Common::Timer timer;
+        timer.Start();
+        WriteStateToBuffer(buffer);
+        DEBUG_LOG_FMT(CORE, "Took {} byte rewind snapshot in {} ms", buffer.size(),
+                      timer.ElapsedMs());
+      },
+      true);
+
+  if (buffer.empty())
+    return;
+
+  s_history_buffer_size = buffer.size();
+  s_history_thread.EmplaceItem(HistorySnapshot{std::move(buffer), generation});
+}
+
+bool LoadFromHistory(size_t age)
+{
+  std::vector<u8> buffer;
+  {
+    std::lock_guard lk(s_state_history_mutex);
+    if (!s_state_history || !s_state_history->Get(age, &buffer))
+      return false;
+  }
+
+  LoadFromBuffer(buffer);
+  return true;
+}
+
+void OnNewField()
+{
+  if (s_history_interval == 0 || ++s_fields_since_snapshot < s_history_interval)
+    return;
+
+  s_fields_since_snapshot = 0;
+
+  // Snapshots can't be taken in the middle of a CoreTiming event, so one is taken from the host
+  // thread, which pauses the CPU thread at a safe point. At most one is queued at a time, so a
+  // slow host thread doesn't make them pile up.
+  if (NetPlay::IsNetPlayRunning() || Movie::IsMovieActive() ||
+      s_history_snapshot_queued.exchange(true))
+  {
+    return;
+  }
+
+  Core::QueueHostJob([] {
+    SaveToHistory();
+    s_history_snapshot_queued = false;
+  });
+}
+
+bool Rewind()
+{
+  if (NetPlay::IsNetPlayRunning())
+  {
+    OSD::AddMessage("Rewinding is disabled in Netplay to prevent desyncs");
+    return false;
+  }
+
+  std::vector<u8> buffer;
+  {
+    std::lock_guard lk(s_state_history_mutex);
+    ++s_history_generation;
+    if (!s_state_history || !s_state_history->PopNewest(&buffer))
+    {
+      Core::DisplayMessage("There is nothing to rewind to", 2000);
+      return false;
+    }
+  }
+
+  LoadFromBuffer(buffer);
+  return true;
+}
+
 // return state number not in map
 static int GetEmptySlot(std::map<double, int> m)
 {
@@ -317,6 +525,83 @@ static std::map<double, int> GetSavedStates()
   return m;
 }
 
+static void WriteLZOCompressedState(File::IOFile& f, const u8* buffer_data, size_t buffer_size)
+{
+  lzo_uint i = 0;
+  while (true)
+  {
+    lzo_uint32 cur_len = 0;
+    lzo_uint out_len = 0;
+
+    if ((i + IN_LEN) >= buffer_size)
+    {
+      cur_len = (lzo_uint32)(buffer_size - i);
+    }
+    else
+    {
+      cur_len = IN_LEN;
+    }
+
+    if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
+      PanicAlertFmtT("Internal LZO Error - compression failed");
+
+    // The size of the data to write is 'out_len'
+    f.WriteArray((lzo_uint32*)&out_len, 1);
+    f.WriteBytes(out, out_len);
+
+    if (cur_len != IN_LEN)
+      break;
+
+    i += cur_len;
+  }
+}
+
+static bool WriteZstdCompressedState(File::IOFile& f, const u8* buffer_data, size_t buffer_size,
+                                     int level)
+{
+  const auto compress_chunk = [=](size_t offset) {
+    const size_t size = std::min(ZSTD_CHUNK_SIZE, buffer_size - offset);
+    std::vector<u8> chunk(sizeof(ZstdChunkHeader) + ZSTD_compressBound(size));
+    const size_t compressed_size =
+        ZSTD_compress(chunk.data() + sizeof(ZstdChunkHeader), chunk.size() - sizeof(ZstdChunkHeader),
+                      buffer_data + offset, size, level);
+    if (ZSTD_isError(compressed_size))
+      return std::vector<u8>();
+
+    const ZstdChunkHeader chunk_header{static_cast<u32>(compressed_size), static_cast<u32>(size)};
+    std::memcpy(chunk.data(), &chunk_header, sizeof(chunk_header));
+    chunk.resize(sizeof(ZstdChunkHeader) + compressed_size);
+    return chunk;
+  };
+
+  // Chunks are written in order as soon as they are done, while up to one chunk per core is
+  // being compressed ahead of the one being written.
+  const size_t max_pending = std::max(std::thread::hardware_concurrency(), 1u);
+  std::deque<std::future<std::vector<u8>>> pending;
+  size_t next_offset = 0;
+  while (next_offset < buffer_size || !pending.empty())
+  {
+    while (next_offset < buffer_size && pending.size() < max_pending)
+    {
+      pending.push_back(std::async(std::launch::async, compress_chunk, next_offset));
+      next_offset += ZSTD_CHUNK_SIZE;
+    }
+
+    const std::vector<u8> chunk = pending.front().get();
+    pending.pop_front();
+    if (chunk.empty())
+    {
+      ERROR_LOG_FMT(CORE, "Failed to compress savestate");
+      return false;
+    }
+
+    if (!f.WriteBytes(chunk.data(), chunk.size()))
+      return false;
+  }
+
+  return true;
+}
+
 static void CompressAndDumpState(CompressAndDumpState_args& save_args)
 {
   const u8* const buffer_data = save_args.buffer_vector.data();
@@ -345,45 +630,39 @@ static void CompressAndDumpState(CompressAndDumpState_args& save_args)
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.gameID, std::size(header.gameID));
   header.size = s_use_compression ? (u32)buffer_size : 0;
+  header.compression = save_args.compression;
   header.time = Common::Timer::GetSystemTimeAsDouble();
 
   f.WriteArray(&header, 1);
 
-  if (header.size != 0)  // non-zero header size means the state is compressed
-  {
-    lzo_uint i = 0;
-    while (true)
-    {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
+  Common::Timer timer;
+  timer.Start();
 
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertFmtT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
-    }
+  bool success = true;
+  if (header.size != 0 && header.compression == CompressionMethod::Zstd)
+  {
+    success = WriteZstdCompressedState(f, buffer_data, buffer_size, save_args.compression_level);
+  }
+  else if (header.size != 0)  // non-zero header size means the state is compressed
+  {
+    WriteLZOCompressedState(f, buffer_data, buffer_size);
   }
   else  // uncompressed
   {
     f.WriteBytes(buffer_data, buffer_size);
   }
 
+  if (!success || !f.IsGood())
+  {
+    f.Close();
+    File::Delete(temp_filename);
+    Core::DisplayMessage("Could not save state", 2000);
+    return;
+  }
+
+  INFO_LOG_FMT(CORE, "Wrote {} byte state as {} bytes in {} ms", buffer_size, f.Tell(),
+               timer.ElapsedMs());
+
   const std::string last_state_filename = File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav";
   const std::string last_state_dtmname = last_state_filename + ".dtm";
   const std::string dtmname = filename + ".dtm";
@@ -439,20 +718,10 @@ void SaveAs(const std::string& filename, bool wait)
           ++s_state_writes_in_queue;
         }
 
-        // Measure the size of the buffer.
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-        DoState(p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-        // Then actually do the write.
-        std::vector<u8> current_buffer;
-        current_buffer.resize(buffer_size);
-        ptr = current_buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-        DoState(p);
+        std::vector<u8> current_buffer(s_last_state_size);
+        WriteStateToBuffer(current_buffer);
 
-        if (p.IsWriteMode())
+        if (!current_buffer.empty())
         {
           Core::DisplayMessage("Saving State...", 1000);
 
@@ -461,6 +730,8 @@ void SaveAs(const std::string& filename, bool wait)
           CompressAndDumpState_args save_args;
           save_args.buffer_vector = std::move(current_buffer);
           save_args.filename = filename;
+          save_args.compression = Config::Get(Config::MAIN_SAVESTATE_COMPRESSION);
+          save_args.compression_level = Config::Get(Config::MAIN_SAVESTATE_COMPRESSION_LEVEL);
 
           if (wait)
           {
@@ -521,10 +792,122 @@ u64 GetUnixTimeOfSlot(int slot)
          (Common::Timer::DOUBLE_TIME_OFFSET * MS_PER_SEC);
 }
 
-static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
+static bool ReadLZOCompressedState(std::span<const u8> compressed, std::vector<u8>& buffer)
+{
+  lzo_uint i = 0;
+  size_t position = 0;
+  while (compressed.size() - position >= sizeof(lzo_uint32))
+  {
+    lzo_uint32 cur_len = 0;  // number of bytes to read
+    std::memcpy(&cur_len, compressed.data() + position, sizeof(cur_len));
+    position += sizeof(cur_len);
+    if (cur_len > OUT_LEN || cur_len > compressed.size() - position)
+      break;
+
+    // lzo1x_decompress doesn't take a pointer to const input, so go through the static buffer.
+    std::memcpy(out, compressed.data() + position, cur_len);
+    position += cur_len;
+
+    lzo_uint new_len = buffer.size() - i;  // number of bytes to write
+    const int res = lzo1x_decompress_safe(out, cur_len, &buffer[i], &new_len, nullptr);
+    if (res != LZO_E_OK)
+    {
+      // This doesn't seem to happen anymore.
+      PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
+                     "Try loading the state again",
+                     res, i, new_len);
+      return false;
+    }
+
+    i += new_len;
+  }
+
+  return true;
+}
+
+static bool ReadZstdCompressedState(std::span<const u8> compressed, std::vector<u8>& buffer)
+{
+  struct Chunk
+  {
+    size_t compressed_offset;
+    size_t uncompressed_offset;
+    ZstdChunkHeader header;
+  };
+
+  // Find all chunks first, so that they can be decompressed in parallel. This only touches the
+  // chunk headers, so the file mapping is read from disk by the threads doing the decompression.
+  std::vector<Chunk> chunks;
+  size_t compressed_offset = 0;
+  size_t uncompressed_offset = 0;
+  while (compressed_offset < compressed.size())
+  {
+    if (compressed.size() - compressed_offset < sizeof(ZstdChunkHeader))
+      break;
+
+    Chunk chunk{compressed_offset + sizeof(ZstdChunkHeader), uncompressed_offset, {}};
+    std::memcpy(&chunk.header, compressed.data() + compressed_offset, sizeof(ZstdChunkHeader));
+    if (chunk.header.compressed_size > compressed.size() - chunk.compressed_offset ||
+        chunk.header.uncompressed_size > buffer.size() - uncompressed_offset)
+    {
+      break;
+    }
+
+    chunks.push_back(chunk);
+    compressed_offset = chunk.compressed_offset + chunk.header.compressed_size;
+    uncompressed_offset += chunk.header.uncompressed_size;
+  }
+
+  if (compressed_offset != compressed.size() || uncompressed_offset != buffer.size())
+  {
+    PanicAlertFmtT("The savestate is truncated or damaged.");
+    return false;
+  }
+
+  const auto decompress_chunk = [&](const Chunk& chunk) {
+    const size_t size = ZSTD_decompress(
+        buffer.data() + chunk.uncompressed_offset, chunk.header.uncompressed_size,
+        compressed.data() + chunk.compressed_offset, chunk.header.compressed_size);
+    return size == chunk.header.uncompressed_size;
+  };
+
+  // Each thread takes every num_threads-th chunk, starting with the calling thread.
+  const size_t num_threads =
+      std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), chunks.size());
+  const auto decompress_chunks = [&](size_t first) {
+    bool chunks_ok = true;
+    for (size_t i = first; i < chunks.size(); i += num_threads)
+      chunks_ok &= decompress_chunk(chunks[i]);
+    return chunks_ok;
+  };
+
+  std::vector<std::future<bool>> futures;
+  for (size_t i = 1; i < num_threads; i++)
+    futures.push_back(std::async(std::launch::async, decompress_chunks, i));
+
+  bool success = decompress_chunks(0);
+  for (std::future<bool>& future : futures)
+    success &= future.get();
+
+  if (!success)
+    PanicAlertFmtT("The savestate is truncated or damaged.");
+
+  return success;
+}
+
+namespace
+{
+// The contents of a state file. Compressed states are decompressed into buffer, while
+// uncompressed states are used straight from the mapped file, so they don't need to be copied.
+struct StateFileData
 {
-  File::IOFile f;
+  File::MappedFile file;
+  std::vector<u8> buffer;
+  std::span<const u8> data;
+};
+}  // namespace
 
+static bool LoadFileStateData(const std::string& filename, StateFileData& ret_data)
+{
   {
     // If a state is currently saving, wait for that to end or time out.
     std::unique_lock lk(s_state_writes_in_queue_mutex);
@@ -535,72 +918,66 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
       {
         Core::DisplayMessage(
             "A previous state saving operation is still in progress, cancelling load.", 2000);
-        return;
+        return false;
       }
     }
-    f.Open(filename, "rb");
+
+    if (!ret_data.file.Open(filename) || ret_data.file.GetSize() < sizeof(StateHeader))
+    {
+      Core::DisplayMessage("State not found", 2000);
+      return false;
+    }
   }
 
   StateHeader header;
-  if (!f.ReadArray(&header, 1))
-  {
-    Core::DisplayMessage("State not found", 2000);
-    return;
-  }
+  std::memcpy(&header, ret_data.file.GetData(), sizeof(header));
+  const std::span<const u8> contents(ret_data.file.GetData() + sizeof(header),
+                                     ret_data.file.GetSize() - sizeof(header));
 
   if (strncmp(SConfig::GetInstance().GetGameID().c_str(), header.gameID, 6))
   {
     Core::DisplayMessage(fmt::format("State belongs to a different game (ID {})",
                                      std::string_view{header.gameID, std::size(header.gameID)}),
                          2000);
-    return;
+    return false;
   }
 
-  std::vector<u8> buffer;
-
-  if (header.size != 0)  // non-zero size means the state is compressed
+  if (header.size == 0)  // zero size means the state is uncompressed
   {
-    Core::DisplayMessage("Decompressing State...", 500);
+    ret_data.data = contents;
+    return true;
+  }
 
-    buffer.resize(header.size);
+  Core::DisplayMessage("Decompressing State...", 500);
 
-    lzo_uint i = 0;
-    while (true)
-    {
-      lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
+  Common::Timer timer;
+  timer.Start();
 
-      if (!f.ReadArray(&cur_len, 1))
-        break;
-
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
-      if (res != LZO_E_OK)
-      {
-        // This doesn't seem to happen anymore.
-        PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
-                       "Try loading the state again",
-                       res, i, new_len);
-        return;
-      }
+  ret_data.buffer.resize(header.size);
 
-      i += new_len;
-    }
-  }
-  else  // uncompressed
+  bool success = false;
+  switch (header.compression)
   {
-    const auto size = static_cast<size_t>(f.GetSize() - sizeof(StateHeader));
-    buffer.resize(size);
-
-    if (!f.ReadBytes(&buffer[0], size))
-    {
-      PanicAlertFmt("Error reading bytes: {0}", size);
-      return;
-    }
+  case CompressionMethod::LZO:
+    success = ReadLZOCompressedState(contents, ret_data.buffer);
+    break;
+  case CompressionMethod::Zstd:
+    success = ReadZstdCompressedState(contents, ret_data.buffer);
+    break;
+  default:
+    Core::DisplayMessage("State uses an unsupported compression method", 2000);
+    break;
   }
+  if (!success)
+    return false;
+
+  INFO_LOG_FMT(CORE, "Decompressed {} byte state in {} ms", ret_data.buffer.size(),
+               timer.ElapsedMs());
 
-  // all good
-  ret_data.swap(buffer);
+  // The compressed data isn't needed anymore.
+  ret_data.file.Close();
+  ret_data.data = ret_data.buffer;
+  return true;
 }
 
 void LoadAs(const std::string& filename)
@@ -618,6 +995,12 @@ void LoadAs(const std::string& filename)
   if (!lk)
     return;
 
+  // Reading and decompressing the state doesn't depend on the emulated state, so it's started
+  // right away and happens while the CPU thread is being paused and the undo state is saved.
+  StateFileData state_data;
+  std::future<bool> state_data_loaded =
+      std::async(std::launch::async, [&] { return LoadFileStateData(filename, state_data); });
+
   Core::RunOnCPUThread(
       [&] {
         // Save temp buffer for undo load state
@@ -635,21 +1018,21 @@ void LoadAs(const std::string& filename)
         bool loaded = false;
         bool loadedSuccessfully = false;
 
-        // brackets here are so buffer gets freed ASAP
+        if (state_data_loaded.get())
         {
-          std::vector<u8> buffer;
-          LoadFileStateData(filename, buffer);
-
-          if (!buffer.empty())
-          {
-            u8* ptr = buffer.data();
-            PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-            DoState(p);
-            loaded = true;
-            loadedSuccessfully = p.IsReadMode();
-          }
+          // PointerWrap never writes to the buffer in read mode, so this is safe even for a
+          // read-only mapping.
+          u8* ptr = const_cast<u8*>(state_data.data.data());
+          PointerWrap p(&ptr, state_data.data.size(), PointerWrap::Mode::Read);
+          DoState(p);
+          loaded = true;
+          loadedSuccessfully = p.IsReadMode();
         }
 
+        // Free the buffer or unmap the file as soon as possible.
+        state_data.buffer = {};
+        state_data.file.Close();
+
         if (loaded)
         {
           if (loadedSuccessfully)
@@ -698,6 +1081,26 @@ void Init()
     if (args.state_write_done_event)
       args.state_write_done_event->Set();
   });
+
+  {
+    std::lock_guard lk(s_state_history_mutex);
+    s_state_history = std::make_unique<StateHistory>(
+        STATE_HISTORY_MAX_STATES, STATE_HISTORY_KEYFRAME_INTERVAL,
+        static_cast<size_t>(std::max(Config::Get(Config::MAIN_REWIND_MEMORY_BUDGET), 1)) << 20,
+        STATE_HISTORY_COMPRESSION_LEVEL);
+  }
+  s_history_buffer_size = 0;
+  s_history_interval = Config::Get(Config::MAIN_REWIND_ENABLE) ?
+                           std::max(Config::Get(Config::MAIN_REWIND_INTERVAL), 1) :
+                           0;
+  s_fields_since_snapshot = 0;
+  s_history_snapshot_queued = false;
+
+  s_history_thread.Reset([](HistorySnapshot snapshot) {
+    std::lock_guard lk(s_state_history_mutex);
+    if (s_state_history && snapshot.generation == s_history_generation)
+      s_state_history->Push(std::move(snapshot.buffer));
+  });
 }
 
 void Shutdown()
@@ -712,6 +1115,29 @@ void Shutdown()
     std::lock_guard lk(s_undo_load_buffer_mutex);
     std::vector<u8>().swap(s_undo_load_buffer);
   }
+
+  s_history_thread.Cancel();
+  s_history_interval = 0;
+
+  {
+    std::lock_guard lk(s_fast_state_stats_mutex);
+    if (s_fast_state_stats.count != 0)
+    {
+      INFO_LOG_FMT(CORE,
+                   "Fast states for {}: {} taken, {} us on average, {} us at most, {} over the {} "
+                   "us budget",
+                   SConfig::GetInstance().GetGameID(), s_fast_state_stats.count,
+                   s_fast_state_stats.total_us / s_fast_state_stats.count,
+                   s_fast_state_stats.max_us, s_fast_state_stats.over_budget_count,
+                   FAST_STATE_BUDGET_US);
+    }
+    s_fast_state_stats = {};
+  }
+
+  {
+    std::lock_guard lk(s_state_history_mutex);
+    s_state_history.reset();
+  }
 }
 
 static std::string MakeStateFilename(int number)
@@ -17,10 +17,19 @@ namespace State
 // number of states
 static const u32 NUM_STATES = 10;
 
+// Stored in StateHeader, so values must not change.
+enum class CompressionMethod : u16
+{
+  // 128 KiB LZO1X blocks. Used by all states made before the compression method was stored.
+  LZO = 0,
+  // Independently compressed zstd chunks, so they can be compressed and decompressed in parallel.
+  Zstd = 1,
+};
+
 struct StateHeader
 {
   char gameID[6];
-  u16 reserved1;
+  CompressionMethod compression;  // Only meaningful if size is non-zero
   u32 size;
   u32 reserved2;
   double time;
@@ -59,6 +68,37 @@ void LoadAs(const std::string& filename);
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 
+// Fast in-memory states, meant to be taken every frame for NetPlay rollback. They leave out the
+// EFB and texture cache contents so that nothing has to be read back from the GPU, and reuse the
+// size of buffer's previous contents to skip measuring the state. Unlike LoadFromBuffer, loading
+// is allowed during NetPlay. Keeping several of them in a StateHistory stores all but the
+// keyframes as deltas of the pages that changed.
+constexpr u64 FAST_STATE_BUDGET_US = 2000;
+struct FastStateStats
+{
+  u64 count = 0;
+  u64 total_us = 0;
+  u64 max_us = 0;
+  u64 over_budget_count = 0;
+};
+void SaveToFastBuffer(std::vector<u8>& buffer);
+void LoadFromFastBuffer(std::vector<u8>& buffer);
+// Timings of the fast states taken for the running game. They are also logged when it stops.
+FastStateStats GetFastStateStats();
+
+// Keeps the current state in an in-memory history of recent states, most of which are stored as
+// compressed deltas against a recent full state (see StateHistory). Only the serialization
+// happens on the CPU thread; the rest is done in the background.
+void SaveToHistory();
+// Loads the state saved age calls to SaveToHistory ago. Returns false if there is no such state.
+bool LoadFromHistory(size_t age);
+
+// Called by Core at every video field, to take the automatic snapshots used for rewinding.
+void OnNewField();
+// Loads the most recent snapshot and removes it from the history, so that calling this again
+// steps further back.
+bool Rewind();
+
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
 void UndoSaveState();
@@ -0,0 +1,243 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateDelta.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <zstd.h>
+
+namespace State
+{
+namespace
+{
+// A delta is a DeltaHeader followed by num_runs DeltaRuns, each directly followed by its data.
+struct DeltaHeader
+{
+  u64 base_size;
+  u64 state_size;
+  u64 num_runs;
+};
+
+// size bytes of the state starting at offset, which differ from the base.
+struct DeltaRun
+{
+  u64 offset;
+  u64 size;
+};
+
+template <typename T>
+void Append(std::vector<u8>* out, const T& value)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(&value);
+  out->insert(out->end(), bytes, bytes + sizeof(T));
+}
+
+bool PageDiffers(std::span<const u8> base, std::span<const u8> state, size_t offset)
+{
+  const size_t size = std::min(DELTA_PAGE_SIZE, state.size() - offset);
+  if (offset + size > base.size())
+    return true;
+
+  return std::memcmp(base.data() + offset, state.data() + offset, size) != 0;
+}
+}  // namespace
+
+std::vector<u8> CreateDelta(std::span<const u8> base, std::span<const u8> state)
+{
+  std::vector<u8> delta(sizeof(DeltaHeader));
+  u64 num_runs = 0;
+
+  size_t offset = 0;
+  while (offset < state.size())
+  {
+    if (!PageDiffers(base, state, offset))
+    {
+      offset += DELTA_PAGE_SIZE;
+      continue;
+    }
+
+    // Neighbouring changed pages are stored as one run.
+    size_t end = offset + DELTA_PAGE_SIZE;
+    while (end < state.size() && PageDiffers(base, state, end))
+      end += DELTA_PAGE_SIZE;
+    end = std::min(end, state.size());
+
+    Append(&delta, DeltaRun{offset, end - offset});
+    delta.insert(delta.end(), state.begin() + offset, state.begin() + end);
+    num_runs++;
+    offset = end;
+  }
+
+  const DeltaHeader header{base.size(), state.size(), num_runs};
+  std::memcpy(delta.data(), &header, sizeof(header));
+  return delta;
+}
+
+bool ApplyDelta(std::span<const u8> base, std::span<const u8> delta, std::vector<u8>* state)
+{
+  DeltaHeader header;
+  if (delta.size() < sizeof(header))
+    return false;
+
+  std::memcpy(&header, delta.data(), sizeof(header));
+  if (header.base_size != base.size())
+    return false;
+
+  state->resize(header.state_size);
+  std::copy_n(base.begin(), std::min<u64>(base.size(), header.state_size), state->begin());
+
+  size_t position = sizeof(header);
+  for (u64 i = 0; i < header.num_runs; i++)
+  {
+    DeltaRun run;
+    if (delta.size() - position < sizeof(run))
+      return false;
+
+    std::memcpy(&run, delta.data() + position, sizeof(run));
+    position += sizeof(run);
+    if (run.offset > header.state_size || run.size > header.state_size - run.offset ||
+        run.size > delta.size() - position)
+    {
+      return false;
+    }
+
+    std::memcpy(state->data() + run.offset, delta.data() + position, run.size);
+    position += run.size;
+  }
+
+  return position == delta.size();
+}
+
+StateHistory::StateHistory(size_t max_states, size_t keyframe_interval, size_t memory_budget,
+                           std::optional<int> compression_level)
+    : m_max_states(std::max<size_t>(max_states, 1)),
+      m_keyframe_interval(std::max<size_t>(keyframe_interval, 1)), m_memory_budget(memory_budget),
+      m_compression_level(compression_level)
+{
+}
+
+std::vector<u8> StateHistory::Compress(std::span<const u8> data) const
+{
+  // This can only fail if memory runs out, which Decompress then reports when the state is used.
+  std::vector<u8> compressed(ZSTD_compressBound(data.size()));
+  const size_t size = ZSTD_compress(compressed.data(), compressed.size(), data.data(),
+                                    data.size(), *m_compression_level);
+  compressed.resize(ZSTD_isError(size) ? 0 : size);
+  return compressed;
+}
+
+bool StateHistory::Decompress(std::span<const u8> data, std::vector<u8>* out) const
+{
+  if (!m_compression_level)
+  {
+    out->assign(data.begin(), data.end());
+    return true;
+  }
+
+  const unsigned long long size = ZSTD_getFrameContentSize(data.data(), data.size());
+  if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR)
+    return false;
+
+  out->resize(size);
+  return ZSTD_decompress(out->data(), out->size(), data.data(), data.size()) == size;
+}
+
+void StateHistory::Push(std::vector<u8> state)
+{
+  if (!m_last_keyframe || m_states_since_keyframe + 1 >= m_keyframe_interval)
+  {
+    auto keyframe = std::make_shared<const std::vector<u8>>(std::move(state));
+    auto stored = m_compression_level ?
+                      std::make_shared<const std::vector<u8>>(Compress(*keyframe)) :
+                      keyframe;
+    m_entries.push_back({std::move(stored), {}});
+    m_last_keyframe = std::move(keyframe);
+    m_states_since_keyframe = 0;
+  }
+  else
+  {
+    std::vector<u8> delta = CreateDelta(*m_last_keyframe, state);
+    if (m_compression_level)
+      delta = Compress(delta);
+    m_entries.push_back({m_entries.back().keyframe, std::move(delta)});
+    m_states_since_keyframe++;
+  }
+
+  DropOldStates();
+}
+
+bool StateHistory::PopNewest(std::vector<u8>* state)
+{
+  if (!Get(0, state))
+    return false;
+
+  // New deltas can only be created against the keyframe if it's still in the history.
+  if (m_entries.back().delta.empty())
+    m_last_keyframe.reset();
+  else
+    m_states_since_keyframe--;
+
+  m_entries.pop_back();
+  if (m_entries.empty())
+    Clear();
+  return true;
+}
+
+void StateHistory::DropOldStates()
+{
+  // Old keyframes are freed once no entry refers to them anymore.
+  while (m_entries.size() > m_max_states ||
+         (m_memory_budget != 0 && m_entries.size() > 1 && GetMemoryUsage() > m_memory_budget))
+  {
+    m_entries.pop_front();
+  }
+}
+
+void StateHistory::Clear()
+{
+  m_entries.clear();
+  m_last_keyframe.reset();
+  m_states_since_keyframe = 0;
+}
+
+size_t StateHistory::GetMemoryUsage() const
+{
+  size_t usage = 0;
+  const std::vector<u8>* last_keyframe = nullptr;
+  for (const Entry& entry : m_entries)
+  {
+    usage += entry.delta.size();
+    if (entry.keyframe.get() != last_keyframe)
+    {
+      usage += entry.keyframe->size();
+      last_keyframe = entry.keyframe.get();
+    }
+  }
+
+  if (m_compression_level && m_last_keyframe)
+    usage += m_last_keyframe->size();
+
+  return usage;
+}
+
+bool StateHistory::Get(size_t age, std::vector<u8>* state) const
+{
+  if (age >= m_entries.size())
+    return false;
+
+  const Entry& entry = m_entries[m_entries.size() - 1 - age];
+  if (entry.delta.empty())
+    return Decompress(*entry.keyframe, state);
+
+  if (!m_compression_level)
+    return ApplyDelta(*entry.keyframe, entry.delta, state);
+
+  std::vector<u8> keyframe;
+  std::vector<u8> delta;
+  return Decompress(*entry.keyframe, &keyframe) && Decompress(entry.delta, &delta) &&
+         ApplyDelta(keyframe, delta, state);
+}
+}  // namespace State
@@ -0,0 +1,76 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+// Savestates are compared in pages of this size. MEM1 and MEM2 make up most of a state, and games
+// only write to a small part of them between two states that are a few seconds apart.
+constexpr size_t DELTA_PAGE_SIZE = 0x1000;
+
+// Returns a delta that turns base into state, storing only the pages of state that differ from
+// base. Both are buffers from State::SaveToBuffer.
+std::vector<u8> CreateDelta(std::span<const u8> base, std::span<const u8> state);
+
+// Rebuilds a state from the base the delta was created against. Returns false if the delta is
+// damaged or was created against a base of a different size.
+bool ApplyDelta(std::span<const u8> base, std::span<const u8> delta, std::vector<u8>* state);
+
+// Keeps the most recent states in memory, for rewinding or frequent autosaves. Every
+// keyframe_interval-th state is kept whole as a keyframe, and the others only as deltas against
+// the keyframe before them, so restoring any state takes a single ApplyDelta.
+//
+// If a zstd compression level is given, keyframes and deltas are stored compressed. The oldest
+// states are dropped once there are more than max_states, or once they use more than
+// memory_budget bytes (if it isn't 0).
+class StateHistory final
+{
+public:
+  StateHistory(size_t max_states, size_t keyframe_interval, size_t memory_budget = 0,
+               std::optional<int> compression_level = std::nullopt);
+
+  void Push(std::vector<u8> state);
+  // Removes the most recently pushed state and returns it in state.
+  bool PopNewest(std::vector<u8>* state);
+  void Clear();
+
+  size_t GetSize() const { return m_entries.size(); }
+  // Bytes used by keyframes and deltas, including the uncompressed copy of the latest keyframe
+  // that new deltas are created against.
+  size_t GetMemoryUsage() const;
+
+  // age 0 is the most recently pushed state. Returns false if there is no such state.
+  bool Get(size_t age, std::vector<u8>* state) const;
+
+private:
+  struct Entry
+  {
+    std::shared_ptr<const std::vector<u8>> keyframe;
+    // Empty if this entry is the keyframe itself.
+    std::vector<u8> delta;
+  };
+
+  std::vector<u8> Compress(std::span<const u8> data) const;
+  bool Decompress(std::span<const u8> data, std::vector<u8>* out) const;
+  void DropOldStates();
+
+  size_t m_max_states;
+  size_t m_keyframe_interval;
+  size_t m_memory_budget;
+  std::optional<int> m_compression_level;
+  size_t m_states_since_keyframe = 0;
+  std::deque<Entry> m_entries;
+  // The latest keyframe as it was pushed. Shared with its entry if there's no compression.
+  std::shared_ptr<const std::vector<u8>> m_last_keyframe;
+};
+}  // namespace State
@@ -192,14 +192,22 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename);
 
 using CompressCB = std::function<bool(const std::string& text, float percent)>;
 
+// compression_threads limits how many threads compress at once, e.g. when converting several
+// discs at the same time. 0 uses one thread per hardware thread.
+// infile_path may be empty if infile can't be opened by path, such as a StreamBlobReader. WIA and
+// RVZ then store the disc without looking at its partitions and file systems, which compresses
+// Wii discs much worse, since their partitions are kept encrypted.
+// zstd_dictionary makes RVZ files using Zstandard share a dictionary built from the disc between
+// all chunks, which helps small chunk sizes. Such files need Dolphin with RVZ 1.1 support.
 bool ConvertToGCZ(BlobReader* infile, const std::string& infile_path,
                   const std::string& outfile_path, u32 sub_type, int sector_size,
-                  CompressCB callback);
+                  CompressCB callback, unsigned int compression_threads = 0);
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
                     const std::string& outfile_path, CompressCB callback);
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback);
+                       int chunk_size, CompressCB callback,
+                       unsigned int compression_threads = 0, bool zstd_dictionary = false);
 
 }  // namespace DiscIO
@@ -28,6 +28,7 @@
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/MultithreadedCompressor.h"
+#include "DiscIO/ReadAheadReader.h"
 #include "DiscIO/Volume.h"
 
 namespace DiscIO
@@ -271,7 +272,7 @@ static ConversionResultCode Output(OutputParameters parameters, File::IOFile* ou
 
 bool ConvertToGCZ(BlobReader* infile, const std::string& infile_path,
                   const std::string& outfile_path, u32 sub_type, int block_size,
-                  CompressCB callback)
+                  CompressCB callback, unsigned int compression_threads)
 {
   ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
 
@@ -323,23 +324,29 @@ bool ConvertToGCZ(BlobReader* infile, const std::string& infile_path,
   };
 
   MultithreadedCompressor<CompressThreadState, CompressParameters, OutputParameters> compressor(
-      SetUpCompressThreadState, compress, output);
+      SetUpCompressThreadState, compress, output, compression_threads);
 
-  std::vector<u8> in_buf(block_size);
+  std::vector<ReadAheadReader::Range> ranges(header.num_blocks);
+  for (u32 i = 0; i < header.num_blocks; i++)
+  {
+    const u64 offset = static_cast<u64>(i) * block_size;
+    ranges[i] = {offset, std::min<u64>(block_size, header.data_size - offset)};
+  }
+  ReadAheadReader reader(infile, std::move(ranges));
+
+  std::vector<u8> in_buf;
   for (u32 i = 0; i < header.num_blocks; i++)
   {
     if (compressor.GetStatus() != ConversionResultCode::Success)
       break;
 
-    const u64 bytes_to_read = std::min<u64>(block_size, header.data_size - inpos);
-
-    if (!infile->Read(inpos, bytes_to_read, in_buf.data()))
+    if (!reader.GetNext(&in_buf))
     {
       compressor.SetError(ConversionResultCode::ReadFailed);
       break;
     }
 
-    std::fill(in_buf.begin() + bytes_to_read, in_buf.begin() + header.block_size, 0);
+    in_buf.resize(block_size, 0);
 
     inpos += block_size;
 
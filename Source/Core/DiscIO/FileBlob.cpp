@@ -4,20 +4,96 @@
 #include "DiscIO/FileBlob.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#ifdef _WIN32
+#include <Windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 namespace DiscIO
 {
+// How far ahead of sequential reads the OS is asked to read in mapped files. DVDThread reads
+// at most a few blocks at a time, which is too little for the OS to keep fast storage busy.
+constexpr u64 MAPPED_READ_AHEAD_SIZE = 0x400000;
+
 PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
+  MapFile();
+}
+
+PlainFileReader::~PlainFileReader()
+{
+  if (!m_mapped_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_mapped_data);
+#else
+  munmap(const_cast<u8*>(m_mapped_data), static_cast<size_t>(m_size));
+#endif
+}
+
+void PlainFileReader::MapFile()
+{
+  // Disc images don't fit in a 32-bit address space alongside everything else.
+  if (sizeof(void*) < 8 || m_size <= 0)
+    return;
+
+#ifdef _WIN32
+  const HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file.GetHandle())));
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping)
+    return;
+
+  // The view keeps the mapping alive.
+  void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!view)
+    return;
+#else
+  void* const view = mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_SHARED,
+                          fileno(m_file.GetHandle()), 0);
+  if (view == MAP_FAILED)
+    return;
+
+  // Reads are mostly sequential, so let the OS read ahead more aggressively.
+  madvise(view, static_cast<size_t>(m_size), MADV_SEQUENTIAL);
+#endif
+
+  m_mapped_data = static_cast<const u8*>(view);
+  INFO_LOG_FMT(DISCIO, "Memory-mapped disc image of {} bytes", m_size);
+}
+
+void PlainFileReader::PrefetchMapped(u64 offset)
+{
+#ifndef _WIN32
+  // Only ask once per window, so that most reads don't need a syscall at all.
+  if (offset >= m_prefetched_from && offset + MAPPED_READ_AHEAD_SIZE / 2 < m_prefetched_until)
+    return;
+
+  // madvise needs a page-aligned address.
+  const u64 start = offset & ~u64{0xFFF};
+  const u64 end = std::min<u64>(offset + MAPPED_READ_AHEAD_SIZE, m_size);
+  if (start >= end)
+    return;
+
+  madvise(const_cast<u8*>(m_mapped_data) + start, end - start, MADV_WILLNEED);
+  m_prefetched_from = start;
+  m_prefetched_until = end;
+#endif
 }
 
 std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
@@ -30,6 +106,16 @@ std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
+  if (m_mapped_data)
+  {
+    if (offset > static_cast<u64>(m_size) || nbytes > static_cast<u64>(m_size) - offset)
+      return false;
+
+    PrefetchMapped(offset + nbytes);
+    std::memcpy(out_ptr, m_mapped_data + offset, nbytes);
+    return true;
+  }
+
   if (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadBytes(out_ptr, nbytes))
   {
     return true;
@@ -17,6 +17,7 @@ class PlainFileReader : public BlobReader
 {
 public:
   static std::unique_ptr<PlainFileReader> Create(File::IOFile file);
+  ~PlainFileReader();
 
   BlobType GetBlobType() const override { return BlobType::PLAIN; }
 
@@ -34,8 +35,18 @@ public:
 private:
   PlainFileReader(File::IOFile file);
 
+  void MapFile();
+  void PrefetchMapped(u64 offset);
+
   File::IOFile m_file;
   s64 m_size;
+
+  // The whole file is mapped where possible, so that reads are a memcpy from the page cache
+  // instead of a seek and a read syscall each. nullptr if the file is read through m_file.
+  const u8* m_mapped_data = nullptr;
+  // The range the OS was last asked to read in ahead of time.
+  u64 m_prefetched_from = 0;
+  u64 m_prefetched_until = 0;
 };
 
 }  // namespace DiscIO
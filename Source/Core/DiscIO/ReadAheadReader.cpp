@@ -0,0 +1,71 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/ReadAheadReader.h"
+
+#include <utility>
+
+#include "Common/Thread.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+ReadAheadReader::ReadAheadReader(BlobReader* reader, std::vector<Range> ranges,
+                                 size_t max_ranges_ahead)
+    : m_reader(reader), m_ranges(std::move(ranges)), m_max_ranges_ahead(max_ranges_ahead)
+{
+  m_thread = std::thread(&ReadAheadReader::ThreadFunction, this);
+}
+
+ReadAheadReader::~ReadAheadReader()
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_shutting_down = true;
+  }
+  m_result_taken.notify_one();
+  m_thread.join();
+}
+
+bool ReadAheadReader::GetNext(std::vector<u8>* buffer)
+{
+  std::unique_lock lk(m_mutex);
+  m_read_done.wait(lk, [this] { return !m_results.empty(); });
+
+  Result result = std::move(m_results.front());
+  m_results.pop_front();
+  lk.unlock();
+  m_result_taken.notify_one();
+
+  *buffer = std::move(result.data);
+  return result.success;
+}
+
+void ReadAheadReader::ThreadFunction()
+{
+  Common::SetCurrentThreadName("Disc read-ahead");
+
+  for (const Range& range : m_ranges)
+  {
+    {
+      std::unique_lock lk(m_mutex);
+      m_result_taken.wait(
+          lk, [this] { return m_shutting_down || m_results.size() < m_max_ranges_ahead; });
+      if (m_shutting_down)
+        return;
+    }
+
+    std::vector<u8> data(range.size);
+    const bool success = m_reader->Read(range.offset, range.size, data.data());
+
+    {
+      std::lock_guard lk(m_mutex);
+      m_results.push_back(Result{std::move(data), success});
+    }
+    m_read_done.notify_one();
+
+    if (!success)
+      return;
+  }
+}
+}  // namespace DiscIO
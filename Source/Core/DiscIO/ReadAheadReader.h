@@ -0,0 +1,63 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+class BlobReader;
+
+// Reads a list of ranges from a BlobReader in order on a separate thread, staying up to
+// max_ranges_ahead ranges ahead of the caller, so that reading the disc overlaps with processing
+// the data that was already read. The BlobReader must not be used by anything else until the
+// ReadAheadReader is destroyed.
+class ReadAheadReader
+{
+public:
+  struct Range
+  {
+    u64 offset;
+    u64 size;
+  };
+
+  ReadAheadReader(BlobReader* reader, std::vector<Range> ranges, size_t max_ranges_ahead = 4);
+  ~ReadAheadReader();
+
+  ReadAheadReader(const ReadAheadReader&) = delete;
+  ReadAheadReader& operator=(const ReadAheadReader&) = delete;
+
+  // Waits for the next range and moves its data into buffer. Returns false if reading it failed,
+  // in which case nothing after it is read either.
+  bool GetNext(std::vector<u8>* buffer);
+
+private:
+  struct Result
+  {
+    std::vector<u8> data;
+    bool success;
+  };
+
+  void ThreadFunction();
+
+  BlobReader* m_reader;
+  std::vector<Range> m_ranges;
+  size_t m_max_ranges_ahead;
+
+  std::mutex m_mutex;
+  std::condition_variable m_read_done;
+  std::condition_variable m_result_taken;
+  std::deque<Result> m_results;
+  bool m_shutting_down = false;
+
+  std::thread m_thread;
+};
+}  // namespace DiscIO
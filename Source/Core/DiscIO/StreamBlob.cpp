@@ -0,0 +1,88 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/StreamBlob.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Common/Logging/Log.h"
+
+namespace DiscIO
+{
+StreamBlobReader::StreamBlobReader(File::IOFile file, u64 size)
+    : m_file(std::move(file)), m_size(size)
+{
+}
+
+std::unique_ptr<StreamBlobReader> StreamBlobReader::Create(File::IOFile file, u64 size)
+{
+  if (!file || size == 0)
+    return nullptr;
+
+  // Can't use make_unique due to private constructor.
+  std::unique_ptr<StreamBlobReader> reader(new StreamBlobReader(std::move(file), size));
+
+  reader->m_head.resize(std::min(HEAD_SIZE, size));
+  if (!reader->ReadFromStream(0, reader->m_head.size(), reader->m_head.data()))
+    return nullptr;
+
+  return reader;
+}
+
+bool StreamBlobReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (offset > m_size || size > m_size - offset)
+    return false;
+
+  if (offset < m_head.size())
+  {
+    const u64 head_bytes = std::min(size, m_head.size() - offset);
+    std::memcpy(out_ptr, m_head.data() + offset, head_bytes);
+    offset += head_bytes;
+    size -= head_bytes;
+    out_ptr += head_bytes;
+  }
+
+  if (size == 0)
+    return true;
+
+  if (offset < m_position)
+  {
+    ERROR_LOG_FMT(DISCIO, "Stream read at {:#x} is before the current position {:#x}", offset,
+                  m_position);
+    return false;
+  }
+
+  return ReadFromStream(offset, size, out_ptr);
+}
+
+bool StreamBlobReader::ReadFromStream(u64 offset, u64 size, u8* out_ptr)
+{
+  // Data that nothing asked for is read and thrown away, as the stream can't seek.
+  if (m_position < offset)
+  {
+    std::vector<u8> skipped(std::min<u64>(offset - m_position, 0x100000));
+    while (m_position < offset)
+    {
+      const u64 bytes_to_skip = std::min<u64>(offset - m_position, skipped.size());
+      if (!m_file.ReadBytes(skipped.data(), bytes_to_skip))
+        return false;
+      m_position += bytes_to_skip;
+    }
+  }
+
+  if (!m_file.ReadBytes(out_ptr, size))
+  {
+    ERROR_LOG_FMT(DISCIO, "Stream ended early at {:#x}", m_position);
+    return false;
+  }
+
+  m_position += size;
+  return true;
+}
+
+}  // namespace DiscIO
@@ -0,0 +1,55 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+// Reads a plain disc image from a source that can only be read once from start to end, such as
+// a pipe from a download, so that it can be converted without being stored on disk first.
+// Its size must be known up front, as nothing in a plain disc image says how big it is.
+//
+// Reads must be at or after the end of the previous read. The only exception is the start of
+// the disc, which is kept so that the disc header and partition table can be read again.
+class StreamBlobReader final : public BlobReader
+{
+public:
+  static std::unique_ptr<StreamBlobReader> Create(File::IOFile file, u64 size);
+
+  BlobType GetBlobType() const override { return BlobType::PLAIN; }
+
+  u64 GetRawSize() const override { return m_size; }
+  u64 GetDataSize() const override { return m_size; }
+  DataSizeType GetDataSizeType() const override { return DataSizeType::Accurate; }
+
+  u64 GetBlockSize() const override { return 0; }
+  bool HasFastRandomAccessInBlock() const override { return false; }
+  std::string GetCompressionMethod() const override { return {}; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+private:
+  // Covers the disc header and the Wii partition table.
+  static constexpr u64 HEAD_SIZE = 0x50000;
+
+  StreamBlobReader(File::IOFile file, u64 size);
+
+  bool ReadFromStream(u64 offset, u64 size, u8* out_ptr);
+
+  File::IOFile m_file;
+  u64 m_size;
+  u64 m_position = 0;
+  std::vector<u8> m_head;
+};
+
+}  // namespace DiscIO
@@ -10,6 +10,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 #include <mbedtls/md5.h>
@@ -357,7 +358,18 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
   return {Status::Unknown, Common::GetStringT("Unknown disc")};
 }
 
-constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
+// Big enough for the hashing of each chunk to be split across threads. Also the size of a group.
+constexpr u64 DEFAULT_READ_SIZE = VolumeWii::GROUP_TOTAL_SIZE;
+
+// Smaller pieces aren't worth the overhead of hashing on another thread.
+constexpr u64 MIN_PARALLEL_CRC32_SIZE = 0x40000;
+constexpr size_t MIN_PARALLEL_BLOCKS = 8;
+
+static size_t GetHashingThreadCount(u64 work, u64 min_work_per_thread)
+{
+  const size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  return static_cast<size_t>(std::clamp<u64>(work / min_work_per_thread, 1, threads));
+}
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
@@ -1206,8 +1218,7 @@ void VolumeVerifier::Process()
     if (m_hashes_to_calculate.crc32)
     {
       m_crc32_future = std::async(std::launch::async, [this, byte_increment] {
-        m_crc32_context = Common::UpdateCRC32(m_crc32_context, m_data.data(),
-                                              static_cast<size_t>(byte_increment));
+        m_crc32_context = UpdateCRC32InParallel(m_crc32_context, byte_increment);
       });
     }
 
@@ -1240,36 +1251,10 @@ void VolumeVerifier::Process()
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
-
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
-        {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
-        }
-      }
-    });
+    m_group_future =
+        std::async(std::launch::async, [this, read_failed, group_index = m_group_index] {
+          VerifyGroup(group_index, read_failed);
+        });
 
     m_group_index++;
   }
@@ -1277,6 +1262,89 @@ void VolumeVerifier::Process()
   m_progress += byte_increment;
 }
 
+u32 VolumeVerifier::UpdateCRC32InParallel(u32 crc, u64 size) const
+{
+  const size_t threads = GetHashingThreadCount(size, MIN_PARALLEL_CRC32_SIZE);
+  if (threads == 1)
+    return Common::UpdateCRC32(crc, m_data.data(), static_cast<size_t>(size));
+
+  // Each piece is hashed from scratch, and the results are then combined in order.
+  std::vector<std::future<u32>> crc32_futures(threads);
+  for (size_t i = 0; i < threads; ++i)
+  {
+    const u64 start = i * size / threads;
+    const u64 end = (i + 1) * size / threads;
+    crc32_futures[i] = std::async(std::launch::async, [this, start, end] {
+      return Common::ComputeCRC32(m_data.data() + start, static_cast<size_t>(end - start));
+    });
+  }
+
+  for (size_t i = 0; i < threads; ++i)
+  {
+    const u64 piece_size = (i + 1) * size / threads - i * size / threads;
+    crc = Common::CombineCRC32(crc, crc32_futures[i].get(), piece_size);
+  }
+
+  return crc;
+}
+
+void VolumeVerifier::VerifyGroup(size_t group_index, bool read_failed)
+{
+  const GroupToVerify& group = m_groups[group_index];
+  const size_t blocks = group.block_index_end - group.block_index_start;
+
+  // The blocks are checked in parallel, but the results are tallied here so that the error
+  // counts and the verified offset are only touched by one thread.
+  std::vector<u8> block_ok(blocks, false);
+  if (!read_failed)
+  {
+    const auto check_blocks = [this, &group, &block_ok](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i)
+      {
+        block_ok[i] = m_volume.CheckBlockIntegrity(group.block_index_start + i,
+                                                   m_data.data() + i * VolumeWii::BLOCK_TOTAL_SIZE,
+                                                   group.partition);
+      }
+    };
+
+    const size_t threads = GetHashingThreadCount(blocks, MIN_PARALLEL_BLOCKS);
+    std::vector<std::future<void>> block_futures(threads - 1);
+    for (size_t i = 1; i < threads; ++i)
+    {
+      block_futures[i - 1] = std::async(std::launch::async, check_blocks, i * blocks / threads,
+                                        (i + 1) * blocks / threads);
+    }
+    check_blocks(0, blocks / threads);
+
+    for (std::future<void>& future : block_futures)
+      future.get();
+  }
+
+  for (size_t i = 0; i < blocks; ++i)
+  {
+    const u64 block_offset = group.offset + i * VolumeWii::BLOCK_TOTAL_SIZE;
+
+    if (block_ok[i])
+    {
+      m_biggest_verified_offset =
+          std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
+    }
+    else
+    {
+      if (m_scrubber.CanBlockBeScrubbed(block_offset))
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
+        m_unused_block_errors[group.partition]++;
+      }
+      else
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+        m_block_errors[group.partition]++;
+      }
+    }
+  }
+}
+
 u64 VolumeVerifier::GetBytesProcessed() const
 {
   return m_progress;
@@ -158,6 +158,8 @@ private:
   void SetUpHashing();
   void WaitForAsyncOperations() const;
   bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  u32 UpdateCRC32InParallel(u32 crc, u64 size) const;
+  void VerifyGroup(size_t group_index, bool read_failed);
 
   void AddProblem(Severity severity, std::string text);
 
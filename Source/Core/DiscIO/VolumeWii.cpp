@@ -36,8 +36,7 @@
 namespace DiscIO
 {
 VolumeWii::VolumeWii(std::unique_ptr<BlobReader> reader)
-    : m_reader(std::move(reader)), m_game_partition(PARTITION_NONE),
-      m_last_decrypted_block(UINT64_MAX)
+    : m_reader(std::move(reader)), m_game_partition(PARTITION_NONE)
 {
   ASSERT(m_reader);
 
@@ -185,51 +184,43 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
     return m_reader->Read(partition_data_offset + offset, length, buffer);
   }
 
-  Common::AES::Context* aes_context = nullptr;
-  std::unique_ptr<u8[]> read_buffer = nullptr;
+  const Common::AES::Context* aes_context = nullptr;
   if (m_has_encryption)
   {
     aes_context = partition_details.key->get();
     if (!aes_context)
       return false;
-
-    read_buffer = std::make_unique<u8[]>(BLOCK_TOTAL_SIZE);
   }
 
+  std::vector<u8> read_buffer;
   while (length > 0)
   {
     // Calculate offsets
     u64 block_offset_on_disc = partition_data_offset + offset / BLOCK_DATA_SIZE * BLOCK_TOTAL_SIZE;
     u64 data_offset_in_block = offset % BLOCK_DATA_SIZE;
 
-    if (m_last_decrypted_block != block_offset_on_disc)
+    // Decrypt runs of whole blocks straight into the buffer, reading them all at once
+    if (data_offset_in_block == 0 && length >= BLOCK_DATA_SIZE &&
+        !FindDecryptedBlock(block_offset_on_disc))
     {
-      if (m_has_encryption)
-      {
-        // Read the current block
-        if (!m_reader->Read(block_offset_on_disc, BLOCK_TOTAL_SIZE, read_buffer.get()))
-          return false;
-
-        // Decrypt the block's data
-        DecryptBlockData(read_buffer.get(), m_last_decrypted_block_data, aes_context);
-      }
-      else
-      {
-        // Read the current block
-        if (!m_reader->Read(block_offset_on_disc + BLOCK_HEADER_SIZE, BLOCK_DATA_SIZE,
-                            m_last_decrypted_block_data))
-        {
-          return false;
-        }
-      }
-
-      m_last_decrypted_block = block_offset_on_disc;
+      const u64 num_blocks = std::min(length / BLOCK_DATA_SIZE, MAX_BLOCKS_PER_READ);
+      if (!ReadBlocks(block_offset_on_disc, num_blocks, buffer, aes_context, &read_buffer))
+        return false;
+
+      const u64 read_size = num_blocks * BLOCK_DATA_SIZE;
+      length -= read_size;
+      buffer += read_size;
+      offset += read_size;
+      continue;
     }
 
+    const u8* block_data = GetDecryptedBlock(block_offset_on_disc, aes_context, &read_buffer);
+    if (!block_data)
+      return false;
+
     // Copy the decrypted data
     u64 copy_size = std::min(length, BLOCK_DATA_SIZE - data_offset_in_block);
-    memcpy(buffer, &m_last_decrypted_block_data[data_offset_in_block],
-           static_cast<size_t>(copy_size));
+    memcpy(buffer, &block_data[data_offset_in_block], static_cast<size_t>(copy_size));
 
     // Update offsets
     length -= copy_size;
@@ -648,9 +639,92 @@ void VolumeWii::DecryptBlockHashes(const u8* in, HashBlock* out, Common::AES::Co
   aes_context->CryptIvZero(in, reinterpret_cast<u8*>(out), sizeof(HashBlock));
 }
 
-void VolumeWii::DecryptBlockData(const u8* in, u8* out, Common::AES::Context* aes_context)
+void VolumeWii::DecryptBlockData(const u8* in, u8* out, const Common::AES::Context* aes_context)
 {
   aes_context->Crypt(&in[0x3d0], &in[sizeof(HashBlock)], out, BLOCK_DATA_SIZE);
 }
 
+bool VolumeWii::ReadBlocks(u64 block_offset_on_disc, u64 num_blocks, u8* out,
+                           const Common::AES::Context* aes_context,
+                           std::vector<u8>* read_buffer) const
+{
+  read_buffer->resize(num_blocks * BLOCK_TOTAL_SIZE);
+  if (!m_reader->Read(block_offset_on_disc, read_buffer->size(), read_buffer->data()))
+    return false;
+
+  const auto process_blocks = [&](u64 start, u64 end) {
+    for (u64 i = start; i < end; ++i)
+    {
+      const u8* in_ptr = read_buffer->data() + i * BLOCK_TOTAL_SIZE;
+      u8* out_ptr = out + i * BLOCK_DATA_SIZE;
+      if (aes_context)
+        DecryptBlockData(in_ptr, out_ptr, aes_context);
+      else
+        std::memcpy(out_ptr, in_ptr + BLOCK_HEADER_SIZE, BLOCK_DATA_SIZE);
+    }
+  };
+
+  const unsigned int threads = std::min<unsigned int>(
+      num_blocks / MIN_BLOCKS_FOR_PARALLEL_DECRYPTION * 2,
+      std::max<unsigned int>(1, std::thread::hardware_concurrency()));
+  if (!aes_context || threads <= 1)
+  {
+    process_blocks(0, num_blocks);
+    return true;
+  }
+
+  // The first range is decrypted on this thread, while the others are decrypted in parallel.
+  std::vector<std::future<void>> decryption_futures(threads - 1);
+  for (size_t i = 1; i < threads; ++i)
+  {
+    decryption_futures[i - 1] = std::async(std::launch::async, process_blocks,
+                                           i * num_blocks / threads, (i + 1) * num_blocks / threads);
+  }
+  process_blocks(0, num_blocks / threads);
+
+  for (std::future<void>& future : decryption_futures)
+    future.get();
+
+  return true;
+}
+
+VolumeWii::DecryptedBlock* VolumeWii::FindDecryptedBlock(u64 block_offset_on_disc) const
+{
+  if (!m_decrypted_blocks)
+    return nullptr;
+
+  for (DecryptedBlock& block : *m_decrypted_blocks)
+  {
+    if (block.offset_on_disc == block_offset_on_disc)
+      return &block;
+  }
+
+  return nullptr;
+}
+
+const u8* VolumeWii::GetDecryptedBlock(u64 block_offset_on_disc,
+                                       const Common::AES::Context* aes_context,
+                                       std::vector<u8>* read_buffer) const
+{
+  DecryptedBlock* block = FindDecryptedBlock(block_offset_on_disc);
+  if (!block)
+  {
+    if (!m_decrypted_blocks)
+      m_decrypted_blocks = std::make_unique<std::array<DecryptedBlock, DECRYPTED_BLOCK_CACHE_SIZE>>();
+
+    // Replace the least recently used block
+    block = &*std::min_element(
+        m_decrypted_blocks->begin(), m_decrypted_blocks->end(),
+        [](const DecryptedBlock& a, const DecryptedBlock& b) { return a.last_used < b.last_used; });
+
+    block->offset_on_disc = UINT64_MAX;
+    if (!ReadBlocks(block_offset_on_disc, 1, block->data.data(), aes_context, read_buffer))
+      return nullptr;
+    block->offset_on_disc = block_offset_on_disc;
+  }
+
+  block->last_used = ++m_decrypted_block_counter;
+  return block->data.data();
+}
+
 }  // namespace DiscIO
@@ -107,7 +107,7 @@ public:
                                hash_exception_callback = {});
 
   static void DecryptBlockHashes(const u8* in, HashBlock* out, Common::AES::Context* aes_context);
-  static void DecryptBlockData(const u8* in, u8* out, Common::AES::Context* aes_context);
+  static void DecryptBlockData(const u8* in, u8* out, const Common::AES::Context* aes_context);
 
 protected:
   u32 GetOffsetShift() const override { return 2; }
@@ -125,14 +125,39 @@ private:
     u32 type = 0;
   };
 
+  struct DecryptedBlock
+  {
+    u64 offset_on_disc = UINT64_MAX;
+    u64 last_used = 0;
+    std::array<u8, BLOCK_DATA_SIZE> data;
+  };
+
+  // Blocks that are only partially read tend to be read again soon, e.g. when the FST and a
+  // file share a block, or a file is read in pieces. Whole blocks are decrypted straight into
+  // the output instead.
+  static constexpr size_t DECRYPTED_BLOCK_CACHE_SIZE = 8;
+
+  // The most blocks that are read from the blob at once, and the least that are worth
+  // decrypting on several threads.
+  static constexpr u64 MAX_BLOCKS_PER_READ = BLOCKS_PER_GROUP;
+  static constexpr u64 MIN_BLOCKS_FOR_PARALLEL_DECRYPTION = 16;
+
+  bool ReadBlocks(u64 block_offset_on_disc, u64 num_blocks, u8* out,
+                  const Common::AES::Context* aes_context, std::vector<u8>* read_buffer) const;
+  const u8* GetDecryptedBlock(u64 block_offset_on_disc, const Common::AES::Context* aes_context,
+                              std::vector<u8>* read_buffer) const;
+  DecryptedBlock* FindDecryptedBlock(u64 block_offset_on_disc) const;
+
   std::unique_ptr<BlobReader> m_reader;
   std::map<Partition, PartitionDetails> m_partitions;
   Partition m_game_partition;
   bool m_has_hashes;
   bool m_has_encryption;
 
-  mutable u64 m_last_decrypted_block;
-  mutable u8 m_last_decrypted_block_data[BLOCK_DATA_SIZE]{};
+  // Allocated on first use, as many volumes are only used to read a few headers.
+  mutable std::unique_ptr<std::array<DecryptedBlock, DECRYPTED_BLOCK_CACHE_SIZE>>
+      m_decrypted_blocks;
+  mutable u64 m_decrypted_block_counter = 0;
 };
 
 }  // namespace DiscIO
@@ -11,8 +11,10 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <zstd.h>
@@ -33,6 +35,7 @@
 #include "DiscIO/Filesystem.h"
 #include "DiscIO/LaggedFibonacciGenerator.h"
 #include "DiscIO/MultithreadedCompressor.h"
+#include "DiscIO/ReadAheadReader.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/VolumeWii.h"
 #include "DiscIO/WIACompression.h"
@@ -79,13 +82,25 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
 
 template <bool RVZ>
 WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path)
-    : m_file(std::move(file)), m_encryption_cache(this)
+    : m_path(path), m_file(std::move(file)), m_encryption_cache(this)
 {
   m_valid = Initialize(path);
+
+  // Reading ahead only pays off when decompression takes a while.
+  m_read_ahead_enabled = m_valid && m_compression_type > WIARVZCompressionType::Purge;
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::~WIARVZFileReader() = default;
+WIARVZFileReader<RVZ>::~WIARVZFileReader()
+{
+  ShutdownReadAhead();
+
+  if (m_read_ahead_hits + m_read_ahead_misses != 0)
+  {
+    INFO_LOG_FMT(DISCIO, "{} of {} chunks read from {} had been decompressed in advance",
+                 m_read_ahead_hits, m_read_ahead_hits + m_read_ahead_misses, m_path);
+  }
+}
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
@@ -158,6 +173,13 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
     return false;
   }
 
+  if (RVZ && m_compression_type == WIARVZCompressionType::Zstd &&
+      m_header_2.compressor_data_size != 0 && !ReadZstdDictionary(header_2_size))
+  {
+    ERROR_LOG_FMT(DISCIO, "Invalid Zstandard dictionary in {}", path);
+    return false;
+  }
+
   const size_t number_of_partition_entries = Common::swap32(m_header_2.number_of_partition_entries);
   const size_t partition_entry_size = Common::swap32(m_header_2.partition_entry_size);
   std::vector<u8> partition_entries(partition_entry_size * number_of_partition_entries);
@@ -236,6 +258,28 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
   return true;
 }
 
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::ReadZstdDictionary(u32 header_2_size)
+{
+  // The compressor data holds the size of the dictionary, which is stored right after header 2.
+  if (m_header_2.compressor_data_size != sizeof(u32))
+    return false;
+
+  const u32 size = Common::swap32(m_header_2.compressor_data);
+  if (size == 0 || size > MAX_ZSTD_DICTIONARY_SIZE)
+    return false;
+
+  std::vector<u8> content(size);
+  if (!m_file.Seek(sizeof(WIAHeader1) + header_2_size, File::SeekOrigin::Begin) ||
+      !m_file.ReadBytes(content.data(), content.size()))
+  {
+    return false;
+  }
+
+  m_zstd_dictionary = std::make_unique<ZstdDictionary>(std::move(content), std::nullopt);
+  return m_zstd_dictionary->IsValid();
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::HasDataOverlap() const
 {
@@ -501,38 +545,22 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     if (total_group_index >= m_group_entries.size())
       return false;
 
-    const GroupEntry group = m_group_entries[total_group_index];
     const u64 group_offset_in_data = i * chunk_size;
     const u64 offset_in_group = *offset - group_offset_in_data - data_offset;
 
-    chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
+    const GroupChunk group =
+        GetGroupChunk(total_group_index, chunk_size, group_offset_in_data, data_size,
+                      exception_lists);
 
-    const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
+    const u64 bytes_to_read = std::min(group.decompressed_size - offset_in_group, *size);
 
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
-    {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
-
-      group_data_size &= 0x7FFFFFFF;
-
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
-    }
-
-    if (group_data_size == 0)
+    if (group.compressed_size == 0)
     {
       std::memset(*out_ptr, 0, bytes_to_read);
     }
     else
     {
-      const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
-
-      Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
+      Chunk& chunk = ReadGroupChunk(group);
 
       if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
@@ -554,11 +582,190 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     *offset += bytes_to_read;
     *size -= bytes_to_read;
     *out_ptr += bytes_to_read;
+
+    // Reads are mostly sequential, so start on the groups that are likely to be read next.
+    if (*size == 0 && m_read_ahead_enabled)
+    {
+      ReadAhead(i + 1, group_index, number_of_groups, chunk_size, data_size, exception_lists);
+    }
   }
 
   return true;
 }
 
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::GroupChunk
+WIARVZFileReader<RVZ>::GetGroupChunk(u64 total_group_index, u64 chunk_size,
+                                     u64 group_offset_in_data, u64 data_size,
+                                     u32 exception_lists) const
+{
+  const GroupEntry& entry = m_group_entries[total_group_index];
+
+  GroupChunk group;
+  group.offset_in_file = static_cast<u64>(Common::swap32(entry.data_offset)) << 2;
+  group.decompressed_size = std::min(chunk_size, data_size - group_offset_in_data);
+  group.compression_type = m_compression_type;
+  group.rvz_packed_size = 0;
+  group.data_offset = group_offset_in_data;
+  group.exception_lists = exception_lists;
+
+  u32 group_data_size = Common::swap32(entry.data_size);
+  if constexpr (RVZ)
+  {
+    if ((group_data_size & 0x80000000) == 0)
+      group.compression_type = WIARVZCompressionType::None;
+
+    group_data_size &= 0x7FFFFFFF;
+
+    group.rvz_packed_size = Common::swap32(entry.rvz_packed_size);
+  }
+  group.compressed_size = group_data_size;
+
+  return group;
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk&
+WIARVZFileReader<RVZ>::ReadGroupChunk(const GroupChunk& group)
+{
+  if (group.offset_in_file == m_cached_chunk_offset)
+    return m_cached_chunk;
+
+  if (m_read_ahead_enabled)
+  {
+    std::unique_lock lk(m_read_ahead_mutex);
+    const auto it = m_read_ahead_chunks.find(group.offset_in_file);
+    if (it != m_read_ahead_chunks.end())
+    {
+      const std::shared_ptr<ReadAheadChunk> entry = it->second;
+      m_read_ahead_chunks.erase(it);
+      m_read_ahead_done.wait(lk, [&entry] { return entry->done; });
+
+      // On failure, decompress it again below so that the error is handled as usual.
+      if (entry->success)
+      {
+        ++m_read_ahead_hits;
+        m_cached_chunk = std::move(entry->chunk);
+        m_cached_chunk_offset = group.offset_in_file;
+        return m_cached_chunk;
+      }
+    }
+
+    ++m_read_ahead_misses;
+  }
+
+  return ReadCompressedData(group.offset_in_file, group.compressed_size, group.decompressed_size,
+                            group.compression_type, group.exception_lists, group.rvz_packed_size,
+                            group.data_offset);
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::ReadAhead(u64 first_group, u32 group_index, u32 number_of_groups,
+                                      u64 chunk_size, u64 data_size, u32 exception_lists)
+{
+  const u64 end_group = std::min<u64>(first_group + READ_AHEAD_CHUNKS, number_of_groups);
+
+  std::vector<GroupChunk> groups;
+  for (u64 i = first_group; i < end_group; ++i)
+  {
+    const u64 total_group_index = group_index + i;
+    if (total_group_index >= m_group_entries.size())
+      break;
+
+    const GroupChunk group =
+        GetGroupChunk(total_group_index, chunk_size, i * chunk_size, data_size, exception_lists);
+    if (group.compressed_size != 0 && group.offset_in_file != m_cached_chunk_offset)
+      groups.push_back(group);
+  }
+
+  if (!m_read_ahead_started)
+  {
+    for (ReadAheadWorker& worker : m_read_ahead_workers)
+    {
+      worker.thread.Reset([this, &worker](std::shared_ptr<ReadAheadChunk> entry) {
+        ReadAheadThreadFunc(&worker, std::move(entry));
+      });
+    }
+    m_read_ahead_started = true;
+  }
+
+  std::lock_guard lk(m_read_ahead_mutex);
+
+  // Drop the chunks that are no longer expected to be read, to bound memory usage. The access
+  // pattern has changed, so they would most likely be wasted work.
+  for (auto it = m_read_ahead_chunks.begin(); it != m_read_ahead_chunks.end();)
+  {
+    const bool expected = std::any_of(groups.begin(), groups.end(), [&it](const GroupChunk& g) {
+      return g.offset_in_file == it->first;
+    });
+    if (expected)
+    {
+      ++it;
+    }
+    else
+    {
+      it->second->cancelled = true;
+      it = m_read_ahead_chunks.erase(it);
+    }
+  }
+
+  for (const GroupChunk& group : groups)
+  {
+    if (m_read_ahead_chunks.contains(group.offset_in_file))
+      continue;
+
+    auto entry = std::make_shared<ReadAheadChunk>();
+    entry->group = group;
+    m_read_ahead_chunks.emplace(group.offset_in_file, entry);
+
+    m_read_ahead_workers[m_read_ahead_next_worker].thread.EmplaceItem(std::move(entry));
+    m_read_ahead_next_worker = (m_read_ahead_next_worker + 1) % READ_AHEAD_THREADS;
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::ReadAheadThreadFunc(ReadAheadWorker* worker,
+                                                std::shared_ptr<ReadAheadChunk> entry)
+{
+  {
+    std::lock_guard lk(m_read_ahead_mutex);
+    if (entry->cancelled)
+      return;
+  }
+
+  // Each thread has its own file handle, so that it can seek without affecting the others.
+  if (!worker->file.IsOpen())
+    worker->file.Open(m_path, "rb");
+
+  const GroupChunk& group = entry->group;
+  Chunk chunk = CreateChunk(&worker->file, group.offset_in_file, group.compressed_size,
+                            group.decompressed_size, group.compression_type,
+                            group.exception_lists, group.rvz_packed_size, group.data_offset);
+  const bool success = worker->file.IsOpen() && chunk.Preload();
+
+  {
+    std::lock_guard lk(m_read_ahead_mutex);
+    entry->chunk = std::move(chunk);
+    entry->success = success;
+    entry->done = true;
+  }
+  m_read_ahead_done.notify_all();
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::ShutdownReadAhead()
+{
+  {
+    std::lock_guard lk(m_read_ahead_mutex);
+    for (auto& [offset, entry] : m_read_ahead_chunks)
+      entry->cancelled = true;
+    m_read_ahead_chunks.clear();
+  }
+
+  for (ReadAheadWorker& worker : m_read_ahead_workers)
+    worker.thread.Shutdown();
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -569,6 +776,20 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
   if (offset_in_file == m_cached_chunk_offset)
     return m_cached_chunk;
 
+  m_cached_chunk =
+      CreateChunk(&m_file, offset_in_file, compressed_size, decompressed_size, compression_type,
+                  exception_lists, rvz_packed_size, data_offset);
+  m_cached_chunk_offset = offset_in_file;
+  return m_cached_chunk;
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                                   u64 decompressed_size, WIARVZCompressionType compression_type,
+                                   u32 exception_lists, u32 rvz_packed_size,
+                                   u64 data_offset) const
+{
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
   {
@@ -591,17 +812,14 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                                       m_header_2.compressor_data_size);
     break;
   case WIARVZCompressionType::Zstd:
-    decompressor = std::make_unique<ZstdDecompressor>();
+    decompressor = std::make_unique<ZstdDecompressor>(m_zstd_dictionary.get());
     break;
   }
 
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return Chunk(file, offset_in_file, compressed_size, decompressed_size, exception_lists,
+               compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
 }
 
 template <bool RVZ>
@@ -645,16 +863,29 @@ WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 {
-  if (!m_decompressor || !m_file ||
-      offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
-  {
+  if (!DecompressUpTo(offset + size))
     return false;
-  }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::Preload()
+{
+  return DecompressUpTo(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUpTo(u64 end)
+{
+  if (!m_decompressor || !m_file || end > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
+    return false;
+
+  while (end > GetOutBytesWrittenExcludingExceptions())
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -667,7 +898,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -747,7 +978,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -1055,7 +1285,8 @@ std::optional<std::vector<u8>> WIARVZFileReader<RVZ>::Compress(Compressor* compr
 template <bool RVZ>
 void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                                             WIARVZCompressionType compression_type,
-                                            int compression_level, WIAHeader2* header_2)
+                                            int compression_level, WIAHeader2* header_2,
+                                            const ZstdDictionary* zstd_dictionary)
 {
   switch (compression_type)
   {
@@ -1086,11 +1317,73 @@ void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compres
     break;
   }
   case WIARVZCompressionType::Zstd:
-    *compressor = std::make_unique<ZstdCompressor>(compression_level);
+    *compressor = std::make_unique<ZstdCompressor>(compression_level, zstd_dictionary);
     break;
   }
 }
 
+template <bool RVZ>
+std::vector<u8> WIARVZFileReader<RVZ>::BuildZstdDictionary(const VolumeDisc* volume)
+{
+  // The starts of files are the parts of a disc that are most alike, as most files begin with
+  // the header of one of a handful of file formats. Samples are taken from files spread evenly
+  // over the disc, and identical samples are only included once.
+  struct FileToSample
+  {
+    Partition partition;
+    u64 offset;
+    u32 size;
+  };
+  std::vector<FileToSample> files;
+
+  std::vector<Partition> partitions = volume->GetPartitions();
+  if (partitions.empty())
+    partitions.push_back(PARTITION_NONE);
+
+  for (const Partition& partition : partitions)
+  {
+    const FileSystem* file_system = volume->GetFileSystem(partition);
+    if (!file_system || !file_system->IsValid())
+      continue;
+
+    const auto add_files = [&](const FileInfo& directory, const auto& add_files_ref) -> void {
+      for (const FileInfo& file_info : directory)
+      {
+        if (file_info.IsDirectory())
+          add_files_ref(file_info, add_files_ref);
+        else if (file_info.GetSize() != 0)
+          files.push_back({partition, file_info.GetOffset(), file_info.GetSize()});
+      }
+    };
+    add_files(file_system->GetRoot(), add_files);
+  }
+
+  const size_t max_samples = ZSTD_DICTIONARY_SIZE / ZSTD_DICTIONARY_SAMPLE_SIZE;
+  const size_t stride = std::max<size_t>(1, files.size() / max_samples);
+
+  std::vector<u8> content;
+  std::set<std::vector<u8>> samples;
+  for (size_t i = 0; i < files.size() && content.size() < ZSTD_DICTIONARY_SIZE; i += stride)
+  {
+    const FileToSample& file = files[i];
+    std::vector<u8> sample(std::min<size_t>(ZSTD_DICTIONARY_SAMPLE_SIZE, file.size));
+    if (!volume->Read(file.offset, sample.size(), sample.data(), file.partition))
+      continue;
+
+    if (samples.insert(sample).second)
+      content.insert(content.end(), sample.begin(), sample.end());
+  }
+
+  // Content starting with the magic number would be parsed as a trained dictionary instead.
+  if (content.size() >= sizeof(u32) &&
+      Common::swap32(content.data()) == Common::swap32(ZSTD_MAGIC_DICTIONARY))
+  {
+    content.erase(content.begin());
+  }
+
+  return content;
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::TryReuse(std::map<ReuseID, GroupEntry>* reusable_groups,
                                      std::mutex* reusable_groups_mutex,
@@ -1729,7 +2022,8 @@ template <bool RVZ>
 ConversionResultCode
 WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                File::IOFile* outfile, WIARVZCompressionType compression_type,
-                               int compression_level, int chunk_size, CompressCB callback)
+                               int compression_level, int chunk_size, CompressCB callback,
+                               unsigned int compression_threads, bool zstd_dictionary)
 {
   ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
   ASSERT(chunk_size > 0);
@@ -1765,6 +2059,19 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
   group_entries.resize(total_groups);
 
+  std::unique_ptr<ZstdDictionary> dictionary;
+  if (RVZ && zstd_dictionary && compression_type == WIARVZCompressionType::Zstd && infile_volume)
+  {
+    std::vector<u8> content = BuildZstdDictionary(infile_volume);
+    if (!content.empty())
+    {
+      dictionary = std::make_unique<ZstdDictionary>(std::move(content), compression_level);
+      if (!dictionary->IsValid())
+        return ConversionResultCode::InternalError;
+    }
+  }
+  const size_t dictionary_size = dictionary ? dictionary->GetContent().size() : 0;
+
   const size_t partition_entries_size = partition_entries.size() * sizeof(PartitionEntry);
   const size_t raw_data_entries_size = raw_data_entries.size() * sizeof(RawDataEntry);
   const size_t group_entries_size = group_entries.size() * sizeof(GroupEntry);
@@ -1774,8 +2081,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   // fit on that space, we will need to write them at the end of the file instead.
   const u64 headers_size_upper_bound = [&] {
     // 0x100 is added to account for compression overhead (in particular for Purge).
-    u64 upper_bound = sizeof(WIAHeader1) + sizeof(WIAHeader2) + partition_entries_size +
-                      raw_data_entries_size + 0x100;
+    u64 upper_bound = sizeof(WIAHeader1) + sizeof(WIAHeader2) + dictionary_size +
+                      partition_entries_size + raw_data_entries_size + 0x100;
 
     // RVZ's added data in GroupEntry usually compresses well, so we'll assume the compression ratio
     // for RVZ GroupEntries is 9 / 16 or better. This constant is somehwat arbitrarily chosen, but
@@ -1804,7 +2111,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   std::mutex reusable_groups_mutex;
 
   const auto set_up_compress_thread_state = [&](CompressThreadState* state) {
-    SetUpCompressor(&state->compressor, compression_type, compression_level, nullptr);
+    SetUpCompressor(&state->compressor, compression_type, compression_level, nullptr,
+                    dictionary.get());
     return ConversionResultCode::Success;
   };
 
@@ -1835,7 +2143,11 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   };
 
   MultithreadedCompressor<CompressThreadState, CompressParameters, OutputParameters> mt_compressor(
-      set_up_compress_thread_state, process_and_compress, output);
+      set_up_compress_thread_state, process_and_compress, output, compression_threads);
+
+  // Work out all the reads up front, so that they can be done ahead of the compression.
+  std::vector<CompressParameters> pieces;
+  std::vector<ReadAheadReader::Range> ranges;
 
   for (const DataEntry& data_entry : data_entries)
   {
@@ -1887,22 +2199,16 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
     while (groups_processed < last_group)
     {
-      const ConversionResultCode status = mt_compressor.GetStatus();
-      if (status != ConversionResultCode::Success)
-        return status;
-
       u64 bytes_to_read = chunk_size;
       if (data_entry.is_partition)
         bytes_to_read = std::max<u64>(bytes_to_read, VolumeWii::GROUP_TOTAL_SIZE);
       bytes_to_read = std::min<u64>(bytes_to_read, data_offset + data_size - bytes_read);
 
-      buffer.resize(bytes_to_read);
-      if (!infile->Read(bytes_read, bytes_to_read, buffer.data()))
-        return ConversionResultCode::ReadFailed;
+      ranges.push_back({bytes_read, bytes_to_read});
       bytes_read += bytes_to_read;
 
-      mt_compressor.CompressAndWrite(CompressParameters{
-          buffer, &data_entry, data_offset_in_partition, bytes_read, groups_processed});
+      pieces.push_back(CompressParameters{{}, &data_entry, data_offset_in_partition, bytes_read,
+                                          groups_processed});
 
       data_offset += bytes_to_read;
       data_size -= bytes_to_read;
@@ -1926,6 +2232,19 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   ASSERT(groups_processed == total_groups);
   ASSERT(bytes_read == iso_size);
 
+  ReadAheadReader reader(infile, std::move(ranges));
+  for (CompressParameters& piece : pieces)
+  {
+    const ConversionResultCode status = mt_compressor.GetStatus();
+    if (status != ConversionResultCode::Success)
+      return status;
+
+    if (!reader.GetNext(&piece.data))
+      return ConversionResultCode::ReadFailed;
+
+    mt_compressor.CompressAndWrite(std::move(piece));
+  }
+
   mt_compressor.Shutdown();
 
   const ConversionResultCode status = mt_compressor.GetStatus();
@@ -1933,7 +2252,7 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
     return status;
 
   std::unique_ptr<Compressor> compressor;
-  SetUpCompressor(&compressor, compression_type, compression_level, &header_2);
+  SetUpCompressor(&compressor, compression_type, compression_level, &header_2, dictionary.get());
 
   const std::optional<std::vector<u8>> compressed_raw_data_entries = Compress(
       compressor.get(), reinterpret_cast<u8*>(raw_data_entries.data()), raw_data_entries_size);
@@ -1949,6 +2268,20 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   if (!outfile->Seek(sizeof(WIAHeader1) + sizeof(WIAHeader2), File::SeekOrigin::Begin))
     return ConversionResultCode::WriteFailed;
 
+  // The dictionary is always within the reserved space, as readers expect it right after header 2.
+  if (dictionary)
+  {
+    if (!outfile->WriteBytes(dictionary->GetContent().data(), dictionary_size))
+      return ConversionResultCode::WriteFailed;
+    bytes_written += dictionary_size;
+    if (!PadTo4(outfile, &bytes_written))
+      return ConversionResultCode::WriteFailed;
+
+    const u32 dictionary_size_be = Common::swap32(static_cast<u32>(dictionary_size));
+    std::memcpy(header_2.compressor_data, &dictionary_size_be, sizeof(dictionary_size_be));
+    header_2.compressor_data_size = sizeof(dictionary_size_be);
+  }
+
   u64 partition_entries_offset;
   if (!WriteHeader(outfile, reinterpret_cast<u8*>(partition_entries.data()), partition_entries_size,
                    headers_size_upper_bound, &bytes_written, &partition_entries_offset))
@@ -2003,8 +2336,10 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
   header_1.magic = RVZ ? RVZ_MAGIC : WIA_MAGIC;
   header_1.version = Common::swap32(RVZ ? RVZ_VERSION : WIA_VERSION);
-  header_1.version_compatible =
-      Common::swap32(RVZ ? RVZ_VERSION_WRITE_COMPATIBLE : WIA_VERSION_WRITE_COMPATIBLE);
+  u32 version_compatible = RVZ ? RVZ_VERSION_WRITE_COMPATIBLE : WIA_VERSION_WRITE_COMPATIBLE;
+  if (dictionary)
+    version_compatible = RVZ_VERSION_WRITE_COMPATIBLE_ZSTD_DICTIONARY;
+  header_1.version_compatible = Common::swap32(version_compatible);
   header_1.header_2_size = Common::swap32(sizeof(WIAHeader2));
   header_1.header_2_hash =
       Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(&header_2), sizeof(header_2));
@@ -2027,7 +2362,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback)
+                       int chunk_size, CompressCB callback, unsigned int compression_threads,
+                       bool zstd_dictionary)
 {
   File::IOFile outfile(outfile_path, "wb");
   if (!outfile)
@@ -2040,12 +2376,13 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
     return false;
   }
 
-  std::unique_ptr<VolumeDisc> infile_volume = CreateDisc(infile_path);
+  std::unique_ptr<VolumeDisc> infile_volume =
+      infile_path.empty() ? nullptr : CreateDisc(infile_path);
 
   const auto convert = rvz ? RVZFileReader::Convert : WIAFileReader::Convert;
   const ConversionResultCode result =
       convert(infile, infile_volume.get(), &outfile, compression_type, compression_level,
-              chunk_size, callback);
+              chunk_size, callback, compression_threads, zstd_dictionary);
 
   if (result == ConversionResultCode::ReadFailed)
     PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
@@ -4,10 +4,12 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -15,6 +17,7 @@
 #include "Common/Crypto/SHA1.h"
 #include "Common/IOFile.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
@@ -68,7 +71,8 @@ public:
 
   static ConversionResultCode Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
-                                      int compression_level, int chunk_size, CompressCB callback);
+                                      int compression_level, int chunk_size, CompressCB callback,
+                                      unsigned int compression_threads, bool zstd_dictionary);
 
 private:
   using WiiKey = std::array<u8, 16>;
@@ -193,6 +197,9 @@ private:
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
 
+    // Decompresses the whole chunk, so that reading from it no longer accesses the file.
+    bool Preload();
+
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
                            u64 exception_list_index, u16 additional_offset) const;
@@ -204,6 +211,7 @@ private:
     }
 
   private:
+    bool DecompressUpTo(u64 end);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -233,12 +241,51 @@ private:
 
   const PartitionEntry* GetPartition(u64 partition_data_offset, u32* partition_first_sector) const;
 
+  // Where and how the data of a group is stored in the file.
+  struct GroupChunk
+  {
+    u64 offset_in_file;
+    u64 compressed_size;  // 0 if the group is all zeroes
+    u64 decompressed_size;
+    WIARVZCompressionType compression_type;
+    u32 rvz_packed_size;
+    u64 data_offset;
+    u32 exception_lists;
+  };
+
+  // A chunk being decompressed in advance by a read-ahead thread.
+  struct ReadAheadChunk
+  {
+    GroupChunk group;
+    Chunk chunk;
+    bool done = false;
+    bool success = false;
+    bool cancelled = false;
+  };
+
+  struct ReadAheadWorker
+  {
+    Common::WorkQueueThread<std::shared_ptr<ReadAheadChunk>> thread;
+    File::IOFile file;  // Only used by the thread.
+  };
+
   bool ReadFromGroups(u64* offset, u64* size, u8** out_ptr, u64 chunk_size, u32 sector_size,
                       u64 data_offset, u64 data_size, u32 group_index, u32 number_of_groups,
                       u32 exception_lists);
+  GroupChunk GetGroupChunk(u64 total_group_index, u64 chunk_size, u64 group_offset_in_data,
+                           u64 data_size, u32 exception_lists) const;
+  Chunk& ReadGroupChunk(const GroupChunk& group);
+  void ReadAhead(u64 first_group, u32 group_index, u32 number_of_groups, u64 chunk_size,
+                 u64 data_size, u32 exception_lists);
+  void ReadAheadThreadFunc(ReadAheadWorker* worker, std::shared_ptr<ReadAheadChunk> entry);
+  void ShutdownReadAhead();
+
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk CreateChunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                    u64 decompressed_size, WIARVZCompressionType compression_type,
+                    u32 exception_lists, u32 rvz_packed_size, u64 data_offset) const;
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -342,7 +389,9 @@ private:
 
   static void SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                               WIARVZCompressionType compression_type, int compression_level,
-                              WIAHeader2* header_2);
+                              WIAHeader2* header_2, const ZstdDictionary* zstd_dictionary);
+  static std::vector<u8> BuildZstdDictionary(const VolumeDisc* volume);
+  bool ReadZstdDictionary(u32 header_2_size);
   static bool TryReuse(std::map<ReuseID, GroupEntry>* reusable_groups,
                        std::mutex* reusable_groups_mutex, OutputParametersEntry* entry);
   static ConversionResult<OutputParameters>
@@ -364,9 +413,27 @@ private:
   bool m_valid;
   WIARVZCompressionType m_compression_type;
 
+  std::string m_path;
   File::IOFile m_file;
+  // Declared before anything that holds chunks, as their decompressors refer to it.
+  std::unique_ptr<ZstdDictionary> m_zstd_dictionary;
   Chunk m_cached_chunk;
   u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+
+  // Decompressing a chunk can take long enough to cause stutter when the emulated software waits
+  // for the data, so the chunks after the last one read are decompressed ahead of time on worker
+  // threads. Entries are keyed by their offset in the file, like m_cached_chunk_offset.
+  static constexpr u64 READ_AHEAD_CHUNKS = 4;
+  static constexpr size_t READ_AHEAD_THREADS = 2;
+  bool m_read_ahead_enabled = false;
+  std::mutex m_read_ahead_mutex;
+  std::condition_variable m_read_ahead_done;
+  std::map<u64, std::shared_ptr<ReadAheadChunk>> m_read_ahead_chunks;
+  std::array<ReadAheadWorker, READ_AHEAD_THREADS> m_read_ahead_workers;
+  bool m_read_ahead_started = false;
+  size_t m_read_ahead_next_worker = 0;
+  u64 m_read_ahead_hits = 0;
+  u64 m_read_ahead_misses = 0;
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
@@ -389,9 +456,17 @@ private:
   static constexpr u32 WIA_VERSION_WRITE_COMPATIBLE = 0x01000000;
   static constexpr u32 WIA_VERSION_READ_COMPATIBLE = 0x00080000;
 
-  static constexpr u32 RVZ_VERSION = 0x01000000;
+  static constexpr u32 RVZ_VERSION = 0x01010000;
   static constexpr u32 RVZ_VERSION_WRITE_COMPATIBLE = 0x00030000;
   static constexpr u32 RVZ_VERSION_READ_COMPATIBLE = 0x00030000;
+  // Files with a Zstandard dictionary can't be read by anything older than 1.1.
+  static constexpr u32 RVZ_VERSION_WRITE_COMPATIBLE_ZSTD_DICTIONARY = 0x01010000;
+
+  // The dictionary is built from the first bytes of files spread evenly over the disc.
+  static constexpr size_t ZSTD_DICTIONARY_SIZE = 0x10000;
+  static constexpr size_t ZSTD_DICTIONARY_SAMPLE_SIZE = 0x200;
+  // Anything bigger than this in a file is treated as corruption.
+  static constexpr u32 MAX_ZSTD_DICTIONARY_SIZE = 0x100000;
 };
 
 using WIAFileReader = WIARVZFileReader<false>;
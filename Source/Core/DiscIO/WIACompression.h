@@ -31,6 +31,29 @@ struct PurgeSegment
 };
 static_assert(sizeof(PurgeSegment) == 0x08, "Wrong size for WIA purge segment");
 
+// Raw content that every Zstandard frame in an RVZ file can refer back to, which gives small
+// chunks something to match against before they have built up any history of their own.
+class ZstdDictionary final
+{
+public:
+  // The compression level is only needed when the dictionary is used for compressing.
+  ZstdDictionary(std::vector<u8> content, std::optional<int> compression_level);
+  ~ZstdDictionary();
+
+  ZstdDictionary(const ZstdDictionary&) = delete;
+  ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+  bool IsValid() const;
+  const std::vector<u8>& GetContent() const { return m_content; }
+  const ZSTD_CDict* GetCDict() const { return m_cdict; }
+  const ZSTD_DDict* GetDDict() const { return m_ddict; }
+
+private:
+  std::vector<u8> m_content;
+  ZSTD_CDict* m_cdict = nullptr;
+  ZSTD_DDict* m_ddict = nullptr;
+};
+
 class Decompressor
 {
 public:
@@ -105,7 +128,8 @@ private:
 class ZstdDecompressor final : public Decompressor
 {
 public:
-  ZstdDecompressor();
+  // The dictionary, if any, must outlive the decompressor.
+  explicit ZstdDecompressor(const ZstdDictionary* dictionary = nullptr);
   ~ZstdDecompressor();
 
   bool Decompress(const DecompressionBuffer& in, DecompressionBuffer* out,
@@ -228,7 +252,8 @@ private:
 class ZstdCompressor final : public Compressor
 {
 public:
-  ZstdCompressor(int compression_level);
+  // The dictionary, if any, must outlive the compressor.
+  ZstdCompressor(int compression_level, const ZstdDictionary* dictionary = nullptr);
   ~ZstdCompressor();
 
   bool Start(std::optional<u64> size) override;
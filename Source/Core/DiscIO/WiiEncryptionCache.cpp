@@ -26,20 +26,31 @@ WiiEncryptionCache::EncryptGroup(u64 offset, u64 partition_data_offset,
                                  u64 partition_data_decrypted_size, const Key& key,
                                  const HashExceptionCallback& hash_exception_callback)
 {
-  // Only allocate memory if this function actually ends up getting called
-  if (!m_cache)
-  {
-    m_cache = std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>();
-    m_cached_offset = std::numeric_limits<u64>::max();
-  }
-
   ASSERT(offset % VolumeWii::GROUP_TOTAL_SIZE == 0);
   const u64 group_offset_in_partition =
       offset / VolumeWii::GROUP_TOTAL_SIZE * VolumeWii::GROUP_DATA_SIZE;
   const u64 group_offset_on_disc = partition_data_offset + offset;
 
-  if (m_cached_offset != group_offset_on_disc)
+  // Use the group if it's cached, and otherwise replace the least recently used one
+  CachedGroup* cached = &m_cache[0];
+  for (CachedGroup& group : m_cache)
   {
+    if (group.offset == group_offset_on_disc)
+    {
+      cached = &group;
+      break;
+    }
+    if (group.last_used < cached->last_used)
+      cached = &group;
+  }
+  cached->last_used = ++m_use_counter;
+
+  if (cached->offset != group_offset_on_disc)
+  {
+    // Only allocate memory if this function actually ends up getting called
+    if (!cached->data)
+      cached->data = std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>();
+
     std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
 
     if (hash_exception_callback)
@@ -52,17 +63,17 @@ WiiEncryptionCache::EncryptGroup(u64 offset, u64 partition_data_offset,
     }
 
     if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
-                                 partition_data_decrypted_size, key, m_blob, m_cache.get(),
+                                 partition_data_decrypted_size, key, m_blob, cached->data.get(),
                                  hash_exception_callback_2))
     {
-      m_cached_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+      cached->offset = std::numeric_limits<u64>::max();  // Invalidate the cache
       return nullptr;
     }
 
-    m_cached_offset = group_offset_on_disc;
+    cached->offset = group_offset_on_disc;
   }
 
-  return m_cache.get();
+  return cached->data.get();
 }
 
 bool WiiEncryptionCache::EncryptGroups(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset,
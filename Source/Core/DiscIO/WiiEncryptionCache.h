@@ -48,9 +48,20 @@ public:
                      const HashExceptionCallback& hash_exception_callback = {});
 
 private:
+  // Games often read from a few files at once, which are rarely in the same group, and each miss
+  // means reading, hashing and encrypting a whole group again. A few groups are kept for that.
+  static constexpr size_t CACHED_GROUPS = 4;
+
+  struct CachedGroup
+  {
+    std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> data;
+    u64 offset = std::numeric_limits<u64>::max();
+    u64 last_used = 0;
+  };
+
   BlobReader* m_blob;
-  std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> m_cache;
-  u64 m_cached_offset = 0;
+  std::array<CachedGroup, CACHED_GROUPS> m_cache;
+  u64 m_use_counter = 0;
 };
 
 }  // namespace DiscIO
@@ -4,9 +4,11 @@
 #include "DolphinNoGUI/Platform.h"
 
 #include <OptionParser.h>
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <optional>
 #include <signal.h>
 #include <string>
 #include <vector>
@@ -17,13 +19,23 @@
 #include <Windows.h>
 #endif
 
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
+#include "Common/Version.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/CPUBenchmark.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
+#include "Core/PowerPC/PowerPC.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -33,6 +45,9 @@
 
 #include "InputCommon/GCAdapter.h"
 
+#include "VideoBackends/Null/VideoBackend.h"
+
+#include "VideoCommon/FrameStatsRecorder.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 
@@ -176,6 +191,23 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+static const char* GetCPUCoreName(PowerPC::CPUCore core)
+{
+  switch (core)
+  {
+  case PowerPC::CPUCore::Interpreter:
+    return "Interpreter";
+  case PowerPC::CPUCore::JIT64:
+    return "JIT64";
+  case PowerPC::CPUCore::JITARM64:
+    return "JITARM64";
+  case PowerPC::CPUCore::CachedInterpreter:
+    return "Cached Interpreter";
+  default:
+    return "Unknown";
+  }
+}
+
 #ifdef _WIN32
 #define main app_main
 #endif
@@ -201,6 +233,29 @@ int main(int argc, char* argv[])
             "win32"
 #endif
       });
+  parser->add_option("--benchmark")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Play back a FIFO log as fast as possible, and write the statistics of each frame to "
+            "a JSON file");
+  parser->add_option("--benchmark_passes")
+      .action("store")
+      .type("int")
+      .set_default(1)
+      .help("Number of times to play back the FIFO log when benchmarking [default: %default]");
+  parser->add_option("--cpu_benchmark")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Emulate a number of frames as fast as possible with the Null video backend and no "
+            "audio output, and write CPU emulation statistics to a JSON file. Use --movie to "
+            "provide the input");
+  parser->add_option("--benchmark_frames")
+      .action("store")
+      .type("int")
+      .set_default(1800)
+      .help("Number of VI fields to emulate for --cpu_benchmark [default: %default]");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -212,12 +267,14 @@ int main(int argc, char* argv[])
   }
 
   std::unique_ptr<BootParameters> boot;
+  std::string game_path;
   bool game_specified = false;
   if (options.is_set("exec"))
   {
     const std::list<std::string> paths_list = options.all("exec");
     const std::vector<std::string> paths{std::make_move_iterator(std::begin(paths_list)),
                                          std::make_move_iterator(std::end(paths_list))};
+    game_path = paths.front();
     boot = BootParameters::GenerateFromFile(
         paths, BootSessionData(save_state_path, DeleteSavestateAfterBoot::No));
     game_specified = true;
@@ -236,6 +293,7 @@ int main(int argc, char* argv[])
   }
   else if (args.size())
   {
+    game_path = args.front();
     boot = BootParameters::GenerateFromFile(
         args.front(), BootSessionData(save_state_path, DeleteSavestateAfterBoot::No));
     args.erase(args.begin());
@@ -275,6 +333,55 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  std::optional<std::string> benchmark_path;
+  if (options.is_set("benchmark"))
+  {
+    benchmark_path = static_cast<const char*>(options.get("benchmark"));
+
+    // The FIFO player stops after the last pass, which ends the main loop.
+    FifoPlayer& fifo_player = FifoPlayer::GetInstance();
+    fifo_player.SetLoopCount(std::max(static_cast<int>(options.get("benchmark_passes")), 1));
+    fifo_player.SetFrameWrittenCallback([] {
+      VideoCommon::g_frame_stats_recorder.SetPass(
+          FifoPlayer::GetInstance().GetCompletedLoopCount());
+    });
+
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    Config::SetCurrent(Config::GFX_VSYNC, false);
+    VideoCommon::g_frame_stats_recorder.Start();
+  }
+
+  std::optional<std::string> cpu_benchmark_path;
+  if (options.is_set("cpu_benchmark"))
+  {
+    if (benchmark_path)
+    {
+      fprintf(stderr, "--benchmark and --cpu_benchmark cannot be used together.\n");
+      return 1;
+    }
+
+    cpu_benchmark_path = static_cast<const char*>(options.get("cpu_benchmark"));
+
+    // Emulation stops once all fields have been measured, which ends the main loop.
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, Null::VideoBackend::NAME);
+    Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, BACKEND_NULLSOUND);
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    CPUBenchmark::Start(std::max(static_cast<int>(options.get("benchmark_frames")), 1));
+  }
+
+  if (options.is_set("movie"))
+  {
+    std::optional<std::string> movie_save_state_path;
+    if (!Movie::PlayInput(static_cast<const char*>(options.get("movie")), &movie_save_state_path))
+    {
+      fprintf(stderr, "Could not play the specified movie\n");
+      return 1;
+    }
+
+    boot->boot_session_data.SetSavestateData(std::move(movie_save_state_path),
+                                             DeleteSavestateAfterBoot::No);
+  }
+
   Core::AddOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_platform->Stop();
@@ -311,6 +418,40 @@ int main(int argc, char* argv[])
   Core::Shutdown();
   s_platform.reset();
 
+  if (benchmark_path)
+  {
+    FifoPlayer::GetInstance().SetFrameWrittenCallback(nullptr);
+    const std::vector<VideoCommon::FrameStats> frames = VideoCommon::g_frame_stats_recorder.Stop();
+    const std::string description =
+        fmt::format("{} ({} backend, Dolphin {})", game_path,
+                    Config::Get(Config::MAIN_GFX_BACKEND), Common::GetScmRevStr());
+    if (!VideoCommon::WriteFrameStatsJSON(*benchmark_path, frames, description))
+    {
+      fprintf(stderr, "Failed to write the benchmark results to %s\n", benchmark_path->c_str());
+      return 1;
+    }
+  }
+
+  if (cpu_benchmark_path)
+  {
+    const std::optional<CPUBenchmark::Results> results = CPUBenchmark::Stop();
+    if (!results)
+    {
+      fprintf(stderr, "Emulation stopped before the benchmark was complete\n");
+      return 1;
+    }
+
+    const std::string description =
+        fmt::format("{} ({}, Dolphin {})", game_path,
+                    GetCPUCoreName(Config::Get(Config::MAIN_CPU_CORE)), Common::GetScmRevStr());
+    if (!CPUBenchmark::WriteResultsJSON(*cpu_benchmark_path, *results, description))
+    {
+      fprintf(stderr, "Failed to write the benchmark results to %s\n",
+              cpu_benchmark_path->c_str());
+      return 1;
+    }
+  }
+
   return 0;
 }
 
@@ -32,10 +32,16 @@ void CommonControllersWidget::CreateLayout()
   m_common_box = new QGroupBox(tr("Common"));
   m_common_layout = new QVBoxLayout();
   m_common_bg_input = new QCheckBox(tr("Background Input"));
+  m_common_late_latching = new QCheckBox(tr("Late Input Latching"));
+  m_common_late_latching->setToolTip(
+      tr("Samples GameCube controllers when the game reads their inputs instead of when the "
+         "emulated console polls them, which can reduce input latency by up to a frame.<br><br>"
+         "Has no effect during netplay or while recording or playing back a movie."));
   m_common_configure_controller_interface =
       new NonDefaultQPushButton(tr("Alternate Input Sources"));
 
   m_common_layout->addWidget(m_common_bg_input);
+  m_common_layout->addWidget(m_common_late_latching);
   m_common_layout->addWidget(m_common_configure_controller_interface);
 
   m_common_box->setLayout(m_common_layout);
@@ -50,6 +56,8 @@ void CommonControllersWidget::CreateLayout()
 void CommonControllersWidget::ConnectWidgets()
 {
   connect(m_common_bg_input, &QCheckBox::toggled, this, &CommonControllersWidget::SaveSettings);
+  connect(m_common_late_latching, &QCheckBox::toggled, this,
+          &CommonControllersWidget::SaveSettings);
   connect(m_common_configure_controller_interface, &QPushButton::clicked, this,
           &CommonControllersWidget::OnControllerInterfaceConfigure);
 }
@@ -65,10 +73,12 @@ void CommonControllersWidget::OnControllerInterfaceConfigure()
 void CommonControllersWidget::LoadSettings()
 {
   SignalBlocking(m_common_bg_input)->setChecked(Config::Get(Config::MAIN_INPUT_BACKGROUND_INPUT));
+  SignalBlocking(m_common_late_latching)->setChecked(Config::Get(Config::MAIN_INPUT_LATE_LATCHING));
 }
 
 void CommonControllersWidget::SaveSettings()
 {
   Config::SetBaseOrCurrent(Config::MAIN_INPUT_BACKGROUND_INPUT, m_common_bg_input->isChecked());
+  Config::SetBaseOrCurrent(Config::MAIN_INPUT_LATE_LATCHING, m_common_late_latching->isChecked());
   Config::Save();
 }
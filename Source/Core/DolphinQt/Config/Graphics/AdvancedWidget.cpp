@@ -52,6 +52,8 @@ void AdvancedWidget::CreateWidgets()
 
   m_enable_wireframe = new GraphicsBool(tr("Enable Wireframe"), Config::GFX_ENABLE_WIREFRAME);
   m_show_statistics = new GraphicsBool(tr("Show Statistics"), Config::GFX_OVERLAY_STATS);
+  m_show_frame_timeline =
+      new GraphicsBool(tr("Show Frame Timeline"), Config::GFX_SHOW_FRAME_TIMELINE);
   m_enable_format_overlay =
       new GraphicsBool(tr("Texture Format Overlay"), Config::GFX_TEXFMT_OVERLAY_ENABLE);
   m_enable_api_validation =
@@ -61,6 +63,7 @@ void AdvancedWidget::CreateWidgets()
   debugging_layout->addWidget(m_show_statistics, 0, 1);
   debugging_layout->addWidget(m_enable_format_overlay, 1, 0);
   debugging_layout->addWidget(m_enable_api_validation, 1, 1);
+  debugging_layout->addWidget(m_show_frame_timeline, 2, 0);
 
   // Utility
   auto* utility_box = new QGroupBox(tr("Utility"));
@@ -220,6 +223,11 @@ void AdvancedWidget::AddDescriptions()
   static const char TR_SHOW_STATS_DESCRIPTION[] =
       QT_TR_NOOP("Shows various rendering statistics.<br><br><dolphin_emphasis>If unsure, "
                  "leave this unchecked.</dolphin_emphasis>");
+  static const char TR_SHOW_FRAME_TIMELINE_DESCRIPTION[] = QT_TR_NOOP(
+      "Shows a graph of the time each frame spends on JIT execution, JIT compilation, MMIO/HLE, "
+      "idle skipping and throttling on the CPU thread, on command decoding, vertex loading, the "
+      "texture cache and flushing on the GPU thread, and the GPU time of each kind of "
+      "work.<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
   static const char TR_TEXTURE_FORMAT_DESCRIPTION[] =
       QT_TR_NOOP("Modifies textures to show the format they're encoded in.<br><br>May require "
                  "an emulation reset to apply.<br><br><dolphin_emphasis>If unsure, leave this "
@@ -333,6 +341,7 @@ void AdvancedWidget::AddDescriptions()
 
   m_enable_wireframe->SetDescription(tr(TR_WIREFRAME_DESCRIPTION));
   m_show_statistics->SetDescription(tr(TR_SHOW_STATS_DESCRIPTION));
+  m_show_frame_timeline->SetDescription(tr(TR_SHOW_FRAME_TIMELINE_DESCRIPTION));
   m_enable_format_overlay->SetDescription(tr(TR_TEXTURE_FORMAT_DESCRIPTION));
   m_enable_api_validation->SetDescription(tr(TR_VALIDATION_LAYER_DESCRIPTION));
   m_dump_textures->SetDescription(tr(TR_DUMP_TEXTURE_DESCRIPTION));
@@ -33,6 +33,7 @@ private:
   // Debugging
   GraphicsBool* m_enable_wireframe;
   GraphicsBool* m_show_statistics;
+  GraphicsBool* m_show_frame_timeline;
   GraphicsBool* m_enable_format_overlay;
   GraphicsBool* m_enable_api_validation;
 
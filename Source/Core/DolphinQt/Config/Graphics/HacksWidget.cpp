@@ -106,11 +106,14 @@ void HacksWidget::CreateWidgets()
   m_vertex_rounding = new GraphicsBool(tr("Vertex Rounding"), Config::GFX_HACK_VERTEX_ROUNDING);
   m_save_texture_cache_state =
       new GraphicsBool(tr("Save Texture Cache to State"), Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE);
+  m_save_texture_cache_native = new GraphicsBool(tr("Save Texture Cache at Native Resolution"),
+                                                 Config::GFX_SAVE_TEXTURE_CACHE_AT_NATIVE_RESOLUTION);
 
   other_layout->addWidget(m_fast_depth_calculation, 0, 0);
   other_layout->addWidget(m_disable_bounding_box, 0, 1);
   other_layout->addWidget(m_vertex_rounding, 1, 0);
   other_layout->addWidget(m_save_texture_cache_state, 1, 1);
+  other_layout->addWidget(m_save_texture_cache_native, 2, 1);
 
   main_layout->addWidget(efb_box);
   main_layout->addWidget(texture_cache_box);
@@ -275,6 +278,12 @@ void HacksWidget::AddDescriptions()
                  "in save states. Fixes missing and/or non-upscaled textures/objects when loading "
                  "states at the cost of additional save/load time.<br><br><dolphin_emphasis>If "
                  "unsure, leave this checked.</dolphin_emphasis>");
+  static const char TR_SAVE_TEXTURE_CACHE_NATIVE_DESCRIPTION[] =
+      QT_TR_NOOP("Stores EFB copies in save states at native resolution instead of the internal "
+                 "resolution. Greatly reduces save time and state size at high internal "
+                 "resolutions, but copies that the game doesn't redraw stay blurry after loading "
+                 "the state.<br><br><dolphin_emphasis>If unsure, leave this "
+                 "unchecked.</dolphin_emphasis>");
   static const char TR_VERTEX_ROUNDING_DESCRIPTION[] = QT_TR_NOOP(
       "Rounds 2D vertices to whole pixels and rounds the viewport size to a whole number.<br><br>"
       "Fixes graphical problems in some games at higher internal resolutions. This setting has no "
@@ -294,6 +303,7 @@ void HacksWidget::AddDescriptions()
   m_fast_depth_calculation->SetDescription(tr(TR_FAST_DEPTH_CALC_DESCRIPTION));
   m_disable_bounding_box->SetDescription(tr(TR_DISABLE_BOUNDINGBOX_DESCRIPTION));
   m_save_texture_cache_state->SetDescription(tr(TR_SAVE_TEXTURE_CACHE_TO_STATE_DESCRIPTION));
+  m_save_texture_cache_native->SetDescription(tr(TR_SAVE_TEXTURE_CACHE_NATIVE_DESCRIPTION));
   m_vertex_rounding->SetDescription(tr(TR_VERTEX_ROUNDING_DESCRIPTION));
 }
 
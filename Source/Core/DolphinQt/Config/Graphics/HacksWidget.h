@@ -43,6 +43,7 @@ private:
   GraphicsBool* m_disable_bounding_box;
   GraphicsBool* m_vertex_rounding;
   GraphicsBool* m_save_texture_cache_state;
+  GraphicsBool* m_save_texture_cache_native;
 
   void CreateWidgets();
   void ConnectWidgets();
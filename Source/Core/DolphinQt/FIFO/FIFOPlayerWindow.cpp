@@ -138,8 +138,11 @@ void FIFOPlayerWindow::CreateWidgets()
   m_frame_record_count->setMaximum(3600);
   m_frame_record_count->setValue(3);
 
+  m_compress_recording = new ToolTipCheckBox(tr("Compress"));
+
   recording_layout->addWidget(m_frame_record_count_label);
   recording_layout->addWidget(m_frame_record_count);
+  recording_layout->addWidget(m_compress_recording);
   recording_group->setLayout(recording_layout);
 
   m_button_box = new QDialogButtonBox(QDialogButtonBox::Close);
@@ -175,6 +178,7 @@ void FIFOPlayerWindow::LoadSettings()
 {
   m_early_memory_updates->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES));
   m_loop->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_LOOP_REPLAY));
+  m_compress_recording->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_COMPRESS_RECORDINGS));
 }
 
 void FIFOPlayerWindow::ConnectWidgets()
@@ -186,6 +190,7 @@ void FIFOPlayerWindow::ConnectWidgets()
   connect(m_button_box, &QDialogButtonBox::rejected, this, &FIFOPlayerWindow::hide);
   connect(m_early_memory_updates, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
   connect(m_loop, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
+  connect(m_compress_recording, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
 
   connect(m_frame_range_from, qOverload<int>(&QSpinBox::valueChanged), this,
           &FIFOPlayerWindow::OnLimitsChanged);
@@ -208,9 +213,14 @@ void FIFOPlayerWindow::AddDescriptions()
       QT_TR_NOOP("If unchecked, then playback of the fifolog stops after the final frame.<br><br>"
                  "This is generally only useful when a frame-dumping option is enabled.<br><br>"
                  "<dolphin_emphasis>If unsure, leave this checked.</dolphin_emphasis>");
+  static const char TR_COMPRESS_DESCRIPTION[] = QT_TR_NOOP(
+      "If checked, then recorded data is compressed while recording, which makes fifologs much "
+      "smaller.<br><br>Compressed fifologs can't be played by older versions of Dolphin.<br><br>"
+      "<dolphin_emphasis>If unsure, leave this checked.</dolphin_emphasis>");
 
   m_early_memory_updates->SetDescription(tr(TR_MEMORY_UPDATES_DESCRIPTION));
   m_loop->SetDescription(tr(TR_LOOP_DESCRIPTION));
+  m_compress_recording->SetDescription(tr(TR_COMPRESS_DESCRIPTION));
 }
 
 void FIFOPlayerWindow::LoadRecording()
@@ -304,18 +314,14 @@ void FIFOPlayerWindow::UpdateInfo()
   if (FifoRecorder::GetInstance().IsRecordingDone())
   {
     FifoDataFile* file = FifoRecorder::GetInstance().GetRecordedFile();
-    size_t fifo_bytes = 0;
-    size_t mem_bytes = 0;
-
-    for (u32 i = 0; i < file->GetFrameCount(); ++i)
-    {
-      fifo_bytes += file->GetFrame(i).fifoData.size();
-      for (const auto& mem_update : file->GetFrame(i).memoryUpdates)
-        mem_bytes += mem_update.data.size();
-    }
+    u64 fifo_bytes = 0;
+    u64 mem_bytes = 0;
+    u64 stored_bytes = 0;
+    file->GetRecordedSizes(&fifo_bytes, &mem_bytes, &stored_bytes);
 
-    m_info_label->setText(tr("%1 FIFO bytes\n%2 memory bytes\n%3 frames")
+    m_info_label->setText(tr("%1 FIFO bytes\n%2 memory bytes\n%3 bytes stored\n%4 frames")
                               .arg(QString::number(fifo_bytes), QString::number(mem_bytes),
+                                   QString::number(stored_bytes),
                                    QString::number(file->GetFrameCount())));
     return;
   }
@@ -356,6 +362,7 @@ void FIFOPlayerWindow::OnConfigChanged()
   Config::SetBase(Config::MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES,
                   m_early_memory_updates->isChecked());
   Config::SetBase(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, m_loop->isChecked());
+  Config::SetBase(Config::MAIN_FIFOPLAYER_COMPRESS_RECORDINGS, m_compress_recording->isChecked());
 }
 
 void FIFOPlayerWindow::OnLimitsChanged()
@@ -396,6 +403,7 @@ void FIFOPlayerWindow::UpdateControls()
 
   m_frame_record_count_label->setEnabled(enable_frame_record_count);
   m_frame_record_count->setEnabled(enable_frame_record_count);
+  m_compress_recording->setEnabled(enable_frame_record_count);
 
   m_load->setEnabled(!running);
   m_record->setEnabled(running && !is_playing);
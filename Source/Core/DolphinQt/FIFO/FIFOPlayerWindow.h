@@ -66,6 +66,7 @@ private:
   QLabel* m_object_range_to_label;
   ToolTipCheckBox* m_early_memory_updates;
   ToolTipCheckBox* m_loop;
+  ToolTipCheckBox* m_compress_recording;
   QDialogButtonBox* m_button_box;
 
   QWidget* m_main_widget;
@@ -598,6 +598,9 @@ void HotkeyScheduler::Run()
     if (IsHotkey(HK_UNDO_SAVE_STATE))
       emit StateSaveUndo();
 
+    if (IsHotkey(HK_REWIND))
+      emit StateRewind();
+
     if (IsHotkey(HK_LOAD_STATE_FILE))
       emit StateLoadFile();
 
@@ -583,6 +583,7 @@ void MainWindow::ConnectHotkeys()
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadLastSaved, this,
           &MainWindow::StateLoadLastSavedAt);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadUndo, this, &MainWindow::StateLoadUndo);
+  connect(m_hotkey_scheduler, &HotkeyScheduler::StateRewind, this, &MainWindow::StateRewind);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveUndo, this, &MainWindow::StateSaveUndo);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveOldest, this,
           &MainWindow::StateSaveOldest);
@@ -1342,6 +1343,11 @@ void MainWindow::StateLoadUndo()
   State::UndoLoadState();
 }
 
+void MainWindow::StateRewind()
+{
+  State::Rewind();
+}
+
 void MainWindow::StateSaveUndo()
 {
   State::UndoSaveState();
@@ -41,6 +41,7 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/PowerPC/SignatureDB/SignatureDB.h"
 #include "Core/State.h"
 #include "Core/TitleDatabase.h"
@@ -62,6 +63,8 @@
 #include "UICommon/AutoUpdate.h"
 #include "UICommon/GameFile.h"
 
+#include "VideoCommon/DrawCapture.h"
+
 QPointer<MenuBar> MenuBar::s_menu_bar;
 
 QString MenuBar::GetSignatureSelector() const
@@ -131,6 +134,9 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_recording_play->setEnabled(m_game_selected && !running);
   m_recording_start->setEnabled((m_game_selected || running) && !Movie::IsPlayingInput());
 
+  // Tools
+  m_capture_draws->setEnabled(running);
+
   // JIT
   m_jit_interpreter_core->setEnabled(running);
   m_jit_block_linking->setEnabled(!running);
@@ -139,6 +145,9 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_jit_clear_cache->setEnabled(running);
   m_jit_log_coverage->setEnabled(!running);
   m_jit_search_instruction->setEnabled(running);
+  m_jit_sampling_profiler->setEnabled(running);
+  if (!running)
+    m_jit_sampling_profiler->setChecked(false);
 
   for (QAction* action :
        {m_jit_off, m_jit_loadstore_off, m_jit_loadstore_lbzx_off, m_jit_loadstore_lxz_off,
@@ -229,6 +238,8 @@ void MenuBar::AddToolsMenu()
   tools_menu->addAction(tr("&Cheats Manager"), this, [this] { emit ShowCheatsManager(); });
 
   tools_menu->addAction(tr("FIFO Player"), this, &MenuBar::ShowFIFOPlayer);
+  m_capture_draws = tools_menu->addAction(tr("Capture Draws of One Frame"), this,
+                                          [] { VideoCommon::g_draw_capture.Request(); });
 
   tools_menu->addSeparator();
 
@@ -757,6 +768,12 @@ void MenuBar::AddMovieMenu()
   connect(pause_at_end, &QAction::toggled,
           [](bool value) { Config::SetBaseOrCurrent(Config::MAIN_MOVIE_PAUSE_MOVIE, value); });
 
+  auto* fast_playback = movie_menu->addAction(tr("Fast Playback"));
+  fast_playback->setCheckable(true);
+  fast_playback->setChecked(Config::Get(Config::MAIN_MOVIE_FAST_PLAYBACK));
+  connect(fast_playback, &QAction::toggled,
+          [](bool value) { Config::SetBaseOrCurrent(Config::MAIN_MOVIE_FAST_PLAYBACK, value); });
+
   auto* rerecord_counter = movie_menu->addAction(tr("Show Rerecord Counter"));
   rerecord_counter->setCheckable(true);
   rerecord_counter->setChecked(Config::Get(Config::MAIN_MOVIE_SHOW_RERECORD));
@@ -850,6 +867,9 @@ void MenuBar::AddJITMenu()
       m_jit->addAction(tr("Log JIT Instruction Coverage"), this, &MenuBar::LogInstructions);
   m_jit_search_instruction =
       m_jit->addAction(tr("Search for an Instruction"), this, &MenuBar::SearchInstruction);
+  m_jit_sampling_profiler = m_jit->addAction(tr("Sampling Profiler"));
+  m_jit_sampling_profiler->setCheckable(true);
+  connect(m_jit_sampling_profiler, &QAction::toggled, this, &MenuBar::ToggleSamplingProfiler);
 
   m_jit->addSeparator();
 
@@ -1652,6 +1672,29 @@ void MenuBar::LogInstructions()
   PPCTables::LogCompiledInstructions();
 }
 
+void MenuBar::ToggleSamplingProfiler(bool enabled)
+{
+  if (enabled)
+  {
+    if (!SamplingProfiler::Start())
+    {
+      m_jit_sampling_profiler->setChecked(false);
+      ModalMessageBox::critical(this, tr("Error"),
+                                tr("The sampling profiler isn't supported on this system."));
+    }
+    return;
+  }
+
+  if (!SamplingProfiler::IsRunning())
+    return;
+
+  SamplingProfiler::Stop();
+  ModalMessageBox::information(
+      this, tr("Sampling Profiler"),
+      tr("The profile was written to %1.")
+          .arg(QString::fromStdString(SamplingProfiler::GetOutputPath())));
+}
+
 void MenuBar::SearchInstruction()
 {
   bool good;
@@ -178,6 +178,7 @@ private:
   void ClearCache();
   void LogInstructions();
   void SearchInstruction();
+  void ToggleSamplingProfiler(bool enabled);
 
   void OnSelectionChanged(std::shared_ptr<const UICommon::GameFile> game_file);
   void OnRecordingStatusChanged(bool recording);
@@ -196,6 +197,7 @@ private:
   QMenu* m_backup_menu;
 
   // Tools
+  QAction* m_capture_draws;
   QAction* m_wad_install_action;
   QMenu* m_perform_online_update_menu;
   QAction* m_perform_online_update_for_current_region;
@@ -261,6 +263,7 @@ private:
   QAction* m_jit_clear_cache;
   QAction* m_jit_log_coverage;
   QAction* m_jit_search_instruction;
+  QAction* m_jit_sampling_profiler;
   QAction* m_jit_off;
   QAction* m_jit_loadstore_off;
   QAction* m_jit_loadstore_lbzx_off;
@@ -206,6 +206,13 @@ void NetPlayDialog::CreateMainLayout()
   m_network_mode_group->addAction(m_host_input_authority_action);
   m_network_mode_group->addAction(m_golf_mode_action);
   m_fixed_delay_action->setChecked(true);
+  m_network_menu->addSeparator();
+  m_adaptive_buffer_action = m_network_menu->addAction(tr("Adaptive Buffer"));
+  m_adaptive_buffer_action->setToolTip(
+      tr("Adjusts the buffer size automatically, based on the measured latency and jitter of all "
+         "players.
+Only used with Fair Input Delay."));
+  m_adaptive_buffer_action->setCheckable(true);
 
   m_game_digest_menu = m_menu_bar->addMenu(tr("Checksum"));
   m_game_digest_menu->addAction(tr("Current game"), this, [this] {
@@ -376,6 +383,12 @@ void NetPlayDialog::ConnectWidgets()
   connect(m_golf_mode_action, &QAction::toggled, this, [hia_function] { hia_function(true); });
   connect(m_fixed_delay_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
 
+  connect(m_adaptive_buffer_action, &QAction::toggled, this, [](bool enable) {
+    auto server = Settings::Instance().GetNetPlayServer();
+    if (server)
+      server->SetAdaptiveBuffer(enable);
+  });
+
   connect(m_start_button, &QPushButton::clicked, this, &NetPlayDialog::OnStart);
   connect(m_quit_button, &QPushButton::clicked, this, &NetPlayDialog::reject);
 
@@ -423,6 +436,7 @@ void NetPlayDialog::ConnectWidgets()
   connect(m_golf_mode_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_golf_mode_overlay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_fixed_delay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_adaptive_buffer_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_hide_remote_gbas_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
 }
 
@@ -687,6 +701,20 @@ void NetPlayDialog::UpdateGUI()
       m_players_list->selectRow(i);
   }
 
+  if (g_netplay_chat_ui)
+  {
+    QStringList stats{m_host_input_authority ? tr("Max buffer: %1").arg(m_buffer_size) :
+                                               tr("Buffer: %1").arg(m_buffer_size)};
+    for (const auto* p : players)
+    {
+      stats.append(tr("%1: %2 ms (jitter %3 ms)")
+                       .arg(QString::fromStdString(p->name))
+                       .arg(p->ping)
+                       .arg(p->ping_jitter));
+    }
+    g_netplay_chat_ui->SetStats(stats.join(QLatin1Char('\n')).toStdString());
+  }
+
   if (m_old_player_count != m_player_count)
   {
     UpdateDiscordPresence();
@@ -920,6 +948,7 @@ void NetPlayDialog::OnPadBufferChanged(u32 buffer)
   QueueOnObject(this, [this, buffer] {
     const QSignalBlocker blocker(m_buffer_size_box);
     m_buffer_size_box->setValue(buffer);
+    UpdateGUI();
   });
   DisplayMessage(m_host_input_authority ? tr("Max buffer size changed to %1").arg(buffer) :
                                           tr("Buffer size changed to %1").arg(buffer),
@@ -1127,6 +1156,7 @@ void NetPlayDialog::LoadSettings()
   const bool strict_settings_sync = Config::Get(Config::NETPLAY_STRICT_SETTINGS_SYNC);
   const bool golf_mode_overlay = Config::Get(Config::NETPLAY_GOLF_MODE_OVERLAY);
   const bool hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
+  const bool adaptive_buffer = Config::Get(Config::NETPLAY_ADAPTIVE_BUFFER);
 
   m_buffer_size_box->setValue(buffer_size);
 
@@ -1143,6 +1173,7 @@ void NetPlayDialog::LoadSettings()
   m_strict_settings_sync_action->setChecked(strict_settings_sync);
   m_golf_mode_overlay_action->setChecked(golf_mode_overlay);
   m_hide_remote_gbas_action->setChecked(hide_remote_gbas);
+  m_adaptive_buffer_action->setChecked(adaptive_buffer);
 
   const std::string network_mode = Config::Get(Config::NETPLAY_NETWORK_MODE);
 
@@ -1186,6 +1217,7 @@ void NetPlayDialog::SaveSettings()
   Config::SetBase(Config::NETPLAY_STRICT_SETTINGS_SYNC, m_strict_settings_sync_action->isChecked());
   Config::SetBase(Config::NETPLAY_GOLF_MODE_OVERLAY, m_golf_mode_overlay_action->isChecked());
   Config::SetBase(Config::NETPLAY_HIDE_REMOTE_GBAS, m_hide_remote_gbas_action->isChecked());
+  Config::SetBase(Config::NETPLAY_ADAPTIVE_BUFFER, m_adaptive_buffer_action->isChecked());
 
   std::string network_mode;
   if (m_fixed_delay_action->isChecked())
@@ -81,6 +81,7 @@ void AudioPane::CreateWidgets()
   m_backend_label = new QLabel(tr("Audio Backend:"));
   m_backend_combo = new QComboBox();
   m_dolby_pro_logic = new QCheckBox(tr("Dolby Pro Logic II Decoder"));
+  m_high_quality_resampling = new QCheckBox(tr("High Quality Resampling"));
 
   if (m_latency_control_supported)
   {
@@ -96,6 +97,10 @@ void AudioPane::CreateWidgets()
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
 
+  m_high_quality_resampling->setToolTip(
+      tr("Resamples the audio with a windowed sinc filter instead of linear interpolation, which "
+         "reduces aliasing at a small CPU cost."));
+
   auto* dolby_quality_layout = new QHBoxLayout;
 
   m_dolby_quality_label = new QLabel(tr("Decoding Quality:"));
@@ -132,6 +137,7 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_wasapi_device_label, m_wasapi_device_combo);
 #endif
 
+  backend_layout->addRow(m_high_quality_resampling);
   backend_layout->addRow(m_dolby_pro_logic);
   backend_layout->addRow(m_dolby_quality_label);
   backend_layout->addRow(dolby_quality_layout);
@@ -184,6 +190,7 @@ void AudioPane::ConnectWidgets()
   }
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
+  connect(m_high_quality_resampling, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_stretching_enable, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_hle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
@@ -231,6 +238,9 @@ void AudioPane::LoadSettings()
   // Volume
   OnVolumeChanged(settings.GetVolume());
 
+  // Resampling
+  m_high_quality_resampling->setChecked(Config::Get(Config::MAIN_AUDIO_HIGH_QUALITY_RESAMPLING));
+
   // DPL2
   m_dolby_pro_logic->setChecked(Config::Get(Config::MAIN_DPL2_DECODER));
   m_dolby_quality_slider->setValue(int(Config::Get(Config::MAIN_DPL2_QUALITY)));
@@ -296,6 +306,10 @@ void AudioPane::SaveSettings()
     OnVolumeChanged(settings.GetVolume());
   }
 
+  // Resampling
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_HIGH_QUALITY_RESAMPLING,
+                           m_high_quality_resampling->isChecked());
+
   // DPL2
   Config::SetBaseOrCurrent(Config::MAIN_DPL2_DECODER, m_dolby_pro_logic->isChecked());
   Config::SetBase(Config::MAIN_DPL2_QUALITY,
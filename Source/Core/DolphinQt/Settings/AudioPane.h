@@ -59,6 +59,7 @@ private:
   QLabel* m_backend_label;
   QComboBox* m_backend_combo;
   QCheckBox* m_dolby_pro_logic;
+  QCheckBox* m_high_quality_resampling;
   QLabel* m_dolby_quality_label;
   QSlider* m_dolby_quality_slider;
   QLabel* m_dolby_quality_low_label;
@@ -3,18 +3,36 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
 #include <OptionParser.h>
+#include <fmt/format.h>
 
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/ScrubbedBlob.h"
+#include "DiscIO/StreamBlob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/VolumeDisc.h"
 #include "DiscIO/WIABlob.h"
@@ -27,7 +45,8 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
 {
   optparse::OptionParser parser;
 
-  parser.usage("usage: convert [options]... [FILE]...");
+  parser.usage("usage: convert [options]... [FILE]...\n"
+               "       convert --input_dir DIR --output_dir DIR [options]...");
 
   parser.add_option("-u", "--user")
       .action("store")
@@ -37,9 +56,15 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
   parser.add_option("-i", "--input")
       .type("string")
       .action("store")
-      .help("Path to disc image FILE.")
+      .help("Path to disc image FILE. Use - to read a plain disc image from stdin, for example "
+            "while it is being downloaded. Requires --input_size.")
       .metavar("FILE");
 
+  parser.add_option("--input_size")
+      .type("string")
+      .action("store")
+      .help("Size in bytes of the disc image read from stdin.");
+
   parser.add_option("-o", "--output")
       .type("string")
       .action("store")
@@ -75,6 +100,42 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
       .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
             "zstd: 5");
 
+  parser.add_option("--zstd_dictionary")
+      .action("store_true")
+      .help("Share a dictionary built from the disc between all RVZ chunks compressed with zstd. "
+            "Improves compression with small block sizes. Requires Dolphin with RVZ 1.1 support "
+            "to read the output.");
+
+  parser.add_option("-d", "--input_dir")
+      .type("string")
+      .action("store")
+      .help("Convert every disc image in DIR, instead of a single FILE. Requires --output_dir.")
+      .metavar("DIR");
+
+  parser.add_option("-L", "--input_list")
+      .type("string")
+      .action("store")
+      .help("Convert every disc image listed in FILE, one path per line. Requires --output_dir.")
+      .metavar("FILE");
+
+  parser.add_option("-O", "--output_dir")
+      .type("string")
+      .action("store")
+      .help("Directory to write batch conversions to. Images that were already converted there "
+            "are skipped, so an interrupted batch can be resumed by running it again.")
+      .metavar("DIR");
+
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Number of discs to convert at the same time in batch mode. Default is 2.");
+
+  parser.add_option("-t", "--threads")
+      .type("int")
+      .action("store")
+      .help("Total number of compression threads, shared between the discs being converted. "
+            "Default is the number of hardware threads.");
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -88,99 +149,119 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
 
   // Validate options
 
-  // --input
-  const std::string input_file_path = static_cast<const char*>(options.get("input"));
-  if (input_file_path.empty())
+  // --input_dir, --input_list, --output_dir
+  std::vector<std::string> batch_inputs;
+  const bool batch = options.is_set("input_dir") || options.is_set("input_list");
+  if (options.is_set("input_dir"))
   {
-    std::cerr << "Error: No input set" << std::endl;
-    return 1;
+    static const std::vector<std::string> disc_extensions = {
+        ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wia", ".rvz", ".nfs"};
+    batch_inputs = Common::DoFileSearch({static_cast<const char*>(options.get("input_dir"))},
+                                        disc_extensions);
   }
-
-  // --output
-  const std::string output_file_path = static_cast<const char*>(options.get("output"));
-  if (output_file_path.empty())
+  if (options.is_set("input_list"))
   {
-    std::cerr << "Error: No output set" << std::endl;
-    return 1;
+    std::ifstream list;
+    File::OpenFStream(list, static_cast<const char*>(options.get("input_list")), std::ios_base::in);
+    if (!list)
+    {
+      std::cerr << "Error: The input list could not be opened." << std::endl;
+      return 1;
+    }
+
+    std::string line;
+    while (std::getline(list, line))
+    {
+      line = StripWhitespace(line);
+      if (!line.empty())
+        batch_inputs.push_back(std::move(line));
+    }
   }
 
-  // --format
-  const std::optional<DiscIO::BlobType> format_o =
-      ParseFormatString(static_cast<const char*>(options.get("format")));
-  if (!format_o.has_value())
+  const std::string output_directory = static_cast<const char*>(options.get("output_dir"));
+  if (batch && output_directory.empty())
   {
-    std::cerr << "Error: No output format set" << std::endl;
+    std::cerr << "Error: No output directory set" << std::endl;
     return 1;
   }
-  const DiscIO::BlobType format = format_o.value();
 
-  // Open the blob reader
-  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
-  if (!blob_reader)
+  // --input
+  const std::string input_file_path = static_cast<const char*>(options.get("input"));
+  if (!batch && input_file_path.empty())
   {
-    std::cerr << "Error: The input file could not be opened." << std::endl;
+    std::cerr << "Error: No input set" << std::endl;
     return 1;
   }
 
-  // --scrub
-  const bool scrub = static_cast<bool>(options.get("scrub"));
-
-  // Open the volume
-  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
-  if (!volume)
+  // --input_size
+  ConversionSettings settings;
+  if (input_file_path == STDIN_PATH)
   {
-    if (scrub)
+    if (!TryParse(static_cast<const char*>(options.get("input_size")), &settings.input_size) ||
+        settings.input_size == 0)
     {
-      std::cerr << "Error: Scrubbing is only supported for GC/Wii disc images." << std::endl;
+      std::cerr << "Error: The size of the input must be set when reading from stdin" << std::endl;
       return 1;
     }
 
-    std::cerr << "Warning: The input file is not a GC/Wii disc image. Continuing anyway."
-              << std::endl;
-  }
-
-  if (scrub)
-  {
-    if (volume->IsDatelDisc())
+    if (static_cast<bool>(options.get("scrub")))
     {
-      std::cerr << "Error: Scrubbing a Datel disc is not supported." << std::endl;
+      std::cerr << "Error: Scrubbing is not supported when reading from stdin" << std::endl;
       return 1;
     }
+  }
 
-    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
-
-    if (!blob_reader)
-    {
-      std::cerr << "Error: Unable to process disc image. Try again without --scrub." << std::endl;
-      return 1;
-    }
+  // --output
+  const std::string output_file_path = static_cast<const char*>(options.get("output"));
+  if (!batch && output_file_path.empty())
+  {
+    std::cerr << "Error: No output set" << std::endl;
+    return 1;
   }
 
-  if (scrub && format == DiscIO::BlobType::RVZ)
+  // --jobs, --threads
+  int jobs = 1;
+  if (batch)
+    jobs = options.is_set("jobs") ? static_cast<int>(options.get("jobs")) : DEFAULT_BATCH_JOBS;
+
+  int threads = std::max<int>(1, std::thread::hardware_concurrency());
+  if (options.is_set("threads"))
+    threads = static_cast<int>(options.get("threads"));
+
+  if (jobs < 1 || threads < 1)
   {
-    std::cerr << "Warning: Scrubbing an RVZ container does not offer significant space advantages. "
-                 "Continuing anyway."
-              << std::endl;
+    std::cerr << "Error: The number of jobs and threads must be at least 1" << std::endl;
+    return 1;
   }
 
-  if (scrub && format == DiscIO::BlobType::PLAIN)
+  // Every disc gets an equal share of the threads, rather than each starting one per hardware
+  // thread and fighting over the cores.
+  settings.compression_threads = std::max(1, threads / jobs);
+
+  // --format
+  const std::optional<DiscIO::BlobType> format_o =
+      ParseFormatString(static_cast<const char*>(options.get("format")));
+  if (!format_o.has_value())
   {
-    std::cerr << "Warning: Scrubbing does not save space when converting to ISO unless using "
-                 "external compression. Continuing anyway."
-              << std::endl;
+    std::cerr << "Error: No output format set" << std::endl;
+    return 1;
   }
+  settings.format = format_o.value();
 
-  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
-      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
+  // --scrub
+  settings.scrub = static_cast<bool>(options.get("scrub"));
+
+  if (settings.scrub && settings.format == DiscIO::BlobType::RVZ)
   {
-    std::cerr << "Warning: Converting Wii disc images to GCZ without scrubbing may not offer space "
-                 "advantages over ISO. Continuing anyway."
+    std::cerr << "Warning: Scrubbing an RVZ container does not offer significant space advantages. "
+                 "Continuing anyway."
               << std::endl;
   }
 
-  if (volume && volume->IsNKit())
+  if (settings.scrub && settings.format == DiscIO::BlobType::PLAIN)
   {
-    std::cerr << "Warning: Converting an NKit file, output will still be NKit! Continuing anyway."
+    std::cerr << "Warning: Scrubbing does not save space when converting to ISO unless using "
+                 "external compression. Continuing anyway."
               << std::endl;
   }
 
@@ -189,8 +270,8 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
   if (options.is_set("block_size"))
     block_size_o = static_cast<int>(options.get("block_size"));
 
-  if (format == DiscIO::BlobType::GCZ || format == DiscIO::BlobType::WIA ||
-      format == DiscIO::BlobType::RVZ)
+  if (settings.format == DiscIO::BlobType::GCZ || settings.format == DiscIO::BlobType::WIA ||
+      settings.format == DiscIO::BlobType::RVZ)
   {
     if (!block_size_o.has_value())
     {
@@ -198,7 +279,7 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
       return 1;
     }
 
-    if (!DiscIO::IsDiscImageBlockSizeValid(block_size_o.value(), format))
+    if (!DiscIO::IsDiscImageBlockSizeValid(block_size_o.value(), settings.format))
     {
       std::cerr << "Error: Block size is not valid for this format" << std::endl;
       return 1;
@@ -211,15 +292,7 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
                 << std::endl;
     }
 
-    if (format == DiscIO::BlobType::GCZ && volume &&
-        !DiscIO::IsGCZBlockSizeLegacyCompatible(block_size_o.value(), volume->GetDataSize()))
-    {
-      std::cerr << "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, "
-                   "the file size must be an integer multiple of the block size "
-                   "and must not be an integer multiple of the block size multiplied by 32. "
-                   "Continuing anyway."
-                << std::endl;
-    }
+    settings.block_size = block_size_o.value();
   }
 
   // --compress, --compress_level
@@ -230,7 +303,7 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
   if (options.is_set("compression_level"))
     compression_level_o = static_cast<int>(options.get("compression_level"));
 
-  if (format == DiscIO::BlobType::WIA || format == DiscIO::BlobType::RVZ)
+  if (settings.format == DiscIO::BlobType::WIA || settings.format == DiscIO::BlobType::RVZ)
   {
     if (!compression_o.has_value())
     {
@@ -238,9 +311,9 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
       return 1;
     }
 
-    if ((format == DiscIO::BlobType::WIA &&
+    if ((settings.format == DiscIO::BlobType::WIA &&
          compression_o.value() == DiscIO::WIARVZCompressionType::Zstd) ||
-        (format == DiscIO::BlobType::RVZ &&
+        (settings.format == DiscIO::BlobType::RVZ &&
          compression_o.value() == DiscIO::WIARVZCompressionType::Purge))
     {
       std::cerr << "Error: Compression type is not supported for the container format" << std::endl;
@@ -268,6 +341,198 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
         return 1;
       }
     }
+
+    settings.compression = compression_o.value();
+    settings.compression_level = compression_level_o.value();
+  }
+
+  // --zstd_dictionary
+  settings.zstd_dictionary = static_cast<bool>(options.get("zstd_dictionary"));
+  if (settings.zstd_dictionary && (settings.format != DiscIO::BlobType::RVZ ||
+                                   settings.compression != DiscIO::WIARVZCompressionType::Zstd))
+  {
+    std::cerr << "Error: A zstd dictionary can only be used for RVZ with zstd compression"
+              << std::endl;
+    return 1;
+  }
+
+  if (batch)
+    return ConvertBatch(batch_inputs, output_directory, settings, jobs);
+
+  return ConvertDisc(input_file_path, output_file_path, settings) ? 0 : 1;
+}
+
+int ConvertCommand::ConvertBatch(const std::vector<std::string>& input_paths,
+                                 const std::string& output_directory,
+                                 const ConversionSettings& settings, unsigned int jobs)
+{
+  if (input_paths.empty())
+  {
+    std::cerr << "Error: No disc images to convert" << std::endl;
+    return 1;
+  }
+
+  if (!File::CreateFullPath(output_directory + '/'))
+  {
+    std::cerr << "Error: The output directory could not be created." << std::endl;
+    return 1;
+  }
+
+  m_batch = true;
+  const std::string extension = GetFormatExtension(settings.format);
+
+  std::atomic<size_t> next_index = 0;
+  std::atomic<size_t> converted = 0;
+  std::atomic<size_t> skipped = 0;
+  std::atomic<size_t> failed = 0;
+  std::atomic<u64> bytes_converted = 0;
+  const auto batch_start = std::chrono::steady_clock::now();
+
+  // Each job reads its disc on its own thread and feeds its own share of compression threads.
+  const auto job = [&] {
+    for (size_t i = next_index++; i < input_paths.size(); i = next_index++)
+    {
+      const std::string& input_path = input_paths[i];
+      std::string name;
+      SplitPath(input_path, nullptr, &name, nullptr);
+      const std::string output_path = output_directory + '/' + name + extension;
+
+      if (File::Exists(output_path))
+      {
+        PrintMessage(input_path, "Skipped, the output already exists.");
+        ++skipped;
+        continue;
+      }
+
+      // Converting to a temporary name means that an interrupted conversion isn't mistaken for a
+      // finished one when the batch is resumed.
+      const std::string partial_path = output_path + ".part";
+      const auto start = std::chrono::steady_clock::now();
+      if (!ConvertDisc(input_path, partial_path, settings) ||
+          !File::Rename(partial_path, output_path))
+      {
+        File::Delete(partial_path, File::IfAbsentBehavior::NoConsoleWarning);
+        PrintMessage(input_path, "Error: Conversion failed");
+        ++failed;
+        continue;
+      }
+
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      const u64 size = File::GetSize(input_path);
+      bytes_converted += size;
+      const size_t done = ++converted + skipped + failed;
+      PrintMessage(input_path,
+                   fmt::format("[{}/{}] Converted {:.1f} MiB in {:.1f} s ({:.1f} MiB/s)", done,
+                               input_paths.size(), size / double(1 << 20), elapsed.count(),
+                               size / double(1 << 20) / std::max(elapsed.count(), 0.001)));
+    }
+  };
+
+  std::vector<std::thread> job_threads;
+  for (unsigned int i = 1; i < std::min<size_t>(jobs, input_paths.size()); ++i)
+    job_threads.emplace_back(job);
+  job();
+  for (std::thread& thread : job_threads)
+    thread.join();
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - batch_start;
+  std::cout << fmt::format("Converted {}, skipped {}, failed {}. {:.1f} MiB in {:.1f} s "
+                           "({:.1f} MiB/s)",
+                           converted.load(), skipped.load(), failed.load(),
+                           bytes_converted / double(1 << 20), elapsed.count(),
+                           bytes_converted / double(1 << 20) / std::max(elapsed.count(), 0.001))
+            << std::endl;
+
+  return failed == 0 ? 0 : 1;
+}
+
+bool ConvertCommand::ConvertDisc(const std::string& input_file_path,
+                                 const std::string& output_file_path,
+                                 const ConversionSettings& settings)
+{
+  // A stream can only be read once, so it can't also be opened as a volume. The converters are
+  // given no path, so they don't try to.
+  const bool is_stream = input_file_path == STDIN_PATH;
+  const std::string converter_input_path = is_stream ? std::string() : input_file_path;
+
+  // Open the blob reader
+  std::unique_ptr<DiscIO::BlobReader> blob_reader;
+  if (is_stream)
+  {
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+#endif
+    blob_reader = DiscIO::StreamBlobReader::Create(File::IOFile(stdin), settings.input_size);
+  }
+  else
+  {
+    blob_reader = DiscIO::CreateBlobReader(input_file_path);
+  }
+
+  if (!blob_reader)
+  {
+    PrintMessage(input_file_path, "Error: The input file could not be opened.");
+    return false;
+  }
+
+  // Open the volume
+  std::unique_ptr<DiscIO::Volume> volume;
+  if (!is_stream)
+    volume = DiscIO::CreateDisc(input_file_path);
+
+  if (!volume && !is_stream)
+  {
+    if (settings.scrub)
+    {
+      PrintMessage(input_file_path,
+                   "Error: Scrubbing is only supported for GC/Wii disc images.");
+      return false;
+    }
+
+    PrintMessage(input_file_path,
+                 "Warning: The input file is not a GC/Wii disc image. Continuing anyway.");
+  }
+
+  if (settings.scrub)
+  {
+    if (volume->IsDatelDisc())
+    {
+      PrintMessage(input_file_path, "Error: Scrubbing a Datel disc is not supported.");
+      return false;
+    }
+
+    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
+
+    if (!blob_reader)
+    {
+      PrintMessage(input_file_path,
+                   "Error: Unable to process disc image. Try again without --scrub.");
+      return false;
+    }
+  }
+
+  if (!settings.scrub && settings.format == DiscIO::BlobType::GCZ && volume &&
+      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
+  {
+    PrintMessage(input_file_path,
+                 "Warning: Converting Wii disc images to GCZ without scrubbing may not offer "
+                 "space advantages over ISO. Continuing anyway.");
+  }
+
+  if (volume && volume->IsNKit())
+  {
+    PrintMessage(input_file_path,
+                 "Warning: Converting an NKit file, output will still be NKit! Continuing anyway.");
+  }
+
+  if (settings.format == DiscIO::BlobType::GCZ && volume &&
+      !DiscIO::IsGCZBlockSizeLegacyCompatible(settings.block_size, volume->GetDataSize()))
+  {
+    PrintMessage(input_file_path,
+                 "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, "
+                 "the file size must be an integer multiple of the block size "
+                 "and must not be an integer multiple of the block size multiplied by 32. "
+                 "Continuing anyway.");
   }
 
   // Perform the conversion
@@ -275,11 +540,11 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
 
   bool success = false;
 
-  switch (format)
+  switch (settings.format)
   {
   case DiscIO::BlobType::PLAIN:
   {
-    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
+    success = DiscIO::ConvertToPlain(blob_reader.get(), converter_input_path, output_file_path,
                                      NOOP_STATUS_CALLBACK);
     break;
   }
@@ -294,18 +559,20 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
       else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
         sub_type = 1;
     }
-    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
-                                   block_size_o.value(), NOOP_STATUS_CALLBACK);
+    success = DiscIO::ConvertToGCZ(blob_reader.get(), converter_input_path, output_file_path,
+                                   sub_type, settings.block_size, NOOP_STATUS_CALLBACK,
+                                   settings.compression_threads);
     break;
   }
 
   case DiscIO::BlobType::WIA:
   case DiscIO::BlobType::RVZ:
   {
-    success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
-                                        format == DiscIO::BlobType::RVZ, compression_o.value(),
-                                        compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
+    success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), converter_input_path, output_file_path,
+                                        settings.format == DiscIO::BlobType::RVZ,
+                                        settings.compression, settings.compression_level,
+                                        settings.block_size, NOOP_STATUS_CALLBACK,
+                                        settings.compression_threads, settings.zstd_dictionary);
     break;
   }
 
@@ -316,13 +583,23 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
   }
   }
 
-  if (!success)
+  if (!success && !m_batch)
+    PrintMessage(input_file_path, "Error: Conversion failed");
+
+  return success;
+}
+
+void ConvertCommand::PrintMessage(const std::string& input_file_path, std::string_view message)
+{
+  if (!m_batch)
   {
-    std::cerr << "Error: Conversion failed" << std::endl;
-    return 1;
+    std::cerr << message << std::endl;
+    return;
   }
 
-  return 0;
+  // Several discs are converted at once, so say which one the message is about.
+  std::lock_guard lk(m_output_lock);
+  std::cerr << input_file_path << ": " << message << std::endl;
 }
 
 std::optional<DiscIO::WIARVZCompressionType>
@@ -344,6 +621,21 @@ ConvertCommand::ParseCompressionTypeString(const std::string& compression_str)
     return std::nullopt;
 }
 
+std::string ConvertCommand::GetFormatExtension(DiscIO::BlobType format)
+{
+  switch (format)
+  {
+  case DiscIO::BlobType::GCZ:
+    return ".gcz";
+  case DiscIO::BlobType::WIA:
+    return ".wia";
+  case DiscIO::BlobType::RVZ:
+    return ".rvz";
+  default:
+    return ".iso";
+  }
+}
+
 std::optional<DiscIO::BlobType> ConvertCommand::ParseFormatString(const std::string& format_str)
 {
   if (format_str == "iso")
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "Common/CommonTypes.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/WIABlob.h"
 #include "DolphinTool/Command.h"
@@ -19,9 +22,35 @@ public:
   int Main(const std::vector<std::string>& args) override;
 
 private:
+  static constexpr int DEFAULT_BATCH_JOBS = 2;
+  static constexpr const char* STDIN_PATH = "-";
+
+  struct ConversionSettings
+  {
+    DiscIO::BlobType format = DiscIO::BlobType::PLAIN;
+    bool scrub = false;
+    int block_size = 0;
+    DiscIO::WIARVZCompressionType compression = DiscIO::WIARVZCompressionType::None;
+    int compression_level = 0;
+    bool zstd_dictionary = false;
+    unsigned int compression_threads = 0;
+    u64 input_size = 0;  // Only used when reading from stdin
+  };
+
+  int ConvertBatch(const std::vector<std::string>& input_paths,
+                   const std::string& output_directory, const ConversionSettings& settings,
+                   unsigned int jobs);
+  bool ConvertDisc(const std::string& input_file_path, const std::string& output_file_path,
+                   const ConversionSettings& settings);
+  void PrintMessage(const std::string& input_file_path, std::string_view message);
+
+  std::string GetFormatExtension(DiscIO::BlobType format);
   std::optional<DiscIO::WIARVZCompressionType>
   ParseCompressionTypeString(const std::string& compression_str);
   std::optional<DiscIO::BlobType> ParseFormatString(const std::string& format_str);
+
+  bool m_batch = false;
+  std::mutex m_output_lock;
 };
 
 }  // namespace DolphinTool
@@ -11,12 +11,19 @@
 #include "DolphinTool/Command.h"
 #include "DolphinTool/ConvertCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#ifdef HAS_VULKAN
+#include "DolphinTool/UberShadersCommand.h"
+#endif
 #include "DolphinTool/VerifyCommand.h"
 
 static int PrintUsage(int code)
 {
   std::cerr << "usage: dolphin-tool COMMAND -h" << std::endl << std::endl;
+#ifdef HAS_VULKAN
+  std::cerr << "commands supported: [convert, verify, header, ubershaders]" << std::endl;
+#else
   std::cerr << "commands supported: [convert, verify, header]" << std::endl;
+#endif
 
   return code;
 }
@@ -45,6 +52,10 @@ int main(int argc, char* argv[])
     command = std::make_unique<DolphinTool::VerifyCommand>();
   else if (command_str == "header")
     command = std::make_unique<DolphinTool::HeaderCommand>();
+#ifdef HAS_VULKAN
+  else if (command_str == "ubershaders")
+    command = std::make_unique<DolphinTool::UberShadersCommand>();
+#endif
   else
     return PrintUsage(1);
 
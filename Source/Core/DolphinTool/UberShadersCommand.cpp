@@ -0,0 +1,186 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/UberShadersCommand.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <OptionParser.h>
+
+#include "Common/FileUtil.h"
+#include "VideoBackends/Vulkan/ShaderCompiler.h"
+#include "VideoBackends/Vulkan/VulkanContext.h"
+#include "VideoCommon/AbstractShader.h"
+#include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/Spirv.h"
+#include "VideoCommon/UberShaderPixel.h"
+#include "VideoCommon/UberShaderVertex.h"
+#include "VideoCommon/VideoBackendBase.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace DolphinTool
+{
+namespace
+{
+// Device features which change the generated ubershaders. The remaining host config comes from
+// the default graphics settings, since that's what most users run with.
+struct DeviceProfile
+{
+  const char* name;
+  bool dual_source_blend;
+  bool fragment_stores_and_atomics;
+  bool sample_rate_shading;
+  bool logic_op;
+  bool depth_clamp;
+  bool subgroup_operations;
+};
+
+constexpr DeviceProfile DEVICE_PROFILES[] = {
+    {"desktop", true, true, true, true, true, true},
+    {"mobile", true, true, true, false, false, true},
+    {"baseline", false, false, false, false, false, false},
+};
+
+void SetDeviceProfile(const DeviceProfile& profile)
+{
+  g_Config.backend_info = {};
+  Vulkan::VulkanContext::PopulateBackendInfo(&g_Config);
+  g_Config.backend_info.bSupportsDualSourceBlend = profile.dual_source_blend;
+  g_Config.backend_info.bSupportsBBox = profile.fragment_stores_and_atomics;
+  g_Config.backend_info.bSupportsFragmentStoresAndAtomics = profile.fragment_stores_and_atomics;
+  g_Config.backend_info.bSupportsSSAA = profile.sample_rate_shading;
+  g_Config.backend_info.bSupportsLogicOp = profile.logic_op;
+  g_Config.backend_info.bSupportsDepthClamp = profile.depth_clamp;
+#ifndef __APPLE__
+  g_Config.backend_info.bSupportsLodBiasInSampler = true;
+#endif
+
+  g_ActiveConfig = g_Config;
+  g_ActiveConfig.bShaderCache = true;
+  g_ActiveConfig.bEnableValidationLayer = false;
+}
+
+using CompileJob = std::function<bool()>;
+
+bool RunJobs(const std::vector<CompileJob>& jobs)
+{
+  std::atomic<size_t> next_job{0};
+  std::atomic<bool> success{true};
+  auto worker = [&] {
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++)
+    {
+      if (!jobs[i]())
+        success = false;
+    }
+  };
+
+  std::vector<std::thread> threads(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+  for (std::thread& thread : threads)
+    thread = std::thread(worker);
+  worker();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  return success;
+}
+}  // namespace
+
+int UberShadersCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: ubershaders [options]...");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the prebuilt SPIR-V cache FILE to write.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  const std::string output_file_path = static_cast<const char*>(options.get("output"));
+  if (output_file_path.empty())
+  {
+    std::cerr << "Error: No output set" << std::endl;
+    return 1;
+  }
+
+  // The cache is appended to, so start from scratch in case it's from another version.
+  File::Delete(output_file_path);
+  SPIRV::SetCacheFileName(output_file_path);
+
+  VideoBackendBase::ActivateBackend("Vulkan");
+  g_Config.Refresh();
+
+  size_t num_shaders = 0;
+  bool success = true;
+  for (const DeviceProfile& profile : DEVICE_PROFILES)
+  {
+    SetDeviceProfile(profile);
+    const ShaderHostConfig host_config = ShaderHostConfig::GetCurrent();
+
+    // The shaders are generated up front, since generating them reads g_ActiveConfig.
+    std::vector<CompileJob> jobs;
+    auto add_job = [&jobs, &profile](ShaderStage stage, ShaderCode code) {
+      jobs.emplace_back([stage, code = std::move(code), &profile] {
+        return Vulkan::ShaderCompiler::PrecompileShader(stage, code.GetBuffer(),
+                                                        profile.subgroup_operations)
+            .has_value();
+      });
+    };
+
+    UberShader::EnumerateVertexShaderUids([&](const UberShader::VertexShaderUid& uid) {
+      add_job(ShaderStage::Vertex,
+              UberShader::GenVertexShader(APIType::Vulkan, host_config, uid.GetUidData()));
+    });
+
+    // Several UIDs map to the same shader once the bits this host config doesn't use are cleared.
+    std::set<UberShader::PixelShaderUid> pixel_shader_uids;
+    UberShader::EnumeratePixelShaderUids([&](const UberShader::PixelShaderUid& uid) {
+      UberShader::PixelShaderUid cleared_uid = uid;
+      UberShader::ClearUnusedPixelShaderUidBits(APIType::Vulkan, host_config, &cleared_uid);
+      pixel_shader_uids.insert(cleared_uid);
+    });
+    for (const UberShader::PixelShaderUid& uid : pixel_shader_uids)
+    {
+      add_job(ShaderStage::Pixel,
+              UberShader::GenPixelShader(APIType::Vulkan, host_config, uid.GetUidData()));
+    }
+
+    std::cout << "Compiling " << jobs.size() << " ubershaders for the " << profile.name
+              << " profile" << std::endl;
+
+    num_shaders += jobs.size();
+
+    // Compile one on this thread first, so that glslang is initialized before the workers start.
+    if (!jobs.empty())
+    {
+      success = jobs.back()() && success;
+      jobs.pop_back();
+    }
+    success = RunJobs(jobs) && success;
+  }
+
+  SPIRV::SetCacheFileName({});
+
+  if (!success)
+  {
+    std::cerr << "Error: Failed to compile some ubershaders" << std::endl;
+    File::Delete(output_file_path);
+    return 1;
+  }
+
+  std::cout << "Wrote " << num_shaders << " ubershaders to " << output_file_path << std::endl;
+  return 0;
+}
+
+}  // namespace DolphinTool
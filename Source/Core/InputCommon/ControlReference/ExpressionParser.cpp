@@ -44,6 +44,11 @@ public:
 
   bool IsSuppressed(Device::Input* input) const
   {
+    // This is checked for every control of every mapping on every update, while suppressions only
+    // exist as long as a hotkey with modifiers is held, so skip the lookups in the common case.
+    if (m_suppressions.empty())
+      return false;
+
     // Input is suppressed if it exists in the map at all.
     return m_suppressions.lower_bound({input, nullptr}) !=
            m_suppressions.lower_bound({input + 1, nullptr});
@@ -294,6 +299,9 @@ private:
 bool HotkeySuppressions::IsSuppressedIgnoringModifiers(Device::Input* input,
                                                        const Modifiers& ignore_modifiers) const
 {
+  if (m_suppressions.empty())
+    return false;
+
   // Input is suppressed if it exists in the map with a modifier that we aren't ignoring.
   auto it = m_suppressions.lower_bound({input, nullptr});
   auto it_end = m_suppressions.lower_bound({input + 1, nullptr});
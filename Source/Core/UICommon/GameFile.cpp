@@ -63,6 +63,15 @@ bool UseGameCovers()
   return Config::Get(Config::MAIN_USE_GAME_COVERS);
 #endif
 }
+
+FileStamp GetFileStamp(const std::string& path)
+{
+  if (path.empty())
+    return {};
+
+  const File::FileInfo info(path);
+  return {info.GetSize(), info.GetModificationTime()};
+}
 }  // Anonymous namespace
 
 DiscIO::Language GameFile::GetConfigLanguage() const
@@ -114,6 +123,7 @@ GameFile::GameFile() = default;
 GameFile::GameFile(std::string path) : m_file_path(std::move(path))
 {
   m_file_name = PathToFileName(m_file_path);
+  m_file_stamp = GetFileStamp(m_file_path);
 
   {
     std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolume(m_file_path));
@@ -207,6 +217,11 @@ bool GameFile::IsValid() const
   return true;
 }
 
+bool GameFile::IsOutdated() const
+{
+  return GetFileStamp(m_file_path) != m_file_stamp;
+}
+
 bool GameFile::CustomCoverChanged()
 {
   if (!m_custom_cover.buffer.empty() || !UseGameCovers())
@@ -341,11 +356,18 @@ void GameCover::DoState(PointerWrap& p)
   p.Do(buffer);
 }
 
+void FileStamp::DoState(PointerWrap& p)
+{
+  p.Do(size);
+  p.Do(modification_time);
+}
+
 void GameFile::DoState(PointerWrap& p)
 {
   p.Do(m_valid);
   p.Do(m_file_path);
   p.Do(m_file_name);
+  m_file_stamp.DoState(p);
 
   p.Do(m_file_size);
   p.Do(m_volume_size);
@@ -379,6 +401,8 @@ void GameFile::DoState(PointerWrap& p)
   p.Do(m_custom_maker);
   m_volume_banner.DoState(p);
   m_custom_banner.DoState(p);
+  p.Do(m_custom_banner_path);
+  m_custom_banner_stamp.DoState(p);
   m_default_cover.DoState(p);
   m_custom_cover.DoState(p);
 }
@@ -500,45 +524,57 @@ bool GameFile::ReadPNGBanner(const std::string& path)
   return true;
 }
 
-bool GameFile::TryLoadGameModDescriptorBanner()
+std::string GameFile::GetCustomBannerPath() const
 {
-  if (m_blob_type != DiscIO::BlobType::MOD_DESCRIPTOR)
-    return false;
+  std::string path, name;
+  SplitPath(m_file_path, &path, &name, nullptr);
 
-  auto descriptor = DiscIO::ParseGameModDescriptorFile(m_file_path);
-  if (!descriptor)
-    return false;
+  // This icon naming format is intended as an alternative to the Homebrew Channel naming
+  // for those who don't want to have a Homebrew Channel style folder structure.
+  std::string banner_path = path + name + ".png";
+  if (File::IsFile(banner_path))
+    return banner_path;
+
+  // Homebrew Channel icon naming. Typical for DOLs and ELFs, but we also support it for volumes.
+  banner_path = path + "icon.png";
+  if (File::IsFile(banner_path))
+    return banner_path;
 
-  return ReadPNGBanner(descriptor->banner);
+  // If it's a game mod descriptor file, it may specify its own custom banner.
+  if (m_blob_type == DiscIO::BlobType::MOD_DESCRIPTOR)
+  {
+    auto descriptor = DiscIO::ParseGameModDescriptorFile(m_file_path);
+    if (descriptor && File::IsFile(descriptor->banner))
+      return descriptor->banner;
+  }
+
+  return {};
 }
 
 bool GameFile::CustomBannerChanged()
 {
-  std::string path, name;
-  SplitPath(m_file_path, &path, &name, nullptr);
-
-  // This icon naming format is intended as an alternative to the Homebrew Channel naming
-  // for those who don't want to have a Homebrew Channel style folder structure.
-  if (!ReadPNGBanner(path + name + ".png"))
+  // Decoding a PNG for every game each time the game list is refreshed adds up, so the banner
+  // is only read again if the file it comes from has been replaced or modified.
+  m_pending.custom_banner_path = GetCustomBannerPath();
+  m_pending.custom_banner_stamp = GetFileStamp(m_pending.custom_banner_path);
+  if (m_pending.custom_banner_path == m_custom_banner_path &&
+      m_pending.custom_banner_stamp == m_custom_banner_stamp)
   {
-    // Homebrew Channel icon naming. Typical for DOLs and ELFs, but we also support it for volumes.
-    if (!ReadPNGBanner(path + "icon.png"))
-    {
-      // If it's a game mod descriptor file, it may specify its own custom banner.
-      if (!TryLoadGameModDescriptorBanner())
-      {
-        // If no custom icon is found, go back to the non-custom one.
-        m_pending.custom_banner = {};
-      }
-    }
+    return false;
   }
 
-  return m_pending.custom_banner != m_custom_banner;
+  // If no custom icon is found, go back to the non-custom one.
+  if (m_pending.custom_banner_path.empty() || !ReadPNGBanner(m_pending.custom_banner_path))
+    m_pending.custom_banner = {};
+
+  return true;
 }
 
 void GameFile::CustomBannerCommit()
 {
   m_custom_banner = std::move(m_pending.custom_banner);
+  m_custom_banner_path = std::move(m_pending.custom_banner_path);
+  m_custom_banner_stamp = m_pending.custom_banner_stamp;
 }
 
 const std::string& GameFile::GetName(const Core::TitleDatabase& title_database) const
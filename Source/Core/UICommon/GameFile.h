@@ -38,6 +38,16 @@ struct GameCover
   void DoState(PointerWrap& p);
 };
 
+// The size and modification time of a file, which are enough to notice that it has changed
+// without opening it.
+struct FileStamp
+{
+  u64 size{};
+  s64 modification_time{};
+  bool operator==(const FileStamp&) const = default;
+  void DoState(PointerWrap& p);
+};
+
 bool operator==(const GameBanner& lhs, const GameBanner& rhs);
 bool operator!=(const GameBanner& lhs, const GameBanner& rhs);
 
@@ -57,6 +67,8 @@ public:
   ~GameFile();
 
   bool IsValid() const;
+  // Only stats the file, so this is cheap enough to call for every game on each scan.
+  bool IsOutdated() const;
   const std::string& GetFilePath() const { return m_file_path; }
   const std::string& GetFileName() const { return m_file_name; }
   const std::string& GetName(const Core::TitleDatabase& title_database) const;
@@ -133,7 +145,7 @@ private:
   bool IsElfOrDol() const;
   bool ReadXMLMetadata(const std::string& path);
   bool ReadPNGBanner(const std::string& path);
-  bool TryLoadGameModDescriptorBanner();
+  std::string GetCustomBannerPath() const;
 
   // IMPORTANT: Nearly all data members must be save/restored in DoState.
   // If anything is changed, make sure DoState handles it properly and
@@ -142,6 +154,7 @@ private:
   bool m_valid{};
   std::string m_file_path;
   std::string m_file_name;
+  FileStamp m_file_stamp{};
 
   u64 m_file_size{};
   u64 m_volume_size{};
@@ -175,6 +188,8 @@ private:
   std::string m_custom_maker;
   GameBanner m_volume_banner{};
   GameBanner m_custom_banner{};
+  std::string m_custom_banner_path;
+  FileStamp m_custom_banner_stamp{};
   GameCover m_default_cover{};
   GameCover m_custom_cover{};
 
@@ -187,6 +202,8 @@ private:
     std::string custom_maker;
     GameBanner volume_banner;
     GameBanner custom_banner;
+    std::string custom_banner_path;
+    FileStamp custom_banner_stamp;
     GameCover default_cover;
     GameCover custom_cover;
   } m_pending{};
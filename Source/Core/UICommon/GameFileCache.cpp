@@ -5,11 +5,16 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <deque>
 #include <functional>
+#include <future>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -19,6 +24,8 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -26,7 +33,16 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 23;  // Last changed in PR 10932
+static constexpr u32 CACHE_MAGIC = 0x43474C44;  // "DLGC"
+static constexpr u32 CACHE_REVISION = 24;
+
+// Below this, starting threads would take longer than deserializing the games.
+static constexpr u32 MIN_RECORDS_PER_LOAD_THREAD = 64;
+
+// Reading the metadata of a game is mostly spent waiting for storage, so several games are read
+// at once even on machines with few cores.
+static constexpr unsigned int MIN_SCAN_THREADS = 4;
+static constexpr unsigned int MAX_SCAN_THREADS = 16;
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -104,6 +120,8 @@ bool GameFileCache::Update(
 
   // Delete paths that aren't in game_paths from m_cached_files,
   // while simultaneously deleting paths that are in m_cached_files from game_paths.
+  // Files that have changed on disk since they were cached are deleted too, and left in
+  // game_paths so that they get read again.
   // For the sake of speed, we don't care about maintaining the order of m_cached_files.
   {
     auto it = m_cached_files.begin();
@@ -113,8 +131,9 @@ bool GameFileCache::Update(
       if (processing_halted)
         break;
 
-      if (game_paths.erase((*it)->GetFilePath()))
+      if (game_paths.contains((*it)->GetFilePath()) && !(*it)->IsOutdated())
       {
+        game_paths.erase((*it)->GetFilePath());
         ++it;
       }
       else
@@ -132,12 +151,33 @@ bool GameFileCache::Update(
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
+  // The files are read on a few threads at a time, but added in order on this thread.
+  const std::vector<std::string> paths_to_add(game_paths.begin(), game_paths.end());
+  const unsigned int max_pending =
+      std::clamp(std::thread::hardware_concurrency(), MIN_SCAN_THREADS, MAX_SCAN_THREADS);
+  std::deque<std::future<std::shared_ptr<GameFile>>> pending;
+  auto next_path = paths_to_add.begin();
+
+  while (true)
   {
-    if (processing_halted)
+    while (!processing_halted && next_path != paths_to_add.end() && pending.size() < max_pending)
+    {
+      pending.push_back(std::async(std::launch::async, [&path = *next_path] {
+        return std::make_shared<GameFile>(path);
+      }));
+      ++next_path;
+    }
+
+    if (pending.empty())
       break;
 
-    auto file = std::make_shared<GameFile>(path);
+    auto file = pending.front().get();
+    pending.pop_front();
+
+    // Files that are still being read when processing is halted are waited for but discarded.
+    if (processing_halted)
+      continue;
+
     if (file->IsValid())
     {
       if (game_added_to_cache)
@@ -210,79 +250,155 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
 
 bool GameFileCache::Load()
 {
-  return SyncCacheFile(false);
+  File::MappedFile file;
+  if (!file.Open(m_path))
+    return false;
+
+  if (!ReadCacheFile(file.GetData(), file.GetSize()))
+  {
+    // The cache is probably corrupted or from another version, so delete it
+    file.Close();
+    File::Delete(m_path);
+    return false;
+  }
+
+  return true;
 }
 
 bool GameFileCache::Save()
 {
-  return SyncCacheFile(true);
+  const std::vector<u8> buffer = WriteCacheFile();
+  File::IOFile f(m_path, "wb");
+  if (f && f.WriteBytes(buffer.data(), buffer.size()))
+    return true;
+
+  // If some file operation failed, try to delete the probably-corrupted cache
+  f.Close();
+  File::Delete(m_path);
+  return false;
 }
 
-bool GameFileCache::SyncCacheFile(bool save)
+std::vector<u8> GameFileCache::WriteCacheFile() const
 {
-  const char* open_mode = save ? "wb" : "rb";
-  File::IOFile f(m_path, open_mode);
-  if (!f)
-    return false;
-  bool success = false;
-  if (save)
+  const size_t num_records = m_cached_files.size();
+  const u64 data_start = sizeof(CacheHeader) + sizeof(CacheRecord) * num_records;
+
+  std::vector<CacheRecord> records(num_records);
+  u64 offset = data_start;
+  for (size_t i = 0; i < num_records; i++)
   {
-    // Measure the size of the buffer.
     u8* ptr = nullptr;
     PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
-    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
+    m_cached_files[i]->DoState(p_measure);
+
+    CacheRecord& record = records[i];
+    record.path_offset = offset;
+    record.path_length = static_cast<u32>(m_cached_files[i]->GetFilePath().size());
+    record.state_offset = record.path_offset + record.path_length;
+    record.state_size = reinterpret_cast<size_t>(ptr);
+    offset = record.state_offset + record.state_size;
   }
-  else
-  {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
-    {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
-    }
-  }
-  if (!success)
+
+  std::vector<u8> buffer(offset);
+  const CacheHeader header{CACHE_MAGIC, CACHE_REVISION, static_cast<u32>(num_records),
+                           sizeof(CacheRecord), offset};
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  if (num_records != 0)
+    std::memcpy(buffer.data() + sizeof(header), records.data(), sizeof(CacheRecord) * num_records);
+
+  for (size_t i = 0; i < num_records; i++)
   {
-    // If some file operation failed, try to delete the probably-corrupted cache
-    f.Close();
-    File::Delete(m_path);
+    const CacheRecord& record = records[i];
+    const std::string& path = m_cached_files[i]->GetFilePath();
+    std::memcpy(buffer.data() + record.path_offset, path.data(), path.size());
+
+    u8* ptr = buffer.data() + record.state_offset;
+    PointerWrap p(&ptr, record.state_size, PointerWrap::Mode::Write);
+    m_cached_files[i]->DoState(p);
   }
-  return success;
+
+  return buffer;
 }
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
+bool GameFileCache::ReadCacheFile(const u8* data, size_t size)
 {
-  struct
-  {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
+  CacheHeader header;
+  if (size < sizeof(header))
+    return false;
+
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != CACHE_MAGIC || header.revision != CACHE_REVISION ||
+      header.record_size != sizeof(CacheRecord) || header.file_size != size ||
+      sizeof(CacheRecord) * u64{header.num_records} > size - sizeof(header))
   {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
+    return false;
+  }
+
+  const auto is_in_bounds = [size](u64 offset, u64 length) {
+    return offset <= size && length <= size - offset;
+  };
+
+  // Returns nullptr if the record is damaged, so that only that game has to be scanned again.
+  const auto read_record = [&](u32 index) -> std::shared_ptr<GameFile> {
+    CacheRecord record;
+    std::memcpy(&record, data + sizeof(header) + sizeof(CacheRecord) * index, sizeof(record));
+    if (!is_in_bounds(record.path_offset, record.path_length) ||
+        !is_in_bounds(record.state_offset, record.state_size))
     {
-      p->SetMeasureMode();
-      return;
+      return nullptr;
     }
+
+    // PointerWrap only reads in read mode, so the mapping isn't written to.
+    u8* ptr = const_cast<u8*>(data + record.state_offset);
+    u8* const end = ptr + record.state_size;
+    PointerWrap p(&ptr, record.state_size, PointerWrap::Mode::Read);
+    auto file = std::make_shared<GameFile>();
+    file->DoState(p);
+
+    const std::string_view path(reinterpret_cast<const char*>(data + record.path_offset),
+                                record.path_length);
+    if (!p.IsReadMode() || ptr != end || file->GetFilePath() != path)
+      return nullptr;
+
+    return file;
+  };
+
+  // Deserializing is mostly copying names and images around, which is spread across threads for
+  // large libraries. Pages of the mapping are only read from disk as they are reached.
+  std::vector<std::shared_ptr<GameFile>> files(header.num_records);
+  const u32 num_threads = std::clamp<u32>(header.num_records / MIN_RECORDS_PER_LOAD_THREAD, 1,
+                                          std::max(std::thread::hardware_concurrency(), 1u));
+  const auto read_range = [&](u32 begin, u32 end) {
+    for (u32 i = begin; i < end; i++)
+      files[i] = read_record(i);
+  };
+
+  std::vector<std::future<void>> futures;
+  const u32 per_thread = (header.num_records + num_threads - 1) / num_threads;
+  for (u32 begin = per_thread; begin < header.num_records; begin += per_thread)
+  {
+    futures.push_back(std::async(std::launch::async, read_range, begin,
+                                 std::min(begin + per_thread, header.num_records)));
+  }
+  read_range(0, std::min(per_thread, header.num_records));
+  for (std::future<void>& future : futures)
+    future.get();
+
+  m_cached_files.clear();
+  m_cached_files.reserve(files.size());
+  for (std::shared_ptr<GameFile>& file : files)
+  {
+    if (file)
+      m_cached_files.push_back(std::move(file));
+  }
+
+  if (m_cached_files.size() != files.size())
+  {
+    WARN_LOG_FMT(COMMON, "Dropped {} damaged entries from the game list cache",
+                 files.size() - m_cached_files.size());
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
-  });
+
+  return true;
 }
 
 }  // namespace UICommon
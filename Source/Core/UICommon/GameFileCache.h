@@ -12,8 +12,6 @@
 
 #include "Common/CommonTypes.h"
 
-class PointerWrap;
-
 namespace UICommon
 {
 class GameFile;
@@ -55,8 +53,32 @@ public:
 private:
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
-  bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
+  // The cache file starts with a CacheHeader, followed by one fixed-size CacheRecord per game.
+  // Each record points at the game's path and its serialized GameFile, which are stored after
+  // the records. Games can be located without reading anything else, and a damaged game only
+  // drops that game rather than the whole cache. The file is in native byte order.
+  struct CacheHeader
+  {
+    u32 magic;
+    u32 revision;
+    u32 num_records;
+    u32 record_size;
+    u64 file_size;
+  };
+  static_assert(sizeof(CacheHeader) == 24);
+
+  struct CacheRecord
+  {
+    u64 path_offset;
+    u64 state_offset;
+    u64 state_size;
+    u32 path_length;
+    u32 padding;
+  };
+  static_assert(sizeof(CacheRecord) == 32);
+
+  std::vector<u8> WriteCacheFile() const;
+  bool ReadCacheFile(const u8* data, size_t size);
 
   std::string m_path;
   std::vector<std::shared_ptr<GameFile>> m_cached_files;
@@ -136,55 +136,66 @@ void VertexManager::CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 num_in
 
 void VertexManager::UploadUniforms()
 {
-  UpdateVertexShaderConstants();
-  UpdateGeometryShaderConstants();
-  UpdatePixelShaderConstants();
-}
-
-void VertexManager::UpdateVertexShaderConstants()
-{
-  if (!VertexShaderManager::dirty || !ReserveConstantStorage())
+  const bool vs_dirty = VertexShaderManager::dirty;
+  const bool gs_dirty = GeometryShaderManager::dirty;
+  const bool ps_dirty = PixelShaderManager::dirty;
+  if (!vs_dirty && !gs_dirty && !ps_dirty)
     return;
 
-  Renderer::GetInstance()->SetConstantBuffer(1, m_uniform_stream_buffer.GetCurrentGPUPointer());
-  std::memcpy(m_uniform_stream_buffer.GetCurrentHostPointer(), &VertexShaderManager::constants,
-              sizeof(VertexShaderConstants));
-  m_uniform_stream_buffer.CommitMemory(sizeof(VertexShaderConstants));
-  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(VertexShaderConstants));
-  VertexShaderManager::dirty = false;
-}
-
-void VertexManager::UpdateGeometryShaderConstants()
-{
-  if (!GeometryShaderManager::dirty || !ReserveConstantStorage())
+  // Pack the blocks that changed into a single allocation, so that a draw only reserves uniform
+  // buffer memory once, no matter how many of them changed.
+  u32 size = 0;
+  const auto place = [&size](bool dirty, u32 block_size) {
+    if (!dirty)
+      return 0u;
+    const u32 offset = Common::AlignUp(size, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+    size = offset + block_size;
+    return offset;
+  };
+  const u32 vs_offset = place(vs_dirty, sizeof(VertexShaderConstants));
+  const u32 gs_offset = place(gs_dirty, sizeof(GeometryShaderConstants));
+  const u32 ps_offset = place(ps_dirty, sizeof(PixelShaderConstants));
+
+  if (!ReserveConstantStorage())
     return;
 
-  Renderer::GetInstance()->SetConstantBuffer(2, m_uniform_stream_buffer.GetCurrentGPUPointer());
-  std::memcpy(m_uniform_stream_buffer.GetCurrentHostPointer(), &GeometryShaderManager::constants,
-              sizeof(GeometryShaderConstants));
-  m_uniform_stream_buffer.CommitMemory(sizeof(GeometryShaderConstants));
-  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(GeometryShaderConstants));
-  GeometryShaderManager::dirty = false;
-}
-
-void VertexManager::UpdatePixelShaderConstants()
-{
-  if (!PixelShaderManager::dirty || !ReserveConstantStorage())
-    return;
+  const D3D12_GPU_VIRTUAL_ADDRESS gpu_pointer = m_uniform_stream_buffer.GetCurrentGPUPointer();
+  u8* const host_pointer = m_uniform_stream_buffer.GetCurrentHostPointer();
+  if (vs_dirty)
+  {
+    Renderer::GetInstance()->SetConstantBuffer(1, gpu_pointer + vs_offset);
+    std::memcpy(host_pointer + vs_offset, &VertexShaderManager::constants,
+                sizeof(VertexShaderConstants));
+    VertexShaderManager::dirty = false;
+  }
+  if (gs_dirty)
+  {
+    Renderer::GetInstance()->SetConstantBuffer(2, gpu_pointer + gs_offset);
+    std::memcpy(host_pointer + gs_offset, &GeometryShaderManager::constants,
+                sizeof(GeometryShaderConstants));
+    GeometryShaderManager::dirty = false;
+  }
+  if (ps_dirty)
+  {
+    Renderer::GetInstance()->SetConstantBuffer(0, gpu_pointer + ps_offset);
+    std::memcpy(host_pointer + ps_offset, &PixelShaderManager::constants,
+                sizeof(PixelShaderConstants));
+    PixelShaderManager::dirty = false;
+  }
 
-  Renderer::GetInstance()->SetConstantBuffer(0, m_uniform_stream_buffer.GetCurrentGPUPointer());
-  std::memcpy(m_uniform_stream_buffer.GetCurrentHostPointer(), &PixelShaderManager::constants,
-              sizeof(PixelShaderConstants));
-  m_uniform_stream_buffer.CommitMemory(sizeof(PixelShaderConstants));
-  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(PixelShaderConstants));
-  PixelShaderManager::dirty = false;
+  m_uniform_stream_buffer.CommitMemory(size);
+  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, size);
 }
 
 bool VertexManager::ReserveConstantStorage()
 {
-  static constexpr u32 reserve_size =
-      static_cast<u32>(std::max({sizeof(PixelShaderConstants), sizeof(VertexShaderConstants),
-                                 sizeof(GeometryShaderConstants)}));
+  // Enough for all stages' constants, packed together.
+  static constexpr u32 reserve_size = static_cast<u32>(
+      Common::AlignUp(Common::AlignUp(sizeof(VertexShaderConstants),
+                                      D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT) +
+                          sizeof(GeometryShaderConstants),
+                      D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT) +
+      sizeof(PixelShaderConstants));
   if (m_uniform_stream_buffer.ReserveMemory(reserve_size,
                                             D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT))
   {
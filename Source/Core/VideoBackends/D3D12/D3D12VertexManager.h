@@ -31,11 +31,7 @@ protected:
                     u32* out_base_index) override;
   void UploadUniforms() override;
 
-  void UpdateVertexShaderConstants();
-  void UpdateGeometryShaderConstants();
-  void UpdatePixelShaderConstants();
-
-  // Allocates storage in the uniform buffer of the specified size. If this storage cannot be
+  // Allocates storage in the uniform buffer for all stages' constants. If this storage cannot be
   // allocated immediately, the current command buffer will be submitted and all stage's
   // constants will be re-uploaded. false will be returned in this case, otherwise true.
   bool ReserveConstantStorage();
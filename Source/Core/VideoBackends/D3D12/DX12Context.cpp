@@ -490,6 +490,7 @@ void DXContext::MoveToNextCommandList()
 
 void DXContext::ExecuteCommandList(bool wait_for_completion)
 {
+  FlushResourceBarriers();
   CommandListResources& res = m_command_lists[m_current_command_list];
 
   // Close and queue command list.
@@ -520,6 +521,45 @@ void DXContext::DeferDescriptorDestruction(DescriptorHeapManager& manager, u32 i
   m_command_lists[m_current_command_list].pending_descriptors.emplace_back(manager, index);
 }
 
+void DXContext::DeferTextureHeapFree(const TextureHeapAllocation& allocation)
+{
+  m_command_lists[m_current_command_list].pending_heap_allocations.push_back(allocation);
+}
+
+void DXContext::AddResourceBarrier(ID3D12Resource* resource, D3D12_RESOURCE_STATES from_state,
+                                   D3D12_RESOURCE_STATES to_state)
+{
+  // If the resource already has a queued transition, e.g. a texture moved to COPY_SOURCE and
+  // straight back, combine the two, or drop both if they cancel out.
+  for (auto it = m_pending_barriers.begin(); it != m_pending_barriers.end(); ++it)
+  {
+    if (it->Transition.pResource != resource)
+      continue;
+
+    ASSERT(it->Transition.StateAfter == from_state);
+    if (it->Transition.StateBefore == to_state)
+      m_pending_barriers.erase(it);
+    else
+      it->Transition.StateAfter = to_state;
+    return;
+  }
+
+  m_pending_barriers.push_back(
+      {D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
+       D3D12_RESOURCE_BARRIER_FLAG_NONE,
+       {{resource, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, from_state, to_state}}});
+}
+
+void DXContext::FlushResourceBarriers()
+{
+  if (m_pending_barriers.empty())
+    return;
+
+  m_command_lists[m_current_command_list].command_list->ResourceBarrier(
+      static_cast<UINT>(m_pending_barriers.size()), m_pending_barriers.data());
+  m_pending_barriers.clear();
+}
+
 void DXContext::ResetSamplerAllocators()
 {
   for (CommandListResources& res : m_command_lists)
@@ -542,6 +582,10 @@ void DXContext::DestroyPendingResources(CommandListResources& cmdlist)
   for (ID3D12Resource* res : cmdlist.pending_resources)
     res->Release();
   cmdlist.pending_resources.clear();
+
+  for (const TextureHeapAllocation& allocation : cmdlist.pending_heap_allocations)
+    m_texture_heap_allocator.Free(allocation);
+  cmdlist.pending_heap_allocations.clear();
 }
 
 void DXContext::WaitForFence(u64 fence)
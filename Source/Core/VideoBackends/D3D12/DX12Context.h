@@ -5,6 +5,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/HRWrap.h"
@@ -13,6 +14,7 @@
 #include "VideoBackends/D3D12/D3D12StreamBuffer.h"
 #include "VideoBackends/D3D12/DescriptorAllocator.h"
 #include "VideoBackends/D3D12/DescriptorHeapManager.h"
+#include "VideoBackends/D3D12/TextureHeapAllocator.h"
 
 struct IDXGIFactory;
 
@@ -62,10 +64,19 @@ public:
   ID3D12CommandQueue* GetCommandQueue() const { return m_command_queue.Get(); }
 
   // Returns the current command list, commands can be recorded directly.
-  ID3D12GraphicsCommandList* GetCommandList() const
+  // Any queued resource barriers are recorded first.
+  ID3D12GraphicsCommandList* GetCommandList()
   {
+    if (!m_pending_barriers.empty())
+      FlushResourceBarriers();
     return m_command_lists[m_current_command_list].command_list.Get();
   }
+
+  // Queues a transition barrier. Queued barriers are recorded together, with one ResourceBarrier
+  // call, when the command list is next used.
+  void AddResourceBarrier(ID3D12Resource* resource, D3D12_RESOURCE_STATES from_state,
+                          D3D12_RESOURCE_STATES to_state);
+  void FlushResourceBarriers();
   DescriptorAllocator* GetDescriptorAllocator()
   {
     return &m_command_lists[m_current_command_list].descriptor_allocator;
@@ -101,6 +112,9 @@ public:
   // Texture streaming buffer for uploads.
   StreamBuffer& GetTextureUploadBuffer() { return m_texture_upload_buffer; }
 
+  // Heaps which sampled textures are placed in.
+  TextureHeapAllocator& GetTextureHeapAllocator() { return m_texture_heap_allocator; }
+
   // Feature level to use when compiling shaders.
   D3D_FEATURE_LEVEL GetFeatureLevel() const { return m_feature_level; }
 
@@ -122,6 +136,10 @@ public:
   // Defers destruction of a descriptor handle (associates it with the current list).
   void DeferDescriptorDestruction(DescriptorHeapManager& manager, u32 index);
 
+  // Defers freeing a texture heap range (associates it with the current list).
+  // The resource placed in it must be deferred for destruction first.
+  void DeferTextureHeapFree(const TextureHeapAllocation& allocation);
+
   // Clears all samplers from the per-frame allocators.
   void ResetSamplerAllocators();
 
@@ -143,6 +161,7 @@ private:
     SamplerAllocator sampler_allocator;
     std::vector<ID3D12Resource*> pending_resources;
     std::vector<std::pair<DescriptorHeapManager&, u32>> pending_descriptors;
+    std::vector<TextureHeapAllocation> pending_heap_allocations;
     u64 ready_fence_value = 0;
   };
 
@@ -188,6 +207,9 @@ private:
   ComPtr<ID3D12RootSignature> m_compute_root_signature;
 
   StreamBuffer m_texture_upload_buffer;
+  TextureHeapAllocator m_texture_heap_allocator;
+
+  std::vector<D3D12_RESOURCE_BARRIER> m_pending_barriers;
 };
 
 extern std::unique_ptr<DXContext> g_dx_context;
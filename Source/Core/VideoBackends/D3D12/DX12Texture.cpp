@@ -68,6 +68,8 @@ DXTexture::~DXTexture()
   }
   if (m_resource)
     g_dx_context->DeferResourceDestruction(m_resource.Get());
+  if (m_heap_allocation)
+    g_dx_context->DeferTextureHeapFree(m_heap_allocation);
 }
 
 std::unique_ptr<DXTexture> DXTexture::Create(const TextureConfig& config, std::string_view name)
@@ -112,16 +114,45 @@ std::unique_ptr<DXTexture> DXTexture::Create(const TextureConfig& config, std::s
             D3DCommon::GetRTVFormatForAbstractFormat(config.format, false);
   }
 
+  // Sampled textures are placed in a shared heap where possible, as the texture cache creates and
+  // destroys lots of them. Render targets keep their own allocation.
   ComPtr<ID3D12Resource> resource;
-  HRESULT hr = g_dx_context->GetDevice()->CreateCommittedResource(
-      &heap_properties, D3D12_HEAP_FLAG_NONE, &resource_desc, resource_state,
-      config.IsRenderTarget() ? &optimized_clear_value : nullptr, IID_PPV_ARGS(&resource));
-  ASSERT_MSG(VIDEO, SUCCEEDED(hr), "Failed to create D3D12 texture resource: {}", DX12HRWrap(hr));
-  if (FAILED(hr))
-    return nullptr;
+  TextureHeapAllocation heap_allocation = {};
+  if (!config.IsRenderTarget() && !config.IsComputeImage())
+  {
+    ID3D12Device* device = g_dx_context->GetDevice();
+    TextureHeapAllocator& heap_allocator = g_dx_context->GetTextureHeapAllocator();
+    const D3D12_RESOURCE_ALLOCATION_INFO allocation_info =
+        device->GetResourceAllocationInfo(0, 1, &resource_desc);
+    if (heap_allocator.Allocate(device, allocation_info, &heap_allocation))
+    {
+      HRESULT hr = device->CreatePlacedResource(heap_allocation.heap, heap_allocation.offset,
+                                                &resource_desc, resource_state, nullptr,
+                                                IID_PPV_ARGS(&resource));
+      if (FAILED(hr))
+      {
+        WARN_LOG_FMT(VIDEO, "Failed to create placed texture resource: {}", DX12HRWrap(hr));
+        heap_allocator.Free(heap_allocation);
+        heap_allocation = {};
+        resource.Reset();
+      }
+    }
+  }
+
+  if (!resource)
+  {
+    HRESULT hr = g_dx_context->GetDevice()->CreateCommittedResource(
+        &heap_properties, D3D12_HEAP_FLAG_NONE, &resource_desc, resource_state,
+        config.IsRenderTarget() ? &optimized_clear_value : nullptr, IID_PPV_ARGS(&resource));
+    ASSERT_MSG(VIDEO, SUCCEEDED(hr), "Failed to create D3D12 texture resource: {}",
+               DX12HRWrap(hr));
+    if (FAILED(hr))
+      return nullptr;
+  }
 
   auto tex =
       std::unique_ptr<DXTexture>(new DXTexture(config, resource.Get(), resource_state, name));
+  tex->m_heap_allocation = heap_allocation;
   if (!tex->CreateSRVDescriptor() || (config.IsComputeImage() && !tex->CreateUAVDescriptor()))
     return nullptr;
 
@@ -377,7 +408,7 @@ void DXTexture::TransitionToState(D3D12_RESOURCE_STATES state) const
   if (m_state == state)
     return;
 
-  ResourceBarrier(g_dx_context->GetCommandList(), m_resource.Get(), m_state, state);
+  g_dx_context->AddResourceBarrier(m_resource.Get(), m_state, state);
   m_state = state;
 }
 
@@ -9,6 +9,7 @@
 #include "Common/CommonTypes.h"
 #include "VideoBackends/D3D12/Common.h"
 #include "VideoBackends/D3D12/DescriptorHeapManager.h"
+#include "VideoBackends/D3D12/TextureHeapAllocator.h"
 #include "VideoCommon/AbstractFramebuffer.h"
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/AbstractTexture.h"
@@ -52,6 +53,7 @@ private:
   bool CreateUAVDescriptor();
 
   ComPtr<ID3D12Resource> m_resource;
+  TextureHeapAllocation m_heap_allocation = {};
   DescriptorHandle m_srv_descriptor = {};
   DescriptorHandle m_uav_descriptor = {};
 
@@ -0,0 +1,105 @@
+// Copyright 2019 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/D3D12/TextureHeapAllocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "Common/Align.h"
+#include "Common/Assert.h"
+#include "Common/Logging/Log.h"
+
+#include "VideoBackends/D3D12/DX12Context.h"
+
+namespace DX12
+{
+TextureHeapAllocator::TextureHeapAllocator() = default;
+TextureHeapAllocator::~TextureHeapAllocator() = default;
+
+bool TextureHeapAllocator::Allocate(ID3D12Device* device,
+                                    const D3D12_RESOURCE_ALLOCATION_INFO& info,
+                                    TextureHeapAllocation* allocation)
+{
+  if (info.SizeInBytes > MAX_ALLOCATION_SIZE)
+    return false;
+
+  for (Heap& heap : m_heaps)
+  {
+    if (AllocateFromHeap(heap, info, allocation))
+      return true;
+  }
+
+  // All heaps are full, or too fragmented, so create another one.
+  const D3D12_HEAP_DESC heap_desc = {HEAP_SIZE,
+                                     {D3D12_HEAP_TYPE_DEFAULT},
+                                     D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT,
+                                     D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES};
+  Heap heap;
+  HRESULT hr = device->CreateHeap(&heap_desc, IID_PPV_ARGS(&heap.heap));
+  if (FAILED(hr))
+  {
+    WARN_LOG_FMT(VIDEO, "Failed to create texture heap: {}", DX12HRWrap(hr));
+    return false;
+  }
+
+  heap.free_ranges.emplace(0, HEAP_SIZE);
+  m_heaps.push_back(std::move(heap));
+  return AllocateFromHeap(m_heaps.back(), info, allocation);
+}
+
+bool TextureHeapAllocator::AllocateFromHeap(Heap& heap, const D3D12_RESOURCE_ALLOCATION_INFO& info,
+                                            TextureHeapAllocation* allocation)
+{
+  // First fit. The texture cache creates lots of textures of a few sizes, so this works well.
+  for (auto it = heap.free_ranges.begin(); it != heap.free_ranges.end(); ++it)
+  {
+    const u64 range_offset = it->first;
+    const u64 range_end = it->first + it->second;
+    const u64 offset = Common::AlignUp(range_offset, info.Alignment);
+    const u64 end = offset + info.SizeInBytes;
+    if (end > range_end)
+      continue;
+
+    heap.free_ranges.erase(it);
+    if (offset > range_offset)
+      heap.free_ranges.emplace(range_offset, offset - range_offset);
+    if (range_end > end)
+      heap.free_ranges.emplace(end, range_end - end);
+
+    *allocation = {heap.heap.Get(), offset, info.SizeInBytes};
+    return true;
+  }
+
+  return false;
+}
+
+void TextureHeapAllocator::Free(const TextureHeapAllocation& allocation)
+{
+  auto heap_it = std::find_if(m_heaps.begin(), m_heaps.end(), [&allocation](const Heap& heap) {
+    return heap.heap.Get() == allocation.heap;
+  });
+  ASSERT(heap_it != m_heaps.end());
+  if (heap_it == m_heaps.end())
+    return;
+
+  // Merge with the free ranges on either side.
+  std::map<u64, u64>& free_ranges = heap_it->free_ranges;
+  u64 offset = allocation.offset;
+  u64 size = allocation.size;
+  auto next = free_ranges.lower_bound(offset);
+  if (next != free_ranges.end() && offset + size == next->first)
+  {
+    size += next->second;
+    next = free_ranges.erase(next);
+  }
+  if (next != free_ranges.begin() && std::prev(next)->first + std::prev(next)->second == offset)
+    std::prev(next)->second += size;
+  else
+    free_ranges.emplace(offset, size);
+
+  // Give back heaps which are completely unused, but keep one around for the next textures.
+  if (m_heaps.size() > 1 && free_ranges.size() == 1 && free_ranges.begin()->second == HEAP_SIZE)
+    m_heaps.erase(heap_it);
+}
+}  // namespace DX12
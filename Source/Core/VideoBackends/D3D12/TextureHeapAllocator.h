@@ -0,0 +1,58 @@
+// Copyright 2019 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/D3D12/Common.h"
+
+namespace DX12
+{
+// A range of a texture heap which a placed resource lives in.
+struct TextureHeapAllocation final
+{
+  ID3D12Heap* heap;
+  u64 offset;
+  u64 size;
+
+  operator bool() const { return heap != nullptr; }
+};
+
+// Sub-allocates placed resources for sampled textures from a few large heaps, which is much
+// cheaper than creating a committed resource (with its own heap) for each texture the texture
+// cache creates. Render targets and storage images are still created as committed resources.
+class TextureHeapAllocator final
+{
+public:
+  TextureHeapAllocator();
+  ~TextureHeapAllocator();
+
+  // Textures larger than this aren't worth sub-allocating.
+  static constexpr u64 MAX_ALLOCATION_SIZE = 16 * 1024 * 1024;
+
+  bool Allocate(ID3D12Device* device, const D3D12_RESOURCE_ALLOCATION_INFO& info,
+                TextureHeapAllocation* allocation);
+
+  // The resource placed in the range must have been released, and no longer be used by the GPU.
+  void Free(const TextureHeapAllocation& allocation);
+
+private:
+  static constexpr u64 HEAP_SIZE = 64 * 1024 * 1024;
+
+  struct Heap
+  {
+    ComPtr<ID3D12Heap> heap;
+
+    // Free ranges, offset -> size. Adjacent ranges are merged when freed.
+    std::map<u64, u64> free_ranges;
+  };
+
+  bool AllocateFromHeap(Heap& heap, const D3D12_RESOURCE_ALLOCATION_INFO& info,
+                        TextureHeapAllocation* allocation);
+
+  std::vector<Heap> m_heaps;
+};
+}  // namespace DX12
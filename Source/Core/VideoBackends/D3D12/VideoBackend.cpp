@@ -88,6 +88,9 @@ void VideoBackend::FillBackendInfo()
   g_Config.backend_info.bSupportsSettingObjectNames = true;
   g_Config.backend_info.bSupportsPartialMultisampleResolve = true;
   g_Config.backend_info.bSupportsDynamicVertexLoader = true;
+  g_Config.backend_info.bSupportsD24S8DepthBuffer = true;
+  g_Config.backend_info.bSupportsETC2Textures = false;
+  g_Config.backend_info.bSupportsASTCTextures = false;
   g_Config.backend_info.bSupportsVSLinePointExpand = true;
 
   // We can only check texture support once we have a device.
@@ -3,11 +3,15 @@
 
 #include "VideoBackends/Metal/MTLObjectCache.h"
 
+#include <chrono>
+#include <future>
 #include <map>
 #include <mutex>
 #include <optional>
 
 #include "Common/Assert.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 #include "VideoBackends/Metal/MTLPipeline.h"
@@ -16,6 +20,7 @@
 
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/VertexShaderGen.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -270,7 +275,21 @@ static MTLBlendFactor Convert(SrcBlendFactor factor, bool usedualsrc)
 class Metal::ObjectCache::Internal
 {
 public:
-  using StoredPipeline = std::pair<MRCOwned<id<MTLRenderPipelineState>>, PipelineReflection>;
+  Internal()
+  {
+    if (g_ActiveConfig.bShaderCache)
+      LoadBinaryArchive();
+  }
+
+  ~Internal()
+  {
+    // Completion handlers reference the archive and the counters below
+    std::unique_lock<std::mutex> lock(m_mtx);
+    m_cv.wait(lock, [this] { return m_compiles_in_flight == 0; });
+    lock.unlock();
+    SaveBinaryArchive();
+  }
+
   /// Holds only the things that are actually used in a Metal pipeline
   struct PipelineID
   {
@@ -373,11 +392,132 @@ public:
 
   std::mutex m_mtx;
   std::condition_variable m_cv;
-  std::map<PipelineID, StoredPipeline> m_pipelines;
+  std::map<PipelineID, std::shared_future<StoredPipeline>> m_pipelines;
   std::map<const Shader*, std::vector<PipelineID>> m_shaders;
   std::array<u32, 3> m_pipeline_counter;
+  u32 m_compiles_in_flight = 0;
+
+  // MTLBinaryArchive requires macOS 11 / iOS 14, so it's stored untyped
+  MRCOwned<id> m_binary_archive;
+  std::string m_binary_archive_path;
+  std::mutex m_binary_archive_mtx;
+  bool m_binary_archive_dirty = false;
+
+  void LoadBinaryArchive()
+  {
+    if (@available(macOS 11, iOS 14, *))
+    {
+      // Keyed the same way as the pipeline UID cache, so the pipelines ShaderCache precompiles
+      // from it on startup come straight out of the archive.
+      // We have to keep the file name around since the game ID is cleared by the time we save.
+      m_binary_archive_path =
+          GetDiskShaderCacheFileName(APIType::Metal, "BinaryArchive", true, true);
+      auto desc = MRCTransfer([MTLBinaryArchiveDescriptor new]);
+      NSError* err = nullptr;
+      if (File::Exists(m_binary_archive_path))
+      {
+        [desc setUrl:[NSURL fileURLWithPath:@(m_binary_archive_path.c_str())]];
+        m_binary_archive = MRCTransfer<id>([g_device newBinaryArchiveWithDescriptor:desc
+                                                                             error:&err]);
+        if (m_binary_archive)
+          return;
+        WARN_LOG_FMT(VIDEO, "Failed to load Metal binary archive {}, recreating it: {}",
+                     m_binary_archive_path, [[err localizedDescription] UTF8String]);
+        File::Delete(m_binary_archive_path);
+        [desc setUrl:nil];
+      }
+      m_binary_archive =
+          MRCTransfer<id>([g_device newBinaryArchiveWithDescriptor:desc error:&err]);
+      if (!m_binary_archive)
+      {
+        WARN_LOG_FMT(VIDEO, "Failed to create Metal binary archive: {}",
+                     [[err localizedDescription] UTF8String]);
+      }
+    }
+  }
+
+  void SaveBinaryArchive()
+  {
+    if (!m_binary_archive_dirty)
+      return;
+    if (@available(macOS 11, iOS 14, *))
+    {
+      @autoreleasepool
+      {
+        // The archive may still be reading from the old file, so don't write over it directly
+        const std::string temp_path = m_binary_archive_path + ".tmp";
+        NSError* err = nullptr;
+        if (![m_binary_archive serializeToURL:[NSURL fileURLWithPath:@(temp_path.c_str())]
+                                        error:&err])
+        {
+          WARN_LOG_FMT(VIDEO, "Failed to save Metal binary archive {}: {}", temp_path,
+                       [[err localizedDescription] UTF8String]);
+          return;
+        }
+        m_binary_archive = nullptr;
+        File::Rename(temp_path, m_binary_archive_path);
+      }
+    }
+  }
+
+  void AddToBinaryArchive(MTLRenderPipelineDescriptor* desc)
+  {
+    if (@available(macOS 11, iOS 14, *))
+    {
+      std::lock_guard<std::mutex> lock(m_binary_archive_mtx);
+      NSError* err = nullptr;
+      if ([m_binary_archive addRenderPipelineFunctionsWithDescriptor:desc error:&err])
+      {
+        m_binary_archive_dirty = true;
+      }
+      else
+      {
+        WARN_LOG_FMT(VIDEO, "Failed to add pipeline to Metal binary archive: {}",
+                     [[err localizedDescription] UTF8String]);
+      }
+    }
+  }
 
-  StoredPipeline CreatePipeline(const AbstractPipelineConfig& config)
+  /// Compiles the pipeline on Metal's own threads, fulfilling the promise when it's done.
+  /// If `archive_lookup` is set, only the binary archive is searched, and a miss is added to it.
+  void CompilePipeline(MRCOwned<MTLRenderPipelineDescriptor*> desc, MTLPipelineOption options,
+                       bool archive_lookup, std::shared_ptr<std::promise<StoredPipeline>> promise)
+  {
+    MTLRenderPipelineDescriptor* raw_desc = desc;
+    auto handler = [this, desc = std::move(desc), archive_lookup, promise = std::move(promise)](
+                       id<MTLRenderPipelineState> pipe, MTLRenderPipelineReflection* reflection,
+                       NSError* err) {
+      if (!pipe && archive_lookup)
+      {
+        // Compile it into the archive, then create it from there
+        AddToBinaryArchive(desc);
+        CompilePipeline(desc, MTLPipelineOptionArgumentInfo, false, promise);
+        return;
+      }
+      StoredPipeline result;
+      if (pipe)
+      {
+        result = std::make_pair(MRCRetain(pipe), PipelineReflection(reflection));
+      }
+      else
+      {
+        PanicAlertFmt("Failed to compile pipeline for {} and {}: {}",
+                      [[[desc vertexFunction] label] UTF8String],
+                      [[[desc fragmentFunction] label] UTF8String],
+                      [[err localizedDescription] UTF8String]);
+      }
+      promise->set_value(std::move(result));
+      std::lock_guard<std::mutex> lock(m_mtx);
+      m_compiles_in_flight--;
+      m_cv.notify_all();
+    };
+    [g_device newRenderPipelineStateWithDescriptor:raw_desc
+                                           options:options
+                                 completionHandler:handler];
+  }
+
+  /// Must be called with m_mtx held
+  std::shared_future<StoredPipeline> CreatePipeline(const AbstractPipelineConfig& config)
   {
     @autoreleasepool
     {
@@ -423,50 +563,38 @@ public:
       [desc setDepthAttachmentPixelFormat:Util::FromAbstract(fs.depth_texture_format)];
       if (Util::HasStencil(fs.depth_texture_format))
         [desc setStencilAttachmentPixelFormat:Util::FromAbstract(fs.depth_texture_format)];
-      NSError* err = nullptr;
-      MTLRenderPipelineReflection* reflection = nullptr;
-      id<MTLRenderPipelineState> pipe =
-          [g_device newRenderPipelineStateWithDescriptor:desc
-                                                 options:MTLPipelineOptionArgumentInfo
-                                              reflection:&reflection
-                                                   error:&err];
-      if (err)
+      MTLPipelineOption options = MTLPipelineOptionArgumentInfo;
+      bool archive_lookup = false;
+      if (@available(macOS 11, iOS 14, *))
       {
-        PanicAlertFmt("Failed to compile pipeline for {} and {}: {}",
-                      [[[desc vertexFunction] label] UTF8String],
-                      [[[desc fragmentFunction] label] UTF8String],
-                      [[err localizedDescription] UTF8String]);
-        return std::make_pair(nullptr, PipelineReflection());
+        if (m_binary_archive)
+        {
+          [desc setBinaryArchives:@[ m_binary_archive.Get() ]];
+          options |= MTLPipelineOptionFailOnBinaryArchiveMiss;
+          archive_lookup = true;
+        }
       }
 
-      return std::make_pair(MRCTransfer(pipe), PipelineReflection(reflection));
+      auto promise = std::make_shared<std::promise<StoredPipeline>>();
+      std::shared_future<StoredPipeline> future = promise->get_future().share();
+      m_compiles_in_flight++;
+      CompilePipeline(std::move(desc), options, archive_lookup, std::move(promise));
+      return future;
     }
   }
 
-  StoredPipeline GetOrCreatePipeline(const AbstractPipelineConfig& config)
+  std::shared_future<StoredPipeline> GetOrCreatePipeline(const AbstractPipelineConfig& config)
   {
-    std::unique_lock<std::mutex> lock(m_mtx);
+    std::lock_guard<std::mutex> lock(m_mtx);
     PipelineID pid(config);
     auto it = m_pipelines.find(pid);
     if (it != m_pipelines.end())
-    {
-      while (!it->second.first && !it->second.second.textures)
-        m_cv.wait(lock);  // Wait for whoever's already compiling this
-      return it->second;
-    }
-    // Reserve the spot now, so other threads know we're making it
-    it = m_pipelines.insert({pid, {nullptr, PipelineReflection()}}).first;
-    lock.unlock();
-    StoredPipeline pipe = CreatePipeline(config);
-    lock.lock();
-    if (pipe.first)
-      it->second = pipe;
-    else
-      it->second.second.textures = 1;  // Abuse this as a "failed to create pipeline" flag
+      return it->second;  // Possibly still compiling, in which case we share the result
+    // Metal compiles it in the background, so this doesn't hold the lock for long
+    std::shared_future<StoredPipeline> pipe = CreatePipeline(config);
+    m_pipelines.emplace(pid, pipe);
     m_shaders[pid.vertex_shader].push_back(pid);
     m_shaders[pid.fragment_shader].push_back(pid);
-    lock.unlock();
-    m_cv.notify_all();  // Wake up anyone who might be waiting
     return pipe;
   }
 
@@ -487,12 +615,20 @@ public:
 std::unique_ptr<AbstractPipeline>
 Metal::ObjectCache::CreatePipeline(const AbstractPipelineConfig& config)
 {
-  Internal::StoredPipeline pipeline = m_internal->GetOrCreatePipeline(config);
-  if (!pipeline.first)
-    return nullptr;
-  return std::make_unique<Pipeline>(
-      std::move(pipeline.first), pipeline.second, Convert(config.rasterization_state.primitive),
-      Convert(config.rasterization_state.cullmode), config.depth_state, config.usage);
+  std::shared_future<StoredPipeline> pipeline = m_internal->GetOrCreatePipeline(config);
+  const MTLPrimitiveType prim = Convert(config.rasterization_state.primitive);
+  const MTLCullMode cull = Convert(config.rasterization_state.cullmode);
+  if (pipeline.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+  {
+    const StoredPipeline& compiled = pipeline.get();
+    if (!compiled.first)
+      return nullptr;
+    return std::make_unique<Pipeline>(compiled.first, compiled.second, prim, cull,
+                                      config.depth_state, config.usage);
+  }
+  // Still compiling, the pipeline waits for it when it's first bound
+  return std::make_unique<Pipeline>(std::move(pipeline), prim, cull, config.depth_state,
+                                    config.usage);
 }
 
 void Metal::ObjectCache::ShaderDestroyed(const Shader* shader)
@@ -63,6 +63,14 @@ void Metal::PerfQuery::FlushResults()
     m_cv.wait(lock);
 }
 
+void Metal::PerfQuery::PollResults()
+{
+  // Results arrive from command buffer completion handlers, so just make sure the commands which
+  // contain the pending queries get submitted.
+  if (!IsFlushed())
+    g_state_tracker->FlushEncoders();
+}
+
 bool Metal::PerfQuery::IsFlushed() const
 {
   return m_query_count.load(std::memory_order_acquire) == 0;
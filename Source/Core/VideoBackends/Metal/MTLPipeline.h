@@ -4,6 +4,8 @@
 #pragma once
 
 #include <Metal/Metal.h>
+#include <future>
+#include <utility>
 
 #include "VideoBackends/Metal/MRCHelpers.h"
 #include "VideoBackends/Metal/MTLObjectCache.h"
@@ -24,12 +26,21 @@ struct PipelineReflection
   explicit PipelineReflection(MTLRenderPipelineReflection* reflection);
 };
 
+using StoredPipeline = std::pair<MRCOwned<id<MTLRenderPipelineState>>, PipelineReflection>;
+
 class Pipeline final : public AbstractPipeline
 {
 public:
   explicit Pipeline(MRCOwned<id<MTLRenderPipelineState>> pipeline,
                     const PipelineReflection& reflection, MTLPrimitiveType prim, MTLCullMode cull,
                     DepthState depth, AbstractPipelineUsage usage);
+  /// Creates a pipeline whose render pipeline state is still being compiled by Metal
+  explicit Pipeline(std::shared_future<StoredPipeline> pending, MTLPrimitiveType prim,
+                    MTLCullMode cull, DepthState depth, AbstractPipelineUsage usage);
+
+  bool IsCompileComplete() const override;
+  /// Blocks until Metal has finished compiling the pipeline.  Must be called before using it.
+  void WaitForCompile() const;
 
   id<MTLRenderPipelineState> Get() const { return m_pipeline; }
   MTLPrimitiveType Prim() const { return m_prim; }
@@ -44,12 +55,13 @@ public:
   bool UsesFragmentBuffer(u32 index) const { return m_reflection.fragment_buffers & (1 << index); }
 
 private:
-  MRCOwned<id<MTLRenderPipelineState>> m_pipeline;
+  mutable std::shared_future<StoredPipeline> m_pending;
+  mutable MRCOwned<id<MTLRenderPipelineState>> m_pipeline;
   MTLPrimitiveType m_prim;
   MTLCullMode m_cull;
   DepthStencilSelector m_depth_stencil;
   AbstractPipelineUsage m_usage;
-  PipelineReflection m_reflection;
+  mutable PipelineReflection m_reflection;
 };
 
 class ComputePipeline : public Shader
@@ -3,6 +3,8 @@
 
 #include "VideoBackends/Metal/MTLPipeline.h"
 
+#include <chrono>
+
 #include "Common/MsgHandler.h"
 
 static void MarkAsUsed(u32* list, u32 start, u32 length)
@@ -61,6 +63,30 @@ Metal::Pipeline::Pipeline(MRCOwned<id<MTLRenderPipelineState>> pipeline,
 {
 }
 
+Metal::Pipeline::Pipeline(std::shared_future<StoredPipeline> pending, MTLPrimitiveType prim,
+                          MTLCullMode cull, DepthState depth, AbstractPipelineUsage usage)
+    : m_pending(std::move(pending)), m_prim(prim), m_cull(cull), m_depth_stencil(depth),
+      m_usage(usage)
+{
+}
+
+bool Metal::Pipeline::IsCompileComplete() const
+{
+  if (!m_pending.valid())
+    return true;
+  return m_pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void Metal::Pipeline::WaitForCompile() const
+{
+  if (!m_pending.valid())
+    return;
+  const StoredPipeline& compiled = m_pending.get();
+  m_pipeline = compiled.first;
+  m_reflection = compiled.second;
+  m_pending = {};
+}
+
 Metal::ComputePipeline::ComputePipeline(ShaderStage stage, MTLComputePipelineReflection* reflection,
                                         std::string msl, MRCOwned<id<MTLFunction>> shader,
                                         MRCOwned<id<MTLComputePipelineState>> pipeline)
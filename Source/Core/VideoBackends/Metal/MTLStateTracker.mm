@@ -491,6 +491,8 @@ void Metal::StateTracker::SetPipeline(const Pipeline* pipe)
 {
   if (pipe != m_state.render_pipeline)
   {
+    if (pipe)
+      pipe->WaitForCompile();
     m_state.render_pipeline = pipe;
     m_flags.has_pipeline = false;
   }
@@ -919,7 +921,7 @@ void Metal::StateTracker::PrepareCompute()
 
 void Metal::StateTracker::Draw(u32 base_vertex, u32 num_vertices)
 {
-  if (!num_vertices)
+  if (!num_vertices || !m_state.render_pipeline->Get())
     return;
   PrepareRender();
   [m_current_render_encoder drawPrimitives:m_state.render_pipeline->Prim()
@@ -931,6 +933,8 @@ void Metal::StateTracker::DrawIndexed(u32 base_index, u32 num_indices, u32 base_
 {
   if (!num_indices)  // Happens in Metroid Prime, Metal API validation doesn't like this
     return;
+  if (!m_state.render_pipeline->Get())  // Pipeline failed to compile
+    return;
   PrepareRender();
   [m_current_render_encoder drawIndexedPrimitives:m_state.render_pipeline->Prim()
                                        indexCount:num_indices
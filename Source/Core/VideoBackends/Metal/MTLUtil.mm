@@ -76,6 +76,9 @@ void Metal::Util::PopulateBackendInfo(VideoConfig* config)
   config->backend_info.bSupportsPartialMultisampleResolve = false;
   config->backend_info.bSupportsDynamicVertexLoader = true;
   config->backend_info.bSupportsVSLinePointExpand = true;
+  config->backend_info.bSupportsD24S8DepthBuffer = false;
+  config->backend_info.bSupportsETC2Textures = false;
+  config->backend_info.bSupportsASTCTextures = false;
 }
 
 void Metal::Util::PopulateBackendInfoAdapters(VideoConfig* config,
@@ -192,6 +195,14 @@ void Metal::Util::PopulateBackendInfoFeatures(VideoConfig* config, id<MTLDevice>
   config->backend_info.bSupportsDepthClamp = true;
   config->backend_info.bSupportsST3CTextures = true;
   config->backend_info.bSupportsBPTCTextures = true;
+  config->backend_info.bSupportsD24S8DepthBuffer = [device isDepth24Stencil8PixelFormatSupported];
+  // Only Apple GPUs can sample ETC2 and ASTC textures on macOS.
+  if (@available(macOS 10.15, *))
+  {
+    const bool supports_apple2 = [device supportsFamily:MTLGPUFamilyApple2];
+    config->backend_info.bSupportsETC2Textures = supports_apple2;
+    config->backend_info.bSupportsASTCTextures = supports_apple2;
+  }
 #else
   bool supports_mac1 = false;
   bool supports_apple4 = false;
@@ -207,6 +218,8 @@ void Metal::Util::PopulateBackendInfoFeatures(VideoConfig* config, id<MTLDevice>
   config->backend_info.bSupportsDepthClamp = supports_mac1 || supports_apple4;
   config->backend_info.bSupportsST3CTextures = supports_mac1;
   config->backend_info.bSupportsBPTCTextures = supports_mac1;
+  config->backend_info.bSupportsETC2Textures = true;
+  config->backend_info.bSupportsASTCTextures = true;
   config->backend_info.bSupportsFramebufferFetch = true;
 #endif
 
@@ -271,6 +284,8 @@ AbstractTextureFormat Metal::Util::ToAbstract(MTLPixelFormat format)
   case MTLPixelFormatBC3_RGBA:              return AbstractTextureFormat::DXT5;
   case MTLPixelFormatBC7_RGBAUnorm:         return AbstractTextureFormat::BPTC;
 #endif
+  case MTLPixelFormatEAC_RGBA8:             return AbstractTextureFormat::ETC2;
+  case MTLPixelFormatASTC_4x4_LDR:          return AbstractTextureFormat::ASTC4x4;
   case MTLPixelFormatR16Unorm:              return AbstractTextureFormat::R16;
   case MTLPixelFormatDepth16Unorm:          return AbstractTextureFormat::D16;
 #if TARGET_OS_OSX
@@ -295,6 +310,8 @@ MTLPixelFormat Metal::Util::FromAbstract(AbstractTextureFormat format)
   case AbstractTextureFormat::DXT5:      return MTLPixelFormatBC3_RGBA;
   case AbstractTextureFormat::BPTC:      return MTLPixelFormatBC7_RGBAUnorm;
 #endif
+  case AbstractTextureFormat::ETC2:      return MTLPixelFormatEAC_RGBA8;
+  case AbstractTextureFormat::ASTC4x4:   return MTLPixelFormatASTC_4x4_LDR;
   case AbstractTextureFormat::R16:       return MTLPixelFormatR16Unorm;
   case AbstractTextureFormat::D16:       return MTLPixelFormatDepth16Unorm;
 #if TARGET_OS_OSX
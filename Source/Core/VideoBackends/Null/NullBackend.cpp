@@ -61,6 +61,9 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsSettingObjectNames = false;
   g_Config.backend_info.bSupportsPartialMultisampleResolve = true;
   g_Config.backend_info.bSupportsDynamicVertexLoader = false;
+  g_Config.backend_info.bSupportsD24S8DepthBuffer = false;
+  g_Config.backend_info.bSupportsETC2Textures = false;
+  g_Config.backend_info.bSupportsASTCTextures = false;
 
   // aamodes: We only support 1 sample, so no MSAA
   g_Config.backend_info.Adapters.clear();
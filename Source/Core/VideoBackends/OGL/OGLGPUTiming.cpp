@@ -0,0 +1,55 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/OGL/OGLGPUTiming.h"
+
+namespace OGL
+{
+OGLGPUTiming::OGLGPUTiming()
+{
+  glGenQueries(NUM_TIMESTAMPS, m_queries.data());
+}
+
+OGLGPUTiming::~OGLGPUTiming()
+{
+  glDeleteQueries(NUM_TIMESTAMPS, m_queries.data());
+}
+
+std::unique_ptr<OGLGPUTiming> OGLGPUTiming::Create()
+{
+  if (!GLExtensions::Supports("GL_ARB_timer_query"))
+    return nullptr;
+
+  return std::make_unique<OGLGPUTiming>();
+}
+
+std::optional<u32> OGLGPUTiming::WriteTimestamp()
+{
+  if (m_num_used == NUM_TIMESTAMPS)
+    return std::nullopt;
+
+  const u32 id = m_write_pos;
+  m_write_pos = (m_write_pos + 1) % NUM_TIMESTAMPS;
+  m_num_used++;
+
+  glQueryCounter(m_queries[id], GL_TIMESTAMP);
+  return id;
+}
+
+std::optional<u64> OGLGPUTiming::ReadTimestamp(u32 id)
+{
+  GLuint available = GL_FALSE;
+  glGetQueryObjectuiv(m_queries[id], GL_QUERY_RESULT_AVAILABLE, &available);
+  if (available != GL_TRUE)
+    return std::nullopt;
+
+  GLuint64 timestamp = 0;
+  glGetQueryObjectui64v(m_queries[id], GL_QUERY_RESULT, &timestamp);
+  return timestamp;
+}
+
+void OGLGPUTiming::ReleaseTimestamp(u32 id)
+{
+  m_num_used--;
+}
+}  // namespace OGL
@@ -0,0 +1,38 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "Common/GL/GLExtensions/GLExtensions.h"
+
+#include "VideoCommon/GPUTiming.h"
+
+namespace OGL
+{
+class OGLGPUTiming final : public VideoCommon::GPUTiming
+{
+public:
+  OGLGPUTiming();
+  ~OGLGPUTiming() override;
+
+  // Returns null if the driver doesn't support timestamp queries.
+  static std::unique_ptr<OGLGPUTiming> Create();
+
+protected:
+  std::optional<u32> WriteTimestamp() override;
+  std::optional<u64> ReadTimestamp(u32 id) override;
+  void ReleaseTimestamp(u32 id) override;
+
+private:
+  static constexpr u32 NUM_TIMESTAMPS = 1024;
+
+  std::array<GLuint, NUM_TIMESTAMPS> m_queries{};
+  u32 m_write_pos = 0;
+  u32 m_num_used = 0;
+};
+}  // namespace OGL
@@ -96,6 +96,9 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsPartialMultisampleResolve = true;
   // Unneccessary since OGL doesn't use pipelines
   g_Config.backend_info.bSupportsDynamicVertexLoader = false;
+  g_Config.backend_info.bSupportsD24S8DepthBuffer = true;
+  g_Config.backend_info.bSupportsETC2Textures = false;
+  g_Config.backend_info.bSupportsASTCTextures = false;
 
   // TODO: There is a bug here, if texel buffers or SSBOs/atomics are not supported the graphics
   // options will show the option when it is not supported. The only way around this would be
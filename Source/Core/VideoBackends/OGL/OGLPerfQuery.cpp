@@ -51,6 +51,11 @@ void PerfQuery::FlushResults()
   m_query->FlushResults();
 }
 
+void PerfQuery::PollResults()
+{
+  m_query->PollResults();
+}
+
 void PerfQuery::ResetQuery()
 {
   m_query_count.store(0, std::memory_order_relaxed);
@@ -134,6 +139,11 @@ void PerfQueryGL::DisableQuery(PerfQueryGroup type)
   }
 }
 
+void PerfQueryGL::PollResults()
+{
+  WeakFlush();
+}
+
 void PerfQueryGL::WeakFlush()
 {
   while (!IsFlushed())
@@ -234,6 +244,11 @@ void PerfQueryGLESNV::DisableQuery(PerfQueryGroup type)
   }
 }
 
+void PerfQueryGLESNV::PollResults()
+{
+  WeakFlush();
+}
+
 void PerfQueryGLESNV::WeakFlush()
 {
   while (!IsFlushed())
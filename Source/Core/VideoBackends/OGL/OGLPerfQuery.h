@@ -24,6 +24,7 @@ public:
   void ResetQuery() override;
   u32 GetQueryResult(PerfQueryType type) override;
   void FlushResults() override;
+  void PollResults() override;
   bool IsFlushed() const override;
 
 protected:
@@ -55,6 +56,7 @@ public:
   void EnableQuery(PerfQueryGroup type) override;
   void DisableQuery(PerfQueryGroup type) override;
   void FlushResults() override;
+  void PollResults() override;
 
 private:
   void WeakFlush();
@@ -73,6 +75,7 @@ public:
   void EnableQuery(PerfQueryGroup type) override;
   void DisableQuery(PerfQueryGroup type) override;
   void FlushResults() override;
+  void PollResults() override;
 
 private:
   void WeakFlush();
@@ -54,6 +54,8 @@ AbstractPipeline::CacheData OGLPipeline::GetCacheData() const
   if (!g_ActiveConfig.backend_info.bSupportsPipelineCacheData || m_program->binary_retrieved)
     return {};
 
+  ProgramShaderCache::FinishPipelineProgram(m_program);
+
   GLint program_size = 0;
   glGetProgramiv(m_program->shader.glprogid, GL_PROGRAM_BINARY_LENGTH, &program_size);
   if (program_size == 0)
@@ -78,6 +80,17 @@ AbstractPipeline::CacheData OGLPipeline::GetCacheData() const
   return data;
 }
 
+bool OGLPipeline::IsCompileComplete() const
+{
+  return ProgramShaderCache::IsPipelineProgramLinked(m_program);
+}
+
+void OGLPipeline::BindProgram() const
+{
+  ProgramShaderCache::FinishPipelineProgram(m_program);
+  m_program->shader.Bind();
+}
+
 std::unique_ptr<OGLPipeline> OGLPipeline::Create(const AbstractPipelineConfig& config,
                                                  const void* cache_data, size_t cache_data_size)
 {
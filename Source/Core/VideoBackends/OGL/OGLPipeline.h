@@ -29,6 +29,10 @@ public:
   bool HasVertexInput() const { return m_vertex_format != nullptr; }
   GLenum GetGLPrimitive() const { return m_gl_primitive; }
   CacheData GetCacheData() const override;
+  bool IsCompileComplete() const override;
+
+  // Checks the link result if the program was linked in the background, then binds it.
+  void BindProgram() const;
   static std::unique_ptr<OGLPipeline> Create(const AbstractPipelineConfig& config,
                                              const void* cache_data, size_t cache_data_size);
 
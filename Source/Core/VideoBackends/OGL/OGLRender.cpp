@@ -20,6 +20,7 @@
 #include "Core/Config/GraphicsSettings.h"
 
 #include "VideoBackends/OGL/OGLBoundingBox.h"
+#include "VideoBackends/OGL/OGLGPUTiming.h"
 #include "VideoBackends/OGL/OGLPipeline.h"
 #include "VideoBackends/OGL/OGLShader.h"
 #include "VideoBackends/OGL/OGLTexture.h"
@@ -479,11 +480,19 @@ Renderer::Renderer(std::unique_ptr<GLContext> main_gl_context, float backbuffer_
   g_ogl_config.bSupportsImageLoadStore = GLExtensions::Supports("GL_ARB_shader_image_load_store");
   g_ogl_config.bSupportsConservativeDepth = GLExtensions::Supports("GL_ARB_conservative_depth");
   g_ogl_config.bSupportsAniso = GLExtensions::Supports("GL_EXT_texture_filter_anisotropic");
+  g_ogl_config.bSupportsParallelShaderCompile =
+      GLExtensions::Supports("GL_KHR_parallel_shader_compile") ||
+      GLExtensions::Supports("GL_ARB_parallel_shader_compile");
   g_Config.backend_info.bSupportsComputeShaders = GLExtensions::Supports("GL_ARB_compute_shader");
   g_Config.backend_info.bSupportsST3CTextures =
       GLExtensions::Supports("GL_EXT_texture_compression_s3tc");
   g_Config.backend_info.bSupportsBPTCTextures =
       GLExtensions::Supports("GL_ARB_texture_compression_bptc");
+  // ETC2 is core in GLES 3.0, and desktop drivers expose it through ARB_ES3_compatibility.
+  g_Config.backend_info.bSupportsETC2Textures =
+      m_main_gl_context->IsGLES() || GLExtensions::Supports("GL_ARB_ES3_compatibility");
+  g_Config.backend_info.bSupportsASTCTextures =
+      GLExtensions::Supports("GL_KHR_texture_compression_astc_ldr");
   g_Config.backend_info.bSupportsCoarseDerivatives =
       GLExtensions::Supports("GL_ARB_derivative_control") || GLExtensions::Version() >= 450;
   g_Config.backend_info.bSupportsTextureQueryLevels =
@@ -672,6 +681,24 @@ Renderer::Renderer(std::unique_ptr<GLContext> main_gl_context, float backbuffer_
   g_ogl_config.bSupportsShaderThreadShuffleNV =
       GLExtensions::Supports("GL_NV_shader_thread_shuffle");
 
+  // KHR_shader_subgroup lets the bounding box be reduced across a subgroup on non-NVIDIA drivers,
+  // so that only one invocation per subgroup touches the SSBO atomics.
+  g_ogl_config.bSupportsShaderSubgroupKHR = false;
+  if (GLExtensions::Supports("GL_KHR_shader_subgroup") &&
+      !DriverDetails::HasBug(DriverDetails::BUG_BROKEN_SUBGROUP_OPS))
+  {
+    GLint supported_stages = 0;
+    GLint supported_features = 0;
+    glGetIntegerv(GL_SUBGROUP_SUPPORTED_STAGES_KHR, &supported_stages);
+    glGetIntegerv(GL_SUBGROUP_SUPPORTED_FEATURES_KHR, &supported_features);
+    constexpr GLint required_features = GL_SUBGROUP_FEATURE_BASIC_BIT_KHR |
+                                        GL_SUBGROUP_FEATURE_ARITHMETIC_BIT_KHR |
+                                        GL_SUBGROUP_FEATURE_BALLOT_BIT_KHR;
+    g_ogl_config.bSupportsShaderSubgroupKHR =
+        (supported_stages & GL_FRAGMENT_SHADER_BIT) != 0 &&
+        (supported_features & required_features) == required_features;
+  }
+
   // We require texel buffers, image load store, and compute shaders to enable GPU texture decoding.
   // If the driver doesn't expose the extensions, but supports GL4.3/GLES3.1, it will still be
   // enabled in the version check below.
@@ -683,6 +710,10 @@ Renderer::Renderer(std::unique_ptr<GLContext> main_gl_context, float backbuffer_
   g_Config.backend_info.bSupportsBackgroundCompiling =
       !DriverDetails::HasBug(DriverDetails::BUG_SHARED_CONTEXT_SHADER_COMPILATION);
 
+  // Let the driver use as many threads as it likes for compiling shaders and linking programs.
+  if (g_ogl_config.bSupportsParallelShaderCompile)
+    glMaxShaderCompilerThreads(0xFFFFFFFF);
+
   // Program binaries are supported on GL4.1+, ARB_get_program_binary, or ES3.
   if (supports_glsl_cache)
   {
@@ -864,6 +895,11 @@ std::unique_ptr<::BoundingBox> Renderer::CreateBoundingBox() const
   return std::make_unique<OGLBoundingBox>();
 }
 
+std::unique_ptr<VideoCommon::GPUTiming> Renderer::CreateGPUTiming() const
+{
+  return OGLGPUTiming::Create();
+}
+
 void Renderer::SetViewport(float x, float y, float width, float height, float near_depth,
                            float far_depth)
 {
@@ -910,7 +946,7 @@ void Renderer::DispatchComputeShader(const AbstractShader* shader, u32 groupsize
   // We messed up the program binding, so restore it.
   ProgramShaderCache::InvalidateLastProgram();
   if (m_current_pipeline)
-    static_cast<const OGLPipeline*>(m_current_pipeline)->GetProgram()->shader.Bind();
+    static_cast<const OGLPipeline*>(m_current_pipeline)->BindProgram();
 
   // Barrier to texture can be used for reads.
   if (m_bound_image_texture)
@@ -1075,6 +1111,14 @@ void Renderer::CheckForSurfaceChange()
   if (!m_surface_changed.TestAndClear())
     return;
 
+  // The surface went away after this frame started. Keep the old window surface until there is a
+  // new one, as the context can't create a window surface without a window.
+  if (!m_new_surface_handle)
+  {
+    m_surface_changed.Set();
+    return;
+  }
+
   m_main_gl_context->UpdateSurface(m_new_surface_handle);
   m_new_surface_handle = nullptr;
 
@@ -1239,7 +1283,7 @@ void Renderer::SetPipeline(const AbstractPipeline* pipeline)
     ApplyBlendingState(static_cast<const OGLPipeline*>(pipeline)->GetBlendingState());
     ProgramShaderCache::BindVertexFormat(
         static_cast<const OGLPipeline*>(pipeline)->GetVertexFormat());
-    static_cast<const OGLPipeline*>(pipeline)->GetProgram()->shader.Bind();
+    static_cast<const OGLPipeline*>(pipeline)->BindProgram();
   }
   else
   {
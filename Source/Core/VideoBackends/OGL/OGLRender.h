@@ -72,6 +72,8 @@ struct VideoConfig
   bool bSupportsTextureSubImage;
   EsFbFetchType SupportedFramebufferFetch;
   bool bSupportsShaderThreadShuffleNV;
+  bool bSupportsShaderSubgroupKHR;
+  bool bSupportsParallelShaderCompile;
 
   const char* gl_vendor;
   const char* gl_renderer;
@@ -164,6 +166,7 @@ public:
 
 protected:
   std::unique_ptr<BoundingBox> CreateBoundingBox() const override;
+  std::unique_ptr<VideoCommon::GPUTiming> CreateGPUTiming() const override;
 
 private:
   void CheckForSurfaceChange();
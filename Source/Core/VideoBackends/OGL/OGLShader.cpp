@@ -31,6 +31,9 @@ OGLShader::OGLShader(ShaderStage stage, GLenum gl_type, GLuint gl_id, std::strin
     : AbstractShader(stage), m_id(ProgramShaderCache::GenerateShaderID()), m_type(gl_type),
       m_gl_id(gl_id), m_source(std::move(source)), m_name(std::move(name))
 {
+  if (ProgramShaderCache::IsParallelCompileEnabled())
+    m_compile_result = CompileResult::Pending;
+
   if (!m_name.empty() && g_ActiveConfig.backend_info.bSupportsSettingObjectNames)
   {
     glObjectLabel(GL_SHADER, m_gl_id, (GLsizei)m_name.size(), m_name.c_str());
@@ -56,6 +59,18 @@ OGLShader::~OGLShader()
     glDeleteProgram(m_gl_compute_program_id);
 }
 
+bool OGLShader::CheckCompileResult() const
+{
+  if (m_compile_result == CompileResult::Pending)
+  {
+    m_compile_result = ProgramShaderCache::CheckShaderCompileResult(m_gl_id, m_type, m_source) ?
+                           CompileResult::Succeeded :
+                           CompileResult::Failed;
+  }
+
+  return m_compile_result == CompileResult::Succeeded;
+}
+
 std::unique_ptr<OGLShader> OGLShader::CreateFromSource(ShaderStage stage, std::string_view source,
                                                        std::string_view name)
 {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <string>
@@ -28,6 +29,10 @@ public:
   GLuint GetGLComputeProgramID() const { return m_gl_compute_program_id; }
   const std::string& GetSource() const { return m_source; }
 
+  // Returns false if the shader failed to compile. Shaders compiled in the background by the
+  // driver are only checked the first time this is called, which may wait for the compile.
+  bool CheckCompileResult() const;
+
   static std::unique_ptr<OGLShader> CreateFromSource(ShaderStage stage, std::string_view source,
                                                      std::string_view name);
 
@@ -38,6 +43,14 @@ private:
   GLuint m_gl_compute_program_id = 0;
   std::string m_source;
   std::string m_name;
+
+  enum class CompileResult
+  {
+    Pending,
+    Succeeded,
+    Failed
+  };
+  mutable std::atomic<CompileResult> m_compile_result{CompileResult::Succeeded};
 };
 
 }  // namespace OGL
@@ -220,36 +220,44 @@ u32 ProgramShaderCache::GetUniformBufferAlignment()
 
 void ProgramShaderCache::UploadConstants()
 {
-  if (PixelShaderManager::dirty || VertexShaderManager::dirty || GeometryShaderManager::dirty)
-  {
-    auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
-
-    memcpy(buffer.first, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-           &VertexShaderManager::constants, sizeof(VertexShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-               Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-           &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
+  if (!PixelShaderManager::dirty && !VertexShaderManager::dirty && !GeometryShaderManager::dirty)
+    return;
 
-    s_buffer->Unmap(s_ubo_buffer_size);
-    glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second,
-                      sizeof(PixelShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-                      sizeof(VertexShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                          Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-                      sizeof(GeometryShaderConstants));
+  // Only the blocks which changed are streamed, the others stay bound where they were.
+  u32 upload_size = 0;
+  if (PixelShaderManager::dirty)
+    upload_size += Common::AlignUp(static_cast<u32>(sizeof(PixelShaderConstants)), s_ubo_align);
+  if (VertexShaderManager::dirty)
+    upload_size += Common::AlignUp(static_cast<u32>(sizeof(VertexShaderConstants)), s_ubo_align);
+  if (GeometryShaderManager::dirty)
+    upload_size += Common::AlignUp(static_cast<u32>(sizeof(GeometryShaderConstants)), s_ubo_align);
+
+  auto buffer = s_buffer->Map(upload_size, s_ubo_align);
+  u32 offset = 0;
+  const auto place = [&](GLuint index, const void* data, u32 size) {
+    std::memcpy(buffer.first + offset, data, size);
+    glBindBufferRange(GL_UNIFORM_BUFFER, index, s_buffer->m_buffer, buffer.second + offset, size);
+    offset += Common::AlignUp(size, s_ubo_align);
+    ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, size);
+  };
 
+  if (PixelShaderManager::dirty)
+  {
+    place(1, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
     PixelShaderManager::dirty = false;
+  }
+  if (VertexShaderManager::dirty)
+  {
+    place(2, &VertexShaderManager::constants, sizeof(VertexShaderConstants));
     VertexShaderManager::dirty = false;
+  }
+  if (GeometryShaderManager::dirty)
+  {
+    place(3, &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
     GeometryShaderManager::dirty = false;
-
-    ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, s_ubo_buffer_size);
   }
+
+  s_buffer->Unmap(upload_size);
 }
 
 void ProgramShaderCache::UploadConstants(const void* data, u32 data_size)
@@ -318,6 +326,11 @@ GLuint ProgramShaderCache::CompileSingleShader(GLenum type, std::string_view cod
   glShaderSource(result, num_strings, src.data(), src_sizes.data());
   glCompileShader(result);
 
+  // The result is checked by the OGLShader when it is first linked, so the driver can compile
+  // several shaders at once.
+  if (IsParallelCompileEnabled() && type != GL_COMPUTE_SHADER)
+    return result;
+
   if (!CheckShaderCompileResult(result, type, code))
   {
     // Don't try to use this shader
@@ -573,6 +586,15 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
   }
   else
   {
+    // Shaders which were compiled in the background are checked before they are first linked.
+    if ((vertex_shader && !vertex_shader->CheckCompileResult()) ||
+        (geometry_shader && !geometry_shader->CheckCompileResult()) ||
+        (pixel_shader && !pixel_shader->CheckCompileResult()))
+    {
+      prog->shader.Destroy();
+      return nullptr;
+    }
+
     // We temporarily change the vertex array to the pipeline's vertex format.
     // This can prevent the NVIDIA OpenGL driver from recompiling on first use.
     GLuint vao = vertex_format ? vertex_format->VAO : s_attributeless_VAO;
@@ -601,10 +623,20 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
     if (!s_is_shared_context && vao != s_last_VAO)
       glBindVertexArray(s_last_VAO);
 
-    if (!CheckProgramLinkResult(prog->shader.glprogid,
-                                vertex_shader ? vertex_shader->GetSource() : std::string_view{},
-                                geometry_shader ? geometry_shader->GetSource() : std::string_view{},
-                                pixel_shader ? pixel_shader->GetSource() : std::string_view{}))
+    if (IsParallelCompileEnabled())
+    {
+      // Don't wait for the driver here, the result is checked by FinishPipelineProgram().
+      prog->link_pending = true;
+      prog->pending_vertex_source = vertex_shader->GetSource();
+      if (geometry_shader)
+        prog->pending_geometry_source = geometry_shader->GetSource();
+      prog->pending_pixel_source = pixel_shader->GetSource();
+    }
+    else if (!CheckProgramLinkResult(
+                 prog->shader.glprogid,
+                 vertex_shader ? vertex_shader->GetSource() : std::string_view{},
+                 geometry_shader ? geometry_shader->GetSource() : std::string_view{},
+                 pixel_shader ? pixel_shader->GetSource() : std::string_view{}))
     {
       prog->shader.Destroy();
       return nullptr;
@@ -624,7 +656,8 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
 
   // Set program variables on the shader which will be returned.
   // This is only needed for drivers which don't support binding layout.
-  prog->shader.SetProgramVariables();
+  if (!prog->link_pending)
+    prog->shader.SetProgramVariables();
 
   // If this is a shared context, ensure we sync before we return the program to
   // the main thread. If we don't do this, some driver can lock up (e.g. AMD).
@@ -635,6 +668,40 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
   return ip.first->second.get();
 }
 
+bool ProgramShaderCache::IsParallelCompileEnabled()
+{
+  // Programs linked on a shared context are synchronized with glFinish() before being handed to
+  // the GPU thread, so there is nothing to gain there.
+  return g_ogl_config.bSupportsParallelShaderCompile && !s_is_shared_context;
+}
+
+bool ProgramShaderCache::IsPipelineProgramLinked(const PipelineProgram* prog)
+{
+  if (!prog->link_pending)
+    return true;
+
+  GLint completed = GL_FALSE;
+  glGetProgramiv(prog->shader.glprogid, GL_COMPLETION_STATUS_KHR, &completed);
+  return completed == GL_TRUE;
+}
+
+void ProgramShaderCache::FinishPipelineProgram(PipelineProgram* prog)
+{
+  if (!prog->link_pending)
+    return;
+
+  prog->link_pending = false;
+  if (CheckProgramLinkResult(prog->shader.glprogid, prog->pending_vertex_source,
+                             prog->pending_geometry_source, prog->pending_pixel_source))
+  {
+    prog->shader.SetProgramVariables();
+  }
+
+  prog->pending_vertex_source = {};
+  prog->pending_geometry_source = {};
+  prog->pending_pixel_source = {};
+}
+
 void ProgramShaderCache::ReleasePipelineProgram(PipelineProgram* prog)
 {
   if (--prog->reference_count > 0)
@@ -733,6 +800,23 @@ void ProgramShaderCache::CreateHeader()
                                         value = func(value, shuffleXorNV(value, 1, 32));
 #define SUBGROUP_MIN(value) SUBGROUP_REDUCTION(min, value)
 #define SUBGROUP_MAX(value) SUBGROUP_REDUCTION(max, value)
+)";
+  }
+  else if (g_ogl_config.bSupportsShaderSubgroupKHR)
+  {
+    shader_shuffle_string = R"(
+#extension GL_KHR_shader_subgroup_basic : enable
+#extension GL_KHR_shader_subgroup_arithmetic : enable
+#extension GL_KHR_shader_subgroup_ballot : enable
+#define SUPPORTS_SUBGROUP_REDUCTION 1
+
+// Unlike the NV xor shuffle, subgroupMin/subgroupMax only consider active invocations.
+#define CAN_USE_SUBGROUP_REDUCTION true
+
+#define IS_HELPER_INVOCATION gl_HelperInvocation
+#define IS_FIRST_ACTIVE_INVOCATION (gl_SubgroupInvocationID == subgroupBallotFindLSB(subgroupBallot(!gl_HelperInvocation)))
+#define SUBGROUP_MIN(value) value = subgroupMin(value)
+#define SUBGROUP_MAX(value) value = subgroupMax(value)
 )";
   }
 
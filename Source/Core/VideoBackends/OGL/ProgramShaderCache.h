@@ -6,6 +6,7 @@
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 
@@ -63,6 +64,13 @@ struct PipelineProgram
   SHADER shader;
   std::atomic_size_t reference_count{1};
   bool binary_retrieved = false;
+
+  // Set while the driver links the program in the background. The sources are only kept for the
+  // error report until ProgramShaderCache::FinishPipelineProgram() checks the link result.
+  bool link_pending = false;
+  std::string pending_vertex_source;
+  std::string pending_geometry_source;
+  std::string pending_pixel_source;
 };
 
 class ProgramShaderCache
@@ -104,6 +112,16 @@ public:
                                              size_t cache_data_size);
   static void ReleasePipelineProgram(PipelineProgram* prog);
 
+  // With GL_KHR_parallel_shader_compile, shaders and programs created on the GPU thread are
+  // compiled and linked by the driver in the background, and their results are checked later.
+  static bool IsParallelCompileEnabled();
+
+  // Returns true if the program can be used without waiting for the driver to finish linking.
+  static bool IsPipelineProgramLinked(const PipelineProgram* prog);
+
+  // Checks the result of a program linked in the background, waiting for it if necessary.
+  static void FinishPipelineProgram(PipelineProgram* prog);
+
 private:
   using PipelineProgramMap =
       std::unordered_map<PipelineProgramKey, std::unique_ptr<PipelineProgram>,
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <vector>
@@ -22,7 +23,36 @@ namespace EfbInterface
 {
 static std::array<u8, EFB_WIDTH * EFB_HEIGHT * 6> efb;
 
-static std::array<u32, PQ_NUM_MEMBERS> perf_values;
+// Pixels counted towards each perf counter in total, and by this thread since it last called
+// FlushPerfCounters(). Rasterizer threads count on their own so they don't contend on the totals.
+static std::array<std::atomic<u64>, PQ_NUM_MEMBERS> perf_pixels;
+static thread_local std::array<u32, PQ_NUM_MEMBERS> thread_perf_pixels;
+
+// Counter values when the perf queries were last reset
+static std::array<u64, PQ_NUM_MEMBERS> perf_reset_values;
+
+static u64 GetPerfCounterValue(PerfQueryType type)
+{
+  // NOTE: hardware doesn't process individual pixels but quads instead.
+  // Current software renderer architecture works on pixels though, so
+  // we have this "quad" hack here to only increment the registers on
+  // every fourth rendered pixel
+  return perf_pixels[type].load(std::memory_order_relaxed) / 3;
+}
+
+// Pixels are packed into 3 bytes, so only those are accessed. Reading and writing back 4 bytes would
+// also touch the first byte of the next pixel, which may be drawn by another rasterizer thread.
+static inline u32 LoadPixel(u32 offset)
+{
+  u32 val = 0;
+  std::memcpy(&val, &efb[offset], 3);
+  return val;
+}
+
+static inline void StorePixel(u32 offset, u32 val)
+{
+  std::memcpy(&efb[offset], &val, 3);
+}
 
 static inline u32 GetColorOffset(u16 x, u16 y)
 {
@@ -48,10 +78,9 @@ static void SetPixelAlphaOnly(u32 offset, u8 a)
   case PixelFormat::RGBA6_Z24:
   {
     u32 a32 = a;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xffffffc0;
+    u32 val = LoadPixel(offset) & 0xffffffc0;
     val |= (a32 >> 2) & 0x0000003f;
-    *dst = val;
+    StorePixel(offset, val);
   }
   break;
   default:
@@ -68,31 +97,28 @@ static void SetPixelColorOnly(u32 offset, u8* rgb)
   case PixelFormat::Z24:
   {
     u32 src = *(u32*)rgb;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
+    u32 val = LoadPixel(offset) & 0xff000000;
     val |= src >> 8;
-    *dst = val;
+    StorePixel(offset, val);
   }
   break;
   case PixelFormat::RGBA6_Z24:
   {
     u32 src = *(u32*)rgb;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff00003f;
+    u32 val = LoadPixel(offset) & 0xff00003f;
     val |= (src >> 4) & 0x00000fc0;  // blue
     val |= (src >> 6) & 0x0003f000;  // green
     val |= (src >> 8) & 0x00fc0000;  // red
-    *dst = val;
+    StorePixel(offset, val);
   }
   break;
   case PixelFormat::RGB565_Z16:
   {
     // TODO: RGB565_Z16 is not supported correctly yet
     u32 src = *(u32*)rgb;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
+    u32 val = LoadPixel(offset) & 0xff000000;
     val |= src >> 8;
-    *dst = val;
+    StorePixel(offset, val);
   }
   break;
   default:
@@ -109,32 +135,29 @@ static void SetPixelAlphaColor(u32 offset, u8* color)
   case PixelFormat::Z24:
   {
     u32 src = *(u32*)color;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
+    u32 val = LoadPixel(offset) & 0xff000000;
     val |= src >> 8;
-    *dst = val;
+    StorePixel(offset, val);
   }
   break;
   case PixelFormat::RGBA6_Z24:
   {
     u32 src = *(u32*)color;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
+    u32 val = LoadPixel(offset) & 0xff000000;
     val |= (src >> 2) & 0x0000003f;  // alpha
     val |= (src >> 4) & 0x00000fc0;  // blue
     val |= (src >> 6) & 0x0003f000;  // green
     val |= (src >> 8) & 0x00fc0000;  // red
-    *dst = val;
+    StorePixel(offset, val);
   }
   break;
   case PixelFormat::RGB565_Z16:
   {
     // TODO: RGB565_Z16 is not supported correctly yet
     u32 src = *(u32*)color;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
+    u32 val = LoadPixel(offset) & 0xff000000;
     val |= src >> 8;
-    *dst = val;
+    StorePixel(offset, val);
   }
   break;
   default:
@@ -145,8 +168,7 @@ static void SetPixelAlphaColor(u32 offset, u8* color)
 
 static u32 GetPixelColor(u32 offset)
 {
-  u32 src;
-  std::memcpy(&src, &efb[offset], sizeof(u32));
+  const u32 src = LoadPixel(offset);
 
   switch (bpmem.zcontrol.pixel_format)
   {
@@ -178,19 +200,17 @@ static void SetPixelDepth(u32 offset, u32 depth)
   case PixelFormat::RGBA6_Z24:
   case PixelFormat::Z24:
   {
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
+    u32 val = LoadPixel(offset) & 0xff000000;
     val |= depth & 0x00ffffff;
-    *dst = val;
+    StorePixel(offset, val);
   }
   break;
   case PixelFormat::RGB565_Z16:
   {
     // TODO: RGB565_Z16 is not supported correctly yet
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
+    u32 val = LoadPixel(offset) & 0xff000000;
     val |= depth & 0x00ffffff;
-    *dst = val;
+    StorePixel(offset, val);
   }
   break;
   default:
@@ -209,13 +229,13 @@ static u32 GetPixelDepth(u32 offset)
   case PixelFormat::RGBA6_Z24:
   case PixelFormat::Z24:
   {
-    depth = (*(u32*)&efb[offset]) & 0x00ffffff;
+    depth = LoadPixel(offset);
   }
   break;
   case PixelFormat::RGB565_Z16:
   {
     // TODO: RGB565_Z16 is not supported correctly yet
-    depth = (*(u32*)&efb[offset]) & 0x00ffffff;
+    depth = LoadPixel(offset);
   }
   break;
   default:
@@ -696,24 +716,29 @@ bool ZCompare(u16 x, u16 y, u32 z)
 
 u32 GetPerfQueryResult(PerfQueryType type)
 {
-  return perf_values[type];
+  return static_cast<u32>(GetPerfCounterValue(type) - perf_reset_values[type]);
 }
 
 void ResetPerfQuery()
 {
-  perf_values = {};
+  for (size_t i = 0; i < PQ_NUM_MEMBERS; ++i)
+    perf_reset_values[i] = GetPerfCounterValue(static_cast<PerfQueryType>(i));
 }
 
 void IncPerfCounterQuadCount(PerfQueryType type)
 {
-  // NOTE: hardware doesn't process individual pixels but quads instead.
-  // Current software renderer architecture works on pixels though, so
-  // we have this "quad" hack here to only increment the registers on
-  // every fourth rendered pixel
-  static u32 quad[PQ_NUM_MEMBERS];
-  if (++quad[type] != 3)
-    return;
-  quad[type] = 0;
-  ++perf_values[type];
+  ++thread_perf_pixels[type];
+}
+
+void FlushPerfCounters()
+{
+  for (size_t i = 0; i < PQ_NUM_MEMBERS; ++i)
+  {
+    if (thread_perf_pixels[i] != 0)
+    {
+      perf_pixels[i].fetch_add(thread_perf_pixels[i], std::memory_order_relaxed);
+      thread_perf_pixels[i] = 0;
+    }
+  }
 }
 }  // namespace EfbInterface
@@ -59,4 +59,6 @@ void EncodeXFB(u8* xfb_in_ram, u32 memory_stride, const MathUtil::Rectangle<int>
 u32 GetPerfQueryResult(PerfQueryType type);
 void ResetPerfQuery();
 void IncPerfCounterQuadCount(PerfQueryType type);
+// Adds the pixels counted by the calling thread to the perf counters.
+void FlushPerfCounters();
 }  // namespace EfbInterface
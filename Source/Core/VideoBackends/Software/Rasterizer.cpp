@@ -4,11 +4,17 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
@@ -25,6 +31,17 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// Triangles are binned into square tiles of the EFB, which are rasterized in parallel. Each tile
+// draws its triangles in the order they were submitted, so the result is the same as drawing them
+// one after another. Tiles are a multiple of the block size, so blocks are never split.
+static constexpr int TILE_SIZE = 64;
+static constexpr int TILES_X = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr int TILES_Y = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+static_assert(TILE_SIZE % BLOCK_SIZE == 0);
+
+// Queued triangles take about a kilobyte each, so don't let huge draws queue too many.
+static constexpr size_t MAX_QUEUED_TRIANGLES = 4096;
+
 struct SlopeContext
 {
   SlopeContext(const OutputVertexData* v0, const OutputVertexData* v1, const OutputVertexData* v2,
@@ -96,21 +113,67 @@ struct Slope
   }
 };
 
-static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
+// Everything needed to rasterize a triangle once it has been set up
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // Half-edge constants and deltas, in 28.4 fixed point
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Bounding rectangle, clipped to the scissor
+  s32 minx, maxx, miny, maxy;
+};
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// State used while rasterizing, one for each thread
+struct RasterContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  int rasterizedPixels = 0;
+};
+
+// Set up in submission order, since zfreeze uses the slope of the last triangle
+static Slope ZSlope;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
+static std::vector<TriangleSetup> queuedTriangles;
+static std::array<std::vector<u32>, TILES_X * TILES_Y> tileTriangles;
+static std::vector<u32> activeTiles;
+
+static Common::ThreadPool workerThreads;
+
 void Init()
 {
   // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
   // needs to be set to an (untested) default value.
   ZSlope = Slope();
+
+  workerThreads.Reset(g_ActiveConfig.GetSWRasterizerThreads(), "Software Rasterizer");
+}
+
+void Shutdown()
+{
+  workerThreads.Shutdown();
+  queuedTriangles.clear();
+  for (std::vector<u32>& triangles : tileTriangles)
+    triangles.clear();
+  activeTiles.clear();
+}
+
+static RasterContext& GetThreadContext()
+{
+  // Tev holds references to its own members, so it can't be copied around
+  static thread_local std::unique_ptr<RasterContext> context;
+  if (!context)
+    context = std::make_unique<RasterContext>();
+  return *context;
 }
 
 void ScissorChanged()
@@ -140,16 +203,14 @@ static inline int iround(float x)
   return t;
 }
 
-void SetTevKonstColors()
+static void Draw(RasterContext& ctx, const TriangleSetup& tri, s32 x, s32 y, s32 xi, s32 yi)
 {
-  tev.SetKonstColors();
-}
+  INCSTAT(ctx.rasterizedPixels);
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
-{
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  Tev& tev = ctx.tev;
+  const RasterBlock& rasterBlock = ctx.rasterBlock;
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(tri.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
   {
@@ -164,7 +225,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -175,7 +236,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(x, y);
+      u16 color = (u16)tri.ColorSlopes[i][comp].GetValue(x, y);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -207,7 +268,8 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   tev.Draw();
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -218,9 +280,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
@@ -258,7 +320,7 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, const TriangleSetup& tri, s32 blockX, s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -269,19 +331,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / tri.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = tri.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = tri.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = tri.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -291,7 +353,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -303,7 +366,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -320,9 +384,9 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
   }
 }
 
-static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                                  const OutputVertexData* v2,
-                                  const BPFunctions::ScissorRect& scissor)
+static bool SetupTriangle(const OutputVertexData* v0, const OutputVertexData* v1,
+                          const OutputVertexData* v2, const BPFunctions::ScissorRect& scissor,
+                          TriangleSetup* tri)
 {
   // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
   // zfreeze depends on it
@@ -349,15 +413,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -376,7 +431,9 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   maxy = std::min(maxy, scissor.rect.bottom);
 
   if (minx >= maxx || miny >= maxy)
-    return;
+    return false;
+
+  tri->ZSlope = ZSlope;
 
   // Set up the remaining slopes
   const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
@@ -384,20 +441,23 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
 
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
+  tri->WSlope = Slope(w[0], w[1], w[2], ctx);
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    {
+      tri->ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
     {
-      TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                                 v2->texCoords[i][comp] * w[2], ctx);
+      tri->TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
+                                      v2->texCoords[i][comp] * w[2], ctx);
     }
   }
 
@@ -414,6 +474,55 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
     C3++;
 
+  tri->C1 = C1;
+  tri->C2 = C2;
+  tri->C3 = C3;
+  tri->DX12 = DX12;
+  tri->DX23 = DX23;
+  tri->DX31 = DX31;
+  tri->DY12 = DY12;
+  tri->DY23 = DY23;
+  tri->DY31 = DY31;
+  tri->minx = minx;
+  tri->maxx = maxx;
+  tri->miny = miny;
+  tri->maxy = maxy;
+  return true;
+}
+
+static void RasterizeTriangle(RasterContext& context, const TriangleSetup& tri,
+                              const MathUtil::Rectangle<s32>& tile)
+{
+  const s32 C1 = tri.C1;
+  const s32 C2 = tri.C2;
+  const s32 C3 = tri.C3;
+
+  const s32 DX12 = tri.DX12;
+  const s32 DX23 = tri.DX23;
+  const s32 DX31 = tri.DX31;
+
+  const s32 DY12 = tri.DY12;
+  const s32 DY23 = tri.DY23;
+  const s32 DY31 = tri.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
+  // Only the part of the triangle inside this tile
+  const s32 minx = std::max(tri.minx, tile.left);
+  const s32 maxx = std::min(tri.maxx, tile.right);
+  const s32 miny = std::max(tri.miny, tile.top);
+  const s32 maxy = std::min(tri.maxy, tile.bottom);
+
+  if (minx >= maxx || miny >= maxy)
+    return;
+
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
   s32 block_miny = miny & ~(BLOCK_SIZE - 1);
@@ -455,7 +564,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(context.rasterBlock, tri, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -465,7 +574,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(context, tri, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -488,7 +597,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(context, tri, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -505,12 +614,78 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+static void QueueTriangle(const TriangleSetup& tri)
+{
+  const u32 index = static_cast<u32>(queuedTriangles.size());
+  queuedTriangles.push_back(tri);
+
+  const int tile_minx = tri.minx / TILE_SIZE;
+  const int tile_maxx = (tri.maxx - 1) / TILE_SIZE;
+  const int tile_miny = tri.miny / TILE_SIZE;
+  const int tile_maxy = (tri.maxy - 1) / TILE_SIZE;
+  for (int tile_y = tile_miny; tile_y <= tile_maxy; tile_y++)
+  {
+    for (int tile_x = tile_minx; tile_x <= tile_maxx; tile_x++)
+    {
+      const u32 tile = static_cast<u32>(tile_y * TILES_X + tile_x);
+      if (tileTriangles[tile].empty())
+        activeTiles.push_back(tile);
+      tileTriangles[tile].push_back(index);
+    }
+  }
+
+  if (queuedTriangles.size() >= MAX_QUEUED_TRIANGLES)
+    Flush();
+}
+
+void Flush()
+{
+  if (queuedTriangles.empty())
+    return;
+
+  std::atomic<int> rasterized_pixels{0};
+  std::atomic<int> tev_pixels_in{0};
+  std::atomic<int> tev_pixels_out{0};
+
+  workerThreads.RunParallel(activeTiles.size(), [&](size_t i) {
+    const u32 tile = activeTiles[i];
+    const s32 left = static_cast<s32>(tile % TILES_X) * TILE_SIZE;
+    const s32 top = static_cast<s32>(tile / TILES_X) * TILE_SIZE;
+    const MathUtil::Rectangle<s32> tile_rect(
+        left, top, std::min(left + TILE_SIZE, static_cast<s32>(EFB_WIDTH)),
+        std::min(top + TILE_SIZE, static_cast<s32>(EFB_HEIGHT)));
+
+    RasterContext& context = GetThreadContext();
+    context.tev.SetKonstColors();
+    for (const u32 index : tileTriangles[tile])
+      RasterizeTriangle(context, queuedTriangles[index], tile_rect);
+
+    rasterized_pixels += std::exchange(context.rasterizedPixels, 0);
+    tev_pixels_in += std::exchange(context.tev.PixelsIn, 0);
+    tev_pixels_out += std::exchange(context.tev.PixelsOut, 0);
+    EfbInterface::FlushPerfCounters();
+  });
+
+  ADDSTAT(g_stats.this_frame.rasterized_pixels, rasterized_pixels.load());
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, tev_pixels_in.load());
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, tev_pixels_out.load());
+
+  for (const u32 tile : activeTiles)
+    tileTriangles[tile].clear();
+  activeTiles.clear();
+  queuedTriangles.clear();
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
   INCSTAT(g_stats.this_frame.num_triangles_drawn);
 
   for (const auto& scissor : scissors)
-    DrawTriangleFrontFace(v0, v1, v2, scissor);
+  {
+    TriangleSetup tri;
+    if (SetupTriangle(v0, v1, v2, scissor, &tri))
+      QueueTriangle(tri);
+  }
 }
 }  // namespace Rasterizer
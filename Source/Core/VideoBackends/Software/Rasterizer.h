@@ -10,6 +10,7 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
@@ -17,7 +18,9 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
 
-void SetTevKonstColors();
+// Triangles are queued up and rasterized on several threads. This finishes drawing them, and must
+// be called before the EFB is accessed or any state they use changes.
+void Flush();
 
 struct RasterBlockPixel
 {
@@ -64,7 +64,6 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
     g_renderer->BBoxFlush();
 
   m_setup_unit.Init(primitive_type);
-  Rasterizer::SetTevKonstColors();
 
   for (u32 i = 0; i < m_index_generator.GetIndexLen(); i++)
   {
@@ -90,6 +89,8 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
     INCSTAT(g_stats.this_frame.num_vertices_loaded);
   }
 
+  Rasterizer::Flush();
+
   INCSTAT(g_stats.this_frame.num_drawn_objects);
 }
 
@@ -89,6 +89,9 @@ void VideoSoftware::InitBackendInfo()
   g_Config.backend_info.bSupportsSettingObjectNames = false;
   g_Config.backend_info.bSupportsPartialMultisampleResolve = true;
   g_Config.backend_info.bSupportsDynamicVertexLoader = false;
+  g_Config.backend_info.bSupportsD24S8DepthBuffer = false;
+  g_Config.backend_info.bSupportsETC2Textures = false;
+  g_Config.backend_info.bSupportsASTCTextures = false;
 
   // aamodes
   g_Config.backend_info.AAModes = {1};
@@ -127,6 +130,8 @@ bool VideoSoftware::Initialize(const WindowSystemInfo& wsi)
 
 void VideoSoftware::Shutdown()
 {
+  Rasterizer::Shutdown();
+
   if (g_shader_cache)
     g_shader_cache->Shutdown();
 
@@ -20,6 +20,12 @@
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
+#if defined(_M_X86_64)
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #ifdef _DEBUG
 #define ALLOW_TEV_DUMPS 1
 #else
@@ -195,6 +201,111 @@ void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const Inpu
     Reg[ac.dest].a = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
 }
 
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+// Evaluates the regular color and alpha combiners of a stage at once, including the clamping, with
+// the channels in the lanes of a vector (in the same ABGR order as TevColor). The results are
+// identical to DrawColorRegular and DrawAlphaRegular, which differ slightly in how they round
+// subtractions: the alpha combiner negates before dividing by 256, the color one after.
+void Tev::DrawRegularSIMD(const TevStageCombiner::ColorCombiner& cc,
+                          const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
+{
+  const bool color_sub = cc.op == TevOp::Sub;
+  const bool alpha_sub = ac.op == TevOp::Sub;
+  const s32 color_lshift = s_ScaleLShiftLUT[cc.scale];
+  const s32 alpha_lshift = s_ScaleLShiftLUT[ac.scale];
+  const s32 color_round = (cc.scale == TevScale::Divide2) ? 0 : color_sub ? 127 : 128;
+  const s32 alpha_round = (ac.scale == TevScale::Divide2) ? 0 : alpha_sub ? 127 : 128;
+
+  alignas(16) s32 a[4], b[4], c[4], d[4];
+  for (int i = 0; i < 4; i++)
+  {
+    const s32 bias = s_BiasLUT[i == ALP_C ? ac.bias : cc.bias];
+    a[i] = inputs[i].a;
+    b[i] = inputs[i].b;
+    c[i] = inputs[i].c + (inputs[i].c >> 7);
+    d[i] = inputs[i].d + bias;
+  }
+
+  alignas(8) s16 result[4];
+#if defined(_M_X86_64)
+  // All the multiplications fit in 16 bits, so pmaddwd does them on the low halves of the lanes.
+  const __m128i scale = _mm_setr_epi32(1 << alpha_lshift, 1 << color_lshift, 1 << color_lshift,
+                                       1 << color_lshift);
+  const __m128i round = _mm_setr_epi32(alpha_round, color_round, color_round, color_round);
+  const __m128i negate_before = _mm_setr_epi32(alpha_sub ? -1 : 0, 0, 0, 0);
+  const __m128i negate_after =
+      _mm_setr_epi32(0, color_sub ? -1 : 0, color_sub ? -1 : 0, color_sub ? -1 : 0);
+  const __m128i divide2 =
+      _mm_setr_epi32(ac.scale == TevScale::Divide2 ? -1 : 0, cc.scale == TevScale::Divide2 ? -1 : 0,
+                     cc.scale == TevScale::Divide2 ? -1 : 0, cc.scale == TevScale::Divide2 ? -1 : 0);
+  const __m128i clamp_min = _mm_setr_epi16(ac.clamp ? 0 : -1024, cc.clamp ? 0 : -1024,
+                                           cc.clamp ? 0 : -1024, cc.clamp ? 0 : -1024, 0, 0, 0, 0);
+  const __m128i clamp_max = _mm_setr_epi16(ac.clamp ? 255 : 1023, cc.clamp ? 255 : 1023,
+                                           cc.clamp ? 255 : 1023, cc.clamp ? 255 : 1023, 0, 0, 0, 0);
+
+  const __m128i va = _mm_load_si128(reinterpret_cast<const __m128i*>(a));
+  const __m128i vb = _mm_load_si128(reinterpret_cast<const __m128i*>(b));
+  const __m128i vc = _mm_load_si128(reinterpret_cast<const __m128i*>(c));
+  const __m128i vd = _mm_load_si128(reinterpret_cast<const __m128i*>(d));
+
+  // (a * (256 - c) + b * c) << lshift, with the shift folded into the weights
+  const __m128i weight_a = _mm_madd_epi16(_mm_sub_epi32(_mm_set1_epi32(256), vc), scale);
+  const __m128i weight_b = _mm_madd_epi16(vc, scale);
+  __m128i temp = _mm_add_epi32(_mm_madd_epi16(va, weight_a), _mm_madd_epi16(vb, weight_b));
+  temp = _mm_add_epi32(temp, round);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_before), negate_before);
+  temp = _mm_srai_epi32(temp, 8);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_after), negate_after);
+
+  // (d + bias) can be negative, but the high half of scale is zero so pmaddwd still works
+  __m128i sum = _mm_add_epi32(_mm_madd_epi16(vd, scale), temp);
+  sum = _mm_or_si128(_mm_and_si128(divide2, _mm_srai_epi32(sum, 1)),
+                     _mm_andnot_si128(divide2, sum));
+
+  __m128i packed = _mm_packs_epi32(sum, sum);
+  packed = _mm_max_epi16(_mm_min_epi16(packed, clamp_max), clamp_min);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(result), packed);
+#elif defined(_M_ARM_64)
+  alignas(16) const s32 lshift[4] = {alpha_lshift, color_lshift, color_lshift, color_lshift};
+  alignas(16) const s32 rshift[4] = {-s_ScaleRShiftLUT[ac.scale], -s_ScaleRShiftLUT[cc.scale],
+                                     -s_ScaleRShiftLUT[cc.scale], -s_ScaleRShiftLUT[cc.scale]};
+  alignas(16) const s32 round[4] = {alpha_round, color_round, color_round, color_round};
+  alignas(16) const s32 negate_before[4] = {alpha_sub ? -1 : 0, 0, 0, 0};
+  alignas(16) const s32 negate_after[4] = {0, color_sub ? -1 : 0, color_sub ? -1 : 0,
+                                           color_sub ? -1 : 0};
+  alignas(8) const s16 clamp_min[4] = {s16(ac.clamp ? 0 : -1024), s16(cc.clamp ? 0 : -1024),
+                                       s16(cc.clamp ? 0 : -1024), s16(cc.clamp ? 0 : -1024)};
+  alignas(8) const s16 clamp_max[4] = {s16(ac.clamp ? 255 : 1023), s16(cc.clamp ? 255 : 1023),
+                                       s16(cc.clamp ? 255 : 1023), s16(cc.clamp ? 255 : 1023)};
+
+  const int32x4_t vc = vld1q_s32(c);
+  const int32x4_t vlshift = vld1q_s32(lshift);
+  const int32x4_t vnegate_before = vld1q_s32(negate_before);
+  const int32x4_t vnegate_after = vld1q_s32(negate_after);
+
+  int32x4_t temp = vmulq_s32(vld1q_s32(a), vsubq_s32(vdupq_n_s32(256), vc));
+  temp = vmlaq_s32(temp, vld1q_s32(b), vc);
+  temp = vaddq_s32(vshlq_s32(temp, vlshift), vld1q_s32(round));
+  temp = vsubq_s32(veorq_s32(temp, vnegate_before), vnegate_before);
+  temp = vshrq_n_s32(temp, 8);
+  temp = vsubq_s32(veorq_s32(temp, vnegate_after), vnegate_after);
+
+  // Shifting by a negative amount is an arithmetic right shift
+  int32x4_t sum = vaddq_s32(vshlq_s32(vld1q_s32(d), vlshift), temp);
+  sum = vshlq_s32(sum, vld1q_s32(rshift));
+
+  int16x4_t packed = vqmovn_s32(sum);
+  packed = vmax_s16(vmin_s16(packed, vld1_s16(clamp_max)), vld1_s16(clamp_min));
+  vst1_s16(result, packed);
+#endif
+
+  Reg[cc.dest].b = result[BLU_C];
+  Reg[cc.dest].g = result[GRN_C];
+  Reg[cc.dest].r = result[RED_C];
+  Reg[ac.dest].a = result[ALP_C];
+}
+#endif
+
 static bool AlphaCompare(int alpha, int ref, CompareMode comp)
 {
   switch (comp)
@@ -394,7 +505,7 @@ void Tev::Draw()
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  INCSTAT(PixelsIn);
 
   // initial color values
   for (int i = 0; i < 4; i++)
@@ -504,6 +615,14 @@ void Tev::Draw()
     inputs[ALP_C].c = m_AlphaInputLUT[ac.c].a;
     inputs[ALP_C].d = m_AlphaInputLUT[ac.d].a;
 
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+    if (cc.bias != TevBias::Compare && ac.bias != TevBias::Compare)
+    {
+      DrawRegularSIMD(cc, ac, inputs);
+      continue;
+    }
+#endif
+
     if (cc.bias != TevBias::Compare)
       DrawColorRegular(cc, inputs);
     else
@@ -686,7 +805,7 @@ void Tev::Draw()
   BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
                       static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
+  INCSTAT(PixelsOut);
   EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
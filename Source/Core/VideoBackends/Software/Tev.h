@@ -206,6 +206,8 @@ class Tev
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
   void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+  void DrawRegularSIMD(const TevStageCombiner::ColorCombiner& cc,
+                       const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
@@ -218,6 +220,10 @@ public:
   s32 TextureLod[16];
   bool TextureLinear[16];
 
+  // Counted here rather than in g_stats, since several threads may be drawing at once
+  int PixelsIn = 0;
+  int PixelsOut = 0;
+
   enum
   {
     ALP_C,
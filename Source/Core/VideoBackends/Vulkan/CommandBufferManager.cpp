@@ -77,6 +77,20 @@ bool CommandBufferManager::CreateCommandBuffers()
       return false;
     }
 
+    if (g_vulkan_context->HasTransferQueue())
+    {
+      VkCommandPoolCreateInfo transfer_pool_info = {
+          VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, nullptr, 0,
+          g_vulkan_context->GetTransferQueueFamilyIndex()};
+      res = vkCreateCommandPool(device, &transfer_pool_info, nullptr,
+                                &resources.transfer_command_pool);
+      if (res != VK_SUCCESS)
+      {
+        LOG_VULKAN_ERROR(res, "vkCreateCommandPool failed: ");
+        return false;
+      }
+    }
+
     VkFenceCreateInfo fence_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr,
                                     VK_FENCE_CREATE_SIGNALED_BIT};
 
@@ -102,6 +116,21 @@ bool CommandBufferManager::CreateCommandBuffers()
     return false;
   }
 
+  if (g_vulkan_context->HasTransferQueue())
+  {
+    const VkSemaphoreTypeCreateInfoKHR semaphore_type_info = {
+        VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR, nullptr, VK_SEMAPHORE_TYPE_TIMELINE_KHR,
+        0};
+    const VkSemaphoreCreateInfo transfer_semaphore_info = {
+        VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, &semaphore_type_info, 0};
+    res = vkCreateSemaphore(device, &transfer_semaphore_info, nullptr, &m_transfer_semaphore);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkCreateSemaphore failed: ");
+      return false;
+    }
+  }
+
   // Activate the first command buffer. BeginCommandBuffer moves forward, so start with the last
   m_current_cmd_buffer = static_cast<u32>(m_command_buffers.size()) - 1;
   BeginCommandBuffer();
@@ -120,6 +149,8 @@ void CommandBufferManager::DestroyCommandBuffers()
     // objects which are pending destruction being in-use.
     if (resources.command_pool != VK_NULL_HANDLE)
       vkDestroyCommandPool(device, resources.command_pool, nullptr);
+    if (resources.transfer_command_pool != VK_NULL_HANDLE)
+      vkDestroyCommandPool(device, resources.transfer_command_pool, nullptr);
 
     // Destroy any pending objects.
     for (auto& it : resources.cleanup_resources)
@@ -141,6 +172,8 @@ void CommandBufferManager::DestroyCommandBuffers()
   }
 
   vkDestroySemaphore(device, m_present_semaphore, nullptr);
+  if (m_transfer_semaphore != VK_NULL_HANDLE)
+    vkDestroySemaphore(device, m_transfer_semaphore, nullptr);
 }
 
 VkDescriptorPool CommandBufferManager::CreateDescriptorPool(u32 max_descriptor_sets)
@@ -238,7 +271,7 @@ bool CommandBufferManager::CreateSubmitThread()
       }
 
       SubmitCommandBuffer(submit.command_buffer_index, submit.present_swap_chain,
-                          submit.present_image_index);
+                          submit.present_image_index, submit.present_time);
       CmdBufferResources& resources = m_command_buffers[submit.command_buffer_index];
       resources.waiting_for_submit.store(false, std::memory_order_release);
 
@@ -325,11 +358,90 @@ void CommandBufferManager::WaitForCommandBufferCompletion(u32 index)
   m_completed_fence_counter = now_completed_counter;
 }
 
+VkCommandBuffer CommandBufferManager::GetCurrentTransferCommandBuffer()
+{
+  if (m_current_transfer_command_buffer != VK_NULL_HANDLE)
+    return m_current_transfer_command_buffer;
+
+  // Transfers may be submitted several times for one command buffer, so these are allocated as
+  // they are needed and kept around for the next time the pool is used.
+  CmdBufferResources& resources = GetCurrentCmdBufferResources();
+  if (resources.transfer_command_buffers_used == resources.transfer_command_buffers.size())
+  {
+    const VkCommandBufferAllocateInfo buffer_info = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, resources.transfer_command_pool,
+        VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1};
+    VkCommandBuffer command_buffer;
+    VkResult res =
+        vkAllocateCommandBuffers(g_vulkan_context->GetDevice(), &buffer_info, &command_buffer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkAllocateCommandBuffers failed: ");
+      PanicAlertFmt("Failed to allocate transfer command buffer: {} ({})", VkResultToString(res),
+                    static_cast<int>(res));
+    }
+    resources.transfer_command_buffers.push_back(command_buffer);
+  }
+
+  VkCommandBuffer command_buffer =
+      resources.transfer_command_buffers[resources.transfer_command_buffers_used++];
+  const VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
+                                               VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                                               nullptr};
+  VkResult res = vkBeginCommandBuffer(command_buffer, &begin_info);
+  if (res != VK_SUCCESS)
+    LOG_VULKAN_ERROR(res, "vkBeginCommandBuffer failed: ");
+
+  m_current_transfer_command_buffer = command_buffer;
+  return command_buffer;
+}
+
+void CommandBufferManager::SubmitTransferCommandBuffer()
+{
+  if (m_current_transfer_command_buffer == VK_NULL_HANDLE)
+    return;
+
+  VkResult res = vkEndCommandBuffer(m_current_transfer_command_buffer);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
+    PanicAlertFmt("Failed to end command buffer: {} ({})", VkResultToString(res),
+                  static_cast<int>(res));
+  }
+
+  const u64 signal_value = ++m_transfer_semaphore_value;
+  const VkTimelineSemaphoreSubmitInfoKHR timeline_info = {
+      VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR, nullptr, 0, nullptr, 1, &signal_value};
+  const VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                                    &timeline_info,
+                                    0,
+                                    nullptr,
+                                    nullptr,
+                                    1,
+                                    &m_current_transfer_command_buffer,
+                                    1,
+                                    &m_transfer_semaphore};
+  res = vkQueueSubmit(g_vulkan_context->GetTransferQueue(), 1, &submit_info, VK_NULL_HANDLE);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkQueueSubmit failed: ");
+    PanicAlertFmt("Failed to submit transfer command buffer: {} ({})", VkResultToString(res),
+                  static_cast<int>(res));
+  }
+
+  GetCurrentCmdBufferResources().transfer_wait_value = signal_value;
+  m_current_transfer_command_buffer = VK_NULL_HANDLE;
+}
+
 void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
                                                bool wait_for_completion,
                                                VkSwapchainKHR present_swap_chain,
-                                               uint32_t present_image_index)
+                                               uint32_t present_image_index,
+                                               VkPresentTimeGOOGLE present_time)
 {
+  // Transfers have to be on the transfer queue before the command buffer which waits for them.
+  SubmitTransferCommandBuffer();
+
   // End the current command buffer.
   CmdBufferResources& resources = GetCurrentCmdBufferResources();
   for (VkCommandBuffer command_buffer : resources.command_buffers)
@@ -351,7 +463,8 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
     {
       std::lock_guard<std::mutex> guard(m_pending_submit_lock);
       m_submit_worker_idle = false;
-      m_pending_submits.push_back({present_swap_chain, present_image_index, m_current_cmd_buffer});
+      m_pending_submits.push_back(
+          {present_swap_chain, present_image_index, m_current_cmd_buffer, present_time});
     }
 
     // Wake up the worker thread for a single iteration.
@@ -362,7 +475,8 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
     WaitForWorkerThreadIdle();
 
     // Pass through to normal submission path.
-    SubmitCommandBuffer(m_current_cmd_buffer, present_swap_chain, present_image_index);
+    SubmitCommandBuffer(m_current_cmd_buffer, present_swap_chain, present_image_index,
+                        present_time);
     if (wait_for_completion)
       WaitForCommandBufferCompletion(m_current_cmd_buffer);
   }
@@ -415,17 +529,21 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
 
 void CommandBufferManager::SubmitCommandBuffer(u32 command_buffer_index,
                                                VkSwapchainKHR present_swap_chain,
-                                               u32 present_image_index)
+                                               u32 present_image_index,
+                                               const VkPresentTimeGOOGLE& present_time)
 {
   CmdBufferResources& resources = m_command_buffers[command_buffer_index];
 
   // This may be executed on the worker thread, so don't modify any state of the manager class.
-  uint32_t wait_bits = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  std::array<VkSemaphore, 2> wait_semaphores;
+  std::array<VkPipelineStageFlags, 2> wait_stages;
+  std::array<u64, 2> wait_values = {};
+  u32 wait_count = 0;
   VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO,
                               nullptr,
                               0,
-                              nullptr,
-                              &wait_bits,
+                              wait_semaphores.data(),
+                              wait_stages.data(),
                               static_cast<u32>(resources.command_buffers.size()),
                               resources.command_buffers.data(),
                               0,
@@ -440,9 +558,23 @@ void CommandBufferManager::SubmitCommandBuffer(u32 command_buffer_index,
 
   if (resources.semaphore_used)
   {
-    submit_info.pWaitSemaphores = &resources.semaphore;
-    submit_info.waitSemaphoreCount = 1;
+    wait_semaphores[wait_count] = resources.semaphore;
+    wait_stages[wait_count++] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  }
+
+  // The init command buffer takes ownership of the textures uploaded on the transfer queue.
+  VkTimelineSemaphoreSubmitInfoKHR timeline_info = {
+      VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR, nullptr, 0, nullptr, 0, nullptr};
+  if (resources.transfer_wait_value != 0)
+  {
+    wait_semaphores[wait_count] = m_transfer_semaphore;
+    wait_values[wait_count] = resources.transfer_wait_value;
+    wait_stages[wait_count++] = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    timeline_info.waitSemaphoreValueCount = wait_count;
+    timeline_info.pWaitSemaphoreValues = wait_values.data();
+    submit_info.pNext = &timeline_info;
   }
+  submit_info.waitSemaphoreCount = wait_count;
 
   if (present_swap_chain != VK_NULL_HANDLE)
   {
@@ -472,6 +604,11 @@ void CommandBufferManager::SubmitCommandBuffer(u32 command_buffer_index,
                                      &present_image_index,
                                      nullptr};
 
+    VkPresentTimesInfoGOOGLE present_times_info = {VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE,
+                                                   nullptr, 1, &present_time};
+    if (present_time.presentID != 0)
+      present_info.pNext = &present_times_info;
+
     m_last_present_result = vkQueuePresentKHR(g_vulkan_context->GetPresentQueue(), &present_info);
     m_last_present_done.Set();
     if (m_last_present_result != VK_SUCCESS)
@@ -516,6 +653,16 @@ void CommandBufferManager::BeginCommandBuffer()
   if (res != VK_SUCCESS)
     LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
 
+  // The transfers were waited for by the command buffer, so they are done too.
+  if (resources.transfer_command_pool != VK_NULL_HANDLE)
+  {
+    res = vkResetCommandPool(g_vulkan_context->GetDevice(), resources.transfer_command_pool, 0);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+  }
+  resources.transfer_command_buffers_used = 0;
+  resources.transfer_wait_value = 0;
+
   // Enable commands to be recorded to the two buffers again.
   VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
                                          VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr};
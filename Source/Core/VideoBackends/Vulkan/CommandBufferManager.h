@@ -43,6 +43,14 @@ public:
     const CmdBufferResources& cmd_buffer_resources = m_command_buffers[m_current_cmd_buffer];
     return cmd_buffer_resources.command_buffers[1];
   }
+  // Command buffer for the transfer queue, only available when the context has one. Its commands
+  // run before the current command buffer, and they must release any resources they write to the
+  // graphics queue family. Submitting the current command buffer submits it too.
+  VkCommandBuffer GetCurrentTransferCommandBuffer();
+  // Starts the recorded transfers right away, rather than when the current command buffer is
+  // submitted.
+  void SubmitTransferCommandBuffer();
+
   // Allocates a descriptors set from the pool reserved for the current frame.
   VkDescriptorSet AllocateDescriptorSet(VkDescriptorSetLayout set_layout);
 
@@ -76,9 +84,11 @@ public:
   // Also invokes callbacks for completion.
   void WaitForFenceCounter(u64 fence_counter);
 
+  // If present_time has a non-zero ID, it's passed to the present with VK_GOOGLE_display_timing.
   void SubmitCommandBuffer(bool submit_on_worker_thread, bool wait_for_completion,
                            VkSwapchainKHR present_swap_chain = VK_NULL_HANDLE,
-                           uint32_t present_image_index = 0xFFFFFFFF);
+                           uint32_t present_image_index = 0xFFFFFFFF,
+                           VkPresentTimeGOOGLE present_time = {});
 
   // Was the last present submitted to the queue a failure? If so, we must recreate our swapchain.
   bool CheckLastPresentFail() { return m_last_present_failed.TestAndClear(); }
@@ -101,7 +111,7 @@ private:
 
   void WaitForCommandBufferCompletion(u32 command_buffer_index);
   void SubmitCommandBuffer(u32 command_buffer_index, VkSwapchainKHR present_swap_chain,
-                           u32 present_image_index);
+                           u32 present_image_index, const VkPresentTimeGOOGLE& present_time);
   void BeginCommandBuffer();
 
   VkDescriptorPool CreateDescriptorPool(u32 descriptor_sizes);
@@ -113,6 +123,13 @@ private:
     // [0] - Init (upload) command buffer, [1] - draw command buffer
     VkCommandPool command_pool = VK_NULL_HANDLE;
     std::array<VkCommandBuffer, 2> command_buffers = {};
+    // Transfer queue command buffers, and the transfer semaphore value to wait for. Every
+    // command buffer which is submitted before this one is waited for, so the resources they use
+    // are cleaned up with this command buffer's.
+    VkCommandPool transfer_command_pool = VK_NULL_HANDLE;
+    std::vector<VkCommandBuffer> transfer_command_buffers;
+    u32 transfer_command_buffers_used = 0;
+    u64 transfer_wait_value = 0;
     VkFence fence = VK_NULL_HANDLE;
     VkSemaphore semaphore = VK_NULL_HANDLE;
     u64 fence_counter = 0;
@@ -153,8 +170,14 @@ private:
     VkSwapchainKHR present_swap_chain;
     u32 present_image_index;
     u32 command_buffer_index;
+    VkPresentTimeGOOGLE present_time;
   };
   VkSemaphore m_present_semaphore = VK_NULL_HANDLE;
+
+  // Timeline semaphore signaled by the transfer queue, with the value of the last submission.
+  VkSemaphore m_transfer_semaphore = VK_NULL_HANDLE;
+  u64 m_transfer_semaphore_value = 0;
+  VkCommandBuffer m_current_transfer_command_buffer = VK_NULL_HANDLE;
   std::deque<PendingCommandBufferSubmit> m_pending_submits;
   std::mutex m_pending_submit_lock;
   std::condition_variable m_submit_worker_condvar;
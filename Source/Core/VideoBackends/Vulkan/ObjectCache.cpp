@@ -7,11 +7,14 @@
 #include <array>
 #include <type_traits>
 
+#include <fmt/format.h>
+
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/FileUtil.h"
 #include "Common/LinearDiskCache.h"
 #include "Common/MsgHandler.h"
+#include "Common/Timer.h"
 
 #include "Core/ConfigManager.h"
 
@@ -27,10 +30,19 @@ namespace Vulkan
 {
 std::unique_ptr<ObjectCache> g_object_cache;
 
+// Key of the single entry in a pipeline cache file. Increment to discard all existing files.
+// Files from before they were split by driver used a key of 1.
+constexpr u32 PIPELINE_CACHE_FILE_VERSION = 2;
+constexpr u32 LEGACY_PIPELINE_CACHE_FILE_VERSION = 1;
+
+// How often the pipeline cache is written out while running, at most.
+constexpr u64 PIPELINE_CACHE_SAVE_INTERVAL_MS = 30 * 1000;
+
 ObjectCache::ObjectCache() = default;
 
 ObjectCache::~ObjectCache()
 {
+  DestroyPipelineLibraries();
   DestroyPipelineCache();
   DestroySamplers();
   DestroyPipelineLayouts();
@@ -69,6 +81,7 @@ bool ObjectCache::Initialize()
       return false;
   }
 
+  StartPipelineCacheSaveThread();
   return true;
 }
 
@@ -190,6 +203,16 @@ bool ObjectCache::CreateDescriptorSetLayouts()
   if (!g_ActiveConfig.backend_info.bSupportsDynamicVertexLoader)
     create_infos[DESCRIPTOR_SET_LAYOUT_STANDARD_SHADER_STORAGE_BUFFERS].bindingCount--;
 
+  // The sampler sets change the most between draws, so push them instead of allocating and
+  // writing a new set each time. A pipeline layout can only contain one push descriptor set.
+  if (g_vulkan_context->SupportsPushDescriptors())
+  {
+    create_infos[DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS].flags |=
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+    create_infos[DESCRIPTOR_SET_LAYOUT_UTILITY_SAMPLERS].flags |=
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+  }
+
   for (size_t i = 0; i < create_infos.size(); i++)
   {
     VkResult res = vkCreateDescriptorSetLayout(g_vulkan_context->GetDevice(), &create_infos[i],
@@ -472,12 +495,41 @@ void ObjectCache::DestroyRenderPassCache()
   m_render_pass_cache.clear();
 }
 
+VkPipeline ObjectCache::GetPipelineLibrary(const PipelineLibraryKey& key,
+                                           const std::function<VkPipeline()>& create)
+{
+  std::lock_guard<std::mutex> guard(m_pipeline_library_lock);
+  auto it = m_pipeline_library_cache.find(key);
+  if (it != m_pipeline_library_cache.end())
+    return it->second;
+
+  // Failures are cached too, so that we fall back to full pipelines without retrying.
+  VkPipeline library = create();
+  m_pipeline_library_cache.emplace(key, library);
+  return library;
+}
+
+void ObjectCache::DestroyPipelineLibraries()
+{
+  for (auto& it : m_pipeline_library_cache)
+  {
+    if (it.second != VK_NULL_HANDLE)
+      vkDestroyPipeline(g_vulkan_context->GetDevice(), it.second, nullptr);
+  }
+  m_pipeline_library_cache.clear();
+}
+
 class PipelineCacheReadCallback : public LinearDiskCacheReader<u32, u8>
 {
 public:
-  PipelineCacheReadCallback(std::vector<u8>* data) : m_data(data) {}
+  PipelineCacheReadCallback(std::vector<u8>* data, u32 version) : m_data(data), m_version(version)
+  {
+  }
   void Read(const u32& key, const u8* value, u32 value_size) override
   {
+    if (key != m_version)
+      return;
+
     m_data->resize(value_size);
     if (value_size > 0)
       memcpy(m_data->data(), value, value_size);
@@ -485,8 +537,33 @@ public:
 
 private:
   std::vector<u8>* m_data;
+  u32 m_version;
 };
 
+static std::vector<u8> ReadPipelineCacheFile(const std::string& filename, u32 version)
+{
+  std::vector<u8> data;
+  LinearDiskCache<u32, u8> disk_cache;
+  PipelineCacheReadCallback read_callback(&data, version);
+  if (disk_cache.OpenAndRead(filename, read_callback) != 1)
+    data.clear();
+
+  return data;
+}
+
+static std::string GetPipelineCacheFileName()
+{
+  // The pipeline cache UUID changes with the driver version, so every GPU and driver combination
+  // gets its own file. Switching between them no longer throws away the other's cache.
+  const VkPhysicalDeviceProperties& properties = g_vulkan_context->GetDeviceProperties();
+  std::string type =
+      fmt::format("Pipeline-{:04x}-{:04x}-", properties.vendorID, properties.deviceID);
+  for (const u8 uuid_byte : properties.pipelineCacheUUID)
+    type += fmt::format("{:02x}", uuid_byte);
+
+  return GetDiskShaderCacheFileName(APIType::Vulkan, type.c_str(), false, true);
+}
+
 class PipelineCacheReadIgnoreCallback : public LinearDiskCacheReader<u32, u8>
 {
 public:
@@ -498,7 +575,8 @@ bool ObjectCache::CreatePipelineCache()
   // Vulkan pipeline caches can be shared between games for shader compile time reduction.
   // This assumes that drivers don't create all pipelines in the cache on load time, only
   // when a lookup occurs that matches a pipeline (or pipeline data) in the cache.
-  m_pipeline_cache_filename = GetDiskShaderCacheFileName(APIType::Vulkan, "Pipeline", false, true);
+  m_pipeline_cache_filename = GetPipelineCacheFileName();
+  m_saved_pipeline_cache_size = 0;
 
   VkPipelineCacheCreateInfo info = {
       VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,  // VkStructureType            sType
@@ -521,14 +599,10 @@ bool ObjectCache::LoadPipelineCache()
 {
   // We have to keep the pipeline cache file name around since when we save it
   // we delete the old one, by which time the game's unique ID is already cleared.
-  m_pipeline_cache_filename = GetDiskShaderCacheFileName(APIType::Vulkan, "Pipeline", false, true);
-
-  std::vector<u8> disk_data;
-  LinearDiskCache<u32, u8> disk_cache;
-  PipelineCacheReadCallback read_callback(&disk_data);
-  if (disk_cache.OpenAndRead(m_pipeline_cache_filename, read_callback) != 1)
-    disk_data.clear();
+  m_pipeline_cache_filename = GetPipelineCacheFileName();
 
+  std::vector<u8> disk_data =
+      ReadPipelineCacheFile(m_pipeline_cache_filename, PIPELINE_CACHE_FILE_VERSION);
   if (!disk_data.empty() && !ValidatePipelineCache(disk_data.data(), disk_data.size()))
   {
     // Don't use this data. In fact, we should delete it to prevent it from being used next time.
@@ -536,6 +610,20 @@ bool ObjectCache::LoadPipelineCache()
     return CreatePipelineCache();
   }
 
+  // Carry over the cache from before it was split by driver, if it was made by this driver.
+  // It is saved under the new name from now on.
+  const std::string legacy_filename =
+      GetDiskShaderCacheFileName(APIType::Vulkan, "Pipeline", false, true);
+  if (disk_data.empty() && File::Exists(legacy_filename))
+  {
+    disk_data = ReadPipelineCacheFile(legacy_filename, LEGACY_PIPELINE_CACHE_FILE_VERSION);
+    if (!disk_data.empty() && !ValidatePipelineCache(disk_data.data(), disk_data.size()))
+      disk_data.clear();
+    else
+      File::Delete(legacy_filename);
+  }
+  m_saved_pipeline_cache_size = disk_data.size();
+
   VkPipelineCacheCreateInfo info = {
       VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,  // VkStructureType            sType
       nullptr,                                       // const void*                pNext
@@ -620,41 +708,83 @@ bool ObjectCache::ValidatePipelineCache(const u8* data, size_t data_length)
 
 void ObjectCache::DestroyPipelineCache()
 {
+  m_pipeline_cache_save_thread.Shutdown();
   vkDestroyPipelineCache(g_vulkan_context->GetDevice(), m_pipeline_cache, nullptr);
   m_pipeline_cache = VK_NULL_HANDLE;
 }
 
-void ObjectCache::SavePipelineCache()
+void ObjectCache::StartPipelineCacheSaveThread()
+{
+  m_last_pipeline_cache_save_time = Common::Timer::NowMs();
+  m_pipeline_cache_save_thread.Reset([this](PipelineCacheSaveRequest request) {
+    WritePipelineCache(request.cache, request.filename);
+  });
+}
+
+void ObjectCache::WritePipelineCache(VkPipelineCache cache, const std::string& filename)
 {
   size_t data_size;
-  VkResult res =
-      vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &data_size, nullptr);
+  VkResult res = vkGetPipelineCacheData(g_vulkan_context->GetDevice(), cache, &data_size, nullptr);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkGetPipelineCacheData failed: ");
     return;
   }
 
+  // Pipeline caches only grow, so an unchanged size means there is nothing new to write.
+  if (data_size == m_saved_pipeline_cache_size)
+    return;
+
   std::vector<u8> data(data_size);
-  res = vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &data_size,
-                               data.data());
+  res = vkGetPipelineCacheData(g_vulkan_context->GetDevice(), cache, &data_size, data.data());
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkGetPipelineCacheData failed: ");
     return;
   }
 
-  // Delete the old cache and re-create.
-  File::Delete(m_pipeline_cache_filename);
+  // Write to a temporary file and rename it over the old one, so that being killed in the middle
+  // of a save leaves the previous cache intact.
+  const std::string temp_filename = filename + ".tmp";
+  File::Delete(temp_filename);
 
-  // We write a single key of 1, with the entire pipeline cache data.
+  // We write a single key of the file version, with the entire pipeline cache data.
   // Not ideal, but our disk cache class does not support just writing a single blob
   // of data without specifying a key.
   LinearDiskCache<u32, u8> disk_cache;
   PipelineCacheReadIgnoreCallback callback;
-  disk_cache.OpenAndRead(m_pipeline_cache_filename, callback);
-  disk_cache.Append(1, data.data(), static_cast<u32>(data.size()));
+  disk_cache.OpenAndRead(temp_filename, callback);
+  disk_cache.Append(PIPELINE_CACHE_FILE_VERSION, data.data(), static_cast<u32>(data.size()));
   disk_cache.Close();
+
+  if (!File::RenameSync(temp_filename, filename))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write pipeline cache to {}", filename);
+    return;
+  }
+
+  m_saved_pipeline_cache_size = data_size;
+}
+
+void ObjectCache::SavePipelineCache()
+{
+  // Let a pending background save finish first, so the two don't write the same file.
+  m_pipeline_cache_save_thread.Shutdown();
+  WritePipelineCache(m_pipeline_cache, m_pipeline_cache_filename);
+}
+
+void ObjectCache::SavePipelineCacheIfStale()
+{
+  if (!g_ActiveConfig.bShaderCache || m_pipeline_cache == VK_NULL_HANDLE)
+    return;
+
+  const u64 now = Common::Timer::NowMs();
+  if (now - m_last_pipeline_cache_save_time < PIPELINE_CACHE_SAVE_INTERVAL_MS)
+    return;
+
+  m_last_pipeline_cache_save_time = now;
+  m_pipeline_cache_save_thread.EmplaceItem(
+      PipelineCacheSaveRequest{m_pipeline_cache, m_pipeline_cache_filename});
 }
 
 void ObjectCache::ReloadPipelineCache()
@@ -665,5 +795,7 @@ void ObjectCache::ReloadPipelineCache()
     LoadPipelineCache();
   else
     CreatePipelineCache();
+
+  StartPipelineCacheSaveThread();
 }
 }  // namespace Vulkan
@@ -5,14 +5,17 @@
 
 #include <array>
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
 
 #include "Common/CommonTypes.h"
 #include "Common/LinearDiskCache.h"
+#include "Common/WorkQueueThread.h"
 
 #include "VideoBackends/Vulkan/Constants.h"
 
@@ -28,6 +31,11 @@ class VertexFormat;
 class VKTexture;
 class StreamBuffer;
 
+// Identifies a graphics pipeline library part: the library flag, the state bits it was built from,
+// the sample state, the pipeline layout and render pass, and the vertex format if any.
+using PipelineLibraryKey =
+    std::tuple<u32, u32, u32, VkPipelineLayout, VkRenderPass, const VertexFormat*>;
+
 class ObjectCache
 {
 public:
@@ -62,6 +70,11 @@ public:
   VkRenderPass GetRenderPass(VkFormat color_format, VkFormat depth_format, u32 multisamples,
                              VkAttachmentLoadOp load_op);
 
+  // Cache of graphics pipeline library parts which don't depend on a shader module, i.e. the
+  // vertex input and fragment output interfaces. create is only called on a miss.
+  VkPipeline GetPipelineLibrary(const PipelineLibraryKey& key,
+                                const std::function<VkPipeline()>& create);
+
   // Pipeline cache. Used when creating pipelines for drivers to store compiled programs.
   VkPipelineCache GetPipelineCache() const { return m_pipeline_cache; }
 
@@ -72,6 +85,10 @@ public:
   // Saves the pipeline cache to disk. Call when shutting down.
   void SavePipelineCache();
 
+  // Saves the pipeline cache to disk in the background if enough time has passed since the last
+  // save. Call once per frame, so that the cache survives the process being killed.
+  void SavePipelineCacheIfStale();
+
   // Reload pipeline cache. Call when host config changes.
   void ReloadPipelineCache();
 
@@ -83,10 +100,13 @@ private:
   bool CreateStaticSamplers();
   void DestroySamplers();
   void DestroyRenderPassCache();
+  void DestroyPipelineLibraries();
   bool CreatePipelineCache();
   bool LoadPipelineCache();
   bool ValidatePipelineCache(const u8* data, size_t data_length);
   void DestroyPipelineCache();
+  void StartPipelineCacheSaveThread();
+  void WritePipelineCache(VkPipelineCache cache, const std::string& filename);
 
   std::array<VkDescriptorSetLayout, NUM_DESCRIPTOR_SET_LAYOUTS> m_descriptor_set_layouts = {};
   std::array<VkPipelineLayout, NUM_PIPELINE_LAYOUTS> m_pipeline_layouts = {};
@@ -105,9 +125,24 @@ private:
   using RenderPassCacheKey = std::tuple<VkFormat, VkFormat, u32, VkAttachmentLoadOp>;
   std::map<RenderPassCacheKey, VkRenderPass> m_render_pass_cache;
 
+  // Graphics pipeline library parts, created from the pipeline compiler threads
+  std::mutex m_pipeline_library_lock;
+  std::map<PipelineLibraryKey, VkPipeline> m_pipeline_library_cache;
+
   // pipeline cache
   VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;
   std::string m_pipeline_cache_filename;
+
+  // Background saving of the pipeline cache. The saved size is only touched by whichever thread
+  // is writing, as synchronous saves stop the save thread first.
+  struct PipelineCacheSaveRequest
+  {
+    VkPipelineCache cache;
+    std::string filename;
+  };
+  Common::WorkQueueThread<PipelineCacheSaveRequest> m_pipeline_cache_save_thread;
+  u64 m_last_pipeline_cache_save_time = 0;
+  size_t m_saved_pipeline_cache_size = 0;
 };
 
 extern std::unique_ptr<ObjectCache> g_object_cache;
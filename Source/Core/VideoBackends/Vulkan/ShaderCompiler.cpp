@@ -7,6 +7,7 @@
 #include <string>
 
 #include "VideoBackends/Vulkan/VulkanContext.h"
+#include "VideoCommon/AbstractShader.h"
 #include "VideoCommon/Spirv.h"
 
 namespace Vulkan::ShaderCompiler
@@ -88,7 +89,8 @@ static const char SUBGROUP_HELPER_HEADER[] = R"(
   #define SUBGROUP_MAX(value) value = subgroupMax(value)
 )";
 
-static std::string GetShaderCode(std::string_view source, std::string_view header)
+static std::string GetShaderCode(std::string_view source, std::string_view header,
+                                 bool supports_subgroup_operations)
 {
   std::string full_source_code;
   if (!header.empty())
@@ -96,7 +98,7 @@ static std::string GetShaderCode(std::string_view source, std::string_view heade
     constexpr size_t subgroup_helper_header_length = std::size(SUBGROUP_HELPER_HEADER) - 1;
     full_source_code.reserve(header.size() + subgroup_helper_header_length + source.size());
     full_source_code.append(header);
-    if (g_vulkan_context->SupportsShaderSubgroupOperations())
+    if (supports_subgroup_operations)
       full_source_code.append(SUBGROUP_HELPER_HEADER, subgroup_helper_header_length);
     full_source_code.append(source);
   }
@@ -104,15 +106,25 @@ static std::string GetShaderCode(std::string_view source, std::string_view heade
   return full_source_code;
 }
 
-static glslang::EShTargetLanguageVersion GetLanguageVersion()
+static std::string GetShaderCode(std::string_view source, std::string_view header)
+{
+  return GetShaderCode(source, header, g_vulkan_context->SupportsShaderSubgroupOperations());
+}
+
+static glslang::EShTargetLanguageVersion GetLanguageVersion(bool supports_subgroup_operations)
 {
   // Sub-group operations require Vulkan 1.1 and SPIR-V 1.3.
-  if (g_vulkan_context->SupportsShaderSubgroupOperations())
+  if (supports_subgroup_operations)
     return glslang::EShTargetSpv_1_3;
 
   return glslang::EShTargetSpv_1_0;
 }
 
+static glslang::EShTargetLanguageVersion GetLanguageVersion()
+{
+  return GetLanguageVersion(g_vulkan_context->SupportsShaderSubgroupOperations());
+}
+
 std::optional<SPIRVCodeVector> CompileVertexShader(std::string_view source_code)
 {
   return SPIRV::CompileVertexShader(GetShaderCode(source_code, SHADER_HEADER), APIType::Vulkan,
@@ -136,4 +148,24 @@ std::optional<SPIRVCodeVector> CompileComputeShader(std::string_view source_code
   return SPIRV::CompileComputeShader(GetShaderCode(source_code, COMPUTE_SHADER_HEADER),
                                      APIType::Vulkan, GetLanguageVersion());
 }
+
+std::optional<SPIRVCodeVector> PrecompileShader(ShaderStage stage, std::string_view source_code,
+                                                bool supports_subgroup_operations)
+{
+  const std::string full_source_code =
+      GetShaderCode(source_code, SHADER_HEADER, supports_subgroup_operations);
+  const glslang::EShTargetLanguageVersion language_version =
+      GetLanguageVersion(supports_subgroup_operations);
+  switch (stage)
+  {
+  case ShaderStage::Vertex:
+    return SPIRV::CompileVertexShader(full_source_code, APIType::Vulkan, language_version);
+  case ShaderStage::Geometry:
+    return SPIRV::CompileGeometryShader(full_source_code, APIType::Vulkan, language_version);
+  case ShaderStage::Pixel:
+    return SPIRV::CompileFragmentShader(full_source_code, APIType::Vulkan, language_version);
+  default:
+    return std::nullopt;
+  }
+}
 }  // namespace Vulkan::ShaderCompiler
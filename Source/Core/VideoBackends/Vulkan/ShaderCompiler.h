@@ -10,6 +10,8 @@
 
 #include "Common/CommonTypes.h"
 
+enum class ShaderStage;
+
 namespace Vulkan::ShaderCompiler
 {
 // SPIR-V compiled code type
@@ -27,4 +29,9 @@ std::optional<SPIRVCodeVector> CompileFragmentShader(std::string_view source_cod
 
 // Compile a compute shader to SPIR-V.
 std::optional<SPIRVCodeVector> CompileComputeShader(std::string_view source_code);
+
+// Compile a vertex, geometry or pixel shader to SPIR-V for a device with or without subgroup
+// operations, without a Vulkan context. Used to generate the prebuilt SPIR-V cache.
+std::optional<SPIRVCodeVector> PrecompileShader(ShaderStage stage, std::string_view source_code,
+                                                bool supports_subgroup_operations);
 }  // namespace Vulkan::ShaderCompiler
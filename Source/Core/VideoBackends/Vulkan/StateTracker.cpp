@@ -3,6 +3,9 @@
 
 #include "VideoBackends/Vulkan/StateTracker.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "Common/Assert.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
@@ -14,6 +17,8 @@
 #include "VideoBackends/Vulkan/VKVertexFormat.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
 
+#include "VideoCommon/Statistics.h"
+
 namespace Vulkan
 {
 static std::unique_ptr<StateTracker> s_state_tracker;
@@ -261,21 +266,16 @@ void StateTracker::InvalidateCachedState()
 void StateTracker::BeginRenderPass()
 {
   if (InRenderPass())
+  {
+    BeginPendingRenderPass();
     return;
+  }
 
   m_current_render_pass = m_framebuffer->GetLoadRenderPass();
   m_framebuffer_render_area = m_framebuffer->GetRect();
-
-  VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-                                      nullptr,
-                                      m_current_render_pass,
-                                      m_framebuffer->GetFB(),
-                                      m_framebuffer_render_area,
-                                      0,
-                                      nullptr};
-
-  vkCmdBeginRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer(), &begin_info,
-                       VK_SUBPASS_CONTENTS_INLINE);
+  m_num_render_pass_clear_values = 0;
+  m_render_pass_pending = true;
+  BeginPendingRenderPass();
 }
 
 void StateTracker::BeginDiscardRenderPass()
@@ -285,17 +285,27 @@ void StateTracker::BeginDiscardRenderPass()
 
   m_current_render_pass = m_framebuffer->GetDiscardRenderPass();
   m_framebuffer_render_area = m_framebuffer->GetRect();
+  m_num_render_pass_clear_values = 0;
+  m_render_pass_pending = true;
+}
+
+void StateTracker::BeginPendingRenderPass()
+{
+  if (!m_render_pass_pending)
+    return;
 
   VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
                                       nullptr,
                                       m_current_render_pass,
                                       m_framebuffer->GetFB(),
                                       m_framebuffer_render_area,
-                                      0,
-                                      nullptr};
+                                      m_num_render_pass_clear_values,
+                                      m_render_pass_clear_values.data()};
 
   vkCmdBeginRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer(), &begin_info,
                        VK_SUBPASS_CONTENTS_INLINE);
+  m_render_pass_pending = false;
+  INCSTAT(g_stats.this_frame.num_render_passes);
 }
 
 void StateTracker::EndRenderPass()
@@ -303,28 +313,61 @@ void StateTracker::EndRenderPass()
   if (!InRenderPass())
     return;
 
-  vkCmdEndRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer());
+  // A pending clear still has to be done, but a pending discard pass wouldn't change anything.
+  if (m_render_pass_pending && m_current_render_pass == m_framebuffer->GetClearRenderPass())
+    BeginPendingRenderPass();
+
+  if (!m_render_pass_pending)
+    vkCmdEndRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer());
+
+  m_current_render_pass = VK_NULL_HANDLE;
+  m_render_pass_pending = false;
+}
+
+void StateTracker::DiscardPendingRenderPass()
+{
+  if (!m_render_pass_pending)
+  {
+    EndRenderPass();
+    return;
+  }
+
   m_current_render_pass = VK_NULL_HANDLE;
+  m_render_pass_pending = false;
+}
+
+bool StateTracker::CanBeginClearRenderPass(const VkRect2D& area) const
+{
+  if (!InRenderPass())
+    return true;
+  if (!m_render_pass_pending)
+    return false;
+
+  // The contents of a discard pass are undefined anyway. A pending clear can be replaced if the
+  // new clear covers all of it.
+  if (m_current_render_pass == m_framebuffer->GetDiscardRenderPass())
+    return true;
+
+  const VkRect2D& pending_area = m_framebuffer_render_area;
+  return area.offset.x <= pending_area.offset.x && area.offset.y <= pending_area.offset.y &&
+         area.offset.x + static_cast<s32>(area.extent.width) >=
+             pending_area.offset.x + static_cast<s32>(pending_area.extent.width) &&
+         area.offset.y + static_cast<s32>(area.extent.height) >=
+             pending_area.offset.y + static_cast<s32>(pending_area.extent.height);
 }
 
 void StateTracker::BeginClearRenderPass(const VkRect2D& area, const VkClearValue* clear_values,
                                         u32 num_clear_values)
 {
-  ASSERT(!InRenderPass());
+  ASSERT(CanBeginClearRenderPass(area));
+  ASSERT(num_clear_values <= m_render_pass_clear_values.size());
 
+  // Nothing has been recorded for a pending pass, so the clear simply replaces it.
   m_current_render_pass = m_framebuffer->GetClearRenderPass();
   m_framebuffer_render_area = area;
-
-  VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-                                      nullptr,
-                                      m_current_render_pass,
-                                      m_framebuffer->GetFB(),
-                                      m_framebuffer_render_area,
-                                      num_clear_values,
-                                      clear_values};
-
-  vkCmdBeginRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer(), &begin_info,
-                       VK_SUBPASS_CONTENTS_INLINE);
+  std::copy_n(clear_values, num_clear_values, m_render_pass_clear_values.begin());
+  m_num_render_pass_clear_values = num_clear_values;
+  m_render_pass_pending = true;
 }
 
 void StateTracker::SetViewport(const VkViewport& viewport)
@@ -351,6 +394,11 @@ bool StateTracker::Bind()
   if (!m_pipeline)
     return false;
 
+  // Time spent binding state is shown per draw in the statistics overlay.
+  const bool measure_time = g_ActiveConfig.bOverlayStats;
+  const auto start_time =
+      measure_time ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
   // Check the render area if we were in a clear pass.
   if (m_current_render_pass == m_framebuffer->GetClearRenderPass() && !IsViewportWithinRenderArea())
     EndRenderPass();
@@ -358,9 +406,8 @@ bool StateTracker::Bind()
   // Get a new descriptor set if any parts have changed
   UpdateDescriptorSet();
 
-  // Start render pass if not already started
-  if (!InRenderPass())
-    BeginRenderPass();
+  // Start render pass if not already started, or record the pending one
+  BeginRenderPass();
 
   // Re-bind parts of the pipeline
   const VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
@@ -376,8 +423,19 @@ bool StateTracker::Bind()
     vkCmdBindIndexBuffer(command_buffer, m_index_buffer, m_index_buffer_offset, m_index_type);
 
   if (m_dirty_flags & DIRTY_FLAG_PIPELINE)
+  {
     vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipeline());
 
+    // Binding a pipeline leaves its dynamic state undefined, so set it every time.
+    if (const auto& dynamic_state = m_pipeline->GetDynamicState())
+    {
+      vkCmdSetCullModeEXT(command_buffer, dynamic_state->cull_mode);
+      vkCmdSetDepthTestEnableEXT(command_buffer, dynamic_state->depth_test_enable);
+      vkCmdSetDepthWriteEnableEXT(command_buffer, dynamic_state->depth_write_enable);
+      vkCmdSetDepthCompareOpEXT(command_buffer, dynamic_state->depth_compare_op);
+    }
+  }
+
   if (m_dirty_flags & DIRTY_FLAG_VIEWPORT)
     vkCmdSetViewport(command_buffer, 0, 1, &m_viewport);
 
@@ -386,6 +444,15 @@ bool StateTracker::Bind()
 
   m_dirty_flags &=
       ~(DIRTY_FLAG_INDEX_BUFFER | DIRTY_FLAG_PIPELINE | DIRTY_FLAG_VIEWPORT | DIRTY_FLAG_SCISSOR);
+
+  if (measure_time)
+  {
+    ADDSTAT(g_stats.this_frame.draw_state_bind_ns,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                 start_time)
+                .count());
+  }
+
   return true;
 }
 
@@ -461,6 +528,13 @@ void StateTracker::UpdateGXDescriptorSet()
   const bool needs_gs_ubo = g_ActiveConfig.backend_info.bSupportsGeometryShaders ||
                             g_ActiveConfig.UseVSForLinePointExpand();
 
+  // With push descriptors, the samplers are pushed directly into the command buffer. They need to
+  // be pushed again when the layout changed, as that disturbs the previously pushed set.
+  const bool use_push_descriptors = g_vulkan_context->SupportsPushDescriptors();
+  const bool push_samplers =
+      use_push_descriptors &&
+      (m_dirty_flags & (DIRTY_FLAG_GX_SAMPLERS | DIRTY_FLAG_DESCRIPTOR_SETS)) != 0;
+
   if (m_dirty_flags & DIRTY_FLAG_GX_UBOS || m_gx_descriptor_sets[0] == VK_NULL_HANDLE)
   {
     m_gx_descriptor_sets[0] = g_command_buffer_mgr->AllocateDescriptorSet(
@@ -488,7 +562,8 @@ void StateTracker::UpdateGXDescriptorSet()
     m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_GX_UBOS) | DIRTY_FLAG_DESCRIPTOR_SETS;
   }
 
-  if (m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS || m_gx_descriptor_sets[1] == VK_NULL_HANDLE)
+  if (!use_push_descriptors &&
+      (m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS || m_gx_descriptor_sets[1] == VK_NULL_HANDLE))
   {
     m_gx_descriptor_sets[1] = g_command_buffer_mgr->AllocateDescriptorSet(
         g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS));
@@ -544,7 +619,23 @@ void StateTracker::UpdateGXDescriptorSet()
   if (num_writes > 0)
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), num_writes, writes.data(), 0, nullptr);
 
-  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
+  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS && use_push_descriptors)
+  {
+    // The sampler set in the middle is pushed, so bind the sets around it separately.
+    vkCmdBindDescriptorSets(
+        g_command_buffer_mgr->GetCurrentCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS,
+        m_pipeline->GetVkPipelineLayout(), 0, 1, m_gx_descriptor_sets.data(),
+        needs_gs_ubo ? NUM_UBO_DESCRIPTOR_SET_BINDINGS : (NUM_UBO_DESCRIPTOR_SET_BINDINGS - 1),
+        m_bindings.gx_ubo_offsets.data());
+    if (needs_ssbo)
+    {
+      vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                              VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(),
+                              2, 1, &m_gx_descriptor_sets[2], 0, nullptr);
+    }
+    m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_GX_UBO_OFFSETS);
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
   {
     vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                             VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
@@ -564,6 +655,24 @@ void StateTracker::UpdateGXDescriptorSet()
         m_bindings.gx_ubo_offsets.data());
     m_dirty_flags &= ~DIRTY_FLAG_GX_UBO_OFFSETS;
   }
+
+  if (push_samplers)
+  {
+    const VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                        nullptr,
+                                        VK_NULL_HANDLE,
+                                        0,
+                                        0,
+                                        static_cast<u32>(NUM_PIXEL_SHADER_SAMPLERS),
+                                        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                        m_bindings.samplers.data(),
+                                        nullptr,
+                                        nullptr};
+    vkCmdPushDescriptorSetKHR(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                              VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 1,
+                              1, &write);
+    m_dirty_flags &= ~DIRTY_FLAG_GX_SAMPLERS;
+  }
 }
 
 void StateTracker::UpdateUtilityDescriptorSet()
@@ -572,6 +681,12 @@ void StateTracker::UpdateUtilityDescriptorSet()
   std::array<VkWriteDescriptorSet, 3> dswrites;
   u32 writes = 0;
 
+  // See UpdateGXDescriptorSet.
+  const bool use_push_descriptors = g_vulkan_context->SupportsPushDescriptors();
+  const bool push_bindings =
+      use_push_descriptors &&
+      (m_dirty_flags & (DIRTY_FLAG_UTILITY_BINDINGS | DIRTY_FLAG_DESCRIPTOR_SETS)) != 0;
+
   // Allocate descriptor sets.
   if (m_dirty_flags & DIRTY_FLAG_UTILITY_UBO || m_utility_descriptor_sets[0] == VK_NULL_HANDLE)
   {
@@ -592,7 +707,8 @@ void StateTracker::UpdateUtilityDescriptorSet()
     m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_UTILITY_UBO) | DIRTY_FLAG_DESCRIPTOR_SETS;
   }
 
-  if (m_dirty_flags & DIRTY_FLAG_UTILITY_BINDINGS || m_utility_descriptor_sets[1] == VK_NULL_HANDLE)
+  if (!use_push_descriptors && (m_dirty_flags & DIRTY_FLAG_UTILITY_BINDINGS ||
+                                m_utility_descriptor_sets[1] == VK_NULL_HANDLE))
   {
     m_utility_descriptor_sets[1] = g_command_buffer_mgr->AllocateDescriptorSet(
         g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_UTILITY_SAMPLERS));
@@ -626,10 +742,11 @@ void StateTracker::UpdateUtilityDescriptorSet()
 
   if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
   {
-    vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                            VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
-                            NUM_UTILITY_DESCRIPTOR_SETS, m_utility_descriptor_sets.data(), 1,
-                            &m_bindings.utility_ubo_offset);
+    vkCmdBindDescriptorSets(
+        g_command_buffer_mgr->GetCurrentCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS,
+        m_pipeline->GetVkPipelineLayout(), 0,
+        use_push_descriptors ? 1 : NUM_UTILITY_DESCRIPTOR_SETS, m_utility_descriptor_sets.data(),
+        1, &m_bindings.utility_ubo_offset);
     m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_UTILITY_UBO_OFFSET);
   }
   else if (m_dirty_flags & DIRTY_FLAG_UTILITY_UBO_OFFSET)
@@ -639,6 +756,22 @@ void StateTracker::UpdateUtilityDescriptorSet()
                             1, m_utility_descriptor_sets.data(), 1, &m_bindings.utility_ubo_offset);
     m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_UTILITY_UBO_OFFSET);
   }
+
+  if (push_bindings)
+  {
+    const std::array<VkWriteDescriptorSet, 2> push_writes = {{
+        {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, VK_NULL_HANDLE, 0, 0,
+         NUM_PIXEL_SHADER_SAMPLERS, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+         m_bindings.samplers.data(), nullptr, nullptr},
+        {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, VK_NULL_HANDLE, 8, 0, 1,
+         VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, nullptr, nullptr,
+         m_bindings.texel_buffers.data()},
+    }};
+    vkCmdPushDescriptorSetKHR(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                              VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 1,
+                              static_cast<u32>(push_writes.size()), push_writes.data());
+    m_dirty_flags &= ~DIRTY_FLAG_UTILITY_BINDINGS;
+  }
 }
 
 void StateTracker::UpdateComputeDescriptorSet()
@@ -53,11 +53,22 @@ public:
   // Ends a render pass if we're currently in one.
   // When Bind() is next called, the pass will be restarted.
   // Calling this function is allowed even if a pass has not begun.
+  // Discard and clear passes are only recorded once something is drawn in them, so a discard pass
+  // which is ended without any draws is dropped, and a pending clear pass can be replaced by
+  // another clear. This avoids needless tile loads and stores on tiled GPUs.
   bool InRenderPass() const { return m_current_render_pass != VK_NULL_HANDLE; }
   void BeginRenderPass();
   void BeginDiscardRenderPass();
   void EndRenderPass();
 
+  // Like EndRenderPass(), but drops a pending clear, for when the attachments are about to be
+  // overwritten completely outside of a render pass.
+  void DiscardPendingRenderPass();
+
+  // Returns true if a clear of the specified area can be done with BeginClearRenderPass(), i.e.
+  // there is no render pass, or the current one has not recorded anything the clear would keep.
+  bool CanBeginClearRenderPass(const VkRect2D& area) const;
+
   // Ends the current render pass if it was a clear render pass.
   void BeginClearRenderPass(const VkRect2D& area, const VkClearValue* clear_values,
                             u32 num_clear_values);
@@ -116,6 +127,10 @@ private:
   // If not, ends the render pass if it is a clear render pass.
   bool IsViewportWithinRenderArea() const;
 
+  // Records the begin of a render pass which was deferred by BeginDiscardRenderPass() or
+  // BeginClearRenderPass().
+  void BeginPendingRenderPass();
+
   void UpdateDescriptorSet();
   void UpdateGXDescriptorSet();
   void UpdateUtilityDescriptorSet();
@@ -162,5 +177,8 @@ private:
   VKFramebuffer* m_framebuffer = nullptr;
   VkRenderPass m_current_render_pass = VK_NULL_HANDLE;
   VkRect2D m_framebuffer_render_area = {};
+  std::array<VkClearValue, 2> m_render_pass_clear_values = {};
+  u32 m_num_render_pass_clear_values = 0;
+  bool m_render_pass_pending = false;
 };
 }  // namespace Vulkan
@@ -0,0 +1,100 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Vulkan/VKGPUTiming.h"
+
+#include <vector>
+
+#include "Common/Logging/Log.h"
+
+#include "VideoBackends/Vulkan/CommandBufferManager.h"
+#include "VideoBackends/Vulkan/VulkanContext.h"
+
+namespace Vulkan
+{
+VKGPUTiming::VKGPUTiming(VkQueryPool query_pool, double ns_per_tick, u64 valid_mask)
+    : m_query_pool(query_pool), m_ns_per_tick(ns_per_tick), m_valid_mask(valid_mask)
+{
+}
+
+VKGPUTiming::~VKGPUTiming()
+{
+  vkDestroyQueryPool(g_vulkan_context->GetDevice(), m_query_pool, nullptr);
+}
+
+std::unique_ptr<VKGPUTiming> VKGPUTiming::Create()
+{
+  const VkPhysicalDeviceLimits& limits = g_vulkan_context->GetDeviceLimits();
+  if (!limits.timestampComputeAndGraphics || limits.timestampPeriod <= 0.0f)
+    return nullptr;
+
+  u32 queue_family_count = 0;
+  vkGetPhysicalDeviceQueueFamilyProperties(g_vulkan_context->GetPhysicalDevice(),
+                                           &queue_family_count, nullptr);
+  std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
+  vkGetPhysicalDeviceQueueFamilyProperties(g_vulkan_context->GetPhysicalDevice(),
+                                           &queue_family_count, queue_families.data());
+  const u32 valid_bits =
+      queue_families[g_vulkan_context->GetGraphicsQueueFamilyIndex()].timestampValidBits;
+  if (valid_bits == 0)
+    return nullptr;
+
+  const VkQueryPoolCreateInfo info = {
+      VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO, nullptr, 0, VK_QUERY_TYPE_TIMESTAMP,
+      NUM_TIMESTAMPS, 0};
+  VkQueryPool query_pool;
+  const VkResult res = vkCreateQueryPool(g_vulkan_context->GetDevice(), &info, nullptr, &query_pool);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateQueryPool failed: ");
+    return nullptr;
+  }
+
+  const u64 valid_mask = valid_bits >= 64 ? ~u64(0) : ((u64(1) << valid_bits) - 1);
+  return std::unique_ptr<VKGPUTiming>(
+      new VKGPUTiming(query_pool, limits.timestampPeriod, valid_mask));
+}
+
+std::optional<u32> VKGPUTiming::WriteTimestamp()
+{
+  if (m_num_used == NUM_TIMESTAMPS)
+    return std::nullopt;
+
+  const u32 id = m_write_pos;
+  m_write_pos = (m_write_pos + 1) % NUM_TIMESTAMPS;
+  m_num_used++;
+
+  // The init command buffer runs before the current one, and unlike it is never inside a render
+  // pass, so the query can be reset there.
+  vkCmdResetQueryPool(g_command_buffer_mgr->GetCurrentInitCommandBuffer(), m_query_pool, id, 1);
+  vkCmdWriteTimestamp(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_query_pool, id);
+  m_fence_counters[id] = g_command_buffer_mgr->GetCurrentFenceCounter();
+  return id;
+}
+
+std::optional<u64> VKGPUTiming::ReadTimestamp(u32 id)
+{
+  if (m_fence_counters[id] > g_command_buffer_mgr->GetCompletedFenceCounter())
+    return std::nullopt;
+
+  u64 ticks;
+  const VkResult res =
+      vkGetQueryPoolResults(g_vulkan_context->GetDevice(), m_query_pool, id, 1, sizeof(ticks),
+                            &ticks, sizeof(ticks), VK_QUERY_RESULT_64_BIT);
+  if (res == VK_NOT_READY)
+    return std::nullopt;
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkGetQueryPoolResults failed: ");
+    return 0;
+  }
+
+  return static_cast<u64>((ticks & m_valid_mask) * m_ns_per_tick);
+}
+
+void VKGPUTiming::ReleaseTimestamp(u32 id)
+{
+  m_num_used--;
+}
+}  // namespace Vulkan
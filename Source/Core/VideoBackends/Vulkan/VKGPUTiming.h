@@ -0,0 +1,44 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Vulkan/VulkanLoader.h"
+
+#include "VideoCommon/GPUTiming.h"
+
+namespace Vulkan
+{
+class VKGPUTiming final : public VideoCommon::GPUTiming
+{
+public:
+  ~VKGPUTiming() override;
+
+  // Returns null if the graphics queue can't write timestamps.
+  static std::unique_ptr<VKGPUTiming> Create();
+
+protected:
+  std::optional<u32> WriteTimestamp() override;
+  std::optional<u64> ReadTimestamp(u32 id) override;
+  void ReleaseTimestamp(u32 id) override;
+
+private:
+  static constexpr u32 NUM_TIMESTAMPS = 1024;
+
+  VKGPUTiming(VkQueryPool query_pool, double ns_per_tick, u64 valid_mask);
+
+  VkQueryPool m_query_pool;
+  double m_ns_per_tick;
+  u64 m_valid_mask;
+
+  // Fence counter of the command buffer each timestamp was written to.
+  std::array<u64, NUM_TIMESTAMPS> m_fence_counters{};
+  u32 m_write_pos = 0;
+  u32 m_num_used = 0;
+};
+}  // namespace Vulkan
@@ -123,6 +123,12 @@ void PerfQuery::FlushResults()
     PartialFlush(true);
 }
 
+void PerfQuery::PollResults()
+{
+  if (!IsFlushed())
+    PartialFlush(false);
+}
+
 bool PerfQuery::IsFlushed() const
 {
   return m_query_count.load(std::memory_order_relaxed) == 0;
@@ -3,6 +3,7 @@
 
 #include "VideoBackends/Vulkan/VKPipeline.h"
 
+#include <algorithm>
 #include <array>
 
 #include "Common/Assert.h"
@@ -19,8 +20,10 @@
 namespace Vulkan
 {
 VKPipeline::VKPipeline(VkPipeline pipeline, VkPipelineLayout pipeline_layout,
-                       AbstractPipelineUsage usage)
-    : m_pipeline(pipeline), m_pipeline_layout(pipeline_layout), m_usage(usage)
+                       AbstractPipelineUsage usage,
+                       const std::optional<DynamicState>& dynamic_state)
+    : m_pipeline(pipeline), m_pipeline_layout(pipeline_layout), m_usage(usage),
+      m_dynamic_state(dynamic_state)
 {
 }
 
@@ -234,6 +237,144 @@ GetVulkanColorBlendState(const BlendingState& state,
   return vk_state;
 }
 
+static VkPipeline CreatePipelineLibrary(const VkGraphicsPipelineCreateInfo& pipeline_info,
+                                        VkGraphicsPipelineLibraryFlagsEXT part)
+{
+  VkGraphicsPipelineLibraryCreateInfoEXT library_info = {};
+  library_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+  library_info.flags = part;
+
+  VkGraphicsPipelineCreateInfo library_pipeline_info = {};
+  library_pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  library_pipeline_info.pNext = &library_info;
+  library_pipeline_info.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+  library_pipeline_info.basePipelineIndex = -1;
+
+  // Each part only takes the state that belongs to it.
+  VkShaderStageFlags stage_mask = 0;
+  switch (part)
+  {
+  case VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT:
+    library_pipeline_info.pVertexInputState = pipeline_info.pVertexInputState;
+    library_pipeline_info.pInputAssemblyState = pipeline_info.pInputAssemblyState;
+    break;
+  case VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT:
+    stage_mask = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_GEOMETRY_BIT;
+    library_pipeline_info.pViewportState = pipeline_info.pViewportState;
+    library_pipeline_info.pRasterizationState = pipeline_info.pRasterizationState;
+    library_pipeline_info.pDynamicState = pipeline_info.pDynamicState;
+    library_pipeline_info.layout = pipeline_info.layout;
+    library_pipeline_info.renderPass = pipeline_info.renderPass;
+    break;
+  case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT:
+    stage_mask = VK_SHADER_STAGE_FRAGMENT_BIT;
+    library_pipeline_info.pMultisampleState = pipeline_info.pMultisampleState;
+    library_pipeline_info.pDepthStencilState = pipeline_info.pDepthStencilState;
+    library_pipeline_info.pDynamicState = pipeline_info.pDynamicState;
+    library_pipeline_info.layout = pipeline_info.layout;
+    library_pipeline_info.renderPass = pipeline_info.renderPass;
+    break;
+  case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT:
+    library_pipeline_info.pMultisampleState = pipeline_info.pMultisampleState;
+    library_pipeline_info.pColorBlendState = pipeline_info.pColorBlendState;
+    library_pipeline_info.renderPass = pipeline_info.renderPass;
+    break;
+  default:
+    PanicAlertFmt("Unknown pipeline library part.");
+    return VK_NULL_HANDLE;
+  }
+
+  std::array<VkPipelineShaderStageCreateInfo, 3> shader_stages;
+  uint32_t num_shader_stages = 0;
+  for (uint32_t i = 0; i < pipeline_info.stageCount; i++)
+  {
+    if (pipeline_info.pStages[i].stage & stage_mask)
+      shader_stages[num_shader_stages++] = pipeline_info.pStages[i];
+  }
+  library_pipeline_info.stageCount = num_shader_stages;
+  library_pipeline_info.pStages = shader_stages.data();
+
+  VkPipeline library;
+  VkResult res =
+      vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
+                                1, &library_pipeline_info, nullptr, &library);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines (library) failed: ");
+    return VK_NULL_HANDLE;
+  }
+
+  return library;
+}
+
+// Links a pipeline from the four graphics pipeline library parts. Parts are shared between all
+// pipelines with the same shader and state, so only the parts which haven't been seen before are
+// compiled, and linking itself is fast. Returns VK_NULL_HANDLE if any part can't be created.
+static VkPipeline LinkPipelineFromLibraries(const AbstractPipelineConfig& config,
+                                            const VkGraphicsPipelineCreateInfo& pipeline_info)
+{
+  const auto create = [&pipeline_info](VkGraphicsPipelineLibraryFlagsEXT part) {
+    return [&pipeline_info, part]() { return CreatePipelineLibrary(pipeline_info, part); };
+  };
+  const auto* vertex_shader = static_cast<const VKShader*>(config.vertex_shader);
+  const auto* pixel_shader = static_cast<const VKShader*>(config.pixel_shader);
+  const auto* vertex_format = static_cast<const VertexFormat*>(config.vertex_format);
+
+  // State which is dynamic doesn't need to be part of the key, so more pipelines share a part.
+  const bool dynamic_raster_depth_state = g_vulkan_context->SupportsExtendedDynamicState();
+  const u32 rasterization_key =
+      dynamic_raster_depth_state ? static_cast<u32>(config.rasterization_state.primitive.Value()) :
+                                   config.rasterization_state.hex;
+  const u32 depth_key = dynamic_raster_depth_state ? 0 : config.depth_state.hex;
+
+  const std::array<VkPipeline, 4> libraries = {
+      g_object_cache->GetPipelineLibrary(
+          {VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+           static_cast<u32>(config.rasterization_state.primitive.Value()), 0, VK_NULL_HANDLE,
+           VK_NULL_HANDLE, vertex_format},
+          create(VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT)),
+      vertex_shader->GetPipelineLibrary(
+          {VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT, rasterization_key, 0,
+           pipeline_info.layout, pipeline_info.renderPass, nullptr},
+          create(VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT)),
+      pixel_shader->GetPipelineLibrary(
+          {VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, depth_key,
+           config.framebuffer_state.hex, pipeline_info.layout, pipeline_info.renderPass, nullptr},
+          create(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT)),
+      g_object_cache->GetPipelineLibrary(
+          {VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+           config.blending_state.hex, config.framebuffer_state.hex, VK_NULL_HANDLE,
+           pipeline_info.renderPass, nullptr},
+          create(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT)),
+  };
+  if (std::find(libraries.begin(), libraries.end(), VK_NULL_HANDLE) != libraries.end())
+    return VK_NULL_HANDLE;
+
+  VkPipelineLibraryCreateInfoKHR linking_info = {};
+  linking_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+  linking_info.libraryCount = static_cast<uint32_t>(libraries.size());
+  linking_info.pLibraries = libraries.data();
+
+  // No link-time optimization, the point is to link without a full compile.
+  VkGraphicsPipelineCreateInfo linked_pipeline_info = {};
+  linked_pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  linked_pipeline_info.pNext = &linking_info;
+  linked_pipeline_info.layout = pipeline_info.layout;
+  linked_pipeline_info.basePipelineIndex = -1;
+
+  VkPipeline pipeline;
+  VkResult res =
+      vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
+                                1, &linked_pipeline_info, nullptr, &pipeline);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines (link) failed: ");
+    return VK_NULL_HANDLE;
+  }
+
+  return pipeline;
+}
+
 std::unique_ptr<VKPipeline> VKPipeline::Create(const AbstractPipelineConfig& config)
 {
   DEBUG_ASSERT(config.vertex_shader && config.pixel_shader);
@@ -359,16 +500,30 @@ std::unique_ptr<VKPipeline> VKPipeline::Create(const AbstractPipelineConfig& con
   };
 
   // Set viewport and scissor dynamic state so we can change it elsewhere.
-  static const std::array<VkDynamicState, 2> dynamic_states{
+  // With extended dynamic state, cull mode and depth state are set when the pipeline is bound, so
+  // pipelines which only differ in those can share library parts.
+  static const std::array<VkDynamicState, 6> dynamic_states{
       VK_DYNAMIC_STATE_VIEWPORT,
       VK_DYNAMIC_STATE_SCISSOR,
+      VK_DYNAMIC_STATE_CULL_MODE_EXT,
+      VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT,
+      VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT,
+      VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT,
   };
-  static const VkPipelineDynamicStateCreateInfo dynamic_state = {
+  const bool dynamic_raster_depth_state = g_vulkan_context->SupportsExtendedDynamicState();
+  const VkPipelineDynamicStateCreateInfo dynamic_state = {
       VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO, nullptr,
-      0,                                        // VkPipelineDynamicStateCreateFlags    flags
-      static_cast<u32>(dynamic_states.size()),  // uint32_t dynamicStateCount
+      0,                                   // VkPipelineDynamicStateCreateFlags    flags
+      dynamic_raster_depth_state ? 6u : 2u,  // uint32_t dynamicStateCount
       dynamic_states.data()  // const VkDynamicState*                pDynamicStates
   };
+  std::optional<DynamicState> pipeline_dynamic_state;
+  if (dynamic_raster_depth_state)
+  {
+    pipeline_dynamic_state = DynamicState{
+        rasterization_state.cullMode, depth_stencil_state.depthTestEnable,
+        depth_stencil_state.depthWriteEnable, depth_stencil_state.depthCompareOp};
+  }
 
   // Combine to full pipeline info structure.
   VkGraphicsPipelineCreateInfo pipeline_info = {
@@ -393,6 +548,16 @@ std::unique_ptr<VKPipeline> VKPipeline::Create(const AbstractPipelineConfig& con
       -1                     // int32_t                                          basePipelineIndex
   };
 
+  // Pipelines with a geometry shader are rare, and the geometry shaders aren't owned in a way that
+  // would let them cache library parts, so those always take the monolithic path.
+  if (g_vulkan_context->SupportsGraphicsPipelineLibrary() && !config.geometry_shader)
+  {
+    VkPipeline pipeline = LinkPipelineFromLibraries(config, pipeline_info);
+    if (pipeline != VK_NULL_HANDLE)
+      return std::make_unique<VKPipeline>(pipeline, pipeline_layout, config.usage,
+                                          pipeline_dynamic_state);
+  }
+
   VkPipeline pipeline;
   VkResult res =
       vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
@@ -403,6 +568,7 @@ std::unique_ptr<VKPipeline> VKPipeline::Create(const AbstractPipelineConfig& con
     return VK_NULL_HANDLE;
   }
 
-  return std::make_unique<VKPipeline>(pipeline, pipeline_layout, config.usage);
+  return std::make_unique<VKPipeline>(pipeline, pipeline_layout, config.usage,
+                                      pipeline_dynamic_state);
 }
 }  // namespace Vulkan
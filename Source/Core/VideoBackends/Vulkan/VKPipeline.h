@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "VideoBackends/Vulkan/VulkanLoader.h"
 #include "VideoCommon/AbstractPipeline.h"
@@ -13,19 +14,32 @@ namespace Vulkan
 class VKPipeline final : public AbstractPipeline
 {
 public:
+  // State which is set with VK_EXT_extended_dynamic_state when the pipeline is bound, rather than
+  // being part of the pipeline.
+  struct DynamicState
+  {
+    VkCullModeFlags cull_mode;
+    VkBool32 depth_test_enable;
+    VkBool32 depth_write_enable;
+    VkCompareOp depth_compare_op;
+  };
+
   explicit VKPipeline(VkPipeline pipeline, VkPipelineLayout pipeline_layout,
-                      AbstractPipelineUsage usage);
+                      AbstractPipelineUsage usage,
+                      const std::optional<DynamicState>& dynamic_state = std::nullopt);
   ~VKPipeline() override;
 
   VkPipeline GetVkPipeline() const { return m_pipeline; }
   VkPipelineLayout GetVkPipelineLayout() const { return m_pipeline_layout; }
   AbstractPipelineUsage GetUsage() const { return m_usage; }
+  const std::optional<DynamicState>& GetDynamicState() const { return m_dynamic_state; }
   static std::unique_ptr<VKPipeline> Create(const AbstractPipelineConfig& config);
 
 private:
   VkPipeline m_pipeline;
   VkPipelineLayout m_pipeline_layout;
   AbstractPipelineUsage m_usage;
+  std::optional<DynamicState> m_dynamic_state;
 };
 
 }  // namespace Vulkan
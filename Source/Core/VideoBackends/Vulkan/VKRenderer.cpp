@@ -22,6 +22,7 @@
 #include "VideoBackends/Vulkan/StagingBuffer.h"
 #include "VideoBackends/Vulkan/StateTracker.h"
 #include "VideoBackends/Vulkan/VKBoundingBox.h"
+#include "VideoBackends/Vulkan/VKGPUTiming.h"
 #include "VideoBackends/Vulkan/VKPerfQuery.h"
 #include "VideoBackends/Vulkan/VKPipeline.h"
 #include "VideoBackends/Vulkan/VKShader.h"
@@ -132,6 +133,11 @@ std::unique_ptr<BoundingBox> Renderer::CreateBoundingBox() const
   return std::make_unique<VKBoundingBox>();
 }
 
+std::unique_ptr<VideoCommon::GPUTiming> Renderer::CreateGPUTiming() const
+{
+  return VKGPUTiming::Create();
+}
+
 void Renderer::ClearScreen(const MathUtil::Rectangle<int>& rc, bool color_enable, bool alpha_enable,
                            bool z_enable, u32 color, u32 z)
 {
@@ -172,11 +178,12 @@ void Renderer::ClearScreen(const MathUtil::Rectangle<int>& rc, bool color_enable
   if (!g_ActiveConfig.backend_info.bSupportsReversedDepthRange)
     clear_depth_value.depthStencil.depth = 1.0f - clear_depth_value.depthStencil.depth;
 
-  // If we're not in a render pass (start of the frame), we can use a clear render pass
-  // to discard the data, rather than loading and then clearing.
+  // If we're not in a render pass (start of the frame), or nothing has been drawn in the current
+  // one yet, we can use a clear render pass to discard the data, rather than loading and then
+  // clearing.
   bool use_clear_attachments = (color_enable && alpha_enable) || z_enable;
-  bool use_clear_render_pass =
-      !StateTracker::GetInstance()->InRenderPass() && color_enable && alpha_enable && z_enable;
+  bool use_clear_render_pass = StateTracker::GetInstance()->CanBeginClearRenderPass(target_vk_rc) &&
+                               color_enable && alpha_enable && z_enable;
 
   // The NVIDIA Vulkan driver causes the GPU to lock up, or throw exceptions if MSAA is enabled,
   // a non-full clear rect is specified, and a clear loadop or vkCmdClearAttachments is used.
@@ -324,6 +331,18 @@ void Renderer::BindBackbuffer(const ClearColor& clear_color)
                     VkResultToString(res));
   }
 
+  // No present is in flight at this point, so the swap chain's past timings can be queried. When
+  // fast forwarding, frames should go out as soon as possible instead.
+  if (g_ActiveConfig.bDisplayPacing && m_swap_chain->SupportsFramePacing() &&
+      !Core::GetIsThrottlerTempDisabled())
+  {
+    m_next_present_time = m_swap_chain->GetNextPresentTime();
+  }
+  else
+  {
+    m_next_present_time = {};
+  }
+
   // Transition from undefined (or present src, but it can be substituted) to
   // color attachment ready for writing. These transitions must occur outside
   // a render pass, unless the render pass declares a self-dependency.
@@ -349,10 +368,70 @@ void Renderer::PresentBackbuffer()
   // the available semaphore to be signaled before executing the buffer. This final submission
   // can happen off-thread in the background while we're preparing the next frame.
   g_command_buffer_mgr->SubmitCommandBuffer(true, false, m_swap_chain->GetSwapChain(),
-                                            m_swap_chain->GetCurrentImageIndex());
+                                            m_swap_chain->GetCurrentImageIndex(),
+                                            m_next_present_time);
 
   // New cmdbuffer, so invalidate state.
   StateTracker::GetInstance()->InvalidateCachedState();
+
+  g_object_cache->SavePipelineCacheIfStale();
+}
+
+void Renderer::RenderXFBToScreen(const MathUtil::Rectangle<int>& target_rc,
+                                 const AbstractTexture* source_texture,
+                                 const MathUtil::Rectangle<int>& source_rc)
+{
+  // Copying the XFB saves drawing a full-screen triangle with the post-processing pipeline. The
+  // copy has to convert the format if the swap chain isn't RGBA.
+  const VKTexture* source = static_cast<const VKTexture*>(source_texture);
+  const bool same_format = source->GetFormat() == m_swap_chain->GetTextureFormat();
+  if (!CanCopyXFBToBackbuffer(target_rc, source_rc) || source->GetLayers() != 1 ||
+      !(same_format ? m_swap_chain->CanCopyToImages() : m_swap_chain->CanBlitToImages()))
+  {
+    ::Renderer::RenderXFBToScreen(target_rc, source_texture, source_rc);
+    return;
+  }
+
+  // The backbuffer doesn't have to be cleared first if the XFB covers all of it.
+  VKTexture* backbuffer = m_swap_chain->GetCurrentTexture();
+  if (target_rc == backbuffer->GetRect())
+    StateTracker::GetInstance()->DiscardPendingRenderPass();
+  else
+    StateTracker::GetInstance()->EndRenderPass();
+
+  const VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
+  const VkImageLayout old_source_layout = source->GetLayout();
+  source->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+  backbuffer->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+  const VkImageSubresourceLayers subresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+  if (same_format)
+  {
+    const VkImageCopy region = {
+        subresource,
+        {source_rc.left, source_rc.top, 0},
+        subresource,
+        {target_rc.left, target_rc.top, 0},
+        {static_cast<u32>(source_rc.GetWidth()), static_cast<u32>(source_rc.GetHeight()), 1}};
+    vkCmdCopyImage(command_buffer, source->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   backbuffer->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+  }
+  else
+  {
+    const VkImageBlit region = {
+        subresource,
+        {{source_rc.left, source_rc.top, 0}, {source_rc.right, source_rc.bottom, 1}},
+        subresource,
+        {{target_rc.left, target_rc.top, 0}, {target_rc.right, target_rc.bottom, 1}}};
+    vkCmdBlitImage(command_buffer, source->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   backbuffer->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region,
+                   VK_FILTER_NEAREST);
+  }
+
+  source->TransitionToLayout(command_buffer, old_source_layout);
+  backbuffer->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+  // Anything drawn on top, like ImGui, begins a pass which loads the copy.
 }
 
 void Renderer::SetFullscreen(bool enable_fullscreen)
@@ -382,6 +461,14 @@ void Renderer::CheckForSurfaceChange()
   if (!m_surface_changed.TestAndClear() || !m_swap_chain)
     return;
 
+  // The surface went away after this frame started. Keep using the old swap chain until there is
+  // a new surface, since a swap chain can't exist without one.
+  if (!m_new_surface_handle)
+  {
+    m_surface_changed.Set();
+    return;
+  }
+
   // Submit the current draws up until rendering the XFB.
   ExecuteCommandBuffer(false, true);
 
@@ -416,8 +503,9 @@ void Renderer::CheckForSurfaceResize()
   // Clear the present failed flag, since we don't want to resize after recreating.
   g_command_buffer_mgr->CheckLastPresentFail();
 
-  // Resize the swap chain.
-  m_swap_chain->RecreateSwapChain();
+  // Resize the swap chain. The old swap chain is handed over to the new one, which lets the driver
+  // reuse its resources, and nothing else (pipelines, textures, the EFB) depends on its size.
+  m_swap_chain->ResizeSwapChain();
   OnSwapChainResized();
 }
 
@@ -81,6 +81,9 @@ public:
                              u32 groupsize_z, u32 groups_x, u32 groups_y, u32 groups_z) override;
   void BindBackbuffer(const ClearColor& clear_color = {}) override;
   void PresentBackbuffer() override;
+  void RenderXFBToScreen(const MathUtil::Rectangle<int>& target_rc,
+                         const AbstractTexture* source_texture,
+                         const MathUtil::Rectangle<int>& source_rc) override;
   void SetFullscreen(bool enable_fullscreen) override;
   bool IsFullscreen() const override;
 
@@ -90,6 +93,7 @@ public:
 
 protected:
   std::unique_ptr<BoundingBox> CreateBoundingBox() const override;
+  std::unique_ptr<VideoCommon::GPUTiming> CreateGPUTiming() const override;
 
 private:
   void CheckForSurfaceChange();
@@ -101,6 +105,8 @@ private:
   void BindFramebuffer(VKFramebuffer* fb);
 
   std::unique_ptr<SwapChain> m_swap_chain;
+  // Presentation time for the backbuffer which is being drawn, if frame pacing is active.
+  VkPresentTimeGOOGLE m_next_present_time = {};
 
   // Keep a copy of sampler states to avoid cache lookups every draw
   std::array<SamplerState, NUM_PIXEL_SHADER_SAMPLERS> m_sampler_states = {};
@@ -47,6 +47,12 @@ VKShader::VKShader(std::vector<u32> spv, VkPipeline compute_pipeline, std::strin
 
 VKShader::~VKShader()
 {
+  for (auto& it : m_pipeline_libraries)
+  {
+    if (it.second != VK_NULL_HANDLE)
+      vkDestroyPipeline(g_vulkan_context->GetDevice(), it.second, nullptr);
+  }
+
   if (m_stage != ShaderStage::Compute)
     vkDestroyShaderModule(g_vulkan_context->GetDevice(), m_module, nullptr);
   else
@@ -60,6 +66,19 @@ AbstractShader::BinaryData VKShader::GetBinary() const
   return ret;
 }
 
+VkPipeline VKShader::GetPipelineLibrary(const PipelineLibraryKey& key,
+                                        const std::function<VkPipeline()>& create) const
+{
+  std::lock_guard<std::mutex> guard(m_pipeline_library_lock);
+  auto it = m_pipeline_libraries.find(key);
+  if (it != m_pipeline_libraries.end())
+    return it->second;
+
+  VkPipeline library = create();
+  m_pipeline_libraries.emplace(key, library);
+  return library;
+}
+
 static std::unique_ptr<VKShader>
 CreateShaderObject(ShaderStage stage, ShaderCompiler::SPIRVCodeVector spv, std::string_view name)
 {
@@ -4,12 +4,16 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "VideoBackends/Vulkan/ObjectCache.h"
 #include "VideoBackends/Vulkan/VulkanLoader.h"
 #include "VideoCommon/AbstractShader.h"
 
@@ -26,6 +30,11 @@ public:
   VkPipeline GetComputePipeline() const { return m_compute_pipeline; }
   BinaryData GetBinary() const override;
 
+  // Graphics pipeline library parts built from this shader module. They are owned by the shader,
+  // so they can't outlive the module. create is only called on a miss.
+  VkPipeline GetPipelineLibrary(const PipelineLibraryKey& key,
+                                const std::function<VkPipeline()>& create) const;
+
   static std::unique_ptr<VKShader> CreateFromSource(ShaderStage stage, std::string_view source,
                                                     std::string_view name);
   static std::unique_ptr<VKShader> CreateFromBinary(ShaderStage stage, const void* data,
@@ -36,6 +45,9 @@ private:
   VkShaderModule m_module;
   VkPipeline m_compute_pipeline;
   std::string m_name;
+
+  mutable std::mutex m_pipeline_library_lock;
+  mutable std::map<PipelineLibraryKey, VkPipeline> m_pipeline_libraries;
 };
 
 }  // namespace Vulkan
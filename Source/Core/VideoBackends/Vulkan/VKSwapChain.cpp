@@ -4,6 +4,7 @@
 #include "VideoBackends/Vulkan/VKSwapChain.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 
 #include "Common/Assert.h"
@@ -286,6 +287,24 @@ bool SwapChain::CreateSwapChain()
     return false;
   }
 
+  // The XFB can be copied into the images directly when it doesn't need to be drawn.
+  m_copy_supported =
+      (surface_capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT) != 0;
+  if (m_copy_supported)
+  {
+    image_usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+    VkFormatProperties format_properties;
+    vkGetPhysicalDeviceFormatProperties(g_vulkan_context->GetPhysicalDevice(),
+                                        m_surface_format.format, &format_properties);
+    m_blit_supported =
+        (format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_DST_BIT) != 0;
+  }
+  else
+  {
+    m_blit_supported = false;
+  }
+
   // Select the number of image layers for Quad-Buffered stereoscopy
   uint32_t image_layers = g_ActiveConfig.stereo_mode == StereoMode::QuadBuffer ? 2 : 1;
 
@@ -368,6 +387,9 @@ bool SwapChain::CreateSwapChain()
   m_width = size.width;
   m_height = size.height;
   m_layers = image_layers;
+
+  // The refresh rate can change along with the swap chain, e.g. when moving to another display.
+  UpdateRefreshDuration();
   return true;
 }
 
@@ -574,6 +596,54 @@ bool SwapChain::RecreateSurface(void* native_handle)
   return true;
 }
 
+void SwapChain::UpdateRefreshDuration()
+{
+  VkRefreshCycleDurationGOOGLE refresh_cycle = {};
+  if (!g_vulkan_context->SupportsDeviceExtension(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME) ||
+      vkGetRefreshCycleDurationGOOGLE(g_vulkan_context->GetDevice(), m_swap_chain,
+                                      &refresh_cycle) != VK_SUCCESS)
+  {
+    m_frame_pacer.SetRefreshDuration(0);
+    return;
+  }
+
+  INFO_LOG_FMT(VIDEO, "Display refresh duration: {} ns", refresh_cycle.refreshDuration);
+  m_frame_pacer.SetRefreshDuration(refresh_cycle.refreshDuration);
+}
+
+VkPresentTimeGOOGLE SwapChain::GetNextPresentTime()
+{
+  if (!SupportsFramePacing())
+    return {};
+
+  // Feed the timings of the presents which completed since the last frame back into the pacer.
+  VkDevice device = g_vulkan_context->GetDevice();
+  u32 count = 0;
+  if (vkGetPastPresentationTimingGOOGLE(device, m_swap_chain, &count, nullptr) == VK_SUCCESS &&
+      count != 0)
+  {
+    m_past_present_timings.resize(count);
+    const VkResult res = vkGetPastPresentationTimingGOOGLE(device, m_swap_chain, &count,
+                                                           m_past_present_timings.data());
+    if (res == VK_SUCCESS || res == VK_INCOMPLETE)
+    {
+      for (u32 i = 0; i < count; i++)
+      {
+        const VkPastPresentationTimingGOOGLE& timing = m_past_present_timings[i];
+        m_frame_pacer.OnPresented(timing.desiredPresentTime, timing.actualPresentTime);
+      }
+    }
+  }
+
+  // The presentation engine uses CLOCK_MONOTONIC, which is what steady_clock is based on on the
+  // platforms which implement VK_GOOGLE_display_timing.
+  const u64 now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+  const FramePacer::Target target = m_frame_pacer.NextPresent(now);
+  return {target.present_id, target.desired_present_time};
+}
+
 void SwapChain::DestroySurface()
 {
   vkDestroySurfaceKHR(g_vulkan_context->GetVulkanInstance(), m_surface, nullptr);
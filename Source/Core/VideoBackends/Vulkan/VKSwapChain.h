@@ -9,6 +9,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/WindowSystemInfo.h"
 #include "VideoBackends/Vulkan/Constants.h"
+#include "VideoCommon/FramePacer.h"
 #include "VideoCommon/TextureConfig.h"
 
 namespace Vulkan
@@ -52,6 +53,10 @@ public:
   }
   VkResult AcquireNextImage();
 
+  // Whether textures can be copied into the images, or blitted with a format conversion.
+  bool CanCopyToImages() const { return m_copy_supported; }
+  bool CanBlitToImages() const { return m_blit_supported; }
+
   bool RecreateSurface(void* native_handle);
   bool ResizeSwapChain();
   bool RecreateSwapChain();
@@ -70,6 +75,13 @@ public:
   // Updates the fullscreen state. Must call on-thread.
   bool SetFullscreenState(bool state);
 
+  // Can frames be scheduled for a display refresh?
+  bool SupportsFramePacing() const { return m_frame_pacer.GetRefreshDuration() != 0; }
+
+  // Picks the presentation time for the current image. Must be called on-thread, while no present
+  // is in flight on the submit thread.
+  VkPresentTimeGOOGLE GetNextPresentTime();
+
 private:
   bool SelectSurfaceFormat();
   bool SelectPresentMode();
@@ -82,6 +94,8 @@ private:
 
   void DestroySurface();
 
+  void UpdateRefreshDuration();
+
   struct SwapChainImage
   {
     VkImage image{};
@@ -98,6 +112,8 @@ private:
   bool m_fullscreen_supported = false;
   bool m_current_fullscreen_state = false;
   bool m_next_fullscreen_state = false;
+  bool m_copy_supported = false;
+  bool m_blit_supported = false;
 
   VkSwapchainKHR m_swap_chain = VK_NULL_HANDLE;
   std::vector<SwapChainImage> m_swap_chain_images;
@@ -106,6 +122,9 @@ private:
   u32 m_width = 0;
   u32 m_height = 0;
   u32 m_layers = 0;
+
+  FramePacer m_frame_pacer;
+  std::vector<VkPastPresentationTimingGOOGLE> m_past_present_timings;
 };
 
 }  // namespace Vulkan
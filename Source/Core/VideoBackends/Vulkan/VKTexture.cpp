@@ -183,6 +183,12 @@ VkFormat VKTexture::GetVkFormatForHostTextureFormat(AbstractTextureFormat format
   case AbstractTextureFormat::BPTC:
     return VK_FORMAT_BC7_UNORM_BLOCK;
 
+  case AbstractTextureFormat::ETC2:
+    return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+
+  case AbstractTextureFormat::ASTC4x4:
+    return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+
   case AbstractTextureFormat::RGBA8:
     return VK_FORMAT_R8G8B8A8_UNORM;
 
@@ -342,16 +348,34 @@ void VKTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
   // When the last mip level is uploaded, we transition to SHADER_READ_ONLY, ready for use. This is
   // because we can't transition in a render pass, and we don't necessarily know when this texture
   // is going to be used.
-  TransitionToLayout(g_command_buffer_mgr->GetCurrentInitCommandBuffer(),
-                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
+  //
   // For unaligned textures, we can save some memory in the transfer buffer by skipping the rows
   // that lie outside of the texture's dimensions.
-  const u32 upload_alignment = static_cast<u32>(g_vulkan_context->GetBufferImageGranularity());
   const u32 block_size = GetBlockSizeForFormat(GetFormat());
   const u32 num_rows = Common::AlignUp(height, block_size) / block_size;
   const u32 source_pitch = CalculateStrideForFormat(m_config.format, row_length);
   const u32 upload_size = source_pitch * num_rows;
+
+  // Large textures which have never been used are uploaded on the transfer queue, if there is
+  // one, so the copy can overlap with rendering instead of holding up the next command buffer.
+  // Nothing can be sampling from them, so there's no need to wait for the graphics queue, and the
+  // remaining mip levels follow the first one there.
+  if (level == 0 && upload_size > STAGING_TEXTURE_UPLOAD_THRESHOLD &&
+      m_layout == VK_IMAGE_LAYOUT_UNDEFINED && GetLayers() == 1 &&
+      g_vulkan_context->HasTransferQueue())
+  {
+    m_transfer_queue_upload = true;
+  }
+
+  const VkCommandBuffer command_buffer =
+      m_transfer_queue_upload ? g_command_buffer_mgr->GetCurrentTransferCommandBuffer() :
+                                g_command_buffer_mgr->GetCurrentInitCommandBuffer();
+  TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+  // Copies on the transfer queue need four byte aligned buffer offsets.
+  u32 upload_alignment = static_cast<u32>(g_vulkan_context->GetBufferImageGranularity());
+  if (m_transfer_queue_upload)
+    upload_alignment = std::max(upload_alignment, 4u);
   std::unique_ptr<StagingBuffer> temp_buffer;
   VkBuffer upload_buffer;
   VkDeviceSize upload_buffer_offset;
@@ -403,8 +427,8 @@ void VKTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
       {0, 0, 0},                                 // VkOffset3D                  imageOffset
       {width, height, 1}                         // VkExtent3D                  imageExtent
   };
-  vkCmdCopyBufferToImage(g_command_buffer_mgr->GetCurrentInitCommandBuffer(), upload_buffer,
-                         m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_copy);
+  vkCmdCopyBufferToImage(command_buffer, upload_buffer, m_image,
+                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_copy);
 
   // Preemptively transition to shader read only after uploading the last mip level, as we're
   // likely finished with writes to this texture for now. We can't do this in common with a
@@ -412,11 +436,46 @@ void VKTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
   // don't want to interrupt the render pass with calls which were executed ages before.
   if (level == (m_config.levels - 1))
   {
-    TransitionToLayout(g_command_buffer_mgr->GetCurrentInitCommandBuffer(),
-                       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    if (m_transfer_queue_upload)
+      ReleaseFromTransferQueue(command_buffer);
+    else
+      TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
   }
 }
 
+void VKTexture::ReleaseFromTransferQueue(VkCommandBuffer transfer_command_buffer)
+{
+  // The transfer queue releases the image to the graphics queue, which acquires it in the init
+  // command buffer. Both halves of the ownership transfer do the layout transition.
+  VkImageMemoryBarrier barrier = {
+      VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,           // VkStructureType            sType
+      nullptr,                                          // const void*                pNext
+      VK_ACCESS_TRANSFER_WRITE_BIT,                     // VkAccessFlags              srcAccessMask
+      0,                                                // VkAccessFlags              dstAccessMask
+      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,             // VkImageLayout              oldLayout
+      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,         // VkImageLayout              newLayout
+      g_vulkan_context->GetTransferQueueFamilyIndex(),  // uint32_t srcQueueFamilyIndex
+      g_vulkan_context->GetGraphicsQueueFamilyIndex(),  // uint32_t dstQueueFamilyIndex
+      m_image,                                          // VkImage                    image
+      {GetImageAspectForFormat(GetFormat()), 0, GetLevels(), 0,
+       GetLayers()}  // VkImageSubresourceRange    subresourceRange
+  };
+
+  vkCmdPipelineBarrier(transfer_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1,
+                       &barrier);
+  g_command_buffer_mgr->SubmitTransferCommandBuffer();
+
+  barrier.srcAccessMask = 0;
+  barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+  vkCmdPipelineBarrier(g_command_buffer_mgr->GetCurrentInitCommandBuffer(),
+                       VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                       0, nullptr, 0, nullptr, 1, &barrier);
+
+  m_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  m_transfer_queue_upload = false;
+}
+
 void VKTexture::FinishedRendering()
 {
   if (m_layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
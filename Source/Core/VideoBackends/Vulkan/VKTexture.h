@@ -72,12 +72,15 @@ public:
 
 private:
   bool CreateView(VkImageViewType type);
+  void ReleaseFromTransferQueue(VkCommandBuffer transfer_command_buffer);
 
   VmaAllocation m_alloc;
   VkImage m_image;
   VkImageView m_view = VK_NULL_HANDLE;
   mutable VkImageLayout m_layout = VK_IMAGE_LAYOUT_UNDEFINED;
   mutable ComputeImageLayout m_compute_layout = ComputeImageLayout::Undefined;
+  // Set while the mip levels are being uploaded on the transfer queue.
+  bool m_transfer_queue_upload = false;
   std::string m_name;
 };
 
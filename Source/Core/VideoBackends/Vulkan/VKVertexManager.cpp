@@ -77,13 +77,14 @@ bool VertexManager::Initialize()
   // The validation layer complains if max(offsets) + max(ubo_ranges) >= ubo_size.
   // To work around this we reserve the maximum buffer size at all times, but only commit
   // as many bytes as we use.
-  m_uniform_buffer_reserve_size = sizeof(PixelShaderConstants);
+  // This is in the order UploadUniforms packs the blocks in.
+  m_uniform_buffer_reserve_size = sizeof(VertexShaderConstants);
   m_uniform_buffer_reserve_size = Common::AlignUp(m_uniform_buffer_reserve_size,
                                                   g_vulkan_context->GetUniformBufferAlignment()) +
-                                  sizeof(VertexShaderConstants);
+                                  sizeof(GeometryShaderConstants);
   m_uniform_buffer_reserve_size = Common::AlignUp(m_uniform_buffer_reserve_size,
                                                   g_vulkan_context->GetUniformBufferAlignment()) +
-                                  sizeof(GeometryShaderConstants);
+                                  sizeof(PixelShaderConstants);
 
   // Prefer an 8MB buffer if possible, but use less if the device doesn't support this.
   // This buffer is potentially going to be addressed as R8s in the future, so we assume
@@ -195,54 +196,63 @@ void VertexManager::CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 num_in
 
 void VertexManager::UploadUniforms()
 {
-  UpdateVertexShaderConstants();
-  UpdateGeometryShaderConstants();
-  UpdatePixelShaderConstants();
-}
-
-void VertexManager::UpdateVertexShaderConstants()
-{
-  if (!VertexShaderManager::dirty || !ReserveConstantStorage())
+  const bool vs_dirty = VertexShaderManager::dirty;
+  const bool gs_dirty = GeometryShaderManager::dirty;
+  const bool ps_dirty = PixelShaderManager::dirty;
+  if (!vs_dirty && !gs_dirty && !ps_dirty)
     return;
 
-  StateTracker::GetInstance()->SetGXUniformBuffer(
-      UBO_DESCRIPTOR_SET_BINDING_VS, m_uniform_stream_buffer->GetBuffer(),
-      m_uniform_stream_buffer->GetCurrentOffset(), sizeof(VertexShaderConstants));
-  std::memcpy(m_uniform_stream_buffer->GetCurrentHostPointer(), &VertexShaderManager::constants,
-              sizeof(VertexShaderConstants));
-  m_uniform_stream_buffer->CommitMemory(sizeof(VertexShaderConstants));
-  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(VertexShaderConstants));
-  VertexShaderManager::dirty = false;
-}
+  // Pack the blocks that changed into a single allocation, so that a draw only reserves and
+  // flushes uniform buffer memory once, no matter how many of them changed.
+  const u32 ub_alignment = static_cast<u32>(g_vulkan_context->GetUniformBufferAlignment());
+  u32 size = 0;
+  const auto place = [&size, ub_alignment](bool dirty, u32 block_size) {
+    if (!dirty)
+      return 0u;
+    const u32 offset = Common::AlignUp(size, ub_alignment);
+    size = offset + block_size;
+    return offset;
+  };
+  const u32 vs_offset = place(vs_dirty, sizeof(VertexShaderConstants));
+  const u32 gs_offset = place(gs_dirty, sizeof(GeometryShaderConstants));
+  const u32 ps_offset = place(ps_dirty, sizeof(PixelShaderConstants));
 
-void VertexManager::UpdateGeometryShaderConstants()
-{
-  if (!GeometryShaderManager::dirty || !ReserveConstantStorage())
+  if (!ReserveConstantStorage())
     return;
 
-  StateTracker::GetInstance()->SetGXUniformBuffer(
-      UBO_DESCRIPTOR_SET_BINDING_GS, m_uniform_stream_buffer->GetBuffer(),
-      m_uniform_stream_buffer->GetCurrentOffset(), sizeof(GeometryShaderConstants));
-  std::memcpy(m_uniform_stream_buffer->GetCurrentHostPointer(), &GeometryShaderManager::constants,
-              sizeof(GeometryShaderConstants));
-  m_uniform_stream_buffer->CommitMemory(sizeof(GeometryShaderConstants));
-  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(GeometryShaderConstants));
-  GeometryShaderManager::dirty = false;
-}
-
-void VertexManager::UpdatePixelShaderConstants()
-{
-  if (!PixelShaderManager::dirty || !ReserveConstantStorage())
-    return;
+  const VkBuffer buffer = m_uniform_stream_buffer->GetBuffer();
+  const u32 base_offset = m_uniform_stream_buffer->GetCurrentOffset();
+  u8* const host_pointer = m_uniform_stream_buffer->GetCurrentHostPointer();
+  if (vs_dirty)
+  {
+    StateTracker::GetInstance()->SetGXUniformBuffer(UBO_DESCRIPTOR_SET_BINDING_VS, buffer,
+                                                    base_offset + vs_offset,
+                                                    sizeof(VertexShaderConstants));
+    std::memcpy(host_pointer + vs_offset, &VertexShaderManager::constants,
+                sizeof(VertexShaderConstants));
+    VertexShaderManager::dirty = false;
+  }
+  if (gs_dirty)
+  {
+    StateTracker::GetInstance()->SetGXUniformBuffer(UBO_DESCRIPTOR_SET_BINDING_GS, buffer,
+                                                    base_offset + gs_offset,
+                                                    sizeof(GeometryShaderConstants));
+    std::memcpy(host_pointer + gs_offset, &GeometryShaderManager::constants,
+                sizeof(GeometryShaderConstants));
+    GeometryShaderManager::dirty = false;
+  }
+  if (ps_dirty)
+  {
+    StateTracker::GetInstance()->SetGXUniformBuffer(UBO_DESCRIPTOR_SET_BINDING_PS, buffer,
+                                                    base_offset + ps_offset,
+                                                    sizeof(PixelShaderConstants));
+    std::memcpy(host_pointer + ps_offset, &PixelShaderManager::constants,
+                sizeof(PixelShaderConstants));
+    PixelShaderManager::dirty = false;
+  }
 
-  StateTracker::GetInstance()->SetGXUniformBuffer(
-      UBO_DESCRIPTOR_SET_BINDING_PS, m_uniform_stream_buffer->GetBuffer(),
-      m_uniform_stream_buffer->GetCurrentOffset(), sizeof(PixelShaderConstants));
-  std::memcpy(m_uniform_stream_buffer->GetCurrentHostPointer(), &PixelShaderManager::constants,
-              sizeof(PixelShaderConstants));
-  m_uniform_stream_buffer->CommitMemory(sizeof(PixelShaderConstants));
-  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(PixelShaderConstants));
-  PixelShaderManager::dirty = false;
+  m_uniform_stream_buffer->CommitMemory(size);
+  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, size);
 }
 
 bool VertexManager::ReserveConstantStorage()
@@ -305,6 +305,9 @@ void VulkanContext::PopulateBackendInfo(VideoConfig* config)
   config->backend_info.bSupportsPartialMultisampleResolve = true;  // Assumed support.
   config->backend_info.bSupportsDynamicVertexLoader = true;        // Assumed support.
   config->backend_info.bSupportsVSLinePointExpand = true;          // Assumed support.
+  config->backend_info.bSupportsD24S8DepthBuffer = false;          // Dependent on features.
+  config->backend_info.bSupportsETC2Textures = false;              // Dependent on features.
+  config->backend_info.bSupportsASTCTextures = false;              // Dependent on features.
 }
 
 void VulkanContext::PopulateBackendInfoAdapters(VideoConfig* config, const GPUList& gpu_list)
@@ -356,6 +359,10 @@ void VulkanContext::PopulateBackendInfoFeatures(VideoConfig* config, VkPhysicalD
   config->backend_info.bSupportsST3CTextures = supports_bc;
   config->backend_info.bSupportsBPTCTextures = supports_bc;
 
+  // Mobile GPUs usually support ETC2 and ASTC instead of BC.
+  config->backend_info.bSupportsETC2Textures = features.textureCompressionETC2 == VK_TRUE;
+  config->backend_info.bSupportsASTCTextures = features.textureCompressionASTC_LDR == VK_TRUE;
+
   // Some devices don't support point sizes >1 (e.g. Adreno).
   // If we can't use a point size above our maximum IR, use triangles instead for EFB pokes.
   // This means a 6x increase in the size of the vertices, though.
@@ -363,6 +370,15 @@ void VulkanContext::PopulateBackendInfoFeatures(VideoConfig* config, VkPhysicalD
                                               properties.limits.pointSizeRange[0] <= 1.0f &&
                                               properties.limits.pointSizeRange[1] >= 16;
 
+  // D24S8 is optional in Vulkan, and missing on some GPUs (e.g. AMD desktop, some PowerVR).
+  VkImageFormatProperties d24s8_properties = {};
+  config->backend_info.bSupportsD24S8DepthBuffer =
+      vkGetPhysicalDeviceImageFormatProperties(
+          gpu, VK_FORMAT_D24_UNORM_S8_UINT, VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL,
+          VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+              VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+          0, &d24s8_properties) == VK_SUCCESS;
+
   std::string device_name = properties.deviceName;
   u32 vendor_id = properties.vendorID;
 
@@ -517,6 +533,23 @@ bool VulkanContext::SelectDeviceExtensions(bool enable_surface)
   AddExtension(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, false);
   AddExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, false);
 
+  // VK_GOOGLE_display_timing, used for frame pacing
+  if (enable_surface)
+    AddExtension(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME, false);
+
+  // VK_KHR_timeline_semaphore, used to synchronize the transfer queue
+  AddExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME, false);
+
+  // VK_KHR_push_descriptor, used for the sampler bindings which change between draws
+  AddExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, false);
+
+  // VK_EXT_extended_dynamic_state, used to keep cull mode and depth state out of pipelines
+  AddExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME, false);
+
+  // VK_EXT_graphics_pipeline_library, used to link pipelines from precompiled parts
+  if (AddExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME, false))
+    AddExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME, false);
+
   return true;
 }
 
@@ -554,6 +587,8 @@ bool VulkanContext::SelectDeviceFeatures()
   m_device_features.shaderClipDistance = available_features.shaderClipDistance;
   m_device_features.depthClamp = available_features.depthClamp;
   m_device_features.textureCompressionBC = available_features.textureCompressionBC;
+  m_device_features.textureCompressionETC2 = available_features.textureCompressionETC2;
+  m_device_features.textureCompressionASTC_LDR = available_features.textureCompressionASTC_LDR;
   return true;
 }
 
@@ -622,6 +657,24 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
     return false;
   }
 
+  // Look for a queue family which only does transfers, which is usually backed by a DMA engine
+  // that can copy while the graphics queue is busy. Families with a coarse image transfer
+  // granularity are skipped, since uploads don't always cover whole mip levels.
+  u32 transfer_queue_family_index = queue_family_count;
+  for (u32 i = 0; i < queue_family_count; i++)
+  {
+    const VkQueueFamilyProperties& properties = queue_family_properties[i];
+    const VkExtent3D& granularity = properties.minImageTransferGranularity;
+    if ((properties.queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+        !(properties.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) &&
+        properties.queueCount > 0 && granularity.width == 1 && granularity.height == 1 &&
+        granularity.depth == 1)
+    {
+      transfer_queue_family_index = i;
+      break;
+    }
+  }
+
   VkDeviceCreateInfo device_info = {};
   device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
   device_info.pNext = nullptr;
@@ -644,7 +697,7 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
   present_queue_info.queueCount = 1;
   present_queue_info.pQueuePriorities = queue_priorities;
 
-  std::array<VkDeviceQueueCreateInfo, 2> queue_infos = {{
+  std::array<VkDeviceQueueCreateInfo, 3> queue_infos = {{
       graphics_queue_info,
       present_queue_info,
   }};
@@ -660,6 +713,44 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
   if (!SelectDeviceExtensions(surface != VK_NULL_HANDLE))
     return false;
 
+  VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_semaphore_features = {};
+  timeline_semaphore_features.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+  timeline_semaphore_features.timelineSemaphore = VK_TRUE;
+  const bool create_transfer_queue =
+      transfer_queue_family_index != queue_family_count && SupportsTimelineSemaphores();
+  if (create_transfer_queue)
+  {
+    VkDeviceQueueCreateInfo& transfer_queue_info = queue_infos[device_info.queueCreateInfoCount++];
+    transfer_queue_info = graphics_queue_info;
+    transfer_queue_info.queueFamilyIndex = transfer_queue_family_index;
+    device_info.pNext = &timeline_semaphore_features;
+    m_transfer_queue_family_index = transfer_queue_family_index;
+  }
+
+  VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extended_dynamic_state_features = {};
+  extended_dynamic_state_features.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+  extended_dynamic_state_features.extendedDynamicState = VK_TRUE;
+  const bool enable_extended_dynamic_state = SupportsExtendedDynamicStateFeature();
+  if (enable_extended_dynamic_state)
+  {
+    extended_dynamic_state_features.pNext = const_cast<void*>(device_info.pNext);
+    device_info.pNext = &extended_dynamic_state_features;
+  }
+
+  VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphics_pipeline_library_features = {};
+  graphics_pipeline_library_features.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+  graphics_pipeline_library_features.graphicsPipelineLibrary = VK_TRUE;
+  m_supports_graphics_pipeline_library = SupportsFastGraphicsPipelineLibraryLinking();
+  if (m_supports_graphics_pipeline_library)
+  {
+    graphics_pipeline_library_features.pNext = const_cast<void*>(device_info.pNext);
+    device_info.pNext = &graphics_pipeline_library_features;
+    INFO_LOG_FMT(VIDEO, "Using VK_EXT_graphics_pipeline_library for pipeline linking.");
+  }
+
   // convert std::string list to a char pointer list which we can feed in
   std::vector<const char*> extension_name_pointers;
   for (const std::string& name : m_device_extensions)
@@ -695,15 +786,103 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
   if (!LoadVulkanDeviceFunctions(m_device))
     return false;
 
+  m_supports_push_descriptors =
+      SupportsDeviceExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) && vkCmdPushDescriptorSetKHR;
+  if (m_supports_push_descriptors)
+    INFO_LOG_FMT(VIDEO, "Using VK_KHR_push_descriptor for sampler bindings.");
+
+  m_supports_extended_dynamic_state = enable_extended_dynamic_state && vkCmdSetCullModeEXT &&
+                                      vkCmdSetDepthTestEnableEXT && vkCmdSetDepthWriteEnableEXT &&
+                                      vkCmdSetDepthCompareOpEXT;
+  if (m_supports_extended_dynamic_state)
+    INFO_LOG_FMT(VIDEO, "Using VK_EXT_extended_dynamic_state for cull mode and depth state.");
+
   // Grab the graphics and present queues.
   vkGetDeviceQueue(m_device, m_graphics_queue_family_index, 0, &m_graphics_queue);
   if (surface)
   {
     vkGetDeviceQueue(m_device, m_present_queue_family_index, 0, &m_present_queue);
   }
+  if (create_transfer_queue)
+  {
+    vkGetDeviceQueue(m_device, m_transfer_queue_family_index, 0, &m_transfer_queue);
+    INFO_LOG_FMT(VIDEO, "Using queue family {} for texture uploads", m_transfer_queue_family_index);
+  }
   return true;
 }
 
+bool VulkanContext::SupportsTimelineSemaphores() const
+{
+  // Like vkGetPhysicalDeviceProperties2(), the function pointer alone doesn't mean the device
+  // supports Vulkan 1.1.
+  if (!SupportsDeviceExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) ||
+      !vkGetPhysicalDeviceFeatures2 || (VK_VERSION_MAJOR(m_device_properties.apiVersion) == 1 &&
+                                        VK_VERSION_MINOR(m_device_properties.apiVersion) < 1))
+  {
+    return false;
+  }
+
+  VkPhysicalDeviceFeatures2 features_2 = {};
+  features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_semaphore_features = {};
+  timeline_semaphore_features.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+  features_2.pNext = &timeline_semaphore_features;
+  vkGetPhysicalDeviceFeatures2(m_physical_device, &features_2);
+  return timeline_semaphore_features.timelineSemaphore == VK_TRUE;
+}
+
+bool VulkanContext::SupportsExtendedDynamicStateFeature() const
+{
+  if (!SupportsDeviceExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME) ||
+      !vkGetPhysicalDeviceFeatures2 || (VK_VERSION_MAJOR(m_device_properties.apiVersion) == 1 &&
+                                        VK_VERSION_MINOR(m_device_properties.apiVersion) < 1))
+  {
+    return false;
+  }
+
+  VkPhysicalDeviceFeatures2 features_2 = {};
+  features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extended_dynamic_state_features = {};
+  extended_dynamic_state_features.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+  features_2.pNext = &extended_dynamic_state_features;
+  vkGetPhysicalDeviceFeatures2(m_physical_device, &features_2);
+  return extended_dynamic_state_features.extendedDynamicState == VK_TRUE;
+}
+
+bool VulkanContext::SupportsFastGraphicsPipelineLibraryLinking() const
+{
+  if (!SupportsDeviceExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) ||
+      !vkGetPhysicalDeviceFeatures2 || !vkGetPhysicalDeviceProperties2 ||
+      (VK_VERSION_MAJOR(m_device_properties.apiVersion) == 1 &&
+       VK_VERSION_MINOR(m_device_properties.apiVersion) < 1))
+  {
+    return false;
+  }
+
+  VkPhysicalDeviceFeatures2 features_2 = {};
+  features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphics_pipeline_library_features = {};
+  graphics_pipeline_library_features.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+  features_2.pNext = &graphics_pipeline_library_features;
+  vkGetPhysicalDeviceFeatures2(m_physical_device, &features_2);
+
+  VkPhysicalDeviceProperties2 properties_2 = {};
+  properties_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+  VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT graphics_pipeline_library_properties = {};
+  graphics_pipeline_library_properties.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+  properties_2.pNext = &graphics_pipeline_library_properties;
+  vkGetPhysicalDeviceProperties2(m_physical_device, &properties_2);
+
+  // Without fast linking, linking can cost as much as a full compile, so there is no gain over
+  // creating the pipeline in one go.
+  return graphics_pipeline_library_features.graphicsPipelineLibrary == VK_TRUE &&
+         graphics_pipeline_library_properties.graphicsPipelineLibraryFastLinking == VK_TRUE;
+}
+
 bool VulkanContext::CreateAllocator(u32 vk_api_version)
 {
   VmaAllocatorCreateInfo allocator_info = {};
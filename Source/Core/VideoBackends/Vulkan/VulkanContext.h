@@ -61,6 +61,11 @@ public:
   u32 GetGraphicsQueueFamilyIndex() const { return m_graphics_queue_family_index; }
   VkQueue GetPresentQueue() const { return m_present_queue; }
   u32 GetPresentQueueFamilyIndex() const { return m_present_queue_family_index; }
+  // A queue on a transfer-only family, used for large texture uploads. Only created when timeline
+  // semaphores are supported for synchronizing it with the graphics queue.
+  bool HasTransferQueue() const { return m_transfer_queue != VK_NULL_HANDLE; }
+  VkQueue GetTransferQueue() const { return m_transfer_queue; }
+  u32 GetTransferQueueFamilyIndex() const { return m_transfer_queue_family_index; }
   const VkQueueFamilyProperties& GetGraphicsQueueProperties() const
   {
     return m_graphics_queue_properties;
@@ -83,6 +88,9 @@ public:
   }
   u32 GetShaderSubgroupSize() const { return m_shader_subgroup_size; }
   bool SupportsShaderSubgroupOperations() const { return m_supports_shader_subgroup_operations; }
+  bool SupportsGraphicsPipelineLibrary() const { return m_supports_graphics_pipeline_library; }
+  bool SupportsPushDescriptors() const { return m_supports_push_descriptors; }
+  bool SupportsExtendedDynamicState() const { return m_supports_extended_dynamic_state; }
 
   // Helpers for getting constants
   VkDeviceSize GetUniformBufferAlignment() const
@@ -119,6 +127,9 @@ private:
   bool SelectDeviceExtensions(bool enable_surface);
   bool SelectDeviceFeatures();
   bool CreateDevice(VkSurfaceKHR surface, bool enable_validation_layer);
+  bool SupportsTimelineSemaphores() const;
+  bool SupportsExtendedDynamicStateFeature() const;
+  bool SupportsFastGraphicsPipelineLibraryLinking() const;
   void InitDriverDetails();
   void PopulateShaderSubgroupSupport();
   bool CreateAllocator(u32 vk_api_version);
@@ -132,6 +143,8 @@ private:
   u32 m_graphics_queue_family_index = 0;
   VkQueue m_present_queue = VK_NULL_HANDLE;
   u32 m_present_queue_family_index = 0;
+  VkQueue m_transfer_queue = VK_NULL_HANDLE;
+  u32 m_transfer_queue_family_index = 0;
   VkQueueFamilyProperties m_graphics_queue_properties = {};
 
   VkDebugReportCallbackEXT m_debug_report_callback = VK_NULL_HANDLE;
@@ -142,6 +155,9 @@ private:
 
   u32 m_shader_subgroup_size = 1;
   bool m_supports_shader_subgroup_operations = false;
+  bool m_supports_graphics_pipeline_library = false;
+  bool m_supports_push_descriptors = false;
+  bool m_supports_extended_dynamic_state = false;
 
   std::vector<std::string> m_device_extensions;
 };
@@ -23,6 +23,50 @@
 
 #include "vulkan/vulkan.h"
 
+// VK_EXT_graphics_pipeline_library is newer than the bundled headers, so declare the parts we use.
+#ifndef VK_EXT_graphics_pipeline_library
+#define VK_EXT_graphics_pipeline_library 1
+#define VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME "VK_EXT_graphics_pipeline_library"
+#define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT                     \
+  static_cast<VkStructureType>(1000320000)
+#define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT                   \
+  static_cast<VkStructureType>(1000320001)
+#define VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT                                \
+  static_cast<VkStructureType>(1000320002)
+
+typedef enum VkGraphicsPipelineLibraryFlagBitsEXT
+{
+  VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT = 0x00000001,
+  VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT = 0x00000002,
+  VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT = 0x00000004,
+  VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT = 0x00000008,
+  VK_GRAPHICS_PIPELINE_LIBRARY_FLAG_BITS_MAX_ENUM_EXT = 0x7FFFFFFF
+} VkGraphicsPipelineLibraryFlagBitsEXT;
+typedef VkFlags VkGraphicsPipelineLibraryFlagsEXT;
+
+typedef struct VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT
+{
+  VkStructureType sType;
+  void* pNext;
+  VkBool32 graphicsPipelineLibrary;
+} VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT;
+
+typedef struct VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT
+{
+  VkStructureType sType;
+  void* pNext;
+  VkBool32 graphicsPipelineLibraryFastLinking;
+  VkBool32 graphicsPipelineLibraryIndependentInterpolationDecoration;
+} VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT;
+
+typedef struct VkGraphicsPipelineLibraryCreateInfoEXT
+{
+  VkStructureType sType;
+  void* pNext;
+  VkGraphicsPipelineLibraryFlagsEXT flags;
+} VkGraphicsPipelineLibraryCreateInfoEXT;
+#endif
+
 // Currently, exclusive fullscreen is only supported on Windows.
 #if defined(WIN32)
 #define SUPPORTS_VULKAN_EXCLUSIVE_FULLSCREEN 1
@@ -83,4 +83,8 @@ public:
   // pipeline objects, the cache is optionally used by the driver to speed up compilation.
   using CacheData = std::vector<u8>;
   virtual CacheData GetCacheData() const { return {}; }
+
+  // Some drivers finish compiling pipelines in the background after they are created. This
+  // returns false until the pipeline can be used without waiting for the driver.
+  virtual bool IsCompileComplete() const { return true; }
 };
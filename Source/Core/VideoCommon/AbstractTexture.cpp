@@ -62,6 +62,8 @@ bool AbstractTexture::IsCompressedFormat(AbstractTextureFormat format)
   case AbstractTextureFormat::DXT3:
   case AbstractTextureFormat::DXT5:
   case AbstractTextureFormat::BPTC:
+  case AbstractTextureFormat::ETC2:
+  case AbstractTextureFormat::ASTC4x4:
     return true;
 
   default:
@@ -114,6 +116,8 @@ u32 AbstractTexture::CalculateStrideForFormat(AbstractTextureFormat format, u32
   case AbstractTextureFormat::DXT3:
   case AbstractTextureFormat::DXT5:
   case AbstractTextureFormat::BPTC:
+  case AbstractTextureFormat::ETC2:
+  case AbstractTextureFormat::ASTC4x4:
     return static_cast<size_t>(std::max(1u, row_length / 4)) * 16;
   case AbstractTextureFormat::R16:
   case AbstractTextureFormat::D16:
@@ -141,6 +145,8 @@ u32 AbstractTexture::GetTexelSizeForFormat(AbstractTextureFormat format)
   case AbstractTextureFormat::DXT3:
   case AbstractTextureFormat::DXT5:
   case AbstractTextureFormat::BPTC:
+  case AbstractTextureFormat::ETC2:
+  case AbstractTextureFormat::ASTC4x4:
     return 16;
   case AbstractTextureFormat::R16:
   case AbstractTextureFormat::D16:
@@ -167,6 +173,8 @@ u32 AbstractTexture::GetBlockSizeForFormat(AbstractTextureFormat format)
   case AbstractTextureFormat::DXT3:
   case AbstractTextureFormat::DXT5:
   case AbstractTextureFormat::BPTC:
+  case AbstractTextureFormat::ETC2:
+  case AbstractTextureFormat::ASTC4x4:
     return 4;
 
   default:
@@ -3,10 +3,14 @@
 
 #include "VideoCommon/AsyncShaderCompiler.h"
 
+#include <algorithm>
+#include <iterator>
 #include <thread>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
+#include "Common/ScopeGuard.h"
 #include "Common/Thread.h"
 
 #include "Core/Core.h"
@@ -35,11 +39,33 @@ void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
   else
   {
     std::lock_guard<std::mutex> guard(m_pending_work_lock);
-    m_pending_work.emplace(priority, std::move(item));
+    m_pending_work.emplace(priority,
+                           PendingWorkItem{std::move(item), std::chrono::steady_clock::now()});
     m_worker_thread_wake.notify_one();
   }
 }
 
+bool AsyncShaderCompiler::PromoteWorkItem(const WorkItem* item, u32 priority)
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  for (auto iter = m_pending_work.upper_bound(priority); iter != m_pending_work.end(); ++iter)
+  {
+    if (iter->second.item.get() != item)
+      continue;
+
+    // The queue time is kept, so the latency includes the wait at the old priority.
+    auto node = m_pending_work.extract(iter);
+    node.key() = priority;
+    m_pending_work.insert(std::move(node));
+
+    // The item may now be one that the worker kept free of background work can take.
+    m_worker_thread_wake.notify_one();
+    return true;
+  }
+
+  return false;
+}
+
 void AsyncShaderCompiler::RetrieveWorkItems()
 {
   std::deque<WorkItemPtr> completed_work;
@@ -48,11 +74,22 @@ void AsyncShaderCompiler::RetrieveWorkItems()
     m_completed_work.swap(completed_work);
   }
 
+  std::deque<WorkItemPtr> unready_work;
   while (!completed_work.empty())
   {
-    completed_work.front()->Retrieve();
+    if (completed_work.front()->IsReady())
+      completed_work.front()->Retrieve();
+    else
+      unready_work.push_back(std::move(completed_work.front()));
     completed_work.pop_front();
   }
+
+  if (!unready_work.empty())
+  {
+    std::lock_guard<std::mutex> guard(m_completed_work_lock);
+    m_completed_work.insert(m_completed_work.begin(), std::make_move_iterator(unready_work.begin()),
+                            std::make_move_iterator(unready_work.end()));
+  }
 }
 
 bool AsyncShaderCompiler::HasPendingWork()
@@ -67,12 +104,52 @@ bool AsyncShaderCompiler::HasCompletedWork()
   return !m_completed_work.empty();
 }
 
+void AsyncShaderCompiler::SetBackgroundPriority(u32 priority)
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  m_background_priority = priority;
+  m_worker_thread_wake.notify_all();
+}
+
+AsyncShaderCompiler::LatencyStats AsyncShaderCompiler::GetLatencyStats()
+{
+  std::vector<u32> samples;
+  {
+    std::lock_guard<std::mutex> guard(m_completed_work_lock);
+    samples.assign(m_latency_samples_us.begin(),
+                   m_latency_samples_us.begin() +
+                       std::min(m_num_latency_samples, m_latency_samples_us.size()));
+  }
+  if (samples.empty())
+    return {};
+
+  std::sort(samples.begin(), samples.end());
+  const auto percentile = [&samples](size_t p) { return samples[(samples.size() - 1) * p / 100]; };
+  return {static_cast<u32>(samples.size()), percentile(50), percentile(95), percentile(99)};
+}
+
+bool AsyncShaderCompiler::CanStartWorkItem(u32 priority) const
+{
+  return priority < m_background_priority || m_waiting_for_completion ||
+         m_busy_background_workers < m_max_background_workers;
+}
+
 bool AsyncShaderCompiler::WaitUntilCompletion(
     const std::function<void(size_t, size_t)>& progress_callback)
 {
   if (!HasPendingWork())
     return true;
 
+  {
+    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    m_waiting_for_completion = true;
+    m_worker_thread_wake.notify_all();
+  }
+  Common::ScopeGuard waiting_guard{[this] {
+    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    m_waiting_for_completion = false;
+  }};
+
   // Wait a second before opening a progress dialog.
   // This way, if the operation completes quickly, we don't annoy the user.
   constexpr u32 CHECK_INTERVAL_MS = 1000 / 30;
@@ -118,6 +195,11 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
   if (num_worker_threads == 0)
     return true;
 
+  {
+    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    m_max_background_workers = std::max<size_t>(num_worker_threads, 2) - 1;
+  }
+
   for (u32 i = 0; i < num_worker_threads; i++)
   {
     void* thread_param = nullptr;
@@ -142,6 +224,13 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
     m_worker_threads.push_back(std::move(thr));
   }
 
+  // Some workers may have failed to start.
+  {
+    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    m_max_background_workers = std::max<size_t>(m_worker_threads.size(), 2) - 1;
+    m_worker_thread_wake.notify_all();
+  }
+
   return HasWorkerThreads();
 }
 
@@ -195,6 +284,8 @@ void AsyncShaderCompiler::WorkerThreadExit(void* param)
 void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
 {
   Common::SetCurrentThreadName("AsyncShaderCompiler Worker");
+  // Keep the fast cores free for the CPU and GPU threads.
+  Core::PinCurrentThread(Core::HostCoreType::Efficiency);
 
   // Initialize worker thread with backend-specific method.
   if (!WorkerThreadInitWorkerThread(param))
@@ -218,25 +309,39 @@ void AsyncShaderCompiler::WorkerThreadRun()
   std::unique_lock<std::mutex> pending_lock(m_pending_work_lock);
   while (!m_exit_flag.IsSet())
   {
-    m_worker_thread_wake.wait(pending_lock);
-
-    while (!m_pending_work.empty() && !m_exit_flag.IsSet())
+    // The work items are ordered by priority, so if the first one has to wait, they all do.
+    auto iter = m_pending_work.begin();
+    if (iter == m_pending_work.end() || !CanStartWorkItem(iter->first))
     {
-      m_busy_workers++;
-      auto iter = m_pending_work.begin();
-      WorkItemPtr item(std::move(iter->second));
-      m_pending_work.erase(iter);
-      pending_lock.unlock();
+      m_worker_thread_wake.wait(pending_lock);
+      continue;
+    }
+
+    const bool background = iter->first >= m_background_priority;
+    m_busy_workers++;
+    if (background)
+      m_busy_background_workers++;
+    PendingWorkItem work(std::move(iter->second));
+    m_pending_work.erase(iter);
+    pending_lock.unlock();
 
-      if (item->Compile())
+    if (work.item->Compile())
+    {
+      const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - work.queue_time);
+      std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
+      if (!background)
       {
-        std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
-        m_completed_work.push_back(std::move(item));
+        m_latency_samples_us[m_num_latency_samples++ % m_latency_samples_us.size()] =
+            static_cast<u32>(std::min<s64>(latency.count(), UINT32_MAX));
       }
-
-      pending_lock.lock();
-      m_busy_workers--;
+      m_completed_work.push_back(std::move(work.item));
     }
+
+    pending_lock.lock();
+    m_busy_workers--;
+    if (background)
+      m_busy_background_workers--;
   }
 }
 
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
@@ -29,10 +31,24 @@ public:
     virtual ~WorkItem() = default;
     virtual bool Compile() = 0;
     virtual void Retrieve() = 0;
+
+    // Retrieve() is put off until a later RetrieveWorkItems() call while this returns false, e.g.
+    // while the driver is still compiling the result in the background.
+    virtual bool IsReady() const { return true; }
   };
 
   using WorkItemPtr = std::unique_ptr<WorkItem>;
 
+  // Time from queueing to finished compiling, over the recent work items which weren't
+  // background work.
+  struct LatencyStats
+  {
+    u32 samples;
+    u32 p50_us;
+    u32 p95_us;
+    u32 p99_us;
+  };
+
   AsyncShaderCompiler();
   virtual ~AsyncShaderCompiler();
 
@@ -49,6 +65,17 @@ public:
   bool HasPendingWork();
   bool HasCompletedWork();
 
+  // Work items with at least this priority are background work, such as precompiling the shader
+  // cache. When there are several workers, one of them is kept free of background work, so work
+  // which is needed for the frame being drawn never waits behind a background compile. The whole
+  // pool takes background work while waiting for completion, as nothing is being drawn then.
+  void SetBackgroundPriority(u32 priority);
+
+  // Moves a work item which no worker has picked up yet forward to the given priority. Returns
+  // false if the item isn't waiting in the queue, or will already be compiled that soon.
+  bool PromoteWorkItem(const WorkItem* item, u32 priority);
+  LatencyStats GetLatencyStats();
+
   // Calls progress_callback periodically, with completed_items, and total_items.
   // Returns false if interrupted.
   bool WaitUntilCompletion(const std::function<void(size_t, size_t)>& progress_callback);
@@ -65,8 +92,15 @@ protected:
   virtual void WorkerThreadExit(void* param);
 
 private:
+  struct PendingWorkItem
+  {
+    WorkItemPtr item;
+    std::chrono::steady_clock::time_point queue_time;
+  };
+
   void WorkerThreadEntryPoint(void* param);
   void WorkerThreadRun();
+  bool CanStartWorkItem(u32 priority) const;
 
   Common::Flag m_exit_flag;
   Common::Event m_init_event;
@@ -76,13 +110,23 @@ private:
 
   // A multimap is used to store the work items. We can't use a priority_queue here, because
   // there's no way to obtain a non-const reference, which we need for the unique_ptr.
-  std::multimap<u32, WorkItemPtr> m_pending_work;
+  std::multimap<u32, PendingWorkItem> m_pending_work;
   std::mutex m_pending_work_lock;
   std::condition_variable m_worker_thread_wake;
   std::atomic_size_t m_busy_workers{0};
 
+  // Guarded by m_pending_work_lock.
+  u32 m_background_priority = UINT32_MAX;
+  size_t m_max_background_workers = 0;
+  size_t m_busy_background_workers = 0;
+  bool m_waiting_for_completion = false;
+
   std::deque<WorkItemPtr> m_completed_work;
   std::mutex m_completed_work_lock;
+
+  // Latencies of the most recent work items, guarded by m_completed_work_lock.
+  std::array<u32, 256> m_latency_samples_us{};
+  size_t m_num_latency_samples = 0;
 };
 
 }  // namespace VideoCommon
@@ -53,6 +53,57 @@ void BPInit()
   bpmem.bpMask = 0xFFFFFF;
 }
 
+// These registers only configure EFB copies, clears, TLUT and TMEM preloads and the like. They are
+// read when the command that uses them is triggered, which flushes on its own, so they don't affect
+// the primitives that are already batched and writing them doesn't have to end the batch.
+static constexpr bool IsBatchNeutralRegister(u32 address)
+{
+  switch (address)
+  {
+  case BPMEM_DISPLAYCOPYFILTER:
+  case BPMEM_DISPLAYCOPYFILTER + 1:
+  case BPMEM_DISPLAYCOPYFILTER + 2:
+  case BPMEM_DISPLAYCOPYFILTER + 3:
+  case BPMEM_COPYFILTER0:
+  case BPMEM_COPYFILTER1:
+  case BPMEM_FIELDMASK:
+  case BPMEM_FIELDMODE:
+  case BPMEM_BUSCLOCK0:
+  case BPMEM_BUSCLOCK1:
+  case BPMEM_PERF0_TRI:
+  case BPMEM_PERF0_QUAD:
+  case BPMEM_PERF1:
+  case BPMEM_EFB_TL:
+  case BPMEM_EFB_WH:
+  case BPMEM_EFB_ADDR:
+  case BPMEM_MIPMAP_STRIDE:
+  case BPMEM_COPYYSCALE:
+  case BPMEM_CLEAR_AR:
+  case BPMEM_CLEAR_GB:
+  case BPMEM_CLEAR_Z:
+  case BPMEM_LOADTLUT0:
+  case BPMEM_PRELOAD_ADDR:
+  case BPMEM_PRELOAD_TMEMEVEN:
+  case BPMEM_PRELOAD_TMEMODD:
+  case BPMEM_BP_MASK:
+  case BPMEM_IND_IMASK:
+  case BPMEM_REVBITS:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// The TEV stage configuration, which games usually write in long runs of consecutive registers.
+// Outside of the shader UIDs, which are built from bpmem, it's only needed for the ubershader
+// constants, and those are updated once for the whole run when the next draw sets them.
+static constexpr bool IsTevStageRegister(u32 address)
+{
+  return (address >= BPMEM_TREF && address < BPMEM_TREF + 8) ||
+         (address >= BPMEM_TEV_COLOR_ENV && address < BPMEM_TEV_COLOR_ENV + 32) ||
+         (address >= BPMEM_TEV_KSEL && address < BPMEM_TEV_KSEL + 8);
+}
+
 static void BPWritten(const BPCmd& bp)
 {
   /*
@@ -85,14 +136,24 @@ static void BPWritten(const BPCmd& bp)
           bp.address == BPMEM_TEXINVALIDATE || bp.address == BPMEM_PRELOAD_MODE ||
           bp.address == BPMEM_CLEAR_PIXEL_PERF))
     {
+      INCSTAT(g_stats.this_frame.num_bp_flushes_avoided);
       return;
     }
   }
 
-  FlushPipeline();
+  if (IsBatchNeutralRegister(bp.address))
+    INCSTAT(g_stats.this_frame.num_bp_flushes_avoided);
+  else
+    FlushPipeline();
 
   ((u32*)&bpmem)[bp.address] = bp.newvalue;
 
+  if (IsTevStageRegister(bp.address))
+  {
+    PixelShaderManager::SetTevStagesChanged();
+    return;
+  }
+
   switch (bp.address)
   {
   case BPMEM_GENMODE:  // Set the Generation Mode
@@ -495,17 +556,6 @@ static void BPWritten(const BPCmd& bp)
     return;
   }
 
-  case BPMEM_TEV_KSEL:      // Texture Environment Swap Mode Table 0
-  case BPMEM_TEV_KSEL + 1:  // Texture Environment Swap Mode Table 1
-  case BPMEM_TEV_KSEL + 2:  // Texture Environment Swap Mode Table 2
-  case BPMEM_TEV_KSEL + 3:  // Texture Environment Swap Mode Table 3
-  case BPMEM_TEV_KSEL + 4:  // Texture Environment Swap Mode Table 4
-  case BPMEM_TEV_KSEL + 5:  // Texture Environment Swap Mode Table 5
-  case BPMEM_TEV_KSEL + 6:  // Texture Environment Swap Mode Table 6
-  case BPMEM_TEV_KSEL + 7:  // Texture Environment Swap Mode Table 7
-    PixelShaderManager::SetTevKSel(bp.address - BPMEM_TEV_KSEL, bp.newvalue);
-    return;
-
   /* This Register can be used to limit to which bits of BP registers is
    * actually written to. The mask is only valid for the next BP write,
    * and will reset itself afterwards. It's handled as a special case in
@@ -632,13 +682,6 @@ static void BPWritten(const BPCmd& bp)
 
   switch (bp.address & 0xFC)  // Texture sampler filter
   {
-  // -------------------------
-  // Texture Environment Order
-  // -------------------------
-  case BPMEM_TREF:
-  case BPMEM_TREF + 4:
-    PixelShaderManager::SetTevOrder(bp.address - BPMEM_TREF, bp.newvalue);
-    return;
   // ----------------------
   // Set wrap size
   // ----------------------
@@ -704,16 +747,6 @@ static void BPWritten(const BPCmd& bp)
   case BPMEM_IND_CMD:
     PixelShaderManager::SetTevIndirectChanged();
     return;
-  // --------------------------------------------------
-  // Set Color/Alpha of a Tev
-  // BPMEM_TEV_COLOR_ENV - Dest, Shift, Clamp, Sub, Bias, Sel A, Sel B, Sel C, Sel D
-  // BPMEM_TEV_ALPHA_ENV - Dest, Shift, Clamp, Sub, Bias, Sel A, Sel B, Sel C, Sel D, T Swap, R Swap
-  // --------------------------------------------------
-  case BPMEM_TEV_COLOR_ENV:  // Texture Environment 1
-  case BPMEM_TEV_COLOR_ENV + 16:
-    PixelShaderManager::SetTevCombiner((bp.address - BPMEM_TEV_COLOR_ENV) >> 1,
-                                       (bp.address - BPMEM_TEV_COLOR_ENV) & 1, bp.newvalue);
-    return;
   default:
     break;
   }
@@ -0,0 +1,184 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/DrawCapture.h"
+
+#include <fmt/format.h>
+#include <picojson.h>
+
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/RenderState.h"
+#include "VideoCommon/VertexLoaderBase.h"
+
+namespace VideoCommon
+{
+DrawCapture g_draw_capture;
+
+static const char* GetPrimitiveName(PrimitiveType primitive)
+{
+  switch (primitive)
+  {
+  case PrimitiveType::Points:
+    return "points";
+  case PrimitiveType::Lines:
+    return "lines";
+  case PrimitiveType::Triangles:
+    return "triangles";
+  case PrimitiveType::TriangleStrip:
+    return "triangle_strip";
+  }
+  return "unknown";
+}
+
+static const char* GetPipelineName(DrawPipeline pipeline)
+{
+  switch (pipeline)
+  {
+  case DrawPipeline::Specialized:
+    return "specialized";
+  case DrawPipeline::Ubershader:
+    return "ubershader";
+  case DrawPipeline::None:
+    break;
+  }
+  return "none";
+}
+
+void DrawCapture::OnFrameEnd(u64 frame_count)
+{
+  if (m_capturing)
+  {
+    m_capturing = false;
+
+    const std::string path =
+        fmt::format("{}Debug/draw_capture_{}", File::GetUserPath(D_DUMP_IDX), frame_count);
+    if (Write(path))
+    {
+      OSD::AddMessage(fmt::format("Captured {} draws to {}.json", m_draws.size(), path),
+                      OSD::Duration::NORMAL);
+    }
+    else
+    {
+      OSD::AddMessage(fmt::format("Failed to write the draw capture to {}.json", path),
+                      OSD::Duration::NORMAL, OSD::Color::RED);
+    }
+
+    m_draws = {};
+    m_loaders = {};
+    m_loader_indices = {};
+    return;
+  }
+
+  if (!m_requested.exchange(false, std::memory_order_relaxed))
+    return;
+
+  m_capturing = true;
+  m_pending_loaders.clear();
+}
+
+void DrawCapture::OnVerticesLoaded(const VertexLoaderBase* loader)
+{
+  const auto [iter, inserted] =
+      m_loader_indices.try_emplace(loader, static_cast<u32>(m_loaders.size()));
+  if (inserted)
+  {
+    m_loaders.push_back({loader->m_vertex_size, loader->m_native_components,
+                         loader->m_native_vtx_decl.stride});
+  }
+
+  if (m_pending_loaders.empty() || m_pending_loaders.back() != iter->second)
+    m_pending_loaders.push_back(iter->second);
+}
+
+void DrawCapture::BeginDraw(PrimitiveType primitive, u32 num_vertices, u32 num_indices)
+{
+  DrawRecord& draw = m_draws.emplace_back();
+  draw.primitive = primitive;
+  draw.num_vertices = num_vertices;
+  draw.num_indices = num_indices;
+  draw.loaders = std::move(m_pending_loaders);
+  m_pending_loaders.clear();
+}
+
+void DrawCapture::OnTextureLoaded(int uploads)
+{
+  DrawRecord& draw = m_draws.back();
+  if (uploads > 0)
+  {
+    draw.texture_misses++;
+    draw.texture_uploads += static_cast<u32>(uploads);
+  }
+  else
+  {
+    draw.texture_hits++;
+  }
+}
+
+void DrawCapture::SetDrawPipeline(bool is_uber)
+{
+  m_draws.back().pipeline = is_uber ? DrawPipeline::Ubershader : DrawPipeline::Specialized;
+}
+
+void DrawCapture::EndDraw(u64 flush_time_ns)
+{
+  m_draws.back().flush_time_ns = flush_time_ns;
+}
+
+// Writes the capture as <path>.json, and the draws as <path>.csv for spreadsheets.
+bool DrawCapture::Write(const std::string& path_without_extension) const
+{
+  picojson::array json_loaders;
+  for (const VertexLoaderRecord& loader : m_loaders)
+  {
+    picojson::object json_loader;
+    json_loader.emplace("vertex_size", static_cast<double>(loader.vertex_size));
+    json_loader.emplace("native_components", fmt::format("{:#x}", loader.native_components));
+    json_loader.emplace("native_stride", static_cast<double>(loader.native_stride));
+    json_loaders.emplace_back(std::move(json_loader));
+  }
+
+  std::string csv = "draw,primitive,vertices,indices,loaders,texture_hits,texture_misses,"
+                    "texture_uploads,pipeline,flush_time_ns\n";
+  picojson::array json_draws;
+  for (size_t i = 0; i < m_draws.size(); i++)
+  {
+    const DrawRecord& draw = m_draws[i];
+
+    picojson::array json_draw_loaders;
+    std::vector<std::string> loader_names;
+    for (const u32 loader : draw.loaders)
+    {
+      json_draw_loaders.emplace_back(static_cast<double>(loader));
+      loader_names.push_back(std::to_string(loader));
+    }
+
+    picojson::object json_draw;
+    json_draw.emplace("primitive", GetPrimitiveName(draw.primitive));
+    json_draw.emplace("vertices", static_cast<double>(draw.num_vertices));
+    json_draw.emplace("indices", static_cast<double>(draw.num_indices));
+    json_draw.emplace("loaders", std::move(json_draw_loaders));
+    json_draw.emplace("texture_hits", static_cast<double>(draw.texture_hits));
+    json_draw.emplace("texture_misses", static_cast<double>(draw.texture_misses));
+    json_draw.emplace("texture_uploads", static_cast<double>(draw.texture_uploads));
+    json_draw.emplace("pipeline", GetPipelineName(draw.pipeline));
+    json_draw.emplace("flush_time_ns", static_cast<double>(draw.flush_time_ns));
+    json_draws.emplace_back(std::move(json_draw));
+
+    csv += fmt::format("{},{},{},{},{},{},{},{},{},{}\n", i, GetPrimitiveName(draw.primitive),
+                       draw.num_vertices, draw.num_indices, JoinStrings(loader_names, ";"),
+                       draw.texture_hits, draw.texture_misses, draw.texture_uploads,
+                       GetPipelineName(draw.pipeline), draw.flush_time_ns);
+  }
+
+  picojson::object root;
+  root.emplace("vertex_loaders", std::move(json_loaders));
+  root.emplace("draws", std::move(json_draws));
+
+  const std::string json_path = path_without_extension + ".json";
+  File::CreateFullPath(json_path);
+  return File::WriteStringToFile(json_path, picojson::value(std::move(root)).serialize(true)) &&
+         File::WriteStringToFile(path_without_extension + ".csv", csv);
+}
+}  // namespace VideoCommon
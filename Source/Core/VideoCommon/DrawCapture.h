@@ -0,0 +1,116 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class VertexLoaderBase;
+enum class PrimitiveType : u32;
+
+namespace VideoCommon
+{
+enum class DrawPipeline
+{
+  // Nothing was drawn, e.g. because the vertices were culled or the pipeline is still compiling.
+  None,
+  Specialized,
+  Ubershader,
+};
+
+// What happened during one flush of the vertex manager.
+struct DrawRecord
+{
+  PrimitiveType primitive{};
+  u32 num_vertices = 0;
+  u32 num_indices = 0;
+  // Indices into DrawCapture::GetLoaders of the loaders which loaded the vertices, usually one.
+  std::vector<u32> loaders;
+  u32 texture_hits = 0;
+  u32 texture_misses = 0;
+  u32 texture_uploads = 0;
+  DrawPipeline pipeline = DrawPipeline::None;
+  // CPU time spent in VertexManagerBase::Flush.
+  u64 flush_time_ns = 0;
+};
+
+struct VertexLoaderRecord
+{
+  u32 vertex_size = 0;
+  u32 native_components = 0;
+  u32 native_stride = 0;
+};
+
+// Records every draw of a single frame, so that the cost of a frame can be attributed to its
+// draws. A capture can be requested from any thread. Everything else is called on the video
+// thread, and only does work while a frame is being captured.
+class DrawCapture
+{
+public:
+  // The capture starts at the next frame boundary and is written when that frame ends.
+  void Request() { m_requested.store(true, std::memory_order_relaxed); }
+
+  bool IsCapturing() const { return m_capturing; }
+
+  // Called by the renderer at the end of each new frame.
+  void OnFrameEnd(u64 frame_count);
+
+  void OnVerticesLoaded(const VertexLoaderBase* loader);
+  void BeginDraw(PrimitiveType primitive, u32 num_vertices, u32 num_indices);
+  // uploads is the number of textures uploaded while loading the texture, zero on a cache hit.
+  void OnTextureLoaded(int uploads);
+  void SetDrawPipeline(bool is_uber);
+  void EndDraw(u64 flush_time_ns);
+
+private:
+  bool Write(const std::string& path_without_extension) const;
+
+  std::atomic<bool> m_requested{false};
+  bool m_capturing = false;
+
+  std::vector<DrawRecord> m_draws;
+  std::vector<VertexLoaderRecord> m_loaders;
+  std::map<const VertexLoaderBase*, u32> m_loader_indices;
+  // Loaders which were used since the last draw.
+  std::vector<u32> m_pending_loaders;
+};
+
+extern DrawCapture g_draw_capture;
+
+// Records the flush of the vertex manager it lives in while a frame is being captured.
+class DrawCaptureScope
+{
+public:
+  DrawCaptureScope(PrimitiveType primitive, u32 num_vertices, u32 num_indices)
+      : m_active(g_draw_capture.IsCapturing())
+  {
+    if (!m_active)
+      return;
+
+    g_draw_capture.BeginDraw(primitive, num_vertices, num_indices);
+    m_start = std::chrono::steady_clock::now();
+  }
+
+  ~DrawCaptureScope()
+  {
+    if (!m_active)
+      return;
+
+    const auto elapsed = std::chrono::steady_clock::now() - m_start;
+    g_draw_capture.EndDraw(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  }
+
+  DrawCaptureScope(const DrawCaptureScope&) = delete;
+  DrawCaptureScope& operator=(const DrawCaptureScope&) = delete;
+
+private:
+  bool m_active;
+  std::chrono::steady_clock::time_point m_start;
+};
+}  // namespace VideoCommon
@@ -4,6 +4,7 @@
 #include "VideoCommon/DriverDetails.h"
 
 #include <map>
+#include <set>
 
 #include "Common/Logging/LogManager.h"
 
@@ -22,6 +23,18 @@ struct BugInfo
   bool m_hasbug;          // Does it have it?
 };
 
+struct PreferenceInfo
+{
+  API m_api;                // Which API it applies to
+  u32 m_os;                 // Which OS it applies to
+  Vendor m_vendor;          // Which vendor it applies to
+  Driver m_driver;          // Which driver it applies to
+  Family m_family;          // Which family of hardware it applies to
+  Preference m_preference;  // Which preference it is
+  double m_versionstart;    // When it started
+  double m_versionend;      // When it ended
+};
+
 // Local members
 #ifdef _WIN32
 constexpr u32 m_os = OS_ALL | OS_WINDOWS;
@@ -160,7 +173,27 @@ constexpr BugInfo m_known_bugs[] = {
      BUG_SLOW_OPTIMAL_IMAGE_TO_BUFFER_COPY, -1.0, -1.0, true},
 };
 
+// This is a list of the code paths which are known to be faster on some drivers
+constexpr PreferenceInfo m_known_preferences[] = {
+    {API_VULKAN, OS_ALL, VENDOR_ARM, DRIVER_ARM, Family::UNKNOWN, PREFER_STATIC_SAMPLER_INDEXING,
+     -1.0, -1.0},
+    {API_OPENGL, OS_ALL, VENDOR_ARM, DRIVER_ARM, Family::UNKNOWN, PREFER_STATIC_SAMPLER_INDEXING,
+     -1.0, -1.0},
+};
+
 static std::map<Bug, BugInfo> m_bugs;
+static std::set<Preference> m_preferences;
+
+template <typename Info>
+static bool AppliesToDriver(const Info& info)
+{
+  return (info.m_api & m_api) && (info.m_os & m_os) &&
+         (info.m_vendor == m_vendor || info.m_vendor == VENDOR_ALL) &&
+         (info.m_driver == m_driver || info.m_driver == DRIVER_ALL) &&
+         (info.m_family == m_family || info.m_family == Family::UNKNOWN) &&
+         (info.m_versionstart <= m_version || info.m_versionstart == -1) &&
+         (info.m_versionend > m_version || info.m_versionend == -1);
+}
 
 void Init(API api, Vendor vendor, Driver driver, const double version, const Family family)
 {
@@ -195,20 +228,20 @@ void Init(API api, Vendor vendor, Driver driver, const double version, const Fam
     }
   }
 
-  // Clear bug list, as the API may have changed
+  // Clear bug and preference lists, as the API may have changed
   m_bugs.clear();
+  m_preferences.clear();
 
   for (const auto& bug : m_known_bugs)
   {
-    if ((bug.m_api & api) && (bug.m_os & m_os) &&
-        (bug.m_vendor == m_vendor || bug.m_vendor == VENDOR_ALL) &&
-        (bug.m_driver == m_driver || bug.m_driver == DRIVER_ALL) &&
-        (bug.m_family == m_family || bug.m_family == Family::UNKNOWN) &&
-        (bug.m_versionstart <= m_version || bug.m_versionstart == -1) &&
-        (bug.m_versionend > m_version || bug.m_versionend == -1))
-    {
+    if (AppliesToDriver(bug))
       m_bugs.emplace(bug.m_bug, bug);
-    }
+  }
+
+  for (const auto& preference : m_known_preferences)
+  {
+    if (AppliesToDriver(preference))
+      m_preferences.insert(preference.m_preference);
   }
 }
 
@@ -219,4 +252,9 @@ bool HasBug(Bug bug)
     return false;
   return it->second.m_hasbug;
 }
+
+bool HasPreference(Preference preference)
+{
+  return m_preferences.count(preference) != 0;
+}
 }  // namespace DriverDetails
@@ -343,10 +343,28 @@ enum Bug
   BUG_SLOW_OPTIMAL_IMAGE_TO_BUFFER_COPY
 };
 
+// Enum of known performance preferences
+// Unlike bugs, these only choose between code paths which all work on the driver, so getting one
+// wrong costs speed rather than correctness.
+enum Preference
+{
+  // PREFERENCE: Avoid dynamic sampler indexing in ubershaders
+  // Indexing the sampler array with a non-uniform value is slow on Mali, so the ubershaders select
+  // the sampler with a switch instead, like on backends which don't support dynamic indexing.
+  // Affected devices: ARM Mali
+  // Started version: -1
+  // Ended version: -1
+  PREFER_STATIC_SAMPLER_INDEXING,
+};
+
 // Initializes our internal vendor, device family, and driver version
 void Init(API api, Vendor vendor, Driver driver, const double version, const Family family);
 
 // Once Vendor and driver version is set, this will return if it has the applicable bug passed to
 // it.
 bool HasBug(Bug bug);
+
+// Returns if the driver prefers the code path of the preference passed to it. Only valid after
+// Init, like HasBug.
+bool HasPreference(Preference preference);
 }  // namespace DriverDetails
@@ -0,0 +1,110 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/DynamicResolution.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+static std::atomic<float> s_thermal_headroom = std::numeric_limits<float>::quiet_NaN();
+
+void DynamicResolution::SetThermalHeadroom(float headroom)
+{
+  s_thermal_headroom.store(headroom, std::memory_order_relaxed);
+}
+
+float DynamicResolution::GetThermalHeadroom()
+{
+  return s_thermal_headroom.load(std::memory_order_relaxed);
+}
+
+void DynamicResolution::SetMinimumScale(u32 percent)
+{
+  m_min_scale_factor = std::clamp(percent, 10u, 100u) / 100.0;
+  m_scale_factor = std::max(m_scale_factor, m_min_scale_factor);
+}
+
+bool DynamicResolution::Update(u64 gpu_time_ns, u64 frame_budget_ns)
+{
+  if (gpu_time_ns == 0 || frame_budget_ns == 0)
+    return false;
+
+  // Smooth out single slow frames, which are often shader compiles or texture loads.
+  if (m_average_gpu_time == 0.0)
+    m_average_gpu_time = static_cast<double>(gpu_time_ns);
+  else
+    m_average_gpu_time = m_average_gpu_time * 0.8 + gpu_time_ns * 0.2;
+
+  if (m_cooldown > 0)
+  {
+    m_cooldown--;
+    return false;
+  }
+
+  const double load = m_average_gpu_time / frame_budget_ns;
+  if (load > HIGH_LOAD)
+  {
+    m_frames_over++;
+    m_frames_under = 0;
+  }
+  else if (load < LOW_LOAD)
+  {
+    m_frames_under++;
+    m_frames_over = 0;
+  }
+  else
+  {
+    m_frames_over = 0;
+    m_frames_under = 0;
+  }
+
+  if (m_frames_over < FRAMES_BEFORE_DECREASE && m_frames_under < FRAMES_BEFORE_INCREASE)
+    return false;
+
+  // GPU time is mostly proportional to the number of pixels, so to the square of the scale.
+  double new_factor = m_scale_factor * std::sqrt(TARGET_LOAD / load);
+  new_factor = std::min(new_factor, m_scale_factor * MAX_INCREASE);
+  new_factor = std::clamp(new_factor, m_min_scale_factor, 1.0);
+
+  m_frames_over = 0;
+  m_frames_under = 0;
+  if (std::abs(new_factor - m_scale_factor) < 0.01)
+    return false;
+
+  m_scale_factor = new_factor;
+  m_average_gpu_time = 0.0;
+  m_cooldown = COOLDOWN_FRAMES;
+  return true;
+}
+
+void DynamicResolution::UpdateThermalLimit(float headroom)
+{
+  if (std::isnan(headroom))
+  {
+    m_thermal_limit = 1.0;
+    return;
+  }
+
+  const double load =
+      std::clamp((headroom - THERMAL_HEADROOM_START) / (1.0 - THERMAL_HEADROOM_START), 0.0, 1.0);
+  const double limit = 1.0 - load * (1.0 - m_min_scale_factor);
+  if (limit < m_thermal_limit || limit >= m_thermal_limit + THERMAL_RAISE_STEP || limit == 1.0)
+    m_thermal_limit = limit;
+}
+
+void DynamicResolution::Reset()
+{
+  m_scale_factor = 1.0;
+  m_average_gpu_time = 0.0;
+  m_frames_over = 0;
+  m_frames_under = 0;
+  m_cooldown = 0;
+}
+
+u32 DynamicResolution::Apply(u32 efb_scale) const
+{
+  const u32 scaled = static_cast<u32>(efb_scale * GetScaleFactor() / 5.0) * 5;
+  return std::clamp(scaled, std::min(efb_scale, 5u), efb_scale);
+}
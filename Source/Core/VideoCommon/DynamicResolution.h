@@ -0,0 +1,71 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+
+#include "Common/CommonTypes.h"
+
+// Picks a fraction of the configured internal resolution to render at, based on how much GPU time
+// recent frames took compared to the frame budget. The resolution drops quickly when frames go
+// over budget, and only grows back after a sustained period with plenty of headroom. Every change
+// is followed by a cooldown, as it takes a few frames for the GPU times at the new resolution to
+// be read back, and resizing the EFB isn't free either.
+//
+// Independently of that, the fraction can be capped based on how close the device is to thermal
+// throttling, so that the load is reduced before the device slows itself down.
+class DynamicResolution
+{
+public:
+  // Reports how close the device is to thermal throttling, where 0 means no thermal load and 1
+  // means throttling is about to start. NaN if unknown. Can be called from any thread.
+  static void SetThermalHeadroom(float headroom);
+  static float GetThermalHeadroom();
+
+  // Sets the lowest fraction of the configured resolution which may be used, in percent.
+  void SetMinimumScale(u32 percent);
+
+  // Feeds the GPU time of a frame. Returns true if the scale changed.
+  bool Update(u64 gpu_time_ns, u64 frame_budget_ns);
+
+  // Recomputes the thermal cap from a headroom as passed to SetThermalHeadroom.
+  // A NaN headroom removes the cap.
+  void UpdateThermalLimit(float headroom);
+
+  // Goes back to the full configured resolution, apart from the thermal cap.
+  void Reset();
+
+  // Scales an internal resolution (in percent of native) by the current fraction, in steps of 5%.
+  u32 Apply(u32 efb_scale) const;
+
+  double GetScaleFactor() const { return std::min(m_scale_factor, m_thermal_limit); }
+  bool IsThermallyLimited() const { return m_thermal_limit < m_scale_factor; }
+
+private:
+  // Fraction of the frame budget the GPU time is steered towards, and the band around it where
+  // the resolution is left alone.
+  static constexpr double TARGET_LOAD = 0.85;
+  static constexpr double HIGH_LOAD = 0.95;
+  static constexpr double LOW_LOAD = 0.7;
+
+  static constexpr u32 FRAMES_BEFORE_DECREASE = 4;
+  static constexpr u32 FRAMES_BEFORE_INCREASE = 60;
+  static constexpr u32 COOLDOWN_FRAMES = 15;
+  static constexpr double MAX_INCREASE = 1.1;
+
+  // Headroom at which the thermal cap starts going down, reaching the minimum scale at 1.
+  static constexpr float THERMAL_HEADROOM_START = 0.75f;
+  // The cap is lowered right away, but only raised again in steps this large, so that a headroom
+  // hovering around a value doesn't resize the EFB every time it is read.
+  static constexpr double THERMAL_RAISE_STEP = 0.1;
+
+  double m_scale_factor = 1.0;
+  double m_min_scale_factor = 0.5;
+  double m_thermal_limit = 1.0;
+
+  double m_average_gpu_time = 0.0;
+  u32 m_frames_over = 0;
+  u32 m_frames_under = 0;
+  u32 m_cooldown = 0;
+};
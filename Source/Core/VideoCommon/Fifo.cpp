@@ -3,7 +3,9 @@
 
 #include "VideoCommon/Fifo.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 
 #include "Common/Assert.h"
@@ -70,6 +72,13 @@ static u8* s_video_buffer_pp_read_ptr;
 // polls, it's just atomic.
 // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
 
+// How many bytes have to be available from the read_ptr (or the pp_read_ptr) on before the opcode
+// decoder can make progress. Large primitives span many gather pipe bursts, and without this their
+// header would be decoded again every time another burst arrives. These aren't saved, since 0 is
+// always safe.
+static u32 s_video_buffer_needed;
+static u32 s_video_buffer_pp_needed;
+
 static std::atomic<int> s_sync_ticks;
 static bool s_syncing_suspended;
 static Common::Event s_sync_wakeup_event;
@@ -79,6 +88,42 @@ static bool s_config_sync_gpu = false;
 static int s_config_sync_gpu_max_distance = 0;
 static int s_config_sync_gpu_min_distance = 0;
 static float s_config_sync_gpu_overclock = 0.0f;
+static bool s_config_sync_gpu_adaptive = false;
+
+// How far the CPU may run ahead of the GPU thread before it has to wait. This is the configured
+// max distance, unless adaptive sync is enabled, in which case the CPU thread retunes it once per
+// control period. The GPU thread only reads it.
+static std::atomic<int> s_sync_max_distance;
+
+// Roughly one emulated frame.
+static constexpr int SYNC_CONTROL_PERIOD = 8000000;
+
+struct AdaptiveSyncState
+{
+  int period_ticks = 0;
+  u32 checks = 0;
+  u32 idle_checks = 0;
+  u32 waits = 0;
+  std::chrono::steady_clock::duration wait_time{};
+  std::chrono::steady_clock::time_point period_start{};
+};
+// Only accessed by the CPU thread.
+static AdaptiveSyncState s_adaptive_sync;
+
+// Results of the last control period, for the statistics overlay.
+static std::atomic<u32> s_sync_stat_waits;
+static std::atomic<u32> s_sync_stat_wait_percent;
+static std::atomic<u32> s_sync_stat_idle_percent;
+
+static void ResetAdaptiveSync()
+{
+  s_sync_max_distance.store(s_config_sync_gpu_max_distance, std::memory_order_relaxed);
+  s_adaptive_sync = {};
+  s_adaptive_sync.period_start = std::chrono::steady_clock::now();
+  s_sync_stat_waits.store(0, std::memory_order_relaxed);
+  s_sync_stat_wait_percent.store(0, std::memory_order_relaxed);
+  s_sync_stat_idle_percent.store(0, std::memory_order_relaxed);
+}
 
 static void RefreshConfig()
 {
@@ -86,6 +131,8 @@ static void RefreshConfig()
   s_config_sync_gpu_max_distance = Config::Get(Config::MAIN_SYNC_GPU_MAX_DISTANCE);
   s_config_sync_gpu_min_distance = Config::Get(Config::MAIN_SYNC_GPU_MIN_DISTANCE);
   s_config_sync_gpu_overclock = Config::Get(Config::MAIN_SYNC_GPU_OVERCLOCK);
+  s_config_sync_gpu_adaptive = Config::Get(Config::MAIN_SYNC_GPU_ADAPTIVE);
+  s_sync_max_distance.store(s_config_sync_gpu_max_distance, std::memory_order_relaxed);
 }
 
 void DoState(PointerWrap& p)
@@ -95,6 +142,11 @@ void DoState(PointerWrap& p)
   p.DoPointer(write_ptr, s_video_buffer);
   s_video_buffer_write_ptr = write_ptr;
   p.DoPointer(s_video_buffer_read_ptr, s_video_buffer);
+  if (p.IsReadMode())
+  {
+    s_video_buffer_needed = 0;
+    s_video_buffer_pp_needed = 0;
+  }
   if (p.IsReadMode() && s_use_deterministic_gpu_thread)
   {
     // We're good and paused, right?
@@ -136,6 +188,7 @@ void Init()
   if (Core::System::GetInstance().IsDualCoreMode())
     s_gpu_mainloop.Prepare();
   s_sync_ticks.store(0);
+  ResetAdaptiveSync();
 }
 
 void Shutdown()
@@ -300,8 +353,12 @@ static void ReadDataFromFifoOnCPU(u32 readPtr)
     }
   }
   Memory::CopyFromEmu(s_video_buffer_write_ptr, readPtr, GPFifo::GATHER_PIPE_SIZE);
-  s_video_buffer_pp_read_ptr = OpcodeDecoder::RunFifo<true>(
-      DataReader(s_video_buffer_pp_read_ptr, write_ptr + GPFifo::GATHER_PIPE_SIZE), nullptr);
+  u8* const end_ptr = write_ptr + GPFifo::GATHER_PIPE_SIZE;
+  if (static_cast<size_t>(end_ptr - s_video_buffer_pp_read_ptr) >= s_video_buffer_pp_needed)
+  {
+    s_video_buffer_pp_read_ptr = OpcodeDecoder::RunFifo<true>(
+        DataReader(s_video_buffer_pp_read_ptr, end_ptr), nullptr, &s_video_buffer_pp_needed);
+  }
   // This would have to be locked if the GPU thread didn't spin.
   s_video_buffer_write_ptr = write_ptr + GPFifo::GATHER_PIPE_SIZE;
 }
@@ -312,6 +369,8 @@ void ResetVideoBuffer()
   s_video_buffer_write_ptr = s_video_buffer;
   s_video_buffer_seen_ptr = s_video_buffer;
   s_video_buffer_pp_read_ptr = s_video_buffer;
+  s_video_buffer_needed = 0;
+  s_video_buffer_pp_needed = 0;
   s_fifo_aux_write_ptr = s_fifo_aux_data;
   s_fifo_aux_read_ptr = s_fifo_aux_data;
 }
@@ -376,8 +435,12 @@ void RunGpuLoop()
                        distance);
 
             u8* write_ptr = s_video_buffer_write_ptr;
-            s_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
-                DataReader(s_video_buffer_read_ptr, write_ptr), &cyclesExecuted);
+            if (static_cast<size_t>(write_ptr - s_video_buffer_read_ptr) >= s_video_buffer_needed)
+            {
+              s_video_buffer_read_ptr =
+                  OpcodeDecoder::RunFifo(DataReader(s_video_buffer_read_ptr, write_ptr),
+                                         &cyclesExecuted, &s_video_buffer_needed);
+            }
 
             fifo.CPReadPointer.store(readPtr, std::memory_order_relaxed);
             fifo.CPReadWriteDistance.fetch_sub(GPFifo::GATHER_PIPE_SIZE, std::memory_order_seq_cst);
@@ -393,8 +456,8 @@ void RunGpuLoop()
             {
               cyclesExecuted = (int)(cyclesExecuted / s_config_sync_gpu_overclock);
               int old = s_sync_ticks.fetch_sub(cyclesExecuted);
-              if (old >= s_config_sync_gpu_max_distance &&
-                  old - (int)cyclesExecuted < s_config_sync_gpu_max_distance)
+              const int max_distance = s_sync_max_distance.load(std::memory_order_relaxed);
+              if (old >= max_distance && old - (int)cyclesExecuted < max_distance)
                 s_sync_wakeup_event.Set();
             }
 
@@ -409,7 +472,7 @@ void RunGpuLoop()
           if (s_sync_ticks.load() > 0)
           {
             int old = s_sync_ticks.exchange(0);
-            if (old >= s_config_sync_gpu_max_distance)
+            if (old >= s_sync_max_distance.load(std::memory_order_relaxed))
               s_sync_wakeup_event.Set();
           }
 
@@ -467,6 +530,20 @@ void RunGpu()
   }
 }
 
+static u64 s_memory_epoch = 0;
+static u64 s_last_memory_epoch = 0;
+
+u64 GetMemoryEpoch()
+{
+  return s_memory_epoch;
+}
+
+void OnGPUMemoryWrite()
+{
+  if (s_memory_epoch != 0)
+    s_memory_epoch = ++s_last_memory_epoch;
+}
+
 static int RunGpuOnCpu(int ticks)
 {
   CommandProcessor::SCPFifoStruct& fifo = CommandProcessor::fifo;
@@ -488,11 +565,17 @@ static int RunGpuOnCpu(int ticks)
         FPURoundMode::SaveSIMDState();
         FPURoundMode::LoadDefaultSIMDState();
         reset_simd_state = true;
+        // The CPU doesn't run until this returns.
+        s_memory_epoch = ++s_last_memory_epoch;
       }
       ReadDataFromFifo(fifo.CPReadPointer.load(std::memory_order_relaxed));
       u32 cycles = 0;
-      s_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
-          DataReader(s_video_buffer_read_ptr, s_video_buffer_write_ptr), &cycles);
+      u8* write_ptr = s_video_buffer_write_ptr;
+      if (static_cast<size_t>(write_ptr - s_video_buffer_read_ptr) >= s_video_buffer_needed)
+      {
+        s_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
+            DataReader(s_video_buffer_read_ptr, write_ptr), &cycles, &s_video_buffer_needed);
+      }
       available_ticks -= cycles;
     }
 
@@ -515,6 +598,7 @@ static int RunGpuOnCpu(int ticks)
   if (reset_simd_state)
   {
     FPURoundMode::LoadSIMDState();
+    s_memory_epoch = 0;
   }
 
   // Discard all available ticks as there is nothing to do any more.
@@ -555,6 +639,7 @@ void UpdateWantDeterminism(bool want)
     {
       // These haven't been updated in non-deterministic mode.
       s_video_buffer_seen_ptr = s_video_buffer_pp_read_ptr = s_video_buffer_read_ptr;
+      s_video_buffer_pp_needed = 0;
       CopyPreprocessCPStateFromMain();
       VertexLoaderManager::MarkAllDirty();
     }
@@ -571,13 +656,58 @@ bool UseDeterministicGPUThread()
  * @ticks The gone emulated CPU time.
  * @return A good time to call WaitForGpuThread() next.
  */
+/* Retunes the max distance from how the last control period went. If the CPU spent a noticeable
+ * amount of time blocked on the GPU thread, the threads are allowed to drift further apart. If it
+ * hardly ever blocked and the GPU thread was idle most of the time, the distance is tightened
+ * again, which keeps the emulated CPU and GPU closer together. The result always stays within
+ * the configured min and max distance.
+ */
+static int UpdateSyncDistance(int ticks, bool gpu_idle)
+{
+  AdaptiveSyncState& state = s_adaptive_sync;
+  int distance = s_sync_max_distance.load(std::memory_order_relaxed);
+  state.checks++;
+  if (gpu_idle)
+    state.idle_checks++;
+
+  state.period_ticks += ticks;
+  if (state.period_ticks < SYNC_CONTROL_PERIOD)
+    return distance;
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto elapsed = std::max(now - state.period_start, std::chrono::steady_clock::duration(1));
+  const u32 wait_percent = static_cast<u32>(std::min<s64>(100 * state.wait_time / elapsed, 100));
+  const u32 idle_percent = 100 * state.idle_checks / state.checks;
+
+  const int upper = s_config_sync_gpu_max_distance;
+  const int lower =
+      std::min(upper, std::max(s_config_sync_gpu_min_distance, 0) + GPU_TIME_SLOT_SIZE);
+  if (wait_percent >= 5)
+    distance += distance / 4 + GPU_TIME_SLOT_SIZE;
+  else if (wait_percent == 0 && idle_percent >= 50)
+    distance -= distance / 8;
+  distance = std::clamp(distance, lower, upper);
+  s_sync_max_distance.store(distance, std::memory_order_relaxed);
+
+  s_sync_stat_waits.store(state.waits, std::memory_order_relaxed);
+  s_sync_stat_wait_percent.store(wait_percent, std::memory_order_relaxed);
+  s_sync_stat_idle_percent.store(idle_percent, std::memory_order_relaxed);
+  state = {};
+  state.period_start = now;
+  return distance;
+}
+
 static int WaitForGpuThread(int ticks)
 {
   int old = s_sync_ticks.fetch_add(ticks);
   int now = old + ticks;
+  const bool gpu_idle = old >= 0 && s_gpu_mainloop.IsDone();
+  const int max_distance = s_config_sync_gpu_adaptive ?
+                               UpdateSyncDistance(ticks, gpu_idle) :
+                               s_config_sync_gpu_max_distance;
 
   // GPU is idle, so stop polling.
-  if (old >= 0 && s_gpu_mainloop.IsDone())
+  if (gpu_idle)
     return -1;
 
   // Wakeup GPU
@@ -589,12 +719,37 @@ static int WaitForGpuThread(int ticks)
     return GPU_TIME_SLOT_SIZE + s_config_sync_gpu_min_distance - now;
 
   // Wait for GPU
-  if (now >= s_config_sync_gpu_max_distance)
-    s_sync_wakeup_event.Wait();
+  if (now >= max_distance)
+  {
+    if (s_config_sync_gpu_adaptive)
+    {
+      const auto wait_start = std::chrono::steady_clock::now();
+      s_sync_wakeup_event.Wait();
+      s_adaptive_sync.wait_time += std::chrono::steady_clock::now() - wait_start;
+      s_adaptive_sync.waits++;
+    }
+    else
+    {
+      s_sync_wakeup_event.Wait();
+    }
+  }
 
   return GPU_TIME_SLOT_SIZE;
 }
 
+SyncGPUStats GetSyncGPUStats()
+{
+  SyncGPUStats stats;
+  stats.enabled = s_config_sync_gpu && Core::System::GetInstance().IsDualCoreMode() &&
+                  !s_use_deterministic_gpu_thread;
+  stats.adaptive = s_config_sync_gpu_adaptive;
+  stats.max_distance = s_sync_max_distance.load(std::memory_order_relaxed);
+  stats.waits = s_sync_stat_waits.load(std::memory_order_relaxed);
+  stats.wait_percent = s_sync_stat_wait_percent.load(std::memory_order_relaxed);
+  stats.idle_percent = s_sync_stat_idle_percent.load(std::memory_order_relaxed);
+  return stats;
+}
+
 static void SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLate)
 {
   ticks += cyclesLate;
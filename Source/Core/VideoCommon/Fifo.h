@@ -36,6 +36,25 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr = true);
 // In dual core mode, this synchronizes with the GPU thread.
 void SyncGPUForRegisterAccess();
 
+// Used for diagnostics. The counters cover the last adaptive sync control period.
+struct SyncGPUStats
+{
+  bool enabled = false;
+  bool adaptive = false;
+  int max_distance = 0;
+  u32 waits = 0;
+  u32 wait_percent = 0;
+  u32 idle_percent = 0;
+};
+SyncGPUStats GetSyncGPUStats();
+
+// While the GPU runs on the CPU thread, guest memory can only change between GPU time slices or
+// through the GPU's own writes. Returns an ID for the current stretch of time in which memory
+// doesn't change, or 0 if the CPU may be writing to memory at the same time.
+u64 GetMemoryEpoch();
+// Must be called before the GPU writes to guest memory, such as for EFB copies.
+void OnGPUMemoryWrite();
+
 void PushFifoAuxBuffer(const void* ptr, size_t size);
 void* PopFifoAuxBuffer(size_t size);
 
@@ -18,6 +18,7 @@ extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/error.h>
+#include <libavutil/hwcontext.h>
 #include <libavutil/log.h>
 #include <libavutil/mathematics.h>
 #include <libavutil/opt.h>
@@ -47,6 +48,8 @@ struct FrameDumpContext
   AVCodecContext* codec = nullptr;
   AVFrame* src_frame = nullptr;
   AVFrame* scaled_frame = nullptr;
+  // Frame in GPU memory the scaled frame is uploaded to, for encoders that only take those.
+  AVFrame* hw_frame = nullptr;
   SwsContext* sws = nullptr;
 
   s64 last_pts = AV_NOPTS_VALUE;
@@ -155,6 +158,182 @@ std::string AVErrorString(int error)
   return fmt::format("{:8x} {}", (u32)error, &msg[0]);
 }
 
+void SetCommonCodecParameters(AVCodecContext* codec, int width, int height, AVRational time_base,
+                              const AVOutputFormat* output_format)
+{
+  codec->codec_type = AVMEDIA_TYPE_VIDEO;
+  codec->bit_rate = static_cast<int64_t>(g_Config.iBitrateKbps) * 1000;
+  codec->width = width;
+  codec->height = height;
+  codec->time_base = time_base;
+  codec->gop_size = 1;
+
+  if (output_format->flags & AVFMT_GLOBALHEADER)
+    codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+}
+
+// Returns the encoder's preferred pixel format for frames in system memory, if it takes any.
+AVPixelFormat GetSoftwarePixelFormat(const AVCodec* codec)
+{
+  if (!codec->pix_fmts)
+    return AV_PIX_FMT_NONE;
+
+  for (const AVPixelFormat* format = codec->pix_fmts; *format != AV_PIX_FMT_NONE; ++format)
+  {
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(*format);
+    if (desc && !(desc->flags & AV_PIX_FMT_FLAG_HWACCEL))
+      return *format;
+  }
+
+  return AV_PIX_FMT_NONE;
+}
+
+// Gives the codec a pool of frames in GPU memory to encode from, for encoders like VAAPI that
+// can't take frames from system memory.
+bool CreateHardwareFrames(const AVCodec* codec, AVCodecContext* codec_context)
+{
+  for (int i = 0;; i++)
+  {
+    const AVCodecHWConfig* config = avcodec_get_hw_config(codec, i);
+    if (!config)
+      return false;
+
+    if (!(config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_FRAMES_CTX))
+      continue;
+
+    AVBufferRef* device = nullptr;
+    if (av_hwdevice_ctx_create(&device, config->device_type, nullptr, nullptr, 0) < 0)
+      continue;
+
+    // The frames context keeps its own reference to the device.
+    AVBufferRef* frames = av_hwframe_ctx_alloc(device);
+    av_buffer_unref(&device);
+    if (!frames)
+      continue;
+
+    auto* const frames_context = reinterpret_cast<AVHWFramesContext*>(frames->data);
+    frames_context->format = config->pix_fmt;
+    frames_context->sw_format = AV_PIX_FMT_NV12;
+    frames_context->width = codec_context->width;
+    frames_context->height = codec_context->height;
+    frames_context->initial_pool_size = 20;
+    if (av_hwframe_ctx_init(frames) < 0)
+    {
+      av_buffer_unref(&frames);
+      continue;
+    }
+
+    codec_context->pix_fmt = config->pix_fmt;
+    codec_context->hw_frames_ctx = frames;
+    return true;
+  }
+}
+
+// Opens the first hardware encoder for codec_id that works on this system, e.g. NVENC, VAAPI or
+// MediaCodec. Returns nullptr if there are none, so software encoding can be used instead.
+const AVCodec* OpenHardwareEncoder(FrameDumpContext* context, AVCodecID codec_id,
+                                   const AVOutputFormat* output_format, AVRational time_base)
+{
+  void* iter = nullptr;
+  while (const AVCodec* codec = av_codec_iterate(&iter))
+  {
+    if (codec->id != codec_id || !av_codec_is_encoder(codec) ||
+        !(codec->capabilities & AV_CODEC_CAP_HARDWARE))
+    {
+      continue;
+    }
+
+    AVCodecContext* codec_context = avcodec_alloc_context3(codec);
+    if (!codec_context)
+      continue;
+
+    SetCommonCodecParameters(codec_context, context->width, context->height, time_base,
+                             output_format);
+
+    codec_context->pix_fmt = GetSoftwarePixelFormat(codec);
+    if ((codec_context->pix_fmt != AV_PIX_FMT_NONE ||
+         CreateHardwareFrames(codec, codec_context)) &&
+        avcodec_open2(codec_context, codec, nullptr) >= 0)
+    {
+      INFO_LOG_FMT(FRAMEDUMP, "Using hardware encoder {}", codec->name);
+      context->codec = codec_context;
+      return codec;
+    }
+
+    WARN_LOG_FMT(FRAMEDUMP, "Could not open hardware encoder {}", codec->name);
+    avcodec_free_context(&codec_context);
+  }
+
+  WARN_LOG_FMT(FRAMEDUMP, "No hardware encoder available, using software encoding");
+  return nullptr;
+}
+
+// Opens the configured encoder, or the default one for codec_id.
+bool OpenSoftwareEncoder(FrameDumpContext* context, AVCodecID codec_id,
+                         const AVOutputFormat* output_format, AVRational time_base,
+                         const AVCodec** out_codec)
+{
+  const AVCodec* codec = nullptr;
+
+  if (!g_Config.sDumpEncoder.empty())
+  {
+    codec = avcodec_find_encoder_by_name(g_Config.sDumpEncoder.c_str());
+    if (!codec)
+      WARN_LOG_FMT(FRAMEDUMP, "Invalid encoder {}", g_Config.sDumpEncoder);
+  }
+  if (!codec)
+    codec = avcodec_find_encoder(codec_id);
+
+  context->codec = avcodec_alloc_context3(codec);
+  if (!codec || !context->codec)
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not find encoder or allocate codec context");
+    return false;
+  }
+
+  // Force XVID FourCC for better compatibility when using H.263
+  if (codec->id == AV_CODEC_ID_MPEG4)
+    context->codec->codec_tag = MKTAG('X', 'V', 'I', 'D');
+
+  SetCommonCodecParameters(context->codec, context->width, context->height, time_base,
+                           output_format);
+  context->codec->level = 1;
+
+  AVPixelFormat pix_fmt = AV_PIX_FMT_NONE;
+
+  const std::string& pixel_format_string = g_Config.sDumpPixelFormat;
+  if (!pixel_format_string.empty())
+  {
+    pix_fmt = av_get_pix_fmt(pixel_format_string.c_str());
+    if (pix_fmt == AV_PIX_FMT_NONE)
+      WARN_LOG_FMT(FRAMEDUMP, "Invalid pixel format {}", pixel_format_string);
+  }
+
+  if (pix_fmt == AV_PIX_FMT_NONE)
+  {
+    if (context->codec->codec_id == AV_CODEC_ID_FFV1)
+      pix_fmt = AV_PIX_FMT_BGR0;
+    else if (context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
+      pix_fmt = AV_PIX_FMT_GBRP;
+    else
+      pix_fmt = AV_PIX_FMT_YUV420P;
+  }
+
+  context->codec->pix_fmt = pix_fmt;
+
+  if (context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
+    av_opt_set_int(context->codec->priv_data, "pred", 3, 0);  // median
+
+  if (avcodec_open2(context->codec, codec, nullptr) < 0)
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not open codec");
+    return false;
+  }
+
+  *out_codec = codec;
+  return true;
+}
+
 }  // namespace
 
 bool FrameDump::Start(int w, int h, u64 start_ticks)
@@ -227,80 +406,32 @@ bool FrameDump::CreateVideoFile()
       WARN_LOG_FMT(FRAMEDUMP, "Invalid codec {}", codec_name);
   }
 
-  const AVCodec* codec = nullptr;
-
-  if (!g_Config.sDumpEncoder.empty())
-  {
-    codec = avcodec_find_encoder_by_name(g_Config.sDumpEncoder.c_str());
-    if (!codec)
-      WARN_LOG_FMT(FRAMEDUMP, "Invalid encoder {}", g_Config.sDumpEncoder);
-  }
-  if (!codec)
-    codec = avcodec_find_encoder(codec_id);
-
-  m_context->codec = avcodec_alloc_context3(codec);
-  if (!codec || !m_context->codec)
-  {
-    ERROR_LOG_FMT(FRAMEDUMP, "Could not find encoder or allocate codec context");
-    return false;
-  }
-
-  // Force XVID FourCC for better compatibility when using H.263
-  if (codec->id == AV_CODEC_ID_MPEG4)
-    m_context->codec->codec_tag = MKTAG('X', 'V', 'I', 'D');
-
   const auto time_base = GetTimeBaseForCurrentRefreshRate();
 
   INFO_LOG_FMT(FRAMEDUMP, "Creating video file: {} x {} @ {}/{} fps", m_context->width,
                m_context->height, time_base.den, time_base.num);
 
-  m_context->codec->codec_type = AVMEDIA_TYPE_VIDEO;
-  m_context->codec->bit_rate = static_cast<int64_t>(g_Config.iBitrateKbps) * 1000;
-  m_context->codec->width = m_context->width;
-  m_context->codec->height = m_context->height;
-  m_context->codec->time_base = time_base;
-  m_context->codec->gop_size = 1;
-  m_context->codec->level = 1;
-  m_context->codec->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGR0 : AV_PIX_FMT_YUV420P;
-
-  AVPixelFormat pix_fmt = AV_PIX_FMT_NONE;
-
-  const std::string& pixel_format_string = g_Config.sDumpPixelFormat;
-  if (!pixel_format_string.empty())
-  {
-    pix_fmt = av_get_pix_fmt(pixel_format_string.c_str());
-    if (pix_fmt == AV_PIX_FMT_NONE)
-      WARN_LOG_FMT(FRAMEDUMP, "Invalid pixel format {}", pixel_format_string);
-  }
-
-  if (pix_fmt == AV_PIX_FMT_NONE)
-  {
-    if (m_context->codec->codec_id == AV_CODEC_ID_FFV1)
-      pix_fmt = AV_PIX_FMT_BGR0;
-    else if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
-      pix_fmt = AV_PIX_FMT_GBRP;
-    else
-      pix_fmt = AV_PIX_FMT_YUV420P;
-  }
-
-  m_context->codec->pix_fmt = pix_fmt;
-
-  if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
-    av_opt_set_int(m_context->codec->priv_data, "pred", 3, 0);  // median
-
-  if (output_format->flags & AVFMT_GLOBALHEADER)
-    m_context->codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+  // An explicitly configured encoder takes priority over a hardware one.
+  const AVCodec* codec = nullptr;
+  if (g_Config.bDumpHardwareEncoder && g_Config.sDumpEncoder.empty() && !g_Config.bUseFFV1)
+    codec = OpenHardwareEncoder(m_context.get(), codec_id, output_format, time_base);
 
-  if (avcodec_open2(m_context->codec, codec, nullptr) < 0)
-  {
-    ERROR_LOG_FMT(FRAMEDUMP, "Could not open codec");
+  if (!codec && !OpenSoftwareEncoder(m_context.get(), codec_id, output_format, time_base, &codec))
     return false;
-  }
 
   m_context->src_frame = av_frame_alloc();
   m_context->scaled_frame = av_frame_alloc();
 
-  m_context->scaled_frame->format = m_context->codec->pix_fmt;
+  // Frames are scaled to the format of the hardware frames, and then uploaded to them.
+  AVPixelFormat scaled_format = m_context->codec->pix_fmt;
+  if (m_context->codec->hw_frames_ctx)
+  {
+    scaled_format =
+        reinterpret_cast<AVHWFramesContext*>(m_context->codec->hw_frames_ctx->data)->sw_format;
+    m_context->hw_frame = av_frame_alloc();
+  }
+
+  m_context->scaled_frame->format = scaled_format;
   m_context->scaled_frame->width = m_context->width;
   m_context->scaled_frame->height = m_context->height;
 
@@ -384,17 +515,39 @@ void FrameDump::AddFrame(const FrameData& frame)
   // Convert image from RGBA to desired pixel format.
   m_context->sws = sws_getCachedContext(
       m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
-      m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
+      static_cast<AVPixelFormat>(m_context->scaled_frame->format), SWS_BICUBIC, nullptr, nullptr,
+      nullptr);
   if (m_context->sws)
   {
     sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
               frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
   }
 
+  AVFrame* encode_frame = m_context->scaled_frame;
+  if (m_context->hw_frame)
+  {
+    // The encoder holds a reference to the previous frame's buffer, so get a new one.
+    av_frame_unref(m_context->hw_frame);
+    if (const int error =
+            av_hwframe_get_buffer(m_context->codec->hw_frames_ctx, m_context->hw_frame, 0);
+        error < 0)
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Could not allocate hardware frame: {}", AVErrorString(error));
+      return;
+    }
+    if (const int error = av_hwframe_transfer_data(m_context->hw_frame, m_context->scaled_frame, 0);
+        error < 0)
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Could not upload hardware frame: {}", AVErrorString(error));
+      return;
+    }
+    encode_frame = m_context->hw_frame;
+  }
+
   m_context->last_pts = pts;
-  m_context->scaled_frame->pts = pts;
+  encode_frame->pts = pts;
 
-  if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
+  if (const int error = avcodec_send_frame(m_context->codec, encode_frame))
   {
     ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
     return;
@@ -467,6 +620,7 @@ void FrameDump::CloseVideoFile()
 {
   av_frame_free(&m_context->src_frame);
   av_frame_free(&m_context->scaled_frame);
+  av_frame_free(&m_context->hw_frame);
 
   avcodec_free_context(&m_context->codec);
 
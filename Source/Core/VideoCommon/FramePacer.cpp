@@ -0,0 +1,110 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FramePacer.h"
+
+#include <algorithm>
+
+#include "Common/Logging/Log.h"
+
+// Intervals longer than this many refreshes are pauses or loading hitches, not the frame rate.
+static constexpr u64 MAX_FRAME_INTERVAL_CYCLES = 8;
+// How many frames in a row may be scheduled later than necessary before the cadence is moved
+// closer to the submission time again.
+static constexpr u32 MAX_SLACK_FRAMES = 30;
+static constexpr u64 MAX_MARGIN_CYCLES = 3;
+static constexpr u32 PRESENTS_BEFORE_MARGIN_DECAY = 600;
+
+void FramePacer::SetRefreshDuration(u64 refresh_duration)
+{
+  const u32 next_present_id = m_next_present_id;
+  *this = {};
+  m_refresh_duration = refresh_duration;
+  m_next_present_id = next_present_id;
+}
+
+FramePacer::Target FramePacer::NextPresent(u64 now)
+{
+  Target target{m_next_present_id++, 0};
+  const u64 refresh = m_refresh_duration;
+  if (refresh == 0)
+    return target;
+
+  if (m_last_frame_time != 0 && now > m_last_frame_time)
+  {
+    const u64 delta = now - m_last_frame_time;
+    if (delta < MAX_FRAME_INTERVAL_CYCLES * refresh)
+      m_frame_interval = m_frame_interval == 0 ? delta : (m_frame_interval * 7 + delta) / 8;
+  }
+  m_last_frame_time = now;
+
+  // Only switch to another number of refreshes per frame if the frame rate is clearly closer to
+  // it, otherwise a frame rate half way between two cadences would keep flipping between them.
+  if (m_frame_interval != 0)
+  {
+    const u64 current = m_refresh_cycles * refresh;
+    const u64 error =
+        m_frame_interval > current ? m_frame_interval - current : current - m_frame_interval;
+    if (error > refresh * 3 / 4)
+    {
+      m_refresh_cycles = std::max<u64>((m_frame_interval + refresh / 2) / refresh, 1);
+      INFO_LOG_FMT(VIDEO, "Frame pacing: showing each frame for {} refreshes", m_refresh_cycles);
+    }
+  }
+  const u64 interval = m_refresh_cycles * refresh;
+
+  // The earliest refresh the frame can make, aligned to the refreshes the display reported.
+  u64 earliest = now + m_margin_cycles * refresh;
+  if (m_last_presented_time != 0 && earliest > m_last_presented_time)
+  {
+    const u64 since_presented = earliest - m_last_presented_time;
+    earliest = m_last_presented_time + (since_presented + refresh - 1) / refresh * refresh;
+  }
+
+  u64 time = m_last_target != 0 ? m_last_target + interval : 0;
+  if (time < earliest)
+  {
+    // Fell behind, so there is nothing to keep the cadence with.
+    time = earliest;
+    m_slack_frames = 0;
+  }
+  else if (time >= earliest + interval)
+  {
+    // The frame would wait for at least a whole frame in the queue. If that keeps up, drop the
+    // queued time instead of adding a frame of latency for good.
+    if (++m_slack_frames >= MAX_SLACK_FRAMES)
+    {
+      time = earliest;
+      m_slack_frames = 0;
+    }
+  }
+  else
+  {
+    m_slack_frames = 0;
+  }
+  m_last_target = time;
+
+  // Ask for half a refresh early, since the image is shown at the first refresh that comes after
+  // the desired time.
+  target.desired_present_time = time - refresh / 2;
+  return target;
+}
+
+void FramePacer::OnPresented(u64 desired_present_time, u64 actual_present_time)
+{
+  m_last_presented_time = std::max(m_last_presented_time, actual_present_time);
+  if (m_refresh_duration == 0 || desired_present_time == 0)
+    return;
+
+  if (actual_present_time >= desired_present_time + m_refresh_duration)
+  {
+    m_missed_presents++;
+    m_presents_on_time = 0;
+    m_margin_cycles = std::min(m_margin_cycles + 1, MAX_MARGIN_CYCLES);
+  }
+  else if (++m_presents_on_time >= PRESENTS_BEFORE_MARGIN_DECAY)
+  {
+    m_presents_on_time = 0;
+    m_margin_cycles = std::max<u64>(m_margin_cycles - 1, 1);
+  }
+}
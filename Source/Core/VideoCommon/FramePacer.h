@@ -0,0 +1,54 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Picks presentation times for swap chains which can be told when to show an image, such as with
+// VK_GOOGLE_display_timing. Frames are shown on a fixed cadence of display refreshes, so a 60 FPS
+// game on a 90 or 120 Hz panel doesn't alternate between short and long frames, and the target is
+// kept as close to the submission time as the display allows, which keeps frames from piling up in
+// the presentation queue. All times are in nanoseconds on the presentation engine's clock.
+class FramePacer
+{
+public:
+  struct Target
+  {
+    u32 present_id;
+    // Zero if the frame should be presented as soon as possible.
+    u64 desired_present_time;
+  };
+
+  // Resets the cadence; a refresh duration of zero disables pacing.
+  void SetRefreshDuration(u64 refresh_duration);
+  u64 GetRefreshDuration() const { return m_refresh_duration; }
+
+  // Picks when the frame which is submitted at the given time should be presented.
+  Target NextPresent(u64 now);
+
+  // Reports when an earlier frame really reached the screen.
+  void OnPresented(u64 desired_present_time, u64 actual_present_time);
+
+  // Number of display refreshes each frame is shown for.
+  u64 GetRefreshCycles() const { return m_refresh_cycles; }
+  u32 GetMissedPresents() const { return m_missed_presents; }
+
+private:
+  u64 m_refresh_duration = 0;
+  u32 m_next_present_id = 1;
+
+  u64 m_last_frame_time = 0;
+  u64 m_frame_interval = 0;
+  u64 m_refresh_cycles = 1;
+
+  u64 m_last_target = 0;
+  u64 m_last_presented_time = 0;
+  u32 m_slack_frames = 0;
+
+  // How many refreshes ahead of the submission time a frame is scheduled. Grows when the display
+  // misses targets, and shrinks again after a while without misses.
+  u64 m_margin_cycles = 1;
+  u32 m_presents_on_time = 0;
+  u32 m_missed_presents = 0;
+};
@@ -0,0 +1,158 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameStatsRecorder.h"
+
+#include <algorithm>
+#include <map>
+
+#include <picojson.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Timer.h"
+#include "VideoCommon/Statistics.h"
+
+namespace VideoCommon
+{
+FrameStatsRecorder g_frame_stats_recorder;
+
+void FrameStatsRecorder::Start()
+{
+  std::lock_guard lk(m_mutex);
+  m_frames.clear();
+  m_last_frame_end_us = 0;
+  m_pass.store(0, std::memory_order_relaxed);
+  m_recording.store(true, std::memory_order_relaxed);
+}
+
+std::vector<FrameStats> FrameStatsRecorder::Stop()
+{
+  std::lock_guard lk(m_mutex);
+  m_recording.store(false, std::memory_order_relaxed);
+  return std::move(m_frames);
+}
+
+void FrameStatsRecorder::OnFrameEnd()
+{
+  if (!IsRecording())
+    return;
+
+  std::lock_guard lk(m_mutex);
+  const u64 now = Common::Timer::NowUs();
+  const int shaders_created =
+      g_stats.num_pixel_shaders_created + g_stats.num_vertex_shaders_created;
+
+  // Recording may start long before the first frame, e.g. while booting, so that frame only
+  // starts the clock.
+  if (m_last_frame_end_us == 0)
+  {
+    m_last_frame_end_us = now;
+    m_last_shaders_created = shaders_created;
+    return;
+  }
+
+  // The shader counters are reset when the shader cache is reloaded.
+  const int new_shaders = shaders_created >= m_last_shaders_created ?
+                              shaders_created - m_last_shaders_created :
+                              shaders_created;
+
+  FrameStats& frame = m_frames.emplace_back();
+  frame.pass = m_pass.load(std::memory_order_relaxed);
+  frame.frame_time_us = now - m_last_frame_end_us;
+  frame.gpu_times_ns = g_stats.gpu_times_ns;
+  frame.num_draw_calls = g_stats.this_frame.num_draw_calls;
+  frame.num_prims = g_stats.this_frame.num_prims + g_stats.this_frame.num_dl_prims;
+  frame.num_shader_changes = g_stats.this_frame.num_shader_changes;
+  frame.num_efb_copies = g_stats.this_frame.num_efb_copy_flushes;
+  frame.num_shaders_created = new_shaders;
+
+  m_last_frame_end_us = now;
+  m_last_shaders_created = shaders_created;
+}
+
+static picojson::object GPUTimesToJSON(const GPUTimes& times)
+{
+  picojson::object object;
+  for (u32 i = 0; i < NUM_GPU_TIMING_CATEGORIES; i++)
+  {
+    object.emplace(GetGPUTimingCategoryName(static_cast<GPUTimingCategory>(i)),
+                   static_cast<double>(times[i]));
+  }
+  return object;
+}
+
+static picojson::object SummarizePass(u32 pass, const std::vector<const FrameStats*>& frames)
+{
+  std::vector<u64> frame_times;
+  GPUTimes gpu_times{};
+  double draw_calls = 0;
+  double shaders_created = 0;
+  for (const FrameStats* frame : frames)
+  {
+    frame_times.push_back(frame->frame_time_us);
+    for (u32 i = 0; i < NUM_GPU_TIMING_CATEGORIES; i++)
+      gpu_times[i] += frame->gpu_times_ns[i];
+    draw_calls += frame->num_draw_calls;
+    shaders_created += frame->num_shaders_created;
+  }
+
+  std::sort(frame_times.begin(), frame_times.end());
+  const auto percentile = [&frame_times](size_t percent) {
+    return static_cast<double>(frame_times[(frame_times.size() - 1) * percent / 100]);
+  };
+
+  double total_time = 0;
+  for (const u64 time : frame_times)
+    total_time += time;
+
+  const size_t count = frames.size();
+  for (u64& time : gpu_times)
+    time /= count;
+
+  picojson::object summary;
+  summary.emplace("pass", static_cast<double>(pass));
+  summary.emplace("frames", static_cast<double>(count));
+  summary.emplace("total_time_us", total_time);
+  summary.emplace("mean_frame_time_us", total_time / count);
+  summary.emplace("median_frame_time_us", percentile(50));
+  summary.emplace("p99_frame_time_us", percentile(99));
+  summary.emplace("max_frame_time_us", static_cast<double>(frame_times.back()));
+  summary.emplace("mean_gpu_time_ns", GPUTimesToJSON(gpu_times));
+  summary.emplace("mean_draw_calls", draw_calls / count);
+  summary.emplace("shaders_created", shaders_created);
+  return summary;
+}
+
+bool WriteFrameStatsJSON(const std::string& path, const std::vector<FrameStats>& frames,
+                         const std::string& description)
+{
+  std::map<u32, std::vector<const FrameStats*>> passes;
+  picojson::array json_frames;
+  for (const FrameStats& frame : frames)
+  {
+    passes[frame.pass].push_back(&frame);
+
+    picojson::object json_frame;
+    json_frame.emplace("pass", static_cast<double>(frame.pass));
+    json_frame.emplace("frame_time_us", static_cast<double>(frame.frame_time_us));
+    json_frame.emplace("gpu_time_ns", GPUTimesToJSON(frame.gpu_times_ns));
+    json_frame.emplace("draw_calls", static_cast<double>(frame.num_draw_calls));
+    json_frame.emplace("prims", static_cast<double>(frame.num_prims));
+    json_frame.emplace("shader_changes", static_cast<double>(frame.num_shader_changes));
+    json_frame.emplace("efb_copies", static_cast<double>(frame.num_efb_copies));
+    json_frame.emplace("shaders_created", static_cast<double>(frame.num_shaders_created));
+    json_frames.emplace_back(std::move(json_frame));
+  }
+
+  picojson::array json_passes;
+  for (const auto& [pass, pass_frames] : passes)
+    json_passes.emplace_back(SummarizePass(pass, pass_frames));
+
+  picojson::object root;
+  root.emplace("description", description);
+  root.emplace("passes", std::move(json_passes));
+  root.emplace("frames", std::move(json_frames));
+
+  return File::WriteStringToFile(path, picojson::value(std::move(root)).serialize(true));
+}
+}  // namespace VideoCommon
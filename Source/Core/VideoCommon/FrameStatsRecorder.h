@@ -0,0 +1,66 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/GPUTiming.h"
+
+namespace VideoCommon
+{
+struct FrameStats
+{
+  u32 pass = 0;
+  // Wall time since the previous frame ended.
+  u64 frame_time_us = 0;
+  // GPU time of the most recent frame which has been read back, which trails this frame by a few
+  // frames. All zero if the backend can't measure it.
+  GPUTimes gpu_times_ns{};
+  int num_draw_calls = 0;
+  int num_prims = 0;
+  int num_shader_changes = 0;
+  int num_efb_copies = 0;
+  // Pixel and vertex shaders compiled during this frame.
+  int num_shaders_created = 0;
+};
+
+// Records the statistics of every frame while it's enabled, so that runs of the same content can
+// be compared across backends and builds.
+class FrameStatsRecorder
+{
+public:
+  void Start();
+  // Returns the frames recorded since Start.
+  std::vector<FrameStats> Stop();
+
+  bool IsRecording() const { return m_recording.load(std::memory_order_relaxed); }
+
+  // Frames recorded from now on are counted towards this pass.
+  void SetPass(u32 pass) { m_pass.store(pass, std::memory_order_relaxed); }
+
+  // Called by the renderer at the end of each new frame, before its statistics are reset. The
+  // first frame after Start isn't recorded, as there's no previous frame to time it from.
+  void OnFrameEnd();
+
+private:
+  std::atomic<bool> m_recording{false};
+  std::atomic<u32> m_pass{0};
+
+  std::mutex m_mutex;
+  std::vector<FrameStats> m_frames;
+  u64 m_last_frame_end_us = 0;
+  int m_last_shaders_created = 0;
+};
+
+// Writes the frames as JSON, along with a summary of each pass. Returns false if the file can't
+// be written.
+bool WriteFrameStatsJSON(const std::string& path, const std::vector<FrameStats>& frames,
+                         const std::string& description);
+
+extern FrameStatsRecorder g_frame_stats_recorder;
+}  // namespace VideoCommon
@@ -0,0 +1,191 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameTimeline.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <imgui.h>
+
+namespace VideoCommon
+{
+FrameTimeline g_frame_timeline;
+
+namespace
+{
+thread_local TimelineCategory t_category = TimelineCategory::None;
+// When the calling thread switched to its current category, or zero if that happened while
+// measuring was disabled.
+thread_local u64 t_category_start_ns = 0;
+
+u64 GetTimeNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+const char* GetTimelineCategoryName(TimelineCategory category)
+{
+  switch (category)
+  {
+  case TimelineCategory::JitExecution:
+    return "JIT execution";
+  case TimelineCategory::JitCompile:
+    return "JIT compile";
+  case TimelineCategory::MMIOAndHLE:
+    return "MMIO/HLE";
+  case TimelineCategory::IdleSkip:
+    return "Idle skip";
+  case TimelineCategory::Throttle:
+    return "Throttle";
+  case TimelineCategory::CommandDecode:
+    return "Decode";
+  case TimelineCategory::VertexLoading:
+    return "Vertex loading";
+  case TimelineCategory::TextureCache:
+    return "Texture cache";
+  case TimelineCategory::FlushAndSubmit:
+    return "Flush/submit";
+  default:
+    return "None";
+  }
+}
+
+TimelineCategory FrameTimeline::SwitchCategory(TimelineCategory category)
+{
+  const TimelineCategory previous = t_category;
+  t_category = category;
+
+  if (!IsEnabled())
+  {
+    t_category_start_ns = 0;
+    return previous;
+  }
+
+  const u64 now = GetTimeNs();
+  if (previous != TimelineCategory::None && t_category_start_ns != 0)
+  {
+    m_times_ns[static_cast<u32>(previous)].fetch_add(now - t_category_start_ns,
+                                                     std::memory_order_relaxed);
+  }
+  t_category_start_ns = now;
+  return previous;
+}
+
+// Draws one bar for each frame, made of the times get_time(frame, part) for each part, and a
+// legend with the average time of each part.
+template <typename GetTime, typename GetName>
+static void DrawStackedGraph(const char* label, const FrameTimeline& timeline, u32 num_parts,
+                             GetTime get_time, GetName get_name, double full_scale_ns)
+{
+  static constexpr std::array<ImU32, NUM_TIMELINE_CATEGORIES> colors = {
+      IM_COL32(66, 135, 245, 255), IM_COL32(245, 66, 66, 255),   IM_COL32(245, 197, 66, 255),
+      IM_COL32(66, 245, 117, 255), IM_COL32(160, 160, 160, 255), IM_COL32(186, 66, 245, 255),
+      IM_COL32(245, 66, 197, 255), IM_COL32(66, 233, 245, 255),  IM_COL32(245, 138, 66, 255),
+  };
+  static_assert(NUM_GPU_TIMING_CATEGORIES <= NUM_TIMELINE_CATEGORIES);
+
+  const float scale = ImGui::GetIO().DisplayFramebufferScale.x;
+  const float bar_width = 2.0f * scale;
+  const ImVec2 size(FrameTimeline::HISTORY_SIZE * bar_width, 50.0f * scale);
+
+  ImGui::TextUnformatted(label);
+  ImDrawList* const draw_list = ImGui::GetWindowDrawList();
+  const ImVec2 origin = ImGui::GetCursorScreenPos();
+  const float bottom = origin.y + size.y;
+  draw_list->AddRectFilled(origin, ImVec2(origin.x + size.x, bottom), IM_COL32(0, 0, 0, 128));
+
+  std::array<double, NUM_TIMELINE_CATEGORIES> totals_ns{};
+  float x = origin.x;
+  timeline.ForEachFrame([&](const FrameTimeline::Frame& frame) {
+    float y = bottom;
+    for (u32 part = 0; part < num_parts; ++part)
+    {
+      const u64 time_ns = get_time(frame, part);
+      totals_ns[part] += time_ns;
+
+      const float top =
+          std::max(y - static_cast<float>(time_ns / full_scale_ns * size.y), origin.y);
+      if (top < y)
+        draw_list->AddRectFilled(ImVec2(x, top), ImVec2(x + bar_width, y), colors[part]);
+      y = top;
+    }
+    x += bar_width;
+  });
+
+  // The frame time is halfway up.
+  const float budget_y = origin.y + size.y / 2;
+  draw_list->AddLine(ImVec2(origin.x, budget_y), ImVec2(origin.x + size.x, budget_y),
+                     IM_COL32(255, 255, 255, 128));
+  ImGui::Dummy(size);
+
+  const size_t num_frames = std::max<size_t>(timeline.GetNumFrames(), 1);
+  for (u32 part = 0; part < num_parts; ++part)
+  {
+    ImGui::TextColored(ImColor(colors[part]), "%s: %.2f ms", get_name(part),
+                       totals_ns[part] / num_frames / 1000000.0);
+  }
+}
+
+void FrameTimeline::Display(double frame_time_ns) const
+{
+  const float scale = ImGui::GetIO().DisplayFramebufferScale.x;
+  ImGui::SetNextWindowPos(ImVec2(10.0f * scale, 10.0f * scale), ImGuiCond_FirstUseEver);
+  ImGui::SetNextWindowBgAlpha(.6f);
+  if (!ImGui::Begin("Frame Timeline", nullptr,
+                    ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_AlwaysAutoResize |
+                        ImGuiWindowFlags_NoFocusOnAppearing))
+  {
+    ImGui::End();
+    return;
+  }
+
+  const double full_scale_ns = frame_time_ns * 2;
+  const auto get_category_name = [](u32 category) {
+    return GetTimelineCategoryName(static_cast<TimelineCategory>(category));
+  };
+
+  DrawStackedGraph(
+      "CPU thread", *this, NUM_CPU_TIMELINE_CATEGORIES,
+      [](const Frame& frame, u32 part) { return frame.times_ns[part]; },
+      get_category_name, full_scale_ns);
+  DrawStackedGraph(
+      "GPU thread", *this, NUM_TIMELINE_CATEGORIES - NUM_CPU_TIMELINE_CATEGORIES,
+      [](const Frame& frame, u32 part) {
+        return frame.times_ns[NUM_CPU_TIMELINE_CATEGORIES + part];
+      },
+      [&](u32 part) { return get_category_name(NUM_CPU_TIMELINE_CATEGORIES + part); },
+      full_scale_ns);
+  DrawStackedGraph(
+      "GPU", *this, NUM_GPU_TIMING_CATEGORIES,
+      [](const Frame& frame, u32 part) { return frame.gpu_times_ns[part]; },
+      [](u32 part) { return GetGPUTimingCategoryName(static_cast<GPUTimingCategory>(part)); },
+      full_scale_ns);
+
+  ImGui::End();
+}
+
+void FrameTimeline::EndFrame(bool enabled, const GPUTimes& gpu_times_ns)
+{
+  const bool was_enabled = m_enabled.exchange(enabled, std::memory_order_relaxed);
+  if (!was_enabled)
+  {
+    // Start over, without the times which were measured before the overlay was hidden.
+    m_num_frames = 0;
+    for (std::atomic<u64>& time : m_times_ns)
+      time.store(0, std::memory_order_relaxed);
+    return;
+  }
+
+  Frame& frame = m_history[m_next_frame];
+  for (u32 i = 0; i < NUM_TIMELINE_CATEGORIES; ++i)
+    frame.times_ns[i] = m_times_ns[i].exchange(0, std::memory_order_relaxed);
+  frame.gpu_times_ns = gpu_times_ns;
+
+  m_next_frame = (m_next_frame + 1) % HISTORY_SIZE;
+  m_num_frames = std::min(m_num_frames + 1, HISTORY_SIZE);
+}
+}  // namespace VideoCommon
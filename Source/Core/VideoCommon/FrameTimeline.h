@@ -0,0 +1,107 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/GPUTiming.h"
+
+namespace VideoCommon
+{
+enum class TimelineCategory : u32
+{
+  // Work of the CPU thread
+  JitExecution,
+  JitCompile,
+  MMIOAndHLE,
+  IdleSkip,
+  Throttle,
+  // Work of the GPU thread, or of the CPU thread in single core mode
+  CommandDecode,
+  VertexLoading,
+  TextureCache,
+  FlushAndSubmit,
+  None,
+};
+
+constexpr u32 NUM_TIMELINE_CATEGORIES = static_cast<u32>(TimelineCategory::None);
+constexpr u32 NUM_CPU_TIMELINE_CATEGORIES = static_cast<u32>(TimelineCategory::CommandDecode);
+
+using TimelineTimes = std::array<u64, NUM_TIMELINE_CATEGORIES>;
+
+const char* GetTimelineCategoryName(TimelineCategory category);
+
+// Measures how much host time is spent on each kind of work per frame, for the timeline overlay.
+// Each thread has a current category, which TimelineScope changes until the end of the scope, and
+// the time since the last switch is added to a category when a thread switches away from it. A
+// thread which stays in one category for a whole frame is thus counted in the frame it leaves it.
+// Nothing is measured while the overlay is hidden, apart from keeping track of the categories.
+class FrameTimeline
+{
+public:
+  struct Frame
+  {
+    TimelineTimes times_ns{};
+    // GPU time measured with timestamps, which trails the host times by a few frames.
+    GPUTimes gpu_times_ns{};
+  };
+
+  static constexpr size_t HISTORY_SIZE = 120;
+
+  bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+  // Makes the given category the calling thread's current one, and returns the previous one.
+  TimelineCategory SwitchCategory(TimelineCategory category);
+
+  // Called by the renderer at the end of each frame. Adds the times measured since the previous
+  // call to the history, and enables or disables measuring from now on.
+  void EndFrame(bool enabled, const GPUTimes& gpu_times_ns);
+
+  // Calls func for each frame in the history, oldest first. Must only be called from the thread
+  // which calls EndFrame.
+  template <typename Func>
+  void ForEachFrame(Func func) const
+  {
+    const size_t first = (m_next_frame + HISTORY_SIZE - m_num_frames) % HISTORY_SIZE;
+    for (size_t i = 0; i < m_num_frames; ++i)
+      func(m_history[(first + i) % HISTORY_SIZE]);
+  }
+
+  size_t GetNumFrames() const { return m_num_frames; }
+
+  // Draws a stacked bar for each frame in the history, for the CPU thread, the GPU thread and the
+  // GPU. Bars which reach the top of a graph took twice the given frame time.
+  void Display(double frame_time_ns) const;
+
+private:
+  std::atomic<bool> m_enabled{false};
+  std::array<std::atomic<u64>, NUM_TIMELINE_CATEGORIES> m_times_ns{};
+
+  std::array<Frame, HISTORY_SIZE> m_history{};
+  size_t m_next_frame = 0;
+  size_t m_num_frames = 0;
+};
+
+extern FrameTimeline g_frame_timeline;
+
+// Counts the time until the end of the scope towards the given category.
+class TimelineScope
+{
+public:
+  explicit TimelineScope(TimelineCategory category)
+      : m_previous(g_frame_timeline.SwitchCategory(category))
+  {
+  }
+  ~TimelineScope() { g_frame_timeline.SwitchCategory(m_previous); }
+
+  TimelineScope(const TimelineScope&) = delete;
+  TimelineScope& operator=(const TimelineScope&) = delete;
+
+private:
+  TimelineCategory m_previous;
+};
+}  // namespace VideoCommon
@@ -9,7 +9,6 @@
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
-#include "Core/Config/GraphicsSettings.h"
 #include "VideoCommon/AbstractFramebuffer.h"
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/AbstractShader.h"
@@ -21,6 +20,7 @@
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
+#include "VideoCommon/VideoState.h"
 
 // Maximum number of pixels poked in one batch * 6
 constexpr size_t MAX_POKE_VERTICES = 32768;
@@ -127,8 +127,19 @@ AbstractTextureFormat FramebufferManager::GetEFBDepthFormat()
   // We still resolve this to a R32F texture, as there is no 24-bit format.
   if (DriverDetails::HasBug(DriverDetails::BUG_BROKEN_D32F_CLEAR))
     return AbstractTextureFormat::D24_S8;
-  else
-    return AbstractTextureFormat::D32F;
+
+  // The GameCube's depth buffer is 24-bit, so D24S8 can hold it. Mobile GPUs generally only
+  // compress D24S8/D16 depth buffers (e.g. older Mali AFBC), which saves a lot of bandwidth where
+  // the EFB is loaded and stored for every render pass. However, normalized depth is scaled by
+  // 2^24-1 rather than 2^24, so values above 2^23 read back through EFB copies and peeks can be
+  // off by one. Games which compare copied depth exactly will break, so this is opt-in.
+  if (g_ActiveConfig.bReducedPrecisionEFBDepth &&
+      g_ActiveConfig.backend_info.bSupportsD24S8DepthBuffer)
+  {
+    return AbstractTextureFormat::D24_S8;
+  }
+
+  return AbstractTextureFormat::D32F;
 }
 
 AbstractTextureFormat FramebufferManager::GetEFBDepthCopyFormat()
@@ -415,7 +426,7 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
 
   u32 tile_index;
   if (!IsEFBCacheTilePresent(false, x, y, &tile_index))
-    PopulateEFBCache(false, tile_index);
+    PopulateEFBCacheOnMiss(false, tile_index);
 
   m_efb_color_cache.tiles[tile_index].frame_access_mask |= 1;
 
@@ -438,7 +449,7 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
 
   u32 tile_index;
   if (!IsEFBCacheTilePresent(true, x, y, &tile_index))
-    PopulateEFBCache(true, tile_index);
+    PopulateEFBCacheOnMiss(true, tile_index);
 
   m_efb_depth_cache.tiles[tile_index].frame_access_mask |= 1;
 
@@ -785,6 +796,21 @@ void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index, bool async
   data.tiles[tile_index].present = true;
 }
 
+void FramebufferManager::PopulateEFBCacheOnMiss(bool depth, u32 tile_index)
+{
+  // Tiles which were read in the last few frames are likely to be read again before the EFB
+  // changes, so they are copied along with the missing one. The readback has to wait for the GPU
+  // either way, and this way a single wait covers all of them instead of one per tile.
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  for (u32 i = 0; i < data.tiles.size(); i++)
+  {
+    if (i != tile_index && data.tiles[i].frame_access_mask != 0 && !data.tiles[i].present)
+      PopulateEFBCache(depth, i, true);
+  }
+
+  PopulateEFBCache(depth, tile_index);
+}
+
 void FramebufferManager::ClearEFB(const MathUtil::Rectangle<int>& rc, bool clear_color,
                                   bool clear_alpha, bool clear_z, u32 color, u32 z)
 {
@@ -1032,7 +1058,7 @@ void FramebufferManager::DoState(PointerWrap& p)
 {
   FlushEFBPokes();
 
-  bool save_efb_state = Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE);
+  bool save_efb_state = VideoCommon_ShouldSaveGPUState();
   p.Do(save_efb_state);
   if (!save_efb_state)
     return;
@@ -64,6 +64,10 @@ public:
   void ResetSpeed();
   float GetSpeed() const;
 
+protected:
+  // Called by the controllers whenever their view changes.
+  void SetDirty() { m_dirty = true; }
+
 private:
   static constexpr float MIN_FOV_MULTIPLIER = 0.025f;
   static constexpr float DEFAULT_SPEED = 60.0f;
@@ -0,0 +1,138 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/GPUTiming.h"
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "VideoCommon/FrameStatsRecorder.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace VideoCommon
+{
+const char* GetGPUTimingCategoryName(GPUTimingCategory category)
+{
+  switch (category)
+  {
+  case GPUTimingCategory::Draws:
+    return "Draws";
+  case GPUTimingCategory::EFBCopies:
+    return "EFB copies";
+  case GPUTimingCategory::XFBPresent:
+    return "XFB present";
+  case GPUTimingCategory::PostProcessing:
+    return "Post-processing";
+  default:
+    return "None";
+  }
+}
+
+GPUTiming::~GPUTiming() = default;
+
+bool GPUTiming::IsEnabled()
+{
+  return g_ActiveConfig.bOverlayStats || g_ActiveConfig.bShowFrameTimeline ||
+         g_ActiveConfig.bLogGPUTimingsToFile ||
+         g_ActiveConfig.bDynamicResolution || g_frame_stats_recorder.IsRecording();
+}
+
+void GPUTiming::SetCategory(GPUTimingCategory category)
+{
+  if (!IsEnabled())
+    category = GPUTimingCategory::None;
+
+  if (category == m_current_category)
+    return;
+
+  if (m_current_category != GPUTimingCategory::None)
+    m_intervals.back().end_id = WriteTimestamp();
+
+  m_current_category = GPUTimingCategory::None;
+  if (category == GPUTimingCategory::None)
+    return;
+
+  const std::optional<u32> begin_id = WriteTimestamp();
+  if (!begin_id)
+    return;
+
+  m_intervals.push_back({category, m_current_frame, *begin_id, std::nullopt});
+  m_current_category = category;
+}
+
+void GPUTiming::EndFrame()
+{
+  SetCategory(GPUTimingCategory::None);
+  CollectResults();
+  m_current_frame++;
+}
+
+void GPUTiming::CollectResults()
+{
+  while (!m_intervals.empty())
+  {
+    const Interval& interval = m_intervals.front();
+    const std::optional<u64> begin = ReadTimestamp(interval.begin_id);
+    if (!begin)
+      break;
+
+    // An interval without an end timestamp ran out of space, so it doesn't count.
+    std::optional<u64> end = begin;
+    if (interval.end_id)
+    {
+      end = ReadTimestamp(*interval.end_id);
+      if (!end)
+        break;
+    }
+
+    // Every interval of a frame has been read once an interval of a later frame is.
+    if (m_collecting_frame && *m_collecting_frame != interval.frame)
+    {
+      PublishFrame(*m_collecting_frame, m_collecting_times);
+      m_collecting_times = {};
+    }
+
+    m_collecting_frame = interval.frame;
+    if (*end > *begin)
+      m_collecting_times[static_cast<u32>(interval.category)] += *end - *begin;
+
+    ReleaseInterval(interval);
+    m_intervals.pop_front();
+  }
+}
+
+void GPUTiming::PublishFrame(u64 frame, const GPUTimes& times)
+{
+  g_stats.gpu_times_ns = times;
+
+  if (!g_ActiveConfig.bLogGPUTimingsToFile)
+  {
+    if (m_log_file.is_open())
+      m_log_file.close();
+    return;
+  }
+
+  if (!m_log_file.is_open())
+  {
+    File::OpenFStream(m_log_file, File::GetUserPath(D_LOGS_IDX) + "gpu_timings.csv",
+                      std::ios_base::out);
+    m_log_file << "frame";
+    for (u32 i = 0; i < NUM_GPU_TIMING_CATEGORIES; i++)
+      m_log_file << ',' << GetGPUTimingCategoryName(static_cast<GPUTimingCategory>(i)) << " (us)";
+    m_log_file << '\n';
+  }
+
+  m_log_file << frame;
+  for (const u64 time : times)
+    m_log_file << fmt::format(",{:.1f}", time / 1000.0);
+  m_log_file << '\n';
+}
+
+void GPUTiming::ReleaseInterval(const Interval& interval)
+{
+  ReleaseTimestamp(interval.begin_id);
+  if (interval.end_id)
+    ReleaseTimestamp(*interval.end_id);
+}
+}  // namespace VideoCommon
@@ -0,0 +1,83 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <fstream>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+
+namespace VideoCommon
+{
+enum class GPUTimingCategory : u32
+{
+  Draws,
+  EFBCopies,
+  XFBPresent,
+  PostProcessing,
+  None,
+};
+
+constexpr u32 NUM_GPU_TIMING_CATEGORIES = static_cast<u32>(GPUTimingCategory::None);
+
+using GPUTimes = std::array<u64, NUM_GPU_TIMING_CATEGORIES>;
+
+const char* GetGPUTimingCategoryName(GPUTimingCategory category);
+
+// Measures how much GPU time each kind of work takes per frame, using timestamps the backend
+// writes into its command stream. Work is split into intervals at the points where the category
+// changes, and timestamps are read back once the GPU has finished with them, which is usually a
+// few frames later. Results are published to g_stats, and optionally logged to a CSV file.
+class GPUTiming
+{
+public:
+  virtual ~GPUTiming();
+
+  // Ends the current interval, and begins a new one for the given category, unless it is None.
+  // Does nothing if the category is unchanged, so it can be called for every draw.
+  void SetCategory(GPUTimingCategory category);
+
+  // Ends the current interval and collects the results of any finished frames. Must be called
+  // before the backend submits the frame's last commands.
+  void EndFrame();
+
+  static bool IsEnabled();
+
+protected:
+  // Writes a timestamp after all previous GPU commands. Returns its ID, or nothing if the backend
+  // has run out of space for timestamps.
+  virtual std::optional<u32> WriteTimestamp() = 0;
+
+  // Returns the timestamp in nanoseconds, or nothing if the GPU hasn't written it yet.
+  virtual std::optional<u64> ReadTimestamp(u32 id) = 0;
+
+  // Timestamps are released in the order they were written.
+  virtual void ReleaseTimestamp(u32 id) = 0;
+
+private:
+  struct Interval
+  {
+    GPUTimingCategory category;
+    u64 frame;
+    u32 begin_id;
+    std::optional<u32> end_id;
+  };
+
+  void CollectResults();
+  void PublishFrame(u64 frame, const GPUTimes& times);
+  void ReleaseInterval(const Interval& interval);
+
+  std::deque<Interval> m_intervals;
+  GPUTimingCategory m_current_category = GPUTimingCategory::None;
+  u64 m_current_frame = 0;
+
+  // Frame whose results are being summed, as intervals of it are read back.
+  std::optional<u64> m_collecting_frame;
+  GPUTimes m_collecting_times{};
+
+  std::ofstream m_log_file;
+};
+}  // namespace VideoCommon
@@ -7,6 +7,8 @@
 #include <string_view>
 #include <variant>
 
+#include <xxhash.h>
+
 #include "Common/Logging/Log.h"
 #include "Common/VariantUtil.h"
 
@@ -64,6 +66,17 @@ private:
   GraphicsModConfig m_mod;
 };
 
+u64 GraphicsModManager::HashTextureName(std::string_view texture_name)
+{
+  return XXH64(texture_name.data(), texture_name.size(), 0);
+}
+
+u64 GraphicsModManager::GetProjectionTextureKey(ProjectionType projection_type,
+                                                u64 texture_name_hash)
+{
+  return texture_name_hash ^ ((static_cast<u64>(projection_type) + 1) * 0x9E3779B97F4A7C15);
+}
+
 const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetProjectionActions(ProjectionType projection_type) const
 {
@@ -78,10 +91,10 @@ GraphicsModManager::GetProjectionActions(ProjectionType projection_type) const
 
 const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
-                                                const std::string& texture_name) const
+                                                u64 texture_name_hash) const
 {
-  const auto lookup = fmt::format("{}_{}", texture_name, static_cast<int>(projection_type));
-  if (const auto it = m_projection_texture_target_to_actions.find(lookup);
+  const u64 key = GetProjectionTextureKey(projection_type, texture_name_hash);
+  if (const auto it = m_projection_texture_target_to_actions.find(key);
       it != m_projection_texture_target_to_actions.end())
   {
     return it->second;
@@ -91,9 +104,9 @@ GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetDrawStartedActions(const std::string& texture_name) const
+GraphicsModManager::GetDrawStartedActions(u64 texture_name_hash) const
 {
-  if (const auto it = m_draw_started_target_to_actions.find(texture_name);
+  if (const auto it = m_draw_started_target_to_actions.find(texture_name_hash);
       it != m_draw_started_target_to_actions.end())
   {
     return it->second;
@@ -103,9 +116,9 @@ GraphicsModManager::GetDrawStartedActions(const std::string& texture_name) const
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetTextureLoadActions(const std::string& texture_name) const
+GraphicsModManager::GetTextureLoadActions(u64 texture_name_hash) const
 {
-  if (const auto it = m_load_texture_target_to_actions.find(texture_name);
+  if (const auto it = m_load_texture_target_to_actions.find(texture_name_hash);
       it != m_load_texture_target_to_actions.end())
   {
     return it->second;
@@ -126,7 +139,7 @@ const std::vector<GraphicsModAction*>& GraphicsModManager::GetEFBActions(const F
 
 const std::vector<GraphicsModAction*>& GraphicsModManager::GetXFBActions(const FBInfo& xfb) const
 {
-  if (const auto it = m_efb_target_to_actions.find(xfb); it != m_efb_target_to_actions.end())
+  if (const auto it = m_xfb_target_to_actions.find(xfb); it != m_xfb_target_to_actions.end())
   {
     return it->second;
   }
@@ -165,6 +178,11 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
 
   for (const auto& mod : mods)
   {
+    // Actions of disabled mods would never do anything, and the mods are reloaded when they're
+    // toggled, so leaving them out keeps the tables empty when no mod is active.
+    if (!mod.m_enabled)
+      continue;
+
     for (const GraphicsModFeatureConfig& feature : mod.m_features)
     {
       const auto create_action = [](const std::string_view& action_name,
@@ -192,12 +210,14 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
         std::visit(
             overloaded{
                 [&](const DrawStartedTextureTarget& the_target) {
-                  m_draw_started_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  m_draw_started_target_to_actions[HashTextureName(
+                                                       the_target.m_texture_info_string)]
+                      .push_back(m_actions.back().get());
                 },
                 [&](const LoadTextureTarget& the_target) {
-                  m_load_texture_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  m_load_texture_target_to_actions[HashTextureName(
+                                                       the_target.m_texture_info_string)]
+                      .push_back(m_actions.back().get());
                 },
                 [&](const EFBTarget& the_target) {
                   FBInfo info;
@@ -216,10 +236,10 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
                 [&](const ProjectionTarget& the_target) {
                   if (the_target.m_texture_info_string)
                   {
-                    const auto lookup = fmt::format("{}_{}", *the_target.m_texture_info_string,
-                                                    static_cast<int>(the_target.m_projection_type));
-                    m_projection_texture_target_to_actions[lookup].push_back(
-                        m_actions.back().get());
+                    const u64 key =
+                        GetProjectionTextureKey(the_target.m_projection_type,
+                                                HashTextureName(*the_target.m_texture_info_string));
+                    m_projection_texture_target_to_actions[key].push_back(m_actions.back().get());
                   }
                   else
                   {
@@ -6,10 +6,12 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModAction.h"
 #include "VideoCommon/TextureInfo.h"
@@ -19,17 +21,31 @@ class GraphicsModGroupConfig;
 class GraphicsModManager
 {
 public:
+  // Texture targets are looked up by a hash of the texture name, so that callers can hash the name
+  // once per texture rather than building and comparing strings in every draw.
+  static u64 HashTextureName(std::string_view texture_name);
+
   const std::vector<GraphicsModAction*>& GetProjectionActions(ProjectionType projection_type) const;
   const std::vector<GraphicsModAction*>&
-  GetProjectionTextureActions(ProjectionType projection_type,
-                              const std::string& texture_name) const;
-  const std::vector<GraphicsModAction*>&
-  GetDrawStartedActions(const std::string& texture_name) const;
-  const std::vector<GraphicsModAction*>&
-  GetTextureLoadActions(const std::string& texture_name) const;
+  GetProjectionTextureActions(ProjectionType projection_type, u64 texture_name_hash) const;
+  const std::vector<GraphicsModAction*>& GetDrawStartedActions(u64 texture_name_hash) const;
+  const std::vector<GraphicsModAction*>& GetTextureLoadActions(u64 texture_name_hash) const;
   const std::vector<GraphicsModAction*>& GetEFBActions(const FBInfo& efb) const;
   const std::vector<GraphicsModAction*>& GetXFBActions(const FBInfo& xfb) const;
 
+  // Let callers skip gathering what the lookups need when no action could match.
+  bool HasTextureActions() const
+  {
+    return !m_draw_started_target_to_actions.empty() ||
+           !m_load_texture_target_to_actions.empty() ||
+           !m_projection_texture_target_to_actions.empty();
+  }
+  bool HasProjectionActions() const
+  {
+    return !m_projection_target_to_actions.empty() ||
+           !m_projection_texture_target_to_actions.empty();
+  }
+
   void Load(const GraphicsModGroupConfig& config);
 
   void EndOfFrame();
@@ -37,16 +53,17 @@ public:
 private:
   void Reset();
 
+  static u64 GetProjectionTextureKey(ProjectionType projection_type, u64 texture_name_hash);
+
   class DecoratedAction;
 
   static inline const std::vector<GraphicsModAction*> m_default = {};
   std::list<std::unique_ptr<GraphicsModAction>> m_actions;
   std::unordered_map<ProjectionType, std::vector<GraphicsModAction*>>
       m_projection_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>>
-      m_projection_texture_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_draw_started_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_load_texture_target_to_actions;
+  std::unordered_map<u64, std::vector<GraphicsModAction*>> m_projection_texture_target_to_actions;
+  std::unordered_map<u64, std::vector<GraphicsModAction*>> m_draw_started_target_to_actions;
+  std::unordered_map<u64, std::vector<GraphicsModAction*>> m_load_texture_target_to_actions;
   std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_efb_target_to_actions;
   std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_xfb_target_to_actions;
 
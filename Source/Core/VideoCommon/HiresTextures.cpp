@@ -4,12 +4,16 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
@@ -28,15 +32,19 @@
 #include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/TexturePack.h"
 #include "VideoCommon/VideoConfig.h"
 
 struct DiskTexture
 {
   std::string path;
   bool has_arbitrary_mipmaps;
+  // Set if the texture is stored in a texture pack rather than its own files.
+  std::shared_ptr<const TexturePack> pack;
 };
 
 constexpr std::string_view s_format_prefix{"tex1_"};
@@ -48,6 +56,73 @@ static Common::Flag s_textureCacheAbortLoading;
 
 static std::thread s_prefetcher;
 
+// When streaming, textures are loaded on worker threads the first time they're searched for, and
+// kept in memory until the memory limit is reached, evicting the least recently used ones first.
+struct StreamedTexture
+{
+  std::shared_ptr<HiresTexture> texture;
+  size_t size = 0;
+  bool complete = false;
+  std::list<std::string>::iterator lru_iter;
+};
+
+struct StreamingRequest
+{
+  std::string base_filename;
+  u32 width;
+  u32 height;
+};
+
+constexpr size_t STREAMING_THREADS = 2;
+// Levels left out of the first version of a streamed texture, which is used until the complete
+// texture has been loaded. Only applies to textures with separate files for their mipmaps.
+constexpr u32 STREAMING_SKIPPED_LEVELS = 2;
+
+static std::unordered_map<std::string, StreamedTexture> s_streamed_textures;
+static std::list<std::string> s_streamed_lru;
+// Textures which are being loaded, until their complete version is available.
+static std::unordered_set<std::string> s_streaming_queued;
+static size_t s_streamed_size = 0;
+static size_t s_streaming_memory_limit = 0;
+static std::atomic<u64> s_streaming_generation{0};
+static std::array<Common::WorkQueueThread<StreamingRequest>, STREAMING_THREADS>
+    s_streaming_threads;
+static size_t s_next_streaming_thread = 0;
+
+static bool IsPackedFormatSupported(AbstractTextureFormat format)
+{
+  switch (format)
+  {
+  case AbstractTextureFormat::RGBA8:
+    return true;
+  case AbstractTextureFormat::DXT1:
+  case AbstractTextureFormat::DXT3:
+  case AbstractTextureFormat::DXT5:
+    return g_ActiveConfig.backend_info.bSupportsST3CTextures;
+  case AbstractTextureFormat::BPTC:
+    return g_ActiveConfig.backend_info.bSupportsBPTCTextures;
+  case AbstractTextureFormat::ETC2:
+    return g_ActiveConfig.backend_info.bSupportsETC2Textures;
+  case AbstractTextureFormat::ASTC4x4:
+    return g_ActiveConfig.backend_info.bSupportsASTCTextures;
+  default:
+    return false;
+  }
+}
+
+static void StopStreaming()
+{
+  for (auto& thread : s_streaming_threads)
+    thread.Cancel();
+
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  s_streamed_textures.clear();
+  s_streamed_lru.clear();
+  s_streaming_queued.clear();
+  s_streamed_size = 0;
+  s_streaming_generation++;
+}
+
 void HiresTexture::Init()
 {
   // Note: Update is not called here so that we handle dynamic textures on startup more gracefully
@@ -65,6 +140,7 @@ void HiresTexture::Update()
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
+  StopStreaming();
 
   if (!g_ActiveConfig.bHiresTextures)
   {
@@ -80,7 +156,7 @@ void HiresTexture::Update()
   const std::string& game_id = SConfig::GetInstance().GetGameID();
   const std::set<std::string> texture_directories =
       GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
+  const std::vector<std::string> extensions{".png", ".dds", ".dtp"};
 
   for (const auto& texture_directory : texture_directories)
   {
@@ -91,9 +167,26 @@ void HiresTexture::Update()
     for (auto& path : texture_paths)
     {
       std::string filename;
-      SplitPath(path, nullptr, &filename, nullptr);
+      std::string extension;
+      SplitPath(path, nullptr, &filename, &extension);
+      Common::ToLower(&extension);
+
+      if (extension == ".dtp")
+      {
+        const std::shared_ptr<const TexturePack> pack =
+            TexturePack::Open(path, IsPackedFormatSupported);
+        if (!pack)
+          continue;
 
-      if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
+        for (const auto& [name, texture] : pack->GetTextures())
+        {
+          const auto [it, inserted] = s_textureMap.try_emplace(
+              name, DiskTexture{path, texture.has_arbitrary_mipmaps, pack});
+          if (!inserted)
+            failed_insert = true;
+        }
+      }
+      else if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
       {
         const size_t arb_index = filename.rfind("_arb");
         const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
@@ -135,6 +228,17 @@ void HiresTexture::Update()
     s_textureCacheAbortLoading.Clear();
     s_prefetcher = std::thread(Prefetch);
   }
+  else if (g_ActiveConfig.bHiresTexturesStreaming)
+  {
+    s_streaming_memory_limit =
+        static_cast<size_t>(std::max(g_ActiveConfig.iHiresTexturesMemoryLimit, 0)) * 1024 * 1024;
+    for (auto& thread : s_streaming_threads)
+    {
+      thread.Reset([](StreamingRequest request) {
+        Stream(request.base_filename, request.width, request.height);
+      });
+    }
+  }
 }
 
 void HiresTexture::Clear()
@@ -144,6 +248,7 @@ void HiresTexture::Clear()
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
+  StopStreaming();
   s_textureMap.clear();
   s_textureCache.clear();
 }
@@ -261,9 +366,14 @@ u32 HiresTexture::CalculateMipCount(u32 width, u32 height)
   return mip_count;
 }
 
-std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
+std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info, bool* pending)
 {
+  if (pending)
+    *pending = false;
+
   const std::string base_filename = GenBaseName(texture_info);
+  if (g_ActiveConfig.bHiresTexturesStreaming && !g_ActiveConfig.bCacheHiresTextures)
+    return SearchStreamed(base_filename, texture_info, pending);
 
   std::lock_guard<std::mutex> lk(s_textureCacheMutex);
 
@@ -284,8 +394,117 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_in
   return ptr;
 }
 
+u64 HiresTexture::GetStreamingGeneration()
+{
+  return s_streaming_generation.load();
+}
+
+size_t HiresTexture::GetMemoryUsage()
+{
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  size_t size = s_streamed_size;
+  for (const auto& entry : s_textureCache)
+  {
+    if (!entry.second)
+      continue;
+    for (const Level& level : entry.second->m_levels)
+      size += level.data.size();
+  }
+  return size;
+}
+
+std::shared_ptr<HiresTexture> HiresTexture::SearchStreamed(const std::string& base_filename,
+                                                           const TextureInfo& texture_info,
+                                                           bool* pending)
+{
+  if (base_filename.empty())
+    return nullptr;
+
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+
+  auto iter = s_streamed_textures.find(base_filename);
+  if (iter != s_streamed_textures.end())
+  {
+    s_streamed_lru.splice(s_streamed_lru.begin(), s_streamed_lru, iter->second.lru_iter);
+    if (pending)
+      *pending = !iter->second.complete;
+    return iter->second.texture;
+  }
+
+  if (pending)
+    *pending = true;
+
+  if (s_streaming_queued.insert(base_filename).second)
+  {
+    s_streaming_threads[s_next_streaming_thread].EmplaceItem(StreamingRequest{
+        base_filename, texture_info.GetRawWidth(), texture_info.GetRawHeight()});
+    s_next_streaming_thread = (s_next_streaming_thread + 1) % s_streaming_threads.size();
+  }
+
+  return nullptr;
+}
+
+void HiresTexture::Stream(const std::string& base_filename, u32 width, u32 height)
+{
+  // Lower levels are much quicker to decode, so get those on screen first if they're separate.
+  if (s_textureMap.find(fmt::format("{}_mip{}", base_filename, STREAMING_SKIPPED_LEVELS)) !=
+      s_textureMap.end())
+  {
+    std::shared_ptr<HiresTexture> partial =
+        Load(base_filename, width, height, STREAMING_SKIPPED_LEVELS);
+    if (partial)
+      PublishStreamed(base_filename, std::move(partial), false);
+  }
+
+  PublishStreamed(base_filename, Load(base_filename, width, height), true);
+}
+
+void HiresTexture::PublishStreamed(const std::string& base_filename,
+                                   std::shared_ptr<HiresTexture> texture, bool complete)
+{
+  size_t size = 0;
+  if (texture)
+  {
+    for (const Level& level : texture->m_levels)
+      size += level.data.size();
+  }
+
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  if (complete)
+    s_streaming_queued.erase(base_filename);
+
+  auto [iter, inserted] = s_streamed_textures.try_emplace(base_filename);
+  StreamedTexture& streamed = iter->second;
+  if (inserted)
+  {
+    s_streamed_lru.push_front(base_filename);
+    streamed.lru_iter = s_streamed_lru.begin();
+  }
+  else
+  {
+    s_streamed_size -= streamed.size;
+    s_streamed_lru.splice(s_streamed_lru.begin(), s_streamed_lru, streamed.lru_iter);
+  }
+
+  streamed.texture = std::move(texture);
+  streamed.size = size;
+  streamed.complete = complete;
+  s_streamed_size += size;
+
+  // Always keep the texture which was just loaded, even if it's over the limit on its own.
+  while (s_streamed_size > s_streaming_memory_limit && s_streamed_lru.size() > 1)
+  {
+    const auto evicted = s_streamed_textures.find(s_streamed_lru.back());
+    s_streamed_size -= evicted->second.size;
+    s_streamed_textures.erase(evicted);
+    s_streamed_lru.pop_back();
+  }
+
+  s_streaming_generation++;
+}
+
 std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filename, u32 width,
-                                                 u32 height)
+                                                 u32 height, u32 first_level)
 {
   // We need to have a level 0 custom texture to even consider loading.
   auto filename_iter = s_textureMap.find(base_filename);
@@ -298,10 +517,13 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
   std::unique_ptr<HiresTexture> ret = std::unique_ptr<HiresTexture>(new HiresTexture());
   const DiskTexture& first_mip_file = filename_iter->second;
   ret->m_has_arbitrary_mipmaps = first_mip_file.has_arbitrary_mipmaps;
-  LoadDDSTexture(ret.get(), first_mip_file.path);
+  if (first_mip_file.pack)
+    LoadPackedTexture(ret.get(), first_mip_file.pack, base_filename, first_level);
+  else if (first_level == 0)
+    LoadDDSTexture(ret.get(), first_mip_file.path);
 
-  // Load remaining mip levels, or from the start if it's not a DDS texture.
-  for (u32 mip_level = static_cast<u32>(ret->m_levels.size());; mip_level++)
+  // Load remaining mip levels, or from the start if it's not a DDS or packed texture.
+  for (u32 mip_level = first_level + static_cast<u32>(ret->m_levels.size());; mip_level++)
   {
     std::string filename = base_filename;
     if (mip_level != 0)
@@ -337,7 +559,7 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
 
   // Verify that the aspect ratio of the texture hasn't changed, as this could have side-effects.
   const Level& first_mip = ret->m_levels[0];
-  if (first_mip.width * height != first_mip.height * width)
+  if (first_level == 0 && first_mip.width * height != first_mip.height * width)
   {
     ERROR_LOG_FMT(VIDEO,
                   "Invalid custom texture size {}x{} for texture {}. The aspect differs "
@@ -346,7 +568,8 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
   }
 
   // Same deal if the custom texture isn't a multiple of the native size.
-  if (width != 0 && height != 0 && (first_mip.width % width || first_mip.height % height))
+  if (first_level == 0 && width != 0 && height != 0 &&
+      (first_mip.width % width || first_mip.height % height))
   {
     ERROR_LOG_FMT(VIDEO,
                   "Invalid custom texture size {}x{} for texture {}. Please use an integer "
@@ -398,6 +621,28 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
   return ret;
 }
 
+void HiresTexture::LoadPackedTexture(HiresTexture* tex, std::shared_ptr<const TexturePack> pack,
+                                     const std::string& name, u32 first_level)
+{
+  const TexturePack::Texture* texture = pack->Find(name);
+  if (!texture)
+    return;
+
+  for (u32 i = first_level; i < static_cast<u32>(texture->levels.size()); i++)
+  {
+    const TexturePack::Level& packed_level = texture->levels[i];
+    Level level;
+    level.mapped_data = packed_level.data;
+    level.format = packed_level.format;
+    level.width = packed_level.width;
+    level.height = packed_level.height;
+    level.row_length = packed_level.row_length;
+    tex->m_levels.push_back(std::move(level));
+  }
+
+  tex->m_pack = std::move(pack);
+}
+
 bool HiresTexture::LoadTexture(Level& level, const std::vector<u8>& buffer)
 {
   if (!Common::LoadPNG(buffer, &level.data, &level.width, &level.height))
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <set>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -12,6 +13,7 @@
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureInfo.h"
 
+class TexturePack;
 enum class TextureFormat;
 
 std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_directory,
@@ -25,7 +27,18 @@ public:
   static void Clear();
   static void Shutdown();
 
-  static std::shared_ptr<HiresTexture> Search(const TextureInfo& texture_info);
+  // While streaming, returns the most complete version of the texture loaded so far, which may be
+  // missing its top levels or not be available yet. pending is set if a more complete version
+  // will become available later.
+  static std::shared_ptr<HiresTexture> Search(const TextureInfo& texture_info,
+                                              bool* pending = nullptr);
+
+  // Incremented whenever a streamed texture has been loaded.
+  static u64 GetStreamingGeneration();
+
+  // Bytes of custom texture data held in memory, prefetched and streamed. Levels mapped from a
+  // texture pack aren't counted, since the OS can drop them at any time.
+  static size_t GetMemoryUsage();
 
   static std::string GenBaseName(const TextureInfo& texture_info, bool dump = false);
 
@@ -39,21 +52,40 @@ public:
   struct Level
   {
     std::vector<u8> data;
+    // Used instead of data for levels from a texture pack, which are uploaded straight from the
+    // mapped file.
+    std::span<const u8> mapped_data;
     AbstractTextureFormat format = AbstractTextureFormat::RGBA8;
     u32 width = 0;
     u32 height = 0;
     u32 row_length = 0;
+
+    std::span<const u8> GetData() const
+    {
+      return mapped_data.empty() ? std::span<const u8>(data) : mapped_data;
+    }
   };
   std::vector<Level> m_levels;
 
 private:
   static std::unique_ptr<HiresTexture> Load(const std::string& base_filename, u32 width,
-                                            u32 height);
+                                            u32 height, u32 first_level = 0);
   static bool LoadDDSTexture(HiresTexture* tex, const std::string& filename);
   static bool LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level);
   static bool LoadTexture(Level& level, const std::vector<u8>& buffer);
+  static void LoadPackedTexture(HiresTexture* tex, std::shared_ptr<const TexturePack> pack,
+                                const std::string& name, u32 first_level);
   static void Prefetch();
+  static std::shared_ptr<HiresTexture> SearchStreamed(const std::string& base_filename,
+                                                      const TextureInfo& texture_info,
+                                                      bool* pending);
+  static void Stream(const std::string& base_filename, u32 width, u32 height);
+  static void PublishStreamed(const std::string& base_filename,
+                              std::shared_ptr<HiresTexture> texture, bool complete);
 
   HiresTexture() = default;
   bool m_has_arbitrary_mipmaps = false;
+
+  // Keeps the file mapped while levels point into it.
+  std::shared_ptr<const TexturePack> m_pack;
 };
@@ -12,10 +12,134 @@
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VideoConfig.h"
 
+#if defined(_M_X86)
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 namespace
 {
 constexpr u16 s_primitive_restart = UINT16_MAX;
 
+// Markers for pattern entries which don't move along with the vertices.
+constexpr int PATTERN_RESTART = -1;
+constexpr int PATTERN_BASE = -2;
+
+// Most primitives turn into a pattern of indices which repeats every few vertices, so the bulk of
+// them is written in blocks of whole 8-wide vectors instead of one index at a time. A block holds
+// as many repetitions of the pattern as fit, and each block adds the number of vertices it spans to
+// every index except for primitive restarts and the base vertex (the center of a fan).
+template <size_t Vectors>
+struct IndexPattern
+{
+  static constexpr size_t LENGTH = Vectors * 8;
+
+  // The period lists the indices of one repetition relative to the base index, and advance is by
+  // how much the indices grow from one repetition to the next.
+  template <size_t Period>
+  constexpr IndexPattern(const std::array<int, Period>& period, u32 advance)
+      : repeats(LENGTH / Period)
+  {
+    static_assert(LENGTH % Period == 0, "Blocks must hold whole repetitions");
+    for (size_t i = 0; i < LENGTH; ++i)
+    {
+      const int offset = period[i % Period];
+      if (offset == PATTERN_RESTART)
+      {
+        offsets[i] = s_primitive_restart;
+      }
+      else
+      {
+        base_mask[i] = UINT16_MAX;
+        if (offset != PATTERN_BASE)
+        {
+          offsets[i] = static_cast<u16>(offset + i / Period * advance);
+          steps[i] = static_cast<u16>(repeats * advance);
+        }
+      }
+    }
+  }
+
+  std::array<u16, LENGTH> offsets{};
+  std::array<u16, LENGTH> base_mask{};
+  std::array<u16, LENGTH> steps{};
+  u32 repeats;
+};
+
+// Writes whole blocks of the pattern for up to num_repeats repetitions, and returns how many
+// repetitions were written. The caller writes the remaining ones.
+template <size_t Vectors>
+u32 WritePattern(u16*& index_ptr, const IndexPattern<Vectors>& pattern, u32 base, u32 num_repeats)
+{
+  constexpr size_t length = IndexPattern<Vectors>::LENGTH;
+  const u32 num_blocks = num_repeats / pattern.repeats;
+  if (num_blocks == 0)
+    return 0;
+
+#if defined(_M_X86)
+  const __m128i base_vector = _mm_set1_epi16(static_cast<s16>(base));
+  std::array<__m128i, Vectors> vectors;
+  std::array<__m128i, Vectors> steps;
+  for (size_t i = 0; i < Vectors; ++i)
+  {
+    const auto load = [i](const std::array<u16, length>& values) {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(&values[i * 8]));
+    };
+    vectors[i] = _mm_add_epi16(load(pattern.offsets),
+                               _mm_and_si128(base_vector, load(pattern.base_mask)));
+    steps[i] = load(pattern.steps);
+  }
+  for (u32 block = 0; block < num_blocks; ++block)
+  {
+    for (size_t i = 0; i < Vectors; ++i)
+    {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(index_ptr + i * 8), vectors[i]);
+      vectors[i] = _mm_add_epi16(vectors[i], steps[i]);
+    }
+    index_ptr += length;
+  }
+#elif defined(_M_ARM_64)
+  const uint16x8_t base_vector = vdupq_n_u16(static_cast<u16>(base));
+  std::array<uint16x8_t, Vectors> vectors;
+  std::array<uint16x8_t, Vectors> steps;
+  for (size_t i = 0; i < Vectors; ++i)
+  {
+    vectors[i] = vaddq_u16(vld1q_u16(&pattern.offsets[i * 8]),
+                           vandq_u16(base_vector, vld1q_u16(&pattern.base_mask[i * 8])));
+    steps[i] = vld1q_u16(&pattern.steps[i * 8]);
+  }
+  for (u32 block = 0; block < num_blocks; ++block)
+  {
+    for (size_t i = 0; i < Vectors; ++i)
+    {
+      vst1q_u16(index_ptr + i * 8, vectors[i]);
+      vectors[i] = vaddq_u16(vectors[i], steps[i]);
+    }
+    index_ptr += length;
+  }
+#else
+  std::array<u16, length> indices;
+  for (size_t i = 0; i < length; ++i)
+    indices[i] = pattern.offsets[i] + (static_cast<u16>(base) & pattern.base_mask[i]);
+
+  for (u32 block = 0; block < num_blocks; ++block)
+  {
+    for (size_t i = 0; i < length; ++i)
+    {
+      index_ptr[i] = indices[i];
+      indices[i] += pattern.steps[i];
+    }
+    index_ptr += length;
+  }
+#endif
+
+  return num_blocks * pattern.repeats;
+}
+
+// Sequential indices, as used by points, line lists and strips with primitive restart.
+constexpr IndexPattern<1> s_sequential_pattern(std::array{0}, 1);
+
 template <bool pr>
 u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 {
@@ -27,22 +151,31 @@ u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
   return index_ptr;
 }
 
+constexpr IndexPattern<3> s_list_pattern(std::array{0, 1, 2}, 3);
+constexpr IndexPattern<3> s_list_pattern_pr(std::array{0, 1, 2, PATTERN_RESTART}, 3);
+
 template <bool pr>
 u16* AddList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 2; i < num_verts; i += 3)
+  const auto& pattern = pr ? s_list_pattern_pr : s_list_pattern;
+  u32 i = 2 + WritePattern(index_ptr, pattern, index, num_verts / 3) * 3;
+  for (; i < num_verts; i += 3)
   {
     index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
   }
   return index_ptr;
 }
 
+// Every other triangle is wound the other way: 012, 132, 234, 354, ...
+constexpr IndexPattern<3> s_strip_pattern(std::array{0, 1, 2, 1, 3, 2}, 2);
+
 template <bool pr>
 u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
   if constexpr (pr)
   {
-    for (u32 i = 0; i < num_verts; ++i)
+    u32 i = WritePattern(index_ptr, s_sequential_pattern, index, num_verts);
+    for (; i < num_verts; ++i)
     {
       *index_ptr++ = index + i;
     }
@@ -50,8 +183,13 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
   }
   else
   {
+    // Whole blocks hold an even number of triangles, so the winding starts over afterwards.
+    u32 i = 2;
+    if (num_verts > 2)
+      i += WritePattern(index_ptr, s_strip_pattern, index, (num_verts - 2) / 2) * 2;
+
     bool wind = false;
-    for (u32 i = 2; i < num_verts; ++i)
+    for (; i < num_verts; ++i)
     {
       index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
 
@@ -80,6 +218,10 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
  * so we use 6 indices for 3 triangles
  */
 
+constexpr IndexPattern<3> s_fan_pattern(std::array{PATTERN_BASE, 1, 2}, 1);
+constexpr IndexPattern<3> s_fan_pattern_pr(std::array{1, 2, PATTERN_BASE, 3, 4, PATTERN_RESTART},
+                                           3);
+
 template <bool pr>
 u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
 {
@@ -87,6 +229,9 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
 
   if constexpr (pr)
   {
+    if (num_verts > 2)
+      i += WritePattern(index_ptr, s_fan_pattern_pr, index, (num_verts - 2) / 3) * 3;
+
     for (; i + 3 <= num_verts; i += 3)
     {
       *index_ptr++ = index + i - 1;
@@ -106,6 +251,10 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
       *index_ptr++ = s_primitive_restart;
     }
   }
+  else if (num_verts > 2)
+  {
+    i += WritePattern(index_ptr, s_fan_pattern, index, num_verts - 2);
+  }
 
   for (; i < num_verts; ++i)
   {
@@ -131,10 +280,18 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
  * A simple triangle has to be rendered for three vertices.
  * ZWW do this for sun rays
  */
+constexpr IndexPattern<3> s_quad_pattern(std::array{0, 1, 2, 0, 2, 3}, 4);
+constexpr IndexPattern<5> s_quad_pattern_pr(std::array{1, 2, 0, 3, PATTERN_RESTART}, 4);
+
 template <bool pr>
 u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
 {
   u32 i = 3;
+  if constexpr (pr)
+    i += WritePattern(index_ptr, s_quad_pattern_pr, index, num_verts / 4) * 4;
+  else
+    i += WritePattern(index_ptr, s_quad_pattern, index, num_verts / 4) * 4;
+
   for (; i < num_verts; i += 4)
   {
     if constexpr (pr)
@@ -170,7 +327,8 @@ u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; i += 2)
+  u32 i = 1 + WritePattern(index_ptr, s_sequential_pattern, index, num_verts / 2 * 2);
+  for (; i < num_verts; i += 2)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -178,11 +336,16 @@ u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
+constexpr IndexPattern<1> s_line_strip_pattern(std::array{0, 1}, 1);
+
 // Shouldn't be used as strips as LineLists are much more common
 // so converting them to lists
 u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; ++i)
+  u32 i = 1;
+  if (num_verts > 1)
+    i += WritePattern(index_ptr, s_line_strip_pattern, index, num_verts - 1);
+  for (; i < num_verts; ++i)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -190,6 +353,14 @@ u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
+// The VS expand patterns are relative to the base vertex shifted left by 2, so they advance by 4
+// for every vertex.
+constexpr IndexPattern<3> s_line_expand_pattern(std::array{0, 1, 6, 1, 6, 7}, 8);
+constexpr IndexPattern<5> s_line_expand_pattern_pr(std::array{0, 1, 6, 7, PATTERN_RESTART}, 8);
+constexpr IndexPattern<3> s_line_strip_expand_pattern(std::array{0, 1, 6, 1, 6, 7}, 4);
+constexpr IndexPattern<5> s_line_strip_expand_pattern_pr(std::array{0, 1, 6, 7, PATTERN_RESTART},
+                                                         4);
+
 template <bool pr, bool linestrip>
 u16* AddLines_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 {
@@ -198,7 +369,19 @@ u16* AddLines_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
   // Bit 1 indicates which point of the line (top/bottom for a vertical line)
   // VS Expand assumes the two points will be adjacent vertices
   constexpr u32 advance = linestrip ? 1 : 2;
-  for (u32 i = 1; i < num_verts; i += advance)
+  u32 i = 1;
+  if (num_verts > 1)
+  {
+    const u32 num_lines = linestrip ? num_verts - 1 : num_verts / 2;
+    const auto& pattern = linestrip ? s_line_strip_expand_pattern : s_line_expand_pattern;
+    const auto& pattern_pr = linestrip ? s_line_strip_expand_pattern_pr : s_line_expand_pattern_pr;
+    if constexpr (pr)
+      i += WritePattern(index_ptr, pattern_pr, index << 2, num_lines) * advance;
+    else
+      i += WritePattern(index_ptr, pattern, index << 2, num_lines) * advance;
+  }
+
+  for (; i < num_verts; i += advance)
   {
     u32 p0 = (index + i - 1) << 2;
     u32 p1 = (index + i - 0) << 2;
@@ -225,19 +408,29 @@ u16* AddLines_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 0; i != num_verts; ++i)
+  for (u32 i = WritePattern(index_ptr, s_sequential_pattern, index, num_verts); i != num_verts;
+       ++i)
   {
     *index_ptr++ = index + i;
   }
   return index_ptr;
 }
 
+constexpr IndexPattern<3> s_point_expand_pattern(std::array{0, 1, 2, 1, 2, 3}, 4);
+constexpr IndexPattern<5> s_point_expand_pattern_pr(std::array{0, 1, 2, 3, PATTERN_RESTART}, 4);
+
 template <bool pr>
 u16* AddPoints_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 {
   // VS Expand uses (index >> 2) as the base vertex
   // Bottom two bits indicate which of (TL, TR, BL, BR) this is
-  for (u32 i = 0; i < num_verts; ++i)
+  u32 i;
+  if constexpr (pr)
+    i = WritePattern(index_ptr, s_point_expand_pattern_pr, index << 2, num_verts);
+  else
+    i = WritePattern(index_ptr, s_point_expand_pattern, index << 2, num_verts);
+
+  for (; i < num_verts; ++i)
   {
     u32 base = (index + i) << 2;
     if constexpr (pr)
@@ -34,6 +34,12 @@ void NetPlayChatUI::Display()
     return;
   }
 
+  {
+    std::lock_guard lk(m_stats_mutex);
+    if (!m_stats.empty())
+      ImGui::TextUnformatted(m_stats.c_str());
+  }
+
   ImGui::BeginChild("Scrolling", ImVec2(0, -30 * scale), true, ImGuiWindowFlags_None);
   for (const auto& msg : m_messages)
   {
@@ -91,6 +97,12 @@ void NetPlayChatUI::AppendChat(std::string message, Color color)
     m_scroll_to_bottom = true;
 }
 
+void NetPlayChatUI::SetStats(std::string stats)
+{
+  std::lock_guard lk(m_stats_mutex);
+  m_stats = std::move(stats);
+}
+
 void NetPlayChatUI::SendMessage()
 {
   // Check whether the input field is empty
@@ -7,6 +7,7 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -22,6 +23,8 @@ public:
   void AppendChat(std::string message, Color color);
   void SendMessage();
   void Activate();
+  // Shown above the chat, for the buffer size and the latency of the players.
+  void SetStats(std::string stats);
 
 private:
   char m_message_buf[256] = {};
@@ -31,6 +34,9 @@ private:
 
   std::deque<std::pair<std::string, Color>> m_messages;
   std::function<void(const std::string&)> m_message_callback;
+
+  std::string m_stats;
+  std::mutex m_stats_mutex;
 };
 
 extern std::unique_ptr<NetPlayChatUI> g_netplay_chat_ui;
@@ -22,6 +22,7 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameTimeline.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -244,20 +245,29 @@ public:
 };
 
 template <bool is_preprocess>
-u8* RunFifo(DataReader src, u32* cycles)
+u8* RunFifo(DataReader src, u32* cycles, u32* needed_size)
 {
+  VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::CommandDecode);
+
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
-  u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
+  const u32 available = static_cast<u32>(src.size());
+  u32 size = Run(src.GetPointer(), available, callback);
 
   if (cycles != nullptr)
     *cycles = callback.m_cycles;
 
+  if (needed_size != nullptr)
+  {
+    *needed_size =
+        size < available ? GetCommandSize(src.GetPointer() + size, available - size, callback) : 0;
+  }
+
   src.Skip(size);
   return src.GetPointer();
 }
 
-template u8* RunFifo<true>(DataReader src, u32* cycles);
-template u8* RunFifo<false>(DataReader src, u32* cycles);
+template u8* RunFifo<true>(DataReader src, u32* cycles, u32* needed_size);
+template u8* RunFifo<false>(DataReader src, u32* cycles, u32* needed_size);
 
 }  // namespace OpcodeDecoder
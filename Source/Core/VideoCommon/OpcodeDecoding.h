@@ -248,6 +248,48 @@ static DOLPHIN_FORCE_INLINE u32 RunCommand(const u8* data, u32 available, T& cal
 }
 }  // namespace detail
 
+// Returns the size of the command at data. If not enough of it is available to tell, returns the
+// number of bytes needed to find out instead, so this at least is always larger than available for
+// a command that RunCommand couldn't run yet. Only calls GetVertexSize on the callback.
+template <typename T, typename = std::enable_if_t<std::is_base_of_v<Callback, T>>>
+DOLPHIN_FORCE_INLINE u32 GetCommandSize(const u8* data, u32 available, T& callback)
+{
+  if (available < 1)
+    return 1;
+
+  const Opcode cmd = static_cast<Opcode>(data[0]);
+  switch (cmd)
+  {
+  case Opcode::GX_LOAD_CP_REG:
+    return 6;
+
+  case Opcode::GX_LOAD_XF_REG:
+    if (available < 5)
+      return 5;
+    return 5 + (((Common::swap32(&data[1]) >> 16) & 0xf) + 1) * 4;
+
+  case Opcode::GX_LOAD_INDX_A:
+  case Opcode::GX_LOAD_INDX_B:
+  case Opcode::GX_LOAD_INDX_C:
+  case Opcode::GX_LOAD_INDX_D:
+  case Opcode::GX_LOAD_BP_REG:
+    return 5;
+
+  case Opcode::GX_CMD_CALL_DL:
+    return 9;
+
+  default:
+    if (cmd >= Opcode::GX_PRIMITIVE_START && cmd <= Opcode::GX_PRIMITIVE_END)
+    {
+      if (available < 3)
+        return 3;
+      const u8 vat = static_cast<u8>(cmd) & OpcodeDecoder::GX_VAT_MASK;
+      return 3 + Common::swap16(&data[1]) * callback.GetVertexSize(vat);
+    }
+    return 1;
+  }
+}
+
 template <typename T, typename = std::enable_if_t<std::is_base_of_v<Callback, T>>>
 DOLPHIN_FORCE_INLINE u32 RunCommand(const u8* data, u32 available, T& callback)
 {
@@ -273,8 +315,11 @@ DOLPHIN_FORCE_INLINE u32 Run(const u8* data, u32 available, T& callback)
   return size;
 }
 
+// Runs all complete commands in src and returns a pointer to the first one that isn't. If
+// needed_size isn't null, it's set to the number of bytes that have to be available from there on
+// before another call can make progress, or to 0 if all of src was consumed.
 template <bool is_preprocess = false>
-u8* RunFifo(DataReader src, u32* cycles);
+u8* RunFifo(DataReader src, u32* cycles, u32* needed_size = nullptr);
 
 }  // namespace OpcodeDecoder
 
@@ -11,3 +11,25 @@ bool PerfQueryBase::ShouldEmulate()
 {
   return g_ActiveConfig.bPerfQueriesEnable;
 }
+
+std::optional<u32> PerfQueryBase::GetAsyncQueryResult(PerfQueryType type)
+{
+  if (IsFlushed())
+  {
+    const u32 result = GetQueryResult(type);
+    SetCompletedQueryResult(type, result);
+    return result;
+  }
+
+  if (!m_completed_results[type] || m_stale_reads[type] >= MAX_STALE_READS)
+    return std::nullopt;
+
+  m_stale_reads[type]++;
+  return m_completed_results[type];
+}
+
+void PerfQueryBase::SetCompletedQueryResult(PerfQueryType type, u32 value)
+{
+  m_completed_results[type] = value;
+  m_stale_reads[type] = 0;
+}
@@ -6,6 +6,7 @@
 #include <array>
 #include <atomic>
 #include <memory>
+#include <optional>
 
 #include "Common/CommonTypes.h"
 
@@ -58,13 +59,36 @@ public:
   // carefully!
   virtual void FlushResults() {}
 
+  // Retrieve the values of any queries the host GPU has already finished, without waiting for
+  // the rest.
+  virtual void PollResults() {}
+
   // True if there are no further pending query results
   // NOTE: Called from CPU thread
   virtual bool IsFlushed() const { return true; }
 
+  // Returns the current value if there are no pending queries. Otherwise, returns the value from
+  // the last read which had no pending queries, as long as it hasn't been reused too many times in
+  // a row. Returns nothing when the caller has to wait for the pending queries instead.
+  // NOTE: Called from CPU thread
+  std::optional<u32> GetAsyncQueryResult(PerfQueryType type);
+
+  // Records a value which was read after waiting for all pending queries.
+  // NOTE: Called from CPU thread
+  void SetCompletedQueryResult(PerfQueryType type, u32 value);
+
 protected:
   std::atomic<u32> m_query_count;
   std::array<std::atomic<u32>, PQG_NUM_MEMBERS> m_results;
+
+private:
+  // Games usually poll the counters once or twice per frame, so this bounds how stale a result
+  // can get before we wait for the GPU to catch up.
+  static constexpr u32 MAX_STALE_READS = 8;
+
+  // CPU thread state for asynchronous reads.
+  std::array<std::optional<u32>, PQ_NUM_MEMBERS> m_completed_results;
+  std::array<u32, PQ_NUM_MEMBERS> m_stale_reads{};
 };
 
 extern std::unique_ptr<PerfQueryBase> g_perf_query;
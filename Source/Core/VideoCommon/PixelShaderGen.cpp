@@ -5,6 +5,7 @@
 
 #include <cmath>
 #include <cstdio>
+#include <tuple>
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
@@ -326,8 +327,8 @@ void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& hos
   uid_data->bounding_box &= host_config.bounding_box & host_config.backend_bbox;
 }
 
-void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
-                                  const ShaderHostConfig& host_config, bool bounding_box)
+static void GeneratePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
+                                            const ShaderHostConfig& host_config, bool bounding_box)
 {
   // dot product for integer vectors
   out.Write("int idot(int3 x, int3 y)\n"
@@ -733,6 +734,21 @@ uint WrapCoord(int coord, uint wrap, int size) {{
   }
 }
 
+void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
+                                  const ShaderHostConfig& host_config, bool bounding_box)
+{
+  // Every specialized pixel shader and ubershader starts with this header, which only depends on
+  // the host config and the backend.
+  static ShaderCodeBlockCache<std::tuple<APIType, u32, bool, bool, bool>> s_cache;
+  s_cache.Write(out,
+                {api_type, host_config.bits, bounding_box,
+                 g_ActiveConfig.backend_info.bSupportsTextureQueryLevels,
+                 g_ActiveConfig.backend_info.bSupportsCoarseDerivatives},
+                [&](ShaderCode& block) {
+                  GeneratePixelShaderCommonHeader(block, api_type, host_config, bounding_box);
+                });
+}
+
 static void WriteStage(ShaderCode& out, const pixel_shader_uid_data* uid_data, int n,
                        APIType api_type, bool stereo);
 static void WriteTevRegular(ShaderCode& out, std::string_view components, TevBias bias, TevOp op,
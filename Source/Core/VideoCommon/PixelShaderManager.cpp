@@ -16,6 +16,7 @@ bool PixelShaderManager::s_bFogRangeAdjustChanged;
 bool PixelShaderManager::s_bViewPortChanged;
 bool PixelShaderManager::s_bIndirectDirty;
 bool PixelShaderManager::s_bDestAlphaDirty;
+bool PixelShaderManager::s_bTevStagesDirty;
 
 PixelShaderConstants PixelShaderManager::constants;
 bool PixelShaderManager::dirty;
@@ -27,6 +28,7 @@ void PixelShaderManager::Init()
   // Init any intial constants which aren't zero when bpmem is zero.
   s_bFogRangeAdjustChanged = true;
   s_bViewPortChanged = false;
+  s_bTevStagesDirty = true;
 
   SetIndMatrixChanged(0);
   SetIndMatrixChanged(1);
@@ -81,6 +83,7 @@ void PixelShaderManager::Dirty()
   // This function is called after a savestate is loaded.
   // Any constants that can changed based on settings should be re-calculated
   s_bFogRangeAdjustChanged = true;
+  s_bTevStagesDirty = true;
 
   SetEfbScaleChanged(g_renderer->EFBToScaledXf(1), g_renderer->EFBToScaledYf(1));
   SetFogParamChanged();
@@ -140,6 +143,35 @@ void PixelShaderManager::SetConstants()
     s_bViewPortChanged = false;
   }
 
+  if (s_bTevStagesDirty)
+  {
+    for (size_t i = 0; i < std::size(bpmem.combiners); i++)
+    {
+      const u32 color = bpmem.combiners[i].colorC.hex;
+      const u32 alpha = bpmem.combiners[i].alphaC.hex;
+      if (constants.pack1[i][0] != color || constants.pack1[i][1] != alpha)
+      {
+        constants.pack1[i][0] = color;
+        constants.pack1[i][1] = alpha;
+        dirty = true;
+      }
+    }
+
+    for (size_t i = 0; i < std::size(bpmem.tevorders); i++)
+    {
+      const u32 order = bpmem.tevorders[i].hex;
+      const u32 ksel = bpmem.tevksel.ksel[i].hex;
+      if (constants.pack2[i][0] != order || constants.pack2[i][1] != ksel)
+      {
+        constants.pack2[i][0] = order;
+        constants.pack2[i][1] = ksel;
+        dirty = true;
+      }
+    }
+
+    s_bTevStagesDirty = false;
+  }
+
   if (s_bIndirectDirty)
   {
     for (int i = 0; i < 4; i++)
@@ -217,31 +249,9 @@ void PixelShaderManager::SetTevKonstColor(int index, int component, s32 value)
   PRIM_LOG("tev konst color{}: {} {} {} {}", index, c[0], c[1], c[2], c[3]);
 }
 
-void PixelShaderManager::SetTevOrder(int index, u32 order)
-{
-  if (constants.pack2[index][0] != order)
-  {
-    constants.pack2[index][0] = order;
-    dirty = true;
-  }
-}
-
-void PixelShaderManager::SetTevKSel(int index, u32 ksel)
-{
-  if (constants.pack2[index][1] != ksel)
-  {
-    constants.pack2[index][1] = ksel;
-    dirty = true;
-  }
-}
-
-void PixelShaderManager::SetTevCombiner(int index, int alpha, u32 combiner)
+void PixelShaderManager::SetTevStagesChanged()
 {
-  if (constants.pack1[index][alpha] != combiner)
-  {
-    constants.pack1[index][alpha] = combiner;
-    dirty = true;
-  }
+  s_bTevStagesDirty = true;
 }
 
 void PixelShaderManager::SetTevIndirectChanged()
@@ -23,9 +23,8 @@ public:
   // so make sure to call them after memory is committed
   static void SetTevColor(int index, int component, s32 value);
   static void SetTevKonstColor(int index, int component, s32 value);
-  static void SetTevOrder(int index, u32 order);
-  static void SetTevKSel(int index, u32 ksel);
-  static void SetTevCombiner(int index, int alpha, u32 combiner);
+  // The TEV orders, konstant selections and combiners are read from bpmem by SetConstants.
+  static void SetTevStagesChanged();
   static void SetAlpha();
   static void SetAlphaTestChanged();
   static void SetDestAlphaChanged();
@@ -56,4 +55,5 @@ public:
   static bool s_bViewPortChanged;
   static bool s_bIndirectDirty;
   static bool s_bDestAlphaDirty;
+  static bool s_bTevStagesDirty;
 };
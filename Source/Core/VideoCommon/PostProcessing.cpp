@@ -3,6 +3,8 @@
 
 #include "VideoCommon/PostProcessing.h"
 
+#include <algorithm>
+#include <array>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -84,6 +86,7 @@ void PostProcessingConfiguration::LoadShader(const std::string& shader)
 void PostProcessingConfiguration::LoadDefaultShader()
 {
   m_options.clear();
+  m_passes.clear();
   m_any_options_dirty = false;
   m_current_shader_code = s_default_shader;
 }
@@ -96,6 +99,7 @@ void PostProcessingConfiguration::LoadOptions(const std::string& code)
   size_t configuration_end = code.find(config_end_delimiter);
 
   m_options.clear();
+  m_passes.clear();
   m_any_options_dirty = true;
 
   if (configuration_start == std::string::npos || configuration_end == std::string::npos)
@@ -162,6 +166,29 @@ void PostProcessingConfiguration::LoadOptions(const std::string& code)
 
   for (const auto& it : option_strings)
   {
+    if (it.m_type == "Pass")
+    {
+      RenderPass pass;
+      for (const auto& string_option : it.m_options)
+      {
+        if (string_option.first == "EntryPoint")
+          pass.m_entry_point = string_option.second;
+        else if (string_option.first == "OutputScale")
+          TryParse(string_option.second, &pass.m_output_scale);
+        else if (string_option.first == "Compute")
+          TryParse(string_option.second, &pass.m_compute);
+      }
+
+      if (pass.m_entry_point.empty() || !(pass.m_output_scale > 0.0f))
+      {
+        ERROR_LOG_FMT(VIDEO, "Ignoring invalid post-processing pass in {}", m_current_shader);
+        continue;
+      }
+
+      m_passes.push_back(std::move(pass));
+      continue;
+    }
+
     ConfigurationOption option;
     option.m_dirty = true;
 
@@ -398,6 +425,8 @@ void PostProcessing::RecompileShader()
 {
   m_pipeline.reset();
   m_pixel_shader.reset();
+  m_intermediate_passes.clear();
+  m_intermediate_source = nullptr;
   if (!CompilePixelShader())
     return;
   if (!CompileVertexShader())
@@ -412,6 +441,130 @@ void PostProcessing::RecompilePipeline()
   CompilePipeline();
 }
 
+static std::array<float, 4> NormalizeRect(const MathUtil::Rectangle<int>& rect,
+                                          const AbstractTexture* tex)
+{
+  const float rcp_width = 1.0f / tex->GetWidth();
+  const float rcp_height = 1.0f / tex->GetHeight();
+  return {static_cast<float>(rect.left) * rcp_width, static_cast<float>(rect.top) * rcp_height,
+          static_cast<float>(rect.GetWidth()) * rcp_width,
+          static_cast<float>(rect.GetHeight()) * rcp_height};
+}
+
+bool PostProcessing::ResizeIntermediatePass(IntermediatePass& pass, u32 width, u32 height,
+                                            u32 layers)
+{
+  if (pass.output_textures.size() == layers && pass.output_textures[0]->GetWidth() == width &&
+      pass.output_textures[0]->GetHeight() == height)
+  {
+    return true;
+  }
+
+  pass.output_framebuffers.clear();
+  pass.output_textures.clear();
+
+  const u32 flags = AbstractTextureFlag_RenderTarget |
+                    (pass.compute ? AbstractTextureFlag_ComputeImage : 0);
+  const TextureConfig config(width, height, 1, 1, 1, AbstractTextureFormat::RGBA8, flags);
+  for (u32 layer = 0; layer < layers; layer++)
+  {
+    auto texture = g_renderer->CreateTexture(config, "Post-processing pass texture");
+    if (!texture)
+      return false;
+
+    if (!pass.compute)
+    {
+      auto framebuffer = g_renderer->CreateFramebuffer(texture.get(), nullptr);
+      if (!framebuffer)
+        return false;
+      pass.output_framebuffers.push_back(std::move(framebuffer));
+    }
+
+    pass.output_textures.push_back(std::move(texture));
+  }
+
+  return true;
+}
+
+void PostProcessing::RunIntermediatePasses(const MathUtil::Rectangle<int>& src,
+                                           const AbstractTexture* src_tex, bool src_changed)
+{
+  if (m_intermediate_passes.empty())
+    return;
+
+  // A duplicate frame would produce the same results, unless the shader is animated.
+  if (!src_changed && !m_config.UsesTime() && m_intermediate_source == src_tex &&
+      m_intermediate_src_rect == src)
+  {
+    return;
+  }
+
+  m_intermediate_source = nullptr;
+  const u32 layers = src_tex->GetLayers();
+  for (size_t i = 0; i < m_intermediate_passes.size(); i++)
+  {
+    IntermediatePass& pass = m_intermediate_passes[i];
+    if ((!pass.compute && !pass.pipeline) || (pass.compute && !pass.shader))
+      return;
+
+    const u32 width = std::max(static_cast<u32>(src.GetWidth() * pass.output_scale), 1u);
+    const u32 height = std::max(static_cast<u32>(src.GetHeight() * pass.output_scale), 1u);
+    if (!ResizeIntermediatePass(pass, width, height, layers))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to create {}x{} post-processing pass texture", width, height);
+      pass.output_textures.clear();
+      pass.output_framebuffers.clear();
+      return;
+    }
+
+    for (u32 layer = 0; layer < layers; layer++)
+    {
+      // The first pass reads the source, later ones the output of the previous pass.
+      const AbstractTexture* input = src_tex;
+      int input_layer = static_cast<int>(layer);
+      std::array<float, 4> input_rect = NormalizeRect(src, src_tex);
+      if (i > 0)
+      {
+        input = m_intermediate_passes[i - 1].output_textures[layer].get();
+        input_layer = 0;
+        input_rect = {0.0f, 0.0f, 1.0f, 1.0f};
+      }
+
+      FillUniformBuffer(input_rect, input, input_layer, src, src_tex, static_cast<int>(layer));
+      g_vertex_manager->UploadUtilityUniforms(m_uniform_staging_buffer.data(),
+                                              static_cast<u32>(m_uniform_staging_buffer.size()));
+      g_renderer->SetTexture(0, input);
+      g_renderer->SetSamplerState(0, RenderState::GetLinearSamplerState());
+      g_renderer->SetTexture(1, src_tex);
+      g_renderer->SetSamplerState(1, RenderState::GetLinearSamplerState());
+
+      AbstractTexture* output = pass.output_textures[layer].get();
+      if (pass.compute)
+      {
+        g_renderer->SetComputeImageTexture(output, false, true);
+        g_renderer->DispatchComputeShader(pass.shader.get(), COMPUTE_GROUP_SIZE,
+                                          COMPUTE_GROUP_SIZE, 1,
+                                          (width + COMPUTE_GROUP_SIZE - 1) / COMPUTE_GROUP_SIZE,
+                                          (height + COMPUTE_GROUP_SIZE - 1) / COMPUTE_GROUP_SIZE,
+                                          1);
+        g_renderer->SetComputeImageTexture(nullptr, false, false);
+      }
+      else
+      {
+        AbstractFramebuffer* framebuffer = pass.output_framebuffers[layer].get();
+        g_renderer->SetAndDiscardFramebuffer(framebuffer);
+        g_renderer->SetViewportAndScissor(framebuffer->GetRect());
+        g_renderer->SetPipeline(pass.pipeline.get());
+        g_renderer->Draw(0, 3);
+      }
+      output->FinishedRendering();
+    }
+  }
+
+  m_intermediate_source = src_tex;
+  m_intermediate_src_rect = src;
+}
+
 void PostProcessing::BlitFromTexture(const MathUtil::Rectangle<int>& dst,
                                      const MathUtil::Rectangle<int>& src,
                                      const AbstractTexture* src_tex, int src_layer)
@@ -425,15 +578,34 @@ void PostProcessing::BlitFromTexture(const MathUtil::Rectangle<int>& dst,
   if (!m_pipeline)
     return;
 
-  FillUniformBuffer(src, src_tex, src_layer);
+  const AbstractTexture* input = src_tex;
+  int input_layer = src_layer;
+  std::array<float, 4> input_rect = NormalizeRect(src, src_tex);
+  if (!m_intermediate_passes.empty() && m_intermediate_source == src_tex &&
+      static_cast<size_t>(src_layer) < m_intermediate_passes.back().output_textures.size())
+  {
+    // The intermediate outputs cover the rectangle the passes ran on, which the source rectangle
+    // may have been cropped from.
+    const MathUtil::Rectangle<int>& covered = m_intermediate_src_rect;
+    input = m_intermediate_passes.back().output_textures[src_layer].get();
+    input_layer = 0;
+    input_rect = {static_cast<float>(src.left - covered.left) / covered.GetWidth(),
+                  static_cast<float>(src.top - covered.top) / covered.GetHeight(),
+                  static_cast<float>(src.GetWidth()) / covered.GetWidth(),
+                  static_cast<float>(src.GetHeight()) / covered.GetHeight()};
+  }
+
+  FillUniformBuffer(input_rect, input, input_layer, src, src_tex, src_layer);
   g_vertex_manager->UploadUtilityUniforms(m_uniform_staging_buffer.data(),
                                           static_cast<u32>(m_uniform_staging_buffer.size()));
 
   g_renderer->SetViewportAndScissor(
       g_renderer->ConvertFramebufferRectangle(dst, g_renderer->GetCurrentFramebuffer()));
   g_renderer->SetPipeline(m_pipeline.get());
-  g_renderer->SetTexture(0, src_tex);
+  g_renderer->SetTexture(0, input);
   g_renderer->SetSamplerState(0, RenderState::GetLinearSamplerState());
+  g_renderer->SetTexture(1, src_tex);
+  g_renderer->SetSamplerState(1, RenderState::GetLinearSamplerState());
   g_renderer->Draw(0, 3);
 }
 
@@ -447,9 +619,11 @@ std::string PostProcessing::GetUniformBufferHeader() const
   ss << "  float4 resolution;\n";
   ss << "  float4 window_resolution;\n";
   ss << "  float4 src_rect;\n";
+  ss << "  float4 original_rect;\n";
   ss << "  int src_layer;\n";
   ss << "  uint time;\n";
-  for (u32 i = 0; i < 2; i++)
+  ss << "  int original_layer;\n";
+  for (u32 i = 0; i < 1; i++)
     ss << "  uint ubo_align_" << unused_counter++ << "_;\n";
   ss << "\n";
 
@@ -492,11 +666,49 @@ std::string PostProcessing::GetUniformBufferHeader() const
   return ss.str();
 }
 
+// Functions which are the same for pixel and compute passes.
+static const char s_common_functions[] = R"(
+float2 GetWindowResolution()
+{
+  return window_resolution.xy;
+}
+
+float2 GetInvWindowResolution()
+{
+  return window_resolution.zw;
+}
+
+float2 GetResolution()
+{
+  return resolution.xy;
+}
+
+float2 GetInvResolution()
+{
+  return resolution.zw;
+}
+
+float2 GetOriginalCoordinates()
+{
+  return original_rect.xy + (GetCoordinates() - src_rect.xy) / src_rect.zw * original_rect.zw;
+}
+
+uint GetTime()
+{
+  return time;
+}
+
+#define GetOption(x) (x)
+#define OptionEnabled(x) ((x) != 0)
+
+)";
+
 std::string PostProcessing::GetHeader() const
 {
   std::ostringstream ss;
   ss << GetUniformBufferHeader();
   ss << "SAMPLER_BINDING(0) uniform sampler2DArray samp0;\n";
+  ss << "SAMPLER_BINDING(1) uniform sampler2DArray samp1;\n";
 
   if (g_ActiveConfig.backend_info.bSupportsGeometryShaders)
   {
@@ -517,56 +729,106 @@ float4 SampleLocation(float2 location) { return texture(samp0, float3(location,
 float4 SampleLayer(int layer) { return texture(samp0, float3(v_tex0.xy, float(layer))); }
 #define SampleOffset(offset) textureOffset(samp0, v_tex0, offset)
 
-float2 GetWindowResolution()
+float2 GetCoordinates()
 {
-  return window_resolution.xy;
+  return v_tex0.xy;
 }
 
-float2 GetInvWindowResolution()
+float GetLayer()
 {
-  return window_resolution.zw;
+  return v_tex0.z;
 }
 
-float2 GetResolution()
+void SetOutput(float4 color)
 {
-  return resolution.xy;
+  ocol0 = color;
+}
+)";
+  ss << s_common_functions;
+  ss << R"(
+float4 SampleOriginal()
+{
+  return texture(samp1, float3(GetOriginalCoordinates(), float(original_layer)));
+}
+float4 SampleOriginalLocation(float2 location)
+{
+  return texture(samp1, float3(location, float(original_layer)));
 }
 
-float2 GetInvResolution()
+)";
+  return ss.str();
+}
+
+std::string PostProcessing::GetComputeHeader() const
 {
-  return resolution.zw;
+  std::ostringstream ss;
+  ss << GetUniformBufferHeader();
+  ss << "SAMPLER_BINDING(0) uniform sampler2DArray samp0;\n";
+  ss << "SAMPLER_BINDING(1) uniform sampler2DArray samp1;\n";
+  ss << "IMAGE_BINDING(rgba8, 0) uniform writeonly image2DArray output_image;\n";
+
+  // There are no derivatives in compute shaders, so everything samples the top level.
+  ss << R"(
+float2 GetOutputResolution()
+{
+  return float2(imageSize(output_image).xy);
 }
 
 float2 GetCoordinates()
 {
-  return v_tex0.xy;
+  return src_rect.xy + (float2(gl_GlobalInvocationID.xy) + 0.5) / GetOutputResolution() * src_rect.zw;
 }
 
 float GetLayer()
 {
-  return v_tex0.z;
+  return float(src_layer);
 }
 
-uint GetTime()
-{
-  return time;
-}
+float4 Sample() { return textureLod(samp0, float3(GetCoordinates(), GetLayer()), 0.0); }
+float4 SampleLocation(float2 location) { return textureLod(samp0, float3(location, GetLayer()), 0.0); }
+float4 SampleLayer(int layer) { return textureLod(samp0, float3(GetCoordinates(), float(layer)), 0.0); }
+#define SampleOffset(offset) textureLodOffset(samp0, float3(GetCoordinates(), GetLayer()), 0.0, offset)
 
 void SetOutput(float4 color)
 {
-  ocol0 = color;
+  imageStore(output_image, int3(int2(gl_GlobalInvocationID.xy), 0), color);
+}
+)";
+  ss << s_common_functions;
+  ss << R"(
+float4 SampleOriginal()
+{
+  return textureLod(samp1, float3(GetOriginalCoordinates(), float(original_layer)), 0.0);
+}
+float4 SampleOriginalLocation(float2 location)
+{
+  return textureLod(samp1, float3(location, float(original_layer)), 0.0);
 }
-
-#define GetOption(x) (x)
-#define OptionEnabled(x) ((x) != 0)
 
 )";
   return ss.str();
 }
 
-std::string PostProcessing::GetFooter() const
+std::string PostProcessing::GetFooter(const std::string& entry_point) const
 {
-  return {};
+  // Single-pass shaders define main() themselves.
+  if (entry_point.empty() || entry_point == "main")
+    return {};
+
+  return fmt::format("\nvoid main() {{ {}(); }}\n", entry_point);
+}
+
+std::string PostProcessing::GetComputeFooter(const std::string& entry_point) const
+{
+  return fmt::format(R"(
+layout(local_size_x = {0}, local_size_y = {0}) in;
+void main()
+{{
+  if (all(lessThan(int2(gl_GlobalInvocationID.xy), int2(GetOutputResolution()))))
+    {1}();
+}}
+)",
+                     COMPUTE_GROUP_SIZE, entry_point);
 }
 
 bool PostProcessing::CompileVertexShader()
@@ -613,9 +875,11 @@ struct BuiltinUniforms
   float resolution[4];
   float window_resolution[4];
   float src_rect[4];
+  float original_rect[4];
   s32 src_layer;
   u32 time;
-  u32 padding[2];
+  s32 original_layer;
+  u32 padding;
 };
 
 size_t PostProcessing::CalculateUniformsSize() const
@@ -624,23 +888,24 @@ size_t PostProcessing::CalculateUniformsSize() const
   return sizeof(BuiltinUniforms) + m_config.GetOptions().size() * sizeof(float) * 4;
 }
 
-void PostProcessing::FillUniformBuffer(const MathUtil::Rectangle<int>& src,
-                                       const AbstractTexture* src_tex, int src_layer)
+void PostProcessing::FillUniformBuffer(const std::array<float, 4>& src_rect,
+                                       const AbstractTexture* src_tex, int src_layer,
+                                       const MathUtil::Rectangle<int>& original,
+                                       const AbstractTexture* original_tex, int original_layer)
 {
   const auto& window_rect = g_renderer->GetTargetRectangle();
-  const float rcp_src_width = 1.0f / src_tex->GetWidth();
-  const float rcp_src_height = 1.0f / src_tex->GetHeight();
+  const std::array<float, 4> original_rect = NormalizeRect(original, original_tex);
   BuiltinUniforms builtin_uniforms = {
       {static_cast<float>(src_tex->GetWidth()), static_cast<float>(src_tex->GetHeight()),
-       rcp_src_width, rcp_src_height},
+       1.0f / src_tex->GetWidth(), 1.0f / src_tex->GetHeight()},
       {static_cast<float>(window_rect.GetWidth()), static_cast<float>(window_rect.GetHeight()),
        1.0f / static_cast<float>(window_rect.GetWidth()),
        1.0f / static_cast<float>(window_rect.GetHeight())},
-      {static_cast<float>(src.left) * rcp_src_width, static_cast<float>(src.top) * rcp_src_height,
-       static_cast<float>(src.GetWidth()) * rcp_src_width,
-       static_cast<float>(src.GetHeight()) * rcp_src_height},
+      {src_rect[0], src_rect[1], src_rect[2], src_rect[3]},
+      {original_rect[0], original_rect[1], original_rect[2], original_rect[3]},
       static_cast<s32>(src_layer),
       static_cast<u32>(m_timer.ElapsedMs()),
+      static_cast<s32>(original_layer),
   };
 
   u8* buf = m_uniform_staging_buffer.data();
@@ -684,22 +949,18 @@ bool PostProcessing::CompilePixelShader()
 {
   m_pipeline.reset();
   m_pixel_shader.reset();
+  m_intermediate_passes.clear();
+  m_intermediate_source = nullptr;
 
   // Generate GLSL and compile the new shader.
   m_config.LoadShader(g_ActiveConfig.sPostProcessingShader);
-  m_pixel_shader = g_renderer->CreateShaderFromSource(
-      ShaderStage::Pixel, GetHeader() + m_config.GetShaderCode() + GetFooter(),
-      fmt::format("Post-processing pixel shader: {}", m_config.GetShader()));
-  if (!m_pixel_shader)
+  if (!CompilePassShaders())
   {
     PanicAlertFmt("Failed to compile post-processing shader {}", m_config.GetShader());
 
     // Use default shader.
     m_config.LoadDefaultShader();
-    m_pixel_shader = g_renderer->CreateShaderFromSource(
-        ShaderStage::Pixel, GetHeader() + m_config.GetShaderCode() + GetFooter(),
-        "Default post-processing pixel shader");
-    if (!m_pixel_shader)
+    if (!CompilePassShaders())
       return false;
   }
 
@@ -707,6 +968,74 @@ bool PostProcessing::CompilePixelShader()
   return true;
 }
 
+bool PostProcessing::CompilePassShaders()
+{
+  m_pixel_shader.reset();
+  m_intermediate_passes.clear();
+
+  const std::string& code = m_config.GetShaderCode();
+  const auto& passes = m_config.GetPasses();
+  if (passes.empty())
+  {
+    m_pixel_shader = g_renderer->CreateShaderFromSource(
+        ShaderStage::Pixel, GetHeader() + code + GetFooter({}),
+        fmt::format("Post-processing pixel shader: {}", m_config.GetShader()));
+    return m_pixel_shader != nullptr;
+  }
+
+  // The last pass draws to the screen, which compute shaders can't do, so they get a plain copy
+  // of their output added instead.
+  const bool copy_last_pass = passes.back().m_compute;
+  const size_t num_intermediate_passes = copy_last_pass ? passes.size() : passes.size() - 1;
+  for (size_t i = 0; i < num_intermediate_passes; i++)
+  {
+    const PostProcessingConfiguration::RenderPass& pass = passes[i];
+    IntermediatePass& intermediate_pass = m_intermediate_passes.emplace_back();
+    intermediate_pass.output_scale = pass.m_output_scale;
+    intermediate_pass.compute = pass.m_compute;
+    if (pass.m_compute)
+    {
+      if (!g_ActiveConfig.backend_info.bSupportsComputeShaders || pass.m_entry_point == "main")
+      {
+        ERROR_LOG_FMT(VIDEO, "Compute pass {} of {} is not supported", pass.m_entry_point,
+                      m_config.GetShader());
+        return false;
+      }
+
+      intermediate_pass.shader = g_renderer->CreateShaderFromSource(
+          ShaderStage::Compute, GetComputeHeader() + code + GetComputeFooter(pass.m_entry_point),
+          fmt::format("Post-processing compute shader: {} {}", m_config.GetShader(),
+                      pass.m_entry_point));
+    }
+    else
+    {
+      intermediate_pass.shader = g_renderer->CreateShaderFromSource(
+          ShaderStage::Pixel, GetHeader() + code + GetFooter(pass.m_entry_point),
+          fmt::format("Post-processing pixel shader: {} {}", m_config.GetShader(),
+                      pass.m_entry_point));
+    }
+
+    if (!intermediate_pass.shader)
+      return false;
+  }
+
+  if (copy_last_pass)
+  {
+    m_pixel_shader = g_renderer->CreateShaderFromSource(
+        ShaderStage::Pixel, GetHeader() + s_default_shader,
+        fmt::format("Post-processing pixel shader: {} copy", m_config.GetShader()));
+  }
+  else
+  {
+    m_pixel_shader = g_renderer->CreateShaderFromSource(
+        ShaderStage::Pixel, GetHeader() + code + GetFooter(passes.back().m_entry_point),
+        fmt::format("Post-processing pixel shader: {} {}", m_config.GetShader(),
+                    passes.back().m_entry_point));
+  }
+
+  return m_pixel_shader != nullptr;
+}
+
 bool PostProcessing::CompilePipeline()
 {
   AbstractPipelineConfig config = {};
@@ -723,6 +1052,21 @@ bool PostProcessing::CompilePipeline()
   if (!m_pipeline)
     return false;
 
+  // Intermediate passes render each layer separately to a single-layer texture, so they never
+  // use the geometry shader.
+  for (IntermediatePass& pass : m_intermediate_passes)
+  {
+    if (pass.compute)
+      continue;
+
+    config.geometry_shader = nullptr;
+    config.pixel_shader = pass.shader.get();
+    config.framebuffer_state = RenderState::GetColorFramebufferState(AbstractTextureFormat::RGBA8);
+    pass.pipeline = g_renderer->CreatePipeline(config);
+    if (!pass.pipeline)
+      return false;
+  }
+
   return true;
 }
 }  // namespace VideoCommon
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
@@ -13,6 +14,7 @@
 #include "Common/Timer.h"
 #include "VideoCommon/TextureConfig.h"
 
+class AbstractFramebuffer;
 class AbstractPipeline;
 class AbstractShader;
 class AbstractTexture;
@@ -55,6 +57,16 @@ public:
 
   using ConfigMap = std::map<std::string, ConfigurationOption>;
 
+  // A pass of a multi-pass shader, declared by a [Pass] section. Every pass but the last renders
+  // to an intermediate texture, which the following pass reads through Sample().
+  struct RenderPass
+  {
+    std::string m_entry_point;
+    // Size of the output relative to the source, e.g. 0.5 for half resolution.
+    float m_output_scale = 1.0f;
+    bool m_compute = false;
+  };
+
   PostProcessingConfiguration();
   virtual ~PostProcessingConfiguration();
 
@@ -72,6 +84,9 @@ public:
   const ConfigMap& GetOptions() const { return m_options; }
   ConfigMap& GetOptions() { return m_options; }
   const ConfigurationOption& GetOption(const std::string& option) { return m_options[option]; }
+  const std::vector<RenderPass>& GetPasses() const { return m_passes; }
+  // Shaders which use the time can't have their output reused for duplicate frames.
+  bool UsesTime() const { return m_current_shader_code.find("GetTime()") != std::string::npos; }
   // For updating option's values
   void SetOptionf(const std::string& option, int index, float value);
   void SetOptioni(const std::string& option, int index, s32 value);
@@ -82,6 +97,7 @@ private:
   std::string m_current_shader;
   std::string m_current_shader_code;
   ConfigMap m_options;
+  std::vector<RenderPass> m_passes;
 
   void LoadOptions(const std::string& code);
   void LoadOptionsConfiguration();
@@ -104,21 +120,49 @@ public:
   void RecompileShader();
   void RecompilePipeline();
 
+  // Runs the intermediate passes of a multi-pass shader for every layer of the source. These
+  // render to their own textures, so this must be called before the target framebuffer is bound.
+  // If the source hasn't changed since the last call, the previous results are reused.
+  void RunIntermediatePasses(const MathUtil::Rectangle<int>& src, const AbstractTexture* src_tex,
+                             bool src_changed);
+
+  // Runs the final pass to the current framebuffer, reading the intermediate results for the
+  // source if RunIntermediatePasses was called with it.
   void BlitFromTexture(const MathUtil::Rectangle<int>& dst, const MathUtil::Rectangle<int>& src,
                        const AbstractTexture* src_tex, int src_layer);
 
 protected:
+  static constexpr u32 COMPUTE_GROUP_SIZE = 8;
+
+  struct IntermediatePass
+  {
+    std::unique_ptr<AbstractShader> shader;
+    std::unique_ptr<AbstractPipeline> pipeline;
+    float output_scale = 1.0f;
+    bool compute = false;
+
+    // Stereo layers are processed separately, so there is one output for each source layer.
+    std::vector<std::unique_ptr<AbstractTexture>> output_textures;
+    std::vector<std::unique_ptr<AbstractFramebuffer>> output_framebuffers;
+  };
+
   std::string GetUniformBufferHeader() const;
   std::string GetHeader() const;
-  std::string GetFooter() const;
+  std::string GetComputeHeader() const;
+  std::string GetFooter(const std::string& entry_point) const;
+  std::string GetComputeFooter(const std::string& entry_point) const;
 
   bool CompileVertexShader();
   bool CompilePixelShader();
+  bool CompilePassShaders();
   bool CompilePipeline();
 
+  bool ResizeIntermediatePass(IntermediatePass& pass, u32 width, u32 height, u32 layers);
+
   size_t CalculateUniformsSize() const;
-  void FillUniformBuffer(const MathUtil::Rectangle<int>& src, const AbstractTexture* src_tex,
-                         int src_layer);
+  void FillUniformBuffer(const std::array<float, 4>& src_rect, const AbstractTexture* src_tex,
+                         int src_layer, const MathUtil::Rectangle<int>& original,
+                         const AbstractTexture* original_tex, int original_layer);
 
   // Timer for determining our time value
   Common::Timer m_timer;
@@ -129,5 +173,10 @@ protected:
   std::unique_ptr<AbstractPipeline> m_pipeline;
   AbstractTextureFormat m_framebuffer_format = AbstractTextureFormat::Undefined;
   std::vector<u8> m_uniform_staging_buffer;
+
+  std::vector<IntermediatePass> m_intermediate_passes;
+  // Source the intermediate passes last ran on, which their outputs cover.
+  const AbstractTexture* m_intermediate_source = nullptr;
+  MathUtil::Rectangle<int> m_intermediate_src_rect;
 };
 }  // namespace VideoCommon
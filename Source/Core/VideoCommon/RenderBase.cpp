@@ -16,10 +16,12 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <tuple>
+#include <utility>
 
 #include <fmt/format.h>
 #include <imgui.h>
@@ -62,11 +64,15 @@
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
+#include "VideoCommon/DrawCapture.h"
 #include "VideoCommon/FPSCounter.h"
 #include "VideoCommon/FrameDump.h"
+#include "VideoCommon/FrameStatsRecorder.h"
+#include "VideoCommon/FrameTimeline.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/FreeLookCamera.h"
+#include "VideoCommon/GPUTiming.h"
 #include "VideoCommon/GraphicsModSystem/Config/GraphicsModGroup.h"
 #include "VideoCommon/NetPlayChatUI.h"
 #include "VideoCommon/NetPlayGolfUI.h"
@@ -148,6 +154,8 @@ bool Renderer::Initialize()
     return false;
   }
 
+  m_gpu_timing = CreateGPUTiming();
+
   if (g_ActiveConfig.bGraphicMods)
   {
     // If a config change occurred in a previous session,
@@ -178,6 +186,7 @@ void Renderer::Shutdown()
   ShutdownImGui();
   m_post_processor.reset();
   m_bounding_box.reset();
+  m_gpu_timing.reset();
 }
 
 void Renderer::BeginUtilityDrawing()
@@ -421,6 +430,9 @@ bool Renderer::CalculateTargetSize()
       m_efb_scale *= 100;
   }
 
+  if (g_ActiveConfig.bDynamicResolution || g_ActiveConfig.bThermalGovernor)
+    m_efb_scale = m_dynamic_resolution.Apply(m_efb_scale);
+
   const u32 max_size = g_ActiveConfig.backend_info.MaxTextureSize;
   if (max_size < EFB_WIDTH * m_efb_scale / 100)
     m_efb_scale = max_size * 100 / EFB_WIDTH;
@@ -496,6 +508,7 @@ void Renderer::CheckForConfigChanges()
   const bool old_force_filtering = g_ActiveConfig.bForceFiltering;
   const bool old_vsync = g_ActiveConfig.bVSyncActive;
   const bool old_bbox = g_ActiveConfig.bBBoxEnable;
+  const AbstractTextureFormat old_efb_depth_format = FramebufferManager::GetEFBDepthFormat();
   const u32 old_game_mod_changes =
       g_ActiveConfig.graphics_mod_config ? g_ActiveConfig.graphics_mod_config->GetChangeCount() : 0;
   const bool old_graphics_mods_enabled = g_ActiveConfig.bGraphicMods;
@@ -552,6 +565,8 @@ void Renderer::CheckForConfigChanges()
     changed_bits |= CONFIG_CHANGE_BIT_VSYNC;
   if (old_bbox != g_ActiveConfig.bBBoxEnable)
     changed_bits |= CONFIG_CHANGE_BIT_BBOX;
+  if (old_efb_depth_format != FramebufferManager::GetEFBDepthFormat())
+    changed_bits |= CONFIG_CHANGE_BIT_EFB_DEPTH_FORMAT;
   if (CalculateTargetSize())
     changed_bits |= CONFIG_CHANGE_BIT_TARGET_SIZE;
 
@@ -563,7 +578,8 @@ void Renderer::CheckForConfigChanges()
   OnConfigChanged(changed_bits);
 
   // If there's any shader changes, wait for the GPU to finish before destroying anything.
-  if (changed_bits & (CONFIG_CHANGE_BIT_HOST_CONFIG | CONFIG_CHANGE_BIT_MULTISAMPLES))
+  if (changed_bits & (CONFIG_CHANGE_BIT_HOST_CONFIG | CONFIG_CHANGE_BIT_MULTISAMPLES |
+                      CONFIG_CHANGE_BIT_EFB_DEPTH_FORMAT))
   {
     WaitForGPUIdle();
     SetPipeline(nullptr);
@@ -571,13 +587,14 @@ void Renderer::CheckForConfigChanges()
 
   // Framebuffer changed?
   if (changed_bits & (CONFIG_CHANGE_BIT_MULTISAMPLES | CONFIG_CHANGE_BIT_STEREO_MODE |
-                      CONFIG_CHANGE_BIT_TARGET_SIZE))
+                      CONFIG_CHANGE_BIT_TARGET_SIZE | CONFIG_CHANGE_BIT_EFB_DEPTH_FORMAT))
   {
     g_framebuffer_manager->RecreateEFBFramebuffer();
   }
 
-  // Reload shaders if host config has changed.
-  if (changed_bits & (CONFIG_CHANGE_BIT_HOST_CONFIG | CONFIG_CHANGE_BIT_MULTISAMPLES))
+  // Reload shaders if host config has changed. Pipelines also depend on the EFB depth format.
+  if (changed_bits & (CONFIG_CHANGE_BIT_HOST_CONFIG | CONFIG_CHANGE_BIT_MULTISAMPLES |
+                      CONFIG_CHANGE_BIT_EFB_DEPTH_FORMAT))
   {
     OSD::AddMessage("Video config changed, reloading shaders.", OSD::Duration::NORMAL);
     g_vertex_manager->InvalidatePipelineObject();
@@ -610,7 +627,9 @@ void Renderer::DrawDebugText()
     ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - (10.0f * m_backbuffer_scale),
                                    5.0f * m_backbuffer_scale),
                             ImGuiCond_Always, ImVec2(4.9f, 0.0f));
-	ImGui::SetNextWindowSize(ImVec2(165.0f * m_backbuffer_scale, 30.0f * m_backbuffer_scale));
+    const bool thermally_limited = m_dynamic_resolution.IsThermallyLimited();
+	ImGui::SetNextWindowSize(ImVec2(165.0f * m_backbuffer_scale,
+                                    (thermally_limited ? 50.0f : 30.0f) * m_backbuffer_scale));
     ImGui::SetNextWindowBgAlpha(.6f);
 
     if (ImGui::Begin("FPS", nullptr,
@@ -622,6 +641,11 @@ void Renderer::DrawDebugText()
         const Core::PerformanceStatistics& pstats = Core::GetPerformanceStatistics();
         ImGui::TextColored(ImVec4(m_fps_counter.color[0], m_fps_counter.color[1], m_fps_counter.color[2], 1.0f),
                            "|MMJR2| FPS:%.f | %.f%%", pstats.FPS, pstats.Speed);
+        if (thermally_limited)
+        {
+          ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "Thermal: %.f%% res",
+                             m_dynamic_resolution.GetScaleFactor() * 100.0);
+        }
     }
     ImGui::End();
   }
@@ -667,6 +691,9 @@ void Renderer::DrawDebugText()
   if (g_ActiveConfig.bOverlayStats)
     g_stats.Display();
 
+  if (g_ActiveConfig.bShowFrameTimeline)
+    VideoCommon::g_frame_timeline.Display(1000000000.0 / VideoInterface::GetTargetRefreshRate());
+
   if (g_ActiveConfig.bShowNetPlayMessages && g_netplay_chat_ui)
     g_netplay_chat_ui->Display();
 
@@ -749,6 +776,7 @@ void Renderer::ChangeSurface(void* new_surface_handle)
   std::lock_guard<std::mutex> lock(m_swap_mutex);
   m_new_surface_handle = new_surface_handle;
   m_surface_changed.Set();
+  m_surface_lost.Set(new_surface_handle == nullptr);
 }
 
 void Renderer::ResizeSurface()
@@ -1258,7 +1286,9 @@ std::unique_lock<std::mutex> Renderer::GetImGuiLock()
 
 void Renderer::BeginUIFrame()
 {
-  if (IsHeadless())
+  // The surface can go away in between, so EndUIFrame has to match what was done here.
+  m_ui_frame_presented = !IsHeadless() && HasSurface();
+  if (!m_ui_frame_presented)
     return;
 
   BeginUtilityDrawing();
@@ -1272,7 +1302,7 @@ void Renderer::EndUIFrame()
     ImGui::Render();
   }
 
-  if (!IsHeadless())
+  if (m_ui_frame_presented)
   {
     DrawImGui();
 
@@ -1363,10 +1393,10 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
       m_is_game_widescreen = true;
   }
 
-  // Ensure the last frame was written to the dump.
-  // This is required even if frame dumping has stopped, since the frame dump is one frame
+  // Queue the frames whose readback has completed for writing to the dump.
+  // This is required even if frame dumping has stopped, since the frame dump is a few frames
   // behind the renderer.
-  FlushFrameDump();
+  QueueFinishedFrameDumps();
 
   if (g_ActiveConfig.bGraphicMods)
   {
@@ -1381,6 +1411,7 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
     MathUtil::Rectangle<int> xfb_rect;
     const auto* xfb_entry =
         g_texture_cache->GetXFBTexture(xfb_addr, fb_width, fb_height, fb_stride, &xfb_rect);
+    m_xfbs_since_last_frame++;
     if (xfb_entry &&
         (!g_ActiveConfig.bSkipPresentingDuplicateXFBs || xfb_entry->id != m_last_xfb_id))
     {
@@ -1401,10 +1432,32 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         ImGui::Render();
       }
 
+      // Fast movie playback only presents a few frames per second, which is enough to follow
+      // the movie. Nothing that is skipped here affects the emulated state.
+      // Without a surface, e.g. while the app is in the background on Android, the frame is
+      // dropped. The pending surface change is picked up once a new surface is set.
+      bool present = !IsHeadless() && HasSurface();
+      if (present && Movie::IsFastPlayback())
+      {
+        const u64 now = Common::Timer::NowMs();
+        present = now - m_last_fast_playback_present_ms >= FAST_PLAYBACK_PRESENT_INTERVAL_MS;
+        if (present)
+          m_last_fast_playback_present_ms = now;
+      }
+
       // Render the XFB to the screen.
       BeginUtilityDrawing();
-      if (!IsHeadless())
+      if (present)
       {
+        // Multi-pass post-processing renders to its own textures, so it has to happen before the
+        // backbuffer is bound. Duplicate frames reuse the results where possible.
+        if (!g_ActiveConfig.sPostProcessingShader.empty())
+        {
+          SetGPUTimingCategory(VideoCommon::GPUTimingCategory::PostProcessing);
+          m_post_processor->RunIntermediatePasses(xfb_rect, xfb_entry->texture.get(),
+                                                  !is_duplicate_frame);
+        }
+
         BindBackbuffer({{0.0f, 0.0f, 0.0f, 1.0f}});
 
         if (!is_duplicate_frame)
@@ -1416,10 +1469,18 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         auto render_target_rc = GetTargetRectangle();
         auto render_source_rc = xfb_rect;
         AdjustRectanglesToFitBounds(render_target_rc, render_source_rc);
+        SetGPUTimingCategory(g_ActiveConfig.sPostProcessingShader.empty() ?
+                                 VideoCommon::GPUTimingCategory::XFBPresent :
+                                 VideoCommon::GPUTimingCategory::PostProcessing);
         RenderXFBToScreen(render_target_rc, xfb_entry->texture.get(), render_source_rc);
 
+        SetGPUTimingCategory(VideoCommon::GPUTimingCategory::XFBPresent);
         DrawImGui();
 
+        // The frame's timestamps have to be written before it is submitted.
+        if (m_gpu_timing)
+          m_gpu_timing->EndFrame();
+
         // Present to the window system.
         {
           std::lock_guard<std::mutex> guard(m_swap_mutex);
@@ -1434,6 +1495,8 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
       if (!is_duplicate_frame)
       {
         m_fps_counter.Update();
+        VideoCommon::g_frame_timeline.EndFrame(g_ActiveConfig.bShowFrameTimeline,
+                                               g_stats.gpu_times_ns);
 
         DolphinAnalytics::PerformanceSample perf_sample;
         perf_sample.speed_ratio = SystemTimers::GetEstimatedEmulationPerformance();
@@ -1444,6 +1507,12 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         if (IsFrameDumping())
           DumpCurrentFrame(xfb_entry->texture.get(), xfb_rect, ticks, m_frame_count);
 
+        // The new size takes effect when the config changes are checked below.
+        UpdateDynamicResolution();
+
+        VideoCommon::g_frame_stats_recorder.OnFrameEnd();
+        VideoCommon::g_draw_capture.OnFrameEnd(m_frame_count);
+
         // Begin new frame
         m_frame_count++;
         g_stats.ResetFrame();
@@ -1489,10 +1558,13 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
 
       EndUtilityDrawing();
     }
-    else
+    else if (!xfb_entry)
     {
       Flush();
     }
+    // A skipped duplicate, e.g. on every other VI at 30 FPS, isn't flushed either. That would only
+    // split the work of the next frame in two, which costs an extra store and load of the EFB on
+    // tiled GPUs. The GPU is left to idle until the next frame is done or something waits for it.
 
     // Update our last xfb values
     m_last_xfb_addr = xfb_addr;
@@ -1507,6 +1579,43 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
   }
 }
 
+void Renderer::UpdateDynamicResolution()
+{
+  const u32 xfbs = std::exchange(m_xfbs_since_last_frame, 0);
+  m_dynamic_resolution.SetMinimumScale(
+      static_cast<u32>(std::max(g_ActiveConfig.iDynamicResolutionMinScale, 0)));
+  m_dynamic_resolution.UpdateThermalLimit(g_ActiveConfig.bThermalGovernor ?
+                                              DynamicResolution::GetThermalHeadroom() :
+                                              std::numeric_limits<float>::quiet_NaN());
+  if (!g_ActiveConfig.bDynamicResolution)
+  {
+    m_dynamic_resolution.Reset();
+    return;
+  }
+
+  u64 gpu_time = 0;
+  for (const u64 time : g_stats.gpu_times_ns)
+    gpu_time += time;
+
+  // Games which run at half the refresh rate output each frame twice, so they get twice the time.
+  const double refresh_rate = VideoInterface::GetTargetRefreshRate();
+  const u64 frame_budget =
+      refresh_rate > 0.0 ? static_cast<u64>(std::max(xfbs, 1u) * 1000000000.0 / refresh_rate) : 0;
+
+  m_dynamic_resolution.Update(gpu_time, frame_budget);
+}
+
+void Renderer::SetGPUTimingCategory(VideoCommon::GPUTimingCategory category)
+{
+  if (m_gpu_timing)
+    m_gpu_timing->SetCategory(category);
+}
+
+std::unique_ptr<VideoCommon::GPUTiming> Renderer::CreateGPUTiming() const
+{
+  return nullptr;
+}
+
 void Renderer::RenderXFBToScreen(const MathUtil::Rectangle<int>& target_rc,
                                  const AbstractTexture* source_texture,
                                  const MathUtil::Rectangle<int>& source_rc)
@@ -1525,6 +1634,15 @@ void Renderer::RenderXFBToScreen(const MathUtil::Rectangle<int>& target_rc,
   }
 }
 
+bool Renderer::CanCopyXFBToBackbuffer(const MathUtil::Rectangle<int>& target_rc,
+                                      const MathUtil::Rectangle<int>& source_rc) const
+{
+  return g_ActiveConfig.sPostProcessingShader.empty() &&
+         g_ActiveConfig.stereo_mode == StereoMode::Off &&
+         target_rc.GetWidth() == source_rc.GetWidth() &&
+         target_rc.GetHeight() == source_rc.GetHeight();
+}
+
 bool Renderer::IsFrameDumping() const
 {
   if (m_screenshot_request.IsSet())
@@ -1567,13 +1685,14 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  std::unique_ptr<AbstractStagingTexture> readback =
+      GetFrameDumpReadbackTexture(target_width, target_height);
+  if (!readback)
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_frame_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  readback->CopyFromTexture(src_texture, copy_rect, 0, 0, readback->GetRect());
+  m_frame_dump_readbacks.push_back(
+      {std::move(readback), m_frame_dump.FetchState(ticks, frame_number), m_frame_dump_swap_count});
 }
 
 bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -1603,79 +1722,110 @@ bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
   return true;
 }
 
-bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+std::unique_ptr<AbstractStagingTexture> Renderer::GetFrameDumpReadbackTexture(u32 target_width,
+                                                                              u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
-  if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
-    return true;
+  // Reuse a texture the dump thread is done with. This only blocks when the dump thread has
+  // fallen the maximum number of frames behind, rather than on every frame.
+  ReclaimFrameDumpTextures(MAX_QUEUED_FRAME_DUMPS - 1);
+  while (!m_frame_dump_free_textures.empty())
+  {
+    std::unique_ptr<AbstractStagingTexture> texture = std::move(m_frame_dump_free_textures.back());
+    m_frame_dump_free_textures.pop_back();
 
-  rbtex.reset();
-  rbtex = CreateStagingTexture(
+    // Textures of the wrong size are left over from a resolution change.
+    if (texture->GetWidth() == target_width && texture->GetHeight() == target_height)
+      return texture;
+  }
+
+  return CreateStagingTexture(
       StagingTextureType::Readback,
       TextureConfig(target_width, target_height, 1, 1, 1, AbstractTextureFormat::RGBA8, 0));
-  if (!rbtex)
-    return false;
-
-  return true;
 }
 
-void Renderer::FlushFrameDump()
+void Renderer::QueueFinishedFrameDumps()
 {
-  if (!m_frame_dump_needs_flush)
+  m_frame_dump_swap_count++;
+
+  // Shutdown frame dumping if it is no longer active, after writing the remaining frames.
+  if (!IsFrameDumping())
+  {
+    ShutdownFrameDumping();
     return;
+  }
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
+  // Screenshots are written straight away, as the user is waiting for them.
+  if (m_screenshot_request.IsSet())
+  {
+    FlushFrameDump();
+    return;
+  }
 
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  while (!m_frame_dump_readbacks.empty() &&
+         m_frame_dump_readbacks.front().swap_count + FRAME_DUMP_READBACK_LATENCY <=
+             m_frame_dump_swap_count)
+  {
+    QueueFrameDump(std::move(m_frame_dump_readbacks.front()));
+    m_frame_dump_readbacks.pop_front();
+  }
+}
+
+void Renderer::FlushFrameDump()
+{
+  while (!m_frame_dump_readbacks.empty())
+  {
+    QueueFrameDump(std::move(m_frame_dump_readbacks.front()));
+    m_frame_dump_readbacks.pop_front();
+  }
+}
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
+void Renderer::QueueFrameDump(FrameDumpReadback readback)
+{
+  // The texture stays mapped until the dump thread is done with it.
+  std::unique_ptr<AbstractStagingTexture>& output = readback.texture;
   output->Flush();
   if (output->Map())
   {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
+    const u8* data = reinterpret_cast<u8*>(output->GetMappedPointer());
+    const int width = output->GetConfig().width;
+    const int height = output->GetConfig().height;
+    const int stride = static_cast<int>(output->GetMappedStride());
+    m_frame_dump_output_textures.push_back(std::move(output));
+    DumpFrameData(data, width, height, stride, readback.state);
   }
   else
   {
     ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+    m_frame_dump_free_textures.push_back(std::move(output));
   }
-
-  m_frame_dump_needs_flush = false;
-
-  // Shutdown frame dumping if it is no longer active.
-  if (!IsFrameDumping())
-    ShutdownFrameDumping();
 }
 
 void Renderer::ShutdownFrameDumping()
 {
-  // Ensure the last queued readback has been sent to the encoder.
+  // Ensure the pending readbacks have been sent to the encoder.
   FlushFrameDump();
 
   if (!m_frame_dump_thread_running.IsSet())
     return;
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
-
-  // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
+  // Wake thread up, and wait for it to encode the queued frames and exit.
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_queue_lock);
+    m_frame_dump_thread_running.Clear();
+  }
+  m_frame_dump_queue_changed.notify_all();
   if (m_frame_dump_thread.joinable())
     m_frame_dump_thread.join();
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  ReclaimFrameDumpTextures(0);
+  m_frame_dump_free_textures.clear();
 }
 
-void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
+void Renderer::DumpFrameData(const u8* data, int w, int h, int stride,
+                             const FrameDump::FrameState& state)
 {
-  m_frame_dump_data = FrameDump::FrameData{data, w, h, stride, m_last_frame_state};
-
   if (!m_frame_dump_thread_running.IsSet())
   {
     if (m_frame_dump_thread.joinable())
@@ -1685,19 +1835,32 @@ void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
   }
 
   // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_queue_lock);
+    m_frame_dump_queue.push_back(FrameDump::FrameData{data, w, h, stride, state});
+  }
+  m_frame_dump_queue_changed.notify_all();
 }
 
-void Renderer::FinishFrameData()
+void Renderer::ReclaimFrameDumpTextures(size_t max_pending)
 {
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  size_t num_pending;
+  {
+    std::unique_lock<std::mutex> lk(m_frame_dump_queue_lock);
+    m_frame_dump_queue_changed.wait(
+        lk, [this, max_pending] { return m_frame_dump_queue.size() <= max_pending; });
+    num_pending = m_frame_dump_queue.size();
+  }
 
-  m_frame_dump_output_texture->Unmap();
+  // Frames are written in order, so the finished ones are at the front.
+  while (m_frame_dump_output_textures.size() > num_pending)
+  {
+    std::unique_ptr<AbstractStagingTexture> texture =
+        std::move(m_frame_dump_output_textures.front());
+    m_frame_dump_output_textures.pop_front();
+    texture->Unmap();
+    m_frame_dump_free_textures.push_back(std::move(texture));
+  }
 }
 
 void Renderer::FrameDumpThreadFunc()
@@ -1719,11 +1882,19 @@ void Renderer::FrameDumpThreadFunc()
 
   while (true)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
+    FrameDump::FrameData frame;
+    {
+      std::unique_lock<std::mutex> lk(m_frame_dump_queue_lock);
+      m_frame_dump_queue_changed.wait(lk, [this] {
+        return !m_frame_dump_queue.empty() || !m_frame_dump_thread_running.IsSet();
+      });
+
+      // Frames queued before shutdown are still written.
+      if (m_frame_dump_queue.empty())
+        break;
 
-    auto frame = m_frame_dump_data;
+      frame = m_frame_dump_queue.front();
+    }
 
     // Save screenshot
     if (m_screenshot_request.TestAndClear())
@@ -1762,7 +1933,12 @@ void Renderer::FrameDumpThreadFunc()
       }
     }
 
-    m_frame_dump_done.Set();
+    // Only remove the frame now, as the video thread unmaps its data once it is gone.
+    {
+      std::lock_guard<std::mutex> lk(m_frame_dump_queue_lock);
+      m_frame_dump_queue.pop_front();
+    }
+    m_frame_dump_queue_changed.notify_all();
   }
 
   if (frame_dump_started)
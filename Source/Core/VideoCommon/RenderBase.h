@@ -14,6 +14,8 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -28,6 +30,7 @@
 #include "Common/MathUtil.h"
 #include "VideoCommon/AsyncShaderCompiler.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/DynamicResolution.h"
 #include "VideoCommon/FPSCounter.h"
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
@@ -55,7 +58,9 @@ enum class AspectMode;
 
 namespace VideoCommon
 {
+class GPUTiming;
 class PostProcessing;
+enum class GPUTimingCategory : u32;
 }  // namespace VideoCommon
 
 struct EfbPokeData
@@ -235,17 +240,27 @@ public:
                                  const AbstractTexture* source_texture,
                                  const MathUtil::Rectangle<int>& source_rc);
 
+  // Whether RenderXFBToScreen could copy the XFB into the backbuffer as it is: there's no
+  // post-processing shader or stereo layout to apply, and the XFB isn't scaled.
+  bool CanCopyXFBToBackbuffer(const MathUtil::Rectangle<int>& target_rc,
+                              const MathUtil::Rectangle<int>& source_rc) const;
+
   // Called when the configuration changes, and backend structures need to be updated.
   virtual void OnConfigChanged(u32 bits) {}
 
+  // Marks the start of a kind of GPU work, for the GPU timings shown in the statistics.
+  void SetGPUTimingCategory(VideoCommon::GPUTimingCategory category);
+
   PixelFormat GetPrevPixelFormat() const { return m_prev_efb_format; }
   void StorePixelFormat(PixelFormat new_format) { m_prev_efb_format = new_format; }
   bool EFBHasAlphaChannel() const;
   VideoCommon::PostProcessing* GetPostProcessor() const { return m_post_processor.get(); }
   // Final surface changing
   // This is called when the surface is resized (WX) or the window changes (Android).
+  // A null handle means that the surface is gone, and nothing is presented until the next one.
   void ChangeSurface(void* new_surface_handle);
   void ResizeSurface();
+  bool HasSurface() const { return !m_surface_lost.IsSet(); }
   bool UseVertexDepthRange() const;
   void DoState(PointerWrap& p);
 
@@ -281,11 +296,13 @@ protected:
     CONFIG_CHANGE_BIT_ANISOTROPY = (1 << 4),
     CONFIG_CHANGE_BIT_FORCE_TEXTURE_FILTERING = (1 << 5),
     CONFIG_CHANGE_BIT_VSYNC = (1 << 6),
-    CONFIG_CHANGE_BIT_BBOX = (1 << 7)
+    CONFIG_CHANGE_BIT_BBOX = (1 << 7),
+    CONFIG_CHANGE_BIT_EFB_DEPTH_FORMAT = (1 << 8)
   };
 
   std::tuple<int, int> CalculateTargetScale(int x, int y) const;
   bool CalculateTargetSize();
+  void UpdateDynamicResolution();
 
   void CheckForConfigChanges();
 
@@ -314,6 +331,9 @@ protected:
 
   virtual std::unique_ptr<BoundingBox> CreateBoundingBox() const = 0;
 
+  // Backends which can write GPU timestamps return an implementation here.
+  virtual std::unique_ptr<VideoCommon::GPUTiming> CreateGPUTiming() const;
+
   AbstractFramebuffer* m_current_framebuffer = nullptr;
   const AbstractPipeline* m_current_pipeline = nullptr;
 
@@ -344,6 +364,8 @@ protected:
   void* m_new_surface_handle = nullptr;
   Common::Flag m_surface_changed;
   Common::Flag m_surface_resized;
+  Common::Flag m_surface_lost;
+  bool m_ui_frame_presented = false;
   std::mutex m_swap_mutex;
 
   // ImGui resources.
@@ -359,6 +381,10 @@ private:
   PixelFormat m_prev_efb_format = PixelFormat::INVALID_FMT;
   unsigned int m_efb_scale = 1;
 
+  DynamicResolution m_dynamic_resolution;
+  // Number of XFBs the game has output since the last unique frame, which sets the frame budget.
+  u32 m_xfbs_since_last_frame = 0;
+
   // These will be set on the first call to SetWindowSize.
   int m_last_window_request_width = 0;
   int m_last_window_request_height = 0;
@@ -368,29 +394,39 @@ private:
   std::thread m_frame_dump_thread;
   Common::Flag m_frame_dump_thread_running;
 
-  // Used to kick frame dump thread.
-  Common::Event m_frame_dump_start;
+  // Number of frames the dump thread can fall behind before the video thread waits for it. This
+  // absorbs spikes in encoding time, which would otherwise stall every frame.
+  static constexpr size_t MAX_QUEUED_FRAME_DUMPS = 3;
 
-  // Set by frame dump thread on frame completion.
-  Common::Event m_frame_dump_done;
-
-  // Holds emulation state during the last swap when dumping.
-  FrameDump::FrameState m_last_frame_state;
-
-  // Communication of frame between video and dump threads.
-  FrameDump::FrameData m_frame_dump_data;
+  // Frames waiting to be written by the dump thread, oldest first. The dump thread removes a
+  // frame once it is done with its data, and signals the condition variable both when frames
+  // are queued and when they are finished.
+  std::mutex m_frame_dump_queue_lock;
+  std::condition_variable m_frame_dump_queue_changed;
+  std::deque<FrameDump::FrameData> m_frame_dump_queue;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+  // Number of swaps a frame's readback is left in flight before it is mapped. By then the GPU has
+  // normally finished the copy, so mapping it doesn't wait for the GPU to catch up.
+  static constexpr u64 FRAME_DUMP_READBACK_LATENCY = 2;
+
+  struct FrameDumpReadback
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    FrameDump::FrameState state;
+    u64 swap_count;  // Value of m_frame_dump_swap_count when the frame was copied.
+  };
+
+  // Frames copied to readback textures but not yet queued for encoding, oldest first.
+  std::deque<FrameDumpReadback> m_frame_dump_readbacks;
+  u64 m_frame_dump_swap_count = 0;
+  // Mapped textures backing the frames in the queue, in the same order. Video thread only.
+  std::deque<std::unique_ptr<AbstractStagingTexture>> m_frame_dump_output_textures;
+  // Unmapped textures the dump thread has finished with, for reuse. Video thread only.
+  std::vector<std::unique_ptr<AbstractStagingTexture>> m_frame_dump_free_textures;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
@@ -398,6 +434,10 @@ private:
   // Tracking of XFB textures so we don't render duplicate frames.
   u64 m_last_xfb_id = std::numeric_limits<u64>::max();
   u64 m_last_xfb_ticks = 0;
+
+  // When the last frame was presented during fast movie playback.
+  static constexpr u64 FAST_PLAYBACK_PRESENT_INTERVAL_MS = 100;
+  u64 m_last_fast_playback_present_ms = 0;
   u32 m_last_xfb_addr = 0;
   u32 m_last_xfb_width = 0;
   u32 m_last_xfb_stride = 0;
@@ -405,6 +445,8 @@ private:
 
   std::unique_ptr<BoundingBox> m_bounding_box;
 
+  std::unique_ptr<VideoCommon::GPUTiming> m_gpu_timing;
+
   // Nintendo's SDK seems to write "default" bounding box values before every draw (1023 0 1023 0
   // are the only values encountered so far, which happen to be the extents allowed by the BP
   // registers) to reset the registers for comparison in the pixel engine, and presumably to detect
@@ -433,21 +475,29 @@ private:
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  // Returns a readback texture of the given size, reusing a free one if possible.
+  std::unique_ptr<AbstractStagingTexture> GetFrameDumpReadbackTexture(u32 target_width,
+                                                                      u32 target_height);
 
-  // Fills the frame dump staging texture with the current XFB texture.
+  // Copies the current XFB texture to a frame dump readback texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect, u64 ticks, int frame_number);
 
   // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  void DumpFrameData(const u8* data, int w, int h, int stride, const FrameDump::FrameState& state);
+
+  // Called once per swap. Queues the readbacks that are old enough for encoding.
+  void QueueFinishedFrameDumps();
 
   // Ensures all rendered frames are queued for encoding.
   void FlushFrameDump();
 
-  // Ensures all encoded frames have been written to the output file.
-  void FinishFrameData();
+  // Maps the readback texture and queues its frame for encoding.
+  void QueueFrameDump(FrameDumpReadback readback);
+
+  // Waits until at most max_pending frames are queued for encoding, then unmaps the textures of
+  // the frames that have been written so they can be reused.
+  void ReclaimFrameDumpTextures(size_t max_pending);
 
   std::unique_ptr<NetPlayChatUI> m_netplay_chat_ui;
 
@@ -3,11 +3,17 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
+#include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
+#include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Trace.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/ConstantManager.h"
@@ -38,6 +44,7 @@ ShaderCache::~ShaderCache()
 
 bool ShaderCache::Initialize()
 {
+  Common::Trace::ScopedEvent trace_event("ShaderCache::Initialize");
   m_api_type = g_ActiveConfig.backend_info.api_type;
   m_host_config.bits = ShaderHostConfig::GetCurrent().bits;
 
@@ -45,16 +52,20 @@ bool ShaderCache::Initialize()
     return false;
 
   m_async_shader_compiler = g_renderer->CreateAsyncShaderCompiler();
+  // Precompiling is background work, and shouldn't hold up the pipelines needed for drawing.
+  m_async_shader_compiler->SetBackgroundPriority(COMPILE_PRIORITY_UBERSHADER_PIPELINE);
   return true;
 }
 
 void ShaderCache::InitializeShaderCache()
 {
+  Common::Trace::ScopedEvent trace_event("ShaderCache::InitializeShaderCache");
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
 
   // Load shader and UID caches.
   if (g_ActiveConfig.bShaderCache && m_api_type != APIType::Nothing)
   {
+    Common::Trace::ScopedEvent load_trace_event("Load shader caches");
     LoadCaches();
     LoadPipelineUIDCache();
   }
@@ -64,9 +75,12 @@ void ShaderCache::InitializeShaderCache()
     QueueUberShaderPipelines();
 
   // Compile all known UIDs.
-  CompileMissingPipelines();
-  if (g_ActiveConfig.bWaitForShadersBeforeStarting)
-    WaitForAsyncCompiler();
+  {
+    Common::Trace::ScopedEvent compile_trace_event("Precompile pipelines");
+    CompileMissingPipelines();
+    if (g_ActiveConfig.bWaitForShadersBeforeStarting)
+      WaitForAsyncCompiler();
+  }
 
   // Switch to the runtime shader compiler thread configuration.
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
@@ -144,6 +158,22 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
   return {};
 }
 
+void ShaderCache::AddPendingPipelineDraw(const GXPipelineUid& uid, u32 num_indices)
+{
+  auto it = m_pending_gx_pipelines.find(uid);
+  if (it == m_pending_gx_pipelines.end())
+    return;
+
+  PendingGXPipeline& pending = it->second;
+  pending.pending_draw_indices += std::max<u32>(num_indices, 1);
+
+  const u32 boost =
+      std::min<u32>(IntLog2(pending.pending_draw_indices), MAX_PENDING_DRAW_PRIORITY_BOOST);
+  const u32 priority = COMPILE_PRIORITY_ONDEMAND_PIPELINE - boost;
+  if (priority < pending.priority)
+    PromotePipelineCompile(uid, priority);
+}
+
 const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineUid& uid)
 {
   auto it = m_gx_uber_pipeline_cache.find(uid);
@@ -226,7 +256,33 @@ static void UnserializePipelineUid(const SerializedUidType& uid, UidType& real_u
 }
 
 template <ShaderStage stage, typename K, typename T>
-void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid)
+static void AddCachedShader(T& cache, const K& key, std::unique_ptr<AbstractShader> shader)
+{
+  if (!shader)
+    return;
+
+  auto& entry = cache.shader_map[key];
+  entry.shader = std::move(shader);
+  entry.pending = false;
+
+  switch (stage)
+  {
+  case ShaderStage::Vertex:
+    INCSTAT(g_stats.num_vertex_shaders_created);
+    INCSTAT(g_stats.num_vertex_shaders_alive);
+    break;
+  case ShaderStage::Pixel:
+    INCSTAT(g_stats.num_pixel_shaders_created);
+    INCSTAT(g_stats.num_pixel_shaders_alive);
+    break;
+  default:
+    break;
+  }
+}
+
+template <ShaderStage stage, typename K, typename T>
+void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid,
+                                  bool index_only)
 {
   class CacheReader : public LinearDiskCacheReader<K, u8>
   {
@@ -234,27 +290,8 @@ void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type,
     CacheReader(T& cache_) : cache(cache_) {}
     void Read(const K& key, const u8* value, u32 value_size)
     {
-      auto shader = g_renderer->CreateShaderFromBinary(stage, value, value_size);
-      if (shader)
-      {
-        auto& entry = cache.shader_map[key];
-        entry.shader = std::move(shader);
-        entry.pending = false;
-
-        switch (stage)
-        {
-        case ShaderStage::Vertex:
-          INCSTAT(g_stats.num_vertex_shaders_created);
-          INCSTAT(g_stats.num_vertex_shaders_alive);
-          break;
-        case ShaderStage::Pixel:
-          INCSTAT(g_stats.num_pixel_shaders_created);
-          INCSTAT(g_stats.num_pixel_shaders_alive);
-          break;
-        default:
-          break;
-        }
-      }
+      AddCachedShader<stage>(cache, key,
+                             g_renderer->CreateShaderFromBinary(stage, value, value_size));
     }
 
   private:
@@ -262,17 +299,50 @@ void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type,
   };
 
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
+  if (index_only)
+  {
+    u32 count = cache.disk_cache.OpenAndIndex(filename, [&cache](const K& key, u64 offset,
+                                                                 u32 value_size) {
+      cache.disk_index[key] = {offset, value_size};
+    });
+    INFO_LOG_FMT(VIDEO, "Indexed {} cached shaders in {}", count, filename);
+    return;
+  }
+
   CacheReader reader(cache);
   u32 count = cache.disk_cache.OpenAndRead(filename, reader);
   INFO_LOG_FMT(VIDEO, "Loaded {} cached shaders from {}", count, filename);
 }
 
+template <ShaderStage stage, typename K, typename T>
+void ShaderCache::LoadIndexedShader(T& cache, const K& uid)
+{
+  auto iter = cache.disk_index.find(uid);
+  if (iter == cache.disk_index.end())
+    return;
+
+  const auto location = iter->second;
+  cache.disk_index.erase(iter);
+  if (cache.shader_map.find(uid) != cache.shader_map.end())
+    return;
+
+  std::vector<u8> binary(location.size);
+  if (!cache.disk_cache.ReadValue(location.offset, location.size, binary.data()))
+  {
+    WARN_LOG_FMT(VIDEO, "Failed to read a cached shader, it will be recompiled");
+    return;
+  }
+  AddCachedShader<stage>(cache, uid,
+                         g_renderer->CreateShaderFromBinary(stage, binary.data(), location.size));
+}
+
 template <typename T>
 void ShaderCache::ClearShaderCache(T& cache)
 {
   cache.disk_cache.Sync();
   cache.disk_cache.Close();
   cache.shader_map.clear();
+  cache.disk_index.clear();
 }
 
 template <typename KeyType, typename DiskKeyType, typename T>
@@ -364,11 +434,12 @@ void ShaderCache::LoadCaches()
       LoadShaderCache<ShaderStage::Geometry, GeometryShaderUid>(m_gs_cache, m_api_type, "gs",
                                                                 false);
 
-    // Specialized shaders, gameid-specific.
+    // Specialized shaders, gameid-specific. There can be thousands of them, so in low memory
+    // mode they're only loaded once a pipeline needs them.
     LoadShaderCache<ShaderStage::Vertex, VertexShaderUid>(m_vs_cache, m_api_type, "specialized-vs",
-                                                          true);
+                                                          true, g_ActiveConfig.bLowMemoryMode);
     LoadShaderCache<ShaderStage::Pixel, PixelShaderUid>(m_ps_cache, m_api_type, "specialized-ps",
-                                                        true);
+                                                        true, g_ActiveConfig.bLowMemoryMode);
   }
 
   if (g_ActiveConfig.backend_info.bSupportsPipelineCacheData)
@@ -384,6 +455,7 @@ void ShaderCache::LoadCaches()
 void ShaderCache::ClearCaches()
 {
   ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
+  m_pending_gx_pipelines.clear();
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
   ClearShaderCache(m_ps_cache);
@@ -417,10 +489,20 @@ void ShaderCache::ClearCaches()
 
 void ShaderCache::CompileMissingPipelines()
 {
-  // Queue all uids with a null pipeline for compilation.
+  // Pipelines from UID caches go first, in the order they were first used when they were
+  // recorded. Work items of the same priority are compiled in the order they are queued, so the
+  // pipelines a game needs soonest after booting are ready soonest.
+  for (const GXPipelineUid& uid : m_gx_pipeline_uid_order)
+  {
+    auto it = m_gx_pipeline_cache.find(uid);
+    if (it != m_gx_pipeline_cache.end() && !it->second.first && !it->second.second)
+      QueuePipelineCompile(uid, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+  }
+
+  // Queue all other uids with a null pipeline for compilation.
   for (auto& it : m_gx_pipeline_cache)
   {
-    if (!it.second.first)
+    if (!it.second.first && !it.second.second)
       QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
   }
   for (auto& it : m_gx_uber_pipeline_cache)
@@ -733,6 +815,7 @@ ShaderCache::GetGXPipelineConfig(const GXPipelineUid& config_in)
 {
   GXPipelineUid config = ApplyDriverBugs(config_in);
   const AbstractShader* vs;
+  LoadIndexedShader<ShaderStage::Vertex>(m_vs_cache, config.vs_uid);
   auto vs_iter = m_vs_cache.shader_map.find(config.vs_uid);
   if (vs_iter != m_vs_cache.shader_map.end() && !vs_iter->second.pending)
     vs = vs_iter->second.shader.get();
@@ -743,6 +826,7 @@ ShaderCache::GetGXPipelineConfig(const GXPipelineUid& config_in)
   ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &ps_uid);
 
   const AbstractShader* ps;
+  LoadIndexedShader<ShaderStage::Pixel>(m_ps_cache, ps_uid);
   auto ps_iter = m_ps_cache.shader_map.find(ps_uid);
   if (ps_iter != m_ps_cache.shader_map.end() && !ps_iter->second.pending)
     ps = ps_iter->second.shader.get();
@@ -850,6 +934,7 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
 {
   auto& entry = m_gx_pipeline_cache[config];
   entry.second = false;
+  m_pending_gx_pipelines.erase(config);
   if (!entry.first && pipeline)
   {
     entry.first = std::move(pipeline);
@@ -896,55 +981,51 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
   return entry.first.get();
 }
 
-void ShaderCache::LoadPipelineUIDCache()
+bool ShaderCache::ReadPipelineUIDCache(File::IOFile& file)
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
+  // Validate the version before reading entries.
+  u32 existing_magic;
+  u32 existing_version;
+  if (!file.ReadBytes(&existing_magic, sizeof(existing_magic)) ||
+      !file.ReadBytes(&existing_version, sizeof(existing_version)) ||
+      existing_magic != PIPELINE_UID_CACHE_MAGIC || existing_version != GX_PIPELINE_UID_VERSION)
+  {
+    return false;
+  }
+
+  // Ensure the expected size matches the actual size of the file. If it doesn't, it means
+  // the cache file may be corrupted, and we should not proceed with loading potentially
+  // garbage or invalid UIDs.
   constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
-      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
-  if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
+  const u64 file_size = file.GetSize();
+  const size_t uid_count =
+      static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
+  const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
+  if (file_size != expected_size)
+    return false;
+
+  for (size_t i = 0; i < uid_count; i++)
   {
-    // If an existing case exists, validate the version before reading entries.
-    u32 existing_magic;
-    u32 existing_version;
-    bool uid_file_valid = false;
-    if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
-        m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
-    {
-      // Ensure the expected size matches the actual size of the file. If it doesn't, it means
-      // the cache file may be corrupted, and we should not proceed with loading potentially
-      // garbage or invalid UIDs.
-      const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
-      const size_t uid_count =
-          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
-      const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
-      uid_file_valid = file_size == expected_size;
-      if (uid_file_valid)
-      {
-        for (size_t i = 0; i < uid_count; i++)
-        {
-          SerializedGXPipelineUid serialized_uid;
-          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
-          {
-            // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
-          }
-          else
-          {
-            uid_file_valid = false;
-            break;
-          }
-        }
-      }
+    SerializedGXPipelineUid serialized_uid;
+    if (!file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
+      return false;
 
-      // We open the file for reading and writing, so we must seek to the end before writing.
-      if (uid_file_valid)
-        uid_file_valid = m_gx_pipeline_uid_cache_file.Seek(expected_size, File::SeekOrigin::Begin);
-    }
+    // This just adds the pipeline to the map, it is compiled later.
+    AddSerializedGXPipelineUID(serialized_uid);
+  }
+
+  // We may open the file for reading and writing, so we must seek to the end before writing.
+  return file.Seek(expected_size, File::SeekOrigin::Begin);
+}
 
+void ShaderCache::LoadPipelineUIDCache()
+{
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  std::string filename = File::GetUserPath(D_CACHE_IDX) + game_id + ".uidcache";
+  if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
+  {
     // If the file is invalid, close it. We re-open and truncate it below.
-    if (!uid_file_valid)
+    if (!ReadPipelineUIDCache(m_gx_pipeline_uid_cache_file))
       m_gx_pipeline_uid_cache_file.Close();
   }
 
@@ -954,7 +1035,8 @@ void ShaderCache::LoadPipelineUIDCache()
     if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
     {
       // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
+      m_gx_pipeline_uid_cache_file.WriteBytes(&PIPELINE_UID_CACHE_MAGIC,
+                                              sizeof(PIPELINE_UID_CACHE_MAGIC));
       m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
                                               sizeof(GX_PIPELINE_UID_VERSION));
 
@@ -967,6 +1049,24 @@ void ShaderCache::LoadPipelineUIDCache()
   }
 
   INFO_LOG_FMT(VIDEO, "Read {} pipeline UIDs from {}", m_gx_pipeline_cache.size(), filename);
+
+  // UID caches in the same format can be shipped with the game INIs, so players who have never
+  // run the game get its pipelines compiled ahead of time too. Those pipelines are not written to
+  // the local UID cache, which only records what has been used here.
+  for (const std::string& directory : {File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP,
+                                       File::GetUserPath(D_GAMESETTINGS_IDX)})
+  {
+    const std::string shared_filename = directory + game_id + ".uidcache";
+    File::IOFile shared_file(shared_filename, "rb");
+    if (!shared_file.IsOpen())
+      continue;
+
+    const size_t known_uids = m_gx_pipeline_cache.size();
+    if (!ReadPipelineUIDCache(shared_file))
+      WARN_LOG_FMT(VIDEO, "{} is damaged or from a different version", shared_filename);
+    INFO_LOG_FMT(VIDEO, "Read {} new pipeline UIDs from {}",
+                 m_gx_pipeline_cache.size() - known_uids, shared_filename);
+  }
 }
 
 void ShaderCache::ClosePipelineUIDCache()
@@ -979,6 +1079,8 @@ void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
 {
   GXPipelineUid real_uid;
   UnserializePipelineUid(uid, real_uid);
+  if (!IsPipelineUidForCurrentConfig(real_uid))
+    return;
 
   auto iter = m_gx_pipeline_cache.find(real_uid);
   if (iter != m_gx_pipeline_cache.end())
@@ -987,6 +1089,23 @@ void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
   // Flag it as empty with a null pipeline object, for later compilation.
   auto& entry = m_gx_pipeline_cache[real_uid];
   entry.second = false;
+  m_gx_pipeline_uid_order.push_back(real_uid);
+}
+
+bool ShaderCache::IsPipelineUidForCurrentConfig(const GXPipelineUid& uid) const
+{
+  // Some UID bits come from the graphics settings rather than the game. Pipelines which were
+  // recorded with other settings would never be requested, so there's no point compiling them.
+  const pixel_shader_uid_data* ps_uid_data = uid.ps_uid.GetUidData();
+  if ((ps_uid_data->bounding_box && !g_ActiveConfig.bBBoxEnable) ||
+      (ps_uid_data->rgba6_format && g_ActiveConfig.bForceTrueColor) ||
+      (ps_uid_data->numColorChans != 0 && !g_ActiveConfig.bEnablePixelLighting))
+  {
+    return false;
+  }
+
+  const vertex_shader_uid_data* vs_uid_data = uid.vs_uid.GetUidData();
+  return vs_uid_data->vs_expand == VSExpand::None || g_ActiveConfig.UseVSForLinePointExpand();
 }
 
 void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
@@ -1027,8 +1146,10 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
     VertexShaderUid uid;
   };
 
-  m_vs_cache.shader_map[uid].pending = true;
+  auto& entry = m_vs_cache.shader_map[uid];
   auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid);
+  entry.pending = true;
+  entry.work_item = wi.get();
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
@@ -1085,8 +1206,10 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
     PixelShaderUid uid;
   };
 
-  m_ps_cache.shader_map[uid].pending = true;
+  auto& entry = m_ps_cache.shader_map[uid];
   auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid);
+  entry.pending = true;
+  entry.work_item = wi.get();
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
@@ -1139,6 +1262,8 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
 
       GXPipelineUid actual_uid = ApplyDriverBugs(uid);
 
+      shader_cache->LoadIndexedShader<ShaderStage::Vertex>(shader_cache->m_vs_cache,
+                                                           actual_uid.vs_uid);
       auto vs_it = shader_cache->m_vs_cache.shader_map.find(actual_uid.vs_uid);
       stages_ready &= vs_it != shader_cache->m_vs_cache.shader_map.end() && !vs_it->second.pending;
       if (vs_it == shader_cache->m_vs_cache.shader_map.end())
@@ -1147,6 +1272,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       PixelShaderUid ps_uid = actual_uid.ps_uid;
       ClearUnusedPixelShaderUidBits(shader_cache->m_api_type, shader_cache->m_host_config, &ps_uid);
 
+      shader_cache->LoadIndexedShader<ShaderStage::Pixel>(shader_cache->m_ps_cache, ps_uid);
       auto ps_it = shader_cache->m_ps_cache.shader_map.find(ps_uid);
       stages_ready &= ps_it != shader_cache->m_ps_cache.shader_map.end() && !ps_it->second.pending;
       if (ps_it == shader_cache->m_ps_cache.shader_map.end())
@@ -1162,6 +1288,8 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       return true;
     }
 
+    bool IsReady() const override { return !pipeline || pipeline->IsCompileComplete(); }
+
     void Retrieve() override
     {
       if (stages_ready)
@@ -1170,10 +1298,9 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       }
       else
       {
-        // Re-queue for next frame.
-        auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
-            shader_cache, uid, priority);
-        shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+        // Re-queue for next frame, at the priority the pipeline may have been promoted to.
+        shader_cache->QueuePipelineCompile(uid,
+                                           shader_cache->m_pending_gx_pipelines[uid].priority);
       }
     }
 
@@ -1187,10 +1314,32 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
   };
 
   auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority);
+  PendingGXPipeline& pending = m_pending_gx_pipelines[uid];
+  pending.work_item = wi.get();
+  pending.priority = priority;
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
   m_gx_pipeline_cache[uid].second = true;
 }
 
+void ShaderCache::PromotePipelineCompile(const GXPipelineUid& uid, u32 priority)
+{
+  PendingGXPipeline& pending = m_pending_gx_pipelines[uid];
+  pending.priority = priority;
+  m_async_shader_compiler->PromoteWorkItem(pending.work_item, priority);
+
+  // The pipeline can't be created before its shaders, so they have to move forward with it.
+  const GXPipelineUid actual_uid = ApplyDriverBugs(uid);
+  auto vs_it = m_vs_cache.shader_map.find(actual_uid.vs_uid);
+  if (vs_it != m_vs_cache.shader_map.end() && vs_it->second.pending)
+    m_async_shader_compiler->PromoteWorkItem(vs_it->second.work_item, priority);
+
+  PixelShaderUid ps_uid = actual_uid.ps_uid;
+  ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &ps_uid);
+  auto ps_it = m_ps_cache.shader_map.find(ps_uid);
+  if (ps_it != m_ps_cache.shader_map.end() && ps_it->second.pending)
+    m_async_shader_compiler->PromoteWorkItem(ps_it->second.work_item, priority);
+}
+
 void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority)
 {
   class UberPipelineWorkItem final : public AsyncShaderCompiler::WorkItem
@@ -1237,6 +1386,8 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
       return true;
     }
 
+    bool IsReady() const override { return !UberPipeline || UberPipeline->IsCompileComplete(); }
+
     void Retrieve() override
     {
       if (stages_ready)
@@ -12,6 +12,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -61,6 +62,19 @@ public:
   // Retrieves all pending shaders/pipelines from the async compiler.
   void RetrieveAsyncShaders();
 
+  // How long the shaders and pipelines needed for drawing took to compile in the background.
+  AsyncShaderCompiler::LatencyStats GetCompileLatencyStats() const
+  {
+    return m_async_shader_compiler->GetLatencyStats();
+  }
+
+  // Specialized shaders which are in the disk cache but haven't been loaded yet, in low memory
+  // mode.
+  size_t GetUnloadedShaderCount() const
+  {
+    return m_vs_cache.disk_index.size() + m_ps_cache.disk_index.size();
+  }
+
   // Accesses ShaderGen shader caches
   const AbstractPipeline* GetPipelineForUid(const GXPipelineUid& uid);
   const AbstractPipeline* GetUberPipelineForUid(const GXUberPipelineUid& uid);
@@ -69,6 +83,10 @@ public:
   // The optional will be empty if this pipeline is now background compiling.
   std::optional<const AbstractPipeline*> GetPipelineForUidAsync(const GXPipelineUid& uid);
 
+  // Records a draw which needed this pipeline while it was still compiling. The pipelines the
+  // most geometry is waiting on are moved forward in the compile queue.
+  void AddPendingPipelineDraw(const GXPipelineUid& uid, u32 num_indices);
+
   // Shared shaders
   const AbstractShader* GetScreenQuadVertexShader() const
   {
@@ -121,6 +139,9 @@ private:
   void ClearCaches();
   void LoadPipelineUIDCache();
   void ClosePipelineUIDCache();
+  // Adds the UIDs from a pipeline UID cache file. Returns false if the file is damaged or was
+  // written by a different version.
+  bool ReadPipelineUIDCache(File::IOFile& file);
   void CompileMissingPipelines();
   void QueueUberShaderPipelines();
   bool CompileSharedPipelines();
@@ -159,6 +180,7 @@ private:
   const AbstractPipeline* InsertGXUberPipeline(const GXUberPipelineUid& config,
                                                std::unique_ptr<AbstractPipeline> pipeline);
   void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
+  bool IsPipelineUidForCurrentConfig(const GXPipelineUid& uid) const;
   void AppendGXPipelineUID(const GXPipelineUid& config);
 
   // ASync Compiler Methods
@@ -167,11 +189,15 @@ private:
   void QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority);
   void QueuePixelUberShaderCompile(const UberShader::PixelShaderUid& uid, u32 priority);
   void QueuePipelineCompile(const GXPipelineUid& uid, u32 priority);
+  void PromotePipelineCompile(const GXPipelineUid& uid, u32 priority);
   void QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority);
 
   // Populating various caches.
   template <ShaderStage stage, typename K, typename T>
-  void LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid);
+  void LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid,
+                       bool index_only = false);
+  template <ShaderStage stage, typename K, typename T>
+  void LoadIndexedShader(T& cache, const K& uid);
   template <typename T>
   void ClearShaderCache(T& cache);
   template <typename KeyType, typename DiskKeyType, typename T>
@@ -184,6 +210,8 @@ private:
   // The shader cache is compiled last, as it is the least likely to be required. On demand
   // shaders are always compiled before pending ubershaders, as we want to use the ubershader
   // for as few frames as possible, otherwise we risk framerate drops.
+  static constexpr u32 PIPELINE_UID_CACHE_MAGIC = 0x44495550;  // PUID
+
   enum : u32
   {
     COMPILE_PRIORITY_ONDEMAND_PIPELINE = 100,
@@ -191,6 +219,10 @@ private:
     COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
   };
 
+  // On demand pipelines move one step forward each time the geometry drawn while waiting for
+  // them doubles, up to this many steps.
+  static constexpr u32 MAX_PENDING_DRAW_PRIORITY_BOOST = 32;
+
   // Configuration bits.
   APIType m_api_type;
   ShaderHostConfig m_host_config = {};
@@ -213,9 +245,19 @@ private:
     {
       std::unique_ptr<AbstractShader> shader;
       bool pending = false;
+      // Only valid while pending.
+      const AsyncShaderCompiler::WorkItem* work_item = nullptr;
     };
     std::map<Uid, Shader> shader_map;
     LinearDiskCache<Uid, u8> disk_cache;
+
+    // Shaders which are only read from disk_cache once they're needed, in low memory mode.
+    struct DiskLocation
+    {
+      u64 offset = 0;
+      u32 size = 0;
+    };
+    std::map<Uid, DiskLocation> disk_index;
   };
   ShaderModuleCache<VertexShaderUid> m_vs_cache;
   ShaderModuleCache<GeometryShaderUid> m_gs_cache;
@@ -228,6 +270,18 @@ private:
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
   File::IOFile m_gx_pipeline_uid_cache_file;
+
+  // Specialized pipelines which are compiling in the background, and the number of indices
+  // drawn while waiting for them.
+  struct PendingGXPipeline
+  {
+    const AsyncShaderCompiler::WorkItem* work_item = nullptr;
+    u32 priority = 0;
+    u64 pending_draw_indices = 0;
+  };
+  std::map<GXPipelineUid, PendingGXPipeline> m_pending_gx_pipelines;
+  // Pipelines read from UID caches, in the order they were recorded.
+  std::vector<GXPipelineUid> m_gx_pipeline_uid_order;
   LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
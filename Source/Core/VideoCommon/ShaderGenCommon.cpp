@@ -3,14 +3,47 @@
 
 #include "VideoCommon/ShaderGenCommon.h"
 
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Core/ConfigManager.h"
+#include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
+// Buffers are only kept if they have at least this capacity, which fits most specialized shaders.
+constexpr size_t SHADER_CODE_BUFFER_SIZE = 16384;
+constexpr size_t MAX_FREE_SHADER_CODE_BUFFERS = 4;
+static thread_local std::vector<std::string> s_free_shader_code_buffers;
+
+ShaderCode::ShaderCode()
+{
+  if (s_free_shader_code_buffers.empty())
+  {
+    m_buffer.reserve(SHADER_CODE_BUFFER_SIZE);
+    return;
+  }
+
+  m_buffer = std::move(s_free_shader_code_buffers.back());
+  s_free_shader_code_buffers.pop_back();
+  m_buffer.clear();
+}
+
+ShaderCode::~ShaderCode()
+{
+  if (m_buffer.capacity() >= SHADER_CODE_BUFFER_SIZE &&
+      s_free_shader_code_buffers.size() < MAX_FREE_SHADER_CODE_BUFFERS)
+  {
+    s_free_shader_code_buffers.push_back(std::move(m_buffer));
+  }
+}
+
 ShaderHostConfig ShaderHostConfig::GetCurrent()
 {
   ShaderHostConfig bits = {};
@@ -35,7 +68,8 @@ ShaderHostConfig ShaderHostConfig::GetCurrent()
   bits.backend_reversed_depth_range = g_ActiveConfig.backend_info.bSupportsReversedDepthRange;
   bits.backend_bitfield = g_ActiveConfig.backend_info.bSupportsBitfield;
   bits.backend_dynamic_sampler_indexing =
-      g_ActiveConfig.backend_info.bSupportsDynamicSamplerIndexing;
+      g_ActiveConfig.backend_info.bSupportsDynamicSamplerIndexing &&
+      !DriverDetails::HasPreference(DriverDetails::PREFER_STATIC_SAMPLER_INDEXING);
   bits.backend_shader_framebuffer_fetch = g_ActiveConfig.backend_info.bSupportsFramebufferFetch;
   bits.backend_logic_op = g_ActiveConfig.backend_info.bSupportsLogicOp;
   bits.backend_palette_conversion = g_ActiveConfig.backend_info.bSupportsPaletteConversion;
@@ -147,9 +181,9 @@ static void DefineOutputMember(ShaderCode& object, APIType api_type, std::string
   object.Write(";\n");
 }
 
-void GenerateVSOutputMembers(ShaderCode& object, APIType api_type, u32 texgens,
-                             const ShaderHostConfig& host_config, std::string_view qualifier,
-                             ShaderStage stage)
+static void GenerateVSOutputMembersUncached(ShaderCode& object, APIType api_type, u32 texgens,
+                                            const ShaderHostConfig& host_config,
+                                            std::string_view qualifier, ShaderStage stage)
 {
   // SPIRV-Cross names all semantics as "TEXCOORD"
   // Unfortunately Geometry shaders (which also uses this function)
@@ -228,6 +262,18 @@ void GenerateVSOutputMembers(ShaderCode& object, APIType api_type, u32 texgens,
   }
 }
 
+void GenerateVSOutputMembers(ShaderCode& object, APIType api_type, u32 texgens,
+                             const ShaderHostConfig& host_config, std::string_view qualifier,
+                             ShaderStage stage)
+{
+  static ShaderCodeBlockCache<std::tuple<APIType, u32, u32, std::string, ShaderStage>> s_cache;
+  s_cache.Write(object, {api_type, texgens, host_config.bits, std::string(qualifier), stage},
+                [&](ShaderCode& block) {
+                  GenerateVSOutputMembersUncached(block, api_type, texgens, host_config, qualifier,
+                                                  stage);
+                });
+}
+
 void AssignVSOutputMembers(ShaderCode& object, std::string_view a, std::string_view b, u32 texgens,
                            const ShaderHostConfig& host_config)
 {
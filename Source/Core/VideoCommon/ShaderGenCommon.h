@@ -6,7 +6,10 @@
 #include <cstring>
 #include <functional>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -106,9 +109,21 @@ private:
 class ShaderCode : public ShaderGeneratorInterface
 {
 public:
-  ShaderCode() { m_buffer.reserve(16384); }
+  // The buffer is recycled from ShaderCode objects which were destroyed on the same thread, so
+  // generating a shader usually doesn't allocate or grow it.
+  ShaderCode();
+  ~ShaderCode();
+
+  ShaderCode(const ShaderCode&) = default;
+  ShaderCode(ShaderCode&&) noexcept = default;
+  ShaderCode& operator=(const ShaderCode&) = default;
+  ShaderCode& operator=(ShaderCode&&) noexcept = default;
+
   const std::string& GetBuffer() const { return m_buffer; }
 
+  // Appends text which doesn't need formatting.
+  void WriteRaw(std::string_view text) { m_buffer.append(text); }
+
   // Writes format strings using fmtlib format strings.
   template <typename... Args>
   void Write(fmt::format_string<Args...> format, Args&&... args)
@@ -120,6 +135,40 @@ protected:
   std::string m_buffer;
 };
 
+// Blocks of generated shader code which only depend on a few parameters, like the host config.
+// They're generated once and copied into every later shader instead of being formatted again for
+// each UID. Safe to use from the shader compiler threads.
+template <typename Key>
+class ShaderCodeBlockCache
+{
+public:
+  // Appends the block for key to out. generate(ShaderCode&) writes it if it isn't cached yet.
+  template <typename Generator>
+  void Write(ShaderCode& out, const Key& key, Generator generate)
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      const auto iter = m_blocks.find(key);
+      if (iter != m_blocks.end())
+      {
+        out.WriteRaw(iter->second);
+        return;
+      }
+    }
+
+    ShaderCode block;
+    generate(block);
+    out.WriteRaw(block.GetBuffer());
+
+    std::lock_guard lk(m_mutex);
+    m_blocks.try_emplace(key, block.GetBuffer());
+  }
+
+private:
+  std::mutex m_mutex;
+  std::map<Key, std::string> m_blocks;
+};
+
 /**
  * Generates a shader constant profile which can be used to query which constants are used in a
  * shader
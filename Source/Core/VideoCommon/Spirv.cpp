@@ -8,12 +8,21 @@
 #include "ResourceLimits.h"
 #include "disassemble.h"
 
+#include <map>
+#include <mutex>
+#include <set>
+#include <tuple>
+
+#include <xxhash.h>
+
 #include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Version.h"
 
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -42,11 +51,162 @@ const TBuiltInResource* GetCompilerResourceLimits()
   return &glslang::DefaultTBuiltInResource;
 }
 
+// Compiled SPIR-V by the hash of its source and the compiler options. Specialized shaders of
+// different games, or of the same game with a different host config, often have the same source,
+// and parsing and optimizing it with glslang is by far the slowest part of compiling a shader.
+// The cache is shared by all games and backends which compile through here.
+class SpirvCache
+{
+public:
+  struct Key
+  {
+    u64 source_hash_low;
+    u64 source_hash_high;
+    u32 source_size;
+    u32 options;
+
+    bool operator<(const Key& other) const
+    {
+      return std::tie(source_hash_low, source_hash_high, source_size, options) <
+             std::tie(other.source_hash_low, other.source_hash_high, other.source_size,
+                      other.options);
+    }
+  };
+
+  static SpirvCache& GetInstance()
+  {
+    static SpirvCache cache;
+    return cache;
+  }
+
+  static Key MakeKey(EShLanguage stage, APIType api_type,
+                     glslang::EShTargetLanguageVersion language_version, std::string_view source)
+  {
+    // Two differently seeded 64-bit hashes, so that a collision is practically impossible.
+    const u64 hash_low = XXH64(source.data(), source.size(), 0);
+    const u64 hash_high = XXH64(source.data(), source.size(), 0x9E3779B97F4A7C15);
+    // The SPIR-V version is stored in bits 8-23 of EShTargetLanguageVersion.
+    const u32 options = (static_cast<u32>(stage) & 0xFF) |
+                        ((static_cast<u32>(api_type) & 0xFF) << 8) |
+                        ((static_cast<u32>(language_version) >> 8) << 16);
+    return {hash_low, hash_high, static_cast<u32>(source.size()), options};
+  }
+
+  void SetFileName(std::string filename)
+  {
+    std::lock_guard lk(m_mutex);
+    m_file.Close();
+    m_prebuilt_file.Close();
+    m_index.clear();
+    m_prebuilt_index.clear();
+    m_appended.clear();
+    m_opened = false;
+    m_filename = std::move(filename);
+  }
+
+  std::optional<SPIRV::CodeVector> Find(const Key& key)
+  {
+    std::lock_guard lk(m_mutex);
+    Open();
+    if (std::optional<SPIRV::CodeVector> code = Read(m_prebuilt_file, m_prebuilt_index, key))
+      return code;
+    return Read(m_file, m_index, key);
+  }
+
+  void Insert(const Key& key, const SPIRV::CodeVector& code)
+  {
+    std::lock_guard lk(m_mutex);
+    Open();
+    if (m_prebuilt_index.find(key) != m_prebuilt_index.end() ||
+        m_index.find(key) != m_index.end() || !m_appended.insert(key).second)
+    {
+      return;
+    }
+
+    // The code of entries written this session isn't kept around. Shaders which are needed again
+    // are found in the shader caches of the backends until the next session.
+    m_file.Append(key, code.data(), static_cast<u32>(code.size()));
+    m_file.Sync();
+  }
+
+private:
+  using CacheFile = LinearDiskCache<Key, SPIRV::CodeType>;
+  using Index = std::map<Key, std::pair<u64, u32>>;
+
+  static std::optional<SPIRV::CodeVector> Read(CacheFile& file, const Index& index, const Key& key)
+  {
+    const auto iter = index.find(key);
+    if (iter == index.end())
+      return std::nullopt;
+
+    SPIRV::CodeVector code(iter->second.second);
+    if (!file.ReadValue(iter->second.first, iter->second.second, code.data()))
+      return std::nullopt;
+    return code;
+  }
+
+  // The cache is started over when it grows beyond this, rather than tracking which entries are
+  // still used.
+  static constexpr u64 MAX_FILE_SIZE = 256 * 1024 * 1024;
+
+  void Open()
+  {
+    if (m_opened)
+      return;
+    m_opened = true;
+
+    std::string filename = m_filename;
+    if (filename.empty())
+    {
+      // The prebuilt cache is written by the same build, so it's rejected as a whole if it's from
+      // another version. Shaders generated for a different host config simply aren't found.
+      const std::string prebuilt_filename =
+          File::GetSysDirectory() + SPIRV::PREBUILT_CACHE_FILENAME;
+      const u32 prebuilt_count = m_prebuilt_file.OpenReadOnlyAndIndex(
+          prebuilt_filename, [this](const Key& key, u64 offset, u32 value_size) {
+            m_prebuilt_index[key] = {offset, value_size};
+          });
+      INFO_LOG_FMT(VIDEO, "Indexed {} prebuilt SPIR-V shaders in {}", prebuilt_count,
+                   prebuilt_filename);
+
+      filename = GetDiskShaderCacheFileName(APIType::Nothing, "spirv", false, false, false);
+      if (File::GetSize(filename) > MAX_FILE_SIZE)
+        File::Delete(filename);
+    }
+
+    const u32 count =
+        m_file.OpenAndIndex(filename, [this](const Key& key, u64 offset, u32 value_size) {
+          m_index[key] = {offset, value_size};
+        });
+    INFO_LOG_FMT(VIDEO, "Indexed {} cached SPIR-V shaders in {}", count, filename);
+  }
+
+  std::mutex m_mutex;
+  bool m_opened = false;
+  // Overrides the user's SPIR-V cache, if set.
+  std::string m_filename;
+  CacheFile m_file;
+  Index m_index;
+  CacheFile m_prebuilt_file;
+  Index m_prebuilt_index;
+  std::set<Key> m_appended;
+};
+
 std::optional<SPIRV::CodeVector>
 CompileShaderToSPV(EShLanguage stage, APIType api_type,
                    glslang::EShTargetLanguageVersion language_version, const char* stage_filename,
                    std::string_view source)
 {
+  // Shaders compiled with debug info for the validation layers aren't cached.
+  const bool use_cache = g_ActiveConfig.bShaderCache && !g_ActiveConfig.bEnableValidationLayer;
+  const SpirvCache::Key cache_key =
+      SpirvCache::MakeKey(stage, api_type, language_version, source);
+  if (use_cache)
+  {
+    if (std::optional<SPIRV::CodeVector> cached = SpirvCache::GetInstance().Find(cache_key))
+      return cached;
+  }
+
   if (!InitializeGlslang())
     return std::nullopt;
 
@@ -156,12 +316,20 @@ CompileShaderToSPV(EShLanguage stage, APIType api_type,
   if (!spv_messages.empty())
     WARN_LOG_FMT(VIDEO, "SPIR-V conversion messages: {}", spv_messages);
 
+  if (use_cache)
+    SpirvCache::GetInstance().Insert(cache_key, out_code);
+
   return out_code;
 }
 }  // namespace
 
 namespace SPIRV
 {
+void SetCacheFileName(std::string filename)
+{
+  SpirvCache::GetInstance().SetFileName(std::move(filename));
+}
+
 std::optional<CodeVector> CompileVertexShader(std::string_view source_code, APIType api_type,
                                               glslang::EShTargetLanguageVersion language_version)
 {
@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -19,6 +20,14 @@ namespace SPIRV
 using CodeType = u32;
 using CodeVector = std::vector<CodeType>;
 
+// SPIR-V cache in the Sys directory, which is generated at build time by dolphin-tool. It holds
+// the ubershaders of common host configs, and is searched before the user's SPIR-V cache.
+constexpr char PREBUILT_CACHE_FILENAME[] = "ubershaders.spirv";
+
+// Writes the shaders compiled from now on to the given file instead of the user's SPIR-V cache,
+// without searching the prebuilt cache. Used to generate the prebuilt cache.
+void SetCacheFileName(std::string filename);
+
 // Compile a vertex shader to SPIR-V.
 std::optional<CodeVector> CompileVertexShader(std::string_view source_code, APIType api_type,
                                               glslang::EShTargetLanguageVersion language_version);
@@ -3,12 +3,18 @@
 
 #include "VideoCommon/Statistics.h"
 
+#include <algorithm>
 #include <cstring>
 #include <utility>
 
 #include <imgui.h>
 
+#include "Core/PowerPC/JitInterface.h"
+
 #include "VideoCommon/BPFunctions.h"
+#include "VideoCommon/Fifo.h"
+#include "VideoCommon/HiresTextures.h"
+#include "VideoCommon/ShaderCache.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -71,14 +77,63 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  if (g_ActiveConfig.iTextureCacheBudgetMB > 0)
+  {
+    draw_statistic("Texture memory", "%d MB (%d MB pooled) / %d MB", texture_cache_kb / 1024,
+                   texture_pool_kb / 1024, g_ActiveConfig.iTextureCacheBudgetMB);
+    draw_statistic("Textures evicted", "%d", num_textures_evicted);
+  }
+  else
+  {
+    draw_statistic("Texture memory", "%d MB (%d MB pooled)", texture_cache_kb / 1024,
+                   texture_pool_kb / 1024);
+  }
+  if (g_ActiveConfig.bHiresTextures)
+    draw_statistic("Custom texture memory", "%zu MB", HiresTexture::GetMemoryUsage() >> 20);
+  draw_statistic("Texture overlap checks", "%d", this_frame.num_texture_overlap_checks);
+  draw_statistic("Texture hashes skipped", "%d", this_frame.num_texture_hashes_skipped);
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
   draw_statistic("vshaders alive", "%d", num_vertex_shaders_alive);
   draw_statistic("shaders changes", "%d", this_frame.num_shader_changes);
+  if (g_shader_cache)
+  {
+    const VideoCommon::AsyncShaderCompiler::LatencyStats latency =
+        g_shader_cache->GetCompileLatencyStats();
+    if (latency.samples != 0)
+    {
+      draw_statistic("Shader compile latency", "%.1f / %.1f / %.1f ms (p50/p95/p99)",
+                     latency.p50_us / 1000.0f, latency.p95_us / 1000.0f, latency.p99_us / 1000.0f);
+    }
+    if (g_ActiveConfig.bLowMemoryMode)
+      draw_statistic("Shaders left on disk", "%zu", g_shader_cache->GetUnloadedShaderCount());
+  }
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
+  draw_statistic("Ubershader draw calls", "%d (%.0f%%)", this_frame.num_ubershader_draw_calls,
+                 100.0f * this_frame.num_ubershader_draw_calls /
+                     std::max(this_frame.num_draw_calls, 1));
+  if (this_frame.draw_state_bind_ns != 0)
+  {
+    draw_statistic("Draw state binding", "%.0f us (%.0f ns/draw)",
+                   this_frame.draw_state_bind_ns / 1000.0f,
+                   static_cast<float>(this_frame.draw_state_bind_ns) /
+                       std::max(this_frame.num_draw_calls, 1));
+  }
+  for (u32 i = 0; i < VideoCommon::NUM_GPU_TIMING_CATEGORIES; i++)
+  {
+    if (gpu_times_ns[i] == 0)
+      continue;
+
+    draw_statistic(VideoCommon::GetGPUTimingCategoryName(
+                       static_cast<VideoCommon::GPUTimingCategory>(i)),
+                   "%.2f ms GPU", gpu_times_ns[i] / 1000000.0f);
+  }
+  if (this_frame.num_render_passes != 0)
+    draw_statistic("Render passes", "%d", this_frame.num_render_passes);
+  draw_statistic("BP flushes avoided", "%d", this_frame.num_bp_flushes_avoided);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
   draw_statistic("Primitives (DL)", "%d", this_frame.num_dl_prims);
   draw_statistic("XF loads", "%d", this_frame.num_xf_loads);
@@ -91,11 +146,33 @@ void Statistics::Display() const
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
+  draw_statistic("Vertex loader compiles", "%d", this_frame.num_vertex_loader_compiles);
+  draw_statistic("EFB copy flushes:", "%d", this_frame.num_efb_copy_flushes);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
 
+  const JitInterface::CodeSpaceStats jit_stats = JitInterface::GetCodeSpaceStats();
+  draw_statistic("JIT code space", "%u%% (%u/%u KiB)", jit_stats.usage_percent, jit_stats.used_kb,
+                 jit_stats.size_kb);
+  draw_statistic("JIT evicted blocks", "%u", jit_stats.evicted_blocks);
+  draw_statistic("JIT cache clears", "%u", jit_stats.full_clears);
+  draw_statistic("JIT far code share", "%u%%", jit_stats.far_code_percent);
+
+  const Fifo::SyncGPUStats sync_stats = Fifo::GetSyncGPUStats();
+  if (sync_stats.enabled)
+  {
+    draw_statistic("GPU sync distance", "%d%s", sync_stats.max_distance,
+                   sync_stats.adaptive ? " (adaptive)" : "");
+    if (sync_stats.adaptive)
+    {
+      draw_statistic("GPU sync waits", "%u (%u%% of time)", sync_stats.waits,
+                     sync_stats.wait_percent);
+      draw_statistic("GPU idle", "%u%%", sync_stats.idle_percent);
+    }
+  }
+
   ImGui::Columns(1);
 
   ImGui::End();
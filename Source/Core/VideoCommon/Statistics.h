@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "VideoCommon/BPFunctions.h"
+#include "VideoCommon/GPUTiming.h"
 
 struct Statistics
 {
@@ -18,9 +19,18 @@ struct Statistics
   int num_textures_created;
   int num_textures_uploaded;
   int num_textures_alive;
+  int num_textures_evicted;
+  // Memory taken by the textures in the texture cache, including EFB copies and custom textures,
+  // and by the unused textures kept around for reuse.
+  int texture_cache_kb;
+  int texture_pool_kb;
 
   int num_vertex_loaders;
 
+  // GPU time spent on each kind of work in the most recent frame which has been read back, which
+  // trails the current frame by a few frames. Only measured by backends that support timestamps.
+  VideoCommon::GPUTimes gpu_times_ns{};
+
   std::array<float, 6> proj;
   std::array<float, 16> gproj;
   std::array<float, 16> g2proj;
@@ -51,6 +61,16 @@ struct Statistics
 
     int num_primitive_joins;
     int num_draw_calls;
+    int num_ubershader_draw_calls;
+    // CPU time the backend spent binding state and descriptors for draws. Only measured by
+    // backends that support it, and only while the overlay is shown.
+    int draw_state_bind_ns;
+    // Render passes begun by the backend. On tiled GPUs each one loads and stores the tiles.
+    int num_render_passes;
+    int num_bp_flushes_avoided;
+    int num_vertex_loader_compiles;
+    int num_texture_overlap_checks;
+    int num_texture_hashes_skipped;
 
     int num_dlists_called;
 
@@ -69,6 +89,7 @@ struct Statistics
     int tev_pixels_in;
     int tev_pixels_out;
 
+    int num_efb_copy_flushes;
     int num_efb_peeks;
     int num_efb_pokes;
 
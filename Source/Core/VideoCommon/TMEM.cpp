@@ -99,6 +99,12 @@ static u32 CalculateUnitSize(TextureUnitState::BankConfig bank_config);
 
 static std::array<TextureUnitState, 8> s_unit;
 
+// FinalizeBinds only depends on the unit states and the used textures, and leaves the states as
+// they'd be after running it again. Most draws don't change either, so the overlap checks are only
+// redone after something has changed.
+static bool s_units_changed = true;
+static BitSet32 s_finalized_textures;
+
 // On TMEM configuration changed:
 // 1. invalidate stage.
 
@@ -108,6 +114,7 @@ void ConfigurationChanged(TexUnitAddress bp_addr, u32 config)
 
   // If anything has changed, we can't assume existing state is still valid.
   unit_state.state = TextureUnitState::State::INVALID;
+  s_units_changed = true;
 
   // Note: BPStructs has already filtered out NOP changes before calling us
   switch (bp_addr.Reg)
@@ -138,6 +145,7 @@ void InvalidateAll()
   {
     unit.state = TextureUnitState::State::INVALID;
   }
+  s_units_changed = true;
 }
 
 // On invalidate cache:
@@ -160,6 +168,7 @@ void Invalidate([[maybe_unused]] u32 param)
 void Bind(u32 unit, int width, int height, bool is_mipmapped, bool is_32_bit)
 {
   TextureUnitState& unit_state = s_unit[unit];
+  s_units_changed = true;
 
   // All textures use the even bank.
   // It holds the level 0 mipmap (and other even mipmap LODs, if mipmapping is enabled)
@@ -248,6 +257,12 @@ bool TextureUnitState::Overlaps(const TextureUnitState& other) const
 // Scans though active texture units checks for overlaps.
 void FinalizeBinds(BitSet32 used_textures)
 {
+  if (!s_units_changed && used_textures == s_finalized_textures)
+    return;
+
+  s_units_changed = false;
+  s_finalized_textures = used_textures;
+
   for (u32 i : used_textures)
   {
     if (s_unit[i].even.Overlaps(s_unit[i].odd))
@@ -280,11 +295,14 @@ bool IsValid(u32 unit)
 void Init()
 {
   s_unit.fill({});
+  s_units_changed = true;
 }
 
 void DoState(PointerWrap& p)
 {
   p.DoArray(s_unit);
+  if (p.IsReadMode())
+    s_units_changed = true;
 }
 
 }  // namespace TMEM
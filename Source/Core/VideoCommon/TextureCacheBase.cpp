@@ -7,6 +7,7 @@
 #include <cmath>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -35,7 +36,10 @@
 #include "VideoCommon/AbstractFramebuffer.h"
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameTimeline.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/GPUTiming.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModActionData.h"
 #include "VideoCommon/HiresTextures.h"
@@ -51,6 +55,7 @@
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
+#include "VideoCommon/VideoState.h"
 
 static const u64 TEXHASH_INVALID = 0;
 // Sonic the Fighters (inside Sonic Gems Collection) loops a 64 frames animation
@@ -132,6 +137,7 @@ void TextureCacheBase::Invalidate()
   }
   textures_by_address.clear();
   textures_by_hash.clear();
+  texture_sizes.clear();
 
   texture_pool.clear();
 }
@@ -150,7 +156,9 @@ void TextureCacheBase::ForceReload()
 void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 {
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.bHiresTexturesStreaming != backup_config.hires_textures_streaming ||
+      config.iHiresTexturesMemoryLimit != backup_config.hires_textures_memory_limit)
   {
     HiresTexture::Update();
   }
@@ -237,6 +245,83 @@ void TextureCacheBase::Cleanup(int _frameCount)
       ++iter2;
     }
   }
+
+  EnforceMemoryBudget(_frameCount);
+}
+
+void TextureCacheBase::EnforceMemoryBudget(int frame_count)
+{
+  size_t cache_bytes = 0;
+  for (const auto& it : textures_by_address)
+    cache_bytes += it.second->texture->GetConfig().GetSizeInBytes();
+  size_t pool_bytes = 0;
+  for (const auto& it : texture_pool)
+    pool_bytes += it.first.GetSizeInBytes();
+
+  const size_t budget = static_cast<size_t>(std::max(g_ActiveConfig.iTextureCacheBudgetMB, 0))
+                        << 20;
+  if (budget != 0 && cache_bytes + pool_bytes > budget)
+  {
+    pool_bytes -= EvictPooledTextures(cache_bytes + pool_bytes - budget);
+
+    if (cache_bytes > budget)
+    {
+      // EFB copies can't be recreated, and textures used this frame or bound for the next draw
+      // would come straight back, so only the others are candidates.
+      std::vector<TexAddrCache::iterator> candidates;
+      for (auto iter = textures_by_address.begin(); iter != textures_by_address.end(); ++iter)
+      {
+        const TCacheEntry* entry = iter->second;
+        if (entry->IsCopy() || entry->tmem_only || entry->frameCount >= frame_count ||
+            std::find(bound_textures.begin(), bound_textures.end(), entry) !=
+                bound_textures.end())
+        {
+          continue;
+        }
+        candidates.push_back(iter);
+      }
+      std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs->second->frameCount < rhs->second->frameCount;
+      });
+
+      // Invalidated textures go to the pool, where they are freed in turn.
+      for (const TexAddrCache::iterator& iter : candidates)
+      {
+        if (cache_bytes <= budget)
+          break;
+        const size_t size = iter->second->texture->GetConfig().GetSizeInBytes();
+        InvalidateTexture(iter);
+        cache_bytes -= size;
+        pool_bytes += size;
+        INCSTAT(g_stats.num_textures_evicted);
+      }
+      pool_bytes -= EvictPooledTextures(cache_bytes + pool_bytes - std::min(budget, cache_bytes));
+    }
+  }
+
+  SETSTAT(g_stats.texture_cache_kb, cache_bytes / 1024);
+  SETSTAT(g_stats.texture_pool_kb, pool_bytes / 1024);
+}
+
+size_t TextureCacheBase::EvictPooledTextures(size_t bytes_to_free)
+{
+  std::vector<TexPool::iterator> candidates;
+  candidates.reserve(texture_pool.size());
+  for (auto iter = texture_pool.begin(); iter != texture_pool.end(); ++iter)
+    candidates.push_back(iter);
+  std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs->second.frameCount < rhs->second.frameCount;
+  });
+
+  size_t bytes_freed = 0;
+  for (const TexPool::iterator& iter : candidates)
+  {
+    if (bytes_freed >= bytes_to_free)
+      break;
+    bytes_freed += iter->first.GetSizeInBytes();
+    texture_pool.erase(iter);
+  }
+  return bytes_freed;
 }
 
 bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -257,6 +342,8 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.hires_textures_streaming = config.bHiresTexturesStreaming;
+  backup_config.hires_textures_memory_limit = config.iHiresTexturesMemoryLimit;
   backup_config.stereo_3d = config.stereo_mode != StereoMode::Off;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
@@ -331,7 +418,7 @@ TextureCacheBase::ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLU
     g_renderer->EndUtilityDrawing();
   }
 
-  textures_by_address.emplace(decoded_entry->addr, decoded_entry);
+  AddToAddressMap(decoded_entry->addr, decoded_entry);
 
   return decoded_entry;
 }
@@ -377,7 +464,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::ReinterpretEntry(const TCacheEn
   g_renderer->EndUtilityDrawing();
   reinterpreted_entry->texture->FinishedRendering();
 
-  textures_by_address.emplace(reinterpreted_entry->addr, reinterpreted_entry);
+  AddToAddressMap(reinterpreted_entry->addr, reinterpreted_entry);
 
   return reinterpreted_entry;
 }
@@ -446,20 +533,7 @@ void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfi
   if (skip_readback || CheckReadbackTexture(config.width, config.height, config.format))
   {
     // First, measure the amount of memory needed.
-    u32 total_size = 0;
-    for (u32 layer = 0; layer < config.layers; layer++)
-    {
-      for (u32 level = 0; level < config.levels; level++)
-      {
-        u32 level_width = std::max(config.width >> level, 1u);
-        u32 level_height = std::max(config.height >> level, 1u);
-
-        u32 stride = AbstractTexture::CalculateStrideForFormat(config.format, level_width);
-        u32 size = stride * level_height;
-
-        total_size += size;
-      }
-    }
+    u32 total_size = GetSerializedTextureSize(config);
 
     // Set aside total_size bytes of space for the textures.
     // When measuring, this will be set aside and not written to,
@@ -500,6 +574,128 @@ void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfi
   }
 }
 
+u32 TextureCacheBase::GetSerializedTextureSize(const TextureConfig& config)
+{
+  u32 total_size = 0;
+  for (u32 layer = 0; layer < config.layers; layer++)
+  {
+    for (u32 level = 0; level < config.levels; level++)
+    {
+      const u32 level_width = std::max(config.width >> level, 1u);
+      const u32 level_height = std::max(config.height >> level, 1u);
+      total_size +=
+          AbstractTexture::CalculateStrideForFormat(config.format, level_width) * level_height;
+    }
+  }
+  return total_size;
+}
+
+TextureConfig TextureCacheBase::GetSerializedTextureConfig(const TCacheEntry* entry,
+                                                           bool native_resolution)
+{
+  const TextureConfig& config = entry->texture->GetConfig();
+  if (!native_resolution || !entry->IsEfbCopy() || config.levels != 1 ||
+      (config.width <= entry->native_width && config.height <= entry->native_height))
+  {
+    return config;
+  }
+
+  // The texture cache already handles EFB copies whose texture is smaller than the internal
+  // resolution, so these are scaled up again the next time they are used as the source of
+  // another copy, or replaced when the game redraws them.
+  return TextureConfig(entry->native_width, entry->native_height, 1, config.layers, 1,
+                       config.format, config.flags | AbstractTextureFlag_RenderTarget);
+}
+
+void TextureCacheBase::ReadBackTextures(const std::vector<TCacheEntry*>& entries,
+                                        const std::vector<TextureConfig>& configs,
+                                        const std::vector<u8*>& texture_data)
+{
+  // Copies of all textures are queued before reading any of them, so the GPU only has to be
+  // waited on once per batch instead of once per texture. The batches are limited in size to
+  // keep the staging textures from using too much memory at high internal resolutions.
+  constexpr size_t MAX_BATCH_SIZE = 64 * 1024 * 1024;
+
+  struct PendingReadback
+  {
+    std::unique_ptr<AbstractStagingTexture> staging_texture;
+    u8* destination;
+    u32 stride;
+  };
+  std::vector<PendingReadback> batch;
+  size_t batch_size = 0;
+
+  const auto read_batch = [&] {
+    for (PendingReadback& readback : batch)
+    {
+      readback.staging_texture->ReadTexels(readback.staging_texture->GetConfig().GetRect(),
+                                           readback.destination, readback.stride);
+    }
+    batch.clear();
+    batch_size = 0;
+  };
+
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    const TextureConfig& config = configs[i];
+    const AbstractTexture* texture = entries[i]->texture.get();
+
+    // Copies saved at native resolution are scaled down on the GPU first.
+    std::optional<TexPoolEntry> scaled_texture;
+    if (config.width != texture->GetWidth() || config.height != texture->GetHeight())
+    {
+      scaled_texture = AllocateTexture(config);
+      if (!scaled_texture)
+      {
+        ERROR_LOG_FMT(VIDEO, "Failed to allocate texture for serialization");
+        continue;
+      }
+
+      g_renderer->ScaleTexture(scaled_texture->framebuffer.get(), config.GetRect(), texture,
+                               texture->GetConfig().GetRect());
+      texture = scaled_texture->texture.get();
+    }
+
+    u8* destination = texture_data[i];
+    for (u32 layer = 0; layer < config.layers; layer++)
+    {
+      for (u32 level = 0; level < config.levels; level++)
+      {
+        const u32 level_width = std::max(config.width >> level, 1u);
+        const u32 level_height = std::max(config.height >> level, 1u);
+        const u32 stride = AbstractTexture::CalculateStrideForFormat(config.format, level_width);
+        const u32 size = stride * level_height;
+        if (!batch.empty() && batch_size + size > MAX_BATCH_SIZE)
+          read_batch();
+
+        const TextureConfig staging_config(level_width, level_height, 1, 1, 1, config.format, 0);
+        std::unique_ptr<AbstractStagingTexture> staging_texture =
+            g_renderer->CreateStagingTexture(StagingTextureType::Readback, staging_config);
+        if (!staging_texture)
+        {
+          PanicAlertFmt("Failed to create staging texture for serialization");
+          return;
+        }
+
+        staging_texture->CopyFromTexture(texture, config.GetMipRect(level), layer, level,
+                                         staging_config.GetRect());
+        batch.push_back({std::move(staging_texture), destination, stride});
+        batch_size += size;
+        destination += size;
+      }
+    }
+
+    // The copies have been queued, so the scaled texture can go back to the pool.
+    if (scaled_texture)
+    {
+      const TextureConfig scaled_config = scaled_texture->texture->GetConfig();
+      texture_pool.emplace(scaled_config, std::move(*scaled_texture));
+    }
+  }
+
+  read_batch();
+}
+
 std::optional<TextureCacheBase::TexPoolEntry> TextureCacheBase::DeserializeTexture(PointerWrap& p)
 {
   TextureConfig config;
@@ -587,7 +783,7 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
   // of address/hash to entry ID.
   std::vector<std::pair<u32, u32>> textures_by_address_list;
   std::vector<std::pair<u64, u32>> textures_by_hash_list;
-  if (Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE))
+  if (VideoCommon_ShouldSaveGPUState())
   {
     for (const auto& it : textures_by_address)
     {
@@ -607,16 +803,30 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
     }
   }
 
-  // Save the texture cache entries out in the order the were referenced.
+  // Save the texture cache entries out in the order the were referenced. Only space for the
+  // texture data is set aside here, it's read back from the GPU in batches afterwards.
+  const bool native_resolution = Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_AT_NATIVE_RESOLUTION);
+  std::vector<TextureConfig> texture_configs;
+  std::vector<u8*> texture_data;
+  texture_configs.reserve(entries_to_save.size());
+  texture_data.reserve(entries_to_save.size());
   u32 size = static_cast<u32>(entries_to_save.size());
   p.Do(size);
   for (TCacheEntry* entry : entries_to_save)
   {
-    SerializeTexture(entry->texture.get(), entry->texture->GetConfig(), p);
+    TextureConfig config = GetSerializedTextureConfig(entry, native_resolution);
+    p.Do(config);
+    u32 total_size = GetSerializedTextureSize(config);
+    texture_data.push_back(p.DoExternal(total_size));
+    texture_configs.push_back(config);
     entry->DoState(p);
   }
   p.DoMarker("TextureCacheEntries");
 
+  // If the buffer was too small, p is in measure mode now and the pointers aren't usable.
+  if (p.IsWriteMode())
+    ReadBackTextures(entries_to_save, texture_configs, texture_data);
+
   // Save references for each cache entry.
   // As references are circular, we need to have everything created before linking entries.
   std::set<std::pair<u32, u32>> reference_pairs;
@@ -727,7 +937,7 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     TCacheEntry* entry = GetEntry(id);
     if (entry)
-      textures_by_address.emplace(addr, entry);
+      AddToAddressMap(addr, entry);
   }
 
   // Fill in hash map.
@@ -797,6 +1007,7 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, const u8
   auto iter = FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes);
   while (iter.first != iter.second)
   {
+    INCSTAT(g_stats.this_frame.num_texture_overlap_checks);
     TCacheEntry* entry = iter.first->second;
     if (entry != entry_to_update && entry->IsCopy() && !entry->tmem_only &&
         entry->references.count(entry_to_update) == 0 &&
@@ -946,39 +1157,6 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, const u8
   return entry_to_update;
 }
 
-void TextureCacheBase::DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level,
-                                   bool is_arbitrary)
-{
-  std::string szDir = File::GetUserPath(D_DUMPTEXTURES_IDX) + SConfig::GetInstance().GetGameID();
-
-  // make sure that the directory exists
-  if (!File::IsDirectory(szDir))
-    File::CreateDir(szDir);
-
-  if (is_arbitrary)
-  {
-    basename += "_arb";
-  }
-
-  if (level > 0)
-  {
-    if (!g_ActiveConfig.bDumpMipmapTextures)
-      return;
-    basename += fmt::format("_mip{}", level);
-  }
-  else
-  {
-    if (!g_ActiveConfig.bDumpBaseTextures)
-      return;
-  }
-
-  const std::string filename = fmt::format("{}/{}.png", szDir, basename);
-  if (File::Exists(filename))
-    return;
-
-  entry->texture->Save(filename, level);
-}
-
 // Helper for checking if a BPMemory TexMode0 register is set to Point
 // Filtering modes. This is used to decide whether Anisotropic enhancements
 // are (mostly) safe in the VideoBackends.
@@ -1213,8 +1391,31 @@ private:
   std::vector<Level> levels;
 };
 
+// Checks whether an entry which was created while its custom texture was still streaming in should
+// be recreated, because a more complete version of the custom texture has been loaded since.
+static bool IsCustomTextureOutdated(TextureCacheBase::TCacheEntry* entry,
+                                    const TextureInfo& texture_info)
+{
+  if (!entry->custom_tex_pending)
+    return false;
+
+  const u64 generation = HiresTexture::GetStreamingGeneration();
+  if (entry->custom_tex_generation == generation)
+    return false;
+
+  entry->custom_tex_generation = generation;
+  const std::shared_ptr<HiresTexture> hires_tex =
+      HiresTexture::Search(texture_info, &entry->custom_tex_pending);
+  if (!hires_tex)
+    return false;
+
+  return !entry->is_custom_tex || hires_tex->m_levels[0].width != entry->texture->GetWidth();
+}
+
 TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
+  VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::TextureCache);
+
   // if this stage was not invalidated by changes to texture registers, keep the current texture
   if (TMEM::IsValid(texture_info.GetStage()) && bound_textures[texture_info.GetStage()])
   {
@@ -1226,10 +1427,19 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture
       return entry;
     }
 
+    // If the memory can't have changed since the entry was last checked, don't hash it again.
+    const u64 memory_epoch = Fifo::GetMemoryEpoch();
+    if (memory_epoch != 0 && entry->hash_checked_epoch == memory_epoch)
+    {
+      INCSTAT(g_stats.this_frame.num_texture_hashes_skipped);
+      return entry;
+    }
+
     // Otherwise, hash the backing memory and check it's unchanged.
     // FIXME: this doesn't correctly handle textures from tmem.
     if (!entry->tmem_only && entry->base_hash == entry->CalculateHash())
     {
+      entry->hash_checked_epoch = memory_epoch;
       return entry;
     }
   }
@@ -1240,13 +1450,15 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture
     return nullptr;
 
   entry->frameCount = FRAMECOUNT_INVALID;
-  if (entry->texture_info_name.empty() && g_ActiveConfig.bGraphicMods)
+  if (entry->texture_info_name.empty() && g_ActiveConfig.bGraphicMods &&
+      g_renderer->GetGraphicsModManager().HasTextureActions())
   {
     entry->texture_info_name = texture_info.CalculateTextureName().GetFullName();
+    entry->texture_info_name_hash = GraphicsModManager::HashTextureName(entry->texture_info_name);
 
     GraphicsModActionData::TextureLoad texture_load{entry->texture_info_name};
     for (const auto action :
-         g_renderer->GetGraphicsModManager().GetTextureLoadActions(entry->texture_info_name))
+         g_renderer->GetGraphicsModManager().GetTextureLoadActions(entry->texture_info_name_hash))
     {
       action->OnTextureLoad(&texture_load);
     }
@@ -1442,6 +1654,12 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
+        if (IsCustomTextureOutdated(entry, texture_info))
+        {
+          iter = InvalidateTexture(iter);
+          continue;
+        }
+
         entry = DoPartialTextureUpdates(iter->second, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
         entry->texture->FinishedRendering();
@@ -1508,7 +1726,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
       // All parameters, except the address, need to match here
       if (entry->format == full_format && entry->native_levels >= texture_info.GetLevelCount() &&
           entry->native_width == texture_info.GetRawWidth() &&
-          entry->native_height == texture_info.GetRawHeight())
+          entry->native_height == texture_info.GetRawHeight() &&
+          !IsCustomTextureOutdated(entry, texture_info))
       {
         entry = DoPartialTextureUpdates(hash_iter->second, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
@@ -1527,9 +1746,11 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
   }
 
   std::shared_ptr<HiresTexture> hires_tex;
+  bool hires_tex_pending = false;
+  const u64 hires_tex_generation = HiresTexture::GetStreamingGeneration();
   if (g_ActiveConfig.bHiresTextures)
   {
-    hires_tex = HiresTexture::Search(texture_info);
+    hires_tex = HiresTexture::Search(texture_info, &hires_tex_pending);
 
     if (hires_tex)
     {
@@ -1574,8 +1795,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
   if (hires_tex)
   {
     const auto& level = hires_tex->m_levels[0];
-    entry->texture->Load(0, level.width, level.height, level.row_length, level.data.data(),
-                         level.data.size());
+    const std::span<const u8> data = level.GetData();
+    entry->texture->Load(0, level.width, level.height, level.row_length, data.data(), data.size());
   }
 
   // Initialized to null because only software loading uses this buffer
@@ -1631,20 +1852,22 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
     }
   }
 
-  iter = textures_by_address.emplace(texture_info.GetRawAddress(), entry);
+  entry->SetGeneralParameters(texture_info.GetRawAddress(), texture_info.GetTextureSize(),
+                              full_format, false);
+
+  iter = AddToAddressMap(texture_info.GetRawAddress(), entry);
   if (textureCacheSafetyColorSampleSize == 0 ||
       std::max(texture_info.GetTextureSize(), palette_size) <=
           (u32)textureCacheSafetyColorSampleSize * 8)
   {
     entry->textures_by_hash_iter = textures_by_hash.emplace(full_hash, entry);
   }
-
-  entry->SetGeneralParameters(texture_info.GetRawAddress(), texture_info.GetTextureSize(),
-                              full_format, false);
   entry->SetDimensions(texture_info.GetRawWidth(), texture_info.GetRawHeight(),
                        texture_info.GetLevelCount());
   entry->SetHashes(base_hash, full_hash);
   entry->is_custom_tex = hires_tex != nullptr;
+  entry->custom_tex_pending = hires_tex_pending;
+  entry->custom_tex_generation = hires_tex_generation;
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
 
@@ -1659,8 +1882,9 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
     for (u32 level_index = 1; level_index != texLevels; ++level_index)
     {
       const auto& level = hires_tex->m_levels[level_index];
-      entry->texture->Load(level_index, level.width, level.height, level.row_length,
-                           level.data.data(), level.data.size());
+      const std::span<const u8> data = level.GetData();
+      entry->texture->Load(level_index, level.width, level.height, level.row_length, data.data(),
+                           data.size());
     }
   }
   else
@@ -1703,7 +1927,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
   {
     for (u32 level = 0; level < texLevels; ++level)
     {
-      DumpTexture(entry, basename, level, entry->has_arbitrary_mips);
+      m_texture_dumper.DumpTexture(*entry->texture, basename, level, entry->has_arbitrary_mips);
     }
   }
 
@@ -1785,7 +2009,7 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
   entry->texture->FinishedRendering();
 
   // Insert into the texture cache so we can re-use it next frame, if needed.
-  textures_by_address.emplace(entry->addr, entry);
+  AddToAddressMap(entry->addr, entry);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
   INCSTAT(g_stats.num_textures_uploaded);
 
@@ -1795,6 +2019,7 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
     if (g_ActiveConfig.bGraphicMods)
     {
       entry->texture_info_name = fmt::format("{}_{}", XFB_DUMP_PREFIX, id);
+      entry->texture_info_name_hash = GraphicsModManager::HashTextureName(entry->texture_info_name);
     }
 
     if (g_ActiveConfig.bDumpXFBTarget)
@@ -1858,6 +2083,7 @@ void TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
   auto iter = FindOverlappingTextures(stitched_entry->addr, stitched_entry->size_in_bytes);
   while (iter.first != iter.second)
   {
+    INCSTAT(g_stats.this_frame.num_texture_overlap_checks);
     // Currently, this checks the stride of the VRAM copy against the VI request. Therefore, for
     // interlaced modes, VRAM copies won't be considered candidates. This is okay for now, because
     // our force progressive hack means that an XFB copy should always have a matching stride. If
@@ -1892,6 +2118,15 @@ void TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
   std::sort(candidates.begin(), candidates.end(),
             [](const TCacheEntry* a, const TCacheEntry* b) { return a->id < b->id; });
 
+  // Copies never change while they keep their id, so stitching the same ones again wouldn't
+  // change anything. This is the case whenever a game shows a frame for more than one VI.
+  std::vector<u64> candidate_ids(candidates.size());
+  std::transform(candidates.begin(), candidates.end(), candidate_ids.begin(),
+                 [](const TCacheEntry* entry) { return entry->id; });
+  if (candidate_ids == stitched_entry->stitched_copy_ids)
+    return;
+  stitched_entry->stitched_copy_ids = std::move(candidate_ids);
+
   // We only upscale when necessary to preserve resolution. i.e. when there are upscaled partial
   // copies to be stitched together.
   if (create_upscaled_copy)
@@ -2113,6 +2348,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     ERROR_LOG_FMT(VIDEO, "Trying to copy from EFB to invalid address {:#010x}", dstAddr);
     return;
   }
+  Fifo::OnGPUMemoryWrite();
 
   // tex_w and tex_h are the native size of the texture in the GC memory.
   // The size scaled_* represents the emulated texture. Those differ
@@ -2232,9 +2468,11 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       entry->may_have_overlapping_textures = false;
       entry->is_custom_tex = false;
 
+      g_renderer->SetGPUTimingCategory(VideoCommon::GPUTimingCategory::EFBCopies);
       CopyEFBToCacheEntry(entry, is_depth_copy, srcRect, scaleByHalf, linear_filter, dstFormat,
                           isIntensity, gamma, clamp_top, clamp_bottom,
                           GetVRAMCopyFilterCoefficients(filter_coefficients));
+      g_renderer->SetGPUTimingCategory(VideoCommon::GPUTimingCategory::None);
 
       if (is_xfb_copy && (g_ActiveConfig.bDumpXFBTarget || g_ActiveConfig.bGraphicMods))
       {
@@ -2242,6 +2480,8 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         if (g_ActiveConfig.bGraphicMods)
         {
           entry->texture_info_name = fmt::format("{}_{}", XFB_DUMP_PREFIX, id);
+          entry->texture_info_name_hash =
+              GraphicsModManager::HashTextureName(entry->texture_info_name);
         }
 
         if (g_ActiveConfig.bDumpXFBTarget)
@@ -2258,6 +2498,8 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         if (g_ActiveConfig.bGraphicMods)
         {
           entry->texture_info_name = fmt::format("{}_{}", EFB_DUMP_PREFIX, id);
+          entry->texture_info_name_hash =
+              GraphicsModManager::HashTextureName(entry->texture_info_name);
         }
 
         if (g_ActiveConfig.bDumpEFBTarget)
@@ -2283,8 +2525,10 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     std::unique_ptr<AbstractStagingTexture> staging_texture = GetEFBCopyStagingTexture();
     if (staging_texture)
     {
+      g_renderer->SetGPUTimingCategory(VideoCommon::GPUTimingCategory::EFBCopies);
       CopyEFB(staging_texture.get(), format, tex_w, bytes_per_row, num_blocks_y, dstStride, srcRect,
               scaleByHalf, linear_filter, y_scale, gamma, clamp_top, clamp_bottom, coefficients);
+      g_renderer->SetGPUTimingCategory(VideoCommon::GPUTimingCategory::None);
 
       // We can't defer if there is no VRAM copy (since we need to update the hash).
       if (!copy_to_vram || !g_ActiveConfig.bDeferEFBCopies)
@@ -2324,6 +2568,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   auto iter = FindOverlappingTextures(dstAddr, covered_range);
   while (iter.first != iter.second)
   {
+    INCSTAT(g_stats.this_frame.num_texture_overlap_checks);
     TCacheEntry* overlapping_entry = iter.first->second;
 
     if (overlapping_entry->addr == dstAddr && overlapping_entry->is_xfb_copy)
@@ -2397,7 +2642,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   {
     const u64 hash = entry->CalculateHash();
     entry->SetHashes(hash, hash);
-    textures_by_address.emplace(dstAddr, entry);
+    AddToAddressMap(dstAddr, entry);
   }
 }
 
@@ -2406,6 +2651,13 @@ void TextureCacheBase::FlushEFBCopies()
   if (m_pending_efb_copies.empty())
     return;
 
+  // Wait for the most recent copy first. The GPU executes the copies in order, so once it is done
+  // all of the earlier ones are too, and the batch costs one submission and one wait. Otherwise
+  // the oldest copy could wait for the command buffer it's in, and the newer copies in the current
+  // command buffer would need another submission and wait of their own.
+  m_pending_efb_copies.back()->pending_efb_copy->Flush();
+  INCSTAT(g_stats.this_frame.num_efb_copy_flushes);
+
   for (TCacheEntry* entry : m_pending_efb_copies)
     FlushEFBCopy(entry);
   m_pending_efb_copies.clear();
@@ -2422,6 +2674,7 @@ void TextureCacheBase::WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32
 void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
 {
   // Copy from texture -> guest memory.
+  Fifo::OnGPUMemoryWrite();
   u8* const dst = Memory::GetPointer(entry->addr);
   WriteEFBCopyToRAM(dst, entry->pending_efb_copy_width, entry->pending_efb_copy_height,
                     entry->memory_stride, std::move(entry->pending_efb_copy));
@@ -2448,6 +2701,7 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
     auto range = FindOverlappingTextures(entry->addr, covered_range);
     for (auto iter = range.first; iter != range.second; ++iter)
     {
+      INCSTAT(g_stats.this_frame.num_texture_overlap_checks);
       TCacheEntry* overlapping_entry = iter->second;
       if (overlapping_entry->may_have_overlapping_textures && overlapping_entry->is_xfb_copy &&
           overlapping_entry->OverlapsMemoryRange(entry->addr, covered_range))
@@ -2617,16 +2871,21 @@ TextureCacheBase::GetTexCacheIter(TextureCacheBase::TCacheEntry* entry)
   return textures_by_address.end();
 }
 
+TextureCacheBase::TexAddrCache::iterator TextureCacheBase::AddToAddressMap(u32 addr,
+                                                                          TCacheEntry* entry)
+{
+  texture_sizes.insert(entry->size_in_bytes);
+  return textures_by_address.emplace(addr, entry);
+}
+
 std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCache::iterator>
 TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
 {
   // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
-
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
+  // which end after the given addr. But no texture is larger than the largest one in the
+  // cache, so we look for all textures which have a start address bigger than addr minus
+  // that size. But this yields false-positives which must be checked later on.
+  const u32 max_texture_size = texture_sizes.empty() ? 0 : *texture_sizes.rbegin();
   u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
   auto begin = textures_by_address.lower_bound(lower_addr);
   auto end = textures_by_address.upper_bound(addr + size_in_bytes);
@@ -2642,6 +2901,11 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
 
   TCacheEntry* entry = iter->second;
 
+  const auto size_iter = texture_sizes.find(entry->size_in_bytes);
+  ASSERT_MSG(VIDEO, size_iter != texture_sizes.end(), "Texture size changed while in the cache");
+  if (size_iter != texture_sizes.end())
+    texture_sizes.erase(size_iter);
+
   if (entry->textures_by_hash_iter != textures_by_hash.end())
   {
     textures_by_hash.erase(entry->textures_by_hash_iter);
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -23,6 +24,7 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureDumper.h"
 #include "VideoCommon/TextureInfo.h"
 
 class AbstractFramebuffer;
@@ -118,10 +120,16 @@ public:
     u32 size_in_bytes = 0;
     u64 base_hash = 0;
     u64 hash = 0;  // for paletted textures, hash = base_hash ^ palette_hash
+    // The Fifo::GetMemoryEpoch() in which base_hash was last found to match the memory.
+    u64 hash_checked_epoch = 0;
     TextureAndTLUTFormat format;
     u32 memory_stride = 0;
     bool is_efb_copy = false;
     bool is_custom_tex = false;
+    // The custom texture was still streaming in when this was created, so a more complete version
+    // may become available. Checked again whenever the streaming generation changes.
+    bool custom_tex_pending = false;
+    u64 custom_tex_generation = 0;
     bool may_have_overlapping_textures = true;
     bool tmem_only = false;           // indicates that this texture only exists in the tmem cache
     bool has_arbitrary_mips = false;  // indicates that the mips in this texture are arbitrary
@@ -132,6 +140,8 @@ public:
     u64 id = 0;
 
     bool reference_changed = false;  // used by xfb to determine when a reference xfb changed
+    // Ids of the copies which were last stitched into this XFB container, in stitching order.
+    std::vector<u64> stitched_copy_ids;
 
     // Texture dimensions from the GameCube's point of view
     u32 native_width = 0;
@@ -157,6 +167,8 @@ public:
     bool pending_efb_copy_invalidated = false;
 
     std::string texture_info_name = "";
+    // GraphicsModManager::HashTextureName of texture_info_name, for looking up graphics mods.
+    u64 texture_info_name_hash = 0;
 
     explicit TCacheEntry(std::unique_ptr<AbstractTexture> tex,
                          std::unique_ptr<AbstractFramebuffer> fb);
@@ -318,7 +330,6 @@ private:
                                        TLUTFormat tlutfmt);
   void StitchXFBCopy(TCacheEntry* entry_to_update);
 
-  void DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level, bool is_arbitrary);
   void CheckTempSize(size_t required_size);
 
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config);
@@ -326,6 +337,10 @@ private:
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
+  // Adds an entry to textures_by_address. The entry's size must not change until it is removed
+  // again with InvalidateTexture.
+  TexAddrCache::iterator AddToAddressMap(u32 addr, TCacheEntry* entry);
+
   // Return all possible overlapping textures. As addr+size of the textures is not
   // indexed, this may return false positives.
   std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
@@ -335,6 +350,11 @@ private:
   TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter,
                                            bool discard_pending_efb_copy = false);
 
+  // Frees least recently used textures until the cache and the pool fit in the configured memory
+  // budget. Pooled textures go first, then cached textures which can be loaded from RAM again.
+  void EnforceMemoryBudget(int frame_count);
+  size_t EvictPooledTextures(size_t bytes_to_free);
+
   void UninitializeEFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
   void UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
 
@@ -356,11 +376,19 @@ private:
   void ReleaseEFBCopyStagingTexture(std::unique_ptr<AbstractStagingTexture> tex);
 
   bool CheckReadbackTexture(u32 width, u32 height, AbstractTextureFormat format);
+  static u32 GetSerializedTextureSize(const TextureConfig& config);
+  static TextureConfig GetSerializedTextureConfig(const TCacheEntry* entry, bool native_resolution);
+  void ReadBackTextures(const std::vector<TCacheEntry*>& entries,
+                        const std::vector<TextureConfig>& configs,
+                        const std::vector<u8*>& texture_data);
   void DoSaveState(PointerWrap& p);
   void DoLoadState(PointerWrap& p);
 
   TexAddrCache textures_by_address;
   TexHashCache textures_by_hash;
+  // Sizes of the entries in textures_by_address, so that overlap queries only need to look back as
+  // far as the largest texture that is alive instead of the largest one the hardware supports.
+  std::multiset<u32> texture_sizes;
   TexPool texture_pool;
   u64 last_entry_id = 0;
 
@@ -372,6 +400,8 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    bool hires_textures_streaming;
+    int hires_textures_memory_limit;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
@@ -401,6 +431,8 @@ private:
   // We store this in the class so that the same staging texture can be used for multiple
   // readbacks, saving the overhead of allocating a new buffer every time.
   std::unique_ptr<AbstractStagingTexture> m_readback_texture;
+
+  TextureDumper m_texture_dumper;
 };
 
 extern std::unique_ptr<TextureCacheBase> g_texture_cache;
@@ -23,6 +23,8 @@ enum class AbstractTextureFormat : u32
   R32F,
   D32F,
   D32F_S8,
+  ETC2,
+  ASTC4x4,
   Undefined
 };
 
@@ -55,6 +57,8 @@ struct TextureConfig
   MathUtil::Rectangle<int> GetMipRect(u32 level) const;
   size_t GetStride() const;
   size_t GetMipStride(u32 level) const;
+  // Memory taken by every level, layer and sample, not counting any padding by the driver.
+  size_t GetSizeInBytes() const;
 
   bool IsMultisampled() const { return samples > 1; }
   bool IsRenderTarget() const { return (flags & AbstractTextureFlag_RenderTarget) != 0; }
@@ -0,0 +1,371 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/TextureDecoder.h"
+
+#include <arm_neon.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+
+#include "VideoCommon/LookUpTables.h"
+#include "VideoCommon/TextureDecoder_Util.h"
+
+// GameCube/Wii texture decoder, using NEON for the formats which don't go through a palette.
+// Decoded pixels are RGBA8, with red in the lowest byte.
+
+static inline u32 DecodePixel_IA8(u16 val)
+{
+  int a = val & 0xFF;
+  int i = val >> 8;
+  return i | (i << 8) | (i << 16) | (a << 24);
+}
+
+static inline u32 DecodePixel_RGB565(u16 val)
+{
+  int r, g, b, a;
+  r = Convert5To8((val >> 11) & 0x1f);
+  g = Convert6To8((val >> 5) & 0x3f);
+  b = Convert5To8((val)&0x1f);
+  a = 0xFF;
+  return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+static inline u32 DecodePixel_RGB5A3(u16 val)
+{
+  int r, g, b, a;
+  if ((val & 0x8000))
+  {
+    r = Convert5To8((val >> 10) & 0x1f);
+    g = Convert5To8((val >> 5) & 0x1f);
+    b = Convert5To8((val)&0x1f);
+    a = 0xFF;
+  }
+  else
+  {
+    a = Convert3To8((val >> 12) & 0x7);
+    r = Convert4To8((val >> 8) & 0xf);
+    g = Convert4To8((val >> 4) & 0xf);
+    b = Convert4To8((val)&0xf);
+  }
+  return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+static inline u32 DecodePixel_Paletted(u16 pixel, TLUTFormat tlutfmt)
+{
+  switch (tlutfmt)
+  {
+  case TLUTFormat::IA8:
+    return DecodePixel_IA8(pixel);
+  case TLUTFormat::RGB565:
+    return DecodePixel_RGB565(Common::swap16(pixel));
+  case TLUTFormat::RGB5A3:
+    return DecodePixel_RGB5A3(Common::swap16(pixel));
+  default:
+    return 0;
+  }
+}
+
+static inline void DecodeBytes_C4(u32* dst, const u8* src, const u8* tlut_, TLUTFormat tlutfmt)
+{
+  const u16* tlut = (u16*)tlut_;
+  for (int x = 0; x < 4; x++)
+  {
+    u8 val = src[x];
+    *dst++ = DecodePixel_Paletted(tlut[val >> 4], tlutfmt);
+    *dst++ = DecodePixel_Paletted(tlut[val & 0xF], tlutfmt);
+  }
+}
+
+static inline void DecodeBytes_C8(u32* dst, const u8* src, const u8* tlut_, TLUTFormat tlutfmt)
+{
+  const u16* tlut = (u16*)tlut_;
+  for (int x = 0; x < 8; x++)
+  {
+    u8 val = src[x];
+    *dst++ = DecodePixel_Paletted(tlut[val], tlutfmt);
+  }
+}
+
+static inline void DecodeBytes_C14X2(u32* dst, const u16* src, const u8* tlut_, TLUTFormat tlutfmt)
+{
+  const u16* tlut = (u16*)tlut_;
+  for (int x = 0; x < 4; x++)
+  {
+    u16 val = Common::swap16(src[x]);
+    *dst++ = DecodePixel_Paletted(tlut[(val & 0x3FFF)], tlutfmt);
+  }
+}
+
+// Vector constants are loaded from arrays, as not every compiler accepts initializer lists for
+// NEON types.
+alignas(16) static constexpr s8 s_cmpr_selector_shifts[16] = {-6, -6, -6, -6, -4, -4, -4, -4,
+                                                              -2, -2, -2, -2, 0,  0,  0,  0};
+alignas(16) static constexpr u8 s_cmpr_channels[16] = {0, 1, 2, 3, 0, 1, 2, 3,
+                                                       0, 1, 2, 3, 0, 1, 2, 3};
+alignas(16) static constexpr u8 s_ia8_shuffle[16] = {1, 1, 1, 0, 3, 3, 3, 2, 5, 5, 5, 4, 7, 7, 7, 6};
+alignas(16) static constexpr u8 s_rgba8_shuffle[16] = {1, 8,  9,  0, 3, 10, 11, 2,
+                                                       5, 12, 13, 4, 7, 14, 15, 6};
+
+// Expands the low bits of each lane to 8 bits by repeating them, like the scalar ConvertNTo8.
+static inline uint8x8_t Convert4To8_NEON(uint8x8_t x)
+{
+  return vmul_u8(x, vdup_n_u8(0x11));
+}
+
+static inline uint8x8_t Convert3To8_NEON(uint16x8_t x)
+{
+  return vmovn_u16(vorrq_u16(vorrq_u16(vshlq_n_u16(x, 5), vshlq_n_u16(x, 2)), vshrq_n_u16(x, 1)));
+}
+
+static inline uint8x8_t Convert4To8_NEON(uint16x8_t x)
+{
+  return Convert4To8_NEON(vmovn_u16(x));
+}
+
+static inline uint8x8_t Convert5To8_NEON(uint16x8_t x)
+{
+  return vmovn_u16(vorrq_u16(vshlq_n_u16(x, 3), vshrq_n_u16(x, 2)));
+}
+
+static inline uint8x8_t Convert6To8_NEON(uint16x8_t x)
+{
+  return vmovn_u16(vorrq_u16(vshlq_n_u16(x, 2), vshrq_n_u16(x, 4)));
+}
+
+// Loads two rows of four big-endian 16-bit texels.
+static inline uint16x8_t LoadBigEndian16(const u8* src)
+{
+  return vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(src)));
+}
+
+// Stores eight pixels given as separate channels: the first four to row0, the rest to row1.
+static inline void StoreRows4(u32* row0, u32* row1, uint8x8_t r, uint8x8_t g, uint8x8_t b,
+                              uint8x8_t a)
+{
+  const uint8x8x2_t rg = vzip_u8(r, g);
+  const uint8x8x2_t ba = vzip_u8(b, a);
+  const uint16x4x2_t lo = vzip_u16(vreinterpret_u16_u8(rg.val[0]), vreinterpret_u16_u8(ba.val[0]));
+  const uint16x4x2_t hi = vzip_u16(vreinterpret_u16_u8(rg.val[1]), vreinterpret_u16_u8(ba.val[1]));
+  vst1q_u16(reinterpret_cast<u16*>(row0), vcombine_u16(lo.val[0], lo.val[1]));
+  vst1q_u16(reinterpret_cast<u16*>(row1), vcombine_u16(hi.val[0], hi.val[1]));
+}
+
+static inline void StoreRow8(u32* dst, uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a)
+{
+  vst4_u8(reinterpret_cast<u8*>(dst), (uint8x8x4_t{{r, g, b, a}}));
+}
+
+static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
+{
+  // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
+  u16 c1 = Common::swap16(src->color1);
+  u16 c2 = Common::swap16(src->color2);
+  int blue1 = Convert5To8(c1 & 0x1F);
+  int blue2 = Convert5To8(c2 & 0x1F);
+  int green1 = Convert6To8((c1 >> 5) & 0x3F);
+  int green2 = Convert6To8((c2 >> 5) & 0x3F);
+  int red1 = Convert5To8((c1 >> 11) & 0x1F);
+  int red2 = Convert5To8((c2 >> 11) & 0x1F);
+  u32 colors[4];
+  colors[0] = MakeRGBA(red1, green1, blue1, 255);
+  colors[1] = MakeRGBA(red2, green2, blue2, 255);
+  if (c1 > c2)
+  {
+    colors[2] =
+        MakeRGBA(DXTBlend(red2, red1), DXTBlend(green2, green1), DXTBlend(blue2, blue1), 255);
+    colors[3] =
+        MakeRGBA(DXTBlend(red1, red2), DXTBlend(green1, green2), DXTBlend(blue1, blue2), 255);
+  }
+  else
+  {
+    // color[3] is the same as color[2] (average of both colors), but transparent.
+    // This differs from DXT1 where color[3] is transparent black.
+    colors[2] = MakeRGBA((red1 + red2) / 2, (green1 + green2) / 2, (blue1 + blue2) / 2, 255);
+    colors[3] = MakeRGBA((red1 + red2) / 2, (green1 + green2) / 2, (blue1 + blue2) / 2, 0);
+  }
+
+  // Each row is a table lookup into the four colors: the selectors of the row's byte are moved
+  // to the bottom of each pixel's lanes and turned into byte offsets of the chosen color.
+  const uint8x16_t palette = vld1q_u8(reinterpret_cast<const u8*>(colors));
+  const int8x16_t shifts = vld1q_s8(s_cmpr_selector_shifts);
+  const uint8x16_t channels = vld1q_u8(s_cmpr_channels);
+  for (int y = 0; y < 4; y++)
+  {
+    const uint8x16_t selectors =
+        vandq_u8(vshlq_u8(vdupq_n_u8(src->lines[y]), shifts), vdupq_n_u8(3));
+    const uint8x16_t offsets = vaddq_u8(vshlq_n_u8(selectors, 2), channels);
+    vst1q_u8(reinterpret_cast<u8*>(dst), vqtbl1q_u8(palette, offsets));
+    dst += pitch;
+  }
+}
+
+void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
+                            const u8* tlut, TLUTFormat tlutfmt)
+{
+  const int Wsteps4 = (width + 3) / 4;
+  const int Wsteps8 = (width + 7) / 8;
+
+  switch (texformat)
+  {
+  case TextureFormat::C4:
+    for (int y = 0; y < height; y += 8)
+      for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+        for (int iy = 0, xStep = 8 * yStep; iy < 8; iy++, xStep++)
+          DecodeBytes_C4(dst + (y + iy) * width + x, src + 4 * xStep, tlut, tlutfmt);
+    break;
+  case TextureFormat::I4:
+  {
+    // 8x8 blocks of 4 bytes per row, with the left pixel in the high nibble. Two rows at a time.
+    for (int y = 0; y < height; y += 8)
+      for (int x = 0; x < width; x += 8)
+        for (int iy = 0; iy < 8; iy += 2, src += 8)
+        {
+          const uint8x8_t val = vld1_u8(src);
+          const uint8x8x2_t i = vzip_u8(vshr_n_u8(val, 4), vand_u8(val, vdup_n_u8(0xF)));
+          for (int row = 0; row < 2; row++)
+          {
+            const uint8x8_t i8 = Convert4To8_NEON(i.val[row]);
+            StoreRow8(dst + (y + iy + row) * width + x, i8, i8, i8, i8);
+          }
+        }
+  }
+  break;
+  case TextureFormat::I8:  // speed critical
+  {
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 8)
+        for (int iy = 0; iy < 4; ++iy, src += 8)
+        {
+          const uint8x8_t i = vld1_u8(src);
+          StoreRow8(dst + (y + iy) * width + x, i, i, i, i);
+        }
+  }
+  break;
+  case TextureFormat::C8:
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+        for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+          DecodeBytes_C8((u32*)dst + (y + iy) * width + x, src + 8 * xStep, tlut, tlutfmt);
+    break;
+  case TextureFormat::IA4:
+  {
+    // Alpha in the high nibble, intensity in the low one.
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 8)
+        for (int iy = 0; iy < 4; iy++, src += 8)
+        {
+          const uint8x8_t val = vld1_u8(src);
+          const uint8x8_t a = Convert4To8_NEON(vshr_n_u8(val, 4));
+          const uint8x8_t i = Convert4To8_NEON(vand_u8(val, vdup_n_u8(0xF)));
+          StoreRow8(dst + (y + iy) * width + x, i, i, i, a);
+        }
+  }
+  break;
+  case TextureFormat::IA8:
+  {
+    // Each texel is an alpha byte followed by an intensity byte, so one table lookup turns a row
+    // into RGBA.
+    const uint8x16_t row0 = vld1q_u8(s_ia8_shuffle);
+    const uint8x16_t row1 = vaddq_u8(row0, vdupq_n_u8(8));
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 4)
+        for (int iy = 0; iy < 4; iy += 2, src += 16)
+        {
+          const uint8x16_t val = vld1q_u8(src);
+          u32* ptr = dst + (y + iy) * width + x;
+          vst1q_u8(reinterpret_cast<u8*>(ptr), vqtbl1q_u8(val, row0));
+          vst1q_u8(reinterpret_cast<u8*>(ptr + width), vqtbl1q_u8(val, row1));
+        }
+  }
+  break;
+  case TextureFormat::C14X2:
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+        for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+          DecodeBytes_C14X2(dst + (y + iy) * width + x, (u16*)(src + 8 * xStep), tlut, tlutfmt);
+    break;
+  case TextureFormat::RGB565:
+  {
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 4)
+        for (int iy = 0; iy < 4; iy += 2, src += 16)
+        {
+          const uint16x8_t val = LoadBigEndian16(src);
+          const uint8x8_t r = Convert5To8_NEON(vshrq_n_u16(val, 11));
+          const uint8x8_t g = Convert6To8_NEON(vandq_u16(vshrq_n_u16(val, 5), vdupq_n_u16(0x3F)));
+          const uint8x8_t b = Convert5To8_NEON(vandq_u16(val, vdupq_n_u16(0x1F)));
+          u32* ptr = dst + (y + iy) * width + x;
+          StoreRows4(ptr, ptr + width, r, g, b, vdup_n_u8(0xFF));
+        }
+  }
+  break;
+  case TextureFormat::RGB5A3:
+  {
+    // Both encodings are decoded, and the top bit of each texel picks one.
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 4)
+        for (int iy = 0; iy < 4; iy += 2, src += 16)
+        {
+          const uint16x8_t val = LoadBigEndian16(src);
+          const uint8x8_t opaque = vmovn_u16(vtstq_u16(val, vdupq_n_u16(0x8000)));
+          const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+          const uint16x8_t mask4 = vdupq_n_u16(0xF);
+
+          const uint8x8_t r5 = Convert5To8_NEON(vandq_u16(vshrq_n_u16(val, 10), mask5));
+          const uint8x8_t g5 = Convert5To8_NEON(vandq_u16(vshrq_n_u16(val, 5), mask5));
+          const uint8x8_t b5 = Convert5To8_NEON(vandq_u16(val, mask5));
+
+          const uint8x8_t a3 =
+              Convert3To8_NEON(vandq_u16(vshrq_n_u16(val, 12), vdupq_n_u16(0x7)));
+          const uint8x8_t r4 = Convert4To8_NEON(vandq_u16(vshrq_n_u16(val, 8), mask4));
+          const uint8x8_t g4 = Convert4To8_NEON(vandq_u16(vshrq_n_u16(val, 4), mask4));
+          const uint8x8_t b4 = Convert4To8_NEON(vandq_u16(val, mask4));
+
+          u32* ptr = dst + (y + iy) * width + x;
+          StoreRows4(ptr, ptr + width, vbsl_u8(opaque, r5, r4), vbsl_u8(opaque, g5, g4),
+                     vbsl_u8(opaque, b5, b4), vorr_u8(opaque, a3));
+        }
+  }
+  break;
+  case TextureFormat::RGBA8:  // speed critical
+  {
+    // A 4x4 block is 32 bytes of alpha/red pairs followed by 32 bytes of green/blue pairs. One
+    // table lookup over a row of each half gives the row's RGBA.
+    const uint8x16_t shuffle = vld1q_u8(s_rgba8_shuffle);
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 4)
+      {
+        for (int iy = 0; iy < 4; iy++)
+        {
+          const uint8x16_t val = vcombine_u8(vld1_u8(src + 8 * iy), vld1_u8(src + 32 + 8 * iy));
+          vst1q_u8(reinterpret_cast<u8*>(dst + (y + iy) * width + x), vqtbl1q_u8(val, shuffle));
+        }
+        src += 64;
+      }
+  }
+  break;
+  case TextureFormat::CMPR:  // speed critical
+    // The metroid games use this format almost exclusively.
+    {
+      for (int y = 0; y < height; y += 8)
+      {
+        for (int x = 0; x < width; x += 8)
+        {
+          DecodeDXTBlock((u32*)dst + y * width + x, (DXTBlock*)src, width);
+          src += sizeof(DXTBlock);
+          DecodeDXTBlock((u32*)dst + y * width + x + 4, (DXTBlock*)src, width);
+          src += sizeof(DXTBlock);
+          DecodeDXTBlock((u32*)dst + (y + 4) * width + x, (DXTBlock*)src, width);
+          src += sizeof(DXTBlock);
+          DecodeDXTBlock((u32*)dst + (y + 4) * width + x + 4, (DXTBlock*)src, width);
+          src += sizeof(DXTBlock);
+        }
+      }
+      break;
+    }
+  case TextureFormat::XFB:
+    TexDecoder_DecodeXFB(reinterpret_cast<u8*>(dst), src, width, height, width * 2);
+    break;
+  }
+}
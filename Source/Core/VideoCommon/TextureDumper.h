@@ -0,0 +1,52 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+class AbstractTexture;
+
+// Dumps textures to PNG files. The texture is read back on the calling thread, but encoding and
+// writing the file happen on a worker thread, so dumping doesn't stall the GPU thread for the
+// (much longer) time it takes to compress the image.
+class TextureDumper
+{
+public:
+  TextureDumper();
+  ~TextureDumper();
+
+  // Does nothing if the file exists, or the texture has already been dumped to it.
+  void DumpTexture(const AbstractTexture& texture, std::string basename, u32 level,
+                   bool is_arbitrary);
+
+private:
+  struct DumpRequest
+  {
+    std::string path;
+    std::vector<u8> pixels;
+    u32 width;
+    u32 height;
+    int compression_level;
+  };
+
+  void WriteDump(DumpRequest request);
+
+  // Started on the first dump, as most sessions never dump anything.
+  Common::WorkQueueThread<DumpRequest> m_worker;
+  bool m_worker_started = false;
+
+  // Paths already queued, so repeated dumps don't need to check the filesystem. GPU thread only.
+  std::unordered_set<std::string> m_dumped_paths;
+
+  // Hash of each image's pixels to the file it was written to. Many textures share the same image
+  // under different names (e.g. with different palettes that decode the same), and copying the
+  // file is much cheaper than encoding it again. Worker thread only.
+  std::unordered_map<u64, std::string> m_written_images;
+};
@@ -0,0 +1,169 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/TexturePack.h"
+
+#include <cstring>
+#include <utility>
+
+#include "Common/Logging/Log.h"
+#include "VideoCommon/AbstractTexture.h"
+
+TexturePack::TexturePack(std::string path) : m_path(std::move(path))
+{
+}
+
+TexturePack::~TexturePack() = default;
+
+std::shared_ptr<TexturePack> TexturePack::Open(const std::string& path,
+                                               const FormatPredicate& is_format_supported)
+{
+  // Can't use make_shared due to private constructor.
+  std::shared_ptr<TexturePack> pack(new TexturePack(path));
+  if (!pack->m_file.Open(path))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to map texture pack {}", path);
+    return nullptr;
+  }
+
+  pack->m_data = pack->m_file.GetData();
+  pack->m_size = pack->m_file.GetSize();
+  if (!pack->ParseIndex(is_format_supported))
+    return nullptr;
+
+  INFO_LOG_FMT(VIDEO, "Loaded {} textures from texture pack {}", pack->m_textures.size(), path);
+  return pack;
+}
+
+std::optional<AbstractTextureFormat> TexturePack::GetAbstractFormat(Format format)
+{
+  switch (format)
+  {
+  case Format::RGBA8:
+    return AbstractTextureFormat::RGBA8;
+  case Format::BC1:
+    return AbstractTextureFormat::DXT1;
+  case Format::BC2:
+    return AbstractTextureFormat::DXT3;
+  case Format::BC3:
+    return AbstractTextureFormat::DXT5;
+  case Format::BC7:
+    return AbstractTextureFormat::BPTC;
+  case Format::ETC2_RGBA8:
+    return AbstractTextureFormat::ETC2;
+  case Format::ASTC_4x4:
+    return AbstractTextureFormat::ASTC4x4;
+  default:
+    return std::nullopt;
+  }
+}
+
+const TexturePack::Texture* TexturePack::Find(const std::string& name) const
+{
+  const auto iter = m_textures.find(name);
+  return iter != m_textures.end() ? &iter->second : nullptr;
+}
+
+bool TexturePack::ParseIndex(const FormatPredicate& is_format_supported)
+{
+  Header header;
+  if (m_size < sizeof(header))
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack {} is too small", m_path);
+    return false;
+  }
+
+  std::memcpy(&header, m_data, sizeof(header));
+  if (header.magic != MAGIC || header.version != VERSION)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack {} has an unknown magic {:08x} or version {}", m_path,
+                  header.magic, header.version);
+    return false;
+  }
+
+  if (!IsInBounds(sizeof(Header), u64{sizeof(Entry)} * header.num_entries +
+                                      u64{sizeof(LevelHeader)} * header.num_levels))
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack {} is truncated", m_path);
+    return false;
+  }
+
+  const u8* entry_ptr = m_data + sizeof(Header);
+  for (u32 i = 0; i < header.num_entries; i++, entry_ptr += sizeof(Entry))
+  {
+    Entry entry;
+    std::memcpy(&entry, entry_ptr, sizeof(entry));
+
+    // Formats from newer versions of the packer are skipped, rather than failing the whole pack.
+    const std::optional<AbstractTextureFormat> format = GetAbstractFormat(entry.format);
+    if (!format || !is_format_supported(*format))
+      continue;
+
+    if (!IsInBounds(entry.name_offset, entry.name_length))
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture pack {} has an invalid name for entry {}", m_path, i);
+      continue;
+    }
+
+    std::string name(reinterpret_cast<const char*>(m_data + entry.name_offset),
+                     entry.name_length);
+    if (m_textures.contains(name))
+      continue;
+
+    std::optional<Texture> texture = ParseEntry(entry, header);
+    if (!texture)
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture pack {} has invalid levels for texture {}", m_path, name);
+      continue;
+    }
+
+    m_textures.emplace(std::move(name), std::move(*texture));
+  }
+
+  return true;
+}
+
+std::optional<TexturePack::Texture> TexturePack::ParseEntry(const Entry& entry,
+                                                            const Header& header) const
+{
+  if (entry.num_levels == 0 || u64{entry.first_level} + entry.num_levels > header.num_levels)
+    return std::nullopt;
+
+  const AbstractTextureFormat format = *GetAbstractFormat(entry.format);
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(format);
+
+  Texture texture;
+  texture.has_arbitrary_mipmaps = (entry.flags & ENTRY_FLAG_ARBITRARY_MIPMAPS) != 0;
+  texture.levels.reserve(entry.num_levels);
+
+  const u8* level_ptr = m_data + sizeof(Header) + u64{sizeof(Entry)} * header.num_entries +
+                        u64{sizeof(LevelHeader)} * entry.first_level;
+  for (u32 i = 0; i < entry.num_levels; i++, level_ptr += sizeof(LevelHeader))
+  {
+    LevelHeader level;
+    std::memcpy(&level, level_ptr, sizeof(level));
+
+    // Compressed levels are padded to whole blocks, like in DDS files.
+    if (level.width == 0 || level.height == 0 || level.row_length < level.width ||
+        level.row_length % block_size != 0)
+    {
+      return std::nullopt;
+    }
+
+    const u64 num_rows = (u64{level.height} + block_size - 1) / block_size;
+    const u64 min_size =
+        u64{AbstractTexture::CalculateStrideForFormat(format, level.row_length)} * num_rows;
+    if (level.data_size < min_size || !IsInBounds(level.data_offset, level.data_size))
+      return std::nullopt;
+
+    texture.levels.push_back({std::span<const u8>(m_data + level.data_offset, level.data_size),
+                              format, level.width, level.height, level.row_length});
+  }
+
+  return texture;
+}
+
+bool TexturePack::IsInBounds(u64 offset, u64 size) const
+{
+  return offset <= m_size && size <= m_size - offset;
+}
@@ -0,0 +1,128 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
+#include "VideoCommon/TextureConfig.h"
+
+// A texture pack (.dtp) stores many custom textures in a single file, already encoded in the
+// formats GPUs sample directly. The file is memory-mapped, so loading a texture doesn't open or
+// decode anything, and its levels are uploaded straight from the mapping.
+//
+// The file is little-endian, and starts with a Header, followed by num_entries Entries and
+// num_levels LevelHeaders. Names and level data may be anywhere after that, at the offsets
+// (from the start of the file) given by the entries and levels.
+//
+// Entries are keyed by the texture's base name, as generated by HiresTexture::GenBaseName. A name
+// may have several entries in different formats, for example BC7 for desktop GPUs and ASTC for
+// mobile ones. The first one the backend can sample is used, so they should be ordered from most
+// to least preferred.
+class TexturePack
+{
+public:
+  static constexpr u32 MAGIC = 0x4B505444;  // "DTPK"
+  static constexpr u32 VERSION = 1;
+
+  // Stored in the file, so values must not change.
+  enum class Format : u32
+  {
+    RGBA8 = 0,
+    BC1 = 1,
+    BC2 = 2,
+    BC3 = 3,
+    BC7 = 4,
+    ETC2_RGBA8 = 5,
+    ASTC_4x4 = 6,
+  };
+
+  enum EntryFlags : u32
+  {
+    ENTRY_FLAG_ARBITRARY_MIPMAPS = 1 << 0,
+  };
+
+  struct Header
+  {
+    u32 magic;
+    u32 version;
+    u32 num_entries;
+    u32 num_levels;
+  };
+  static_assert(sizeof(Header) == 16);
+
+  struct Entry
+  {
+    u64 name_offset;
+    u32 name_length;
+    Format format;
+    u32 flags;
+    u32 first_level;  // Index of the entry's first level in the level headers.
+    u32 num_levels;
+    u32 padding;
+  };
+  static_assert(sizeof(Entry) == 32);
+
+  struct LevelHeader
+  {
+    u64 data_offset;
+    u64 data_size;
+    u32 width;
+    u32 height;
+    u32 row_length;  // In texels, at least width.
+    u32 padding;
+  };
+  static_assert(sizeof(LevelHeader) == 32);
+
+  struct Level
+  {
+    std::span<const u8> data;
+    AbstractTextureFormat format;
+    u32 width;
+    u32 height;
+    u32 row_length;
+  };
+
+  struct Texture
+  {
+    std::vector<Level> levels;
+    bool has_arbitrary_mipmaps;
+  };
+
+  using FormatPredicate = std::function<bool(AbstractTextureFormat)>;
+
+  // Maps the file and indexes the textures it has in formats is_format_supported accepts.
+  // Returns nullptr if the file can't be mapped or isn't a texture pack.
+  static std::shared_ptr<TexturePack> Open(const std::string& path,
+                                           const FormatPredicate& is_format_supported);
+
+  static std::optional<AbstractTextureFormat> GetAbstractFormat(Format format);
+
+  ~TexturePack();
+
+  const std::string& GetPath() const { return m_path; }
+  const std::unordered_map<std::string, Texture>& GetTextures() const { return m_textures; }
+  const Texture* Find(const std::string& name) const;
+
+private:
+  explicit TexturePack(std::string path);
+
+  bool ParseIndex(const FormatPredicate& is_format_supported);
+  std::optional<Texture> ParseEntry(const Entry& entry, const Header& header) const;
+  bool IsInBounds(u64 offset, u64 size) const;
+
+  std::string m_path;
+  File::MappedFile m_file;
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+  std::unordered_map<std::string, Texture> m_textures;
+};
@@ -23,6 +23,7 @@ PixelShaderUid GetPixelShaderUid()
 
   pixel_ubershader_uid_data* const uid_data = out.GetUidData();
   uid_data->num_texgens = xfmem.numTexGen.numTexGens;
+  uid_data->tev_stage_bucket = GetTevStageBucket(bpmem.genMode.numtevstages + 1);
   uid_data->early_depth = bpmem.GetEmulatedZ() == EmulatedZ::Early &&
                           (g_ActiveConfig.bFastDepthCalc ||
                            bpmem.alpha_test.TestResult() == AlphaTestResult::Undetermined) &&
@@ -68,6 +69,7 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
   const bool per_pixel_depth = uid_data->per_pixel_depth != 0;
   const bool bounding_box = host_config.bounding_box;
   const u32 numTexgen = uid_data->num_texgens;
+  const u32 max_tev_stages = GetTevStageBucketMaxStages(uid_data->tev_stage_bucket);
   ShaderCode out;
 
   ASSERT_MSG(VIDEO, !(use_dual_source && use_framebuffer_fetch),
@@ -572,8 +574,12 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
 
   out.Write("  // Main tev loop\n");
 
-  out.Write("  for(uint stage = 0u; stage <= num_stages; stage++)\n"
+  // The constant bound from the stage bucket lets the compiler unroll the loop and size its
+  // registers for the stages that can actually be active.
+  out.Write("  for(uint stage = 0u; stage < {}u; stage++)\n"
             "  {{\n"
+            "    if (stage > num_stages)\n"
+            "      break;\n\n"
             "    StageState ss;\n"
             "    ss.stage = stage;\n"
             "    ss.cc = bpmem_combiners(stage).x;\n"
@@ -581,6 +587,7 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
             "    ss.order = bpmem_tevorder(stage>>1);\n"
             "    if ((stage & 1u) == 1u)\n"
             "      ss.order = ss.order >> {};\n\n",
+            max_tev_stages,
             int(TwoTevStageOrders().enable_tex_odd.StartBit() -
                 TwoTevStageOrders().enable_tex_even.StartBit()));
 
@@ -1261,23 +1268,28 @@ void EnumeratePixelShaderUids(const std::function<void(const PixelShaderUid&)>&
     pixel_ubershader_uid_data* const puid = uid.GetUidData();
     puid->num_texgens = texgens;
 
-    for (u32 early_depth = 0; early_depth < 2; early_depth++)
+    for (u32 bucket = 0; bucket < NUM_TEV_STAGE_BUCKETS; bucket++)
     {
-      puid->early_depth = early_depth != 0;
-      for (u32 per_pixel_depth = 0; per_pixel_depth < 2; per_pixel_depth++)
+      puid->tev_stage_bucket = bucket;
+      for (u32 early_depth = 0; early_depth < 2; early_depth++)
       {
-        // Don't generate shaders where we have early depth tests enabled, and write gl_FragDepth.
-        if (early_depth && per_pixel_depth)
-          continue;
-
-        puid->per_pixel_depth = per_pixel_depth != 0;
-        for (u32 uint_output = 0; uint_output < 2; uint_output++)
+        puid->early_depth = early_depth != 0;
+        for (u32 per_pixel_depth = 0; per_pixel_depth < 2; per_pixel_depth++)
         {
-          puid->uint_output = uint_output;
-          for (u32 no_dual_src = 0; no_dual_src < 2; no_dual_src++)
+          // Don't generate shaders where we have early depth tests enabled, and write
+          // gl_FragDepth.
+          if (early_depth && per_pixel_depth)
+            continue;
+
+          puid->per_pixel_depth = per_pixel_depth != 0;
+          for (u32 uint_output = 0; uint_output < 2; uint_output++)
           {
-            puid->no_dual_src = no_dual_src;
-            callback(uid);
+            puid->uint_output = uint_output;
+            for (u32 no_dual_src = 0; no_dual_src < 2; no_dual_src++)
+            {
+              puid->no_dual_src = no_dual_src;
+              callback(uid);
+            }
           }
         }
       }
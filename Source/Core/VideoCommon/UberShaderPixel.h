@@ -11,6 +11,21 @@ enum class APIType;
 
 namespace UberShader
 {
+// Pixel ubershaders are specialized on the number of active TEV stages, rounded up to one of
+// these buckets. This gives the TEV loop a small constant trip count for simple materials,
+// while the dynamic stage configuration still avoids a compile per TEV setup.
+constexpr u32 NUM_TEV_STAGE_BUCKETS = 4;
+
+constexpr u32 GetTevStageBucket(u32 num_tev_stages)
+{
+  return num_tev_stages <= 2 ? 0 : num_tev_stages <= 4 ? 1 : num_tev_stages <= 8 ? 2 : 3;
+}
+
+constexpr u32 GetTevStageBucketMaxStages(u32 bucket)
+{
+  return 2u << bucket;
+}
+
 #pragma pack(1)
 struct pixel_ubershader_uid_data
 {
@@ -19,6 +34,7 @@ struct pixel_ubershader_uid_data
   u32 per_pixel_depth : 1;
   u32 uint_output : 1;
   u32 no_dual_src : 1;
+  u32 tev_stage_bucket : 2;
 
   u32 NumValues() const { return sizeof(pixel_ubershader_uid_data); }
 };
@@ -44,7 +60,8 @@ struct fmt::formatter<UberShader::pixel_ubershader_uid_data>
   auto format(const UberShader::pixel_ubershader_uid_data& uid, FormatContext& ctx) const
   {
     return fmt::format_to(
-        ctx.out(), "Pixel UberShader for {} texgens{}{}{}{}", uid.num_texgens,
+        ctx.out(), "Pixel UberShader for {} texgens, up to {} TEV stages{}{}{}{}",
+        uid.num_texgens, UberShader::GetTevStageBucketMaxStages(uid.tev_stage_bucket),
         uid.early_depth ? ", early-depth" : "", uid.per_pixel_depth ? ", per-pixel depth" : "",
         uid.uint_output ? ", uint output" : "", uid.no_dual_src ? ", no dual-source blending" : "");
   }
@@ -29,6 +29,15 @@ public:
     hash = CalculateHash();
   }
 
+  void GetConfig(TVtxDesc& vtx_desc, VAT& vat) const
+  {
+    vtx_desc.low.Hex = vid[0];
+    vtx_desc.high.Hex = vid[1];
+    vat.g0.Hex = vid[2];
+    vat.g1.Hex = vid[3];
+    vat.g2.Hex = vid[4];
+  }
+
   bool operator==(const VertexLoaderUID& rh) const { return vid == rh.vid; }
   size_t GetHash() const { return hash; }
 
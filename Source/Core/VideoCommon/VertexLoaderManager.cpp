@@ -14,14 +14,19 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 
+#include "Core/ConfigManager.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/Memmap.h"
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/DrawCapture.h"
+#include "VideoCommon/FrameTimeline.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/RenderBase.h"
@@ -29,6 +34,7 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace VertexLoaderManager
@@ -49,6 +55,19 @@ static std::mutex s_vertex_loader_map_lock;
 static VertexLoaderMap s_vertex_loader_map;
 // TODO - change into array of pointers. Keep a map of all seen so far.
 
+// Every vertex format a game has used is written to a per-game file, so that the loaders can be
+// compiled at boot the next time instead of in the middle of a frame. Protected by
+// s_vertex_loader_map_lock.
+struct SerializedVertexLoaderUID
+{
+  u32 vtx_desc_low;
+  u32 vtx_desc_high;
+  u32 vat_g0;
+  u32 vat_g1;
+  u32 vat_g2;
+};
+static File::IOFile s_loader_uid_cache_file;
+
 Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
 
 BitSet8 g_main_vat_dirty;
@@ -71,10 +90,108 @@ void Init()
 void Clear()
 {
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  s_loader_uid_cache_file.Close();
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
 }
 
+static void AppendLoaderUID(const TVtxDesc& vtx_desc, const VAT& vat)
+{
+  if (!s_loader_uid_cache_file.IsOpen())
+    return;
+
+  const SerializedVertexLoaderUID disk_uid{vtx_desc.low.Hex, vtx_desc.high.Hex, vat.g0.Hex,
+                                           vat.g1.Hex, vat.g2.Hex};
+  if (!s_loader_uid_cache_file.WriteBytes(&disk_uid, sizeof(disk_uid)))
+  {
+    WARN_LOG_FMT(VIDEO, "Writing vertex loader UID to cache failed, closing file.");
+    s_loader_uid_cache_file.Close();
+  }
+}
+
+void LoadLoaderUIDCache()
+{
+  constexpr u32 CACHE_FILE_MAGIC = 0x4449554C;  // LUID
+  constexpr u32 CACHE_FILE_VERSION = 1;
+  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
+  if (!g_ActiveConfig.bShaderCache)
+    return;
+
+  std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  const std::string filename = File::GetUserPath(D_CACHE_IDX) +
+                               SConfig::GetInstance().GetGameID() + ".vertexloader.uidcache";
+  size_t loaded = 0;
+  if (s_loader_uid_cache_file.Open(filename, "rb+"))
+  {
+    u32 existing_magic;
+    u32 existing_version;
+    bool uid_file_valid = false;
+    if (s_loader_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
+        s_loader_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
+        existing_magic == CACHE_FILE_MAGIC && existing_version == CACHE_FILE_VERSION)
+    {
+      // A truncated last entry means Dolphin didn't finish writing it, so rewrite the file
+      // instead of appending after the partial entry.
+      const u64 file_size = s_loader_uid_cache_file.GetSize();
+      const size_t uid_count =
+          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedVertexLoaderUID);
+      const size_t expected_size =
+          uid_count * sizeof(SerializedVertexLoaderUID) + CACHE_HEADER_SIZE;
+      uid_file_valid = file_size == expected_size;
+      for (size_t i = 0; uid_file_valid && i < uid_count; i++)
+      {
+        SerializedVertexLoaderUID disk_uid;
+        if (!s_loader_uid_cache_file.ReadBytes(&disk_uid, sizeof(disk_uid)))
+        {
+          uid_file_valid = false;
+          break;
+        }
+
+        TVtxDesc vtx_desc;
+        vtx_desc.low.Hex = disk_uid.vtx_desc_low;
+        vtx_desc.high.Hex = disk_uid.vtx_desc_high;
+        VAT vat;
+        vat.g0.Hex = disk_uid.vat_g0;
+        vat.g1.Hex = disk_uid.vat_g1;
+        vat.g2.Hex = disk_uid.vat_g2;
+
+        // The native vertex formats are created when the loader is first used, since that has
+        // to happen on the video thread.
+        const auto [it, added] = s_vertex_loader_map.try_emplace(VertexLoaderUID(vtx_desc, vat));
+        if (added)
+        {
+          it->second = VertexLoaderBase::CreateVertexLoader(vtx_desc, vat);
+          INCSTAT(g_stats.num_vertex_loaders);
+          loaded++;
+        }
+      }
+
+      if (uid_file_valid)
+        uid_file_valid = s_loader_uid_cache_file.Seek(expected_size, File::SeekOrigin::Begin);
+    }
+
+    if (!uid_file_valid)
+      s_loader_uid_cache_file.Close();
+  }
+
+  if (!s_loader_uid_cache_file.IsOpen() && s_loader_uid_cache_file.Open(filename, "wb"))
+  {
+    s_loader_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+    s_loader_uid_cache_file.WriteBytes(&CACHE_FILE_VERSION, sizeof(CACHE_FILE_VERSION));
+
+    // Keep the entries that were read before the file turned out to be damaged.
+    for (const auto& it : s_vertex_loader_map)
+    {
+      TVtxDesc vtx_desc;
+      VAT vat;
+      it.first.GetConfig(vtx_desc, vat);
+      AppendLoaderUID(vtx_desc, vat);
+    }
+  }
+
+  INFO_LOG_FMT(VIDEO, "Compiled {} vertex loaders from {}", loaded, filename);
+}
+
 void UpdateVertexArrayPointers()
 {
   // Anything to update?
@@ -231,6 +348,8 @@ VertexLoaderBase* GetOrCreateLoader(int vtx_attr_group)
         VertexLoaderBase::CreateVertexLoader(state->vtx_desc, state->vtx_attr[vtx_attr_group]));
     loader = it->second.get();
     INCSTAT(g_stats.num_vertex_loaders);
+    INCSTAT(g_stats.this_frame.num_vertex_loader_compiles);
+    AppendLoaderUID(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
   }
   if (check_for_native_format)
   {
@@ -338,6 +457,8 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     return 0;
   ASSERT(count > 0);
 
+  VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::VertexLoading);
+
   VertexLoaderBase* loader = RefreshLoader<IsPreprocess>(vtx_attr_group);
 
   int size = count * loader->m_vertex_size;
@@ -373,6 +494,8 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
 
     g_vertex_manager->AddIndices(primitive, count);
     g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
+    if (VideoCommon::g_draw_capture.IsCapturing())
+      VideoCommon::g_draw_capture.OnVerticesLoaded(loader);
 
     ADDSTAT(g_stats.this_frame.num_prims, count);
     INCSTAT(g_stats.this_frame.num_primitive_joins);
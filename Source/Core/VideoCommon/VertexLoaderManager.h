@@ -28,6 +28,10 @@ using NativeVertexFormatMap =
 void Init();
 void Clear();
 
+// Compiles the vertex loaders the current game used in earlier sessions, and records any new
+// ones for the next boot. Does nothing if the shader cache is disabled.
+void LoadLoaderUIDCache();
+
 void MarkAllDirty();
 
 // Creates or obtains a pointer to a VertexFormat representing decl.
@@ -19,7 +19,10 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/DrawCapture.h"
+#include "VideoCommon/FrameTimeline.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/GPUTiming.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModActionData.h"
 #include "VideoCommon/IndexGenerator.h"
@@ -388,6 +391,10 @@ void VertexManagerBase::Flush()
   if (m_is_flushed)
     return;
 
+  VideoCommon::TimelineScope timeline_scope(VideoCommon::TimelineCategory::FlushAndSubmit);
+  VideoCommon::DrawCaptureScope draw_capture_scope(
+      m_current_primitive_type, m_index_generator.GetNumVerts(), m_index_generator.GetIndexLen());
+
   m_is_flushed = true;
 
   if (xfmem.numTexGen.numTexGens != bpmem.genMode.numtexgens ||
@@ -484,29 +491,25 @@ void VertexManagerBase::Flush()
   CalculateBinormals(VertexLoaderManager::GetCurrentVertexFormat());
   // Calculate ZSlope for zfreeze
   const auto used_textures = UsedTextures();
-  std::vector<std::string> texture_names;
+  const GraphicsModManager& graphics_mod_manager = g_renderer->GetGraphicsModManager();
+  const bool use_texture_names =
+      g_ActiveConfig.bGraphicMods && graphics_mod_manager.HasTextureActions();
+  std::vector<u64> texture_name_hashes;
   if (!m_cull_all)
   {
-    if (!g_ActiveConfig.bGraphicMods)
+    for (const u32 i : used_textures)
     {
-      for (const u32 i : used_textures)
+      const int uploads = g_stats.num_textures_uploaded;
+      const auto cache_entry = g_texture_cache->Load(TextureInfo::FromStage(i));
+      if (VideoCommon::g_draw_capture.IsCapturing())
+        VideoCommon::g_draw_capture.OnTextureLoaded(g_stats.num_textures_uploaded - uploads);
+      if (use_texture_names && cache_entry)
       {
-        g_texture_cache->Load(TextureInfo::FromStage(i));
-      }
-    }
-    else
-    {
-      for (const u32 i : used_textures)
-      {
-        const auto cache_entry = g_texture_cache->Load(TextureInfo::FromStage(i));
-        if (cache_entry)
-        {
-          texture_names.push_back(cache_entry->texture_info_name);
-        }
+        texture_name_hashes.push_back(cache_entry->texture_info_name_hash);
       }
     }
   }
-  VertexShaderManager::SetConstants(texture_names);
+  VertexShaderManager::SetConstants(texture_name_hashes);
   if (!bpmem.genMode.zfreeze)
   {
     // Must be done after VertexShaderManager::SetConstants()
@@ -520,12 +523,11 @@ void VertexManagerBase::Flush()
 
   if (!m_cull_all)
   {
-    for (const auto& texture_name : texture_names)
+    for (const u64 texture_name_hash : texture_name_hashes)
     {
       bool skip = false;
       GraphicsModActionData::DrawStarted draw_started{&skip};
-      for (const auto action :
-           g_renderer->GetGraphicsModManager().GetDrawStartedActions(texture_name))
+      for (const auto action : graphics_mod_manager.GetDrawStartedActions(texture_name_hash))
       {
         action->OnDrawStarted(&draw_started);
       }
@@ -565,14 +567,21 @@ void VertexManagerBase::Flush()
     // Update the pipeline, or compile one if needed.
     UpdatePipelineConfig();
     UpdatePipelineObject();
+    if (m_current_pipeline_pending)
+      g_shader_cache->AddPendingPipelineDraw(m_current_pipeline_config, num_indices);
     if (m_current_pipeline_object)
     {
       g_renderer->SetPipeline(m_current_pipeline_object);
       if (PerfQueryBase::ShouldEmulate())
         g_perf_query->EnableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
 
+      g_renderer->SetGPUTimingCategory(VideoCommon::GPUTimingCategory::Draws);
       DrawCurrentBatch(base_index, num_indices, base_vertex);
       INCSTAT(g_stats.this_frame.num_draw_calls);
+      if (m_current_pipeline_is_uber)
+        INCSTAT(g_stats.this_frame.num_ubershader_draw_calls);
+      if (VideoCommon::g_draw_capture.IsCapturing())
+        VideoCommon::g_draw_capture.SetDrawPipeline(m_current_pipeline_is_uber);
 
       if (PerfQueryBase::ShouldEmulate())
         g_perf_query->DisableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
@@ -778,6 +787,8 @@ void VertexManagerBase::UpdatePipelineObject()
     return;
 
   m_current_pipeline_object = nullptr;
+  m_current_pipeline_is_uber = false;
+  m_current_pipeline_pending = false;
   m_pipeline_config_changed = false;
 
   switch (g_ActiveConfig.iShaderCompilationMode)
@@ -794,6 +805,7 @@ void VertexManagerBase::UpdatePipelineObject()
     // Exclusive ubershader mode, always use ubershaders.
     m_current_pipeline_object =
         g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+    m_current_pipeline_is_uber = true;
   }
   break;
 
@@ -814,13 +826,14 @@ void VertexManagerBase::UpdatePipelineObject()
       // Specialized shaders not ready, use the ubershaders.
       m_current_pipeline_object =
           g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+      m_current_pipeline_is_uber = true;
     }
-    else
-    {
-      // Ensure we try again next draw. Otherwise, if no registers change between frames, the
-      // object will never be drawn, even when the shader is ready.
-      m_pipeline_config_changed = true;
-    }
+
+    // Ensure we try again next draw. Otherwise, if no registers change between frames, the
+    // object will never be drawn, or the ubershader will keep being used, even when the
+    // specialized shader is ready.
+    m_current_pipeline_pending = true;
+    m_pipeline_config_changed = true;
   }
   break;
   }
@@ -48,6 +48,21 @@ static std::array<int, 2> nLightsChanged;                 // min,max
 
 static Common::Matrix44 s_viewportCorrection;
 
+// What the projection constants were last computed from. Games often load the same projection
+// again, e.g. for every object, which then doesn't need the matrices to be built again.
+struct ProjectionInputs
+{
+  Projection::Raw raw_projection;
+  ProjectionType type;
+  float aspect_ratio_hack_w;
+  float aspect_ratio_hack_h;
+  bool freelook;
+
+  bool operator==(const ProjectionInputs&) const = default;
+};
+static ProjectionInputs s_projection_inputs;
+static bool s_projection_inputs_valid;
+
 VertexShaderConstants VertexShaderManager::constants;
 bool VertexShaderManager::dirty;
 
@@ -66,6 +81,7 @@ void VertexShaderManager::Init()
   bTexMtxInfoChanged = false;
   bLightingConfigChanged = false;
   bProjectionGraphicsModChange = false;
+  s_projection_inputs_valid = false;
 
   std::memset(static_cast<void*>(&xfmem), 0, sizeof(xfmem));
   constants = {};
@@ -82,13 +98,33 @@ void VertexShaderManager::Dirty()
   // This function is called after a savestate is loaded.
   // Any constants that can changed based on settings should be re-calculated
   bProjectionChanged = true;
+  s_projection_inputs_valid = false;
 
   dirty = true;
 }
 
+static ProjectionInputs GetProjectionInputs()
+{
+  return {xfmem.projection.rawProjection, xfmem.projection.type, g_ActiveConfig.fAspectRatioHackW,
+          g_ActiveConfig.fAspectRatioHackH,
+          g_freelook_camera.IsActive() && xfmem.projection.type == ProjectionType::Perspective};
+}
+
 // Syncs the shader constant buffers with xfmem
 // TODO: A cleaner way to control the matrices without making a mess in the parameters field
-void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
+// Copies data into the constants, and only marks them dirty if that changed them. Games often load
+// the same matrices again, e.g. for every object, and any change means that the whole block is
+// uploaded again for the next draw.
+static void UpdateConstants(void* dst, const void* src, size_t size)
+{
+  if (std::memcmp(dst, src, size) == 0)
+    return;
+
+  std::memcpy(dst, src, size);
+  VertexShaderManager::dirty = true;
+}
+
+void VertexShaderManager::SetConstants(const std::vector<u64>& texture_name_hashes)
 {
   if (constants.missing_color_hex != g_ActiveConfig.iMissingColorValue)
   {
@@ -106,9 +142,8 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
   {
     int startn = nTransformMatricesChanged[0] / 4;
     int endn = (nTransformMatricesChanged[1] + 3) / 4;
-    memcpy(constants.transformmatrices[startn].data(), &xfmem.posMatrices[startn * 4],
-           (endn - startn) * sizeof(float4));
-    dirty = true;
+    UpdateConstants(constants.transformmatrices[startn].data(), &xfmem.posMatrices[startn * 4],
+                    (endn - startn) * sizeof(float4));
     nTransformMatricesChanged[0] = nTransformMatricesChanged[1] = -1;
   }
 
@@ -117,10 +152,7 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
     int startn = nNormalMatricesChanged[0] / 3;
     int endn = (nNormalMatricesChanged[1] + 2) / 3;
     for (int i = startn; i < endn; i++)
-    {
-      memcpy(constants.normalmatrices[i].data(), &xfmem.normalMatrices[3 * i], 12);
-    }
-    dirty = true;
+      UpdateConstants(constants.normalmatrices[i].data(), &xfmem.normalMatrices[3 * i], 12);
     nNormalMatricesChanged[0] = nNormalMatricesChanged[1] = -1;
   }
 
@@ -128,9 +160,8 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
   {
     int startn = nPostTransformMatricesChanged[0] / 4;
     int endn = (nPostTransformMatricesChanged[1] + 3) / 4;
-    memcpy(constants.posttransformmatrices[startn].data(), &xfmem.postMatrices[startn * 4],
-           (endn - startn) * sizeof(float4));
-    dirty = true;
+    UpdateConstants(constants.posttransformmatrices[startn].data(),
+                    &xfmem.postMatrices[startn * 4], (endn - startn) * sizeof(float4));
     nPostTransformMatricesChanged[0] = nPostTransformMatricesChanged[1] = -1;
   }
 
@@ -214,11 +245,10 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
     const float* norm =
         &xfmem.normalMatrices[3 * (g_main_cp_state.matrix_index_a.PosNormalMtxIdx & 31)];
 
-    memcpy(constants.posnormalmatrix.data(), pos, 3 * sizeof(float4));
-    memcpy(constants.posnormalmatrix[3].data(), norm, 3 * sizeof(float));
-    memcpy(constants.posnormalmatrix[4].data(), norm + 3, 3 * sizeof(float));
-    memcpy(constants.posnormalmatrix[5].data(), norm + 6, 3 * sizeof(float));
-    dirty = true;
+    UpdateConstants(constants.posnormalmatrix.data(), pos, 3 * sizeof(float4));
+    UpdateConstants(constants.posnormalmatrix[3].data(), norm, 3 * sizeof(float));
+    UpdateConstants(constants.posnormalmatrix[4].data(), norm + 3, 3 * sizeof(float));
+    UpdateConstants(constants.posnormalmatrix[5].data(), norm + 6, 3 * sizeof(float));
   }
 
   if (bTexMatricesChanged[0])
@@ -233,9 +263,9 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
 
     for (size_t i = 0; i < pos_matrix_ptrs.size(); ++i)
     {
-      memcpy(constants.texmatrices[3 * i].data(), pos_matrix_ptrs[i], 3 * sizeof(float4));
+      UpdateConstants(constants.texmatrices[3 * i].data(), pos_matrix_ptrs[i],
+                      3 * sizeof(float4));
     }
-    dirty = true;
   }
 
   if (bTexMatricesChanged[1])
@@ -250,9 +280,9 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
 
     for (size_t i = 0; i < pos_matrix_ptrs.size(); ++i)
     {
-      memcpy(constants.texmatrices[3 * i + 12].data(), pos_matrix_ptrs[i], 3 * sizeof(float4));
+      UpdateConstants(constants.texmatrices[3 * i + 12].data(), pos_matrix_ptrs[i],
+                      3 * sizeof(float4));
     }
-    dirty = true;
   }
 
   if (bViewportChanged)
@@ -314,7 +344,7 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
   }
 
   std::vector<GraphicsModAction*> projection_actions;
-  if (g_ActiveConfig.bGraphicMods)
+  if (g_ActiveConfig.bGraphicMods && g_renderer->GetGraphicsModManager().HasProjectionActions())
   {
     for (const auto action :
          g_renderer->GetGraphicsModManager().GetProjectionActions(xfmem.projection.type))
@@ -322,21 +352,29 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
       projection_actions.push_back(action);
     }
 
-    for (const auto& texture : textures)
+    for (const u64 texture_name_hash : texture_name_hashes)
     {
       for (const auto action : g_renderer->GetGraphicsModManager().GetProjectionTextureActions(
-               xfmem.projection.type, texture))
+               xfmem.projection.type, texture_name_hash))
       {
         projection_actions.push_back(action);
       }
     }
   }
 
+  if (bProjectionChanged && !g_freelook_camera.GetController()->IsDirty() &&
+      projection_actions.empty() && !bProjectionGraphicsModChange)
+  {
+    bProjectionChanged = !s_projection_inputs_valid || GetProjectionInputs() != s_projection_inputs;
+  }
+
   if (bProjectionChanged || g_freelook_camera.GetController()->IsDirty() ||
       !projection_actions.empty() || bProjectionGraphicsModChange)
   {
     bProjectionChanged = false;
     bProjectionGraphicsModChange = !projection_actions.empty();
+    s_projection_inputs = GetProjectionInputs();
+    s_projection_inputs_valid = true;
 
     const auto& rawProjection = xfmem.projection.rawProjection;
 
@@ -413,7 +451,7 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
 
     auto corrected_matrix = s_viewportCorrection * Common::Matrix44::FromArray(g_fProjectionMatrix);
 
-    if (g_freelook_camera.IsActive() && xfmem.projection.type == ProjectionType::Perspective)
+    if (s_projection_inputs.freelook)
       corrected_matrix *= g_freelook_camera.GetView();
 
     GraphicsModActionData::Projection projection{&corrected_matrix};
@@ -422,11 +460,9 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
       action->OnProjection(&projection);
     }
 
-    memcpy(constants.projection.data(), corrected_matrix.data.data(), 4 * sizeof(float4));
+    UpdateConstants(constants.projection.data(), corrected_matrix.data.data(), 4 * sizeof(float4));
 
     g_freelook_camera.GetController()->SetClean();
-
-    dirty = true;
   }
 
   if (bTexMtxInfoChanged)
@@ -21,7 +21,8 @@ public:
   static void DoState(PointerWrap& p);
 
   // constant management
-  static void SetConstants(const std::vector<std::string>& textures);
+  // texture_name_hashes are of the textures used by the draw, for graphics mods.
+  static void SetConstants(const std::vector<u64>& texture_name_hashes);
 
   static void InvalidateXFRange(int start, int end);
   static void SetTexMatrixChangedA(u32 value);
@@ -16,6 +16,7 @@
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
+#include "Common/Trace.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -147,6 +148,23 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
     return 0;
   }
 
+  if (g_ActiveConfig.bPerfQueriesAsync)
+  {
+    // Don't stall the CPU thread on the GPU. Have the GPU thread collect whatever has finished in
+    // the background, and answer with the last complete result in the meantime.
+    if (const std::optional<u32> result = g_perf_query->GetAsyncQueryResult(type))
+    {
+      if (!g_perf_query->IsFlushed())
+      {
+        AsyncRequests::Event e;
+        e.time = 0;
+        e.type = AsyncRequests::Event::PERF_QUERY_POLL;
+        AsyncRequests::GetInstance()->PushEvent(e, false);
+      }
+      return *result;
+    }
+  }
+
   Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
 
   AsyncRequests::Event e;
@@ -156,7 +174,9 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
   if (!g_perf_query->IsFlushed())
     AsyncRequests::GetInstance()->PushEvent(e, true);
 
-  return g_perf_query->GetQueryResult(type);
+  const u32 result = g_perf_query->GetQueryResult(type);
+  g_perf_query->SetCompletedQueryResult(type, result);
+  return result;
 }
 
 u16 VideoBackendBase::Video_GetBoundingBox(int index)
@@ -309,6 +329,8 @@ void VideoBackendBase::DoState(PointerWrap& p)
 
 void VideoBackendBase::InitializeShared()
 {
+  Common::Trace::ScopedEvent trace_event("VideoBackendBase::InitializeShared");
+
   memset(reinterpret_cast<u8*>(&g_main_cp_state), 0, sizeof(g_main_cp_state));
   memset(reinterpret_cast<u8*>(&g_preprocess_cp_state), 0, sizeof(g_preprocess_cp_state));
   memset(texMem, 0, TMEM_SIZE);
@@ -328,6 +350,8 @@ void VideoBackendBase::InitializeShared()
 
   g_Config.VerifyValidity();
   UpdateActiveConfig();
+
+  VertexLoaderManager::LoadLoaderUIDCache();
 }
 
 void VideoBackendBase::ShutdownShared()
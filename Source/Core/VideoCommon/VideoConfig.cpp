@@ -20,10 +20,14 @@ VideoConfig g_Config;
 VideoConfig g_ActiveConfig;
 static bool s_has_registered_callback = false;
 
+// Texture memory limits in low memory mode, in MB.
+constexpr int LOW_MEMORY_HIRES_TEXTURES_LIMIT = 128;
+constexpr int LOW_MEMORY_TEXTURE_CACHE_BUDGET = 256;
+
 static bool IsVSyncActive(bool enabled)
 {
-  // Vsync is disabled when the throttler is disabled by the tab key.
-  return enabled && !Core::GetIsThrottlerTempDisabled() &&
+  // Vsync is disabled when the throttler is disabled by the tab key or by fast movie playback.
+  return enabled && !Core::GetIsThrottlerTempDisabled() && !Movie::IsFastPlayback() &&
          Config::Get(Config::MAIN_EMULATION_SPEED) == 1.0;
 }
 
@@ -54,6 +58,7 @@ void VideoConfig::Refresh()
   }
 
   bVSync = Config::Get(Config::GFX_VSYNC);
+  bDisplayPacing = Config::Get(Config::GFX_DISPLAY_PACING);
   iAdapter = Config::Get(Config::GFX_ADAPTER);
   iManuallyUploadBuffers = Config::Get(Config::GFX_MTL_MANUALLY_UPLOAD_BUFFERS);
   bUsePresentDrawable = Config::Get(Config::GFX_MTL_USE_PRESENT_DRAWABLE);
@@ -68,14 +73,19 @@ void VideoConfig::Refresh()
   bShowNetPlayPing = Config::Get(Config::GFX_SHOW_NETPLAY_PING);
   bShowNetPlayMessages = Config::Get(Config::GFX_SHOW_NETPLAY_MESSAGES);
   bLogRenderTimeToFile = Config::Get(Config::GFX_LOG_RENDER_TIME_TO_FILE);
+  bLogGPUTimingsToFile = Config::Get(Config::GFX_LOG_GPU_TIMINGS_TO_FILE);
   bOverlayStats = Config::Get(Config::GFX_OVERLAY_STATS);
+  bShowFrameTimeline = Config::Get(Config::GFX_SHOW_FRAME_TIMELINE);
   bOverlayProjStats = Config::Get(Config::GFX_OVERLAY_PROJ_STATS);
   bOverlayScissorStats = Config::Get(Config::GFX_OVERLAY_SCISSOR_STATS);
   bDumpTextures = Config::Get(Config::GFX_DUMP_TEXTURES);
   bDumpMipmapTextures = Config::Get(Config::GFX_DUMP_MIP_TEXTURES);
   bDumpBaseTextures = Config::Get(Config::GFX_DUMP_BASE_TEXTURES);
+  bDumpTexturesFastCompression = Config::Get(Config::GFX_DUMP_TEXTURES_FAST_COMPRESSION);
   bHiresTextures = Config::Get(Config::GFX_HIRES_TEXTURES);
   bCacheHiresTextures = Config::Get(Config::GFX_CACHE_HIRES_TEXTURES);
+  bHiresTexturesStreaming = Config::Get(Config::GFX_HIRES_TEXTURES_STREAMING);
+  iHiresTexturesMemoryLimit = Config::Get(Config::GFX_HIRES_TEXTURES_MEMORY_LIMIT);
   bDumpEFBTarget = Config::Get(Config::GFX_DUMP_EFB_TARGET);
   bDumpXFBTarget = Config::Get(Config::GFX_DUMP_XFB_TARGET);
   bDumpFramesAsImages = Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
@@ -84,16 +94,21 @@ void VideoConfig::Refresh()
   sDumpCodec = Config::Get(Config::GFX_DUMP_CODEC);
   sDumpPixelFormat = Config::Get(Config::GFX_DUMP_PIXEL_FORMAT);
   sDumpEncoder = Config::Get(Config::GFX_DUMP_ENCODER);
+  bDumpHardwareEncoder = Config::Get(Config::GFX_DUMP_HARDWARE_ENCODER);
   sDumpPath = Config::Get(Config::GFX_DUMP_PATH);
   iBitrateKbps = Config::Get(Config::GFX_BITRATE_KBPS);
   bInternalResolutionFrameDumps = Config::Get(Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS);
   bEnableGPUTextureDecoding = Config::Get(Config::GFX_ENABLE_GPU_TEXTURE_DECODING);
   bPreferVSForLinePointExpansion = Config::Get(Config::GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION);
+  iTextureCacheBudgetMB = Config::Get(Config::GFX_TEXTURE_CACHE_BUDGET_MB);
   bEnablePixelLighting = Config::Get(Config::GFX_ENABLE_PIXEL_LIGHTING);
   bFastDepthCalc = Config::Get(Config::GFX_FAST_DEPTH_CALC);
   iMultisamples = Config::Get(Config::GFX_MSAA);
   bSSAA = Config::Get(Config::GFX_SSAA);
   iEFBScale = Config::Get(Config::GFX_EFB_SCALE);
+  bDynamicResolution = Config::Get(Config::GFX_DYNAMIC_RESOLUTION);
+  iDynamicResolutionMinScale = Config::Get(Config::GFX_DYNAMIC_RESOLUTION_MIN_SCALE);
+  bThermalGovernor = Config::Get(Config::GFX_THERMAL_GOVERNOR);
   bTexFmtOverlayEnable = Config::Get(Config::GFX_TEXFMT_OVERLAY_ENABLE);
   bTexFmtOverlayCenter = Config::Get(Config::GFX_TEXFMT_OVERLAY_CENTER);
   bWireFrame = Config::Get(Config::GFX_ENABLE_WIREFRAME);
@@ -107,6 +122,7 @@ void VideoConfig::Refresh()
   iShaderCompilationMode = Config::Get(Config::GFX_SHADER_COMPILATION_MODE);
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
+  iSWRasterizerThreads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
 
   bForceFiltering = Config::Get(Config::GFX_ENHANCE_FORCE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
@@ -138,6 +154,7 @@ void VideoConfig::Refresh()
   bSkipPresentingDuplicateXFBs = Config::Get(Config::GFX_HACK_SKIP_DUPLICATE_XFBS);
   bCopyEFBScaled = Config::Get(Config::GFX_HACK_COPY_EFB_SCALED);
   bEFBEmulateFormatChanges = Config::Get(Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES);
+  bReducedPrecisionEFBDepth = Config::Get(Config::GFX_HACK_REDUCED_PRECISION_EFB_DEPTH);
   bVertexRounding = Config::Get(Config::GFX_HACK_VERTEX_ROUNDING);
   iEFBAccessTileSize = Config::Get(Config::GFX_HACK_EFB_ACCESS_TILE_SIZE);
   iMissingColorValue = Config::Get(Config::GFX_HACK_MISSING_COLOR_VALUE);
@@ -147,8 +164,21 @@ void VideoConfig::Refresh()
 #endif
 
   bPerfQueriesEnable = Config::Get(Config::GFX_PERF_QUERIES_ENABLE);
+  bPerfQueriesAsync = Config::Get(Config::GFX_PERF_QUERIES_ASYNC);
 
   bGraphicMods = Config::Get(Config::GFX_MODS_ENABLE);
+
+  bLowMemoryMode = Config::Get(Config::MAIN_LOW_MEMORY_MODE);
+  if (bLowMemoryMode)
+  {
+    // Prefetching keeps every custom texture of the game in memory, so stream them instead.
+    bCacheHiresTextures = false;
+    iHiresTexturesMemoryLimit =
+        std::min(iHiresTexturesMemoryLimit, LOW_MEMORY_HIRES_TEXTURES_LIMIT);
+    iTextureCacheBudgetMB = iTextureCacheBudgetMB == 0 ?
+                                LOW_MEMORY_TEXTURE_CACHE_BUDGET :
+                                std::min(iTextureCacheBudgetMB, LOW_MEMORY_TEXTURE_CACHE_BUDGET);
+  }
 }
 
 void VideoConfig::VerifyValidity()
@@ -220,3 +250,12 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
   else
     return GetNumAutoShaderCompilerThreads();
 }
+
+u32 VideoConfig::GetSWRasterizerThreads() const
+{
+  if (iSWRasterizerThreads >= 0)
+    return static_cast<u32>(iSWRasterizerThreads);
+
+  // Automatic number. The video thread rasterizes as well, and the CPU thread is busy emulating.
+  return static_cast<u32>(std::max(cpu_info.num_cores - 2, 0));
+}
@@ -62,6 +62,8 @@ struct VideoConfig final
   // General
   bool bVSync = false;
   bool bVSyncActive = false;
+  // Schedule presents on the display's refresh cycle, if the backend supports it.
+  bool bDisplayPacing = false;
   bool bWidescreenHack = false;
   AspectMode aspect_mode{};
   AspectMode suggested_aspect_mode{};
@@ -73,6 +75,13 @@ struct VideoConfig final
   u32 iMultisamples = 0;
   bool bSSAA = false;
   int iEFBScale = 0;
+  // Lowers the internal resolution when the GPU can't keep up, down to the given percentage of
+  // iEFBScale. Needs a backend which supports GPU timestamps.
+  bool bDynamicResolution = false;
+  int iDynamicResolutionMinScale = 50;
+  // Lowers the internal resolution ahead of thermal throttling, down to the same minimum scale.
+  // Needs the platform to report the thermal headroom (Android 12+).
+  bool bThermalGovernor = false;
   bool bForceFiltering = false;
   int iMaxAnisotropy = 0;
   std::string sPostProcessingShader;
@@ -87,11 +96,13 @@ struct VideoConfig final
   bool bShowNetPlayPing = false;
   bool bShowNetPlayMessages = false;
   bool bOverlayStats = false;
+  bool bShowFrameTimeline = false;
   bool bOverlayProjStats = false;
   bool bOverlayScissorStats = false;
   bool bTexFmtOverlayEnable = false;
   bool bTexFmtOverlayCenter = false;
   bool bLogRenderTimeToFile = false;
+  bool bLogGPUTimingsToFile = false;
 
   // Render
   bool bWireFrame = false;
@@ -101,8 +112,14 @@ struct VideoConfig final
   bool bDumpTextures = false;
   bool bDumpMipmapTextures = false;
   bool bDumpBaseTextures = false;
+  // Trades larger files for much faster PNG encoding of dumped textures.
+  bool bDumpTexturesFastCompression = false;
   bool bHiresTextures = false;
   bool bCacheHiresTextures = false;
+  // Loads custom textures on worker threads instead of when they're first used, keeping up to
+  // iHiresTexturesMemoryLimit MB of them in memory. Ignored when they're all prefetched.
+  bool bHiresTexturesStreaming = false;
+  int iHiresTexturesMemoryLimit = 512;
   bool bDumpEFBTarget = false;
   bool bDumpXFBTarget = false;
   bool bDumpFramesAsImages = false;
@@ -110,12 +127,18 @@ struct VideoConfig final
   std::string sDumpCodec;
   std::string sDumpPixelFormat;
   std::string sDumpEncoder;
+  // Prefer a hardware encoder for the dump codec, if sDumpEncoder doesn't name one.
+  bool bDumpHardwareEncoder = false;
   std::string sDumpFormat;
   std::string sDumpPath;
   bool bInternalResolutionFrameDumps = false;
   bool bBorderlessFullscreen = false;
   bool bEnableGPUTextureDecoding = false;
   bool bPreferVSForLinePointExpansion = false;
+  int iTextureCacheBudgetMB = 0;
+  // Mirrors MAIN_LOW_MEMORY_MODE. Caps the texture memory limits above and makes the shader cache
+  // load shaders from disk when they're first used instead of all at startup.
+  bool bLowMemoryMode = false;
   int iBitrateKbps = 0;
   bool bGraphicMods = false;
   std::optional<GraphicsModGroupConfig> graphics_mod_config;
@@ -124,10 +147,13 @@ struct VideoConfig final
   bool bEFBAccessEnable = false;
   bool bEFBAccessDeferInvalidation = false;
   bool bPerfQueriesEnable = false;
+  bool bPerfQueriesAsync = false;
   bool bBBoxEnable = false;
   bool bForceProgressive = false;
 
   bool bEFBEmulateFormatChanges = false;
+  // Use a D24S8 EFB depth buffer instead of D32F where supported, to save bandwidth on tilers.
+  bool bReducedPrecisionEFBDepth = false;
   bool bSkipEFBCopyToRam = false;
   bool bSkipXFBCopyToRam = false;
   bool bDisableCopyToVRAM = false;
@@ -185,6 +211,10 @@ struct VideoConfig final
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // Number of worker threads the software renderer rasterizes on, besides the video thread.
+  // -1 uses an automatic number based on the CPU threads.
+  int iSWRasterizerThreads = 0;
+
   // Static config per API
   // TODO: Move this out of VideoConfig
   struct
@@ -241,6 +271,9 @@ struct VideoConfig final
     bool bSupportsPartialMultisampleResolve = false;
     bool bSupportsDynamicVertexLoader = false;
     bool bSupportsVSLinePointExpand = false;
+    bool bSupportsD24S8DepthBuffer = false;
+    bool bSupportsETC2Textures = false;
+    bool bSupportsASTCTextures = false;
   } backend_info;
 
   // Utility
@@ -275,6 +308,7 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetSWRasterizerThreads() const;
 };
 
 extern VideoConfig g_Config;
@@ -3,9 +3,11 @@
 
 #include "VideoCommon/VideoState.h"
 
+#include <atomic>
 #include <cstring>
 
 #include "Common/ChunkFile.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
@@ -23,6 +25,18 @@
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/XFMemory.h"
 
+static std::atomic_bool s_skip_gpu_readback;
+
+void VideoCommon_SetSkipGPUReadback(bool skip)
+{
+  s_skip_gpu_readback = skip;
+}
+
+bool VideoCommon_ShouldSaveGPUState()
+{
+  return !s_skip_gpu_readback && Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE);
+}
+
 void VideoCommon_DoState(PointerWrap& p)
 {
   bool software = false;
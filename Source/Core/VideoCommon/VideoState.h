@@ -6,3 +6,10 @@
 class PointerWrap;
 
 void VideoCommon_DoState(PointerWrap& p);
+
+// While set, saved states leave out the EFB and texture cache contents, which have to be read
+// back from the GPU. Used for states that have to be taken quickly, like NetPlay rollback
+// snapshots. Loading such a state discards the texture cache.
+void VideoCommon_SetSkipGPUReadback(bool skip);
+// Whether the EFB and texture cache contents are to be included in saved states.
+bool VideoCommon_ShouldSaveGPUState();
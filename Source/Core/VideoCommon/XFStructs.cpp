@@ -3,6 +3,12 @@
 
 #include "VideoCommon/XFStructs.h"
 
+#if defined(_M_X86)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -26,6 +32,77 @@ static void XFMemWritten(u32 transferSize, u32 baseAddress)
   VertexShaderManager::InvalidateXFRange(baseAddress, baseAddress + transferSize);
 }
 
+// Matrix loads are a few dozen words each, and games issue thousands of them per frame, so the
+// byteswapped compares and copies below work on four words at a time.
+#if defined(_M_X86)
+static __m128i LoadSwapped(const u8* src)
+{
+  // SSE2 has no byte shuffle: swap the bytes of each half, then the halves of each word.
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+  return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+#elif defined(_M_ARM_64)
+static uint32x4_t LoadSwapped(const u8* src)
+{
+  return vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(src)));
+}
+#endif
+
+// Returns whether the big-endian words at src differ from the words at dst.
+static bool XFDataDiffers(const u32* dst, const u8* src, u32 count)
+{
+  u32 i = 0;
+#if defined(_M_X86)
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(current, LoadSwapped(src + i * 4))) != 0xFFFF)
+      return true;
+  }
+#elif defined(_M_ARM_64)
+  for (; i + 4 <= count; i += 4)
+  {
+    if (vminvq_u32(vceqq_u32(vld1q_u32(dst + i), LoadSwapped(src + i * 4))) == 0)
+      return true;
+  }
+#endif
+  for (; i < count; i++)
+  {
+    if (dst[i] != Common::swap32(src + i * 4))
+      return true;
+  }
+  return false;
+}
+
+// Copies count big-endian words from src to dst.
+static void CopySwappedXFData(u32* dst, const u8* src, u32 count)
+{
+  u32 i = 0;
+#if defined(_M_X86)
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), LoadSwapped(src + i * 4));
+#elif defined(_M_ARM_64)
+  for (; i + 4 <= count; i += 4)
+    vst1q_u32(dst + i, LoadSwapped(src + i * 4));
+#endif
+  for (; i < count; i++)
+    dst[i] = Common::swap32(src + i * 4);
+}
+
+// Writes the big-endian words at src to XF memory, flushing and invalidating the range only if
+// they change it.
+static void LoadXFMem(u32 address, const u8* src, u32 count)
+{
+  u32* const dst = reinterpret_cast<u32*>(&xfmem) + address;
+  if (!XFDataDiffers(dst, src, count))
+    return;
+
+  XFMemWritten(count, address);
+  CopySwappedXFData(dst, src, count);
+}
+
 static void XFRegWritten(u32 address, u32 value)
 {
   if (address >= XFMEM_REGISTERS_START && address < XFMEM_REGISTERS_END)
@@ -226,12 +303,8 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
       base_address = XFMEM_REGISTERS_START;
     }
 
-    XFMemWritten(xf_mem_transfer_size, xf_mem_base);
-    for (u32 i = 0; i < xf_mem_transfer_size; i++)
-    {
-      ((u32*)&xfmem)[xf_mem_base + i] = Common::swap32(data);
-      data += 4;
-    }
+    LoadXFMem(xf_mem_base, data, xf_mem_transfer_size);
+    data += xf_mem_transfer_size * 4;
   }
 
   // write to XF regs
@@ -254,32 +327,17 @@ void LoadIndexedXF(CPArray array, u32 index, u16 address, u8 size)
 {
   // load stuff from array to address in xf mem
 
-  u32* currData = (u32*)(&xfmem) + address;
-  u32* newData;
+  const u8* new_data;
   if (Fifo::UseDeterministicGPUThread())
   {
-    newData = (u32*)Fifo::PopFifoAuxBuffer(size * sizeof(u32));
+    new_data = static_cast<const u8*>(Fifo::PopFifoAuxBuffer(size * sizeof(u32)));
   }
   else
   {
-    newData = (u32*)Memory::GetPointer(g_main_cp_state.array_bases[array] +
-                                       g_main_cp_state.array_strides[array] * index);
-  }
-  bool changed = false;
-  for (u32 i = 0; i < size; ++i)
-  {
-    if (currData[i] != Common::swap32(newData[i]))
-    {
-      changed = true;
-      XFMemWritten(size, address);
-      break;
-    }
-  }
-  if (changed)
-  {
-    for (u32 i = 0; i < size; ++i)
-      currData[i] = Common::swap32(newData[i]);
+    new_data = Memory::GetPointer(g_main_cp_state.array_bases[array] +
+                                  g_main_cp_state.array_strides[array] * index);
   }
+  LoadXFMem(address, new_data, size);
 }
 
 void PreprocessIndexedXF(CPArray array, u32 index, u16 address, u8 size)
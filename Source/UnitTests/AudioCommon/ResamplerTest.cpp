@@ -0,0 +1,110 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/Resampler.h"
+#include "Common/CommonTypes.h"
+
+using namespace AudioCommon::Resampler;
+
+namespace
+{
+// Not a multiple of the vector sizes, so that the scalar tails get tested too.
+constexpr u32 COUNT = 0x53;
+// Enough input for a step of up to 4 frames, plus the filter taps on both sides.
+constexpr size_t INPUT_FRAMES = POLYPHASE_HISTORY + COUNT * 4 + POLYPHASE_LOOKAHEAD;
+
+template <size_t N>
+std::array<s16, N> RandomSamples(std::mt19937& rng)
+{
+  // Favor the edges of the range, which is where clamping happens.
+  std::uniform_int_distribution<int> dist(std::numeric_limits<s16>::min(),
+                                          std::numeric_limits<s16>::max());
+  std::uniform_int_distribution<int> pick(0, 7);
+  std::array<s16, N> samples;
+  for (s16& sample : samples)
+  {
+    switch (pick(rng))
+    {
+    case 0:
+      sample = std::numeric_limits<s16>::min();
+      break;
+    case 1:
+      sample = std::numeric_limits<s16>::max();
+      break;
+    default:
+      sample = static_cast<s16>(dist(rng));
+      break;
+    }
+  }
+  return samples;
+}
+
+using MixFunction = void (*)(const s16*, u32, u32, u32, s32, s32, s16*);
+
+void CompareWithScalar(MixFunction mix, MixFunction scalar, unsigned int seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<u32> position_dist(0, 0xFFFF);
+  std::uniform_int_distribution<u32> step_dist(0x1000, 0x40000);
+  std::uniform_int_distribution<s32> volume_dist(0, 256);
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    const auto input = RandomSamples<INPUT_FRAMES * 2>(rng);
+    const u32 position = position_dist(rng);
+    // Include the common case of no resampling at all.
+    const u32 step = iteration % 8 == 0 ? 0x10000 : step_dist(rng);
+    const s32 volume0 = volume_dist(rng);
+    const s32 volume1 = volume_dist(rng);
+
+    auto expected = RandomSamples<COUNT * 2>(rng);
+    auto actual = expected;
+    const s16* in = input.data() + POLYPHASE_HISTORY * 2;
+    scalar(in, position, step, COUNT, volume0, volume1, expected.data());
+    mix(in, position, step, COUNT, volume0, volume1, actual.data());
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+void CheckConstantInput(MixFunction mix)
+{
+  // Both filters have a DC gain of exactly one, so a constant signal must pass through unchanged.
+  for (s16 value : {s16(-32767), s16(-1234), s16(0), s16(1), s16(20000), s16(32767)})
+  {
+    std::array<s16, INPUT_FRAMES * 2> input;
+    input.fill(value);
+    for (u32 step : {0x8000u, 0x10000u, 0x1126Eu, 0x20000u})
+    {
+      std::array<s16, COUNT * 2> output{};
+      mix(input.data() + POLYPHASE_HISTORY * 2, 0x1234, step, COUNT, 256, 256, output.data());
+      for (s16 sample : output)
+        EXPECT_EQ(value, sample);
+    }
+  }
+}
+}  // namespace
+
+TEST(Resampler, MixLinear)
+{
+  CompareWithScalar(MixLinear, MixLinearScalar, 1);
+}
+
+TEST(Resampler, MixPolyphase)
+{
+  CompareWithScalar(MixPolyphase, MixPolyphaseScalar, 2);
+}
+
+TEST(Resampler, LinearConstantInput)
+{
+  CheckConstantInput(MixLinear);
+}
+
+TEST(Resampler, PolyphaseConstantInput)
+{
+  CheckConstantInput(MixPolyphase);
+}
@@ -0,0 +1,29 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+// Texture cache hashing, over the range of texture sizes games use. samples is 0 for a full hash
+// and the safe texture cache's "fast" setting of 128 samples otherwise.
+static void BM_GetHash64(benchmark::State& state)
+{
+  const u32 size = static_cast<u32>(state.range(0));
+  const u32 samples = static_cast<u32>(state.range(1));
+
+  std::mt19937 rng(1);
+  std::vector<u8> data(size);
+  for (u8& byte : data)
+    byte = static_cast<u8>(rng());
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Common::GetHash64(data.data(), size, samples));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+BENCHMARK(BM_GetHash64)->ArgsProduct({{4 << 10, 64 << 10, 1 << 20}, {0, 128}});
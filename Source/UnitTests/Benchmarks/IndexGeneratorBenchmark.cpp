@@ -0,0 +1,46 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+using OpcodeDecoder::Primitive;
+
+// Arguments are the primitive, and whether the backend supports primitive restart.
+static void BM_IndexGenerator(benchmark::State& state)
+{
+  const Primitive primitive = static_cast<Primitive>(state.range(0));
+  g_Config.backend_info.bSupportsPrimitiveRestart = state.range(1) != 0;
+  g_Config.backend_info.bSupportsVSLinePointExpand = false;
+  g_Config.backend_info.bSupportsGeometryShaders = true;
+  g_Config.bPreferVSForLinePointExpansion = false;
+
+  IndexGenerator generator;
+  generator.Init();
+
+  // 60 draws of 1020 vertices fill the 16-bit index range about as much as games do.
+  constexpr u32 draws = 60;
+  constexpr u32 vertices = 1020;
+  std::vector<u16> buffer(65536 * 8);
+  for (auto _ : state)
+  {
+    generator.Start(buffer.data());
+    for (u32 i = 0; i < draws; ++i)
+      generator.AddIndices(primitive, vertices);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * draws * vertices);
+}
+BENCHMARK(BM_IndexGenerator)
+    ->ArgsProduct({{static_cast<int>(Primitive::GX_DRAW_QUADS),
+                    static_cast<int>(Primitive::GX_DRAW_TRIANGLES),
+                    static_cast<int>(Primitive::GX_DRAW_TRIANGLE_STRIP),
+                    static_cast<int>(Primitive::GX_DRAW_TRIANGLE_FAN)},
+                   {0, 1}});
@@ -0,0 +1,160 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexLoaderBase.h"
+
+namespace
+{
+// Only counts what it sees, so that the benchmark measures the decoder and not the consumers of
+// the commands.
+class CountingCallback final : public OpcodeDecoder::Callback
+{
+public:
+  OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data)) { m_xf_writes += count; }
+  OPCODE_CALLBACK(void OnCP(u8 command, u32 value)) { GetCPState().LoadCPReg(command, value); }
+  OPCODE_CALLBACK(void OnBP(u8 command, u32 value)) { m_bp_writes++; }
+  OPCODE_CALLBACK(void OnIndexedLoad(CPArray array, u32 index, u16 address, u8 size)) {}
+  OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat,
+                                          u32 vertex_size, u16 num_vertices,
+                                          const u8* vertex_data))
+  {
+    m_vertices += num_vertices;
+  }
+  OPCODE_CALLBACK(void OnDisplayList(u32 address, u32 size)) {}
+  OPCODE_CALLBACK(void OnNop(u32 count)) {}
+  OPCODE_CALLBACK(void OnUnknown(u8 opcode, const u8* data)) {}
+  OPCODE_CALLBACK(void OnCommand(const u8* data, u32 size)) {}
+  OPCODE_CALLBACK(CPState& GetCPState()) { return m_cp_state; }
+  OPCODE_CALLBACK(u32 GetVertexSize(u8 vat))
+  {
+    return VertexLoaderBase::GetVertexSize(GetCPState().vtx_desc, GetCPState().vtx_attr[vat]);
+  }
+
+  u64 m_xf_writes = 0;
+  u64 m_bp_writes = 0;
+  u64 m_vertices = 0;
+
+private:
+  CPState m_cp_state;
+};
+
+class FifoWriter
+{
+public:
+  void U8(u8 value) { m_data.push_back(value); }
+  void U16(u16 value)
+  {
+    U8(static_cast<u8>(value >> 8));
+    U8(static_cast<u8>(value));
+  }
+  void U32(u32 value)
+  {
+    U16(static_cast<u16>(value >> 16));
+    U16(static_cast<u16>(value));
+  }
+
+  void CP(u8 command, u32 value)
+  {
+    U8(static_cast<u8>(OpcodeDecoder::Opcode::GX_LOAD_CP_REG));
+    U8(command);
+    U32(value);
+  }
+  void BP(u8 command, u32 value)
+  {
+    U8(static_cast<u8>(OpcodeDecoder::Opcode::GX_LOAD_BP_REG));
+    U32(static_cast<u32>(command) << 24 | (value & 0xffffff));
+  }
+  void XF(u16 address, const std::vector<u32>& values)
+  {
+    U8(static_cast<u8>(OpcodeDecoder::Opcode::GX_LOAD_XF_REG));
+    U32(static_cast<u32>(values.size() - 1) << 16 | address);
+    for (u32 value : values)
+      U32(value);
+  }
+  void Primitive(OpcodeDecoder::Primitive primitive, u8 vat, u16 num_vertices, u32 vertex_size)
+  {
+    U8(static_cast<u8>(OpcodeDecoder::Opcode::GX_PRIMITIVE_START) |
+       static_cast<u8>(primitive) << OpcodeDecoder::GX_PRIMITIVE_SHIFT | vat);
+    U16(num_vertices);
+    m_data.resize(m_data.size() + num_vertices * vertex_size, 0x3f);
+  }
+
+  const std::vector<u8>& GetData() const { return m_data; }
+
+private:
+  std::vector<u8> m_data;
+};
+
+// Loading a FIFO log needs emulated memory, so this builds a chunk that resembles a typical draw
+// heavy frame instead: small state changes between many short indexed triangle strips.
+std::vector<u8> MakeFifoChunk()
+{
+  TVtxDesc desc;
+  desc.low.PosMatIdx = 1;
+  desc.low.Position = VertexComponentFormat::Index16;
+  desc.low.Normal = VertexComponentFormat::Index16;
+  desc.low.Color0 = VertexComponentFormat::Direct;
+  desc.high.Tex0Coord = VertexComponentFormat::Index16;
+
+  VAT vat;
+  vat.g0.PosElements = CoordComponentCount::XYZ;
+  vat.g0.PosFormat = ComponentFormat::Float;
+  vat.g0.NormalFormat = ComponentFormat::Float;
+  vat.g0.Color0Elements = ColorComponentCount::RGBA;
+  vat.g0.Color0Comp = ColorFormat::RGBA8888;
+  vat.g0.Tex0CoordElements = TexComponentCount::ST;
+  vat.g0.Tex0CoordFormat = ComponentFormat::Float;
+
+  const u32 vertex_size = VertexLoaderBase::GetVertexSize(desc, vat);
+
+  FifoWriter writer;
+  writer.CP(VCD_LO, desc.low.Hex);
+  writer.CP(VCD_HI, desc.high.Hex);
+  writer.CP(CP_VAT_REG_A, vat.g0.Hex);
+  writer.CP(CP_VAT_REG_B, vat.g1.Hex);
+  writer.CP(CP_VAT_REG_C, vat.g2.Hex);
+
+  for (u32 draw = 0; draw < 1000; draw++)
+  {
+    // A model matrix and a couple of TEV registers per draw.
+    writer.XF(static_cast<u16>((draw % 10) * 12),
+              {0x3f800000, 0, 0, draw, 0, 0x3f800000, 0, 0, 0, 0, 0x3f800000, 0});
+    writer.BP(0xc0, draw);
+    writer.BP(0xc1, draw);
+    writer.Primitive(OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_STRIP, 0, 24 + draw % 40,
+                     vertex_size);
+  }
+
+  return writer.GetData();
+}
+
+void BM_OpcodeDecoder(benchmark::State& state)
+{
+  const std::vector<u8> data = MakeFifoChunk();
+
+  u64 vertices = 0;
+  for (auto _ : state)
+  {
+    CountingCallback callback;
+    const u32 size = static_cast<u32>(data.size());
+    if (OpcodeDecoder::Run(data.data(), size, callback) != size)
+    {
+      state.SkipWithError("Failed to decode the FIFO chunk");
+      return;
+    }
+    vertices += callback.m_vertices;
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * data.size());
+  state.counters["vertices"] = benchmark::Counter(static_cast<double>(vertices),
+                                                  benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_OpcodeDecoder);
+}  // namespace
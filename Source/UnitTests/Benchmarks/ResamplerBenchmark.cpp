@@ -0,0 +1,53 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "AudioCommon/Resampler.h"
+#include "Common/CommonTypes.h"
+
+using namespace AudioCommon::Resampler;
+
+namespace
+{
+// About 85 ms of output, which is in the range of what a backend asks for in one callback.
+constexpr u32 NUM_FRAMES = 4096;
+
+using MixFunction = void (*)(const s16*, u32, u32, u32, s32, s32, s16*);
+
+template <MixFunction Mix>
+void BM_Resample(benchmark::State& state)
+{
+  const u32 step = static_cast<u32>(state.range(0));
+  const u32 input_frames = POLYPHASE_HISTORY + static_cast<u32>((u64{NUM_FRAMES} * step) >> 16) +
+                           POLYPHASE_LOOKAHEAD + 1;
+
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> dist(-20000, 20000);
+  std::vector<s16> input(input_frames * 2);
+  for (s16& sample : input)
+    sample = static_cast<s16>(dist(rng));
+
+  std::vector<s16> output(NUM_FRAMES * 2);
+  for (auto _ : state)
+  {
+    Mix(input.data() + POLYPHASE_HISTORY * 2, 0x4000, step, NUM_FRAMES, 200, 256, output.data());
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * NUM_FRAMES);
+}
+
+// 32000 Hz to 48000 Hz, nearly 1:1, and 48000 Hz to 32000 Hz.
+#define RESAMPLER_BENCHMARK(func)                                                                  \
+  BENCHMARK_TEMPLATE(BM_Resample, func)->Arg(0xAAAB)->Arg(0x1010A)->Arg(0x18000)
+
+RESAMPLER_BENCHMARK(MixLinearScalar);
+RESAMPLER_BENCHMARK(MixLinear);
+RESAMPLER_BENCHMARK(MixPolyphaseScalar);
+RESAMPLER_BENCHMARK(MixPolyphase);
+}  // namespace
@@ -0,0 +1,69 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/VertexShaderGen.h"
+#include "VideoCommon/VideoCommon.h"
+
+// Each iteration generates one shader, so items per second is generated shaders per second.
+
+// Argument is the number of TEV stages, each of which samples a texture.
+static void BM_GeneratePixelShader(benchmark::State& state)
+{
+  const u32 num_stages = static_cast<u32>(state.range(0));
+  const u32 num_texgens = std::min<u32>(num_stages, 8);
+
+  PixelShaderUid uid;
+  pixel_shader_uid_data* const uid_data = uid.GetUidData();
+  uid_data->num_values = sizeof(pixel_shader_uid_data);
+  uid_data->genMode_numtevstages = num_stages - 1;
+  uid_data->genMode_numtexgens = num_texgens;
+  uid_data->numColorChans = 1;
+  for (u32 i = 0; i < num_stages; ++i)
+  {
+    uid_data->stagehash[i].tevorders_enable = 1;
+    uid_data->stagehash[i].tevorders_texmap = i % 8;
+    uid_data->stagehash[i].tevorders_texcoord = i % num_texgens;
+  }
+
+  const ShaderHostConfig host_config = ShaderHostConfig::GetCurrent();
+  for (auto _ : state)
+  {
+    const ShaderCode code = GeneratePixelShaderCode(APIType::Vulkan, host_config, uid_data);
+    benchmark::DoNotOptimize(code.GetBuffer().data());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GeneratePixelShader)->Arg(1)->Arg(4)->Arg(16);
+
+// Argument is the number of texture coordinates.
+static void BM_GenerateVertexShader(benchmark::State& state)
+{
+  const u32 num_texgens = static_cast<u32>(state.range(0));
+
+  VertexShaderUid uid;
+  vertex_shader_uid_data* const uid_data = uid.GetUidData();
+  uid_data->components = VB_HAS_POSMTXIDX | VB_HAS_NORMAL | VB_HAS_COL0;
+  for (u32 i = 0; i < num_texgens; ++i)
+    uid_data->components |= VB_HAS_UV0 << i;
+  uid_data->numTexGens = num_texgens;
+  uid_data->numColorChans = 1;
+
+  const ShaderHostConfig host_config = ShaderHostConfig::GetCurrent();
+  for (auto _ : state)
+  {
+    const ShaderCode code = GenerateVertexShaderCode(APIType::Vulkan, host_config, uid_data);
+    benchmark::DoNotOptimize(code.GetBuffer().data());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GenerateVertexShader)->Arg(0)->Arg(2)->Arg(8);
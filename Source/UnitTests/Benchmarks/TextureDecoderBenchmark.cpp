@@ -0,0 +1,76 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+std::vector<u8> RandomBytes(size_t size, u32 seed)
+{
+  std::mt19937 rng(seed);
+  std::vector<u8> bytes(size);
+  for (u8& byte : bytes)
+    byte = static_cast<u8>(rng());
+  return bytes;
+}
+
+void DecodeTexture(benchmark::State& state, TextureFormat format,
+                   std::optional<TLUTFormat> tlut_format)
+{
+  constexpr int width = 512;
+  constexpr int height = 512;
+  const std::vector<u8> tlut = RandomBytes(TexDecoder_GetPaletteSize(TextureFormat::C14X2), 1);
+  const std::vector<u8> src =
+      RandomBytes(TexDecoder_GetTextureSizeInBytes(width, height, format), 2);
+  std::vector<u8> dst(width * height * 4);
+
+  for (auto _ : state)
+  {
+    TexDecoder_Decode(dst.data(), src.data(), width, height, format, tlut.data(),
+                      tlut_format.value_or(TLUTFormat::IA8));
+    benchmark::DoNotOptimize(dst.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * width * height);
+}
+
+// Registered at startup, so that every format gets a readable name.
+const bool s_registered = [] {
+  constexpr std::pair<TextureFormat, std::optional<TLUTFormat>> formats[] = {
+      {TextureFormat::I4, std::nullopt},
+      {TextureFormat::I8, std::nullopt},
+      {TextureFormat::IA4, std::nullopt},
+      {TextureFormat::IA8, std::nullopt},
+      {TextureFormat::RGB565, std::nullopt},
+      {TextureFormat::RGB5A3, std::nullopt},
+      {TextureFormat::RGBA8, std::nullopt},
+      {TextureFormat::CMPR, std::nullopt},
+      {TextureFormat::C4, TLUTFormat::IA8},
+      {TextureFormat::C4, TLUTFormat::RGB565},
+      {TextureFormat::C4, TLUTFormat::RGB5A3},
+      {TextureFormat::C8, TLUTFormat::IA8},
+      {TextureFormat::C8, TLUTFormat::RGB565},
+      {TextureFormat::C8, TLUTFormat::RGB5A3},
+      {TextureFormat::C14X2, TLUTFormat::IA8},
+      {TextureFormat::C14X2, TLUTFormat::RGB565},
+      {TextureFormat::C14X2, TLUTFormat::RGB5A3},
+  };
+
+  for (const auto& [format, tlut_format] : formats)
+  {
+    const std::string name = tlut_format ?
+                                 fmt::format("BM_TexDecoder/{}/{}", format, *tlut_format) :
+                                 fmt::format("BM_TexDecoder/{}", format);
+    benchmark::RegisterBenchmark(name.c_str(), DecodeTexture, format, tlut_format);
+  }
+  return true;
+}();
+}  // namespace
@@ -0,0 +1,172 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/VertexLoader.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+
+#if defined(_M_X86_64)
+#include "VideoCommon/VertexLoaderX64.h"
+#elif defined(_M_ARM_64)
+#include "VideoCommon/VertexLoaderARM64.h"
+#endif
+
+namespace
+{
+constexpr int VERTEX_COUNT = 10000;
+constexpr u32 ARRAY_STRIDE = 12;
+
+// Vertex data and arrays are filled with big endian 1.0f, which is also a valid index into the
+// arrays whether it's read as one or two bytes.
+std::vector<u8> MakeData(size_t size)
+{
+  constexpr u8 pattern[] = {0x3f, 0x80, 0x00, 0x00};
+  std::vector<u8> data(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = pattern[i % sizeof(pattern)];
+  return data;
+}
+
+struct VertexLayout
+{
+  const char* name;
+  std::function<void(TVtxDesc&, VAT&)> setup;
+};
+
+const VertexLayout LAYOUTS[] = {
+    // Typical for models with fixed point positions and texture coordinates.
+    {"ShortPosByteNrmColorShortTex",
+     [](TVtxDesc& desc, VAT& vat) {
+       desc.low.PosMatIdx = 1;
+       desc.low.Position = VertexComponentFormat::Direct;
+       desc.low.Normal = VertexComponentFormat::Direct;
+       desc.low.Color0 = VertexComponentFormat::Direct;
+       desc.high.Tex0Coord = VertexComponentFormat::Direct;
+       vat.g0.PosElements = CoordComponentCount::XYZ;
+       vat.g0.PosFormat = ComponentFormat::Short;
+       vat.g0.PosFrac = 4;
+       vat.g0.NormalElements = NormalComponentCount::N;
+       vat.g0.NormalFormat = ComponentFormat::Byte;
+       vat.g0.Color0Elements = ColorComponentCount::RGBA;
+       vat.g0.Color0Comp = ColorFormat::RGBA8888;
+       vat.g0.Tex0CoordElements = TexComponentCount::ST;
+       vat.g0.Tex0CoordFormat = ComponentFormat::Short;
+       vat.g0.Tex0Frac = 8;
+     }},
+    // Typical for skinned models, which index into float arrays.
+    {"FloatIndex16PosNrmTex",
+     [](TVtxDesc& desc, VAT& vat) {
+       desc.low.PosMatIdx = 1;
+       desc.low.Position = VertexComponentFormat::Index16;
+       desc.low.Normal = VertexComponentFormat::Index16;
+       desc.high.Tex0Coord = VertexComponentFormat::Index16;
+       vat.g0.PosElements = CoordComponentCount::XYZ;
+       vat.g0.PosFormat = ComponentFormat::Float;
+       vat.g0.NormalElements = NormalComponentCount::N;
+       vat.g0.NormalFormat = ComponentFormat::Float;
+       vat.g0.Tex0CoordElements = TexComponentCount::ST;
+       vat.g0.Tex0CoordFormat = ComponentFormat::Float;
+     }},
+    // Typical for 2D and UI drawing.
+    {"FloatPosColorTex",
+     [](TVtxDesc& desc, VAT& vat) {
+       desc.low.Position = VertexComponentFormat::Direct;
+       desc.low.Color0 = VertexComponentFormat::Direct;
+       desc.high.Tex0Coord = VertexComponentFormat::Direct;
+       vat.g0.PosElements = CoordComponentCount::XYZ;
+       vat.g0.PosFormat = ComponentFormat::Float;
+       vat.g0.Color0Elements = ColorComponentCount::RGBA;
+       vat.g0.Color0Comp = ColorFormat::RGBA8888;
+       vat.g0.Tex0CoordElements = TexComponentCount::ST;
+       vat.g0.Tex0CoordFormat = ComponentFormat::Float;
+     }},
+    // Compact indexed data, with a color format which needs expanding.
+    {"Index8ShortPosRGB565Tex",
+     [](TVtxDesc& desc, VAT& vat) {
+       desc.low.Position = VertexComponentFormat::Index8;
+       desc.low.Color0 = VertexComponentFormat::Index8;
+       desc.high.Tex0Coord = VertexComponentFormat::Index8;
+       vat.g0.PosElements = CoordComponentCount::XYZ;
+       vat.g0.PosFormat = ComponentFormat::Short;
+       vat.g0.PosFrac = 6;
+       vat.g0.Color0Elements = ColorComponentCount::RGB;
+       vat.g0.Color0Comp = ColorFormat::RGB565;
+       vat.g0.Tex0CoordElements = TexComponentCount::ST;
+       vat.g0.Tex0CoordFormat = ComponentFormat::Short;
+       vat.g0.Tex0Frac = 8;
+     }},
+};
+
+using LoaderFactory = std::function<std::unique_ptr<VertexLoaderBase>(const TVtxDesc&, const VAT&)>;
+
+void RunVertexLoader(benchmark::State& state, const VertexLayout& layout,
+                     const LoaderFactory& create_loader)
+{
+  TVtxDesc desc;
+  VAT vat;
+  desc.low.Hex = 0;
+  desc.high.Hex = 0;
+  vat.g0.Hex = 0;
+  vat.g1.Hex = 0;
+  vat.g2.Hex = 0;
+  layout.setup(desc, vat);
+
+  const std::unique_ptr<VertexLoaderBase> loader = create_loader(desc, vat);
+
+  std::vector<u8> arrays = MakeData(0x10000 * ARRAY_STRIDE);
+  for (size_t i = 0; i < NUM_VERTEX_COMPONENT_ARRAYS; ++i)
+  {
+    VertexLoaderManager::cached_arraybases[static_cast<CPArray>(i)] = arrays.data();
+    g_main_cp_state.array_strides[static_cast<CPArray>(i)] = ARRAY_STRIDE;
+  }
+
+  const std::vector<u8> src = MakeData(static_cast<size_t>(loader->m_vertex_size) * VERTEX_COUNT);
+  std::vector<u8> dst(static_cast<size_t>(loader->m_native_vtx_decl.stride) * VERTEX_COUNT);
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(loader->RunVertices(src.data(), dst.data(), VERTEX_COUNT));
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VERTEX_COUNT);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * VERTEX_COUNT *
+                          loader->m_native_vtx_decl.stride);
+}
+
+const bool s_registered = [] {
+  std::vector<std::pair<const char*, LoaderFactory>> backends;
+  backends.emplace_back("Software", [](const TVtxDesc& desc, const VAT& vat) {
+    return std::make_unique<VertexLoader>(desc, vat);
+  });
+#if defined(_M_X86_64)
+  backends.emplace_back("X64", [](const TVtxDesc& desc, const VAT& vat) {
+    return std::make_unique<VertexLoaderX64>(desc, vat);
+  });
+#elif defined(_M_ARM_64)
+  backends.emplace_back("ARM64", [](const TVtxDesc& desc, const VAT& vat) {
+    return std::make_unique<VertexLoaderARM64>(desc, vat);
+  });
+#endif
+
+  for (const VertexLayout& layout : LAYOUTS)
+  {
+    for (const auto& [backend_name, factory] : backends)
+    {
+      const std::string name = fmt::format("BM_VertexLoader/{}/{}", layout.name, backend_name);
+      benchmark::RegisterBenchmark(name.c_str(), RunVertexLoader, layout, factory);
+    }
+  }
+  return true;
+}();
+}  // namespace
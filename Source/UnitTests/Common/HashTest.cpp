@@ -0,0 +1,79 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+namespace
+{
+std::vector<u8> RandomData(size_t size)
+{
+  std::mt19937 rng(size);
+  std::vector<u8> data(size);
+  for (u8& byte : data)
+    byte = static_cast<u8>(rng());
+  return data;
+}
+}  // namespace
+
+TEST(Hash, GetHash64FullHashSeesEveryByte)
+{
+  for (u32 len : {1u, 7u, 8u, 63u, 64u, 100u, 1024u, 1088u, 4096u})
+  {
+    std::vector<u8> data = RandomData(len);
+    const u64 hash = Common::GetHash64(data.data(), len, 0);
+    EXPECT_EQ(hash, Common::GetHash64(data.data(), len, 0));
+
+    for (u32 i = 0; i < len; i++)
+    {
+      data[i] ^= 1 << (i % 8);
+      EXPECT_NE(hash, Common::GetHash64(data.data(), len, 0)) << "length " << len << ", byte " << i;
+      data[i] ^= 1 << (i % 8);
+    }
+  }
+}
+
+TEST(Hash, GetHash64FullHashSeesLength)
+{
+  const std::vector<u8> data(256, 0);
+  EXPECT_NE(Common::GetHash64(data.data(), 128, 0), Common::GetHash64(data.data(), 256, 0));
+}
+
+TEST(Hash, GetHash64Throughput)
+{
+  for (u32 len : {4096u, 65536u, 1u << 20})
+  {
+    const std::vector<u8> data = RandomData(len);
+    for (u32 samples : {0u, 128u})
+    {
+      const u32 iterations = (256u << 20) / len;
+      u64 sum = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for (u32 i = 0; i < iterations; i++)
+        sum += Common::GetHash64(data.data(), len, samples);
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      fmt::print("{} bytes, {} samples: {:.2f} GB/s (checksum {:x})\n", len, samples,
+                 double(len) * iterations / elapsed.count() / 1e9, sum);
+    }
+  }
+}
+
+TEST(Hash, CombineCRC32MatchesSinglePass)
+{
+  const std::vector<u8> data = RandomData(100000);
+  const u32 expected = Common::ComputeCRC32(data.data(), data.size());
+
+  for (size_t split : {size_t{0}, size_t{1}, size_t{4096}, size_t{99999}, data.size()})
+  {
+    const u32 first = Common::ComputeCRC32(data.data(), split);
+    const u32 second = Common::ComputeCRC32(data.data() + split, data.size() - split);
+    EXPECT_EQ(expected, Common::CombineCRC32(first, second, data.size() - split)) << split;
+  }
+}
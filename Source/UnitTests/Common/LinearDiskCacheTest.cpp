@@ -0,0 +1,146 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
+
+class LinearDiskCacheTest : public testing::Test
+{
+protected:
+  LinearDiskCacheTest()
+      : m_parent_directory(File::CreateTempDir()), m_file_path(m_parent_directory + "/cache.bin")
+  {
+  }
+
+  ~LinearDiskCacheTest() override
+  {
+    if (!m_parent_directory.empty())
+      File::DeleteDirRecursively(m_parent_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_parent_directory.empty())
+      FAIL();
+  }
+
+  const std::string m_parent_directory;
+  const std::string m_file_path;
+};
+
+TEST_F(LinearDiskCacheTest, IndexAndReadValues)
+{
+  constexpr std::array<u8, 3> first = {1, 2, 3};
+  constexpr std::array<u8, 5> second = {4, 5, 6, 7, 8};
+  {
+    LinearDiskCache<u32, u8> cache;
+    EXPECT_EQ(cache.OpenAndIndex(m_file_path, [](u32, u64, u32) {}), 0u);
+    cache.Append(10, first.data(), static_cast<u32>(first.size()));
+    cache.Append(20, second.data(), static_cast<u32>(second.size()));
+  }
+
+  LinearDiskCache<u32, u8> cache;
+  std::map<u32, std::pair<u64, u32>> index;
+  EXPECT_EQ(cache.OpenAndIndex(m_file_path,
+                               [&index](u32 key, u64 offset, u32 size) {
+                                 index[key] = {offset, size};
+                               }),
+            2u);
+  ASSERT_EQ(index.size(), 2u);
+  EXPECT_EQ(index[10].second, first.size());
+  EXPECT_EQ(index[20].second, second.size());
+
+  std::array<u8, 5> value{};
+  ASSERT_TRUE(cache.ReadValue(index[20].first, index[20].second, value.data()));
+  EXPECT_EQ(value, second);
+
+  // Reading must not move where new entries are appended.
+  constexpr std::array<u8, 2> third = {9, 10};
+  cache.Append(30, third.data(), static_cast<u32>(third.size()));
+  cache.Close();
+
+  LinearDiskCache<u32, u8> reopened;
+  EXPECT_EQ(reopened.OpenAndIndex(m_file_path, [](u32, u64, u32) {}), 3u);
+}
+
+TEST_F(LinearDiskCacheTest, CompactsSupersededEntries)
+{
+  class Reader final : public LinearDiskCacheReader<u32, u8>
+  {
+  public:
+    void Read(const u32& key, const u8* value, u32 value_size) override
+    {
+      values[key].assign(value, value + value_size);
+    }
+    std::map<u32, std::vector<u8>> values;
+  };
+
+  std::vector<u8> value(256 * 1024);
+  {
+    LinearDiskCache<u32, u8> cache;
+    Reader reader;
+    cache.OpenAndRead(m_file_path, reader);
+    for (u8 i = 0; i < 8; ++i)
+    {
+      std::fill(value.begin(), value.end(), i);
+      cache.Append(1, value.data(), static_cast<u32>(value.size()));
+    }
+  }
+
+  {
+    LinearDiskCache<u32, u8> cache;
+    Reader reader;
+    EXPECT_EQ(cache.OpenAndRead(m_file_path, reader), 8u);
+    // Appended while the file is being compacted.
+    const u8 small_value = 42;
+    cache.Append(2, &small_value, 1);
+  }
+  EXPECT_LT(File::GetSize(m_file_path), 2 * value.size());
+
+  LinearDiskCache<u32, u8> cache;
+  Reader reader;
+  EXPECT_EQ(cache.OpenAndRead(m_file_path, reader), 2u);
+  ASSERT_EQ(reader.values.size(), 2u);
+  EXPECT_EQ(reader.values[1], std::vector<u8>(value.size(), 7));
+  EXPECT_EQ(reader.values[2], std::vector<u8>{42});
+}
+
+TEST_F(LinearDiskCacheTest, ReadOnlyLeavesFileAlone)
+{
+  {
+    LinearDiskCache<u32, u8> cache;
+    EXPECT_EQ(cache.OpenReadOnlyAndIndex(m_file_path, [](u32, u64, u32) {}), 0u);
+  }
+  EXPECT_FALSE(File::Exists(m_file_path));
+
+  constexpr std::array<u8, 3> value = {1, 2, 3};
+  {
+    LinearDiskCache<u32, u8> cache;
+    cache.OpenAndIndex(m_file_path, [](u32, u64, u32) {});
+    cache.Append(10, value.data(), static_cast<u32>(value.size()));
+  }
+  const u64 size = File::GetSize(m_file_path);
+
+  LinearDiskCache<u32, u8> cache;
+  std::map<u32, std::pair<u64, u32>> index;
+  EXPECT_EQ(cache.OpenReadOnlyAndIndex(m_file_path,
+                                       [&index](u32 key, u64 offset, u32 value_size) {
+                                         index[key] = {offset, value_size};
+                                       }),
+            1u);
+  std::array<u8, 3> read_value{};
+  ASSERT_TRUE(cache.ReadValue(index[10].first, index[10].second, read_value.data()));
+  EXPECT_EQ(read_value, value);
+  cache.Close();
+  EXPECT_EQ(File::GetSize(m_file_path), size);
+}
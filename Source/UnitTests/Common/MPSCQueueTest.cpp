@@ -0,0 +1,81 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32, 16> q;
+
+  u32 v;
+  EXPECT_FALSE(q.Pop(v));
+
+  EXPECT_TRUE(q.TryPush(1));
+  EXPECT_TRUE(q.Pop(v));
+  EXPECT_EQ(1u, v);
+  EXPECT_FALSE(q.Pop(v));
+
+  // Test the FIFO order, and that pushing fails once the queue is full.
+  for (u32 lap = 0; lap < 3; ++lap)
+  {
+    for (u32 i = 0; i < 16; ++i)
+      EXPECT_TRUE(q.TryPush(i));
+    EXPECT_FALSE(q.TryPush(16));
+
+    for (u32 i = 0; i < 16; ++i)
+    {
+      EXPECT_TRUE(q.Pop(v));
+      EXPECT_EQ(i, v);
+    }
+    EXPECT_FALSE(q.Pop(v));
+  }
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  constexpr u32 PRODUCERS = 4;
+  constexpr u32 COUNT = 20000;
+  Common::MPSCQueue<u32, 64> q;
+
+  std::vector<std::thread> producers;
+  for (u32 producer = 0; producer < PRODUCERS; ++producer)
+  {
+    producers.emplace_back([&q, producer]() {
+      for (u32 i = 0; i < COUNT; ++i)
+      {
+        while (!q.TryPush(producer * COUNT + i))
+          std::this_thread::yield();
+      }
+    });
+  }
+
+  // Every element must arrive exactly once, and the elements from a producer in order.
+  std::array<u32, PRODUCERS> next{};
+  for (u32 received = 0; received < PRODUCERS * COUNT;)
+  {
+    u32 v;
+    if (!q.Pop(v))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    const u32 producer = v / COUNT;
+    ASSERT_LT(producer, PRODUCERS);
+    EXPECT_EQ(next[producer], v % COUNT);
+    next[producer] = v % COUNT + 1;
+    ++received;
+  }
+
+  for (std::thread& producer : producers)
+    producer.join();
+
+  u32 v;
+  EXPECT_FALSE(q.Pop(v));
+}
@@ -3,9 +3,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <random>
 #include <string>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -364,3 +369,70 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
+
+namespace ManyEventsTest
+{
+static std::vector<u64> s_fired;
+
+void RecordCallback(Core::System& system, u64 userdata, s64 lateness)
+{
+  s_fired.push_back(userdata);
+}
+}  // namespace ManyEventsTest
+
+TEST(CoreTiming, ManyEventsWithRemovals)
+{
+  using namespace ManyEventsTest;
+
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  std::array<CoreTiming::EventType*, 8> event_types;
+  for (size_t i = 0; i < event_types.size(); ++i)
+    event_types[i] = CoreTiming::RegisterEvent(fmt::format("callback{}", i), RecordCallback);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  struct Expected
+  {
+    s64 cycles;
+    u64 id;
+    size_t type;
+  };
+  std::vector<Expected> expected;
+
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<s64> cycles_dist(1, 100000);
+  std::uniform_int_distribution<size_t> type_dist(0, event_types.size() - 1);
+  std::uniform_int_distribution<int> remove_dist(0, 19);
+  for (u64 id = 0; id < 1000; ++id)
+  {
+    if (remove_dist(rng) == 0)
+    {
+      const size_t type = type_dist(rng);
+      CoreTiming::RemoveEvent(event_types[type]);
+      std::erase_if(expected, [type](const Expected& e) { return e.type == type; });
+    }
+
+    const s64 cycles = cycles_dist(rng);
+    const size_t type = type_dist(rng);
+    CoreTiming::ScheduleEvent(cycles, event_types[type], id);
+    expected.push_back({cycles, id, type});
+  }
+
+  // Events due at the same time run in the order they were scheduled in.
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const Expected& a, const Expected& b) { return a.cycles < b.cycles; });
+
+  s_fired.clear();
+  for (int i = 0; i < 1000 && s_fired.size() < expected.size(); ++i)
+  {
+    PowerPC::ppcState.downcount = 0;
+    CoreTiming::Advance();
+  }
+
+  ASSERT_EQ(expected.size(), s_fired.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+    EXPECT_EQ(expected[i].id, s_fired[i]);
+}
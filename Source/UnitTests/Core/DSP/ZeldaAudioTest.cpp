@@ -0,0 +1,153 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/ZeldaAudio.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+// Not a multiple of the vector sizes, so that the scalar tails get tested too.
+constexpr size_t COUNT = 0x53;
+
+template <size_t N>
+std::array<s16, N> RandomSamples(std::mt19937& rng)
+{
+  // Favor the edges of the range, which is where clamping and overflows happen.
+  std::uniform_int_distribution<int> dist(std::numeric_limits<s16>::min(),
+                                          std::numeric_limits<s16>::max());
+  std::uniform_int_distribution<int> pick(0, 7);
+  std::array<s16, N> samples;
+  for (s16& sample : samples)
+  {
+    switch (pick(rng))
+    {
+    case 0:
+      sample = std::numeric_limits<s16>::min();
+      break;
+    case 1:
+      sample = std::numeric_limits<s16>::max();
+      break;
+    default:
+      sample = static_cast<s16>(dist(rng));
+      break;
+    }
+  }
+  return samples;
+}
+
+u16 RandomVolume(std::mt19937& rng)
+{
+  static constexpr std::array<u16, 5> special = {0x0000, 0x7FFF, 0x8000, 0xFFFF, 0x1000};
+  std::uniform_int_distribution<int> pick(0, 9);
+  const int i = pick(rng);
+  if (i < static_cast<int>(special.size()))
+    return special[i];
+  return static_cast<u16>(std::uniform_int_distribution<int>(0, 0xFFFF)(rng));
+}
+}  // namespace
+
+TEST(ZeldaAudio, ApplyVolume)
+{
+  std::mt19937 rng(1);
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    const u16 vol = RandomVolume(rng);
+    for (u32 shift : {15u, 12u})
+    {
+      auto expected = RandomSamples<COUNT>(rng);
+      auto actual = expected;
+      ZeldaAudio::Generic::ApplyVolume(expected.data(), COUNT, vol, shift);
+      ZeldaAudio::ApplyVolume(actual.data(), COUNT, vol, shift);
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(ZeldaAudio, AddWithVolumeRamp)
+{
+  std::mt19937 rng(2);
+  std::uniform_int_distribution<s32> vol_dist(-0x10000 * 0x7000, 0x10000 * 0x7000);
+  std::uniform_int_distribution<s32> step_dist(-0x100000, 0x100000);
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    const s32 vol = vol_dist(rng);
+    const s32 step = step_dist(rng);
+    const auto src = RandomSamples<COUNT>(rng);
+    auto expected = RandomSamples<COUNT>(rng);
+    auto actual = expected;
+    const s32 expected_vol =
+        ZeldaAudio::Generic::AddWithVolumeRamp(expected.data(), src.data(), COUNT, vol, step);
+    const s32 actual_vol =
+        ZeldaAudio::AddWithVolumeRamp(actual.data(), src.data(), COUNT, vol, step);
+    EXPECT_EQ(expected, actual);
+    EXPECT_EQ(expected_vol, actual_vol);
+  }
+}
+
+TEST(ZeldaAudio, AddWithVolume)
+{
+  std::mt19937 rng(3);
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    const u16 vol = RandomVolume(rng);
+    const auto src = RandomSamples<COUNT>(rng);
+    auto expected = RandomSamples<COUNT>(rng);
+    auto actual = expected;
+    ZeldaAudio::Generic::AddWithVolume(expected.data(), src.data(), COUNT, vol);
+    ZeldaAudio::AddWithVolume(actual.data(), src.data(), COUNT, vol);
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST(ZeldaAudio, Filter8Tap)
+{
+  std::mt19937 rng(4);
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    // Scale the coefficients down so that the accumulator can't overflow, which the UCode doesn't
+    // guard against. The larger ones can still push the output out of the s16 range.
+    const auto coeffs = RandomSamples<8>(rng);
+    const int divisor = iteration % 4 == 0 ? 5 : 8;
+    std::array<s16, 8> scaled_coeffs;
+    for (size_t i = 0; i < coeffs.size(); ++i)
+      scaled_coeffs[i] = static_cast<s16>(coeffs[i] / divisor);
+
+    auto expected = RandomSamples<COUNT + 7>(rng);
+    auto actual = expected;
+    ZeldaAudio::Generic::Filter8Tap(expected.data(), COUNT, scaled_coeffs.data());
+    ZeldaAudio::Filter8Tap(actual.data(), COUNT, scaled_coeffs.data());
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST(ZeldaAudio, ResamplePolyphase)
+{
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<u32> pos_dist(0, 0xFFF);
+  std::uniform_int_distribution<u32> ratio_dist(0, 0x3FFF);
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    const auto coeffs = RandomSamples<0x100>(rng);
+    // Enough input for the largest ratio, plus the 4 taps.
+    const auto src = RandomSamples<COUNT * 4 + 4>(rng);
+    const u32 pos = pos_dist(rng);
+    const u32 ratio = ratio_dist(rng);
+
+    std::array<s16, COUNT> expected{};
+    std::array<s16, COUNT> actual{};
+    const u32 expected_pos = ZeldaAudio::Generic::ResamplePolyphase(
+        expected.data(), COUNT, src.data(), pos, ratio, coeffs.data());
+    const u32 actual_pos =
+        ZeldaAudio::ResamplePolyphase(actual.data(), COUNT, src.data(), pos, ratio, coeffs.data());
+    EXPECT_EQ(expected, actual);
+    EXPECT_EQ(expected_pos, actual_pos);
+  }
+}
@@ -417,6 +417,38 @@ TEST_F(FileSystemTest, MultipleHandles)
   EXPECT_EQ(TEST_DATA, read_buffer);
 }
 
+TEST_F(FileSystemTest, ReopenAfterClose)
+{
+  const std::vector<u8> TEST_DATA{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/f", 0, modes), ResultCode::Success);
+
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::Write);
+    ASSERT_TRUE(file.Succeeded());
+    for (u8 byte : TEST_DATA)
+      ASSERT_TRUE(file->Write(&byte, 1).Succeeded());
+  }
+
+  // Closed files may be kept open on the host, which must not be observable.
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/f")->size, TEST_DATA.size());
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::Read);
+    ASSERT_TRUE(file.Succeeded());
+    EXPECT_EQ(file->GetStatus()->size, TEST_DATA.size());
+    std::vector<u8> read_buffer(TEST_DATA.size());
+    ASSERT_TRUE(file->Read(read_buffer.data(), read_buffer.size()).Succeeded());
+    EXPECT_EQ(TEST_DATA, read_buffer);
+  }
+
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/f"), ResultCode::Success);
+  EXPECT_EQ(m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::Read).Error(), ResultCode::NotFound);
+
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/f", 0, modes), ResultCode::Success);
+  const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::Read);
+  ASSERT_TRUE(file.Succeeded());
+  EXPECT_EQ(file->GetStatus()->size, 0u);
+}
+
 // ReadDirectory is used by official titles to determine whether a path is a file.
 // If it is not a file, ResultCode::Invalid must be returned.
 TEST_F(FileSystemTest, ReadDirectoryOnFile)
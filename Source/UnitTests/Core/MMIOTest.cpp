@@ -139,3 +139,41 @@ TEST_F(MappingTest, ReadWriteComplex)
   EXPECT_TRUE(read_called);
   EXPECT_TRUE(write_called);
 }
+
+TEST_F(MappingTest, SizeConvertersFoldDirect)
+{
+  class IsDirectVisitor : public MMIO::ReadHandlingMethodVisitor<u32>
+  {
+  public:
+    void VisitConstant(u32) override {}
+    void VisitDirect(const u32*, u32) override { is_direct = true; }
+    void VisitComplex(const std::function<u32(Core::System&, u32)>*) override {}
+    bool is_direct = false;
+  };
+
+  alignas(u32) u16 target[2] = {};
+
+  // Registered the same way as the 32 bit registers split in two that most
+  // hardware modules have, with the high part at the lower address.
+  m_mapping->Register(0x0C001234, MMIO::DirectRead<u16>(&target[1], 0x0FFF),
+                      MMIO::DirectWrite<u16>(&target[1], 0x0FFF));
+  m_mapping->Register(0x0C001236, MMIO::DirectRead<u16>(&target[0], 0xFFF0),
+                      MMIO::DirectWrite<u16>(&target[0], 0xFFF0));
+  m_mapping->Register(0x0C001234, MMIO::ReadToSmaller<u32>(m_mapping, 0x0C001234, 0x0C001236),
+                      MMIO::WriteToSmaller<u32>(m_mapping, 0x0C001234, 0x0C001236));
+  m_mapping->Register(0x0C001234, MMIO::ReadToLarger<u8>(m_mapping, 0x0C001234, 8),
+                      MMIO::InvalidWrite<u8>());
+  m_mapping->Register(0x0C001235, MMIO::ReadToLarger<u8>(m_mapping, 0x0C001234, 0),
+                      MMIO::InvalidWrite<u8>());
+
+  IsDirectVisitor visitor;
+  m_mapping->GetHandlerForRead<u32>(0x0C001234).Visit(visitor);
+  EXPECT_TRUE(visitor.is_direct);
+
+  m_mapping->Write<u32>(0x0C001234, 0x12345678);
+  EXPECT_EQ(0x0234, target[1]);
+  EXPECT_EQ(0x5670, target[0]);
+  EXPECT_EQ(0x02345670u, m_mapping->Read<u32>(0x0C001234));
+  EXPECT_EQ(0x02, m_mapping->Read<u8>(0x0C001234));
+  EXPECT_EQ(0x34, m_mapping->Read<u8>(0x0C001235));
+}
@@ -0,0 +1,130 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
+
+namespace
+{
+std::vector<u8> MakeState(size_t size, u8 seed)
+{
+  std::vector<u8> state(size);
+  for (size_t i = 0; i < size; i++)
+    state[i] = static_cast<u8>(i * 7 + seed);
+  return state;
+}
+}  // namespace
+
+TEST(StateDelta, StoresOnlyChangedPages)
+{
+  const std::vector<u8> base = MakeState(State::DELTA_PAGE_SIZE * 16, 0);
+  std::vector<u8> state = base;
+  state[State::DELTA_PAGE_SIZE * 3 + 5] ^= 0xff;
+  state[State::DELTA_PAGE_SIZE * 4] ^= 0xff;
+  state[State::DELTA_PAGE_SIZE * 10 + 100] ^= 0xff;
+
+  const std::vector<u8> delta = State::CreateDelta(base, state);
+  EXPECT_LT(delta.size(), State::DELTA_PAGE_SIZE * 4);
+
+  std::vector<u8> restored;
+  ASSERT_TRUE(State::ApplyDelta(base, delta, &restored));
+  EXPECT_EQ(state, restored);
+}
+
+TEST(StateDelta, HandlesSizeChanges)
+{
+  const std::vector<u8> base = MakeState(State::DELTA_PAGE_SIZE * 4 + 10, 0);
+  std::vector<u8> restored;
+
+  const std::vector<u8> larger = MakeState(State::DELTA_PAGE_SIZE * 6 + 3, 0);
+  ASSERT_TRUE(State::ApplyDelta(base, State::CreateDelta(base, larger), &restored));
+  EXPECT_EQ(larger, restored);
+
+  const std::vector<u8> smaller = MakeState(State::DELTA_PAGE_SIZE + 1, 1);
+  ASSERT_TRUE(State::ApplyDelta(base, State::CreateDelta(base, smaller), &restored));
+  EXPECT_EQ(smaller, restored);
+}
+
+TEST(StateDelta, RejectsMismatchedBase)
+{
+  const std::vector<u8> base = MakeState(State::DELTA_PAGE_SIZE * 2, 0);
+  const std::vector<u8> delta = State::CreateDelta(base, MakeState(State::DELTA_PAGE_SIZE * 2, 1));
+
+  std::vector<u8> restored;
+  EXPECT_FALSE(State::ApplyDelta(MakeState(State::DELTA_PAGE_SIZE, 0), delta, &restored));
+
+  std::vector<u8> truncated = delta;
+  truncated.pop_back();
+  EXPECT_FALSE(State::ApplyDelta(base, truncated, &restored));
+}
+
+TEST(StateDelta, HistoryRestoresEveryState)
+{
+  State::StateHistory history(5, 3);
+  std::vector<std::vector<u8>> states;
+  std::vector<u8> state = MakeState(State::DELTA_PAGE_SIZE * 8, 0);
+  for (size_t i = 0; i < 8; i++)
+  {
+    state[(i % 8) * State::DELTA_PAGE_SIZE] = static_cast<u8>(0x80 + i);
+    states.push_back(state);
+    history.Push(state);
+  }
+
+  ASSERT_EQ(5u, history.GetSize());
+  for (size_t age = 0; age < 5; age++)
+  {
+    std::vector<u8> restored;
+    ASSERT_TRUE(history.Get(age, &restored));
+    EXPECT_EQ(states[states.size() - 1 - age], restored);
+  }
+
+  std::vector<u8> restored;
+  EXPECT_FALSE(history.Get(5, &restored));
+
+  // Two keyframes remain (states 3 and 6), along with the deltas of the other three states.
+  EXPECT_LT(history.GetMemoryUsage(), state.size() * 3);
+}
+
+TEST(StateDelta, CompressedHistoryStaysInBudget)
+{
+  // Random data, so that keyframes don't compress to almost nothing.
+  std::vector<u8> state(State::DELTA_PAGE_SIZE * 64);
+  u32 seed = 1;
+  for (u8& byte : state)
+  {
+    seed = seed * 1664525 + 1013904223;
+    byte = static_cast<u8>(seed >> 24);
+  }
+
+  // Enough for two groups of a keyframe and its deltas, plus the uncompressed latest keyframe.
+  const size_t budget = state.size() * 4;
+  State::StateHistory history(100, 4, budget, 1);
+
+  std::vector<std::vector<u8>> states;
+  for (size_t i = 0; i < 20; i++)
+  {
+    state[i * State::DELTA_PAGE_SIZE + 1] ^= 0xff;
+    states.push_back(state);
+    history.Push(state);
+    EXPECT_LE(history.GetMemoryUsage(), budget);
+  }
+  ASSERT_EQ(8u, history.GetSize());
+
+  std::vector<u8> restored;
+  for (size_t i = 0; i < 4; i++)
+  {
+    ASSERT_TRUE(history.PopNewest(&restored));
+    EXPECT_EQ(states[states.size() - 1 - i], restored);
+  }
+
+  // The last pop removed a keyframe, so the next state becomes a keyframe itself.
+  history.Push(states[0]);
+  ASSERT_TRUE(history.Get(0, &restored));
+  EXPECT_EQ(states[0], restored);
+  ASSERT_TRUE(history.Get(1, &restored));
+  EXPECT_EQ(states[states.size() - 5], restored);
+}
@@ -0,0 +1,60 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/DynamicResolution.h"
+
+namespace
+{
+constexpr u64 BUDGET_60FPS = 16666667;
+}  // namespace
+
+TEST(DynamicResolution, StaysAtFullScaleWithinBudget)
+{
+  DynamicResolution dynres;
+  for (int i = 0; i < 200; i++)
+    EXPECT_FALSE(dynres.Update(BUDGET_60FPS / 2, BUDGET_60FPS));
+  EXPECT_EQ(1.0, dynres.GetScaleFactor());
+  EXPECT_EQ(300u, dynres.Apply(300));
+}
+
+TEST(DynamicResolution, DecreasesWhenOverBudget)
+{
+  DynamicResolution dynres;
+  bool changed = false;
+  for (int i = 0; i < 10 && !changed; i++)
+    changed = dynres.Update(BUDGET_60FPS * 2, BUDGET_60FPS);
+  EXPECT_TRUE(changed);
+  EXPECT_LT(dynres.GetScaleFactor(), 1.0);
+  EXPECT_EQ(0u, dynres.Apply(300) % 5);
+  EXPECT_LT(dynres.Apply(300), 300u);
+}
+
+TEST(DynamicResolution, RespectsMinimumScale)
+{
+  DynamicResolution dynres;
+  dynres.SetMinimumScale(75);
+  for (int i = 0; i < 200; i++)
+    dynres.Update(BUDGET_60FPS * 10, BUDGET_60FPS);
+  EXPECT_EQ(0.75, dynres.GetScaleFactor());
+  EXPECT_EQ(225u, dynres.Apply(300));
+}
+
+TEST(DynamicResolution, RecoversWithHeadroom)
+{
+  DynamicResolution dynres;
+  for (int i = 0; i < 50; i++)
+    dynres.Update(BUDGET_60FPS * 2, BUDGET_60FPS);
+  const double lowered = dynres.GetScaleFactor();
+  ASSERT_LT(lowered, 1.0);
+
+  for (int i = 0; i < 1000; i++)
+    dynres.Update(BUDGET_60FPS / 4, BUDGET_60FPS);
+  EXPECT_EQ(1.0, dynres.GetScaleFactor());
+
+  dynres.Update(BUDGET_60FPS * 2, BUDGET_60FPS);
+  dynres.Reset();
+  EXPECT_EQ(1.0, dynres.GetScaleFactor());
+}
@@ -0,0 +1,65 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/FramePacer.h"
+
+namespace
+{
+constexpr u64 REFRESH_120HZ = 8333333;
+constexpr u64 FRAME_60FPS = 16666667;
+}  // namespace
+
+TEST(FramePacer, DisabledWithoutRefreshDuration)
+{
+  FramePacer pacer;
+  const FramePacer::Target first = pacer.NextPresent(1000);
+  const FramePacer::Target second = pacer.NextPresent(2000);
+  EXPECT_EQ(0u, first.desired_present_time);
+  EXPECT_EQ(0u, second.desired_present_time);
+  EXPECT_NE(first.present_id, second.present_id);
+}
+
+TEST(FramePacer, EvenCadenceDespiteJitter)
+{
+  FramePacer pacer;
+  pacer.SetRefreshDuration(REFRESH_120HZ);
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> jitter(-2000000, 2000000);
+  u64 now = 1000000000;
+  u64 last_desired = 0;
+  for (int frame = 0; frame < 300; ++frame)
+  {
+    const FramePacer::Target target = pacer.NextPresent(now + jitter(rng));
+    ASSERT_NE(0u, target.desired_present_time);
+    // Once the frame rate has been picked up, every frame is shown for exactly two refreshes.
+    if (frame >= 20)
+      EXPECT_EQ(2 * REFRESH_120HZ, target.desired_present_time - last_desired);
+    pacer.OnPresented(target.desired_present_time, target.desired_present_time + REFRESH_120HZ / 2);
+    last_desired = target.desired_present_time;
+    now += FRAME_60FPS;
+  }
+  EXPECT_EQ(2u, pacer.GetRefreshCycles());
+  EXPECT_EQ(0u, pacer.GetMissedPresents());
+}
+
+TEST(FramePacer, CatchesUpAfterStall)
+{
+  FramePacer pacer;
+  pacer.SetRefreshDuration(REFRESH_120HZ);
+
+  u64 now = 1000000000;
+  for (int frame = 0; frame < 30; ++frame, now += FRAME_60FPS)
+    pacer.NextPresent(now);
+
+  // After a long hitch the frame goes out at the next possible refresh, not on the old cadence.
+  now += 50 * FRAME_60FPS;
+  const FramePacer::Target target = pacer.NextPresent(now);
+  EXPECT_GE(target.desired_present_time, now);
+  EXPECT_LT(target.desired_present_time, now + 2 * REFRESH_120HZ);
+}
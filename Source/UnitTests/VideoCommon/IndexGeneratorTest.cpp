@@ -0,0 +1,227 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+using OpcodeDecoder::Primitive;
+
+namespace
+{
+constexpr u16 RESTART = UINT16_MAX;
+
+// One index at a time, the way the generator used to write them.
+std::vector<u16> ReferenceIndices(Primitive primitive, u32 n, u32 base, bool pr, bool expand)
+{
+  std::vector<u16> out;
+  const auto put = [&out](u32 index) { out.push_back(static_cast<u16>(index)); };
+  const auto triangle = [&](u32 a, u32 b, u32 c) {
+    put(base + a);
+    put(base + b);
+    put(base + c);
+    if (pr)
+      put(RESTART);
+  };
+
+  switch (primitive)
+  {
+  case Primitive::GX_DRAW_QUADS:
+  case Primitive::GX_DRAW_QUADS_2:
+  {
+    u32 i = 3;
+    for (; i < n; i += 4)
+    {
+      if (pr)
+      {
+        for (u32 offset : {2u, 1u, 3u, 0u})
+          put(base + i - offset);
+        put(RESTART);
+      }
+      else
+      {
+        triangle(i - 3, i - 2, i - 1);
+        triangle(i - 3, i - 1, i);
+      }
+    }
+    if (i == n)
+      triangle(n - 3, n - 2, n - 1);
+    break;
+  }
+  case Primitive::GX_DRAW_TRIANGLES:
+    for (u32 i = 2; i < n; i += 3)
+      triangle(i - 2, i - 1, i);
+    break;
+  case Primitive::GX_DRAW_TRIANGLE_STRIP:
+    if (pr)
+    {
+      for (u32 i = 0; i < n; ++i)
+        put(base + i);
+      put(RESTART);
+    }
+    else
+    {
+      for (u32 i = 2; i < n; ++i)
+      {
+        if (i % 2 == 0)
+          triangle(i - 2, i - 1, i);
+        else
+          triangle(i - 2, i, i - 1);
+      }
+    }
+    break;
+  case Primitive::GX_DRAW_TRIANGLE_FAN:
+  {
+    u32 i = 2;
+    if (pr)
+    {
+      for (; i + 3 <= n; i += 3)
+      {
+        for (u32 index : {base + i - 1, base + i, base, base + i + 1, base + i + 2})
+          put(index);
+        put(RESTART);
+      }
+      for (; i + 2 <= n; i += 2)
+      {
+        for (u32 index : {base + i - 1, base + i, base, base + i + 1})
+          put(index);
+        put(RESTART);
+      }
+    }
+    for (; i < n; ++i)
+      triangle(0, i - 1, i);
+    break;
+  }
+  case Primitive::GX_DRAW_LINES:
+  case Primitive::GX_DRAW_LINE_STRIP:
+  {
+    const u32 advance = primitive == Primitive::GX_DRAW_LINES ? 2 : 1;
+    for (u32 i = 1; i < n; i += advance)
+    {
+      if (!expand)
+      {
+        put(base + i - 1);
+        put(base + i);
+        continue;
+      }
+      const u32 p0 = (base + i - 1) << 2;
+      const u32 p1 = (base + i) << 2;
+      if (pr)
+      {
+        for (u32 index : {p0, p0 + 1, p1 + 2, p1 + 3})
+          put(index);
+        put(RESTART);
+      }
+      else
+      {
+        for (u32 index : {p0, p0 + 1, p1 + 2, p0 + 1, p1 + 2, p1 + 3})
+          put(index);
+      }
+    }
+    break;
+  }
+  case Primitive::GX_DRAW_POINTS:
+    for (u32 i = 0; i < n; ++i)
+    {
+      if (!expand)
+      {
+        put(base + i);
+        continue;
+      }
+      const u32 p = (base + i) << 2;
+      if (pr)
+      {
+        for (u32 index : {p, p + 1, p + 2, p + 3})
+          put(index);
+        put(RESTART);
+      }
+      else
+      {
+        for (u32 index : {p, p + 1, p + 2, p + 1, p + 2, p + 3})
+          put(index);
+      }
+    }
+    break;
+  }
+  return out;
+}
+
+void ConfigureGenerator(IndexGenerator& generator, bool pr, bool expand)
+{
+  g_Config.backend_info.bSupportsPrimitiveRestart = pr;
+  g_Config.backend_info.bSupportsVSLinePointExpand = expand;
+  g_Config.backend_info.bSupportsGeometryShaders = !expand;
+  g_Config.bPreferVSForLinePointExpansion = expand;
+  generator.Init();
+}
+}  // namespace
+
+class IndexGeneratorTest : public testing::TestWithParam<std::tuple<bool, bool>>
+{
+};
+INSTANTIATE_TEST_CASE_P(PrimitiveRestartAndExpand, IndexGeneratorTest,
+                        testing::Combine(testing::Bool(), testing::Bool()));
+
+TEST_P(IndexGeneratorTest, MatchesReference)
+{
+  const auto [pr, expand] = GetParam();
+  IndexGenerator generator;
+  ConfigureGenerator(generator, pr, expand);
+
+  std::vector<u16> buffer(16384);
+  for (int primitive = 0; primitive <= static_cast<int>(Primitive::GX_DRAW_POINTS); ++primitive)
+  {
+    for (u32 base : {0u, 1000u})
+    {
+      for (u32 num_verts = 0; num_verts < 120; ++num_verts)
+      {
+        // Points move the base index along for the primitive under test. The index after the
+        // output is checked too, to catch blocks which are written past the end.
+        std::fill(buffer.begin(), buffer.end(), 0xCCCC);
+        generator.Start(buffer.data());
+        generator.AddIndices(Primitive::GX_DRAW_POINTS, base);
+        const u32 start = generator.GetIndexLen();
+        generator.AddIndices(static_cast<Primitive>(primitive), num_verts);
+
+        const std::vector<u16> expected =
+            ReferenceIndices(static_cast<Primitive>(primitive), num_verts, base, pr, expand);
+        SCOPED_TRACE(fmt::format("primitive {}, base {}, {} vertices", primitive, base, num_verts));
+        ASSERT_EQ(expected.size(), generator.GetIndexLen() - start);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin() + start));
+        EXPECT_EQ(0xCCCC, buffer[start + expected.size()]);
+      }
+    }
+  }
+}
+
+TEST_P(IndexGeneratorTest, Speed)
+{
+  const auto [pr, expand] = GetParam();
+  IndexGenerator generator;
+  ConfigureGenerator(generator, pr, expand);
+
+  std::vector<u16> buffer(65536 * 8);
+  for (Primitive primitive : {Primitive::GX_DRAW_QUADS, Primitive::GX_DRAW_TRIANGLES,
+                              Primitive::GX_DRAW_TRIANGLE_STRIP, Primitive::GX_DRAW_TRIANGLE_FAN})
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i)
+    {
+      generator.Start(buffer.data());
+      for (int j = 0; j < 60; ++j)
+        generator.AddIndices(primitive, 1020);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    fmt::print("primitive {}: {} us\n", static_cast<int>(primitive),
+               std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+  }
+}
@@ -0,0 +1,117 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+struct DecoderFormat
+{
+  TextureFormat format;
+  std::optional<TLUTFormat> tlut_format;
+};
+
+constexpr DecoderFormat FORMATS[] = {
+    {TextureFormat::I4},
+    {TextureFormat::I8},
+    {TextureFormat::IA4},
+    {TextureFormat::IA8},
+    {TextureFormat::RGB565},
+    {TextureFormat::RGB5A3},
+    {TextureFormat::RGBA8},
+    {TextureFormat::CMPR},
+    {TextureFormat::C4, TLUTFormat::IA8},
+    {TextureFormat::C4, TLUTFormat::RGB565},
+    {TextureFormat::C4, TLUTFormat::RGB5A3},
+    {TextureFormat::C8, TLUTFormat::IA8},
+    {TextureFormat::C8, TLUTFormat::RGB565},
+    {TextureFormat::C8, TLUTFormat::RGB5A3},
+    {TextureFormat::C14X2, TLUTFormat::IA8},
+    {TextureFormat::C14X2, TLUTFormat::RGB565},
+    {TextureFormat::C14X2, TLUTFormat::RGB5A3},
+};
+
+std::string FormatName(const DecoderFormat& format)
+{
+  if (!format.tlut_format)
+    return fmt::format("{}", format.format);
+  return fmt::format("{} ({})", format.format, *format.tlut_format);
+}
+
+std::vector<u8> RandomBytes(size_t size, u32 seed)
+{
+  std::mt19937 rng(seed);
+  std::vector<u8> bytes(size);
+  for (u8& byte : bytes)
+    byte = static_cast<u8>(rng());
+  return bytes;
+}
+}  // namespace
+
+// The block decoders, which differ per architecture, have to agree with the texel decoder used
+// when sampling textures directly.
+TEST(TextureDecoder, DecodeMatchesDecodeTexel)
+{
+  constexpr int width = 32;
+  constexpr int height = 32;
+  const std::vector<u8> tlut = RandomBytes(TexDecoder_GetPaletteSize(TextureFormat::C14X2), 1);
+
+  for (const DecoderFormat& format : FORMATS)
+  {
+    const TLUTFormat tlut_format = format.tlut_format.value_or(TLUTFormat::IA8);
+    const std::vector<u8> src =
+        RandomBytes(TexDecoder_GetTextureSizeInBytes(width, height, format.format), 2);
+    std::vector<u8> dst(width * height * 4);
+    TexDecoder_Decode(dst.data(), src.data(), width, height, format.format, tlut.data(),
+                      tlut_format);
+
+    SCOPED_TRACE(FormatName(format));
+    for (int t = 0; t < height; t++)
+    {
+      for (int s = 0; s < width; s++)
+      {
+        u8 texel[4];
+        // The texel decoder takes the width minus one, like the texture registers store it.
+        TexDecoder_DecodeTexel(texel, src.data(), s, t, width - 1, format.format, tlut.data(),
+                               tlut_format);
+        const u8* decoded = &dst[(t * width + s) * 4];
+        ASSERT_TRUE(std::equal(texel, texel + 4, decoded)) << "texel " << s << ", " << t;
+      }
+    }
+  }
+}
+
+TEST(TextureDecoder, Throughput)
+{
+  constexpr int width = 512;
+  constexpr int height = 512;
+  constexpr int iterations = 50;
+  const std::vector<u8> tlut = RandomBytes(TexDecoder_GetPaletteSize(TextureFormat::C14X2), 1);
+  std::vector<u8> dst(width * height * 4);
+
+  for (const DecoderFormat& format : FORMATS)
+  {
+    const std::vector<u8> src =
+        RandomBytes(TexDecoder_GetTextureSizeInBytes(width, height, format.format), 2);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      TexDecoder_Decode(dst.data(), src.data(), width, height, format.format, tlut.data(),
+                        format.tlut_format.value_or(TLUTFormat::IA8));
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    fmt::print("{}: {:.1f} Mtexels/s\n", FormatName(format),
+               double(width) * height * iterations / elapsed.count() / 1e6);
+  }
+}
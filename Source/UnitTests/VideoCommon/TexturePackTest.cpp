@@ -0,0 +1,148 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/TexturePack.h"
+
+namespace
+{
+struct TestTexture
+{
+  std::string name;
+  TexturePack::Format format;
+  u32 flags;
+  u32 width;
+  u32 height;
+  u32 row_length;
+  std::vector<u8> data;
+};
+
+// Lays out the header, the entries, the levels, and then the names and data of each texture.
+std::vector<u8> BuildPack(const std::vector<TestTexture>& textures)
+{
+  const u64 num = textures.size();
+  u64 offset = sizeof(TexturePack::Header) +
+               (sizeof(TexturePack::Entry) + sizeof(TexturePack::LevelHeader)) * num;
+
+  std::vector<TexturePack::Entry> entries;
+  std::vector<TexturePack::LevelHeader> levels;
+  for (u32 i = 0; i < num; i++)
+  {
+    const TestTexture& texture = textures[i];
+    entries.push_back({offset, static_cast<u32>(texture.name.size()), texture.format,
+                       texture.flags, i, 1, 0});
+    offset += texture.name.size();
+    levels.push_back({offset, texture.data.size(), texture.width, texture.height,
+                      texture.row_length, 0});
+    offset += texture.data.size();
+  }
+
+  const TexturePack::Header header{TexturePack::MAGIC, TexturePack::VERSION,
+                                   static_cast<u32>(num), static_cast<u32>(num)};
+  std::vector<u8> pack(sizeof(header));
+  std::memcpy(pack.data(), &header, sizeof(header));
+  const auto append = [&pack](const void* data, size_t size) {
+    const u8* bytes = static_cast<const u8*>(data);
+    pack.insert(pack.end(), bytes, bytes + size);
+  };
+  append(entries.data(), entries.size() * sizeof(TexturePack::Entry));
+  append(levels.data(), levels.size() * sizeof(TexturePack::LevelHeader));
+  for (const TestTexture& texture : textures)
+  {
+    append(texture.name.data(), texture.name.size());
+    append(texture.data.data(), texture.data.size());
+  }
+  return pack;
+}
+
+class TexturePackTest : public testing::Test
+{
+protected:
+  void SetUp() override { m_directory = File::CreateTempDir(); }
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string WritePack(const std::vector<u8>& contents)
+  {
+    const std::string path = m_directory + "/pack.dtp";
+    File::IOFile file(path, "wb");
+    file.WriteBytes(contents.data(), contents.size());
+    return path;
+  }
+
+  std::string m_directory;
+};
+
+bool SupportsAll(AbstractTextureFormat)
+{
+  return true;
+}
+}  // namespace
+
+TEST_F(TexturePackTest, RejectsBadMagic)
+{
+  std::vector<u8> contents = BuildPack({});
+  contents[0] ^= 0xff;
+  EXPECT_EQ(nullptr, TexturePack::Open(WritePack(contents), SupportsAll));
+}
+
+TEST_F(TexturePackTest, MapsLevelData)
+{
+  const std::vector<u8> pixels{1, 2, 3, 4, 5, 6, 7, 8};
+  const auto pack = TexturePack::Open(
+      WritePack(BuildPack({{"tex1_2x1_0123456789abcdef_5", TexturePack::Format::RGBA8,
+                            TexturePack::ENTRY_FLAG_ARBITRARY_MIPMAPS, 2, 1, 2, pixels}})),
+      SupportsAll);
+  ASSERT_NE(nullptr, pack);
+  EXPECT_EQ(nullptr, pack->Find("tex1_2x1_0123456789abcdef_6"));
+
+  const TexturePack::Texture* texture = pack->Find("tex1_2x1_0123456789abcdef_5");
+  ASSERT_NE(nullptr, texture);
+  EXPECT_TRUE(texture->has_arbitrary_mipmaps);
+  ASSERT_EQ(1u, texture->levels.size());
+
+  const TexturePack::Level& level = texture->levels[0];
+  EXPECT_EQ(AbstractTextureFormat::RGBA8, level.format);
+  EXPECT_EQ(2u, level.width);
+  EXPECT_EQ(1u, level.height);
+  EXPECT_EQ(pixels, std::vector<u8>(level.data.begin(), level.data.end()));
+}
+
+TEST_F(TexturePackTest, PrefersFirstSupportedFormat)
+{
+  const std::vector<TestTexture> textures{
+      {"tex1_4x4_a", TexturePack::Format::ASTC_4x4, 0, 4, 4, 4, std::vector<u8>(16)},
+      {"tex1_4x4_a", TexturePack::Format::BC7, 0, 4, 4, 4, std::vector<u8>(16)},
+      {"tex1_4x4_a", TexturePack::Format::RGBA8, 0, 4, 4, 4, std::vector<u8>(64)},
+  };
+  const std::string path = WritePack(BuildPack(textures));
+
+  const auto astc = TexturePack::Open(path, SupportsAll);
+  ASSERT_NE(nullptr, astc);
+  EXPECT_EQ(AbstractTextureFormat::ASTC4x4, astc->Find("tex1_4x4_a")->levels[0].format);
+
+  const auto rgba = TexturePack::Open(
+      path, [](AbstractTextureFormat format) { return format == AbstractTextureFormat::RGBA8; });
+  ASSERT_NE(nullptr, rgba);
+  EXPECT_EQ(AbstractTextureFormat::RGBA8, rgba->Find("tex1_4x4_a")->levels[0].format);
+}
+
+TEST_F(TexturePackTest, SkipsTruncatedLevels)
+{
+  const auto pack = TexturePack::Open(
+      WritePack(BuildPack({{"tex1_4x4_a", TexturePack::Format::BC1, 0, 4, 4, 4,
+                            std::vector<u8>(4)},
+                           {"tex1_4x4_b", TexturePack::Format::BC1, 0, 4, 4, 4,
+                            std::vector<u8>(8)}})),
+      SupportsAll);
+  ASSERT_NE(nullptr, pack);
+  EXPECT_EQ(nullptr, pack->Find("tex1_4x4_a"));
+  EXPECT_NE(nullptr, pack->Find("tex1_4x4_b"));
+}